@@ -193,6 +193,8 @@ public:
             qmlRegisterType<QDeclarativeGeoMap, 12>(uri, major, minor, "Map");
             qmlRegisterType<QDeclarativeGeoRoute, 12>(uri, major, minor, "Route");
             qmlRegisterType<QDeclarativeGeoRouteLeg, 12>(uri, major, minor, "RouteLeg");
+            qmlRegisterUncreatableType<QDeclarativeGeoRoutePath>(uri, major, minor, "RoutePath",
+                                        QStringLiteral("RoutePath is not intended instantiable by developer."));
 
             // Register the latest Qt version as QML type version
             qmlRegisterModule(uri, QT_VERSION_MAJOR, QT_VERSION_MINOR);
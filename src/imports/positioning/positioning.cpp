@@ -613,6 +613,10 @@ public:
             minor = 4;
             qmlRegisterType<QDeclarativePosition, 2>(uri, major, minor, "Position");
 
+            minor = 12;
+            qmlRegisterType<QDeclarativePosition, 3>(uri, major, minor, "Position");
+            qmlRegisterType<QDeclarativePositionSource, 12>(uri, major, minor, "PositionSource");
+
             // Register the latest Qt version as QML type version
             qmlRegisterModule(uri, QT_VERSION_MAJOR, QT_VERSION_MINOR);
         } else {
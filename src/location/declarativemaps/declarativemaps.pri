@@ -19,6 +19,7 @@ PRIVATE_HEADERS += \
         declarativemaps/qdeclarativegeomaptype_p.h \
         declarativemaps/qdeclarativegeoroutemodel_p.h \
         declarativemaps/qdeclarativegeoroute_p.h \
+        declarativemaps/qdeclarativegeoroutepath_p.h \
         declarativemaps/qdeclarativegeoroutesegment_p.h \
         declarativemaps/qdeclarativegeoserviceprovider_p.h \
         declarativemaps/qdeclarativepolygonmapitem_p.h \
@@ -47,6 +48,7 @@ SOURCES += \
         declarativemaps/qdeclarativegeomapquickitem.cpp \
         declarativemaps/qdeclarativegeomaptype.cpp \
         declarativemaps/qdeclarativegeoroute.cpp \
+        declarativemaps/qdeclarativegeoroutepath.cpp \
         declarativemaps/qdeclarativegeoroutemodel.cpp \
         declarativemaps/qdeclarativegeoroutesegment.cpp \
         declarativemaps/qdeclarativegeoserviceprovider.cpp \
@@ -172,7 +172,11 @@ qreal QDeclarativeGeoRoute::distance() const
     indicates the number of objects and 'path[index starting from zero]' gives
     the actual object.
 
-    \sa QtPositioning::coordinate
+    Every read of this property converts all coordinates of the route into a
+    new JavaScript array. Use \l pathModel to access the coordinates of long
+    routes.
+
+    \sa QtPositioning::coordinate, pathModel
 */
 
 QJSValue QDeclarativeGeoRoute::path() const
@@ -181,10 +185,11 @@ QJSValue QDeclarativeGeoRoute::path() const
     QQmlEngine *engine = context->engine();
     QV4::ExecutionEngine *v4 = QQmlEnginePrivate::getV4Engine(engine);
 
+    const QList<QGeoCoordinate> path = route_.path();
     QV4::Scope scope(v4);
-    QV4::Scoped<QV4::ArrayObject> pathArray(scope, v4->newArrayObject(route_.path().length()));
-    for (int i = 0; i < route_.path().length(); ++i) {
-        const QGeoCoordinate &c = route_.path().at(i);
+    QV4::Scoped<QV4::ArrayObject> pathArray(scope, v4->newArrayObject(path.length()));
+    for (int i = 0; i < path.length(); ++i) {
+        const QGeoCoordinate &c = path.at(i);
 
         QV4::ScopedValue cv(scope, v4->fromVariant(QVariant::fromValue(c)));
         pathArray->put(i, cv);
@@ -216,10 +221,32 @@ void QDeclarativeGeoRoute::setPath(const QJSValue &value)
         return;
 
     route_.setPath(pathList);
+    if (pathModel_)
+        pathModel_->setPath(route_.path());
 
     emit pathChanged();
 }
 
+/*!
+    \qmlproperty RoutePath QtLocation::Route::pathModel
+
+    Read-only property which holds the coordinates of this route as a
+    \l RoutePath. Unlike \l path, it shares the coordinates of the route
+    instead of converting them into a JavaScript array on every read, which
+    makes it the better choice for long routes. It follows changes of
+    \l path.
+
+    \since QtLocation 5.12
+*/
+QDeclarativeGeoRoutePath *QDeclarativeGeoRoute::pathModel()
+{
+    if (!pathModel_) {
+        pathModel_ = new QDeclarativeGeoRoutePath(this);
+        pathModel_->setPath(route_.path());
+    }
+    return pathModel_;
+}
+
 /*!
     \qmlproperty list<RouteSegment> QtLocation::Route::segments
 
@@ -50,6 +50,7 @@
 
 #include <QtLocation/private/qlocationglobal_p.h>
 #include <QtLocation/private/qdeclarativegeoroutesegment_p.h>
+#include <QtLocation/private/qdeclarativegeoroutepath_p.h>
 
 #include <QtCore/QObject>
 #include <QtQml/QQmlListProperty>
@@ -69,6 +70,7 @@ class Q_LOCATION_PRIVATE_EXPORT QDeclarativeGeoRoute : public QObject
     Q_PROPERTY(QQmlListProperty<QDeclarativeGeoRouteSegment> segments READ segments CONSTANT)
     Q_PROPERTY(QDeclarativeGeoRouteQuery *routeQuery READ routeQuery REVISION 11)
     Q_PROPERTY(QList<QObject *> legs READ legs CONSTANT REVISION 12)
+    Q_PROPERTY(QDeclarativeGeoRoutePath *pathModel READ pathModel CONSTANT REVISION 12)
 
 public:
     explicit QDeclarativeGeoRoute(QObject *parent = 0);
@@ -81,6 +83,7 @@ public:
 
     QJSValue path() const;
     void setPath(const QJSValue &value);
+    QDeclarativeGeoRoutePath *pathModel();
 
     QQmlListProperty<QDeclarativeGeoRouteSegment> segments();
 
@@ -110,6 +113,7 @@ private:
     QDeclarativeGeoRouteQuery *routeQuery_ = nullptr;
     QList<QDeclarativeGeoRouteSegment *> segments_;
     QList<QObject *> legs_;
+    QDeclarativeGeoRoutePath *pathModel_ = nullptr;
     bool segmentsDirty_ = true;
     friend class QDeclarativeRouteMapItem;
 };
@@ -0,0 +1,163 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qdeclarativegeoroutepath_p.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \qmltype RoutePath
+    \instantiates QDeclarativeGeoRoutePath
+    \inqmlmodule QtLocation
+    \ingroup qml-QtLocation5-routing
+    \since QtLocation 5.12
+
+    \brief The RoutePath type gives read-only access to the coordinates of a route.
+
+    RoutePath shares the coordinates of the \l Route it belongs to instead of
+    converting them into a JavaScript array, so reading it costs the same for
+    routes of any size. Coordinates are read one by one with \l at(), and
+    \l slice() returns a view of a range of them, for example the part of a
+    route that is still ahead.
+
+    A RoutePath can be assigned to the \l {MapPolyline::path}{path} of a
+    \l MapPolyline, which then takes the coordinates over without going
+    through JavaScript:
+
+    \code
+    MapPolyline {
+        line.width: 5
+        line.color: "blue"
+        path: route.pathModel.slice(currentIndex)
+    }
+    \endcode
+
+    RoutePath objects cannot be created in QML; they are obtained from
+    \l {Route::pathModel}{Route.pathModel}.
+*/
+
+QDeclarativeGeoRoutePath::QDeclarativeGeoRoutePath(QObject *parent)
+    : QObject(parent)
+{
+}
+
+QDeclarativeGeoRoutePath::~QDeclarativeGeoRoutePath()
+{
+}
+
+/*!
+    \internal
+
+    Makes this a view of \a count coordinates of \a path starting at
+    \a first, or of all coordinates from \a first on if \a count is
+    negative. The list is shared, not copied.
+*/
+void QDeclarativeGeoRoutePath::setPath(const QList<QGeoCoordinate> &path, int first, int count)
+{
+    const int newFirst = qBound(0, first, path.size());
+    const int newCount = count < 0 ? path.size() - newFirst : qMin(count, path.size() - newFirst);
+    if (path_ == path && first_ == newFirst && count_ == newCount)
+        return;
+
+    path_ = path;
+    first_ = newFirst;
+    count_ = newCount;
+    emit pathChanged();
+}
+
+/*!
+    \internal
+
+    Returns the coordinates of the view; a view of the whole list returns it
+    without copying.
+*/
+QList<QGeoCoordinate> QDeclarativeGeoRoutePath::path() const
+{
+    if (first_ == 0 && count_ == path_.size())
+        return path_;
+    return path_.mid(first_, count_);
+}
+
+/*!
+    \qmlproperty int QtLocation::RoutePath::length
+
+    Read-only property which holds the number of coordinates of the path.
+*/
+int QDeclarativeGeoRoutePath::length() const
+{
+    return count_;
+}
+
+/*!
+    \qmlmethod coordinate QtLocation::RoutePath::at(int index)
+
+    Returns the coordinate at \a index, or an invalid coordinate if \a index
+    is out of range.
+*/
+QGeoCoordinate QDeclarativeGeoRoutePath::at(int index) const
+{
+    if (index < 0 || index >= count_)
+        return QGeoCoordinate();
+    return path_.at(first_ + index);
+}
+
+/*!
+    \qmlmethod RoutePath QtLocation::RoutePath::slice(int from, int to)
+
+    Returns a view of the coordinates from index \a from up to, but not
+    including, index \a to. Negative indexes count from the end of the path,
+    as with \c Array.prototype.slice; if \a to is omitted the view extends to
+    the end of the path.
+
+    The view shares the coordinates of this path and does not follow later
+    changes of it.
+*/
+QDeclarativeGeoRoutePath *QDeclarativeGeoRoutePath::slice(int from, int to) const
+{
+    if (from < 0)
+        from += count_;
+    if (to < 0)
+        to += count_;
+    from = qBound(0, from, count_);
+    to = qBound(from, to, count_);
+
+    // Without a parent the view is owned by the JavaScript engine.
+    QDeclarativeGeoRoutePath *view = new QDeclarativeGeoRoutePath;
+    view->setPath(path_, first_ + from, to - from);
+    return view;
+}
+
+QT_END_NAMESPACE
@@ -39,6 +39,7 @@
 #include "error_messages_p.h"
 #include "locationvaluetypehelper_p.h"
 #include "qdoublevector2d_p.h"
+#include "qdeclarativegeoroutepath_p.h"
 #include <QtLocation/private/qgeomap_p.h>
 
 #include <QtCore/QScopedValueRollback>
@@ -777,6 +778,10 @@ void QDeclarativePolylineMapItem::setMap(QDeclarativeGeoMap *quickMap, QGeoMap *
 
     This property holds the ordered list of coordinates which
     define the polyline.
+
+    Since QtLocation 5.12 a \l RoutePath can be assigned as well; its
+    coordinates are then taken over without converting them into a
+    JavaScript array.
 */
 
 QJSValue QDeclarativePolylineMapItem::path() const
@@ -786,6 +791,11 @@ QJSValue QDeclarativePolylineMapItem::path() const
 
 void QDeclarativePolylineMapItem::setPath(const QJSValue &value)
 {
+    if (const QDeclarativeGeoRoutePath *routePath = qobject_cast<QDeclarativeGeoRoutePath *>(value.toQObject())) {
+        setPathFromGeoList(routePath->path());
+        return;
+    }
+
     if (!value.isArray())
         return;
 
@@ -137,6 +137,14 @@ QT_BEGIN_NAMESPACE
     removed, then correspondingly the place will be removed from the model if it is currently
     present.
 
+    \section1 Progressive Results
+
+    Some plugins report the results of a search as they receive them. The model then adds rows for
+    them while its \l status is still \c PlaceSearchModel.Loading, rather than showing all of them
+    at once when the search has finished. The \c place and \c icon objects of a row are created
+    when the data of the row is first requested, usually when a view creates a delegate for it, and
+    so are the details fetches of updated places.
+
     \section1 Example
 
     The following example shows how to use the PlaceSearchModel to search for Pizza restaurants in
@@ -612,6 +620,9 @@ void QDeclarativeSearchResultModel::clearData(bool suppressSignal)
     m_places.clear();
     qDeleteAll(m_icons);
     m_icons.clear();
+    m_favoritePlaces.clear();
+    m_outdatedPlaceIds.clear();
+    finishStreaming();
     if (!m_results.isEmpty()) {
         m_results.clear();
 
@@ -622,7 +633,7 @@ void QDeclarativeSearchResultModel::clearData(bool suppressSignal)
 
 QVariant QDeclarativeSearchResultModel::data(const QModelIndex &index, int role) const
 {
-    if (index.row() > m_results.count())
+    if (index.row() < 0 || index.row() >= m_results.count())
         return QVariant();
 
     const QPlaceSearchResult &result = m_results.at(index.row());
@@ -634,7 +645,7 @@ QVariant QDeclarativeSearchResultModel::data(const QModelIndex &index, int role)
     case TitleRole:
         return result.title();
     case IconRole:
-        return QVariant::fromValue(static_cast<QObject *>(m_icons.at(index.row())));
+        return QVariant::fromValue(static_cast<QObject *>(iconAt(index.row())));
     case DistanceRole:
         if (result.type() == QPlaceSearchResult::PlaceResult) {
             QPlaceResult placeResult = result;
@@ -643,7 +654,7 @@ QVariant QDeclarativeSearchResultModel::data(const QModelIndex &index, int role)
         break;
     case PlaceRole:
         if (result.type() == QPlaceSearchResult::PlaceResult)
-            return QVariant::fromValue(static_cast<QObject *>(m_places.at(index.row())));
+            return QVariant::fromValue(static_cast<QObject *>(placeAt(index.row())));
         break;
     case SponsoredRole:
         if (result.type() == QPlaceSearchResult::PlaceResult) {
@@ -701,6 +712,13 @@ QPlaceReply *QDeclarativeSearchResultModel::sendQuery(QPlaceManager *manager,
                                                       const QPlaceSearchRequest &request)
 {
     Q_ASSERT(manager);
+
+    // The results of a cancelled search that were added in incremental mode
+    // are not part of any page.
+    if (m_incremental)
+        discardStreamedRows();
+    finishStreaming();
+
     return manager->search(request);
 }
 
@@ -752,6 +770,9 @@ void QDeclarativeSearchResultModel::queryFinished()
         m_pages.clear();
 
     if (reply->error() != QPlaceReply::NoError) {
+        if (m_incremental)
+            discardStreamedRows();
+        finishStreaming();
         m_resultsBuffer.clear();
         updateLayout();
         setStatus(Error, reply->errorString());
@@ -773,21 +794,39 @@ void QDeclarativeSearchResultModel::queryFinished()
         setPreviousPageRequest(searchReply->previousPageRequest());
         setNextPageRequest(searchReply->nextPageRequest());
 
+        // Rows have been added for the results received before, only the
+        // remaining ones are left to add.
+        const bool streamed = m_streamStart >= 0;
+        const QList<QPlaceSearchResult> results = m_resultsBuffer;
+        if (streamed) {
+            appendStreamedResults(results);
+            m_resultsBuffer.clear();
+        }
+
         // Performing favorite matching only upon finished()
         if (!m_favoritesPlugin) {
-            updateLayout();
+            if (streamed)
+                finishStreaming();
+            else
+                updateLayout();
             setStatus(Ready);
         } else {
             QGeoServiceProvider *serviceProvider = m_favoritesPlugin->sharedGeoServiceProvider();
             if (!serviceProvider) {
-                updateLayout();
+                if (streamed)
+                    finishStreaming();
+                else
+                    updateLayout();
                 setStatus(Error, QStringLiteral("Favorites plugin returns a null QGeoServiceProvider instance"));
                 return;
             }
 
             QPlaceManager *favoritesManager = serviceProvider->placeManager();
             if (!favoritesManager) {
-                updateLayout();
+                if (streamed)
+                    finishStreaming();
+                else
+                    updateLayout();
                 setStatus(Error, QStringLiteral("Favorites plugin returns a null QPlaceManager"));
                 return;
             }
@@ -806,7 +845,7 @@ void QDeclarativeSearchResultModel::queryFinished()
                 request.setParameters(m_matchParameters);
             }
 
-            request.setResults(m_resultsBuffer);
+            request.setResults(results);
             if (alreadyLoaded)
                 m_resultsBuffer.clear();
             m_reply = favoritesManager->matchingPlaces(request);
@@ -816,7 +855,12 @@ void QDeclarativeSearchResultModel::queryFinished()
     } else if (reply->type() == QPlaceReply::MatchReply) {
         QPlaceMatchReply *matchReply = qobject_cast<QPlaceMatchReply *>(reply);
         Q_ASSERT(matchReply);
-        updateLayout(matchReply->places());
+        if (m_streamStart >= 0) {
+            setFavorites(m_streamStart, matchReply->places());
+            finishStreaming();
+        } else {
+            updateLayout(matchReply->places());
+        }
         setStatus(Ready);
     } else {
         setStatus(Error, QStringLiteral("Unknown reply type"));
@@ -830,28 +874,36 @@ void QDeclarativeSearchResultModel::onContentUpdated()
 
     QPlaceReply *reply = m_reply; // not finished, don't delete.
 
-    if (!m_incremental)
-        m_pages.clear();
-
-    if (reply->error() != QPlaceReply::NoError) {
-        m_resultsBuffer.clear();
-        updateLayout();
-        setStatus(Error, reply->errorString());
+    // Errors are handled once the reply has finished.
+    if (reply->error() != QPlaceReply::NoError)
         return;
-    }
 
     if (reply->type() == QPlaceReply::SearchReply) {
         QPlaceSearchReply *searchReply = qobject_cast<QPlaceSearchReply *>(reply);
         Q_ASSERT(searchReply);
 
-        const QPlaceSearchRequestPrivate *rpimpl = QPlaceSearchRequestPrivate::get(searchReply->request());
-        if (!rpimpl->related || !m_incremental)
-            m_pages.clear();
-        m_resultsBuffer = searchReply->results();
-        if (!(m_pages.contains(rpimpl->page) && m_resultsBuffer == m_pages.value(rpimpl->page))) {
-            m_pages.insert(rpimpl->page, m_resultsBuffer);
-            updateLayout();
+        if (m_streamStart < 0) {
+            const QPlaceSearchRequestPrivate *rpimpl = QPlaceSearchRequestPrivate::get(searchReply->request());
+            if (!rpimpl->related || !m_incremental) {
+                // The results of a new search replace the current ones as
+                // soon as the first of them arrive.
+                const int oldRowCount = rowCount();
+                beginResetModel();
+                clearData(true);
+                m_pages.clear();
+                endResetModel();
+                if (oldRowCount != 0)
+                    emit rowCountChanged();
+            } else if (m_pages.contains(rpimpl->page)) {
+                // Reloading a page that is already shown, see queryFinished().
+                return;
+            }
+            m_streamStart = rowCount();
+            m_streamedCount = 0;
         }
+
+        // The results of a reply only grow, rows are added for the new ones.
+        appendStreamedResults(searchReply->results());
     } else if (reply->type() == QPlaceReply::MatchReply) {
         // ToDo: handle incremental match replies
     } else {
@@ -900,25 +952,10 @@ void QDeclarativeSearchResultModel::updateLayout(const QList<QPlace> &favoritePl
 
     m_resultsBuffer.clear();
     for (int i = start; i < m_results.count(); ++i) {
-        const QPlaceSearchResult &result = m_results.at(i);
-
-        if (result.type() == QPlaceSearchResult::PlaceResult) {
-            QPlaceResult placeResult = result;
-            QDeclarativePlace *place = new QDeclarativePlace(placeResult.place(), plugin(), this);
-            m_places.append(place);
-
-            if ((favoritePlaces.count() == m_results.count()) && favoritePlaces.at(i) != QPlace())
-                m_places[i]->setFavorite(new QDeclarativePlace(favoritePlaces.at(i),
-                                                               m_favoritesPlugin, m_places[i]));
-        } else if (result.type() == QPlaceSearchResult::ProposedSearchResult) {
-            m_places.append(0);
-        }
-
-        QDeclarativePlaceIcon *icon = 0;
-        if (!result.icon().isEmpty())
-            icon = new QDeclarativePlaceIcon(result.icon(), plugin(), this);
-        m_icons.append(icon);
+        m_places.append(0);
+        m_icons.append(0);
     }
+    setFavorites(start, favoritePlaces);
 
     if (m_incremental)
         endInsertRows();
@@ -934,11 +971,13 @@ void QDeclarativeSearchResultModel::updateLayout(const QList<QPlace> &favoritePl
 void QDeclarativeSearchResultModel::placeUpdated(const QString &placeId)
 {
     int row = getRow(placeId);
-    if (row < 0 || row > m_places.count())
+    if (row < 0 || row >= m_places.count())
         return;
 
     if (m_places.at(row))
         m_places.at(row)->getDetails();
+    else
+        m_outdatedPlaceIds.insert(placeId);
 }
 
 /*!
@@ -947,14 +986,20 @@ void QDeclarativeSearchResultModel::placeUpdated(const QString &placeId)
 void QDeclarativeSearchResultModel::placeRemoved(const QString &placeId)
 {
     int row = getRow(placeId);
-    if (row < 0 || row > m_places.count())
+    if (row < 0 || row >= m_places.count())
         return;
 
     beginRemoveRows(QModelIndex(), row, row);
     delete m_places.at(row);
     m_places.removeAt(row);
+    delete m_icons.at(row);
+    m_icons.removeAt(row);
+    if (row < m_favoritePlaces.count())
+        m_favoritePlaces.removeAt(row);
     m_results.removeAt(row);
     removePageRow(row);
+    if (row < m_streamStart)
+        --m_streamStart;
     endRemoveRows();
 
     emit rowCountChanged();
@@ -992,16 +1037,143 @@ void QDeclarativeSearchResultModel::removePageRow(int row)
 */
 int QDeclarativeSearchResultModel::getRow(const QString &placeId) const
 {
-    for (int i = 0; i < m_places.count(); ++i) {
-        if (!m_places.at(i))
+    for (int i = 0; i < m_results.count(); ++i) {
+        if (m_results.at(i).type() != QPlaceSearchResult::PlaceResult)
             continue;
-        else if (m_places.at(i)->placeId() == placeId)
+
+        const QDeclarativePlace *place = m_places.at(i);
+        const QString id = place ? place->placeId()
+                                 : QPlaceResult(m_results.at(i)).place().placeId();
+        if (id == placeId)
             return i;
     }
 
     return -1;
 }
 
+/*!
+    \internal
+    Returns the place of \a row, creating it if the row has not been shown
+    yet. Creating the places of all rows up front is what made large
+    searches slow to appear.
+*/
+QDeclarativePlace *QDeclarativeSearchResultModel::placeAt(int row) const
+{
+    if (row < 0 || row >= m_places.count() || m_places.at(row))
+        return m_places.value(row);
+
+    const QPlaceSearchResult &result = m_results.at(row);
+    if (result.type() != QPlaceSearchResult::PlaceResult)
+        return 0;
+
+    QDeclarativeSearchResultModel *self = const_cast<QDeclarativeSearchResultModel *>(this);
+    QPlaceResult placeResult = result;
+    QDeclarativePlace *place = new QDeclarativePlace(placeResult.place(), plugin(), self);
+    m_places[row] = place;
+
+    if (row < m_favoritePlaces.count() && m_favoritePlaces.at(row) != QPlace())
+        place->setFavorite(new QDeclarativePlace(m_favoritePlaces.at(row), m_favoritesPlugin, place));
+
+    if (m_outdatedPlaceIds.remove(place->placeId()))
+        place->getDetails();
+
+    return place;
+}
+
+/*!
+    \internal
+*/
+QDeclarativePlaceIcon *QDeclarativeSearchResultModel::iconAt(int row) const
+{
+    if (row < 0 || row >= m_icons.count() || m_icons.at(row))
+        return m_icons.value(row);
+
+    const QPlaceSearchResult &result = m_results.at(row);
+    if (result.icon().isEmpty())
+        return 0;
+
+    QDeclarativeSearchResultModel *self = const_cast<QDeclarativeSearchResultModel *>(this);
+    m_icons[row] = new QDeclarativePlaceIcon(result.icon(), plugin(), self);
+    return m_icons.at(row);
+}
+
+/*!
+    \internal
+    Sets the favorites of the rows from \a first to the last one, if
+    \a favoritePlaces has one place per row.
+*/
+void QDeclarativeSearchResultModel::setFavorites(int first, const QList<QPlace> &favoritePlaces)
+{
+    if (favoritePlaces.isEmpty() || first + favoritePlaces.count() != m_results.count())
+        return;
+
+    while (m_favoritePlaces.count() < m_results.count())
+        m_favoritePlaces.append(QPlace());
+
+    for (int i = 0; i < favoritePlaces.count(); ++i) {
+        const int row = first + i;
+        m_favoritePlaces[row] = favoritePlaces.at(i);
+        if (m_places.at(row) && favoritePlaces.at(i) != QPlace())
+            m_places.at(row)->setFavorite(new QDeclarativePlace(favoritePlaces.at(i),
+                                                                m_favoritesPlugin, m_places.at(row)));
+    }
+}
+
+/*!
+    \internal
+    Adds rows for the results of the current reply that have not been added
+    yet.
+*/
+void QDeclarativeSearchResultModel::appendStreamedResults(const QList<QPlaceSearchResult> &results)
+{
+    if (results.count() <= m_streamedCount)
+        return;
+
+    const int first = m_results.count();
+    const int added = results.count() - m_streamedCount;
+    beginInsertRows(QModelIndex(), first, first + added - 1);
+    m_results.append(results.mid(m_streamedCount));
+    for (int i = 0; i < added; ++i) {
+        m_places.append(0);
+        m_icons.append(0);
+    }
+    m_streamedCount = results.count();
+    endInsertRows();
+
+    emit rowCountChanged();
+}
+
+/*!
+    \internal
+    Removes the rows added for the current reply.
+*/
+void QDeclarativeSearchResultModel::discardStreamedRows()
+{
+    if (m_streamStart < 0 || m_streamStart >= m_results.count())
+        return;
+
+    beginRemoveRows(QModelIndex(), m_streamStart, m_results.count() - 1);
+    while (m_results.count() > m_streamStart) {
+        delete m_places.takeLast();
+        delete m_icons.takeLast();
+        m_results.removeLast();
+    }
+    while (m_favoritePlaces.count() > m_streamStart)
+        m_favoritePlaces.removeLast();
+    endRemoveRows();
+
+    emit rowCountChanged();
+}
+
+/*!
+    \internal
+*/
+void QDeclarativeSearchResultModel::finishStreaming()
+{
+    m_streamStart = -1;
+    m_streamedCount = 0;
+}
+
 /*!
     \qmlsignal PlaceSearchResultModel::dataChanged()
 
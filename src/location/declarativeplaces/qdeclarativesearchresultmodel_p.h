@@ -53,6 +53,7 @@
 #include <QtLocation/private/qdeclarativecategory_p.h>
 #include <QtLocation/private/qdeclarativeplace_p.h>
 #include <QtLocation/private/qdeclarativeplaceicon_p.h>
+#include <QtCore/QSet>
 
 QT_BEGIN_NAMESPACE
 
@@ -169,14 +170,29 @@ private:
     QList<QPlaceSearchResult> resultsFromPages() const;
     void removePageRow(int row);
 
+    QDeclarativePlace *placeAt(int row) const;
+    QDeclarativePlaceIcon *iconAt(int row) const;
+    void setFavorites(int first, const QList<QPlace> &favoritePlaces);
+
+    void appendStreamedResults(const QList<QPlaceSearchResult> &results);
+    void discardStreamedRows();
+    void finishStreaming();
+
     QList<QDeclarativeCategory *> m_categories;
     QLocation::VisibilityScope m_visibilityScope;
 
     QMap<int, QList<QPlaceSearchResult>> m_pages;
     QList<QPlaceSearchResult> m_results;
     QList<QPlaceSearchResult> m_resultsBuffer;
-    QList<QDeclarativePlace *> m_places;
-    QList<QDeclarativePlaceIcon *> m_icons;
+    // Created when the row is first shown, see placeAt() and iconAt()
+    mutable QList<QDeclarativePlace *> m_places;
+    mutable QList<QDeclarativePlaceIcon *> m_icons;
+    QList<QPlace> m_favoritePlaces;
+    mutable QSet<QString> m_outdatedPlaceIds;
+
+    // Rows added for the results of m_reply received so far
+    int m_streamStart = -1;
+    int m_streamedCount = 0;
 
     QDeclarativeGeoServiceProvider *m_favoritesPlugin;
     QVariantMap m_matchParameters;
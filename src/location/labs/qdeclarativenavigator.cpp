@@ -38,10 +38,50 @@
 #include <QtLocation/private/qdeclarativegeoroutemodel_p.h>
 #include <QtLocation/private/qdeclarativegeoroutesegment_p.h>
 #include <QtPositioningQuick/private/qdeclarativepositionsource_p.h>
+#include <QtLocation/QGeoServiceProvider>
+#include <QtLocation/QGeoRoutingManager>
+#include <QtLocation/QGeoRouteReply>
 #include <QtQml/qqmlinfo.h>
 
 QT_BEGIN_NAMESPACE
 
+namespace {
+
+// Delays between the attempts to reroute while the position stays off route
+const int firstRerouteDelay = 1000;
+const int maximumRerouteDelay = 60000;
+
+// Emits the change signals of the progress properties modified during its lifetime
+class ProgressNotifier
+{
+public:
+    explicit ProgressNotifier(QDeclarativeNavigator *navigator)
+        : m_navigator(navigator),
+          m_traveledDistance(navigator->traveledDistance()),
+          m_remainingDistance(navigator->remainingDistance()),
+          m_offRoute(navigator->offRoute())
+    {
+    }
+
+    ~ProgressNotifier()
+    {
+        if (m_navigator->traveledDistance() != m_traveledDistance)
+            emit m_navigator->traveledDistanceChanged();
+        if (m_navigator->remainingDistance() != m_remainingDistance)
+            emit m_navigator->remainingDistanceChanged();
+        if (m_navigator->offRoute() != m_offRoute)
+            emit m_navigator->offRouteChanged();
+    }
+
+private:
+    QDeclarativeNavigator *m_navigator;
+    qreal m_traveledDistance;
+    qreal m_remainingDistance;
+    bool m_offRoute;
+};
+
+}
+
 /*!
     \qmlmodule Qt.labs.location 1.0
     \title Qt Labs Location QML Types
@@ -177,6 +217,42 @@ QT_BEGIN_NAMESPACE
     \sa RouteSegment
 */
 
+/*!
+    \qmlproperty real Qt.labs.location::Navigator::traveledDistance
+
+    This read-only property holds the distance in meters along the \l currentRoute
+    from its start to the last position from \l positionSource that could be
+    matched to the route.
+
+    The progress is tracked by the Navigator itself, whether or not the plugin
+    provides a navigation engine. Each position update only searches the part of
+    the route around the previous match, so updates stay cheap on long routes.
+
+    \sa remainingDistance, offRoute
+*/
+
+/*!
+    \qmlproperty real Qt.labs.location::Navigator::remainingDistance
+
+    This read-only property holds the distance in meters along the \l currentRoute
+    from the last matched position to the destination.
+
+    \sa traveledDistance
+*/
+
+/*!
+    \qmlproperty bool Qt.labs.location::Navigator::offRoute
+
+    This read-only property tells whether the positions coming from \l positionSource
+    have left the \l currentRoute. It becomes \c true after a few consecutive
+    positions further than 50 meters from the route, and \c false again as soon as
+    a position is back on it.
+
+    When the plugin does not provide a navigation engine, leaving the route makes
+    the Navigator ask the plugin's routing manager for an updated route from the
+    current position, which then becomes the \l currentRoute.
+*/
+
 /*!
     \qmlsignal Qt.labs.location::Navigator::waypointReached(Waypoint waypoint)
 
@@ -207,6 +283,8 @@ void QDeclarativeNavigatorPrivate::updateReadyState()
 QDeclarativeNavigator::QDeclarativeNavigator(QObject *parent)
     : QParameterizableObject(parent), d_ptr(new QDeclarativeNavigatorPrivate(this))
 {
+    d_ptr->m_rerouteTimer.setSingleShot(true);
+    connect(&d_ptr->m_rerouteTimer, &QTimer::timeout, this, &QDeclarativeNavigator::retryReroute);
 }
 
 QDeclarativeNavigator::~QDeclarativeNavigator()
@@ -265,6 +343,18 @@ void QDeclarativeNavigator::setRoute(QDeclarativeGeoRoute *route)
 
     d_ptr->m_params->m_route = route;
     d_ptr->m_params->m_geoRoute = route ? route->route() : QGeoRoute();
+    if (!d_ptr->m_navigator) {
+        // Drop the route computed when rerouting, it led to the previous destination
+        if (d_ptr->m_currentRoute) {
+            d_ptr->m_currentRoute->deleteLater();
+            d_ptr->m_currentRoute = nullptr;
+            emit currentRouteChanged();
+        }
+        if (d_ptr->m_currentSegment != 0)
+            onCurrentSegmentChanged(0);
+    }
+    resetProgress();
+    setTrackedRoute(d_ptr->m_params->m_geoRoute);
     if (route) {
         connect(route, &QObject::destroyed,
                 [this]() {
@@ -295,6 +385,8 @@ void QDeclarativeNavigator::setPositionSource(QDeclarativePositionSource *positi
                 dptr->updateReadyState();
             }
     );
+    connect(positionSource, &QDeclarativePositionSource::positionChanged,
+            this, &QDeclarativeNavigator::onPositionChanged);
     emit positionSourceChanged();
     updateReadyState();
 }
@@ -329,6 +421,12 @@ void QDeclarativeNavigator::setTrackPositionSource(bool trackPositionSource)
 
 QDeclarativeGeoRoute *QDeclarativeNavigator::currentRoute() const
 {
+    if (!d_ptr->m_navigator) {
+        // Without a navigation engine, the route only changes when rerouting
+        if (d_ptr->m_active && d_ptr->m_currentRoute)
+            return d_ptr->m_currentRoute.data();
+        return d_ptr->m_params->m_route.data();
+    }
     if (!d_ptr->m_ready || !d_ptr->m_navigator->active())
         return d_ptr->m_params->m_route.data();
     return d_ptr->m_currentRoute.data();
@@ -336,11 +434,28 @@ QDeclarativeGeoRoute *QDeclarativeNavigator::currentRoute() const
 
 int QDeclarativeNavigator::currentSegment() const
 {
+    if (!d_ptr->m_navigator)
+        return d_ptr->m_active ? d_ptr->m_currentSegment : 0;
     if (!d_ptr->m_ready || !d_ptr->m_navigator->active())
         return 0;
     return d_ptr->m_currentSegment;
 }
 
+qreal QDeclarativeNavigator::traveledDistance() const
+{
+    return d_ptr->m_tracker.traveledDistance();
+}
+
+qreal QDeclarativeNavigator::remainingDistance() const
+{
+    return d_ptr->m_tracker.remainingDistance();
+}
+
+bool QDeclarativeNavigator::offRoute() const
+{
+    return d_ptr->m_tracker.isOffRoute();
+}
+
 bool QDeclarativeNavigator::active() const
 {
     return d_ptr->m_active;
@@ -368,6 +483,8 @@ void QDeclarativeNavigator::setActive(bool active)
         return;
 
     d_ptr->m_active = active;
+    if (!active)
+        resetProgress();
     if (!d_ptr->m_plugin)
         return;
 
@@ -380,7 +497,8 @@ void QDeclarativeNavigator::setActive(bool active)
 void QDeclarativeNavigator::start()
 {
     if (!d_ptr->m_ready) {
-        qmlWarning(this) << QStringLiteral("Navigation manager not ready.");
+        if (!trackingOnly())
+            qmlWarning(this) << QStringLiteral("Navigation manager not ready.");
         return;
     }
 
@@ -391,7 +509,8 @@ void QDeclarativeNavigator::start()
 void QDeclarativeNavigator::stop()
 {
     if (!ensureEngine()) { // If somebody re-set route to null or something, this may become !d_ptr->m_ready
-        qmlWarning(this) << QStringLiteral("Navigation manager not ready.");
+        if (!trackingOnly())
+            qmlWarning(this) << QStringLiteral("Navigation manager not ready.");
         return;
     }
 
@@ -410,6 +529,16 @@ void QDeclarativeNavigator::pluginReady()
         start();
 }
 
+/*
+    Returns whether the plugin is ready but has no navigation engine, in
+    which case only the built-in progress tracking runs.
+*/
+bool QDeclarativeNavigator::trackingOnly()
+{
+    return !ensureEngine() && d_ptr->m_completed && d_ptr->m_plugin
+            && d_ptr->m_plugin->isAttached();
+}
+
 bool QDeclarativeNavigator::ensureEngine()
 {
     if (d_ptr->m_navigator)
@@ -430,6 +559,8 @@ bool QDeclarativeNavigator::ensureEngine()
         connect(d_ptr->m_navigator.get(), &QAbstractNavigator::currentSegmentChanged, this, &QDeclarativeNavigator::onCurrentSegmentChanged);
         connect(d_ptr->m_navigator.get(), &QAbstractNavigator::activeChanged, this, [this](bool active){
             d_ptr->m_active = active;
+            if (!active)
+                resetProgress();
             emit activeChanged(active);
         });
         connect(this, &QDeclarativeNavigator::trackPositionSourceChanged, d_ptr->m_navigator.get(), &QAbstractNavigator::setTrackPosition);
@@ -455,6 +586,9 @@ void QDeclarativeNavigator::onCurrentRouteChanged(const QGeoRoute &route)
     if (d_ptr->m_currentRoute)
         d_ptr->m_currentRoute->deleteLater();
     d_ptr->m_currentRoute = new QDeclarativeGeoRoute(route, this);
+    setTrackedRoute(route);
+    if (!d_ptr->m_navigator && d_ptr->m_currentSegment != 0)
+        onCurrentSegmentChanged(0);
     emit currentRouteChanged();
 }
 
@@ -464,4 +598,115 @@ void QDeclarativeNavigator::onCurrentSegmentChanged(int segment)
     emit currentSegmentChanged();
 }
 
+void QDeclarativeNavigator::setTrackedRoute(const QGeoRoute &route)
+{
+    ProgressNotifier notifier(this);
+    d_ptr->m_tracker.setRoute(route);
+}
+
+void QDeclarativeNavigator::resetProgress()
+{
+    if (d_ptr->m_rerouteReply) {
+        d_ptr->m_rerouteReply->disconnect(this);
+        d_ptr->m_rerouteReply->abort();
+        d_ptr->m_rerouteReply->deleteLater();
+        d_ptr->m_rerouteReply = nullptr;
+    }
+    d_ptr->m_rerouteTimer.stop();
+    d_ptr->m_rerouteDelay = 0;
+
+    ProgressNotifier notifier(this);
+    d_ptr->m_tracker.reset();
+}
+
+void QDeclarativeNavigator::onPositionChanged()
+{
+    QDeclarativePositionSource *positionSource = d_ptr->m_params->m_positionSource;
+    if (!d_ptr->m_active || !positionSource || d_ptr->m_tracker.isEmpty())
+        return;
+
+    const QGeoCoordinate position = positionSource->position()->coordinate();
+    const bool wasOffRoute = d_ptr->m_tracker.isOffRoute();
+    {
+        ProgressNotifier notifier(this);
+        d_ptr->m_tracker.update(position);
+    }
+
+    // Navigation engines report the current segment and reroute on their own
+    if (d_ptr->m_navigator)
+        return;
+    if (d_ptr->m_tracker.currentSegment() != d_ptr->m_currentSegment)
+        onCurrentSegmentChanged(d_ptr->m_tracker.currentSegment());
+    if (!d_ptr->m_tracker.isOffRoute()) {
+        d_ptr->m_rerouteTimer.stop();
+        d_ptr->m_rerouteDelay = 0;
+    } else if (!wasOffRoute) {
+        reroute(position);
+    }
+}
+
+/*
+    Asks the routing manager of the plugin for a route from \a position to the
+    remaining waypoints of the current route. This only happens when the
+    position leaves the route, and again after a failure while it stays off
+    the route, not on every position update.
+*/
+void QDeclarativeNavigator::reroute(const QGeoCoordinate &position)
+{
+    if (d_ptr->m_rerouteReply || !d_ptr->m_plugin || !d_ptr->m_plugin->isAttached())
+        return;
+
+    QGeoServiceProvider *serviceProvider = d_ptr->m_plugin->sharedGeoServiceProvider();
+    QGeoRoutingManager *routingManager = serviceProvider ? serviceProvider->routingManager() : nullptr;
+    if (!routingManager)
+        return;
+
+    const QGeoRoute route = d_ptr->m_currentRoute ? d_ptr->m_currentRoute->route()
+                                                  : d_ptr->m_params->m_geoRoute;
+    QGeoRouteReply *reply = routingManager->updateRoute(route, position);
+    if (!reply)
+        return;
+
+    d_ptr->m_rerouteReply = reply;
+    if (reply->isFinished())
+        onRerouteFinished();
+    else
+        connect(reply, &QGeoRouteReply::finished, this, &QDeclarativeNavigator::onRerouteFinished);
+}
+
+void QDeclarativeNavigator::onRerouteFinished()
+{
+    QGeoRouteReply *reply = d_ptr->m_rerouteReply;
+    if (!reply)
+        return;
+    d_ptr->m_rerouteReply = nullptr;
+    reply->deleteLater();
+
+    if (!d_ptr->m_active || d_ptr->m_navigator)
+        return;
+
+    // On failure the navigator stays off route, and tries again after a delay that doubles
+    // with every failed attempt, for as long as the position stays off route
+    if (reply->error() != QGeoRouteReply::NoError || reply->routes().isEmpty()) {
+        if (d_ptr->m_tracker.isOffRoute()) {
+            d_ptr->m_rerouteDelay = d_ptr->m_rerouteDelay == 0
+                    ? firstRerouteDelay : qMin(2 * d_ptr->m_rerouteDelay, maximumRerouteDelay);
+            d_ptr->m_rerouteTimer.start(d_ptr->m_rerouteDelay);
+        }
+        return;
+    }
+
+    d_ptr->m_rerouteDelay = 0;
+    onCurrentRouteChanged(reply->routes().first());
+}
+
+void QDeclarativeNavigator::retryReroute()
+{
+    QDeclarativePositionSource *positionSource = d_ptr->m_params->m_positionSource;
+    if (!d_ptr->m_active || d_ptr->m_navigator || !positionSource || !d_ptr->m_tracker.isOffRoute())
+        return;
+
+    reroute(positionSource->position()->coordinate());
+}
+
 QT_END_NAMESPACE
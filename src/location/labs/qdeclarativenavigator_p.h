@@ -62,6 +62,7 @@ class QDeclarativeGeoRoute;
 class QDeclarativePositionSource;
 class QDeclarativeGeoWaypoint;
 class QGeoRoute;
+class QGeoCoordinate;
 class QGeoRouteSegment;
 class QDeclarativeNavigatorPrivate;
 class QDeclarativeGeoRouteSegment;
@@ -78,6 +79,9 @@ class Q_LOCATION_PRIVATE_EXPORT QDeclarativeNavigator : public QParameterizableO
     Q_PROPERTY(bool trackPositionSource READ trackPositionSource WRITE setTrackPositionSource NOTIFY trackPositionSourceChanged)
     Q_PROPERTY(QDeclarativeGeoRoute *currentRoute READ currentRoute NOTIFY currentRouteChanged)
     Q_PROPERTY(int currentSegment READ currentSegment NOTIFY currentSegmentChanged)
+    Q_PROPERTY(qreal traveledDistance READ traveledDistance NOTIFY traveledDistanceChanged)
+    Q_PROPERTY(qreal remainingDistance READ remainingDistance NOTIFY remainingDistanceChanged)
+    Q_PROPERTY(bool offRoute READ offRoute NOTIFY offRouteChanged)
     Q_INTERFACES(QQmlParserStatus)
 
 public:
@@ -114,6 +118,9 @@ public:
 
     QDeclarativeGeoRoute *currentRoute() const;
     int currentSegment() const;
+    qreal traveledDistance() const;
+    qreal remainingDistance() const;
+    bool offRoute() const;
 
 signals:
     void navigatorReadyChanged(bool ready);
@@ -128,15 +135,25 @@ signals:
     void positionSourceChanged();
     void currentRouteChanged();
     void currentSegmentChanged();
+    void traveledDistanceChanged();
+    void remainingDistanceChanged();
+    void offRouteChanged();
 
 private:
     void pluginReady();
     bool ensureEngine();
+    bool trackingOnly();
     void updateReadyState();
+    void setTrackedRoute(const QGeoRoute &route);
+    void resetProgress();
+    void reroute(const QGeoCoordinate &position);
+    void retryReroute();
 
 private slots:
     void onCurrentRouteChanged(const QGeoRoute &route);
     void onCurrentSegmentChanged(int segment);
+    void onPositionChanged();
+    void onRerouteFinished();
 
 private:
     QScopedPointer<QDeclarativeNavigatorPrivate> d_ptr;
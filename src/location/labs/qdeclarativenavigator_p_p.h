@@ -51,7 +51,9 @@
 #include <QtCore/qlist.h>
 #include <QtLocation/private/qlocationglobal_p.h>
 #include <QtCore/qpointer.h>
+#include <QtCore/qtimer.h>
 #include <QtLocation/qgeoroute.h>
+#include <QtLocation/private/qgeorouteprogresstracker_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -64,6 +66,7 @@ class QGeoMapParameter;
 class QDeclarativeGeoRouteSegment;
 class QParameterizableObject;
 class QAbstractNavigator;
+class QGeoRouteReply;
 
 class Q_LOCATION_PRIVATE_EXPORT QDeclarativeNavigatorParams
 {
@@ -87,6 +90,10 @@ public:
     QScopedPointer<QAbstractNavigator> m_navigator;
     QDeclarativeGeoServiceProvider *m_plugin = nullptr;
     QPointer<QDeclarativeGeoRoute> m_currentRoute;
+    QGeoRouteProgressTracker m_tracker;
+    QPointer<QGeoRouteReply> m_rerouteReply;
+    QTimer m_rerouteTimer;
+    int m_rerouteDelay = 0;
     int m_currentSegment = 0;
     bool m_active = false;
     bool m_completed = false;
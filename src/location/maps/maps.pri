@@ -5,6 +5,7 @@ QT += gui quick
 
 PUBLIC_HEADERS += \
                     maps/qgeocodereply.h \
+                    maps/qgeocodebatchreply.h \
                     maps/qgeocodingmanagerengine.h \
                     maps/qgeocodingmanager.h \
                     maps/qgeomaneuver.h \
@@ -23,6 +24,8 @@ PRIVATE_HEADERS += \
                     maps/qgeocameradata_p.h \
                     maps/qgeocameratiles_p.h \
                     maps/qgeocodereply_p.h \
+                    maps/qgeocodebatchreply_p.h \
+                    maps/qgeocodingbatchengine_p.h \
                     maps/qgeocodingmanagerengine_p.h \
                     maps/qgeocodingmanager_p.h \
                     maps/qgeomaneuver_p.h \
@@ -44,16 +47,23 @@ PRIVATE_HEADERS += \
                     maps/qgeomaptype_p_p.h \
                     maps/qgeoroute_p.h \
                     maps/qgeoroutereply_p.h \
+                    maps/qgeoparsetask_p.h \
                     maps/qgeorouterequest_p.h \
                     maps/qgeoroutesegment_p.h \
                     maps/qgeoroutingmanagerengine_p.h \
                     maps/qgeoroutingmanager_p.h \
                     maps/qgeoserviceprovider_p.h \
+                    maps/qgeoservicecache_p.h \
                     maps/qabstractgeotilecache_p.h \
                     maps/qgeofiletilecache_p.h \
+                    maps/qgeofiletilecachewriter_p.h \
                     maps/qgeotiledmapreply_p.h \
                     maps/qgeotiledmapreply_p_p.h \
                     maps/qgeotilespec_p.h \
+                    maps/qgeotileregiondownload_p.h \
+                    maps/qgeotileretryscheduler_p.h \
+                    maps/qgeosharedtileindex_p.h \
+                    maps/qgeotileresampler_p.h \
                     maps/qgeotilespec_p_p.h \
                     maps/qgeorouteparser_p.h \
                     maps/qgeorouteparser_p_p.h \
@@ -64,13 +74,16 @@ PRIVATE_HEADERS += \
                     maps/qnavigationmanager_p.h \
                     maps/qgeocameratiles_p_p.h \
                     maps/qgeotiledmapscene_p_p.h \
-                    maps/qcache3q_p.h
+                    maps/qcache3q_p.h \
+                    maps/qconcurrentcache3q_p.h \
+                    maps/qgeorouteprogresstracker_p.h
 
 SOURCES += \
             maps/qgeocameracapabilities.cpp \
             maps/qgeocameradata.cpp \
             maps/qgeocameratiles.cpp \
             maps/qgeocodereply.cpp \
+            maps/qgeocodebatchreply.cpp \
             maps/qgeocodingmanager.cpp \
             maps/qgeocodingmanagerengine.cpp \
             maps/qgeomaneuver.cpp \
@@ -83,16 +96,23 @@ SOURCES += \
             maps/qgeomaptype.cpp \
             maps/qgeoroute.cpp \
             maps/qgeoroutereply.cpp \
+            maps/qgeoparsetask.cpp \
             maps/qgeorouterequest.cpp \
             maps/qgeoroutesegment.cpp \
             maps/qgeoroutingmanager.cpp \
             maps/qgeoroutingmanagerengine.cpp \
+            maps/qgeoservicecache.cpp \
             maps/qgeoserviceprovider.cpp \
             maps/qgeoserviceproviderfactory.cpp \
             maps/qabstractgeotilecache.cpp \
             maps/qgeofiletilecache.cpp \
+            maps/qgeofiletilecachewriter.cpp \
             maps/qgeotiledmapreply.cpp \
             maps/qgeotilespec.cpp \
+            maps/qgeotileregiondownload.cpp \
+            maps/qgeotileretryscheduler.cpp \
+            maps/qgeosharedtileindex.cpp \
+            maps/qgeotileresampler.cpp \
             maps/qgeotiledmap.cpp \
             maps/qgeotiledmapscene.cpp \
             maps/qgeorouteparser.cpp \
@@ -101,5 +121,6 @@ SOURCES += \
             maps/qgeomapparameter.cpp \
             maps/qnavigationmanagerengine.cpp \
             maps/qnavigationmanager.cpp \
-            maps/qgeoprojection.cpp
+            maps/qgeoprojection.cpp \
+            maps/qgeorouteprogresstracker.cpp
 
@@ -44,6 +44,9 @@
 #include <QMetaType>
 #include <QPixmap>
 #include <QDebug>
+#include <QLocale>
+#include <QtNetwork/QNetworkReply>
+#include <QtNetwork/QNetworkRequest>
 
 Q_DECLARE_METATYPE(QList<QGeoTileSpec>)
 Q_DECLARE_METATYPE(QSet<QGeoTileSpec>)
@@ -51,12 +54,84 @@ Q_DECLARE_METATYPE(QSet<QGeoTileSpec>)
 QT_BEGIN_NAMESPACE
 
 QGeoTileTexture::QGeoTileTexture()
-    : textureBound(false) {}
+    : textureBound(false), provisional(false) {}
 
 QGeoTileTexture::~QGeoTileTexture()
 {
 }
 
+bool QGeoTileMetadata::isEmpty() const
+{
+    return etag.isEmpty() && !lastModified.isValid() && !expires.isValid();
+}
+
+/*
+    Tiles without an expiry date never become stale, which is how tiles
+    cached before metadata was recorded keep behaving.
+*/
+bool QGeoTileMetadata::isStale(const QDateTime &now) const
+{
+    return expires.isValid() && expires <= now;
+}
+
+bool QGeoTileMetadata::canRevalidate() const
+{
+    return !etag.isEmpty() || lastModified.isValid();
+}
+
+/*
+    Makes \a request conditional, so that the server answers with
+    304 Not Modified if the cached tile is still current.
+*/
+void QGeoTileMetadata::addValidators(QNetworkRequest *request) const
+{
+    if (!etag.isEmpty())
+        request->setRawHeader("If-None-Match", etag);
+    if (lastModified.isValid())
+        request->setHeader(QNetworkRequest::IfModifiedSinceHeader, lastModified);
+}
+
+/*
+    Reads the validators and the expiry date from the headers of \a reply.
+    Cache-Control's max-age takes precedence over Expires, and no-cache or
+    no-store make the tile stale right away.
+*/
+QGeoTileMetadata QGeoTileMetadata::fromNetworkReply(const QNetworkReply *reply)
+{
+    QGeoTileMetadata metadata;
+    metadata.etag = reply->rawHeader("ETag");
+    metadata.lastModified = reply->header(QNetworkRequest::LastModifiedHeader).toDateTime().toUTC();
+
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    const QList<QByteArray> directives = reply->rawHeader("Cache-Control").split(',');
+    for (const QByteArray &directive : directives) {
+        const QByteArray d = directive.trimmed().toLower();
+        if (d == "no-cache" || d == "no-store") {
+            metadata.expires = now;
+            return metadata;
+        }
+        if (d.startsWith("max-age=")) {
+            bool ok = false;
+            const qint64 maxAge = d.mid(8).toLongLong(&ok);
+            if (ok) {
+                metadata.expires = now.addSecs(maxAge);
+                return metadata;
+            }
+        }
+    }
+
+    if (reply->hasRawHeader("Expires")) {
+        // RFC 7231 dates, the only format servers are allowed to send.
+        metadata.expires = QLocale::c().toDateTime(QString::fromLatin1(reply->rawHeader("Expires")),
+                                                   QStringLiteral("ddd, dd MMM yyyy hh:mm:ss 'GMT'"));
+        metadata.expires.setTimeSpec(Qt::UTC);
+        // Invalid dates, such as "0", mean already expired.
+        if (!metadata.expires.isValid())
+            metadata.expires = now;
+    }
+    return metadata;
+}
+
 QAbstractGeoTileCache::QAbstractGeoTileCache(QObject *parent)
     : QObject(parent)
 {
@@ -78,17 +153,100 @@ void QAbstractGeoTileCache::handleError(const QGeoTileSpec &, const QString &err
     qWarning() << "tile request error " << error;
 }
 
-void QAbstractGeoTileCache::setMaxDiskUsage(int diskUsage)
+/*
+    Returns the freshness of the cached tile \a spec. Caches that do not
+    keep metadata return an empty one, and their tiles are never revalidated.
+*/
+QGeoTileMetadata QAbstractGeoTileCache::metadata(const QGeoTileSpec &spec) const
+{
+    Q_UNUSED(spec);
+    return QGeoTileMetadata();
+}
+
+void QAbstractGeoTileCache::setMetadata(const QGeoTileSpec &spec, const QGeoTileMetadata &metadata)
+{
+    Q_UNUSED(spec);
+    Q_UNUSED(metadata);
+}
+
+/*
+    Returns whether the encoded data of tile \a spec is cached, without
+    counting as a use of the tile. Caches that return false here are never
+    used to compose parent tiles.
+*/
+bool QAbstractGeoTileCache::contains(const QGeoTileSpec &spec) const
+{
+    Q_UNUSED(spec);
+    return false;
+}
+
+/*
+    Returns the encoded data of the cached tile \a spec, or an empty array.
+*/
+QByteArray QAbstractGeoTileCache::tileData(const QGeoTileSpec &spec)
+{
+    Q_UNUSED(spec);
+    return QByteArray();
+}
+
+/*
+    Returns a function returning the encoded data of the cached tile
+    \a spec, which may be called on any thread once this returns. Caches
+    keeping tiles on disk only read them when the function is called.
+*/
+QAbstractGeoTileCache::TileReader QAbstractGeoTileCache::tileReader(const QGeoTileSpec &spec)
+{
+    const QByteArray bytes = tileData(spec);
+    return [bytes]() { return bytes; };
+}
+
+/*
+    Caches \a image as the decoded texture of tile \a spec, without any
+    encoded data behind it. A \a provisional texture is shown while the
+    real tile is fetched, and is dropped when the real tile is inserted.
+*/
+QSharedPointer<QGeoTileTexture> QAbstractGeoTileCache::insertTexture(const QGeoTileSpec &spec,
+                                                                     const QImage &image,
+                                                                     bool provisional)
+{
+    Q_UNUSED(spec);
+    Q_UNUSED(image);
+    Q_UNUSED(provisional);
+    return QSharedPointer<QGeoTileTexture>();
+}
+
+/*
+    Returns true if tile \a spec is to be fetched by this process, and false
+    if another process sharing the cache is fetching it already. In that
+    case sharedTileFetched() is emitted once the other process is done, with
+    \a fetched false if it gave up on the tile.
+*/
+bool QAbstractGeoTileCache::claimTileFetch(const QGeoTileSpec &spec)
+{
+    Q_UNUSED(spec);
+    return true;
+}
+
+/*
+    Gives up the fetch of tile \a spec claimed with claimTileFetch() without
+    inserting the tile, letting other processes fetch it.
+*/
+void QAbstractGeoTileCache::releaseTileFetch(const QGeoTileSpec &spec)
+{
+    Q_UNUSED(spec);
+}
+
+void QAbstractGeoTileCache::setMaxDiskUsage(qint64 diskUsage)
 {
     Q_UNUSED(diskUsage);
 }
 
-int QAbstractGeoTileCache::maxDiskUsage() const
+qint64 QAbstractGeoTileCache::maxDiskUsage() const
 {
     return 0;
 }
 
-int QAbstractGeoTileCache::diskUsage() const
+qint64 QAbstractGeoTileCache::diskUsage() const
 {
     return 0;
 }
@@ -59,6 +59,9 @@
 #include "qgeotilespec_p.h"
 
 #include <QImage>
+#include <QDateTime>
+
+#include <functional>
 
 QT_BEGIN_NAMESPACE
 
@@ -69,6 +72,8 @@ class QGeoTile;
 class QAbstractGeoTileCache;
 
 class QThread;
+class QNetworkReply;
+class QNetworkRequest;
 
 /* This is also used in the mapgeometry */
 class Q_LOCATION_PRIVATE_EXPORT QGeoTileTexture
@@ -81,6 +86,23 @@ public:
     QGeoTileSpec spec;
     QImage image;
     bool textureBound;
+    bool provisional;
+};
+
+/* Freshness of a cached tile, and the validators to revalidate it with */
+class Q_LOCATION_PRIVATE_EXPORT QGeoTileMetadata
+{
+public:
+    bool isEmpty() const;
+    bool isStale(const QDateTime &now = QDateTime::currentDateTimeUtc()) const;
+    bool canRevalidate() const;
+
+    void addValidators(QNetworkRequest *request) const;
+    static QGeoTileMetadata fromNetworkReply(const QNetworkReply *reply);
+
+    QByteArray etag;
+    QDateTime lastModified;
+    QDateTime expires;
 };
 
 class Q_LOCATION_PRIVATE_EXPORT QAbstractGeoTileCache : public QObject
@@ -101,9 +123,9 @@ public:
 
     virtual ~QAbstractGeoTileCache();
 
-    virtual void setMaxDiskUsage(int diskUsage);
-    virtual int maxDiskUsage() const;
-    virtual int diskUsage() const;
+    virtual void setMaxDiskUsage(qint64 diskUsage);
+    virtual qint64 maxDiskUsage() const;
+    virtual qint64 diskUsage() const;
 
     virtual void setMaxMemoryUsage(int memoryUsage);
     virtual int maxMemoryUsage() const;
@@ -131,9 +153,27 @@ public:
     virtual void handleError(const QGeoTileSpec &spec, const QString &errorString);
     virtual void init() = 0;
 
+    virtual QGeoTileMetadata metadata(const QGeoTileSpec &spec) const;
+    virtual void setMetadata(const QGeoTileSpec &spec, const QGeoTileMetadata &metadata);
+
+    typedef std::function<QByteArray()> TileReader;
+
+    virtual bool contains(const QGeoTileSpec &spec) const;
+    virtual QByteArray tileData(const QGeoTileSpec &spec);
+    virtual TileReader tileReader(const QGeoTileSpec &spec);
+    virtual QSharedPointer<QGeoTileTexture> insertTexture(const QGeoTileSpec &spec,
+                                                          const QImage &image,
+                                                          bool provisional);
+
+    virtual bool claimTileFetch(const QGeoTileSpec &spec);
+    virtual void releaseTileFetch(const QGeoTileSpec &spec);
+
     static QString baseCacheDirectory();
     static QString baseLocationCacheDirectory();
 
+Q_SIGNALS:
+    void sharedTileFetched(const QGeoTileSpec &spec, bool fetched);
+
 protected:
     QAbstractGeoTileCache(QObject *parent = 0);
     virtual void printStats() = 0;
@@ -145,4 +185,6 @@ Q_DECLARE_OPERATORS_FOR_FLAGS(QAbstractGeoTileCache::CacheAreas)
 
 QT_END_NAMESPACE
 
+Q_DECLARE_METATYPE(QGeoTileMetadata)
+
 #endif // QABSTRACTGEOTILECACHE_P_H
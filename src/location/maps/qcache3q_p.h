@@ -123,7 +123,7 @@ private:
         Key k;
         QSharedPointer<T> v;
         quint64 pop;                // popularity, incremented each ping
-        int cost;
+        qint64 cost;
     };
 
     class Queue
@@ -133,7 +133,7 @@ private:
 
         Node *f;
         Node *l;
-        int cost;               // total cost of nodes on the queue
+        qint64 cost;            // total cost of nodes on the queue
         quint64 pop;            // sum of popularity values on the queue
         int size;               // size of the queue
     };
@@ -145,20 +145,21 @@ private:
     QHash<Key, Node *> lookup_;
 
 public:
-    explicit QCache3Q(int maxCost = 0, int minRecent = -1, int maxOldPopular = -1);
+    explicit QCache3Q(qint64 maxCost = 0, qint64 minRecent = -1, qint64 maxOldPopular = -1);
     inline ~QCache3Q() { clear(); delete q1_; delete q2_; delete q3_; delete q1_evicted_; }
 
-    inline int maxCost() const { return maxCost_; }
-    void setMaxCost(int maxCost, int minRecent = -1, int maxOldPopular = -1);
+    inline qint64 maxCost() const { return maxCost_; }
+    void setMaxCost(qint64 maxCost, qint64 minRecent = -1, qint64 maxOldPopular = -1);
 
     inline int promoteAt() const { return promote_; }
     inline void setPromoteAt(int p) { promote_ = p; }
 
-    inline int totalCost() const { return q1_->cost + q2_->cost + q3_->cost; }
+    inline qint64 totalCost() const { return q1_->cost + q2_->cost + q3_->cost; }
 
     void clear();
-    bool insert(const Key &key, QSharedPointer<T> object, int cost = 1);
+    bool insert(const Key &key, QSharedPointer<T> object, qint64 cost = 1);
     QSharedPointer<T> object(const Key &key) const;
+    bool contains(const Key &key) const;
     QSharedPointer<T> operator[](const Key &key) const;
 
     void remove(const Key &key, bool force = false);
@@ -167,12 +168,12 @@ public:
 
     // Copy data directly into a queue. Designed for single use after construction
     void deserializeQueue(int queueNumber, const QList<Key> &keys,
-                          const QList<QSharedPointer<T> > &values, const QList<int> &costs);
+                          const QList<QSharedPointer<T> > &values, const QList<qint64> &costs);
     // Copy data from specific queue into list
     void serializeQueue(int queueNumber, QList<QSharedPointer<T> > &buffer);
 
 private:
-    int maxCost_, minRecent_, maxOldPopular_;
+    qint64 maxCost_, minRecent_, maxOldPopular_;
     int hitCount_, missCount_, promote_;
 
     void rebalance();
@@ -194,13 +195,13 @@ void QCache3Q<Key,T,EvPolicy>::printStats()
            missCount_,
            100.0 * float(totalCost()) / float(maxCost()));
     qDebug("q1g: size=%d, pop=%llu", q1_evicted_->size, q1_evicted_->pop);
-    qDebug("q1:  cost=%d, size=%d, pop=%llu", q1_->cost, q1_->size, q1_->pop);
-    qDebug("q2:  cost=%d, size=%d, pop=%llu", q2_->cost, q2_->size, q2_->pop);
-    qDebug("q3:  cost=%d, size=%d, pop=%llu", q3_->cost, q3_->size, q3_->pop);
+    qDebug("q1:  cost=%lld, size=%d, pop=%llu", q1_->cost, q1_->size, q1_->pop);
+    qDebug("q2:  cost=%lld, size=%d, pop=%llu", q2_->cost, q2_->size, q2_->pop);
+    qDebug("q3:  cost=%lld, size=%d, pop=%llu", q3_->cost, q3_->size, q3_->pop);
 }
 
 template <class Key, class T, class EvPolicy>
-QCache3Q<Key,T,EvPolicy>::QCache3Q(int maxCost, int minRecent, int maxOldPopular)
+QCache3Q<Key,T,EvPolicy>::QCache3Q(qint64 maxCost, qint64 minRecent, qint64 maxOldPopular)
     : q1_(new Queue), q2_(new Queue), q3_(new Queue), q1_evicted_(new Queue),
       maxCost_(maxCost), minRecent_(minRecent), maxOldPopular_(maxOldPopular),
       hitCount_(0), missCount_(0), promote_(0)
@@ -225,7 +226,7 @@ void QCache3Q<Key,T,EvPolicy>::serializeQueue(int queueNumber, QList<QSharedPoin
 
 template <class Key, class T, class EvPolicy>
 void QCache3Q<Key,T,EvPolicy>::deserializeQueue(int queueNumber, const QList<Key> &keys,
-                       const QList<QSharedPointer<T> > &values, const QList<int> &costs)
+                       const QList<QSharedPointer<T> > &values, const QList<qint64> &costs)
 {
     Q_ASSERT(queueNumber >= 1 && queueNumber <= 4);
     int bufferSize = keys.size();
@@ -248,7 +249,7 @@ void QCache3Q<Key,T,EvPolicy>::deserializeQueue(int queueNumber, const QList<Key
 
 
 template <class Key, class T, class EvPolicy>
-inline void QCache3Q<Key,T,EvPolicy>::setMaxCost(int maxCost, int minRecent, int maxOldPopular)
+inline void QCache3Q<Key,T,EvPolicy>::setMaxCost(qint64 maxCost, qint64 minRecent, qint64 maxOldPopular)
 {
     maxCost_ = maxCost;
     minRecent_ = minRecent;
@@ -261,7 +262,7 @@ inline void QCache3Q<Key,T,EvPolicy>::setMaxCost(int maxCost, int minRecent, int
 }
 
 template <class Key, class T, class EvPolicy>
-bool QCache3Q<Key,T,EvPolicy>::insert(const Key &key, QSharedPointer<T> object, int cost)
+bool QCache3Q<Key,T,EvPolicy>::insert(const Key &key, QSharedPointer<T> object, qint64 cost)
 {
     if (cost > maxCost_) {
         return false;
@@ -430,6 +431,14 @@ QList<Key> QCache3Q<Key,T,EvPolicy>::keys() const
     return lookup_.keys();
 }
 
+// Unlike object(), does not count as a use of the entry.
+template <class Key, class T, class EvPolicy>
+bool QCache3Q<Key,T,EvPolicy>::contains(const Key &key) const
+{
+    const Node *n = lookup_.value(key, 0);
+    return n && n->q != q1_evicted_;
+}
+
 template <class Key, class T, class EvPolicy>
 QSharedPointer<T> QCache3Q<Key,T,EvPolicy>::object(const Key &key) const
 {
@@ -0,0 +1,331 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QCONCURRENTCACHE3Q_P_H
+#define QCONCURRENTCACHE3Q_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+
+#include <QtLocation/private/qcache3q_p.h>
+#include <QtCore/qatomic.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+ * QConcurrentCache3Q
+ *
+ * A QCache3Q that can be used from several threads at once. The keys are
+ * spread over a number of shards by their hash, and each shard is a QCache3Q
+ * of its own behind its own mutex, so that threads working on different
+ * shards do not wait for each other. The maximum cost is split evenly
+ * between the shards, which otherwise follow the 3Q policy described for
+ * QCache3Q. An object costing more than the share of its shard is still
+ * admitted up to the maximum cost of the whole cache: the shard borrows the
+ * difference from the others, first from those holding more than their
+ * share, so that the shards never hold more than the maximum together.
+ *
+ * The eviction policy is called with the shard of the key locked, so it
+ * must not call back into the cache. The same goes for the destructors of
+ * the objects, which may run when they are evicted.
+ */
+template <class Key, class T, class EvPolicy = QCache3QDefaultEvictionPolicy<Key,T> >
+class QConcurrentCache3Q
+{
+public:
+    explicit QConcurrentCache3Q(qint64 maxCost = 0, int shardCount = 8);
+    inline ~QConcurrentCache3Q() { delete[] shards_; }
+
+    inline int shardCount() const { return shardCount_; }
+
+    qint64 maxCost() const;
+    void setMaxCost(qint64 maxCost);
+
+    int promoteAt() const;
+    void setPromoteAt(int p);
+
+    qint64 totalCost() const;
+
+    void clear();
+    bool insert(const Key &key, QSharedPointer<T> object, qint64 cost = 1);
+    QSharedPointer<T> object(const Key &key) const;
+    bool contains(const Key &key) const;
+    QSharedPointer<T> operator[](const Key &key) const;
+
+    void remove(const Key &key, bool force = false);
+    QList<Key> keys() const;
+    void printStats();
+
+    // Copy data directly into a queue. Designed for single use after construction
+    void deserializeQueue(int queueNumber, const QList<Key> &keys,
+                          const QList<QSharedPointer<T> > &values, const QList<qint64> &costs);
+    // Copy data from specific queue into list
+    void serializeQueue(int queueNumber, QList<QSharedPointer<T> > &buffer);
+
+private:
+    struct Shard
+    {
+        mutable QMutex mutex;
+        QCache3Q<Key,T,EvPolicy> cache;
+    };
+
+    inline Shard &shardFor(const Key &key) const
+    { return shards_[qHash(key) % uint(shardCount_)]; }
+    void borrowCost(int shard, qint64 cost);
+    inline qint64 shardMaxCost(qint64 maxCost, int shard) const
+    { return maxCost / shardCount_ + (shard < maxCost % shardCount_ ? 1 : 0); }
+
+    Shard *shards_;
+    int shardCount_;
+    // Read without locking. It and the budgets of the shards are only
+    // changed with costMutex_ held, so that the budgets add up to it.
+    QAtomicInteger<qint64> maxCost_;
+    QMutex costMutex_;
+
+    Q_DISABLE_COPY(QConcurrentCache3Q)
+};
+
+template <class Key, class T, class EvPolicy>
+QConcurrentCache3Q<Key,T,EvPolicy>::QConcurrentCache3Q(qint64 maxCost, int shardCount)
+    : shards_(new Shard[qMax(1, shardCount)]), shardCount_(qMax(1, shardCount)), maxCost_(0)
+{
+    setMaxCost(maxCost);
+}
+
+template <class Key, class T, class EvPolicy>
+qint64 QConcurrentCache3Q<Key,T,EvPolicy>::maxCost() const
+{
+    return maxCost_.load();
+}
+
+template <class Key, class T, class EvPolicy>
+void QConcurrentCache3Q<Key,T,EvPolicy>::setMaxCost(qint64 maxCost)
+{
+    QMutexLocker costLocker(&costMutex_);
+    maxCost_.store(maxCost);
+    for (int i = 0; i < shardCount_; ++i) {
+        QMutexLocker locker(&shards_[i].mutex);
+        shards_[i].cache.setMaxCost(shardMaxCost(maxCost, i));
+    }
+}
+
+template <class Key, class T, class EvPolicy>
+int QConcurrentCache3Q<Key,T,EvPolicy>::promoteAt() const
+{
+    QMutexLocker locker(&shards_[0].mutex);
+    return shards_[0].cache.promoteAt();
+}
+
+template <class Key, class T, class EvPolicy>
+void QConcurrentCache3Q<Key,T,EvPolicy>::setPromoteAt(int p)
+{
+    for (int i = 0; i < shardCount_; ++i) {
+        QMutexLocker locker(&shards_[i].mutex);
+        shards_[i].cache.setPromoteAt(p);
+    }
+}
+
+template <class Key, class T, class EvPolicy>
+qint64 QConcurrentCache3Q<Key,T,EvPolicy>::totalCost() const
+{
+    qint64 cost = 0;
+    for (int i = 0; i < shardCount_; ++i) {
+        QMutexLocker locker(&shards_[i].mutex);
+        cost += shards_[i].cache.totalCost();
+    }
+    return cost;
+}
+
+template <class Key, class T, class EvPolicy>
+void QConcurrentCache3Q<Key,T,EvPolicy>::clear()
+{
+    for (int i = 0; i < shardCount_; ++i) {
+        QMutexLocker locker(&shards_[i].mutex);
+        shards_[i].cache.clear();
+    }
+}
+
+template <class Key, class T, class EvPolicy>
+bool QConcurrentCache3Q<Key,T,EvPolicy>::insert(const Key &key, QSharedPointer<T> object, qint64 cost)
+{
+    if (cost > maxCost_.load())
+        return false;
+
+    Shard &shard = shardFor(key);
+    {
+        QMutexLocker locker(&shard.mutex);
+        if (cost <= shard.cache.maxCost())
+            return shard.cache.insert(key, object, cost);
+    }
+
+    QMutexLocker costLocker(&costMutex_);
+    if (cost > maxCost_.load())
+        return false;
+    borrowCost(int(&shard - shards_), cost);
+    QMutexLocker locker(&shard.mutex);
+    return shard.cache.insert(key, object, cost);
+}
+
+// Raises the budget of the shard to the cost of the object it is to hold,
+// lowering the budgets of the others by as much. Called with costMutex_ held.
+template <class Key, class T, class EvPolicy>
+void QConcurrentCache3Q<Key,T,EvPolicy>::borrowCost(int shard, qint64 cost)
+{
+    qint64 budget;
+    {
+        QMutexLocker locker(&shards_[shard].mutex);
+        budget = shards_[shard].cache.maxCost();
+    }
+    if (cost <= budget)
+        return;
+
+    // The budgets add up to the maximum cost, which is at least the cost of
+    // the object, so the others always have enough to lend.
+    const qint64 maxCost = maxCost_.load();
+    qint64 missing = cost - budget;
+    for (int pass = 0; pass < 2 && missing > 0; ++pass) {
+        for (int i = 0; i < shardCount_ && missing > 0; ++i) {
+            if (i == shard)
+                continue;
+            QMutexLocker locker(&shards_[i].mutex);
+            const qint64 current = shards_[i].cache.maxCost();
+            const qint64 keep = pass == 0 ? shardMaxCost(maxCost, i) : 0;
+            const qint64 lent = qMin(missing, current - keep);
+            if (lent <= 0)
+                continue;
+            shards_[i].cache.setMaxCost(current - lent);
+            missing -= lent;
+        }
+    }
+
+    QMutexLocker locker(&shards_[shard].mutex);
+    shards_[shard].cache.setMaxCost(cost - missing);
+}
+
+template <class Key, class T, class EvPolicy>
+QSharedPointer<T> QConcurrentCache3Q<Key,T,EvPolicy>::object(const Key &key) const
+{
+    Shard &shard = shardFor(key);
+    QMutexLocker locker(&shard.mutex);
+    return shard.cache.object(key);
+}
+
+// Unlike object(), does not count as a use of the entry.
+template <class Key, class T, class EvPolicy>
+bool QConcurrentCache3Q<Key,T,EvPolicy>::contains(const Key &key) const
+{
+    Shard &shard = shardFor(key);
+    QMutexLocker locker(&shard.mutex);
+    return shard.cache.contains(key);
+}
+
+template <class Key, class T, class EvPolicy>
+inline QSharedPointer<T> QConcurrentCache3Q<Key,T,EvPolicy>::operator[](const Key &key) const
+{
+    return object(key);
+}
+
+template <class Key, class T, class EvPolicy>
+void QConcurrentCache3Q<Key,T,EvPolicy>::remove(const Key &key, bool force)
+{
+    Shard &shard = shardFor(key);
+    QMutexLocker locker(&shard.mutex);
+    shard.cache.remove(key, force);
+}
+
+template <class Key, class T, class EvPolicy>
+QList<Key> QConcurrentCache3Q<Key,T,EvPolicy>::keys() const
+{
+    QList<Key> keys;
+    for (int i = 0; i < shardCount_; ++i) {
+        QMutexLocker locker(&shards_[i].mutex);
+        keys += shards_[i].cache.keys();
+    }
+    return keys;
+}
+
+template <class Key, class T, class EvPolicy>
+void QConcurrentCache3Q<Key,T,EvPolicy>::printStats()
+{
+    for (int i = 0; i < shardCount_; ++i) {
+        QMutexLocker locker(&shards_[i].mutex);
+        shards_[i].cache.printStats();
+    }
+}
+
+template <class Key, class T, class EvPolicy>
+void QConcurrentCache3Q<Key,T,EvPolicy>::deserializeQueue(int queueNumber, const QList<Key> &keys,
+                                                          const QList<QSharedPointer<T> > &values,
+                                                          const QList<qint64> &costs)
+{
+    QVector<QList<Key> > shardKeys(shardCount_);
+    QVector<QList<QSharedPointer<T> > > shardValues(shardCount_);
+    QVector<QList<qint64> > shardCosts(shardCount_);
+    for (int i = 0; i < keys.size(); ++i) {
+        const int shard = int(qHash(keys.at(i)) % uint(shardCount_));
+        shardKeys[shard].append(keys.at(i));
+        shardValues[shard].append(values.at(i));
+        shardCosts[shard].append(costs.at(i));
+    }
+
+    for (int i = 0; i < shardCount_; ++i) {
+        QMutexLocker locker(&shards_[i].mutex);
+        shards_[i].cache.deserializeQueue(queueNumber, shardKeys.at(i), shardValues.at(i),
+                                          shardCosts.at(i));
+    }
+}
+
+template <class Key, class T, class EvPolicy>
+void QConcurrentCache3Q<Key,T,EvPolicy>::serializeQueue(int queueNumber, QList<QSharedPointer<T> > &buffer)
+{
+    for (int i = 0; i < shardCount_; ++i) {
+        QMutexLocker locker(&shards_[i].mutex);
+        shards_[i].cache.serializeQueue(queueNumber, buffer);
+    }
+}
+
+QT_END_NAMESPACE
+
+#endif // QCONCURRENTCACHE3Q_P_H
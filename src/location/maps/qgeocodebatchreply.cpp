@@ -0,0 +1,281 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeocodebatchreply.h"
+#include "qgeocodebatchreply_p.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QGeoCodeBatchReply
+    \inmodule QtLocation
+    \ingroup QtLocation-geocoding
+    \since 5.12
+
+    \brief The QGeoCodeBatchReply class manages a batch of geocoding or
+    reverse geocoding operations started by an instance of QGeoCodingManager.
+
+    A batch reply holds one result per address or coordinate of the batch, in
+    the order they were passed to QGeoCodingManager. The results of each item
+    are available with itemLocations() as soon as itemFinished() has been
+    emitted for it, and each item fails or succeeds on its own, as reported by
+    itemError() and itemErrorString().
+
+    The reply itself finishes once every item has finished. error() is only set
+    when the batch as a whole failed, for instance when the service could not
+    be reached. locations() is left empty.
+
+    \sa QGeoCodingManager
+*/
+
+/*!
+    Constructs a batch reply with a given \a error and \a errorString and the
+    specified \a parent. The reply is finished and has no items.
+*/
+QGeoCodeBatchReply::QGeoCodeBatchReply(Error error, const QString &errorString, QObject *parent)
+    : QGeoCodeReply(error, errorString, parent),
+      d_ptr(new QGeoCodeBatchReplyPrivate)
+{
+}
+
+/*!
+    Constructs a batch reply of \a count items with the specified \a parent.
+*/
+QGeoCodeBatchReply::QGeoCodeBatchReply(int count, QObject *parent)
+    : QGeoCodeReply(parent),
+      d_ptr(new QGeoCodeBatchReplyPrivate)
+{
+    d_ptr->items.resize(qMax(0, count));
+}
+
+/*!
+    Destroys this reply object.
+*/
+QGeoCodeBatchReply::~QGeoCodeBatchReply()
+{
+    delete d_ptr;
+}
+
+/*!
+    Returns the number of items in the batch.
+*/
+int QGeoCodeBatchReply::count() const
+{
+    return d_ptr->items.size();
+}
+
+/*!
+    Returns whether the item at \a index has finished.
+*/
+bool QGeoCodeBatchReply::isItemFinished(int index) const
+{
+    return d_ptr->items.value(index).finished;
+}
+
+/*!
+    Returns the locations found for the item at \a index.
+*/
+QList<QGeoLocation> QGeoCodeBatchReply::itemLocations(int index) const
+{
+    return d_ptr->items.value(index).locations;
+}
+
+/*!
+    Returns the error of the item at \a index.
+*/
+QGeoCodeReply::Error QGeoCodeBatchReply::itemError(int index) const
+{
+    return d_ptr->items.value(index).error;
+}
+
+/*!
+    Returns the textual representation of the error of the item at \a index.
+*/
+QString QGeoCodeBatchReply::itemErrorString(int index) const
+{
+    return d_ptr->items.value(index).errorString;
+}
+
+/*!
+    Sets the locations found for the item at \a index to \a locations, and
+    marks the item as finished.
+*/
+void QGeoCodeBatchReply::setItemLocations(int index, const QList<QGeoLocation> &locations)
+{
+    if (index < 0 || index >= d_ptr->items.size())
+        return;
+
+    QGeoCodeBatchReplyPrivate::Item &item = d_ptr->items[index];
+    item.locations = locations;
+    item.finished = true;
+    emit itemFinished(index);
+}
+
+/*!
+    Sets the error of the item at \a index to \a error, with the description
+    \a errorString, and marks the item as finished.
+*/
+void QGeoCodeBatchReply::setItemError(int index, Error error, const QString &errorString)
+{
+    if (index < 0 || index >= d_ptr->items.size())
+        return;
+
+    QGeoCodeBatchReplyPrivate::Item &item = d_ptr->items[index];
+    item.error = error;
+    item.errorString = errorString;
+    item.finished = true;
+    emit itemFinished(index);
+}
+
+/*!
+    Finishes the reply once all of its items have finished. The reply
+    succeeds if at least one item succeeded or the batch is empty, and fails
+    with the error of the first item otherwise.
+*/
+void QGeoCodeBatchReply::finishBatch()
+{
+    for (int i = 0; i < count(); ++i) {
+        if (itemError(i) == NoError) {
+            setFinished(true);
+            return;
+        }
+    }
+    if (count() > 0)
+        setError(itemError(0), itemErrorString(0));
+    else
+        setFinished(true);
+}
+
+/*!
+    \fn void QGeoCodeBatchReply::itemFinished(int index)
+
+    This signal is emitted when the item at \a index has finished, with or
+    without an error.
+*/
+
+QGeoCodePipelinedBatchReply::QGeoCodePipelinedBatchReply(int count, int concurrency,
+                                                         SendFunction send, QObject *parent)
+    : QGeoCodeBatchReply(count, parent),
+      m_send(send),
+      m_concurrency(qMax(1, concurrency))
+{
+}
+
+QGeoCodePipelinedBatchReply::~QGeoCodePipelinedBatchReply()
+{
+    releasePending();
+}
+
+/*
+    Sends the first requests. This is separate from the constructor so that
+    the caller can connect to the reply first.
+*/
+void QGeoCodePipelinedBatchReply::start()
+{
+    sendNext();
+}
+
+void QGeoCodePipelinedBatchReply::abort()
+{
+    m_aborted = true;
+    releasePending();
+    QGeoCodeBatchReply::abort();
+}
+
+void QGeoCodePipelinedBatchReply::sendNext()
+{
+    if (m_sending || m_aborted)
+        return;
+
+    m_sending = true;
+    while (m_pending.size() < m_concurrency && m_next < count()) {
+        const int index = m_next++;
+        QGeoCodeReply *reply = m_send(index);
+        if (!reply) {
+            setItemError(index, UnknownError, QStringLiteral("No reply for this item"));
+            ++m_done;
+        } else if (reply->isFinished()) {
+            collect(index, reply);
+        } else {
+            m_pending.insert(reply, index);
+            connect(reply, &QGeoCodeReply::finished, this, [this, reply]() {
+                const auto it = m_pending.find(reply);
+                if (it == m_pending.end())
+                    return;
+                const int index = it.value();
+                m_pending.erase(it);
+                collect(index, reply);
+                sendNext();
+            });
+        }
+    }
+    m_sending = false;
+
+    if (m_done < count() || m_finishing)
+        return;
+
+    // Finish from the event loop, so that a batch whose items all finish
+    // while it is being started does not finish before its caller returns.
+    m_finishing = true;
+    QMetaObject::invokeMethod(this, [this]() {
+        if (!m_aborted)
+            finishBatch();
+    }, Qt::QueuedConnection);
+}
+
+void QGeoCodePipelinedBatchReply::collect(int index, QGeoCodeReply *reply)
+{
+    disconnect(reply, nullptr, this, nullptr);
+    if (reply->error() != NoError)
+        setItemError(index, reply->error(), reply->errorString());
+    else
+        setItemLocations(index, reply->locations());
+    reply->deleteLater();
+    ++m_done;
+}
+
+void QGeoCodePipelinedBatchReply::releasePending()
+{
+    const QList<QGeoCodeReply *> pending = m_pending.keys();
+    m_pending.clear();
+    for (QGeoCodeReply *reply : pending) {
+        disconnect(reply, nullptr, this, nullptr);
+        reply->abort();
+        reply->deleteLater();
+    }
+}
+
+QT_END_NAMESPACE
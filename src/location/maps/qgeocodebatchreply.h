@@ -0,0 +1,77 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOCODEBATCHREPLY_H
+#define QGEOCODEBATCHREPLY_H
+
+#include <QtLocation/QGeoCodeReply>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoCodeBatchReplyPrivate;
+
+class Q_LOCATION_EXPORT QGeoCodeBatchReply : public QGeoCodeReply
+{
+    Q_OBJECT
+
+public:
+    explicit QGeoCodeBatchReply(Error error, const QString &errorString, QObject *parent = nullptr);
+    ~QGeoCodeBatchReply();
+
+    int count() const;
+    bool isItemFinished(int index) const;
+    QList<QGeoLocation> itemLocations(int index) const;
+    Error itemError(int index) const;
+    QString itemErrorString(int index) const;
+
+Q_SIGNALS:
+    void itemFinished(int index);
+
+protected:
+    explicit QGeoCodeBatchReply(int count, QObject *parent = nullptr);
+
+    void setItemLocations(int index, const QList<QGeoLocation> &locations);
+    void setItemError(int index, Error error, const QString &errorString);
+    void finishBatch();
+
+private:
+    QGeoCodeBatchReplyPrivate *d_ptr;
+    Q_DISABLE_COPY(QGeoCodeBatchReply)
+};
+
+QT_END_NAMESPACE
+
+#endif
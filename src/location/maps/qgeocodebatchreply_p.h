@@ -0,0 +1,114 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOCODEBATCHREPLY_P_H
+#define QGEOCODEBATCHREPLY_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtLocation/private/qlocationglobal_p.h>
+#include "qgeocodebatchreply.h"
+
+#include <QtCore/QHash>
+#include <QtCore/QVector>
+#include <QtPositioning/QGeoLocation>
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoCodeBatchReplyPrivate
+{
+public:
+    struct Item
+    {
+        QList<QGeoLocation> locations;
+        QGeoCodeReply::Error error = QGeoCodeReply::NoError;
+        QString errorString;
+        bool finished = false;
+    };
+
+    QVector<Item> items;
+};
+
+/*
+    Batch reply for engines without a native batch service. It sends one
+    request per item through the engine, with at most \c concurrency of them
+    in flight at any time, and collects their results in item order.
+
+    The reply finishes once every item has finished. It fails with the error
+    of the first item if no item succeeded.
+*/
+class Q_LOCATION_PRIVATE_EXPORT QGeoCodePipelinedBatchReply : public QGeoCodeBatchReply
+{
+    Q_OBJECT
+
+public:
+    typedef std::function<QGeoCodeReply *(int index)> SendFunction;
+
+    QGeoCodePipelinedBatchReply(int count, int concurrency, SendFunction send,
+                                QObject *parent = nullptr);
+    ~QGeoCodePipelinedBatchReply();
+
+    void start();
+    void abort() override;
+
+private:
+    void sendNext();
+    void collect(int index, QGeoCodeReply *reply);
+    void releasePending();
+
+    SendFunction m_send;
+    QHash<QGeoCodeReply *, int> m_pending;
+    int m_concurrency;
+    int m_next = 0;
+    int m_done = 0;
+    bool m_sending = false;
+    bool m_aborted = false;
+    bool m_finishing = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOCODEBATCHREPLY_P_H
@@ -36,6 +36,9 @@
 
 #include "qgeocodereply.h"
 #include "qgeocodereply_p.h"
+#include "qgeoparsetask_p.h"
+
+#include <QtCore/QSharedPointer>
 
 QT_BEGIN_NAMESPACE
 /*!
@@ -335,4 +338,35 @@ QGeoCodeReplyPrivate::QGeoCodeReplyPrivate(QGeoCodeReply::Error error, const QSt
 
 QGeoCodeReplyPrivate::~QGeoCodeReplyPrivate() {}
 
+/*
+    Runs \a parse on a worker thread and delivers its outcome to \a reply through
+    setLocations() and setFinished(), or setError(), once back in the thread of the
+    reply. Nothing is delivered if the reply is aborted or destroyed meanwhile.
+    \a parse must not access the reply.
+*/
+void QGeoCodeReplyPrivate::parseAsync(QGeoCodeReply *reply, ParseFunction parse)
+{
+    struct Result
+    {
+        QGeoCodeReply::Error error = QGeoCodeReply::NoError;
+        QString errorString;
+        QList<QGeoLocation> locations;
+    };
+    QSharedPointer<Result> result(new Result);
+
+    const QGeoParseTask::Handle task = QGeoParseTask::start(reply,
+        [result, parse]() {
+            result->error = parse(result->locations, result->errorString);
+        },
+        [reply, result]() {
+            if (result->error == QGeoCodeReply::NoError) {
+                reply->setLocations(result->locations);
+                reply->setFinished(true);
+            } else {
+                reply->setError(result->error, result->errorString);
+            }
+        });
+    QObject::connect(reply, &QGeoCodeReply::aborted, reply, [task]() { task.cancel(); });
+}
+
 QT_END_NAMESPACE
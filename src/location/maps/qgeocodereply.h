@@ -98,6 +98,7 @@ protected:
 
 private:
     QGeoCodeReplyPrivate *d_ptr;
+    friend class QGeoCodeReplyPrivate;
     Q_DISABLE_COPY(QGeoCodeReply)
 };
 
@@ -48,23 +48,28 @@
 // We mean it.
 //
 
+#include <QtLocation/private/qlocationglobal_p.h>
 #include "qgeocodereply.h"
 
 #include "qgeoshape.h"
 
 #include <QList>
+#include <functional>
 
 QT_BEGIN_NAMESPACE
 
 class QGeoLocation;
 
-class QGeoCodeReplyPrivate
+class Q_LOCATION_PRIVATE_EXPORT QGeoCodeReplyPrivate
 {
 public:
     QGeoCodeReplyPrivate();
     QGeoCodeReplyPrivate(QGeoCodeReply::Error error, const QString &errorString);
     ~QGeoCodeReplyPrivate();
 
+    typedef std::function<QGeoCodeReply::Error (QList<QGeoLocation> &locations, QString &errorString)> ParseFunction;
+    static void parseAsync(QGeoCodeReply *reply, ParseFunction parse);
+
     QGeoCodeReply::Error error;
     QString errorString;
     bool isFinished;
@@ -0,0 +1,91 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOCODINGBATCHENGINE_P_H
+#define QGEOCODINGBATCHENGINE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtLocation/private/qlocationglobal_p.h>
+#include <QtCore/QObject>
+#include <QtCore/QList>
+#include <QtCore/QStringList>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoAddress;
+class QGeoCoordinate;
+class QGeoShape;
+class QGeoCodeBatchReply;
+
+/*
+    Interface for geocoding engines that can map batches onto a native batch
+    service. An engine implements it next to QGeoCodingManagerEngine and lists
+    it in Q_INTERFACES, QGeoCodingManager finds it with qobject_cast.
+
+    Each function may return null, for instance when the service only offers
+    batches for some operations or when they need credentials the plugin was
+    not given. QGeoCodingManager then sends the items one by one through the
+    engine instead.
+*/
+class Q_LOCATION_PRIVATE_EXPORT QGeoCodingBatchEngine
+{
+public:
+    virtual ~QGeoCodingBatchEngine();
+
+    virtual QGeoCodeBatchReply *geocodeBatch(const QList<QGeoAddress> &addresses,
+                                             const QGeoShape &bounds);
+    virtual QGeoCodeBatchReply *geocodeBatch(const QStringList &addresses, int limit,
+                                             const QGeoShape &bounds);
+    virtual QGeoCodeBatchReply *reverseGeocodeBatch(const QList<QGeoCoordinate> &coordinates,
+                                                    const QGeoShape &bounds);
+};
+
+#define QGeoCodingBatchEngine_iid "org.qt-project.qt.location.geocodingbatchengine/5.12"
+Q_DECLARE_INTERFACE(QGeoCodingBatchEngine, QGeoCodingBatchEngine_iid)
+
+QT_END_NAMESPACE
+
+#endif // QGEOCODINGBATCHENGINE_P_H
@@ -37,6 +37,9 @@
 #include "qgeocodingmanager.h"
 #include "qgeocodingmanager_p.h"
 #include "qgeocodingmanagerengine.h"
+#include "qgeoservicecache_p.h"
+#include "qgeocodebatchreply_p.h"
+#include "qgeocodingbatchengine_p.h"
 
 #include "qgeorectangle.h"
 #include "qgeocircle.h"
@@ -65,6 +68,11 @@ QT_BEGIN_NAMESPACE
     geocoding operation, if the string provided can be interpreted as
     an address it can be geocoded to coordinate information.
 
+    Lists of addresses or coordinates can be geocoded in one operation with the
+    overloads returning a QGeoCodeBatchReply. Plugins map these onto the batch
+    service of their provider where there is one, otherwise the items are sent
+    one by one with a bounded number of requests in flight.
+
     Instances of QGeoCodingManager can be accessed with
     QGeoServiceProvider::geocodingManager().
 */
@@ -85,15 +93,24 @@ QGeoCodingManager::QGeoCodingManager(QGeoCodingManagerEngine *engine, QObject *p
     if (d_ptr->engine) {
         d_ptr->engine->setParent(this);
 
-        connect(d_ptr->engine,
-                SIGNAL(finished(QGeoCodeReply*)),
-                this,
-                SIGNAL(finished(QGeoCodeReply*)));
-
-        connect(d_ptr->engine,
-                SIGNAL(error(QGeoCodeReply*,QGeoCodeReply::Error,QString)),
-                this,
-                SIGNAL(error(QGeoCodeReply*,QGeoCodeReply::Error,QString)));
+        // Replies the response cache requested on behalf of its callers
+        // are reported through the replies it handed out instead.
+        // The same goes for the items of pipelined batches.
+        connect(d_ptr->engine, &QGeoCodingManagerEngine::finished,
+                this, [this](QGeoCodeReply *reply) {
+            if (d_ptr->isBatchItem(reply))
+                return;
+            if (!d_ptr->cache || !d_ptr->cache->isUpstream(reply))
+                emit finished(reply);
+        });
+
+        connect(d_ptr->engine, &QGeoCodingManagerEngine::error,
+                this, [this](QGeoCodeReply *reply, QGeoCodeReply::Error error, const QString &errorString) {
+            if (d_ptr->isBatchItem(reply))
+                return;
+            if (!d_ptr->cache || !d_ptr->cache->isUpstream(reply))
+                emit this->error(reply, error, errorString);
+        });
     } else {
         qFatal("The geocoding manager engine that was set for this geocoding manager was NULL.");
     }
@@ -170,6 +187,12 @@ int QGeoCodingManager::managerVersion() const
 */
 QGeoCodeReply *QGeoCodingManager::geocode(const QGeoAddress &address, const QGeoShape &bounds)
 {
+    if (d_ptr->cache) {
+        return d_ptr->cache->geocode(QGeoServiceCache::geocodeKey(address, bounds, locale()), this,
+                                     [this, address, bounds]() {
+            return d_ptr->engine->geocode(address, bounds);
+        });
+    }
     return d_ptr->engine->geocode(address, bounds);
 }
 
@@ -212,6 +235,12 @@ QGeoCodeReply *QGeoCodingManager::geocode(const QGeoAddress &address, const QGeo
 */
 QGeoCodeReply *QGeoCodingManager::reverseGeocode(const QGeoCoordinate &coordinate, const QGeoShape &bounds)
 {
+    if (d_ptr->cache) {
+        return d_ptr->cache->geocode(QGeoServiceCache::reverseGeocodeKey(coordinate, bounds, locale()), this,
+                                     [this, coordinate, bounds]() {
+            return d_ptr->engine->reverseGeocode(coordinate, bounds);
+        });
+    }
     return d_ptr->engine->reverseGeocode(coordinate, bounds);
 }
 
@@ -249,6 +278,13 @@ QGeoCodeReply *QGeoCodingManager::geocode(const QString &address,
         int offset,
         const QGeoShape &bounds)
 {
+    if (d_ptr->cache) {
+        return d_ptr->cache->geocode(QGeoServiceCache::geocodeKey(address, limit, offset, bounds, locale()),
+                                     this, [this, address, limit, offset, bounds]() {
+            return d_ptr->engine->geocode(address, limit, offset, bounds);
+        });
+    }
+
     QGeoCodeReply *reply = d_ptr->engine->geocode(address,
                              limit,
                              offset,
@@ -256,6 +292,95 @@ QGeoCodeReply *QGeoCodingManager::geocode(const QString &address,
     return reply;
 }
 
+/*!
+    \since 5.12
+
+    Begins the geocoding of each address in \a addresses, as one operation.
+
+    A QGeoCodeBatchReply object will be returned, which holds the results of
+    each address in the same order as \a addresses. The results of an address
+    are the same as those geocode() would have returned for it, and an address
+    that cannot be geocoded does not make the whole batch fail.
+
+    If the plugin's provider has a batch geocoding service, the batch is sent
+    to it in as few requests as it allows. Otherwise the addresses are geocoded
+    one by one, with at most \c geocoding.batch.concurrency requests in flight
+    at the same time, 4 by default. Batches do not use the response cache.
+
+    If \a bounds is non-null and is a valid QGeoShape it will be used to
+    limit the results to those that are contained within \a bounds.
+
+    This manager and the returned reply emit finished() once, when every
+    address has been processed. QGeoCodeBatchReply::itemFinished() reports
+    the progress in between.
+
+    The user is responsible for deleting the returned reply object.
+*/
+QGeoCodeBatchReply *QGeoCodingManager::geocode(const QList<QGeoAddress> &addresses,
+                                               const QGeoShape &bounds)
+{
+    if (QGeoCodingBatchEngine *batchEngine = qobject_cast<QGeoCodingBatchEngine *>(d_ptr->engine)) {
+        if (QGeoCodeBatchReply *reply = batchEngine->geocodeBatch(addresses, bounds))
+            return reply;
+    }
+
+    return d_ptr->sendPipelined(this, addresses.size(), [this, addresses, bounds](int index) {
+        return d_ptr->engine->geocode(addresses.at(index), bounds);
+    });
+}
+
+/*!
+    \since 5.12
+
+    Begins the geocoding of each free text address in \a addresses, as one
+    operation. At most \a limit results are returned for each address, or all
+    of them if \a limit is -1.
+
+    The results are reported as with the QGeoAddress overload. Some batch
+    services only return the best match for each address whatever \a limit is.
+
+    If \a bounds is non-null and a valid QGeoShape it will be used to
+    limit the results to those that are contained within \a bounds.
+*/
+QGeoCodeBatchReply *QGeoCodingManager::geocode(const QStringList &addresses, int limit,
+                                               const QGeoShape &bounds)
+{
+    if (QGeoCodingBatchEngine *batchEngine = qobject_cast<QGeoCodingBatchEngine *>(d_ptr->engine)) {
+        if (QGeoCodeBatchReply *reply = batchEngine->geocodeBatch(addresses, limit, bounds))
+            return reply;
+    }
+
+    return d_ptr->sendPipelined(this, addresses.size(), [this, addresses, limit, bounds](int index) {
+        return d_ptr->engine->geocode(addresses.at(index), limit, 0, bounds);
+    });
+}
+
+/*!
+    \since 5.12
+
+    Begins the reverse geocoding of each coordinate in \a coordinates, as one
+    operation.
+
+    The results are reported as with the geocoding of a list of addresses,
+    with the results of each coordinate being those reverseGeocode() would have
+    returned for it.
+
+    If \a bounds is non-null and a valid QGeoShape it will be used to
+    limit the results to those that are contained within \a bounds.
+*/
+QGeoCodeBatchReply *QGeoCodingManager::reverseGeocode(const QList<QGeoCoordinate> &coordinates,
+                                                      const QGeoShape &bounds)
+{
+    if (QGeoCodingBatchEngine *batchEngine = qobject_cast<QGeoCodingBatchEngine *>(d_ptr->engine)) {
+        if (QGeoCodeBatchReply *reply = batchEngine->reverseGeocodeBatch(coordinates, bounds))
+            return reply;
+    }
+
+    return d_ptr->sendPipelined(this, coordinates.size(), [this, coordinates, bounds](int index) {
+        return d_ptr->engine->reverseGeocode(coordinates.at(index), bounds);
+    });
+}
+
 /*!
     Sets the locale to be used by this manager to \a locale.
 
@@ -312,13 +437,51 @@ QLocale QGeoCodingManager::locale() const
 *******************************************************************************/
 
 QGeoCodingManagerPrivate::QGeoCodingManagerPrivate()
-    : engine(0) {}
+    : engine(0), cache(0) {}
 
 QGeoCodingManagerPrivate::~QGeoCodingManagerPrivate()
 {
     delete engine;
 }
 
+QGeoCodeBatchReply *QGeoCodingManagerPrivate::sendPipelined(QGeoCodingManager *manager, int count,
+                                                            const std::function<QGeoCodeReply *(int)> &send)
+{
+    QGeoCodePipelinedBatchReply *reply = new QGeoCodePipelinedBatchReply(count, batchConcurrency,
+        [this, manager, send](int index) {
+            ++sendingBatchItems;
+            QGeoCodeReply *item = send(index);
+            --sendingBatchItems;
+            if (item && !item->isFinished()) {
+                batchItems.insert(item);
+                QObject::connect(item, &QObject::destroyed, manager, [this, item]() {
+                    batchItems.remove(item);
+                });
+            }
+            return item;
+        }, engine);
+
+    QObject::connect(reply, &QGeoCodeReply::finished, manager, [manager, reply]() {
+        emit manager->finished(reply);
+    });
+    QObject::connect(reply, QOverload<QGeoCodeReply::Error, const QString &>::of(&QGeoCodeReply::error),
+                     manager, [manager, reply](QGeoCodeReply::Error error, const QString &errorString) {
+        emit manager->error(reply, error, errorString);
+    });
+
+    reply->start();
+    return reply;
+}
+
+/*
+    Returns true if \a reply was sent for an item of a pipelined batch. Engines
+    may report a reply before returning it, hence the counter.
+*/
+bool QGeoCodingManagerPrivate::isBatchItem(QGeoCodeReply *reply) const
+{
+    return sendingBatchItems > 0 || batchItems.contains(reply);
+}
+
 /*******************************************************************************
 *******************************************************************************/
 
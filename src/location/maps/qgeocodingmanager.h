@@ -38,11 +38,13 @@
 #define QGEOCODINGMANAGER_H
 
 #include <QtLocation/QGeoCodeReply>
+#include <QtLocation/QGeoCodeBatchReply>
 #include <QtPositioning/QGeoRectangle>
 
 #include <QtCore/QObject>
 #include <QtCore/QList>
 #include <QtCore/QMap>
+#include <QtCore/QStringList>
 
 QT_BEGIN_NAMESPACE
 
@@ -70,6 +72,14 @@ public:
     QGeoCodeReply *reverseGeocode(const QGeoCoordinate &coordinate,
                                   const QGeoShape &bounds = QGeoShape());
 
+    QGeoCodeBatchReply *geocode(const QList<QGeoAddress> &addresses,
+                                const QGeoShape &bounds = QGeoShape());
+    QGeoCodeBatchReply *geocode(const QStringList &addresses,
+                                int limit = -1,
+                                const QGeoShape &bounds = QGeoShape());
+    QGeoCodeBatchReply *reverseGeocode(const QList<QGeoCoordinate> &coordinates,
+                                       const QGeoShape &bounds = QGeoShape());
+
     void setLocale(const QLocale &locale);
     QLocale locale() const;
 
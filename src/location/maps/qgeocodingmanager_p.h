@@ -53,10 +53,14 @@
 #include "qgeocodereply.h"
 
 #include <QList>
+#include <QSet>
+#include <functional>
 
 QT_BEGIN_NAMESPACE
 
 class QGeoCodingManagerEngine;
+class QGeoServiceCache;
+class QGeoCodeBatchReply;
 
 class QGeoCodingManagerPrivate
 {
@@ -64,7 +68,18 @@ public:
     QGeoCodingManagerPrivate();
     ~QGeoCodingManagerPrivate();
 
+    QGeoCodeBatchReply *sendPipelined(QGeoCodingManager *manager, int count,
+                                      const std::function<QGeoCodeReply *(int)> &send);
+    bool isBatchItem(QGeoCodeReply *reply) const;
+
     QGeoCodingManagerEngine *engine;
+    QGeoServiceCache *cache;
+
+    // Requests sent on behalf of pipelined batches, they are reported
+    // through the batch reply only
+    QSet<QObject *> batchItems;
+    int sendingBatchItems = 0;
+    int batchConcurrency = 4;
 
 private:
     Q_DISABLE_COPY(QGeoCodingManagerPrivate)
@@ -36,6 +36,7 @@
 
 #include "qgeocodingmanagerengine.h"
 #include "qgeocodingmanagerengine_p.h"
+#include "qgeocodingbatchengine_p.h"
 
 #include "qgeoaddress.h"
 #include "qgeocoordinate.h"
@@ -331,4 +332,36 @@ QGeoCodingManagerEnginePrivate::~QGeoCodingManagerEnginePrivate()
 {
 }
 
+/*******************************************************************************
+*******************************************************************************/
+
+QGeoCodingBatchEngine::~QGeoCodingBatchEngine()
+{
+}
+
+QGeoCodeBatchReply *QGeoCodingBatchEngine::geocodeBatch(const QList<QGeoAddress> &addresses,
+                                                        const QGeoShape &bounds)
+{
+    Q_UNUSED(addresses)
+    Q_UNUSED(bounds)
+    return nullptr;
+}
+
+QGeoCodeBatchReply *QGeoCodingBatchEngine::geocodeBatch(const QStringList &addresses, int limit,
+                                                        const QGeoShape &bounds)
+{
+    Q_UNUSED(addresses)
+    Q_UNUSED(limit)
+    Q_UNUSED(bounds)
+    return nullptr;
+}
+
+QGeoCodeBatchReply *QGeoCodingBatchEngine::reverseGeocodeBatch(const QList<QGeoCoordinate> &coordinates,
+                                                               const QGeoShape &bounds)
+{
+    Q_UNUSED(coordinates)
+    Q_UNUSED(bounds)
+    return nullptr;
+}
+
 QT_END_NAMESPACE
@@ -34,12 +34,15 @@
 **
 ****************************************************************************/
 #include "qgeofiletilecache_p.h"
+#include "qgeofiletilecachewriter_p.h"
+#include "qgeosharedtileindex_p.h"
 
 #include "qgeotilespec_p.h"
 
 #include "qgeomappingmanager_p.h"
 
 #include <QDir>
+#include <QDataStream>
 #include <QStandardPaths>
 #include <QMetaType>
 #include <QPixmap>
@@ -50,6 +53,10 @@ Q_DECLARE_METATYPE(QSet<QGeoTileSpec>)
 
 QT_BEGIN_NAMESPACE
 
+// No dot in the name, so that it is never taken for a tile.
+static const char metadataFileName[] = "tilemetadata";
+static const quint32 metadataFileVersion = 1;
+
 class QGeoCachedTileMemory
 {
 public:
@@ -88,9 +95,32 @@ QGeoCachedTileDisk::~QGeoCachedTileDisk()
 QGeoFileTileCache::QGeoFileTileCache(const QString &directory, QObject *parent)
     : QAbstractGeoTileCache(parent), directory_(directory), minTextureUsage_(0), extraTextureUsage_(0)
     ,costStrategyDisk_(ByteSize), costStrategyMemory_(ByteSize), costStrategyTexture_(ByteSize)
-    ,isDiskCostSet_(false), isMemoryCostSet_(false), isTextureCostSet_(false)
+    ,isDiskCostSet_(false), isMemoryCostSet_(false), isTextureCostSet_(false), shared_(false)
 {
+    diskWriter_.reset(new QGeoFileTileCacheWriter);
+    sharedPoll_.setInterval(200);
+    connect(&sharedPoll_, &QTimer::timeout, this, &QGeoFileTileCache::pollSharedFetches);
+}
+
+/*
+    Sets whether the cache directory is shared with the other processes
+    caching tiles in it. Has to be called before init().
 
+    Shared caches keep an index of the tiles on disk in shared memory, so
+    that a tile fetched by one process is found by the others, a tile being
+    fetched by one process is not fetched again by the others, and the disk
+    usage limit applies to all of them together, with the least recently
+    used tiles of any of them evicted first. The process setting up the
+    index sizes it for the disk usage limit.
+*/
+void QGeoFileTileCache::setShared(bool shared)
+{
+    shared_ = shared;
+}
+
+bool QGeoFileTileCache::isShared() const
+{
+    return shared_;
 }
 
 void QGeoFileTileCache::init()
@@ -144,11 +174,41 @@ void QGeoFileTileCache::init()
             setExtraTextureUsage(30); // byte size of texture is >> compressed image, hence unitary cost should be lower
     }
 
+    if (shared_) {
+        // The index has to hold every tile the disk usage limit allows for,
+        // or it would evict before reaching it. Byte sized limits assume
+        // 8 KiB tiles, about the smallest raster tiles served, and without
+        // limit the index holds 16384 tiles.
+        const qint64 maxDiskUsage = diskCache_.maxCost();
+        const qint64 tiles = costStrategyDisk_ == ByteSize ? maxDiskUsage / 8192 : maxDiskUsage;
+        sharedIndex_.reset(new QGeoSharedTileIndex(directory_, tiles > 0
+                                                   ? QGeoSharedTileIndex::capacityFor(tiles)
+                                                   : 16384));
+        if (sharedIndex_->isValid()) {
+            sharedIndex_->setMaxCost(diskCache_.maxCost());
+            diskWriter_->setWrittenHandler([this](const QString &filename, qint64 size) {
+                tileWritten(filename, size);
+            });
+        } else {
+            qWarning() << "Unable to share the tile cache in" << directory_ << ":"
+                       << sharedIndex_->errorString();
+            sharedIndex_.reset();
+            shared_ = false;
+        }
+    }
+
     loadTiles();
 }
 
 void QGeoFileTileCache::loadTiles()
 {
+    // The tiles of a shared directory are indexed by the process that set up
+    // the index, and found through it by the others.
+    if (sharedIndex_ && !sharedIndex_->isInitializer()) {
+        loadMetadata();
+        return;
+    }
+
     QStringList formats;
     formats << QLatin1String("*.*");
 
@@ -165,7 +225,7 @@ void QGeoFileTileCache::loadTiles()
             continue;
         QList<QSharedPointer<QGeoCachedTileDisk> > queue;
         QList<QGeoTileSpec> specs;
-        QList<int> costs;
+        QList<qint64> costs;
         while (!file.atEnd()) {
             QByteArray line = file.readLine().trimmed();
             QString filename = QString::fromLatin1(line.constData(), line.length());
@@ -202,11 +262,89 @@ void QGeoFileTileCache::loadTiles()
             continue;
         QString filename = dir.filePath(files.at(i));
         addToDiskCache(spec, filename);
+        if (sharedIndex_)
+            shareTile(spec, filename, costStrategyDisk_ == ByteSize ? QFileInfo(filename).size() : 1);
     }
+
+    loadMetadata();
+}
+
+/*
+    Reads the freshness of the cached tiles, kept in a single manifest file
+    next to the tiles. Entries for tiles that are no longer on disk are
+    dropped.
+*/
+void QGeoFileTileCache::loadMetadata()
+{
+    QFile file(QDir(directory_).filePath(QLatin1String(metadataFileName)));
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_12);
+    quint32 version = 0;
+    qint32 count = 0;
+    in >> version >> count;
+    if (version != metadataFileVersion)
+        return;
+
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString plugin;
+        qint32 mapId, zoom, x, y, tileVersion;
+        QGeoTileMetadata metadata;
+        in >> plugin >> mapId >> zoom >> x >> y >> tileVersion
+           >> metadata.etag >> metadata.lastModified >> metadata.expires;
+        const QGeoTileSpec spec(plugin, mapId, zoom, x, y, tileVersion);
+        if (in.status() == QDataStream::Ok && isOnDisk(spec)) {
+            QMutexLocker locker(&metadataMutex_);
+            metadata_.insert(spec, metadata);
+        }
+    }
+}
+
+void QGeoFileTileCache::saveMetadata()
+{
+    if (directory_.isEmpty())
+        return;
+
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_5_12);
+    out << metadataFileVersion << qint32(0);
+
+    QHash<QGeoTileSpec, QGeoTileMetadata> metadata;
+    {
+        QMutexLocker locker(&metadataMutex_);
+        metadata = metadata_;
+    }
+
+    qint32 count = 0;
+    for (auto it = metadata.cbegin(), end = metadata.cend(); it != end; ++it) {
+        const QGeoTileSpec &spec = it.key();
+        if (!isOnDisk(spec))
+            continue;
+        out << spec.plugin() << qint32(spec.mapId()) << qint32(spec.zoom())
+            << qint32(spec.x()) << qint32(spec.y()) << qint32(spec.version())
+            << it->etag << it->lastModified << it->expires;
+        ++count;
+    }
+    out.device()->seek(sizeof(quint32));
+    out << count;
+
+    diskWriter_->write(QDir(directory_).filePath(QLatin1String(metadataFileName)), data);
 }
 
 QGeoFileTileCache::~QGeoFileTileCache()
 {
+    // Index the tiles still being written before the handler goes.
+    if (sharedIndex_) {
+        diskWriter_->flush();
+        diskWriter_->setWrittenHandler(nullptr);
+    }
+
+    // Written behind like the tiles, by the writer outliving the caches.
+    saveMetadata();
+
 #if 0 // workaround for QTBUG-60581
     // write disk cache queues to disk
     QDir dir(directory_);
@@ -240,20 +378,22 @@ void QGeoFileTileCache::printStats()
     diskCache_.printStats();
 }
 
-void QGeoFileTileCache::setMaxDiskUsage(int diskUsage)
+void QGeoFileTileCache::setMaxDiskUsage(qint64 diskUsage)
 {
     diskCache_.setMaxCost(diskUsage);
+    if (sharedIndex_)
+        sharedIndex_->setMaxCost(diskUsage);
     isDiskCostSet_ = true;
 }
 
-int QGeoFileTileCache::maxDiskUsage() const
+qint64 QGeoFileTileCache::maxDiskUsage() const
 {
     return diskCache_.maxCost();
 }
 
-int QGeoFileTileCache::diskUsage() const
+qint64 QGeoFileTileCache::diskUsage() const
 {
-    return diskCache_.totalCost();
+    return sharedIndex_ ? sharedIndex_->totalCost() : diskCache_.totalCost();
 }
 
 void QGeoFileTileCache::setMaxMemoryUsage(int memoryUsage)
@@ -264,12 +404,12 @@ void QGeoFileTileCache::setMaxMemoryUsage(int memoryUsage)
 
 int QGeoFileTileCache::maxMemoryUsage() const
 {
-    return memoryCache_.maxCost();
+    return int(memoryCache_.maxCost());
 }
 
 int QGeoFileTileCache::memoryUsage() const
 {
-    return memoryCache_.totalCost();
+    return int(memoryCache_.totalCost());
 }
 
 void QGeoFileTileCache::setExtraTextureUsage(int textureUsage)
@@ -287,7 +427,7 @@ void QGeoFileTileCache::setMinTextureUsage(int textureUsage)
 
 int QGeoFileTileCache::maxTextureUsage() const
 {
-    return textureCache_.maxCost();
+    return int(textureCache_.maxCost());
 }
 
 int QGeoFileTileCache::minTextureUsage() const
@@ -298,7 +438,7 @@ int QGeoFileTileCache::minTextureUsage() const
 
 int QGeoFileTileCache::textureUsage() const
 {
-    return textureCache_.totalCost();
+    return int(textureCache_.totalCost());
 }
 
 void QGeoFileTileCache::clearAll()
@@ -306,6 +446,13 @@ void QGeoFileTileCache::clearAll()
     textureCache_.clear();
     memoryCache_.clear();
     diskCache_.clear();
+    {
+        QMutexLocker locker(&metadataMutex_);
+        metadata_.clear();
+    }
+    if (sharedIndex_)
+        sharedIndex_->clear();
+    diskWriter_->flush();
     QDir dir(directory_);
     dir.setNameFilters(QStringList() << QLatin1String("*-*-*-*.*"));
     dir.setFilter(QDir::Files);
@@ -325,10 +472,20 @@ void QGeoFileTileCache::clearMapId(const int mapId)
     for (const QGeoTileSpec &k : textureCache_.keys())
         if (k.mapId() == mapId)
             textureCache_.remove(k);
+    {
+        QMutexLocker locker(&metadataMutex_);
+        for (auto it = metadata_.begin(); it != metadata_.end(); ) {
+            if (it.key().mapId() == mapId)
+                it = metadata_.erase(it);
+            else
+                ++it;
+        }
+    }
 
     // TODO: It seems the cache leaves residues, like some tiles do not get picked up.
     // After the above calls, files that shouldnt be left behind are still on disk.
     // Do an additional pass and make sure what has to be deleted gets deleted.
+    diskWriter_->flush();
     QDir dir(directory_);
     QStringList formats;
     formats << QLatin1String("*.*");
@@ -338,10 +495,36 @@ void QGeoFileTileCache::clearMapId(const int mapId)
         QGeoTileSpec spec = filenameToTileSpec(tileFileName);
         if (spec.mapId() != mapId)
             continue;
+        if (sharedIndex_)
+            sharedIndex_->remove(spec);
         QFile::remove(dir.filePath(tileFileName));
     }
 }
 
+/*
+    Marks the cached tiles of \a mapId as stale, so that they keep being
+    shown while they are revalidated, rather than being deleted as
+    clearMapId() does. Tiles without validators are revalidated against the
+    time their file was written.
+*/
+void QGeoFileTileCache::expireMapId(int mapId)
+{
+    const QDateTime expired = QDateTime::fromMSecsSinceEpoch(0, Qt::UTC);
+    for (const QGeoTileSpec &k : diskCache_.keys()) {
+        if (k.mapId() != mapId || !diskCache_.contains(k))
+            continue;
+        QGeoTileMetadata expiredMetadata = metadata(k);
+        expiredMetadata.expires = expired;
+        if (!expiredMetadata.canRevalidate()) {
+            QSharedPointer<QGeoCachedTileDisk> td = diskCache_.object(k);
+            if (td)
+                expiredMetadata.lastModified = QFileInfo(td->filename).lastModified().toUTC();
+        }
+        QMutexLocker locker(&metadataMutex_);
+        metadata_.insert(k, expiredMetadata);
+    }
+}
+
 void QGeoFileTileCache::setCostStrategyDisk(QAbstractGeoTileCache::CostStrategy costStrategy)
 {
     costStrategyDisk_ = costStrategy;
@@ -385,13 +568,23 @@ void QGeoFileTileCache::insert(const QGeoTileSpec &spec,
                            const QString &format,
                            QAbstractGeoTileCache::CacheAreas areas)
 {
-    if (bytes.isEmpty())
+    // A fetch claimed in a shared cache ends once the tile is indexed, after
+    // it has been written out. Tiles that are not written end it here.
+    if (bytes.isEmpty()) {
+        releaseTileFetch(spec);
         return;
+    }
+
+    // A revalidated tile replaces the decoded one.
+    textureCache_.remove(spec);
 
+    bool written = false;
     if (areas & QAbstractGeoTileCache::DiskCache) {
         QString filename = tileSpecToFilename(spec, format, directory_);
-        addToDiskCache(spec, filename, bytes);
+        written = addToDiskCache(spec, filename, bytes);
     }
+    if (!written)
+        releaseTileFetch(spec);
 
     if (areas & QAbstractGeoTileCache::MemoryCache) {
         addToMemoryCache(spec, bytes, format);
@@ -402,6 +595,125 @@ void QGeoFileTileCache::insert(const QGeoTileSpec &spec,
      * and act as a poison */
 }
 
+QGeoTileMetadata QGeoFileTileCache::metadata(const QGeoTileSpec &spec) const
+{
+    QMutexLocker locker(&metadataMutex_);
+    return metadata_.value(spec);
+}
+
+/*
+    Metadata is only kept for tiles in the disk cache, and goes away with
+    them.
+*/
+void QGeoFileTileCache::setMetadata(const QGeoTileSpec &spec, const QGeoTileMetadata &metadata)
+{
+    const bool keep = !metadata.isEmpty() && diskCache_.contains(spec);
+    QMutexLocker locker(&metadataMutex_);
+    if (!keep)
+        metadata_.remove(spec);
+    else
+        metadata_.insert(spec, metadata);
+}
+
+bool QGeoFileTileCache::contains(const QGeoTileSpec &spec) const
+{
+    return memoryCache_.contains(spec) || isOnDisk(spec);
+}
+
+QByteArray QGeoFileTileCache::tileData(const QGeoTileSpec &spec)
+{
+    QSharedPointer<QGeoCachedTileMemory> tm = memoryCache_.object(spec);
+    if (tm)
+        return tm->bytes;
+
+    QSharedPointer<QGeoCachedTileDisk> td = diskTile(spec);
+    if (!td)
+        return QByteArray();
+
+    QByteArray bytes;
+    if (!diskWriter_->pending(td->filename, &bytes)) {
+        QFile file(td->filename);
+        if (file.open(QIODevice::ReadOnly))
+            bytes = file.readAll();
+    }
+    return bytes;
+}
+
+QAbstractGeoTileCache::TileReader QGeoFileTileCache::tileReader(const QGeoTileSpec &spec)
+{
+    QSharedPointer<QGeoCachedTileMemory> tm = memoryCache_.object(spec);
+    if (tm) {
+        const QByteArray bytes = tm->bytes;
+        return [bytes]() { return bytes; };
+    }
+
+    QSharedPointer<QGeoCachedTileDisk> td = diskTile(spec);
+    if (!td)
+        return []() { return QByteArray(); };
+
+    QByteArray bytes;
+    if (diskWriter_->pending(td->filename, &bytes))
+        return [bytes]() { return bytes; };
+
+    const QString filename = td->filename;
+    return [filename]() {
+        QFile file(filename);
+        return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+    };
+}
+
+QSharedPointer<QGeoTileTexture> QGeoFileTileCache::insertTexture(const QGeoTileSpec &spec,
+                                                                 const QImage &image,
+                                                                 bool provisional)
+{
+    QSharedPointer<QGeoTileTexture> tt = addToTextureCache(spec, image);
+    tt->provisional = provisional;
+    return tt;
+}
+
+bool QGeoFileTileCache::claimTileFetch(const QGeoTileSpec &spec)
+{
+    if (!sharedIndex_ || sharedIndex_->claimFetch(spec))
+        return true;
+
+    sharedWaits_.insert(spec);
+    if (!sharedPoll_.isActive())
+        sharedPoll_.start();
+    return false;
+}
+
+void QGeoFileTileCache::releaseTileFetch(const QGeoTileSpec &spec)
+{
+    if (!sharedIndex_)
+        return;
+    sharedWaits_.remove(spec);
+    sharedIndex_->releaseFetch(spec);
+}
+
+/*
+    Reports the tiles waited for that other processes have stopped fetching,
+    either because they are on disk or because the fetch failed or timed out.
+*/
+void QGeoFileTileCache::pollSharedFetches()
+{
+    QVector<QPair<QGeoTileSpec, bool> > done;
+    for (auto it = sharedWaits_.begin(); it != sharedWaits_.end(); ) {
+        const QGeoSharedTileIndex::TileState state = sharedIndex_->state(*it);
+        if (state == QGeoSharedTileIndex::Fetching) {
+            ++it;
+            continue;
+        }
+        done.append(qMakePair(*it, state == QGeoSharedTileIndex::Present));
+        it = sharedWaits_.erase(it);
+    }
+    if (sharedWaits_.isEmpty())
+        sharedPoll_.stop();
+
+    // Emitted once done with the set, as receivers may wait again.
+    for (const auto &tile : qAsConst(done))
+        emit sharedTileFetched(tile.first, tile.second);
+}
+
 QString QGeoFileTileCache::tileSpecToFilenameDefault(const QGeoTileSpec &spec, const QString &format, const QString &directory)
 {
     QString filename = spec.plugin();
@@ -469,7 +781,13 @@ QGeoTileSpec QGeoFileTileCache::filenameToTileSpecDefault(const QString &filenam
 
 void QGeoFileTileCache::evictFromDiskCache(QGeoCachedTileDisk *td)
 {
-    QFile::remove(td->filename);
+    {
+        QMutexLocker locker(&td->cache->metadataMutex_);
+        td->cache->metadata_.remove(td->spec);
+    }
+    // Shared tiles are evicted through the index, on behalf of all the processes.
+    if (!td->cache->sharedIndex_)
+        td->cache->diskWriter_->remove(td->filename);
 }
 
 void QGeoFileTileCache::evictFromMemoryCache(QGeoCachedTileMemory * /* tm  */)
@@ -483,7 +801,7 @@ QSharedPointer<QGeoCachedTileDisk> QGeoFileTileCache::addToDiskCache(const QGeoT
     td->filename = filename;
     td->cache = this;
 
-    int cost = 1;
+    qint64 cost = 1;
     if (costStrategyDisk_ == ByteSize) {
         QFileInfo fi(filename);
         cost = fi.size();
@@ -499,15 +817,16 @@ bool QGeoFileTileCache::addToDiskCache(const QGeoTileSpec &spec, const QString &
     td->filename = filename;
     td->cache = this;
 
-    int cost = 1;
+    qint64 cost = 1;
     if (costStrategyDisk_ == ByteSize)
         cost = bytes.size();
 
     if (diskCache_.insert(spec, td, cost)) {
-        QFile file(filename);
-        file.open(QIODevice::WriteOnly);
-        file.write(bytes);
-        file.close();
+        if (sharedIndex_) {
+            QMutexLocker locker(&sharedWritesMutex_);
+            sharedWrites_.insert(filename, spec);
+        }
+        diskWriter_->write(filename, bytes);
         return true;
     }
     return false;
@@ -524,7 +843,7 @@ void QGeoFileTileCache::addToMemoryCache(const QGeoTileSpec &spec, const QByteAr
     tm->bytes = bytes;
     tm->format = format;
 
-    int cost = 1;
+    qint64 cost = 1;
     if (costStrategyMemory_ == ByteSize)
         cost = bytes.size();
     memoryCache_.insert(spec, tm, cost);
@@ -566,13 +885,22 @@ QSharedPointer<QGeoTileTexture> QGeoFileTileCache::getFromMemory(const QGeoTileS
 
 QSharedPointer<QGeoTileTexture> QGeoFileTileCache::getFromDisk(const QGeoTileSpec &spec)
 {
-    QSharedPointer<QGeoCachedTileDisk> td = diskCache_.object(spec);
+    QSharedPointer<QGeoCachedTileDisk> td = diskTile(spec);
     if (td) {
         const QString format = QFileInfo(td->filename).suffix();
-        QFile file(td->filename);
-        file.open(QIODevice::ReadOnly);
-        QByteArray bytes = file.readAll();
-        file.close();
+        // Tiles that have not been written out yet are served from the write queue.
+        QByteArray bytes;
+        if (!diskWriter_->pending(td->filename, &bytes)) {
+            QFile file(td->filename);
+            if (!file.open(QIODevice::ReadOnly) && sharedIndex_) {
+                // Evicted by another process sharing the directory.
+                diskCache_.remove(spec);
+                sharedIndex_->remove(spec);
+                return QSharedPointer<QGeoTileTexture>();
+            }
+            bytes = file.readAll();
+            file.close();
+        }
 
         QImage image;
         // Some tiles from the servers could be valid images but the tile fetcher
@@ -604,6 +932,65 @@ QSharedPointer<QGeoTileTexture> QGeoFileTileCache::getFromDisk(const QGeoTileSpe
     return QSharedPointer<QGeoTileTexture>();
 }
 
+/*
+    Returns the disk cache entry of tile \a spec. Tiles of a shared cache
+    directory written by other processes are added to the disk cache when
+    first found in the index, and every use counts towards keeping them.
+*/
+QSharedPointer<QGeoCachedTileDisk> QGeoFileTileCache::diskTile(const QGeoTileSpec &spec)
+{
+    QSharedPointer<QGeoCachedTileDisk> td = diskCache_.object(spec);
+    if (!sharedIndex_)
+        return td;
+
+    const QString name = sharedIndex_->lookup(spec);
+    if (!td && !name.isEmpty())
+        td = addToDiskCache(spec, QDir(directory_).filePath(name));
+    return td;
+}
+
+bool QGeoFileTileCache::isOnDisk(const QGeoTileSpec &spec) const
+{
+    if (diskCache_.contains(spec))
+        return true;
+    return sharedIndex_ && sharedIndex_->state(spec) == QGeoSharedTileIndex::Present;
+}
+
+/*
+    Called on the writer thread once a tile file is on disk, to publish it
+    to the other processes, or with a \a size of -1 once writing it failed,
+    to let them fetch it.
+*/
+void QGeoFileTileCache::tileWritten(const QString &filename, qint64 size)
+{
+    QGeoTileSpec spec;
+    {
+        QMutexLocker locker(&sharedWritesMutex_);
+        auto it = sharedWrites_.find(filename);
+        if (it == sharedWrites_.end())
+            return;
+        spec = it.value();
+        sharedWrites_.erase(it);
+    }
+    if (size < 0)
+        sharedIndex_->releaseFetch(spec);
+    else
+        shareTile(spec, filename, costStrategyDisk_ == ByteSize ? size : 1);
+}
+
+/*
+    Adds tile \a spec to the shared index, deleting the files of the tiles
+    evicted to make room for it. The disk cache entries of evicted tiles go
+    when their file is found missing, in this process or any other.
+*/
+void QGeoFileTileCache::shareTile(const QGeoTileSpec &spec, const QString &filename, qint64 cost)
+{
+    const QStringList evicted = sharedIndex_->insert(spec, QFileInfo(filename).fileName(), cost);
+    const QDir dir(directory_);
+    for (const QString &name : evicted)
+        diskWriter_->remove(dir.filePath(name));
+}
+
 bool QGeoFileTileCache::isTileBogus(const QByteArray &bytes) const
 {
     if (bytes.size() == 7 && bytes == QByteArrayLiteral("NoRetry"))
@@ -52,9 +52,11 @@
 #include <QObject>
 #include <QCache>
 #include "qcache3q_p.h"
+#include "qconcurrentcache3q_p.h"
 #include <QSet>
 #include <QMutex>
 #include <QTimer>
+#include <QScopedPointer>
 
 #include "qgeotilespec_p.h"
 #include "qgeotiledmappingmanagerengine_p.h"
@@ -69,6 +71,8 @@ class QGeoMappingManager;
 class QGeoTile;
 class QGeoCachedTileMemory;
 class QGeoFileTileCache;
+class QGeoFileTileCacheWriter;
+class QGeoSharedTileIndex;
 
 class QPixmap;
 class QThread;
@@ -102,9 +106,12 @@ public:
     QGeoFileTileCache(const QString &directory = QString(), QObject *parent = 0);
     ~QGeoFileTileCache();
 
-    void setMaxDiskUsage(int diskUsage) override;
-    int maxDiskUsage() const override;
-    int diskUsage() const override;
+    void setShared(bool shared);
+    bool isShared() const;
+
+    void setMaxDiskUsage(qint64 diskUsage) override;
+    qint64 maxDiskUsage() const override;
+    qint64 diskUsage() const override;
 
     void setMaxMemoryUsage(int memoryUsage) override;
     int maxMemoryUsage() const override;
@@ -136,13 +143,32 @@ public:
                 const QString &format,
                 QAbstractGeoTileCache::CacheAreas areas = QAbstractGeoTileCache::AllCaches) override;
 
+    QGeoTileMetadata metadata(const QGeoTileSpec &spec) const override;
+    void setMetadata(const QGeoTileSpec &spec, const QGeoTileMetadata &metadata) override;
+
+    bool contains(const QGeoTileSpec &spec) const override;
+    QByteArray tileData(const QGeoTileSpec &spec) override;
+    TileReader tileReader(const QGeoTileSpec &spec) override;
+    QSharedPointer<QGeoTileTexture> insertTexture(const QGeoTileSpec &spec,
+                                                  const QImage &image,
+                                                  bool provisional) override;
+
+    bool claimTileFetch(const QGeoTileSpec &spec) override;
+    void releaseTileFetch(const QGeoTileSpec &spec) override;
+
     static QString tileSpecToFilenameDefault(const QGeoTileSpec &spec, const QString &format, const QString &directory);
     static QGeoTileSpec filenameToTileSpecDefault(const QString &filename);
 
+private Q_SLOTS:
+    void pollSharedFetches();
+
 protected:
     void init() override;
     void printStats() override;
     void loadTiles();
+    void loadMetadata();
+    void saveMetadata();
+    void expireMapId(int mapId);
 
     QString directory() const;
 
@@ -152,14 +178,34 @@ protected:
     QSharedPointer<QGeoTileTexture> addToTextureCache(const QGeoTileSpec &spec, const QImage &image);
     QSharedPointer<QGeoTileTexture> getFromMemory(const QGeoTileSpec &spec);
     QSharedPointer<QGeoTileTexture> getFromDisk(const QGeoTileSpec &spec);
+    QSharedPointer<QGeoCachedTileDisk> diskTile(const QGeoTileSpec &spec);
+    bool isOnDisk(const QGeoTileSpec &spec) const;
+    void tileWritten(const QString &filename, qint64 size);
+    void shareTile(const QGeoTileSpec &spec, const QString &filename, qint64 cost);
 
     virtual bool isTileBogus(const QByteArray &bytes) const;
     virtual QString tileSpecToFilename(const QGeoTileSpec &spec, const QString &format, const QString &directory) const;
     virtual QGeoTileSpec filenameToTileSpec(const QString &filename) const;
 
-    QCache3Q<QGeoTileSpec, QGeoCachedTileDisk, QCache3QTileEvictionPolicy > diskCache_;
-    QCache3Q<QGeoTileSpec, QGeoCachedTileMemory > memoryCache_;
+    // Set in init() when the cache directory is shared with other processes.
+    QScopedPointer<QGeoSharedTileIndex> sharedIndex_;
+    // Declared before the caches so that it outlives them.
+    QScopedPointer<QGeoFileTileCacheWriter> diskWriter_;
+    // The caches of encoded tiles can be used from any thread, the decoded
+    // textures belong to the thread that renders them.
+    QConcurrentCache3Q<QGeoTileSpec, QGeoCachedTileDisk, QCache3QTileEvictionPolicy > diskCache_;
+    QConcurrentCache3Q<QGeoTileSpec, QGeoCachedTileMemory > memoryCache_;
     QCache3Q<QGeoTileSpec, QGeoTileTexture > textureCache_;
+    QHash<QGeoTileSpec, QGeoTileMetadata> metadata_;
+    mutable QMutex metadataMutex_; // never held while calling into diskCache_
+
+    // Tiles being written, to be added to the shared index once on disk.
+    QHash<QString, QGeoTileSpec> sharedWrites_;
+    QMutex sharedWritesMutex_;
+    // Tiles other processes are fetching for this one.
+    QSet<QGeoTileSpec> sharedWaits_;
+    QTimer sharedPoll_;
+    bool shared_;
 
     QString directory_;
 
@@ -0,0 +1,167 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeofiletilecachewriter_p.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QSaveFile>
+#include <QtCore/QMutexLocker>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Writes and removes the files of a tile cache on a thread of its own, so
+    that tiles arriving while the map is being flicked do not block the GUI
+    thread on file system calls.
+
+    Operations are keyed by file name: a later write or removal of the same
+    file replaces the one still queued, and the worker takes the whole queue
+    in one batch each time it wakes up. Until a write has completed, the bytes
+    being written are returned by pending() so that the tile can still be read.
+
+    Files are written to a temporary file and renamed into place, so that
+    another process reading the cache directory never sees half a tile.
+*/
+QGeoFileTileCacheWriter::QGeoFileTileCacheWriter(QObject *parent)
+    : QThread(parent)
+{
+    start(QThread::LowPriority);
+}
+
+/*
+    Completes the queued operations before returning, so that the tiles
+    received before the cache is destroyed are found on the next start.
+*/
+QGeoFileTileCacheWriter::~QGeoFileTileCacheWriter()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stopping = true;
+        m_queued.wakeOne();
+    }
+    wait();
+}
+
+void QGeoFileTileCacheWriter::write(const QString &filename, const QByteArray &bytes)
+{
+    QMutexLocker locker(&m_mutex);
+    Operation &operation = m_pending[filename];
+    operation.bytes = bytes;
+    operation.remove = false;
+    m_queued.wakeOne();
+}
+
+void QGeoFileTileCacheWriter::remove(const QString &filename)
+{
+    QMutexLocker locker(&m_mutex);
+    Operation &operation = m_pending[filename];
+    operation.bytes.clear();
+    operation.remove = true;
+    m_queued.wakeOne();
+}
+
+/*
+    Returns true if \a filename is queued or being written, setting \a bytes
+    to its content. A file queued for removal is reported as pending with
+    empty \a bytes, since what is still on disk must not be used.
+*/
+bool QGeoFileTileCacheWriter::pending(const QString &filename, QByteArray *bytes) const
+{
+    QMutexLocker locker(&m_mutex);
+    auto it = m_pending.constFind(filename);
+    if (it == m_pending.cend()) {
+        it = m_inFlight.constFind(filename);
+        if (it == m_inFlight.cend())
+            return false;
+    }
+    *bytes = it.value().bytes;
+    return true;
+}
+
+/*
+    Blocks until every operation queued so far has been carried out.
+*/
+void QGeoFileTileCacheWriter::flush()
+{
+    QMutexLocker locker(&m_mutex);
+    while (!m_pending.isEmpty() || !m_inFlight.isEmpty())
+        m_done.wait(&m_mutex);
+}
+
+/*
+    Sets \a handler to be called on the writer thread, with no lock held,
+    after each file has been written, with its size, or with -1 if it could
+    not be written.
+*/
+void QGeoFileTileCacheWriter::setWrittenHandler(const WrittenHandler &handler)
+{
+    QMutexLocker locker(&m_mutex);
+    m_written = handler;
+}
+
+void QGeoFileTileCacheWriter::run()
+{
+    QMutexLocker locker(&m_mutex);
+    forever {
+        while (m_pending.isEmpty() && !m_stopping)
+            m_queued.wait(&m_mutex);
+        if (m_pending.isEmpty())
+            break;
+
+        m_inFlight.swap(m_pending);
+        const WrittenHandler written = m_written;
+        locker.unlock();
+
+        for (auto it = m_inFlight.cbegin(), end = m_inFlight.cend(); it != end; ++it) {
+            if (it.value().remove) {
+                QFile::remove(it.key());
+                continue;
+            }
+            QSaveFile file(it.key());
+            const bool ok = file.open(QIODevice::WriteOnly)
+                    && file.write(it.value().bytes) == it.value().bytes.size()
+                    && file.commit();
+            if (written)
+                written(it.key(), ok ? it.value().bytes.size() : -1);
+        }
+
+        locker.relock();
+        m_inFlight.clear();
+        m_done.wakeAll();
+    }
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,99 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOFILETILECACHEWRITER_P_H
+#define QGEOFILETILECACHEWRITER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtLocation/private/qlocationglobal_p.h>
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QtCore/QThread>
+#include <QtCore/QWaitCondition>
+
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+class Q_LOCATION_PRIVATE_EXPORT QGeoFileTileCacheWriter : public QThread
+{
+    Q_OBJECT
+public:
+    explicit QGeoFileTileCacheWriter(QObject *parent = nullptr);
+    ~QGeoFileTileCacheWriter();
+
+    void write(const QString &filename, const QByteArray &bytes);
+    void remove(const QString &filename);
+    bool pending(const QString &filename, QByteArray *bytes) const;
+    void flush();
+
+    typedef std::function<void(const QString &filename, qint64 size)> WrittenHandler;
+    void setWrittenHandler(const WrittenHandler &handler);
+
+protected:
+    void run() override;
+
+private:
+    struct Operation
+    {
+        QByteArray bytes;
+        bool remove;
+    };
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_queued;
+    QWaitCondition m_done;
+    QHash<QString, Operation> m_pending;
+    QHash<QString, Operation> m_inFlight;
+    WrittenHandler m_written;
+    bool m_stopping = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOFILETILECACHEWRITER_P_H
@@ -0,0 +1,101 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeoparsetask_p.h"
+
+#include <QtCore/QThreadPool>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Runs the parsing of a reply on the global thread pool and hands the result back
+    to the thread of the receiver, typically the reply object that requested it.
+
+    The parse function must not touch the receiver, as it may be destroyed while
+    the task is running, and it always runs to completion so that it can release
+    whatever it holds. The deliver function is only invoked if the receiver is
+    still alive and the task was not cancelled through the handle returned by
+    start().
+
+    The task is deleted by the thread pool once it has run, and only ever emits
+    its own signal from the worker. The signal is connected to the receiver
+    before the task starts, so that the delivery is queued to the thread of the
+    receiver, and dropped by Qt if the receiver is destroyed first.
+*/
+QGeoParseTask::QGeoParseTask(std::function<void()> parse)
+:   m_parse(std::move(parse))
+{
+}
+
+QGeoParseTask::~QGeoParseTask()
+{
+}
+
+QGeoParseTask::Handle QGeoParseTask::start(QObject *receiver, std::function<void()> parse,
+                                           std::function<void()> deliver)
+{
+    Handle handle;
+    handle.m_cancelled.reset(new QAtomicInt);
+
+    QGeoParseTask *task = new QGeoParseTask(std::move(parse));
+    const QSharedPointer<QAtomicInt> cancelled = handle.m_cancelled;
+    connect(task, &QGeoParseTask::parsed, receiver, [cancelled, deliver]() {
+        if (!cancelled->load())
+            deliver();
+    }, Qt::QueuedConnection);
+    // Neither the thread of the receiver nor the worker owns the task.
+    task->moveToThread(nullptr);
+    QThreadPool::globalInstance()->start(task);
+    return handle;
+}
+
+void QGeoParseTask::run()
+{
+    // always parse, cancelling only drops the delivery
+    m_parse();
+    emit parsed();
+}
+
+/*
+    Drops the delivery of the task, if it has not happened yet.
+*/
+void QGeoParseTask::Handle::cancel() const
+{
+    if (m_cancelled)
+        m_cancelled->store(1);
+}
+
+QT_END_NAMESPACE
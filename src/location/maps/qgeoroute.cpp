@@ -36,6 +36,7 @@
 
 #include "qgeoroute.h"
 #include "qgeoroute_p.h"
+#include "qgeoroutesegment_p.h"
 
 #include "qgeorectangle.h"
 #include "qgeoroutesegment.h"
@@ -457,6 +458,35 @@ const QGeoRoutePrivate *QGeoRoutePrivate::routePrivateData(const QGeoRoute &rout
     return route.d_ptr.data();
 }
 
+/*
+    Returns a copy of \a route, its legs and its segments which shares no
+    data with the original, so that modifying one through the explicitly
+    shared API leaves the other untouched.
+*/
+QGeoRoute QGeoRoutePrivate::deepCopy(const QGeoRoute &route)
+{
+    if (!route.d_ptr)
+        return route;
+
+    QGeoRouteSegmentPrivate::Copies segments;
+    QExplicitlySharedDataPointer<QGeoRoutePrivate> d(route.d_ptr->clone());
+    QGeoRoute copy(d);
+    d->setFirstSegment(QGeoRouteSegmentPrivate::deepCopy(route.d_ptr->firstSegment(), &segments));
+
+    const QList<QGeoRouteLeg> legs = route.d_ptr->routeLegs();
+    QList<QGeoRouteLeg> legCopies;
+    for (const QGeoRouteLeg &leg : legs) {
+        const QExplicitlySharedDataPointer<QGeoRoutePrivate> &legData = static_cast<const QGeoRoute &>(leg).d_ptr;
+        QExplicitlySharedDataPointer<QGeoRoutePrivate> ld(legData->clone());
+        ld->setFirstSegment(QGeoRouteSegmentPrivate::deepCopy(legData->firstSegment(), &segments));
+        ld->setLegIndex(legData->legIndex());
+        ld->setContainingRoute(copy);
+        legCopies.append(QGeoRouteLeg(ld));
+    }
+    d->setRouteLegs(legCopies);
+    return copy;
+}
+
 QVariantMap QGeoRoutePrivate::metadata() const
 {
     return QVariantMap();
@@ -110,6 +110,7 @@ public:
     virtual QGeoRoute containingRoute() const;
 
     static const QGeoRoutePrivate *routePrivateData(const QGeoRoute &route);
+    static QGeoRoute deepCopy(const QGeoRoute &route);
 
 protected:
     virtual bool equals(const QGeoRoutePrivate &other) const;
@@ -38,6 +38,7 @@
 #include "qgeorouteparser_p_p.h"
 #include "qgeoroutesegment.h"
 #include "qgeomaneuver.h"
+#include "qgeoroutereply_p.h"
 
 #include <QtCore/private/qobject_p.h>
 #include <QtCore/QJsonDocument>
@@ -51,7 +52,8 @@ QT_BEGIN_NAMESPACE
     Private class implementations
 */
 
-QGeoRouteParserPrivate::QGeoRouteParserPrivate() : QObjectPrivate(), trafficSide(QGeoRouteParser::RightHandTraffic)
+QGeoRouteParserPrivate::QGeoRouteParserPrivate()
+    : QObjectPrivate(), trafficSide(QGeoRouteParser::RightHandTraffic), pendingAsyncParses(0)
 {
 }
 
@@ -65,7 +67,10 @@ QGeoRouteParserPrivate::~QGeoRouteParserPrivate()
 
 QGeoRouteParser::~QGeoRouteParser()
 {
-
+    Q_D(QGeoRouteParser);
+    QMutexLocker locker(&d->asyncMutex);
+    while (d->pendingAsyncParses)
+        d->asyncFinished.wait(&d->asyncMutex);
 }
 
 QGeoRouteParser::QGeoRouteParser(QGeoRouteParserPrivate &dd, QObject *parent) : QObject(dd, parent)
@@ -79,6 +84,41 @@ QGeoRouteReply::Error QGeoRouteParser::parseReply(QList<QGeoRoute> &routes, QStr
     return d->parseReply(routes, errorString, reply);
 }
 
+/*
+    Parses \a data on a worker thread and delivers the routes to \a reply, see
+    QGeoRouteReplyPrivate::parseAsync(). As with the synchronous replies, the
+    request is set on every route, and only as many routes as alternatives
+    were requested are kept. \a postProcess, if given, also runs on the worker
+    thread. The parser must not be reconfigured while parses are pending.
+*/
+void QGeoRouteParser::parseReplyAsync(QGeoRouteReply *reply, const QByteArray &data,
+                                      std::function<void (QList<QGeoRoute> &routes)> postProcess) const
+{
+    Q_D(const QGeoRouteParser);
+    {
+        QMutexLocker locker(&d->asyncMutex);
+        ++d->pendingAsyncParses;
+    }
+
+    const QGeoRouteRequest request = reply->request();
+    QGeoRouteReplyPrivate::parseAsync(reply,
+        [d, data, request, postProcess](QList<QGeoRoute> &routes, QString &errorString) {
+            QGeoRouteReply::Error error = d->parseReply(routes, errorString, data);
+            if (error == QGeoRouteReply::NoError) {
+                routes = routes.mid(0, request.numberAlternativeRoutes() + 1);
+                for (QGeoRoute &route : routes)
+                    route.setRequest(request);
+                if (postProcess)
+                    postProcess(routes);
+            }
+
+            QMutexLocker locker(&d->asyncMutex);
+            if (--d->pendingAsyncParses == 0)
+                d->asyncFinished.wakeAll();
+            return error;
+        });
+}
+
 QUrl QGeoRouteParser::requestUrl(const QGeoRouteRequest &request, const QString &prefix) const
 {
     Q_D(const QGeoRouteParser);
@@ -53,6 +53,7 @@
 #include <QtLocation/qgeorouterequest.h>
 #include <QtCore/QByteArray>
 #include <QtCore/QUrl>
+#include <functional>
 
 QT_BEGIN_NAMESPACE
 
@@ -70,6 +71,8 @@ public:
     };
     virtual ~QGeoRouteParser();
     QGeoRouteReply::Error parseReply(QList<QGeoRoute> &routes, QString &errorString, const QByteArray &reply) const;
+    void parseReplyAsync(QGeoRouteReply *reply, const QByteArray &data,
+                         std::function<void (QList<QGeoRoute> &routes)> postProcess = nullptr) const;
     QUrl requestUrl(const QGeoRouteRequest &request, const QString &prefix) const;
 
     TrafficSide trafficSide() const;
@@ -50,6 +50,8 @@
 
 #include <QtCore/private/qobject_p.h>
 #include <QtCore/QUrl>
+#include <QtCore/QMutex>
+#include <QtCore/QWaitCondition>
 #include <QtLocation/qgeoroutereply.h>
 #include <QtLocation/qgeorouterequest.h>
 
@@ -66,6 +68,11 @@ public:
     virtual QUrl requestUrl(const QGeoRouteRequest &request, const QString &prefix) const = 0;
 
     QGeoRouteParser::TrafficSide trafficSide;
+
+    // parses still running on worker threads, the parser waits for them on destruction
+    mutable QMutex asyncMutex;
+    mutable QWaitCondition asyncFinished;
+    mutable int pendingAsyncParses;
 };
 
 QT_END_NAMESPACE
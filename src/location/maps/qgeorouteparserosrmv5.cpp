@@ -52,38 +52,47 @@
 
 QT_BEGIN_NAMESPACE
 
-static QList<QGeoCoordinate> decodePolyline(const QString &polylineString)
+// Decodes an encoded polyline, with a precision of 1e5 for polyline and 1e6 for
+// polyline6, straight from the UTF-16 data of the JSON string and appends it to path.
+static void decodePolyline(const QString &polylineString, double precision, QList<QGeoCoordinate> &path)
 {
-    QList<QGeoCoordinate> path;
-    if (polylineString.isEmpty())
-        return path;
-
-    QByteArray data = polylineString.toLatin1();
-
+    const QChar *data = polylineString.constData();
+    const int length = polylineString.size();
+
+    // Every value ends with a chunk that has the continuation bit clear, two values
+    // make a coordinate. Counting them first lets the path grow only once.
+    int values = 0;
+    for (int i = 0; i < length; ++i)
+        values += !((data[i].unicode() - 63) & 0x20);
+    path.reserve(path.size() + values / 2);
+
+    // accumulate in fixed point, so that long paths do not drift
+    int latitude = 0;
+    int longitude = 0;
     bool parsingLatitude = true;
-
     int shift = 0;
     int value = 0;
 
-    QGeoCoordinate coord(0, 0);
-
-    for (int i = 0; i < data.length(); ++i) {
-        unsigned char c = data.at(i) - 63;
+    for (int i = 0; i < length; ++i) {
+        const int c = data[i].unicode() - 63;
 
         value |= (c & 0x1f) << shift;
         shift += 5;
 
         // another chunk
-        if (c & 0x20)
+        if (c & 0x20) {
+            if (shift >= 30) // malformed, a seventh chunk would overflow
+                return;
             continue;
+        }
 
-        int diff = (value & 1) ? ~(value >> 1) : (value >> 1);
+        const int diff = (value & 1) ? ~(value >> 1) : (value >> 1);
 
         if (parsingLatitude) {
-            coord.setLatitude(coord.latitude() + (double)diff/1e6);
+            latitude += diff;
         } else {
-            coord.setLongitude(coord.longitude() + (double)diff/1e6);
-            path.append(coord);
+            longitude += diff;
+            path.append(QGeoCoordinate(latitude / precision, longitude / precision));
         }
 
         parsingLatitude = !parsingLatitude;
@@ -91,8 +100,6 @@ static QList<QGeoCoordinate> decodePolyline(const QString &polylineString)
         value = 0;
         shift = 0;
     }
-
-    return path;
 }
 
 static QString cardinalDirection4(QLocationUtils::CardinalDirection direction)
@@ -858,8 +865,8 @@ QGeoRouteSegment QGeoRouteParserOsrmV5Private::parseStep(const QJsonObject &step
     double longitude = position[0].toDouble();
     QGeoCoordinate coord(latitude, longitude);
 
-    QString geometry = step.value(QLatin1String("geometry")).toString();
-    QList<QGeoCoordinate> path = decodePolyline(geometry);
+    QList<QGeoCoordinate> path;
+    decodePolyline(step.value(QLatin1String("geometry")).toString(), 1e6, path);
 
     QGeoManeuver::InstructionDirection maneuverInstructionDirection = instructionDirection(maneuver, trafficSide);
 
@@ -937,6 +944,7 @@ QGeoRouteReply::Error QGeoRouteParserOsrmV5Private::parseReply(QList<QGeoRoute>
 
             QJsonArray legs = routeObject.value(QLatin1String("legs")).toArray();
             QList<QGeoRouteLeg> routeLegs;
+            QList<QList<QGeoCoordinate>> legPaths;
             QGeoRoute route;
             for (int legIndex = 0; legIndex < legs.size(); ++legIndex) {
                 const QJsonValue &l = legs.at(legIndex);
@@ -975,7 +983,11 @@ QGeoRouteReply::Error QGeoRouteParserOsrmV5Private::parseReply(QList<QGeoRoute>
 
                 QGeoRouteSegmentPrivate *segmentPrivate = QGeoRouteSegmentPrivate::get(segment);
                 segmentPrivate->setLegLastSegment(true);
+                int legPathSize = 0;
+                for (const QGeoRouteSegment &s: qAsConst(legSegments))
+                    legPathSize += s.path().size();
                 QList<QGeoCoordinate> path;
+                path.reserve(legPathSize);
                 for (const QGeoRouteSegment &s: qAsConst(legSegments))
                     path.append(s.path());
                 routeLeg.setLegIndex(legIndex);
@@ -987,14 +999,19 @@ QGeoRouteReply::Error QGeoRouteParserOsrmV5Private::parseReply(QList<QGeoRoute>
                     routeLeg.setFirstRouteSegment(legSegments.first());
                 }
                 routeLegs << routeLeg;
+                legPaths << path;
 
                 segments.append(legSegments);
             }
 
             if (!error) {
+                int routePathSize = 0;
+                for (const QList<QGeoCoordinate> &legPath : qAsConst(legPaths))
+                    routePathSize += legPath.size();
                 QList<QGeoCoordinate> path;
-                foreach (const QGeoRouteSegment &s, segments)
-                    path.append(s.path());
+                path.reserve(routePathSize);
+                for (const QList<QGeoCoordinate> &legPath : qAsConst(legPaths))
+                    path.append(legPath);
 
                 for (int i = segments.size() - 1; i > 0; --i)
                     segments[i-1].setNextRouteSegment(segments[i]);
@@ -0,0 +1,441 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeorouteprogresstracker_p.h"
+
+#include <QtLocation/QGeoRoute>
+#include <QtLocation/QGeoRouteSegment>
+#include <QtPositioning/private/qgeogreatcircle_p.h>
+#include <QtCore/qmath.h>
+#include <QtCore/QPair>
+
+#include <algorithm>
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+// Same earth radius as QGeoCoordinate::distanceTo()
+const double kMetersPerDegree = 6371007.2 * M_PI / 180.0;
+// Edges closer to each other than this from a position are considered equally close
+const double kTieDistance = 1.0;
+
+double wrapLongitude(double delta)
+{
+    if (delta > 180.0)
+        return delta - 360.0;
+    if (delta < -180.0)
+        return delta + 360.0;
+    return delta;
+}
+
+}
+
+QGeoRouteProgressTracker::QGeoRouteProgressTracker()
+{
+}
+
+/*
+    Indexes the path of \a route and resets the progress. The path is built
+    from the paths of the route segments, so that every edge knows its segment.
+    Routes without segment geometry fall back to QGeoRoute::path(), as a single
+    segment.
+*/
+void QGeoRouteProgressTracker::setRoute(const QGeoRoute &route)
+{
+    clear();
+
+    int segmentIndex = 0;
+    for (QGeoRouteSegment segment = route.firstRouteSegment(); segment.isValid();
+         segment = segment.nextRouteSegment()) {
+        appendPath(segment.path(), segmentIndex++);
+    }
+    if (edgeCount() <= 0) {
+        clear();
+        appendPath(route.path(), 0);
+    }
+    if (edgeCount() <= 0) {
+        clear();
+        return;
+    }
+
+    const int count = m_latLng.size() / 2;
+    m_distances.resize(count);
+    QGeoGreatCircle::cumulativeLengths(m_latLng.constData(), count, m_distances.data());
+    buildGrid();
+}
+
+void QGeoRouteProgressTracker::appendPath(const QList<QGeoCoordinate> &path, int segment)
+{
+    m_latLng.reserve(m_latLng.size() + 2 * path.size());
+    for (const QGeoCoordinate &coordinate : path) {
+        if (!coordinate.isValid())
+            continue;
+        const double lat = coordinate.latitude();
+        const double lng = coordinate.longitude();
+        const int size = m_latLng.size();
+        if (size >= 2) {
+            // consecutive segments usually share their end points
+            if (m_latLng.at(size - 2) == lat && m_latLng.at(size - 1) == lng)
+                continue;
+            m_edgeSegments.append(segment);
+        }
+        m_latLng.append(lat);
+        m_latLng.append(lng);
+    }
+}
+
+/*
+    Edges are added to every cell they pass through, by sampling them every half
+    cell. The cells are at least twice as large as the off route distance, also
+    in longitude at the highest latitude of the route, so every edge within that
+    distance of a position is in the cell of the position or in one of the eight
+    cells around it.
+*/
+void QGeoRouteProgressTracker::buildGrid()
+{
+    m_cellKeys.clear();
+    m_firstCellEdge.clear();
+    m_cellEdges.clear();
+
+    const int edges = edgeCount();
+    if (edges <= 0)
+        return;
+
+    double maxLatitude = 0.0;
+    for (int i = 0; i < m_latLng.size(); i += 2)
+        maxLatitude = qMax(maxLatitude, qAbs(m_latLng.at(i)));
+
+    const double distanceDegrees = m_offRouteDistance / kMetersPerDegree;
+    const double minCos = qMax(qCos(qDegreesToRadians(qMin(maxLatitude + distanceDegrees, 90.0))), 0.05);
+    m_cellSize = qBound(1e-5, 2.0 * distanceDegrees / minCos, 90.0);
+    m_columns = qCeil(360.0 / m_cellSize);
+
+    QVector<QPair<quint64, int>> entries;
+    entries.reserve(edges * 2);
+    const double *latLng = m_latLng.constData();
+    for (int edge = 0; edge < edges; ++edge) {
+        const double lat = latLng[2 * edge];
+        const double lng = latLng[2 * edge + 1];
+        const double dLat = latLng[2 * edge + 2] - lat;
+        const double dLng = wrapLongitude(latLng[2 * edge + 3] - lng);
+        const int steps = qMax(1, qCeil(qMax(qAbs(dLat), qAbs(dLng)) / (0.5 * m_cellSize)));
+        quint64 previous = std::numeric_limits<quint64>::max();
+        for (int s = 0; s <= steps; ++s) {
+            const double f = double(s) / steps;
+            const quint64 key = cellKey(cellRow(lat + f * dLat), cellColumn(lng + f * dLng));
+            if (key != previous)
+                entries.append(qMakePair(key, edge));
+            previous = key;
+        }
+    }
+    std::sort(entries.begin(), entries.end());
+    entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+
+    m_cellEdges.reserve(entries.size());
+    for (const auto &entry : qAsConst(entries)) {
+        if (m_cellKeys.isEmpty() || m_cellKeys.last() != entry.first) {
+            m_cellKeys.append(entry.first);
+            m_firstCellEdge.append(m_cellEdges.size());
+        }
+        m_cellEdges.append(entry.second);
+    }
+    m_firstCellEdge.append(m_cellEdges.size());
+}
+
+/*
+    Removes the route.
+*/
+void QGeoRouteProgressTracker::clear()
+{
+    m_latLng.clear();
+    m_distances.clear();
+    m_edgeSegments.clear();
+    m_cellKeys.clear();
+    m_firstCellEdge.clear();
+    m_cellEdges.clear();
+    reset();
+}
+
+/*
+    Forgets the progress along the route, the next update searches the whole route.
+*/
+void QGeoRouteProgressTracker::reset()
+{
+    m_match = Match();
+    m_deviation = 0.0;
+    m_matched = false;
+    m_offRoute = false;
+    m_misses = 0;
+}
+
+void QGeoRouteProgressTracker::setOffRouteDistance(double distance)
+{
+    if (distance <= 0.0 || distance == m_offRouteDistance)
+        return;
+    m_offRouteDistance = distance;
+    buildGrid();
+}
+
+double QGeoRouteProgressTracker::offRouteDistance() const
+{
+    return m_offRouteDistance;
+}
+
+void QGeoRouteProgressTracker::setOffRouteCount(int count)
+{
+    m_offRouteCount = qMax(1, count);
+}
+
+int QGeoRouteProgressTracker::offRouteCount() const
+{
+    return m_offRouteCount;
+}
+
+/*
+    Sets how far ahead of the last matched position the window search looks.
+    This should cover the distance travelled between two position updates.
+*/
+void QGeoRouteProgressTracker::setLookAheadDistance(double distance)
+{
+    m_lookAheadDistance = qMax(0.0, distance);
+}
+
+double QGeoRouteProgressTracker::lookAheadDistance() const
+{
+    return m_lookAheadDistance;
+}
+
+/*
+    Matches \a position against the route. Returns \c true if the position is
+    within offRouteDistance() of the route, in which case the progress is updated.
+*/
+bool QGeoRouteProgressTracker::update(const QGeoCoordinate &position)
+{
+    if (isEmpty() || !position.isValid())
+        return false;
+
+    const double lat = position.latitude();
+    const double lng = position.longitude();
+
+    Match best;
+    bool found = m_matched && searchWindow(lat, lng, &best);
+    if (!found)
+        found = searchGrid(lat, lng, &best);
+
+    m_deviation = best.edge >= 0 ? best.distance : std::numeric_limits<double>::infinity();
+    if (found) {
+        m_match = best;
+        m_matched = true;
+        m_offRoute = false;
+        m_misses = 0;
+    } else if (++m_misses >= m_offRouteCount) {
+        m_offRoute = true;
+    }
+    return found;
+}
+
+/*
+    Projects the position on \a edge in a local equirectangular frame centered
+    on the position, and keeps it in \a best if it is closer than the current
+    candidate. Among equally close edges the first one ahead of the last match
+    wins, so that overlapping parts of the route, like a road taken there and
+    back, do not make the progress jump.
+*/
+void QGeoRouteProgressTracker::matchEdge(int edge, double lat, double lng, double cosLat,
+                                         Match *best) const
+{
+    const double *a = m_latLng.constData() + 2 * edge;
+    const double ax = wrapLongitude(a[1] - lng) * cosLat * kMetersPerDegree;
+    const double ay = (a[0] - lat) * kMetersPerDegree;
+    const double dx = wrapLongitude(a[3] - a[1]) * cosLat * kMetersPerDegree;
+    const double dy = (a[2] - a[0]) * kMetersPerDegree;
+    const double length2 = dx * dx + dy * dy;
+    const double t = length2 > 0.0 ? qBound(0.0, -(ax * dx + ay * dy) / length2, 1.0) : 0.0;
+    const double px = ax + t * dx;
+    const double py = ay + t * dy;
+    const double distance = qSqrt(px * px + py * py);
+    const double along = m_distances.at(edge) + t * (m_distances.at(edge + 1) - m_distances.at(edge));
+
+    if (best->edge >= 0) {
+        if (distance > best->distance + kTieDistance)
+            return;
+        if (distance >= best->distance - kTieDistance) {
+            const double reference = m_matched ? m_match.along : 0.0;
+            const bool ahead = along >= reference;
+            const bool bestAhead = best->along >= reference;
+            if (ahead != bestAhead ? !ahead : (ahead ? along >= best->along : along <= best->along))
+                return;
+        }
+    }
+    best->edge = edge;
+    best->t = t;
+    best->distance = distance;
+    best->along = along;
+}
+
+/*
+    Searches the edges from offRouteDistance() behind the last match, which
+    covers positions jittering backwards, to lookAheadDistance() ahead of it.
+*/
+bool QGeoRouteProgressTracker::searchWindow(double lat, double lng, Match *best) const
+{
+    const double cosLat = qCos(qDegreesToRadians(lat));
+    const double from = m_match.along - m_offRouteDistance;
+    const double to = m_match.along + m_lookAheadDistance;
+    const int edges = edgeCount();
+
+    for (int edge = m_match.edge; edge >= 0 && m_distances.at(edge + 1) >= from; --edge)
+        matchEdge(edge, lat, lng, cosLat, best);
+    for (int edge = m_match.edge + 1; edge < edges && m_distances.at(edge) <= to; ++edge)
+        matchEdge(edge, lat, lng, cosLat, best);
+
+    return best->edge >= 0 && best->distance <= m_offRouteDistance;
+}
+
+bool QGeoRouteProgressTracker::searchGrid(double lat, double lng, Match *best) const
+{
+    const double cosLat = qCos(qDegreesToRadians(lat));
+    const int row = cellRow(lat);
+    const int column = cellColumn(lng);
+
+    for (int r = row - 1; r <= row + 1; ++r) {
+        if (r < 0)
+            continue;
+        for (int c = column - 1; c <= column + 1; ++c) {
+            const quint64 key = cellKey(r, (c + m_columns) % m_columns);
+            const auto it = std::lower_bound(m_cellKeys.cbegin(), m_cellKeys.cend(), key);
+            if (it == m_cellKeys.cend() || *it != key)
+                continue;
+            const int cell = int(it - m_cellKeys.cbegin());
+            for (int i = m_firstCellEdge.at(cell); i < m_firstCellEdge.at(cell + 1); ++i)
+                matchEdge(m_cellEdges.at(i), lat, lng, cosLat, best);
+        }
+    }
+
+    return best->edge >= 0 && best->distance <= m_offRouteDistance;
+}
+
+quint64 QGeoRouteProgressTracker::cellKey(int row, int column) const
+{
+    return (quint64(quint32(row)) << 32) | quint32(column);
+}
+
+int QGeoRouteProgressTracker::cellRow(double lat) const
+{
+    return qFloor((lat + 90.0) / m_cellSize);
+}
+
+int QGeoRouteProgressTracker::cellColumn(double lng) const
+{
+    const int column = qFloor((lng + 180.0) / m_cellSize) % m_columns;
+    return column < 0 ? column + m_columns : column;
+}
+
+int QGeoRouteProgressTracker::edgeCount() const
+{
+    return m_latLng.size() / 2 - 1;
+}
+
+bool QGeoRouteProgressTracker::isEmpty() const
+{
+    return edgeCount() <= 0;
+}
+
+/*
+    Returns \c true once a position has been matched to the route.
+*/
+bool QGeoRouteProgressTracker::isMatched() const
+{
+    return m_matched;
+}
+
+bool QGeoRouteProgressTracker::isOffRoute() const
+{
+    return m_offRoute;
+}
+
+/*
+    Returns the index of the edge of the flattened path the last match is on, or -1.
+*/
+int QGeoRouteProgressTracker::currentEdge() const
+{
+    return m_matched ? m_match.edge : -1;
+}
+
+/*
+    Returns the index of the route segment the last match is on.
+*/
+int QGeoRouteProgressTracker::currentSegment() const
+{
+    return m_matched ? m_edgeSegments.at(m_match.edge) : 0;
+}
+
+double QGeoRouteProgressTracker::totalDistance() const
+{
+    return m_distances.isEmpty() ? 0.0 : m_distances.last();
+}
+
+double QGeoRouteProgressTracker::traveledDistance() const
+{
+    return m_matched ? m_match.along : 0.0;
+}
+
+double QGeoRouteProgressTracker::remainingDistance() const
+{
+    return totalDistance() - traveledDistance();
+}
+
+/*
+    Returns the distance from the last position to the closest point found on
+    the route, or infinity if no part of the route was near it.
+*/
+double QGeoRouteProgressTracker::deviation() const
+{
+    return m_deviation;
+}
+
+QGeoCoordinate QGeoRouteProgressTracker::matchedCoordinate() const
+{
+    if (!m_matched)
+        return QGeoCoordinate();
+    const double *a = m_latLng.constData() + 2 * m_match.edge;
+    const double lng = a[1] + m_match.t * wrapLongitude(a[3] - a[1]);
+    return QGeoCoordinate(a[0] + m_match.t * (a[2] - a[0]), wrapLongitude(lng));
+}
+
+QT_END_NAMESPACE
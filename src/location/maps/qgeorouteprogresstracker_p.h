@@ -0,0 +1,148 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOROUTEPROGRESSTRACKER_P_H
+#define QGEOROUTEPROGRESSTRACKER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtLocation/private/qlocationglobal_p.h>
+#include <QtCore/QList>
+#include <QtCore/QVector>
+#include <QtPositioning/QGeoCoordinate>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoRoute;
+
+/*
+    Matches a stream of positions against the path of a route and keeps track
+    of the progress along it.
+
+    setRoute() flattens the route into a single polyline, remembering which
+    route segment each edge belongs to, and indexes the edges in a uniform grid.
+    update() first looks for the closest edge in a window around the last
+    matched position, so its cost does not depend on the length of the route.
+    The grid is only searched when nothing in the window is close enough, for
+    instance after a gap in the position updates.
+
+    A position is off route when no edge is within offRouteDistance() of it.
+    isOffRoute() only becomes true after offRouteCount() consecutive such
+    positions, so that a single bad fix does not trigger rerouting, and becomes
+    false again as soon as a position matches.
+*/
+class Q_LOCATION_PRIVATE_EXPORT QGeoRouteProgressTracker
+{
+public:
+    QGeoRouteProgressTracker();
+
+    void setRoute(const QGeoRoute &route);
+    void clear();
+    void reset();
+
+    void setOffRouteDistance(double distance);
+    double offRouteDistance() const;
+    void setOffRouteCount(int count);
+    int offRouteCount() const;
+    void setLookAheadDistance(double distance);
+    double lookAheadDistance() const;
+
+    bool update(const QGeoCoordinate &position);
+
+    bool isEmpty() const;
+    bool isMatched() const;
+    bool isOffRoute() const;
+    int currentEdge() const;
+    int currentSegment() const;
+    double totalDistance() const;
+    double traveledDistance() const;
+    double remainingDistance() const;
+    double deviation() const;
+    QGeoCoordinate matchedCoordinate() const;
+
+private:
+    struct Match {
+        int edge = -1;
+        double t = 0.0;
+        double distance = 0.0;
+        double along = 0.0;
+    };
+
+    int edgeCount() const;
+    void appendPath(const QList<QGeoCoordinate> &path, int segment);
+    void buildGrid();
+    void matchEdge(int edge, double lat, double lng, double cosLat, Match *best) const;
+    bool searchWindow(double lat, double lng, Match *best) const;
+    bool searchGrid(double lat, double lng, Match *best) const;
+    quint64 cellKey(int row, int column) const;
+    int cellRow(double lat) const;
+    int cellColumn(double lng) const;
+
+    // packed latitude/longitude pairs and the distance along the route of each vertex
+    QVector<double> m_latLng;
+    QVector<double> m_distances;
+    QVector<int> m_edgeSegments;
+
+    // edges by grid cell, sorted by cell key
+    double m_cellSize = 0.0;
+    int m_columns = 0;
+    QVector<quint64> m_cellKeys;
+    QVector<int> m_firstCellEdge;
+    QVector<int> m_cellEdges;
+
+    double m_offRouteDistance = 50.0;
+    double m_lookAheadDistance = 500.0;
+    int m_offRouteCount = 3;
+
+    Match m_match;
+    double m_deviation = 0.0;
+    bool m_matched = false;
+    bool m_offRoute = false;
+    int m_misses = 0;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOROUTEPROGRESSTRACKER_P_H
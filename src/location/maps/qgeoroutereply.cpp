@@ -36,6 +36,9 @@
 
 #include "qgeoroutereply.h"
 #include "qgeoroutereply_p.h"
+#include "qgeoparsetask_p.h"
+
+#include <QtCore/QSharedPointer>
 
 QT_BEGIN_NAMESPACE
 
@@ -274,4 +277,35 @@ QGeoRouteReplyPrivate::QGeoRouteReplyPrivate(QGeoRouteReply::Error error, QStrin
 
 QGeoRouteReplyPrivate::~QGeoRouteReplyPrivate() {}
 
+/*
+    Runs \a parse on a worker thread and delivers its outcome to \a reply through
+    setRoutes() and setFinished(), or setError(), once back in the thread of the
+    reply. Nothing is delivered if the reply is aborted or destroyed meanwhile.
+    \a parse must not access the reply.
+*/
+void QGeoRouteReplyPrivate::parseAsync(QGeoRouteReply *reply, ParseFunction parse)
+{
+    struct Result
+    {
+        QGeoRouteReply::Error error = QGeoRouteReply::NoError;
+        QString errorString;
+        QList<QGeoRoute> routes;
+    };
+    QSharedPointer<Result> result(new Result);
+
+    const QGeoParseTask::Handle task = QGeoParseTask::start(reply,
+        [result, parse]() {
+            result->error = parse(result->routes, result->errorString);
+        },
+        [reply, result]() {
+            if (result->error == QGeoRouteReply::NoError) {
+                reply->setRoutes(result->routes);
+                reply->setFinished(true);
+            } else {
+                reply->setError(result->error, result->errorString);
+            }
+        });
+    QObject::connect(reply, &QGeoRouteReply::aborted, reply, [task]() { task.cancel(); });
+}
+
 QT_END_NAMESPACE
@@ -88,6 +88,7 @@ protected:
 
 private:
     QGeoRouteReplyPrivate *d_ptr;
+    friend class QGeoRouteReplyPrivate;
     Q_DISABLE_COPY(QGeoRouteReply)
 };
 
@@ -48,22 +48,27 @@
 // We mean it.
 //
 
+#include <QtLocation/private/qlocationglobal_p.h>
 #include "qgeorouterequest.h"
 #include "qgeoroutereply.h"
 
 #include <QList>
+#include <functional>
 
 QT_BEGIN_NAMESPACE
 
 class QGeoRoute;
 
-class QGeoRouteReplyPrivate
+class Q_LOCATION_PRIVATE_EXPORT QGeoRouteReplyPrivate
 {
 public:
     explicit QGeoRouteReplyPrivate(const QGeoRouteRequest &request);
     QGeoRouteReplyPrivate(QGeoRouteReply::Error error, QString errorString);
     ~QGeoRouteReplyPrivate();
 
+    typedef std::function<QGeoRouteReply::Error (QList<QGeoRoute> &routes, QString &errorString)> ParseFunction;
+    static void parseAsync(QGeoRouteReply *reply, ParseFunction parse);
+
     QGeoRouteReply::Error error;
     QString errorString;
     bool isFinished;
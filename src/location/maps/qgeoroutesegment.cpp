@@ -366,6 +366,35 @@ QGeoRouteSegmentPrivate *QGeoRouteSegmentPrivate::get(QGeoRouteSegment &segment)
     return segment.d_ptr.data();
 }
 
+/*
+    Returns a copy of \a segment and of the segments following it which
+    shares no data with the original chain. Segments already recorded in
+    \a copies are reused, so that the chains of a route and of its legs
+    keep pointing at the same segments.
+*/
+QGeoRouteSegment QGeoRouteSegmentPrivate::deepCopy(const QGeoRouteSegment &segment, Copies *copies)
+{
+    const QGeoRouteSegmentPrivate *first = segment.d_ptr.data();
+    if (!first)
+        return segment;
+
+    QGeoRouteSegmentPrivate *previous = nullptr;
+    for (const QGeoRouteSegmentPrivate *d = first; d; d = d->m_nextSegment.data()) {
+        const auto it = copies->constFind(d);
+        if (it != copies->constEnd()) {
+            if (previous)
+                previous->m_nextSegment = it.value();
+            break;
+        }
+        QExplicitlySharedDataPointer<QGeoRouteSegmentPrivate> copy(const_cast<QGeoRouteSegmentPrivate *>(d)->clone());
+        copies->insert(d, copy);
+        if (previous)
+            previous->m_nextSegment = copy;
+        previous = copy.data();
+    }
+    return QGeoRouteSegment(copies->value(first));
+}
+
 /*******************************************************************************
 *******************************************************************************/
 
@@ -54,6 +54,7 @@
 
 
 #include <QSharedData>
+#include <QHash>
 #include <QList>
 #include <QString>
 
@@ -95,6 +96,9 @@ public:
     QExplicitlySharedDataPointer<QGeoRouteSegmentPrivate> m_nextSegment;
     static QGeoRouteSegmentPrivate *get(QGeoRouteSegment &segment);
 
+    typedef QHash<const QGeoRouteSegmentPrivate *, QExplicitlySharedDataPointer<QGeoRouteSegmentPrivate> > Copies;
+    static QGeoRouteSegment deepCopy(const QGeoRouteSegment &segment, Copies *copies);
+
 protected:
     virtual bool equals(const QGeoRouteSegmentPrivate &other) const;
 };
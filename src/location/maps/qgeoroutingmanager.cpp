@@ -37,6 +37,7 @@
 #include "qgeoroutingmanager.h"
 #include "qgeoroutingmanager_p.h"
 #include "qgeoroutingmanagerengine.h"
+#include "qgeoservicecache_p.h"
 
 #include <QLocale>
 
@@ -163,15 +164,19 @@ QGeoRoutingManager::QGeoRoutingManager(QGeoRoutingManagerEngine *engine, QObject
     if (d_ptr->engine) {
         d_ptr->engine->setParent(this);
 
-        connect(d_ptr->engine,
-                SIGNAL(finished(QGeoRouteReply*)),
-                this,
-                SIGNAL(finished(QGeoRouteReply*)));
-
-        connect(d_ptr->engine,
-                SIGNAL(error(QGeoRouteReply*,QGeoRouteReply::Error,QString)),
-                this,
-                SIGNAL(error(QGeoRouteReply*,QGeoRouteReply::Error,QString)));
+        // Replies the response cache requested on behalf of its callers
+        // are reported through the replies it handed out instead.
+        connect(d_ptr->engine, &QGeoRoutingManagerEngine::finished,
+                this, [this](QGeoRouteReply *reply) {
+            if (!d_ptr->cache || !d_ptr->cache->isUpstream(reply))
+                emit finished(reply);
+        });
+
+        connect(d_ptr->engine, &QGeoRoutingManagerEngine::error,
+                this, [this](QGeoRouteReply *reply, QGeoRouteReply::Error error, const QString &errorString) {
+            if (!d_ptr->cache || !d_ptr->cache->isUpstream(reply))
+                emit this->error(reply, error, errorString);
+        });
     } else {
         qFatal("The routing manager engine that was set for this routing manager was NULL.");
     }
@@ -232,6 +237,12 @@ int QGeoRoutingManager::managerVersion() const
 */
 QGeoRouteReply *QGeoRoutingManager::calculateRoute(const QGeoRouteRequest &request)
 {
+    if (d_ptr->cache) {
+        const QByteArray key = QGeoServiceCache::routeKey(request, locale(), measurementSystem());
+        return d_ptr->cache->calculateRoute(key, request, this, [this, request]() {
+            return d_ptr->engine->calculateRoute(request);
+        });
+    }
     return d_ptr->engine->calculateRoute(request);
 }
 
@@ -401,7 +412,7 @@ Use deleteLater() instead.
 *******************************************************************************/
 
 QGeoRoutingManagerPrivate::QGeoRoutingManagerPrivate()
-    : engine(0) {}
+    : engine(0), cache(0) {}
 
 QGeoRoutingManagerPrivate::~QGeoRoutingManagerPrivate()
 {
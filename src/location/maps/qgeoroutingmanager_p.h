@@ -51,6 +51,7 @@
 QT_BEGIN_NAMESPACE
 
 class QGeoRoutingManagerEngine;
+class QGeoServiceCache;
 
 class QGeoRoutingManagerPrivate
 {
@@ -59,6 +60,7 @@ public:
     ~QGeoRoutingManagerPrivate();
 
     QGeoRoutingManagerEngine *engine;
+    QGeoServiceCache *cache;
 
 private:
     Q_DISABLE_COPY(QGeoRoutingManagerPrivate)
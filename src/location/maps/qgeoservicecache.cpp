@@ -0,0 +1,943 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeoservicecache_p.h"
+#include "qabstractgeotilecache_p.h"
+#include "qgeoroute_p.h"
+#include "qgeocodereply.h"
+#include "qgeocodingmanager.h"
+#include "qgeoroutereply.h"
+#include "qgeorouterequest.h"
+#include "qgeoroutingmanager.h"
+#include "qplacecategory.h"
+#include "qplacemanager.h"
+#include "qplacesearchreply.h"
+#include "qplacesearchrequest.h"
+#include "qplacesearchresult.h"
+
+#include <QtPositioning/QGeoAddress>
+#include <QtPositioning/QGeoCoordinate>
+#include <QtPositioning/QGeoLocation>
+#include <QtPositioning/QGeoRectangle>
+#include <QtCore/QCache>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QPointer>
+#include <QtCore/QSaveFile>
+#include <QtCore/QSet>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+const quint32 DiskMagic = 0x51475343; // "QGSC"
+const quint32 DiskVersion = 1;
+const int StreamVersion = QDataStream::Qt_5_12;
+
+enum KeyType {
+    GeocodeAddressKey,
+    GeocodeTextKey,
+    ReverseGeocodeKey,
+    RouteKey,
+    SearchKey
+};
+
+struct GeocodeResult
+{
+    QList<QGeoLocation> locations;
+    QGeoShape viewport;
+    int limit = -1;
+    int offset = 0;
+};
+
+struct RouteResult
+{
+    QList<QGeoRoute> routes;
+};
+
+struct SearchResult
+{
+    QList<QPlaceSearchResult> results;
+    QPlaceSearchRequest request;
+    QPlaceSearchRequest previousPage;
+    QPlaceSearchRequest nextPage;
+};
+
+/*
+    The replies handed out by the cache. They are completed from a cached
+    result, or from the single engine reply shared by identical requests.
+*/
+class QGeoCodeReplyCached : public QGeoCodeReply
+{
+public:
+    explicit QGeoCodeReplyCached(QObject *parent) : QGeoCodeReply(parent) {}
+
+    void abort() override
+    {
+        m_aborted = true;
+        QGeoCodeReply::abort();
+    }
+
+    bool isAborted() const { return m_aborted; }
+
+    void complete(const GeocodeResult &result)
+    {
+        setViewport(result.viewport);
+        setLimit(result.limit);
+        setOffset(result.offset);
+        setLocations(result.locations);
+        setFinished(true);
+    }
+
+    void fail(QGeoCodeReply *upstream)
+    {
+        setError(upstream->error(), upstream->errorString());
+    }
+
+private:
+    bool m_aborted = false;
+};
+
+class QGeoRouteReplyCached : public QGeoRouteReply
+{
+public:
+    QGeoRouteReplyCached(const QGeoRouteRequest &request, QObject *parent)
+        : QGeoRouteReply(request, parent) {}
+
+    void abort() override
+    {
+        m_aborted = true;
+        QGeoRouteReply::abort();
+    }
+
+    bool isAborted() const { return m_aborted; }
+
+    void complete(const RouteResult &result)
+    {
+        // Routes are explicitly shared, hand out copies so that a client
+        // modifying its route does not alter the cached one.
+        QList<QGeoRoute> routes;
+        routes.reserve(result.routes.size());
+        for (const QGeoRoute &route : result.routes)
+            routes.append(QGeoRoutePrivate::deepCopy(route));
+        setRoutes(routes);
+        setFinished(true);
+    }
+
+    void fail(QGeoRouteReply *upstream)
+    {
+        setError(upstream->error(), upstream->errorString());
+    }
+
+private:
+    bool m_aborted = false;
+};
+
+class QPlaceSearchReplyCached : public QPlaceSearchReply
+{
+public:
+    explicit QPlaceSearchReplyCached(QObject *parent) : QPlaceSearchReply(parent) {}
+
+    void abort() override
+    {
+        m_aborted = true;
+        QPlaceSearchReply::abort();
+    }
+
+    bool isAborted() const { return m_aborted; }
+
+    void complete(const SearchResult &result)
+    {
+        setRequest(result.request);
+        setResults(result.results);
+        setPreviousPageRequest(result.previousPage);
+        setNextPageRequest(result.nextPage);
+        setFinished(true);
+        emit finished();
+    }
+
+    void fail(QPlaceSearchReply *upstream)
+    {
+        setError(upstream->error(), upstream->errorString());
+        setFinished(true);
+        emit error(upstream->error(), upstream->errorString());
+        emit finished();
+    }
+
+private:
+    bool m_aborted = false;
+};
+
+struct GeocodeTraits
+{
+    typedef QGeoCodeReply Reply;
+    typedef QGeoCodeReplyCached Proxy;
+    typedef QGeoCodingManager Manager;
+    typedef GeocodeResult Result;
+
+    static bool failed(QGeoCodeReply *reply)
+    {
+        return reply->error() != QGeoCodeReply::NoError;
+    }
+
+    static GeocodeResult capture(QGeoCodeReply *reply)
+    {
+        GeocodeResult result;
+        result.locations = reply->locations();
+        result.viewport = reply->viewport();
+        result.limit = reply->limit();
+        result.offset = reply->offset();
+        return result;
+    }
+
+    static void connectManager(QGeoCodingManager *manager, QGeoCodeReplyCached *proxy)
+    {
+        QObject::connect(proxy, &QGeoCodeReply::finished, manager, [manager, proxy]() {
+            emit manager->finished(proxy);
+        });
+        QObject::connect(proxy, QOverload<QGeoCodeReply::Error, const QString &>::of(&QGeoCodeReply::error),
+                         manager, [manager, proxy](QGeoCodeReply::Error error, const QString &errorString) {
+            emit manager->error(proxy, error, errorString);
+        });
+    }
+};
+
+struct RouteTraits
+{
+    typedef QGeoRouteReply Reply;
+    typedef QGeoRouteReplyCached Proxy;
+    typedef QGeoRoutingManager Manager;
+    typedef RouteResult Result;
+
+    static bool failed(QGeoRouteReply *reply)
+    {
+        return reply->error() != QGeoRouteReply::NoError;
+    }
+
+    static RouteResult capture(QGeoRouteReply *reply)
+    {
+        RouteResult result;
+        result.routes = reply->routes();
+        return result;
+    }
+
+    static void connectManager(QGeoRoutingManager *manager, QGeoRouteReplyCached *proxy)
+    {
+        QObject::connect(proxy, &QGeoRouteReply::finished, manager, [manager, proxy]() {
+            emit manager->finished(proxy);
+        });
+        QObject::connect(proxy, QOverload<QGeoRouteReply::Error, const QString &>::of(&QGeoRouteReply::error),
+                         manager, [manager, proxy](QGeoRouteReply::Error error, const QString &errorString) {
+            emit manager->error(proxy, error, errorString);
+        });
+    }
+};
+
+struct SearchTraits
+{
+    typedef QPlaceSearchReply Reply;
+    typedef QPlaceSearchReplyCached Proxy;
+    typedef QPlaceManager Manager;
+    typedef SearchResult Result;
+
+    static bool failed(QPlaceSearchReply *reply)
+    {
+        return reply->error() != QPlaceReply::NoError;
+    }
+
+    static SearchResult capture(QPlaceSearchReply *reply)
+    {
+        SearchResult result;
+        result.results = reply->results();
+        result.request = reply->request();
+        result.previousPage = reply->previousPageRequest();
+        result.nextPage = reply->nextPageRequest();
+        return result;
+    }
+
+    static void connectManager(QPlaceManager *manager, QPlaceSearchReplyCached *proxy)
+    {
+        QObject::connect(proxy, &QPlaceReply::finished, manager, [manager, proxy]() {
+            emit manager->finished(proxy);
+        });
+        QObject::connect(proxy, QOverload<QPlaceReply::Error, const QString &>::of(&QPlaceReply::error),
+                         manager, [manager, proxy](QPlaceReply::Error error, const QString &errorString) {
+            emit manager->error(proxy, error, errorString);
+        });
+    }
+};
+
+template <class Traits>
+struct Channel
+{
+    struct Entry
+    {
+        typename Traits::Result result;
+        qint64 expires;
+    };
+
+    struct Pending
+    {
+        typename Traits::Reply *upstream;
+        QList<QPointer<typename Traits::Proxy> > proxies;
+    };
+
+    QCache<QByteArray, Entry> memory;
+    QHash<QByteArray, Pending> pending;
+};
+
+QString normalized(const QString &text)
+{
+    return text.simplified().toCaseFolded();
+}
+
+// Coordinates are compared to the microdegree, about 10 cm.
+void writeCoordinate(QDataStream &stream, const QGeoCoordinate &coordinate)
+{
+    stream << qint64(qRound64(coordinate.latitude() * 1e6))
+           << qint64(qRound64(coordinate.longitude() * 1e6));
+}
+
+QByteArray hashed(const QByteArray &data)
+{
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+}
+
+void writeLocation(QDataStream &stream, const QGeoLocation &location)
+{
+    const QGeoAddress address = location.address();
+    stream << location.coordinate() << QGeoShape(location.boundingBox())
+           << address.country() << address.countryCode() << address.state()
+           << address.county() << address.city() << address.district()
+           << address.street() << address.postalCode()
+           << (address.isTextGenerated() ? QString() : address.text());
+}
+
+QGeoLocation readLocation(QDataStream &stream)
+{
+    QGeoCoordinate coordinate;
+    QGeoShape boundingBox;
+    QString country, countryCode, state, county, city, district, street, postalCode, text;
+    stream >> coordinate >> boundingBox
+           >> country >> countryCode >> state
+           >> county >> city >> district
+           >> street >> postalCode
+           >> text;
+
+    QGeoAddress address;
+    address.setCountry(country);
+    address.setCountryCode(countryCode);
+    address.setState(state);
+    address.setCounty(county);
+    address.setCity(city);
+    address.setDistrict(district);
+    address.setStreet(street);
+    address.setPostalCode(postalCode);
+    if (!text.isEmpty())
+        address.setText(text);
+
+    QGeoLocation location;
+    location.setCoordinate(coordinate);
+    location.setBoundingBox(QGeoRectangle(boundingBox));
+    location.setAddress(address);
+    return location;
+}
+
+} // namespace
+
+class QGeoServiceCachePrivate
+{
+public:
+    template <class Traits>
+    typename Traits::Reply *request(QGeoServiceCache *q, Channel<Traits> &channel,
+                                    const QByteArray &key, typename Traits::Manager *manager,
+                                    typename Traits::Proxy *proxy,
+                                    const std::function<typename Traits::Reply *()> &send);
+    template <class Traits>
+    void complete(Channel<Traits> &channel, const QByteArray &key,
+                  typename Traits::Reply *upstream);
+    template <class Traits>
+    void detach(Channel<Traits> &channel, const QByteArray &key, typename Traits::Proxy *proxy);
+
+    bool load(const QByteArray &key, GeocodeResult *result, qint64 *expires);
+    void store(const QByteArray &key, const GeocodeResult &result, qint64 expires);
+    bool load(const QByteArray &, RouteResult *, qint64 *) { return false; }
+    void store(const QByteArray &, const RouteResult &, qint64) {}
+    bool load(const QByteArray &, SearchResult *, qint64 *) { return false; }
+    void store(const QByteArray &, const SearchResult &, qint64) {}
+    void forgetFile(const QString &fileName);
+    void removeFile(const QString &fileName);
+
+    QGeoServiceCache::Service service = QGeoServiceCache::Geocoding;
+    qint64 timeToLive = 0; // msecs
+
+    Channel<GeocodeTraits> geocoding;
+    Channel<RouteTraits> routing;
+    Channel<SearchTraits> places;
+
+    // Engine replies owned by the cache, not reported through the manager.
+    QSet<const QObject *> upstream;
+
+    // Geocoding results are also kept on disk, oldest files are removed
+    // first once the directory grows past maxDiskUsage.
+    QString directory;
+    qint64 maxDiskUsage = 0;
+    qint64 diskUsage = -1; // -1 until the directory has been scanned
+    QList<QPair<QString, qint64> > diskFiles;
+
+    quint64 requests = 0;
+    quint64 memoryHits = 0;
+    quint64 diskHits = 0;
+    quint64 coalesced = 0;
+    quint64 misses = 0;
+};
+
+template <class Traits>
+typename Traits::Reply *QGeoServiceCachePrivate::request(QGeoServiceCache *q, Channel<Traits> &channel,
+                                                         const QByteArray &key,
+                                                         typename Traits::Manager *manager,
+                                                         typename Traits::Proxy *proxy,
+                                                         const std::function<typename Traits::Reply *()> &send)
+{
+    typedef typename Traits::Reply Reply;
+    typedef typename Traits::Proxy Proxy;
+    typedef typename Channel<Traits>::Entry Entry;
+
+    ++requests;
+    Traits::connectManager(manager, proxy);
+    QObject::connect(proxy, &Reply::aborted, q, [this, &channel, key, proxy]() {
+        detach(channel, key, proxy);
+    });
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    typename Traits::Result result;
+    bool hit = false;
+    if (const Entry *entry = channel.memory.object(key)) {
+        if (entry->expires > now) {
+            result = entry->result;
+            hit = true;
+            ++memoryHits;
+        } else {
+            channel.memory.remove(key);
+        }
+    }
+    qint64 expires = 0;
+    if (!hit && load(key, &result, &expires)) {
+        channel.memory.insert(key, new Entry{ result, expires });
+        hit = true;
+        ++diskHits;
+    }
+
+    if (hit) {
+        // Complete from the event loop, as the caller has yet to connect
+        // to the reply.
+        QPointer<Proxy> guard(proxy);
+        QMetaObject::invokeMethod(q, [guard, result]() {
+            if (guard && !guard->isAborted())
+                guard->complete(result);
+        }, Qt::QueuedConnection);
+        emit q->statisticsChanged();
+        return proxy;
+    }
+
+    auto it = channel.pending.find(key);
+    if (it != channel.pending.end()) {
+        it->proxies.append(proxy);
+        ++coalesced;
+        emit q->statisticsChanged();
+        return proxy;
+    }
+
+    ++misses;
+    Reply *reply = send();
+    channel.pending.insert(key, { reply, { proxy } });
+
+    const QObject *object = reply;
+    upstream.insert(object);
+    QObject::connect(reply, &QObject::destroyed, q, [this, object]() {
+        upstream.remove(object);
+    });
+    if (reply->isFinished()) {
+        QMetaObject::invokeMethod(q, [this, &channel, key, reply]() {
+            complete(channel, key, reply);
+        }, Qt::QueuedConnection);
+    } else {
+        QObject::connect(reply, &Reply::finished, q, [this, &channel, key, reply]() {
+            complete(channel, key, reply);
+        });
+    }
+
+    emit q->statisticsChanged();
+    return proxy;
+}
+
+template <class Traits>
+void QGeoServiceCachePrivate::complete(Channel<Traits> &channel, const QByteArray &key,
+                                       typename Traits::Reply *upstream)
+{
+    typedef typename Channel<Traits>::Entry Entry;
+
+    auto it = channel.pending.find(key);
+    if (it == channel.pending.end() || it->upstream != upstream)
+        return; // every proxy was aborted
+    const QList<QPointer<typename Traits::Proxy> > proxies = it->proxies;
+    channel.pending.erase(it);
+
+    if (Traits::failed(upstream)) {
+        // Errors are passed on but not remembered.
+        for (const auto &proxy : proxies) {
+            if (proxy && !proxy->isAborted())
+                proxy->fail(upstream);
+        }
+    } else {
+        const typename Traits::Result result = Traits::capture(upstream);
+        const qint64 expires = QDateTime::currentMSecsSinceEpoch() + timeToLive;
+        channel.memory.insert(key, new Entry{ result, expires });
+        store(key, result, expires);
+        for (const auto &proxy : proxies) {
+            if (proxy && !proxy->isAborted())
+                proxy->complete(result);
+        }
+    }
+
+    upstream->deleteLater();
+}
+
+template <class Traits>
+void QGeoServiceCachePrivate::detach(Channel<Traits> &channel, const QByteArray &key,
+                                     typename Traits::Proxy *proxy)
+{
+    auto it = channel.pending.find(key);
+    if (it == channel.pending.end())
+        return;
+
+    it->proxies.removeAll(proxy);
+    it->proxies.removeAll(QPointer<typename Traits::Proxy>());
+    if (!it->proxies.isEmpty())
+        return;
+
+    // Nobody waits for the result anymore.
+    typename Traits::Reply *upstream = it->upstream;
+    channel.pending.erase(it);
+    upstream->abort();
+    upstream->deleteLater();
+}
+
+bool QGeoServiceCachePrivate::load(const QByteArray &key, GeocodeResult *result, qint64 *expires)
+{
+    if (directory.isEmpty())
+        return false;
+
+    const QString fileName = QString::fromLatin1(key.toHex());
+    QFile file(directory + QLatin1Char('/') + fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&file);
+    stream.setVersion(StreamVersion);
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint32 limit = -1;
+    qint32 offset = 0;
+    quint32 count = 0;
+    stream >> magic >> version;
+    if (magic == DiskMagic && version == DiskVersion) {
+        stream >> *expires >> result->viewport >> limit >> offset >> count;
+        result->limit = limit;
+        result->offset = offset;
+        for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i)
+            result->locations.append(readLocation(stream));
+    }
+    file.close();
+
+    if (magic != DiskMagic || version != DiskVersion || stream.status() != QDataStream::Ok
+            || *expires <= QDateTime::currentMSecsSinceEpoch()) {
+        removeFile(fileName);
+        *result = GeocodeResult();
+        return false;
+    }
+    return true;
+}
+
+void QGeoServiceCachePrivate::store(const QByteArray &key, const GeocodeResult &result, qint64 expires)
+{
+    if (directory.isEmpty())
+        return;
+
+    if (diskUsage < 0) {
+        QDir().mkpath(directory);
+        diskUsage = 0;
+        const QFileInfoList files = QDir(directory).entryInfoList(QDir::Files, QDir::Time | QDir::Reversed);
+        for (const QFileInfo &info : files) {
+            diskFiles.append(qMakePair(info.fileName(), info.size()));
+            diskUsage += info.size();
+        }
+    }
+
+    const QString fileName = QString::fromLatin1(key.toHex());
+    QSaveFile file(directory + QLatin1Char('/') + fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+
+    QDataStream stream(&file);
+    stream.setVersion(StreamVersion);
+    stream << DiskMagic << DiskVersion << expires << result.viewport
+           << qint32(result.limit) << qint32(result.offset) << quint32(result.locations.size());
+    for (const QGeoLocation &location : result.locations)
+        writeLocation(stream, location);
+    const qint64 size = file.size();
+    if (stream.status() != QDataStream::Ok || !file.commit())
+        return;
+
+    forgetFile(fileName);
+    diskFiles.append(qMakePair(fileName, size));
+    diskUsage += size;
+    while (diskUsage > maxDiskUsage && !diskFiles.isEmpty())
+        removeFile(diskFiles.first().first);
+}
+
+void QGeoServiceCachePrivate::forgetFile(const QString &fileName)
+{
+    for (int i = 0; i < diskFiles.size(); ++i) {
+        if (diskFiles.at(i).first == fileName) {
+            diskUsage -= diskFiles.at(i).second;
+            diskFiles.removeAt(i);
+            return;
+        }
+    }
+}
+
+void QGeoServiceCachePrivate::removeFile(const QString &fileName)
+{
+    forgetFile(fileName);
+    QFile::remove(directory + QLatin1Char('/') + fileName);
+}
+
+/*!
+    \class QGeoServiceCache
+    \inmodule QtLocation
+    \internal
+
+    \brief The QGeoServiceCache class caches the replies of the geocoding,
+    routing and places search engines of a service provider.
+
+    Requests are reduced to a key, so that requests differing only in
+    letter case, white space or sub-decimeter coordinate noise share their
+    result. Identical requests issued while one is still in flight are
+    coalesced into a single engine request. Successful results are kept in
+    an LRU memory cache, and geocoding results also on disk, until their
+    time to live expires.
+
+    The cache is configured with service provider parameters:
+
+    \list
+    \li \c cache.services.ttl, the time to live of a result in seconds for
+        all services. The default 0 disables caching.
+    \li \c cache.services.geocoding.ttl, \c cache.services.routing.ttl and
+        \c cache.services.places.ttl override it per service.
+    \li \c cache.services.memory.size, the number of results kept in memory
+        per service, 100 by default.
+    \li \c cache.services.disk.size, the size in bytes of the geocoding disk
+        cache, 10 MiB by default. 0 disables it.
+    \li \c cache.services.directory, where the disk cache is stored.
+    \endlist
+
+    Routes and place search results only live in memory, since they may
+    carry engine specific data that cannot be written out.
+*/
+
+QGeoServiceCache::QGeoServiceCache(QGeoServiceCachePrivate *dd, QObject *parent)
+    : QObject(parent), d_ptr(dd)
+{
+}
+
+QGeoServiceCache::~QGeoServiceCache()
+{
+}
+
+/*!
+    Returns a cache for \a service configured from \a parameters, or
+    \c nullptr if caching is disabled for it.
+*/
+QGeoServiceCache *QGeoServiceCache::create(Service service, const QString &providerName,
+                                           const QVariantMap &parameters, QObject *parent)
+{
+    static const char *const serviceNames[] = { "geocoding", "routing", "places" };
+
+    qint64 timeToLive = parameters.value(QStringLiteral("cache.services.ttl")).toLongLong();
+    const QString serviceTimeToLive = QStringLiteral("cache.services.%1.ttl")
+            .arg(QLatin1String(serviceNames[service]));
+    if (parameters.contains(serviceTimeToLive))
+        timeToLive = parameters.value(serviceTimeToLive).toLongLong();
+    if (timeToLive <= 0)
+        return nullptr;
+
+    QGeoServiceCachePrivate *d = new QGeoServiceCachePrivate;
+    d->service = service;
+    d->timeToLive = timeToLive * 1000;
+
+    int memorySize = 100;
+    if (parameters.contains(QStringLiteral("cache.services.memory.size")))
+        memorySize = parameters.value(QStringLiteral("cache.services.memory.size")).toInt();
+    d->geocoding.memory.setMaxCost(memorySize);
+    d->routing.memory.setMaxCost(memorySize);
+    d->places.memory.setMaxCost(memorySize);
+
+    if (service == Geocoding) {
+        d->maxDiskUsage = 10 * 1024 * 1024;
+        if (parameters.contains(QStringLiteral("cache.services.disk.size")))
+            d->maxDiskUsage = parameters.value(QStringLiteral("cache.services.disk.size")).toLongLong();
+        if (d->maxDiskUsage > 0) {
+            QString directory = parameters.value(QStringLiteral("cache.services.directory")).toString();
+            if (directory.isEmpty()) {
+                directory = QAbstractGeoTileCache::baseCacheDirectory()
+                        + QLatin1String("QtLocation/services/") + providerName;
+            }
+            d->directory = directory + QLatin1String("/geocoding");
+        }
+    }
+
+    return new QGeoServiceCache(d, parent);
+}
+
+QGeoServiceCache::Service QGeoServiceCache::service() const
+{
+    Q_D(const QGeoServiceCache);
+    return d->service;
+}
+
+/*!
+    Returns whether \a reply was requested from the engine by the cache.
+    The manager does not report such replies, only the ones the cache
+    handed out for them.
+*/
+bool QGeoServiceCache::isUpstream(const QObject *reply) const
+{
+    Q_D(const QGeoServiceCache);
+    return d->upstream.contains(reply);
+}
+
+/*!
+    Returns the number of requests made through the cache.
+*/
+quint64 QGeoServiceCache::requests() const
+{
+    Q_D(const QGeoServiceCache);
+    return d->requests;
+}
+
+/*!
+    Returns the number of requests answered from memory.
+*/
+quint64 QGeoServiceCache::memoryHits() const
+{
+    Q_D(const QGeoServiceCache);
+    return d->memoryHits;
+}
+
+/*!
+    Returns the number of requests answered from disk.
+*/
+quint64 QGeoServiceCache::diskHits() const
+{
+    Q_D(const QGeoServiceCache);
+    return d->diskHits;
+}
+
+/*!
+    Returns the number of requests that joined an identical request in flight.
+*/
+quint64 QGeoServiceCache::coalesced() const
+{
+    Q_D(const QGeoServiceCache);
+    return d->coalesced;
+}
+
+/*!
+    Returns the number of requests passed on to the engine.
+*/
+quint64 QGeoServiceCache::misses() const
+{
+    Q_D(const QGeoServiceCache);
+    return d->misses;
+}
+
+/*!
+    Returns the fraction of requests that did not reach the engine.
+*/
+qreal QGeoServiceCache::hitRate() const
+{
+    Q_D(const QGeoServiceCache);
+    if (!d->requests)
+        return 0.0;
+    return qreal(d->requests - d->misses) / qreal(d->requests);
+}
+
+QByteArray QGeoServiceCache::geocodeKey(const QGeoAddress &address, const QGeoShape &bounds,
+                                        const QLocale &locale)
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(StreamVersion);
+    stream << quint8(GeocodeAddressKey) << locale.name() << bounds
+           << normalized(address.country()) << normalized(address.countryCode())
+           << normalized(address.state()) << normalized(address.county())
+           << normalized(address.city()) << normalized(address.district())
+           << normalized(address.street()) << normalized(address.postalCode())
+           << (address.isTextGenerated() ? QString() : normalized(address.text()));
+    return hashed(data);
+}
+
+QByteArray QGeoServiceCache::geocodeKey(const QString &address, int limit, int offset,
+                                        const QGeoShape &bounds, const QLocale &locale)
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(StreamVersion);
+    stream << quint8(GeocodeTextKey) << locale.name() << bounds
+           << normalized(address) << qint32(limit) << qint32(offset);
+    return hashed(data);
+}
+
+QByteArray QGeoServiceCache::reverseGeocodeKey(const QGeoCoordinate &coordinate,
+                                               const QGeoShape &bounds, const QLocale &locale)
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(StreamVersion);
+    stream << quint8(ReverseGeocodeKey) << locale.name() << bounds;
+    writeCoordinate(stream, coordinate);
+    return hashed(data);
+}
+
+QByteArray QGeoServiceCache::routeKey(const QGeoRouteRequest &request, const QLocale &locale,
+                                      QLocale::MeasurementSystem measurementSystem)
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(StreamVersion);
+    stream << quint8(RouteKey) << locale.name() << qint32(measurementSystem);
+
+    const QList<QGeoCoordinate> waypoints = request.waypoints();
+    stream << quint32(waypoints.size());
+    for (const QGeoCoordinate &waypoint : waypoints)
+        writeCoordinate(stream, waypoint);
+    stream << request.waypointsMetadata();
+
+    const QList<QGeoRectangle> excludeAreas = request.excludeAreas();
+    stream << quint32(excludeAreas.size());
+    for (const QGeoRectangle &area : excludeAreas)
+        stream << QGeoShape(area);
+
+    const QList<QGeoRouteRequest::FeatureType> featureTypes = request.featureTypes();
+    stream << quint32(featureTypes.size());
+    for (QGeoRouteRequest::FeatureType featureType : featureTypes)
+        stream << qint32(featureType) << qint32(request.featureWeight(featureType));
+
+    stream << qint32(request.numberAlternativeRoutes()) << qint32(request.travelModes())
+           << qint32(request.routeOptimization()) << qint32(request.segmentDetail())
+           << qint32(request.maneuverDetail()) << request.extraParameters();
+    return hashed(data);
+}
+
+QByteArray QGeoServiceCache::searchKey(const QPlaceSearchRequest &request,
+                                       const QList<QLocale> &locales)
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(StreamVersion);
+    stream << quint8(SearchKey) << quint32(locales.size());
+    for (const QLocale &locale : locales)
+        stream << locale.name();
+
+    const QList<QPlaceCategory> categories = request.categories();
+    stream << quint32(categories.size());
+    for (const QPlaceCategory &category : categories)
+        stream << category.categoryId();
+
+    stream << normalized(request.searchTerm()) << request.searchArea()
+           << request.recommendationId() << request.searchContext()
+           << qint32(request.visibilityScope()) << qint32(request.relevanceHint())
+           << qint32(request.limit());
+    return hashed(data);
+}
+
+/*!
+    Returns a reply for the geocoding request identified by \a key. \a send
+    issues the request to the engine if neither the cache nor a request in
+    flight can answer it. The reply is reported through \a manager.
+*/
+QGeoCodeReply *QGeoServiceCache::geocode(const QByteArray &key, QGeoCodingManager *manager,
+                                         const std::function<QGeoCodeReply *()> &send)
+{
+    Q_D(QGeoServiceCache);
+    return d->request<GeocodeTraits>(this, d->geocoding, key, manager,
+                                     new QGeoCodeReplyCached(manager), send);
+}
+
+/*!
+    Returns a reply for the route \a request identified by \a key.
+
+    \sa geocode()
+*/
+QGeoRouteReply *QGeoServiceCache::calculateRoute(const QByteArray &key,
+                                                 const QGeoRouteRequest &request,
+                                                 QGeoRoutingManager *manager,
+                                                 const std::function<QGeoRouteReply *()> &send)
+{
+    Q_D(QGeoServiceCache);
+    return d->request<RouteTraits>(this, d->routing, key, manager,
+                                   new QGeoRouteReplyCached(request, manager), send);
+}
+
+/*!
+    Returns a reply for the place search identified by \a key.
+
+    \sa geocode()
+*/
+QPlaceSearchReply *QGeoServiceCache::search(const QByteArray &key, QPlaceManager *manager,
+                                            const std::function<QPlaceSearchReply *()> &send)
+{
+    Q_D(QGeoServiceCache);
+    return d->request<SearchTraits>(this, d->places, key, manager,
+                                    new QPlaceSearchReplyCached(manager), send);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,136 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOSERVICECACHE_P_H
+#define QGEOSERVICECACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtLocation/private/qlocationglobal_p.h>
+#include <QtCore/QObject>
+#include <QtCore/QScopedPointer>
+#include <QtCore/QLocale>
+#include <QtCore/QVariantMap>
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoAddress;
+class QGeoCoordinate;
+class QGeoShape;
+class QGeoCodeReply;
+class QGeoCodingManager;
+class QGeoRouteReply;
+class QGeoRouteRequest;
+class QGeoRoutingManager;
+class QPlaceManager;
+class QPlaceSearchReply;
+class QPlaceSearchRequest;
+class QGeoServiceCachePrivate;
+
+class Q_LOCATION_PRIVATE_EXPORT QGeoServiceCache : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(quint64 requests READ requests NOTIFY statisticsChanged)
+    Q_PROPERTY(quint64 memoryHits READ memoryHits NOTIFY statisticsChanged)
+    Q_PROPERTY(quint64 diskHits READ diskHits NOTIFY statisticsChanged)
+    Q_PROPERTY(quint64 coalesced READ coalesced NOTIFY statisticsChanged)
+    Q_PROPERTY(quint64 misses READ misses NOTIFY statisticsChanged)
+    Q_PROPERTY(qreal hitRate READ hitRate NOTIFY statisticsChanged)
+
+public:
+    enum Service {
+        Geocoding,
+        Routing,
+        Places
+    };
+
+    ~QGeoServiceCache();
+
+    static QGeoServiceCache *create(Service service, const QString &providerName,
+                                    const QVariantMap &parameters, QObject *parent);
+
+    Service service() const;
+    bool isUpstream(const QObject *reply) const;
+
+    quint64 requests() const;
+    quint64 memoryHits() const;
+    quint64 diskHits() const;
+    quint64 coalesced() const;
+    quint64 misses() const;
+    qreal hitRate() const;
+
+    static QByteArray geocodeKey(const QGeoAddress &address, const QGeoShape &bounds,
+                                 const QLocale &locale);
+    static QByteArray geocodeKey(const QString &address, int limit, int offset,
+                                 const QGeoShape &bounds, const QLocale &locale);
+    static QByteArray reverseGeocodeKey(const QGeoCoordinate &coordinate, const QGeoShape &bounds,
+                                        const QLocale &locale);
+    static QByteArray routeKey(const QGeoRouteRequest &request, const QLocale &locale,
+                               QLocale::MeasurementSystem measurementSystem);
+    static QByteArray searchKey(const QPlaceSearchRequest &request, const QList<QLocale> &locales);
+
+    QGeoCodeReply *geocode(const QByteArray &key, QGeoCodingManager *manager,
+                           const std::function<QGeoCodeReply *()> &send);
+    QGeoRouteReply *calculateRoute(const QByteArray &key, const QGeoRouteRequest &request,
+                                   QGeoRoutingManager *manager,
+                                   const std::function<QGeoRouteReply *()> &send);
+    QPlaceSearchReply *search(const QByteArray &key, QPlaceManager *manager,
+                              const std::function<QPlaceSearchReply *()> &send);
+
+Q_SIGNALS:
+    void statisticsChanged();
+
+private:
+    QGeoServiceCache(QGeoServiceCachePrivate *dd, QObject *parent);
+
+    QScopedPointer<QGeoServiceCachePrivate> d_ptr;
+    Q_DECLARE_PRIVATE(QGeoServiceCache)
+    Q_DISABLE_COPY(QGeoServiceCache)
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOSERVICECACHE_P_H
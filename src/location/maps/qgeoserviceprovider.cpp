@@ -39,8 +39,10 @@
 #include "qgeoserviceproviderfactory.h"
 
 #include "qgeocodingmanager.h"
+#include "qgeocodingmanager_p.h"
 #include "qgeomappingmanager_p.h"
 #include "qgeoroutingmanager.h"
+#include "qgeoroutingmanager_p.h"
 #include "qplacemanager.h"
 #include "qnavigationmanager_p.h"
 #include "qgeocodingmanagerengine.h"
@@ -49,6 +51,7 @@
 #include "qplacemanagerengine.h"
 #include "qplacemanagerengine_p.h"
 #include "qnavigationmanagerengine_p.h"
+#include "qgeoservicecache_p.h"
 
 #include <QList>
 #include <QString>
@@ -114,6 +117,41 @@ Q_GLOBAL_STATIC_WITH_ARGS(QFactoryLoader, loader,
 
     Please check the GeoServices plugin specific documentation to
     obtain a complete list of the available parameter names/keys and values.
+
+    Independently of the plugin, the geocoding, routing and place search
+    results can be cached. Identical requests made while one is in progress
+    then share a single request to the service, and later ones are answered
+    from the cache until the result expires. The cache is configured with
+    the following parameters:
+
+    \table
+    \header
+        \li Parameter
+        \li Description
+    \row
+        \li cache.services.ttl
+        \li Time in seconds a result is kept. The default value of 0 disables the cache.
+    \row
+        \li cache.services.geocoding.ttl, cache.services.routing.ttl, cache.services.places.ttl
+        \li Override \c cache.services.ttl for geocoding, routing or place search.
+    \row
+        \li cache.services.memory.size
+        \li Number of results per service kept in memory. The default value is 100.
+    \row
+        \li cache.services.disk.size
+        \li Size in bytes of the disk cache for geocoding results. The default value
+        is 10 MiB, 0 keeps geocoding results in memory only. Routes and place search
+        results are always kept in memory only.
+    \row
+        \li cache.services.directory
+        \li Directory of the disk cache. By default it is located in the
+        QtLocation cache directory, next to the map tiles.
+    \endtable
+
+    When a list of addresses or coordinates is geocoded and the plugin has no
+    batch service to send it to, the items are sent one by one. The
+    \c geocoding.batch.concurrency parameter sets how many of them are in
+    flight at the same time. The default value is 4.
 */
 
 /*!
@@ -365,6 +403,33 @@ template <> QNavigationManagerEngine *createEngine<QNavigationManagerEngine>(QGe
     return d_ptr->factoryV2->createNavigationManagerEngine(d_ptr->cleanedParameterMap, &(d_ptr->navigationError), &(d_ptr->navigationErrorString));
 }
 
+/* Hooks the response cache, if enabled, into the managers whose
+ * replies it can share */
+template <class Manager>
+void QGeoServiceProviderPrivate::attachCache(Manager *)
+{
+}
+template <> void QGeoServiceProviderPrivate::attachCache<QGeoCodingManager>(QGeoCodingManager *manager)
+{
+    bool ok = false;
+    const int concurrency = cleanedParameterMap.value(QStringLiteral("geocoding.batch.concurrency")).toInt(&ok);
+    if (ok && concurrency > 0)
+        manager->d_ptr->batchConcurrency = concurrency;
+
+    manager->d_ptr->cache = QGeoServiceCache::create(QGeoServiceCache::Geocoding, providerName,
+                                                     cleanedParameterMap, manager);
+}
+template <> void QGeoServiceProviderPrivate::attachCache<QGeoRoutingManager>(QGeoRoutingManager *manager)
+{
+    manager->d_ptr->cache = QGeoServiceCache::create(QGeoServiceCache::Routing, providerName,
+                                                     cleanedParameterMap, manager);
+}
+template <> void QGeoServiceProviderPrivate::attachCache<QPlaceManager>(QPlaceManager *manager)
+{
+    manager->d->d_ptr->cache = QGeoServiceCache::create(QGeoServiceCache::Places, providerName,
+                                                        cleanedParameterMap, manager);
+}
+
 /* Template for generating the code for each of the geocodingManager(),
  * mappingManager() etc methods */
 template <class Manager, class Engine>
@@ -413,6 +478,9 @@ Manager *QGeoServiceProviderPrivate::manager(QGeoServiceProvider::Error *_error,
 
         if (manager && this->localeSet)
             manager->setLocale(this->locale);
+
+        if (manager)
+            this->attachCache(manager);
     }
 
     if (manager) {
@@ -83,6 +83,8 @@ public:
                      QString *errorString, Manager **manager);
     template <class Flags>
     Flags features(const char *enumName);
+    template <class Manager>
+    void attachCache(Manager *manager);
 
     QGeoServiceProviderFactory *factory;
     QGeoServiceProviderFactoryV2 *factoryV2 = nullptr;
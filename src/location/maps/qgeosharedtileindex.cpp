@@ -0,0 +1,537 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeosharedtileindex_p.h"
+#include "qgeotilespec_p.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QRandomGenerator>
+#include <QtCore/QVector>
+
+#include <algorithm>
+#include <cstring>
+
+QT_BEGIN_NAMESPACE
+
+static const quint32 indexMagic = 0x51544958;
+static const quint32 indexVersion = 1;
+
+enum SlotState {
+    SlotEmpty = 0,
+    SlotRemoved,
+    SlotFetching,
+    SlotPresent
+};
+
+// Laid out the same way in every process, so only fixed size types.
+struct QGeoSharedTileIndex::Header
+{
+    quint32 magic;
+    quint32 version;
+    qint32 capacity;
+    qint32 used;        // slots that are not empty, removed ones included
+    qint32 count;       // tiles present
+    qint32 reserved;
+    qint64 maxCost;
+    qint64 totalCost;
+    qint64 clock;       // ticks on every use, for the LRU order
+};
+
+struct QGeoSharedTileIndex::Slot
+{
+    quint64 key;
+    quint64 owner;      // index instance fetching the tile
+    qint64 cost;
+    qint64 lastUse;
+    qint64 claimed;     // msecs since epoch at which the fetch was claimed
+    quint32 state;
+    char fileName[92];
+};
+
+namespace {
+
+// QSharedMemory only serializes processes, and is not thread-safe itself, so
+// the threads of this process, such as the GUI and the disk writer, take the
+// mutex first.
+class IndexLocker
+{
+public:
+    IndexLocker(QMutex *mutex, QSharedMemory *memory)
+        : m_locker(mutex), m_memory(memory)
+    {
+        m_memory->lock();
+    }
+    ~IndexLocker() { m_memory->unlock(); }
+
+private:
+    QMutexLocker m_locker;
+    QSharedMemory *m_memory;
+};
+
+}
+
+// FNV-1a rather than qHash(), as the key must be the same in every process.
+static quint64 tileKey(const QGeoTileSpec &spec)
+{
+    QByteArray id = spec.plugin().toUtf8();
+    for (int value : { spec.mapId(), spec.zoom(), spec.x(), spec.y(), spec.version() })
+        id += '/' + QByteArray::number(value);
+
+    quint64 hash = Q_UINT64_C(14695981039346656037);
+    for (char c : qAsConst(id)) {
+        hash ^= quint8(c);
+        hash *= Q_UINT64_C(1099511628211);
+    }
+    return hash;
+}
+
+/*
+    Attaches to the index of \a directory, creating it with room for
+    \a capacity tiles if no other process has it yet.
+*/
+QGeoSharedTileIndex::QGeoSharedTileIndex(const QString &directory, int capacity)
+    : m_owner(QRandomGenerator::global()->generate64() | 1),
+      m_claimTimeout(30000),
+      m_initializer(false)
+{
+    const QDir dir(directory);
+    const QString path = dir.exists() ? dir.canonicalPath() : dir.absolutePath();
+    m_memory.setKey(QStringLiteral("qtlocation-tiles-")
+                    + QString::fromLatin1(QCryptographicHash::hash(path.toUtf8(),
+                                                                   QCryptographicHash::Sha1).toHex()));
+
+    const int size = int(sizeof(Header) + sizeof(Slot) * size_t(qMax(64, capacity)));
+    if (!m_memory.create(size)
+            && (m_memory.error() != QSharedMemory::AlreadyExists || !m_memory.attach())) {
+        m_errorString = m_memory.errorString();
+        return;
+    }
+
+    bool compatible = true;
+    {
+        IndexLocker locker(&m_mutex, &m_memory);
+        Header *h = header();
+        if (h->magic == 0) {
+            // Whichever process locks a new segment first sets it up.
+            std::memset(m_memory.data(), 0, size_t(m_memory.size()));
+            h->magic = indexMagic;
+            h->version = indexVersion;
+            h->capacity = int((size_t(m_memory.size()) - sizeof(Header)) / sizeof(Slot));
+            m_initializer = true;
+        } else if (h->magic != indexMagic || h->version != indexVersion
+                   || sizeof(Header) + sizeof(Slot) * size_t(h->capacity) > size_t(m_memory.size())) {
+            compatible = false;
+        }
+    }
+
+    if (!compatible) {
+        m_errorString = QStringLiteral("The shared tile index was created by an incompatible version");
+        m_memory.detach();
+    }
+}
+
+QGeoSharedTileIndex::~QGeoSharedTileIndex()
+{
+}
+
+/*
+    Returns the capacity an index needs to hold \a tiles tiles. As the
+    least recently used tiles are evicted down to 80% of the capacity once
+    90% of it is used, that is a quarter more than \a tiles, bounded so
+    that the shared memory segment stays below about 140 MiB.
+*/
+int QGeoSharedTileIndex::capacityFor(qint64 tiles)
+{
+    return int(qBound<qint64>(64, tiles + tiles / 4 + 1, 1 << 20));
+}
+
+bool QGeoSharedTileIndex::isValid() const
+{
+    return m_memory.isAttached();
+}
+
+/*
+    Returns whether this instance set up the index, in which case the tiles
+    already in the directory are for it to add.
+*/
+bool QGeoSharedTileIndex::isInitializer() const
+{
+    return m_initializer;
+}
+
+QString QGeoSharedTileIndex::errorString() const
+{
+    return m_errorString;
+}
+
+int QGeoSharedTileIndex::capacity() const
+{
+    if (!isValid())
+        return 0;
+    IndexLocker locker(&m_mutex, &m_memory);
+    return header()->capacity;
+}
+
+/*
+    Sets the maximum total cost of the tiles of all the processes. Tiles are
+    evicted on the next insertion if it is exceeded. A maximum of 0 never
+    evicts.
+*/
+void QGeoSharedTileIndex::setMaxCost(qint64 maxCost)
+{
+    if (!isValid())
+        return;
+    IndexLocker locker(&m_mutex, &m_memory);
+    header()->maxCost = maxCost;
+}
+
+qint64 QGeoSharedTileIndex::maxCost() const
+{
+    if (!isValid())
+        return 0;
+    IndexLocker locker(&m_mutex, &m_memory);
+    return header()->maxCost;
+}
+
+qint64 QGeoSharedTileIndex::totalCost() const
+{
+    if (!isValid())
+        return 0;
+    IndexLocker locker(&m_mutex, &m_memory);
+    return header()->totalCost;
+}
+
+int QGeoSharedTileIndex::count() const
+{
+    if (!isValid())
+        return 0;
+    IndexLocker locker(&m_mutex, &m_memory);
+    return header()->count;
+}
+
+/*
+    Sets how long, in \a msecs, a fetch claimed by a process blocks the
+    others, in case the process died before finishing it.
+*/
+void QGeoSharedTileIndex::setClaimTimeout(int msecs)
+{
+    m_claimTimeout = msecs;
+}
+
+int QGeoSharedTileIndex::claimTimeout() const
+{
+    return m_claimTimeout;
+}
+
+/*
+    Records that tile \a spec is on disk as \a fileName, relative to the
+    cache directory, and ends any fetch of it. Returns the file names of the
+    tiles evicted to make room for it, which the caller has to delete.
+
+    Tiles whose file name does not fit in the index, or that there is no
+    room for, are not recorded, but their fetch ends all the same.
+*/
+QStringList QGeoSharedTileIndex::insert(const QGeoTileSpec &spec, const QString &fileName, qint64 cost)
+{
+    QStringList evicted;
+    if (!isValid())
+        return evicted;
+
+    const QByteArray name = fileName.toUtf8();
+    IndexLocker locker(&m_mutex, &m_memory);
+    Header *h = header();
+    Slot *slot = name.size() < int(sizeof(Slot::fileName))
+            ? findOrCreate(tileKey(spec), &evicted) : nullptr;
+    if (!slot) {
+        slot = find(tileKey(spec));
+        if (slot && slot->state == SlotFetching && slot->owner == m_owner)
+            removeSlot(slot);
+        return evicted;
+    }
+
+    if (slot->state == SlotPresent) {
+        h->totalCost -= slot->cost;
+        --h->count;
+    }
+    slot->state = SlotPresent;
+    slot->owner = 0;
+    slot->claimed = 0;
+    slot->cost = cost;
+    slot->lastUse = ++h->clock;
+    std::memcpy(slot->fileName, name.constData(), size_t(name.size()));
+    slot->fileName[name.size()] = '\0';
+    h->totalCost += cost;
+    ++h->count;
+
+    if (h->maxCost > 0)
+        evict(h->maxCost, h->capacity, slot, &evicted);
+    return evicted;
+}
+
+/*
+    Returns the file name of tile \a spec if it is on disk, and counts it as
+    used.
+*/
+QString QGeoSharedTileIndex::lookup(const QGeoTileSpec &spec)
+{
+    if (!isValid())
+        return QString();
+
+    IndexLocker locker(&m_mutex, &m_memory);
+    Slot *slot = find(tileKey(spec));
+    if (!slot || slot->state != SlotPresent)
+        return QString();
+    slot->lastUse = ++header()->clock;
+    return QString::fromUtf8(slot->fileName);
+}
+
+void QGeoSharedTileIndex::remove(const QGeoTileSpec &spec)
+{
+    if (!isValid())
+        return;
+
+    IndexLocker locker(&m_mutex, &m_memory);
+    if (Slot *slot = find(tileKey(spec)))
+        removeSlot(slot);
+}
+
+void QGeoSharedTileIndex::clear()
+{
+    if (!isValid())
+        return;
+
+    IndexLocker locker(&m_mutex, &m_memory);
+    Header *h = header();
+    std::memset(slotAt(0), 0, sizeof(Slot) * size_t(h->capacity));
+    h->used = 0;
+    h->count = 0;
+    h->totalCost = 0;
+}
+
+QGeoSharedTileIndex::TileState QGeoSharedTileIndex::state(const QGeoTileSpec &spec) const
+{
+    if (!isValid())
+        return Missing;
+
+    IndexLocker locker(&m_mutex, &m_memory);
+    const Slot *slot = find(tileKey(spec));
+    if (!slot)
+        return Missing;
+    if (slot->state == SlotPresent)
+        return Present;
+    return isClaimExpired(slot) ? Missing : Fetching;
+}
+
+/*
+    Returns true if the caller is to fetch tile \a spec, and false if it is
+    on disk already or being fetched by another process. The claim lasts
+    until the tile is inserted, the claim is released, or it times out.
+*/
+bool QGeoSharedTileIndex::claimFetch(const QGeoTileSpec &spec)
+{
+    if (!isValid())
+        return true;
+
+    IndexLocker locker(&m_mutex, &m_memory);
+    const quint64 key = tileKey(spec);
+    Slot *slot = find(key);
+    if (slot) {
+        if (slot->state == SlotPresent)
+            return false;
+        if (slot->owner != m_owner && !isClaimExpired(slot))
+            return false;
+    } else {
+        slot = findOrCreate(key, nullptr);
+        if (!slot)
+            return true;
+    }
+
+    slot->state = SlotFetching;
+    slot->owner = m_owner;
+    slot->claimed = QDateTime::currentMSecsSinceEpoch();
+    slot->cost = 0;
+    slot->fileName[0] = '\0';
+    return true;
+}
+
+void QGeoSharedTileIndex::releaseFetch(const QGeoTileSpec &spec)
+{
+    if (!isValid())
+        return;
+
+    IndexLocker locker(&m_mutex, &m_memory);
+    Slot *slot = find(tileKey(spec));
+    if (slot && slot->state == SlotFetching && slot->owner == m_owner)
+        removeSlot(slot);
+}
+
+QGeoSharedTileIndex::Header *QGeoSharedTileIndex::header() const
+{
+    return static_cast<Header *>(m_memory.data());
+}
+
+QGeoSharedTileIndex::Slot *QGeoSharedTileIndex::slotAt(int index) const
+{
+    return reinterpret_cast<Slot *>(static_cast<char *>(m_memory.data()) + sizeof(Header)) + index;
+}
+
+QGeoSharedTileIndex::Slot *QGeoSharedTileIndex::find(quint64 key) const
+{
+    const int capacity = header()->capacity;
+    int index = int(key % quint64(capacity));
+    for (int probes = 0; probes < capacity; ++probes) {
+        Slot *slot = slotAt(index);
+        if (slot->state == SlotEmpty)
+            return nullptr;
+        if (slot->state != SlotRemoved && slot->key == key)
+            return slot;
+        if (++index == capacity)
+            index = 0;
+    }
+    return nullptr;
+}
+
+/*
+    Returns the slot of \a key, or a new empty one, which the caller has to
+    fill in. When the table is nearly full, the least recently used tiles
+    are evicted into \a evicted, unless it is null, in which case null is
+    returned.
+*/
+QGeoSharedTileIndex::Slot *QGeoSharedTileIndex::findOrCreate(quint64 key, QStringList *evicted)
+{
+    if (Slot *slot = find(key))
+        return slot;
+
+    Header *h = header();
+    const int limit = h->capacity * 9 / 10;
+    if (h->used >= limit) {
+        if (evicted)
+            evict(h->totalCost, h->capacity * 8 / 10, nullptr, evicted);
+        compact();
+        if (h->used >= limit)
+            return nullptr;
+    }
+
+    int index = int(key % quint64(h->capacity));
+    forever {
+        Slot *slot = slotAt(index);
+        if (slot->state == SlotEmpty || slot->state == SlotRemoved) {
+            if (slot->state == SlotEmpty)
+                ++h->used;
+            std::memset(slot, 0, sizeof(Slot));
+            slot->key = key;
+            slot->state = SlotRemoved;
+            return slot;
+        }
+        if (++index == h->capacity)
+            index = 0;
+    }
+}
+
+void QGeoSharedTileIndex::removeSlot(Slot *slot)
+{
+    if (slot->state == SlotPresent) {
+        Header *h = header();
+        h->totalCost -= slot->cost;
+        --h->count;
+    }
+    slot->state = SlotRemoved;
+}
+
+/*
+    Evicts the least recently used tiles other than \a keep until their
+    total cost is at most \a maxCost and there are at most \a maxCount.
+*/
+void QGeoSharedTileIndex::evict(qint64 maxCost, int maxCount, const Slot *keep, QStringList *evicted)
+{
+    Header *h = header();
+    if (h->totalCost <= maxCost && h->count <= maxCount)
+        return;
+
+    QVector<Slot *> candidates;
+    candidates.reserve(h->count);
+    for (int i = 0; i < h->capacity; ++i) {
+        Slot *slot = slotAt(i);
+        if (slot->state == SlotPresent && slot != keep)
+            candidates.append(slot);
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const Slot *a, const Slot *b) {
+        return a->lastUse < b->lastUse;
+    });
+
+    for (Slot *slot : qAsConst(candidates)) {
+        if (h->totalCost <= maxCost && h->count <= maxCount)
+            break;
+        evicted->append(QString::fromUtf8(slot->fileName));
+        removeSlot(slot);
+    }
+}
+
+/*
+    Rehashes the live slots, dropping removed slots and expired claims so
+    that probe sequences stay short.
+*/
+void QGeoSharedTileIndex::compact()
+{
+    Header *h = header();
+    QVector<Slot> live;
+    live.reserve(h->used);
+    for (int i = 0; i < h->capacity; ++i) {
+        const Slot *slot = slotAt(i);
+        if (slot->state == SlotPresent || (slot->state == SlotFetching && !isClaimExpired(slot)))
+            live.append(*slot);
+    }
+
+    std::memset(slotAt(0), 0, sizeof(Slot) * size_t(h->capacity));
+    h->used = live.size();
+    for (const Slot &slot : qAsConst(live)) {
+        int index = int(slot.key % quint64(h->capacity));
+        while (slotAt(index)->state != SlotEmpty) {
+            if (++index == h->capacity)
+                index = 0;
+        }
+        *slotAt(index) = slot;
+    }
+}
+
+bool QGeoSharedTileIndex::isClaimExpired(const Slot *slot) const
+{
+    return QDateTime::currentMSecsSinceEpoch() - slot->claimed > m_claimTimeout;
+}
+
+QT_END_NAMESPACE
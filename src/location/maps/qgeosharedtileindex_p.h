@@ -0,0 +1,133 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOSHAREDTILEINDEX_P_H
+#define QGEOSHAREDTILEINDEX_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtLocation/private/qlocationglobal_p.h>
+#include <QtCore/QMutex>
+#include <QtCore/QSharedMemory>
+#include <QtCore/QStringList>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoTileSpec;
+
+/*
+    An index of the tiles in a cache directory, kept in shared memory so that
+    every process caching tiles in the directory sees the same one. It
+    records which tiles are on disk, which process is fetching which tile,
+    and when each tile was last used by any of the processes, so that they
+    evict the least recently used tiles of all of them together.
+
+    The index is a fixed size open addressing hash table. Every call takes
+    a mutex, for the threads of this process, then the lock of the shared
+    memory segment, for the other processes, and may be made from any
+    thread.
+*/
+class Q_LOCATION_PRIVATE_EXPORT QGeoSharedTileIndex
+{
+public:
+    enum TileState {
+        Missing,
+        Fetching,
+        Present
+    };
+
+    explicit QGeoSharedTileIndex(const QString &directory, int capacity = 16384);
+    ~QGeoSharedTileIndex();
+
+    static int capacityFor(qint64 tiles);
+
+    bool isValid() const;
+    bool isInitializer() const;
+    QString errorString() const;
+    int capacity() const;
+
+    void setMaxCost(qint64 maxCost);
+    qint64 maxCost() const;
+    qint64 totalCost() const;
+    int count() const;
+
+    void setClaimTimeout(int msecs);
+    int claimTimeout() const;
+
+    QStringList insert(const QGeoTileSpec &spec, const QString &fileName, qint64 cost);
+    QString lookup(const QGeoTileSpec &spec);
+    void remove(const QGeoTileSpec &spec);
+    void clear();
+
+    TileState state(const QGeoTileSpec &spec) const;
+    bool claimFetch(const QGeoTileSpec &spec);
+    void releaseFetch(const QGeoTileSpec &spec);
+
+private:
+    struct Header;
+    struct Slot;
+
+    Header *header() const;
+    Slot *slotAt(int index) const;
+    Slot *find(quint64 key) const;
+    Slot *findOrCreate(quint64 key, QStringList *evicted);
+    void removeSlot(Slot *slot);
+    void evict(qint64 maxCost, int maxCount, const Slot *keep, QStringList *evicted);
+    void compact();
+    bool isClaimExpired(const Slot *slot) const;
+
+    mutable QMutex m_mutex;
+    mutable QSharedMemory m_memory;
+    QString m_errorString;
+    quint64 m_owner;
+    int m_claimTimeout;
+    bool m_initializer;
+
+    Q_DISABLE_COPY(QGeoSharedTileIndex)
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOSHAREDTILEINDEX_P_H
@@ -66,6 +66,8 @@ QGeoTiledMap::QGeoTiledMap(QGeoTiledMappingManagerEngine *engine, QObject *paren
 
     QObject::connect(engine,&QGeoTiledMappingManagerEngine::tileVersionChanged,
                      this,&QGeoTiledMap::handleTileVersionChanged);
+    QObject::connect(d->m_mapScene, &QGeoTiledMapScene::tilesResampled,
+                     this, &QGeoMap::sgNodeChanged);
     QObject::connect(this, &QGeoMap::cameraCapabilitiesChanged,
                      [d](const QGeoCameraCapabilities &oldCameraCapabilities) {
                        d->onCameraCapabilitiesChanged(oldCameraCapabilities);
@@ -81,6 +83,8 @@ QGeoTiledMap::QGeoTiledMap(QGeoTiledMapPrivate &dd, QGeoTiledMappingManagerEngin
 
     QObject::connect(engine,&QGeoTiledMappingManagerEngine::tileVersionChanged,
                      this,&QGeoTiledMap::handleTileVersionChanged);
+    QObject::connect(d->m_mapScene, &QGeoTiledMapScene::tilesResampled,
+                     this, &QGeoMap::sgNodeChanged);
     QObject::connect(this, &QGeoMap::cameraCapabilitiesChanged,
                      [d](const QGeoCameraCapabilities &oldCameraCapabilities) {
                        d->onCameraCapabilitiesChanged(oldCameraCapabilities);
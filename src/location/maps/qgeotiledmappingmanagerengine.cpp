@@ -43,11 +43,16 @@
 #include "qgeotilerequestmanager_p.h"
 #include "qgeofiletilecache_p.h"
 #include "qgeotilespec_p.h"
+#include "qgeotileregiondownload_p.h"
+#include "qgeotileretryscheduler_p.h"
+#include "qgeoparsetask_p.h"
+#include "qgeotileresampler_p.h"
 
 #include <QTimer>
 #include <QLocale>
 #include <QDir>
 #include <QStandardPaths>
+#include <QPainter>
 
 QT_BEGIN_NAMESPACE
 
@@ -56,6 +61,7 @@ QGeoTiledMappingManagerEngine::QGeoTiledMappingManagerEngine(QObject *parent)
       m_prefetchStyle(QGeoTiledMap::PrefetchTwoNeighbourLayers),
       d_ptr(new QGeoTiledMappingManagerEnginePrivate)
 {
+    d_ptr->retryScheduler_ = new QGeoTileRetryScheduler(this);
 }
 
 /*!
@@ -63,6 +69,9 @@ QGeoTiledMappingManagerEngine::QGeoTiledMappingManagerEngine(QObject *parent)
 */
 QGeoTiledMappingManagerEngine::~QGeoTiledMappingManagerEngine()
 {
+    // Region downloads use the private data when they are deleted.
+    const QList<QGeoTileRegionDownload *> downloads = d_ptr->downloads_;
+    qDeleteAll(downloads);
     delete d_ptr;
 }
 
@@ -79,6 +88,7 @@ void QGeoTiledMappingManagerEngine::setTileFetcher(QGeoTileFetcher *fetcher)
     d->fetcher_ = fetcher;
 
     qRegisterMetaType<QGeoTileSpec>();
+    qRegisterMetaType<QGeoTileMetadata>();
 
     connect(d->fetcher_,
             SIGNAL(tileFinished(QGeoTileSpec,QByteArray,QString)),
@@ -90,6 +100,16 @@ void QGeoTiledMappingManagerEngine::setTileFetcher(QGeoTileFetcher *fetcher)
             this,
             SLOT(engineTileError(QGeoTileSpec,QString)),
             Qt::QueuedConnection);
+    connect(d->fetcher_,
+            SIGNAL(tileMetadataReceived(QGeoTileSpec,QGeoTileMetadata)),
+            this,
+            SLOT(engineTileMetadataReceived(QGeoTileSpec,QGeoTileMetadata)),
+            Qt::QueuedConnection);
+    connect(d->fetcher_,
+            SIGNAL(tileNotModified(QGeoTileSpec,QGeoTileMetadata)),
+            this,
+            SLOT(engineTileNotModified(QGeoTileSpec,QGeoTileMetadata)),
+            Qt::QueuedConnection);
 
     engineInitialized();
 }
@@ -108,6 +128,9 @@ QGeoMap *QGeoTiledMappingManagerEngine::createMap()
 void QGeoTiledMappingManagerEngine::releaseMap(QGeoTiledMap *map)
 {
     d_ptr->mapHash_.remove(map);
+    d_ptr->retryScheduler_->releaseMap(map);
+    for (QSet<QGeoTiledMap *> &maps : d_ptr->composing_)
+        maps.remove(map);
 
     QHash<QGeoTileSpec, QSet<QGeoTiledMap *> > newTileHash = d_ptr->tileHash_;
     typedef QHash<QGeoTileSpec, QSet<QGeoTiledMap *> >::const_iterator h_iter;
@@ -152,6 +175,8 @@ void QGeoTiledMappingManagerEngine::updateTileRequests(QGeoTiledMap *map,
 
     d->mapHash_.insert(map, oldTiles);
 
+    d->retryScheduler_->cancel(map, tilesRemoved);
+
     // add and remove map from mapset for the tiles
 
     QSet<QGeoTileSpec> reqTiles;
@@ -162,17 +187,28 @@ void QGeoTiledMappingManagerEngine::updateTileRequests(QGeoTiledMap *map,
         QSet<QGeoTiledMap *> mapSet = d->tileHash_.value(*rem);
         mapSet.remove(map);
         if (mapSet.isEmpty()) {
-            cancelTiles.insert(*rem);
+            if (!d->downloadHash_.contains(*rem))
+                cancelTiles.insert(*rem);
             d->tileHash_.remove(*rem);
         } else {
             d->tileHash_.insert(*rem, mapSet);
         }
     }
 
+    // Tiles for hosts that keep failing wait for the scheduler's probe.
+    const bool circuitsOpen = d->retryScheduler_->hasOpenCircuits();
+
     add = tilesAdded.constBegin();
     for (; add != addEnd; ++add) {
+        if (circuitsOpen) {
+            const QString host = tileHost(*add);
+            if (d->retryScheduler_->isBlocked(host)) {
+                d->retryScheduler_->defer(map, *add, host);
+                continue;
+            }
+        }
         QSet<QGeoTiledMap *> mapSet = d->tileHash_.value(*add);
-        if (mapSet.isEmpty()) {
+        if (mapSet.isEmpty() && !d->downloadHash_.contains(*add)) {
             reqTiles.insert(*add);
         }
         mapSet.insert(map);
@@ -181,6 +217,24 @@ void QGeoTiledMappingManagerEngine::updateTileRequests(QGeoTiledMap *map,
 
     cancelTiles -= reqTiles;
 
+    // Tiles another process sharing the cache is fetching are waited for.
+    QAbstractGeoTileCache *cache = tileCache();
+    for (auto it = reqTiles.begin(); it != reqTiles.end(); ) {
+        if (cache->claimTileFetch(*it)) {
+            ++it;
+        } else {
+            d->sharedWaits_.insert(*it);
+            it = reqTiles.erase(it);
+        }
+    }
+    for (auto it = cancelTiles.begin(); it != cancelTiles.end(); ) {
+        cache->releaseTileFetch(*it);
+        if (d->sharedWaits_.remove(*it))
+            it = cancelTiles.erase(it);
+        else
+            ++it;
+    }
+
     QMetaObject::invokeMethod(d->fetcher_, "updateTileRequests",
                               Qt::QueuedConnection,
                               Q_ARG(QSet<QGeoTileSpec>, reqTiles),
@@ -207,13 +261,29 @@ void QGeoTiledMappingManagerEngine::engineTileFinished(const QGeoTileSpec &spec,
     }
 
     d->tileHash_.remove(spec);
-    tileCache()->insert(spec, bytes, format, d->cacheHint_);
+    d->revalidating_.remove(spec);
+
+    if (!d->retryScheduler_->isIdle())
+        d->retryScheduler_->tileSucceeded(spec, tileHost(spec));
+
+    // Tiles only wanted by region downloads are stored by the downloads.
+    const QSet<QGeoTileRegionDownload *> downloads = d->downloadHash_.take(spec);
+    const bool cached = !maps.isEmpty() || downloads.isEmpty();
+    if (cached)
+        tileCache()->insert(spec, bytes, format, d->cacheHint_);
+    tileCached(spec);
+    // Otherwise the claim ends once the tile is on disk.
+    if (!cached || !(d->cacheHint_ & QAbstractGeoTileCache::DiskCache))
+        tileCache()->releaseTileFetch(spec);
 
     map = maps.constBegin();
     mapEnd = maps.constEnd();
     for (; map != mapEnd; ++map) {
         (*map)->requestManager()->tileFetched(spec);
     }
+
+    for (QGeoTileRegionDownload *download : downloads)
+        download->tileFinished(spec, bytes, format, cached && (d->cacheHint_ & QAbstractGeoTileCache::DiskCache));
 }
 
 void QGeoTiledMappingManagerEngine::engineTileError(const QGeoTileSpec &spec, const QString &errorString)
@@ -234,14 +304,121 @@ void QGeoTiledMappingManagerEngine::engineTileError(const QGeoTileSpec &spec, co
             d->mapHash_.insert(*map, tileSet);
     }
     d->tileHash_.remove(spec);
+    d->revalidating_.remove(spec);
+    tileCache()->releaseTileFetch(spec);
 
+    // The maps keep waiting for the tile until the scheduler gives up on it.
+    const QString host = tileHost(spec);
+    d->retryScheduler_->hostFailed(host);
+    const bool retry = !maps.isEmpty() && d->retryScheduler_->retryTile(spec);
     for (map = maps.constBegin(); map != mapEnd; ++map) {
-        (*map)->requestManager()->tileError(spec, errorString);
+        if (retry)
+            d->retryScheduler_->defer(*map, spec, host);
+        else
+            (*map)->requestManager()->tileError(spec, errorString);
     }
 
+    const QSet<QGeoTileRegionDownload *> downloads = d->downloadHash_.take(spec);
+    for (QGeoTileRegionDownload *download : downloads)
+        download->tileFailed(spec, errorString);
+
     emit tileError(spec, errorString);
 }
 
+void QGeoTiledMappingManagerEngine::engineTileMetadataReceived(const QGeoTileSpec &spec,
+                                                               const QGeoTileMetadata &metadata)
+{
+    storeTileMetadata(spec, metadata);
+}
+
+/*
+    The cached tile is still current, so only its freshness changes. Maps
+    or downloads that started waiting for the tile while it was being
+    revalidated need the tile data, which a 304 does not carry.
+*/
+void QGeoTiledMappingManagerEngine::engineTileNotModified(const QGeoTileSpec &spec,
+                                                          const QGeoTileMetadata &metadata)
+{
+    Q_D(QGeoTiledMappingManagerEngine);
+
+    d->revalidating_.remove(spec);
+
+    if (!d->retryScheduler_->isIdle())
+        d->retryScheduler_->tileSucceeded(spec, tileHost(spec));
+
+    // Servers may leave out validators they sent with the tile itself.
+    QGeoTileMetadata current = tileCache()->metadata(spec);
+    if (!metadata.etag.isEmpty())
+        current.etag = metadata.etag;
+    if (metadata.lastModified.isValid())
+        current.lastModified = metadata.lastModified;
+    current.expires = metadata.expires;
+    storeTileMetadata(spec, current);
+
+    if (!d->tileHash_.contains(spec) && !d->downloadHash_.contains(spec))
+        return;
+    QMetaObject::invokeMethod(d->fetcher_, "updateTileRequests",
+                              Qt::QueuedConnection,
+                              Q_ARG(QSet<QGeoTileSpec>, QSet<QGeoTileSpec>() << spec),
+                              Q_ARG(QSet<QGeoTileSpec>, QSet<QGeoTileSpec>()));
+}
+
+/*
+    Another process sharing the tile cache has stopped fetching \a spec for
+    the maps waiting for it. If it gave up, the tile is fetched here.
+*/
+void QGeoTiledMappingManagerEngine::engineSharedTileFetched(const QGeoTileSpec &spec, bool fetched)
+{
+    Q_D(QGeoTiledMappingManagerEngine);
+
+    if (!d->sharedWaits_.remove(spec) || !d->tileHash_.contains(spec))
+        return;
+
+    if (!fetched) {
+        if (!tileCache()->claimTileFetch(spec)) {
+            d->sharedWaits_.insert(spec);
+            return;
+        }
+        QMetaObject::invokeMethod(d->fetcher_, "updateTileRequests",
+                                  Qt::QueuedConnection,
+                                  Q_ARG(QSet<QGeoTileSpec>, QSet<QGeoTileSpec>() << spec),
+                                  Q_ARG(QSet<QGeoTileSpec>, QSet<QGeoTileSpec>()));
+        return;
+    }
+
+    tileCached(spec);
+
+    const QSet<QGeoTiledMap *> maps = d->tileHash_.take(spec);
+    for (QGeoTiledMap *map : maps) {
+        QSet<QGeoTileSpec> tileSet = d->mapHash_.value(map);
+        tileSet.remove(spec);
+        if (tileSet.isEmpty())
+            d->mapHash_.remove(map);
+        else
+            d->mapHash_.insert(map, tileSet);
+    }
+    for (QGeoTiledMap *map : maps)
+        map->requestManager()->tileFetched(spec);
+}
+
+/*
+    Returns the host \a spec is fetched from, which failures are counted
+    against.
+*/
+QString QGeoTiledMappingManagerEngine::tileHost(const QGeoTileSpec &spec) const
+{
+    Q_D(const QGeoTiledMappingManagerEngine);
+    return d->fetcher_ ? d->fetcher_->tileHost(spec) : QString();
+}
+
+void QGeoTiledMappingManagerEngine::storeTileMetadata(const QGeoTileSpec &spec, QGeoTileMetadata metadata)
+{
+    Q_D(QGeoTiledMappingManagerEngine);
+    if (d->tileMaxAge_ >= 0)
+        metadata.expires = QDateTime::currentDateTimeUtc().addSecs(d->tileMaxAge_);
+    tileCache()->setMetadata(spec, metadata);
+}
+
 void QGeoTiledMappingManagerEngine::setTileSize(const QSize &tileSize)
 {
     Q_D(QGeoTiledMappingManagerEngine);
@@ -290,9 +467,42 @@ void QGeoTiledMappingManagerEngine::setTileCache(QAbstractGeoTileCache *cache)
     Q_ASSERT_X(!d->tileCache_, Q_FUNC_INFO, "This should be called only once");
     cache->setParent(this);
     d->tileCache_ = cache;
+    connect(d->tileCache_, &QAbstractGeoTileCache::sharedTileFetched,
+            this, &QGeoTiledMappingManagerEngine::engineSharedTileFetched);
     d->tileCache_->init();
 }
 
+/*!
+    Sets how long, in \a seconds, fetched tiles stay fresh, overriding the
+    expiry dates sent by the server. Stale tiles are still shown, but are
+    revalidated with the server in the background. A negative value, the
+    default, uses the expiry dates sent by the server.
+*/
+void QGeoTiledMappingManagerEngine::setTileMaxAge(int seconds)
+{
+    Q_D(QGeoTiledMappingManagerEngine);
+    d->tileMaxAge_ = seconds;
+}
+
+/*!
+    Enables composing tiles that are not cached from their cached children,
+    up to \a levels zoom levels further in, so that zooming out over an
+    area that was seen closer up does not have to wait for the network.
+    Composed tiles are only shown until the real tile arrives, unless
+    \a permanent is true, as for engines that work offline. The real tile
+    is still requested while a tile is being composed; in permanent mode
+    the request is cancelled once the composed tile is ready, and the
+    composed tile is dropped if the real one arrives first. A \a levels
+    of 0, the default, disables composition.
+*/
+void QGeoTiledMappingManagerEngine::setTileComposition(int levels, bool permanent)
+{
+    Q_D(QGeoTiledMappingManagerEngine);
+    d->composeLevels_ = qMax(0, levels);
+    d->composePermanent_ = permanent;
+    d->uncomposable_.clear();
+}
+
 QAbstractGeoTileCache *QGeoTiledMappingManagerEngine::tileCache()
 {
     Q_D(QGeoTiledMappingManagerEngine);
@@ -301,6 +511,8 @@ QAbstractGeoTileCache *QGeoTiledMappingManagerEngine::tileCache()
         if (!managerName().isEmpty())
             cacheDirectory = QAbstractGeoTileCache::baseLocationCacheDirectory() + managerName();
         d->tileCache_ = new QGeoFileTileCache(cacheDirectory);
+        connect(d->tileCache_, &QAbstractGeoTileCache::sharedTileFetched,
+                this, &QGeoTiledMappingManagerEngine::engineSharedTileFetched);
         d->tileCache_->init();
     }
     return d->tileCache_;
@@ -308,7 +520,240 @@ QAbstractGeoTileCache *QGeoTiledMappingManagerEngine::tileCache()
 
 QSharedPointer<QGeoTileTexture> QGeoTiledMappingManagerEngine::getTileTexture(const QGeoTileSpec &spec)
 {
-    return d_ptr->tileCache_->get(spec);
+    Q_D(QGeoTiledMappingManagerEngine);
+
+    QSharedPointer<QGeoTileTexture> texture = d->tileCache_->get(spec);
+
+    // Stale tiles are shown while they are revalidated in the background.
+    if (texture && d->fetcher_ && !d->revalidating_.contains(spec)
+            && !d->tileHash_.contains(spec) && !d->downloadHash_.contains(spec)) {
+        const QGeoTileMetadata metadata = d->tileCache_->metadata(spec);
+        if (metadata.isStale()) {
+            d->revalidating_.insert(spec);
+            QMetaObject::invokeMethod(d->fetcher_, "revalidateTile",
+                                      Qt::QueuedConnection,
+                                      Q_ARG(QGeoTileSpec, spec),
+                                      Q_ARG(QGeoTileMetadata, metadata));
+        }
+    }
+    return texture;
+}
+
+/*
+    Downscales the n x n grid of encoded \a children, in rows, into a
+    single tile. Returns a null image if a child cannot be decoded.
+*/
+static QImage composeChildren(const QVector<QByteArray> &children, int n, QSize tileSize)
+{
+    QImage result;
+    QPainter painter;
+    for (int i = 0; i < children.size(); ++i) {
+        QImage child;
+        if (!child.loadFromData(children.at(i)))
+            return QImage();
+
+        if (result.isNull()) {
+            if (!tileSize.isValid())
+                tileSize = child.size();
+            result = QImage(tileSize, QImage::Format_ARGB32_Premultiplied);
+            result.fill(Qt::transparent);
+            painter.begin(&result);
+        }
+
+        const int col = i % n;
+        const int row = i / n;
+        const QRect cell(QPoint(col * tileSize.width() / n, row * tileSize.height() / n),
+                         QPoint((col + 1) * tileSize.width() / n - 1,
+                                (row + 1) * tileSize.height() / n - 1));
+        painter.drawImage(cell.topLeft(),
+                          QGeoTileResampler::resample(child, child.rect(), cell.size()));
+    }
+    return result;
+}
+
+/*
+    Composes tile \a spec from the closest zoom level at which all of its
+    children are cached, and shows it on \a map once done. The children
+    are read, decoded and downscaled on the global thread pool. Tiles that
+    cannot be composed are not looked at again until one of their children
+    is cached.
+*/
+void QGeoTiledMappingManagerEngine::composeTile(const QGeoTileSpec &spec, QGeoTiledMap *map)
+{
+    Q_D(QGeoTiledMappingManagerEngine);
+    if (d->composeLevels_ <= 0)
+        return;
+
+    if (d->uncomposable_.contains(spec))
+        return;
+
+    QHash<QGeoTileSpec, QSet<QGeoTiledMap *> >::iterator it = d->composing_.find(spec);
+    if (it != d->composing_.end()) {
+        if (map)
+            it->insert(map);
+        return;
+    }
+
+    QAbstractGeoTileCache *cache = tileCache();
+    for (int level = 1; level <= d->composeLevels_; ++level) {
+        const int n = 1 << level;
+        QVector<QGeoTileSpec> children;
+        children.reserve(n * n);
+        for (int row = 0; row < n; ++row) {
+            for (int col = 0; col < n; ++col) {
+                const QGeoTileSpec child(spec.plugin(), spec.mapId(), spec.zoom() + level,
+                                         spec.x() * n + col, spec.y() * n + row, spec.version());
+                if (!cache->contains(child))
+                    break;
+                children.append(child);
+            }
+            if (children.size() != (row + 1) * n)
+                break;
+        }
+        if (children.size() != n * n)
+            continue;
+
+        QVector<QAbstractGeoTileCache::TileReader> readers;
+        readers.reserve(children.size());
+        for (const QGeoTileSpec &child : qAsConst(children))
+            readers.append(cache->tileReader(child));
+
+        QSet<QGeoTiledMap *> &maps = d->composing_[spec];
+        if (map)
+            maps.insert(map);
+
+        const QSize size = d->tileSize_;
+        QSharedPointer<QImage> result(new QImage);
+        QGeoParseTask::start(this,
+                             [readers, n, size, result]() {
+                                 QVector<QByteArray> data;
+                                 data.reserve(readers.size());
+                                 for (const QAbstractGeoTileCache::TileReader &reader : readers)
+                                     data.append(reader());
+                                 *result = composeChildren(data, n, size);
+                             },
+                             [this, spec, result]() {
+                                 tileComposed(spec, *result);
+                             });
+        return;
+    }
+
+    // Only bounds the memory used, forgetting merely costs lookups.
+    if (d->uncomposable_.size() >= 4096)
+        d->uncomposable_.clear();
+    d->uncomposable_.insert(spec);
+}
+
+/*
+    Called when tile \a spec is cached, which may make its ancestors
+    composable.
+*/
+void QGeoTiledMappingManagerEngine::tileCached(const QGeoTileSpec &spec)
+{
+    Q_D(QGeoTiledMappingManagerEngine);
+    if (d->uncomposable_.isEmpty())
+        return;
+
+    d->uncomposable_.remove(spec);
+    for (int level = 1; level <= d->composeLevels_ && level <= spec.zoom(); ++level) {
+        d->uncomposable_.remove(QGeoTileSpec(spec.plugin(), spec.mapId(), spec.zoom() - level,
+                                             spec.x() >> level, spec.y() >> level, spec.version()));
+    }
+}
+
+void QGeoTiledMappingManagerEngine::tileComposed(const QGeoTileSpec &spec, const QImage &image)
+{
+    Q_D(QGeoTiledMappingManagerEngine);
+
+    const QSet<QGeoTiledMap *> maps = d->composing_.take(spec);
+    if (image.isNull())
+        d->uncomposable_.insert(spec);
+    // The real tile may have arrived in the meantime.
+    if (image.isNull() || tileCache()->contains(spec))
+        return;
+
+    tileCache()->insertTexture(spec, image, !d->composePermanent_);
+
+    for (QGeoTiledMap *map : maps) {
+        if (d->composePermanent_) {
+            map->requestManager()->tileFetched(spec);
+            updateTileRequests(map, QSet<QGeoTileSpec>(), QSet<QGeoTileSpec>() << spec);
+        } else {
+            map->updateTile(spec);
+        }
+    }
+}
+
+/*!
+    Creates a download of the tiles of map \a mapId covering \a area from
+    \a minimumZoomLevel to \a maximumZoomLevel, clamped to the zoom levels
+    supported by the map. The download is not started, and is owned by the
+    engine.
+*/
+QGeoTileRegionDownload *QGeoTiledMappingManagerEngine::downloadRegion(const QGeoShape &area,
+                                                                      int minimumZoomLevel,
+                                                                      int maximumZoomLevel,
+                                                                      int mapId)
+{
+    Q_D(QGeoTiledMappingManagerEngine);
+    QGeoTileRegionDownload *download = new QGeoTileRegionDownload(this, area, minimumZoomLevel,
+                                                                  maximumZoomLevel, mapId);
+    d->downloads_.append(download);
+    return download;
+}
+
+void QGeoTiledMappingManagerEngine::requestRegionTiles(QGeoTileRegionDownload *download,
+                                                       const QSet<QGeoTileSpec> &tiles)
+{
+    Q_D(QGeoTiledMappingManagerEngine);
+
+    // Tiles already requested for a map or another download are shared.
+    QSet<QGeoTileSpec> reqTiles;
+    for (const QGeoTileSpec &spec : tiles) {
+        QSet<QGeoTileRegionDownload *> &downloads = d->downloadHash_[spec];
+        if (downloads.isEmpty() && !d->tileHash_.contains(spec))
+            reqTiles.insert(spec);
+        downloads.insert(download);
+    }
+
+    if (reqTiles.isEmpty() || !d->fetcher_)
+        return;
+    QMetaObject::invokeMethod(d->fetcher_, "updateTileRequests",
+                              Qt::QueuedConnection,
+                              Q_ARG(QSet<QGeoTileSpec>, reqTiles),
+                              Q_ARG(QSet<QGeoTileSpec>, QSet<QGeoTileSpec>()));
+}
+
+void QGeoTiledMappingManagerEngine::cancelRegionTiles(QGeoTileRegionDownload *download,
+                                                      const QSet<QGeoTileSpec> &tiles)
+{
+    Q_D(QGeoTiledMappingManagerEngine);
+
+    QSet<QGeoTileSpec> cancelTiles;
+    for (const QGeoTileSpec &spec : tiles) {
+        auto it = d->downloadHash_.find(spec);
+        if (it == d->downloadHash_.end())
+            continue;
+        it.value().remove(download);
+        if (it.value().isEmpty()) {
+            d->downloadHash_.erase(it);
+            if (!d->tileHash_.contains(spec))
+                cancelTiles.insert(spec);
+        }
+    }
+
+    if (cancelTiles.isEmpty() || !d->fetcher_)
+        return;
+    QMetaObject::invokeMethod(d->fetcher_, "updateTileRequests",
+                              Qt::QueuedConnection,
+                              Q_ARG(QSet<QGeoTileSpec>, QSet<QGeoTileSpec>()),
+                              Q_ARG(QSet<QGeoTileSpec>, cancelTiles));
+}
+
+void QGeoTiledMappingManagerEngine::removeRegionDownload(QGeoTileRegionDownload *download)
+{
+    Q_D(QGeoTiledMappingManagerEngine);
+    d->downloads_.removeOne(download);
 }
 
 /*******************************************************************************
@@ -318,7 +763,11 @@ QGeoTiledMappingManagerEnginePrivate::QGeoTiledMappingManagerEnginePrivate()
 :   m_tileVersion(-1),
     cacheHint_(QAbstractGeoTileCache::AllCaches),
     tileCache_(0),
-    fetcher_(0)
+    fetcher_(0),
+    retryScheduler_(0),
+    tileMaxAge_(-1),
+    composeLevels_(0),
+    composePermanent_(false)
 {
 }
 
@@ -65,6 +65,8 @@ class QGeoTileFetcher;
 class QGeoTileTexture;
 class QGeoTileSpec;
 class QGeoTiledMap;
+class QGeoTileRegionDownload;
+class QGeoShape;
 
 class Q_LOCATION_PRIVATE_EXPORT QGeoTiledMappingManagerEngine : public QGeoMappingManagerEngine
 {
@@ -88,13 +90,23 @@ public:
 
     QAbstractGeoTileCache *tileCache();
     virtual QSharedPointer<QGeoTileTexture> getTileTexture(const QGeoTileSpec &spec);
+    void composeTile(const QGeoTileSpec &spec, QGeoTiledMap *map = 0);
 
     QAbstractGeoTileCache::CacheAreas cacheHint() const;
 
+    QGeoTileRegionDownload *downloadRegion(const QGeoShape &area,
+                                           int minimumZoomLevel, int maximumZoomLevel,
+                                           int mapId = 1);
+
 protected Q_SLOTS:
     virtual void engineTileFinished(const QGeoTileSpec &spec, const QByteArray &bytes, const QString &format);
     virtual void engineTileError(const QGeoTileSpec &spec, const QString &errorString);
 
+private Q_SLOTS:
+    void engineTileMetadataReceived(const QGeoTileSpec &spec, const QGeoTileMetadata &metadata);
+    void engineTileNotModified(const QGeoTileSpec &spec, const QGeoTileMetadata &metadata);
+    void engineSharedTileFetched(const QGeoTileSpec &spec, bool fetched);
+
 Q_SIGNALS:
     void tileError(const QGeoTileSpec &spec, const QString &errorString);
     void tileVersionChanged();
@@ -105,6 +117,8 @@ protected:
     void setTileVersion(int version);
     void setCacheHint(QAbstractGeoTileCache::CacheAreas cacheHint);
     void setTileCache(QAbstractGeoTileCache *cache);
+    void setTileMaxAge(int seconds);
+    void setTileComposition(int levels, bool permanent = false);
 
     QGeoTiledMap::PrefetchStyle m_prefetchStyle;
     QGeoTiledMappingManagerEnginePrivate *d_ptr;
@@ -112,7 +126,17 @@ protected:
     Q_DECLARE_PRIVATE(QGeoTiledMappingManagerEngine)
     Q_DISABLE_COPY(QGeoTiledMappingManagerEngine)
 
+private:
+    QString tileHost(const QGeoTileSpec &spec) const;
+    void tileComposed(const QGeoTileSpec &spec, const QImage &image);
+    void tileCached(const QGeoTileSpec &spec);
+    void storeTileMetadata(const QGeoTileSpec &spec, QGeoTileMetadata metadata);
+    void requestRegionTiles(QGeoTileRegionDownload *download, const QSet<QGeoTileSpec> &tiles);
+    void cancelRegionTiles(QGeoTileRegionDownload *download, const QSet<QGeoTileSpec> &tiles);
+    void removeRegionDownload(QGeoTileRegionDownload *download);
+
     friend class QGeoTileFetcher;
+    friend class QGeoTileRegionDownload;
 };
 
 QT_END_NAMESPACE
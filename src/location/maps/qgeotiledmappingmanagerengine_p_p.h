@@ -52,6 +52,7 @@
 #include <QSize>
 #include <QHash>
 #include <QSet>
+#include <QList>
 #include "qgeotiledmappingmanagerengine_p.h"
 
 QT_BEGIN_NAMESPACE
@@ -60,6 +61,8 @@ class QGeoTiledMap;
 class QAbstractGeoTileCache;
 class QGeoTileSpec;
 class QGeoTileFetcher;
+class QGeoTileRegionDownload;
+class QGeoTileRetryScheduler;
 
 class QGeoTiledMappingManagerEnginePrivate
 {
@@ -71,9 +74,19 @@ public:
     int m_tileVersion;
     QHash<QGeoTiledMap *, QSet<QGeoTileSpec> > mapHash_;
     QHash<QGeoTileSpec, QSet<QGeoTiledMap *> > tileHash_;
+    QHash<QGeoTileSpec, QSet<QGeoTileRegionDownload *> > downloadHash_;
+    QList<QGeoTileRegionDownload *> downloads_;
+    QSet<QGeoTileSpec> revalidating_;
+    QSet<QGeoTileSpec> sharedWaits_;
     QAbstractGeoTileCache::CacheAreas cacheHint_;
     QAbstractGeoTileCache *tileCache_;
     QGeoTileFetcher *fetcher_;
+    QGeoTileRetryScheduler *retryScheduler_;
+    QHash<QGeoTileSpec, QSet<QGeoTiledMap *> > composing_;
+    QSet<QGeoTileSpec> uncomposable_;
+    int tileMaxAge_;
+    int composeLevels_;
+    bool composePermanent_;
 
 private:
     Q_DISABLE_COPY(QGeoTiledMappingManagerEnginePrivate)
@@ -233,6 +233,40 @@ void QGeoTiledMapReply::setMapImageFormat(const QString &format)
     d_ptr->mapImageFormat = format;
 }
 
+/*!
+    Returns the freshness information the server sent with the tile.
+*/
+QGeoTileMetadata QGeoTiledMapReply::metadata() const
+{
+    return d_ptr->metadata;
+}
+
+/*!
+    Sets the freshness information of the tile to \a metadata.
+*/
+void QGeoTiledMapReply::setMetadata(const QGeoTileMetadata &metadata)
+{
+    d_ptr->metadata = metadata;
+}
+
+/*!
+    Returns whether the server answered a conditional request by confirming
+    that the cached tile is still current, in which case the reply carries
+    no image data.
+*/
+bool QGeoTiledMapReply::isNotModified() const
+{
+    return d_ptr->isNotModified;
+}
+
+/*!
+    Sets whether the cached tile has been confirmed current to \a notModified.
+*/
+void QGeoTiledMapReply::setNotModified(bool notModified)
+{
+    d_ptr->isNotModified = notModified;
+}
+
 /*!
     Cancels the operation immediately.
 
@@ -304,13 +338,15 @@ QGeoTiledMapReplyPrivate::QGeoTiledMapReplyPrivate(const QGeoTileSpec &spec)
     : error(QGeoTiledMapReply::NoError),
       isFinished(false),
       isCached(false),
-      spec(spec) {}
+      spec(spec),
+      isNotModified(false) {}
 
 QGeoTiledMapReplyPrivate::QGeoTiledMapReplyPrivate(QGeoTiledMapReply::Error error, const QString &errorString)
     : error(error),
       errorString(errorString),
       isFinished(true),
-      isCached(false) {}
+      isCached(false),
+      isNotModified(false) {}
 
 QGeoTiledMapReplyPrivate::~QGeoTiledMapReplyPrivate() {}
 
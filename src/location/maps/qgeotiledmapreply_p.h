@@ -55,6 +55,7 @@
 QT_BEGIN_NAMESPACE
 
 class QGeoTileSpec;
+class QGeoTileMetadata;
 class QGeoTiledMapReplyPrivate;
 
 class Q_LOCATION_PRIVATE_EXPORT QGeoTiledMapReply : public QObject
@@ -84,6 +85,9 @@ public:
     QByteArray mapImageData() const;
     QString mapImageFormat() const;
 
+    QGeoTileMetadata metadata() const;
+    bool isNotModified() const;
+
     virtual void abort();
 
 Q_SIGNALS:
@@ -99,6 +103,8 @@ protected:
 
     void setMapImageData(const QByteArray &data);
     void setMapImageFormat(const QString &format);
+    void setMetadata(const QGeoTileMetadata &metadata);
+    void setNotModified(bool notModified);
 
 private:
     QGeoTiledMapReplyPrivate *d_ptr;
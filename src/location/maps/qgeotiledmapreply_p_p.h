@@ -50,6 +50,7 @@
 
 #include "qgeotiledmapreply_p.h"
 #include "qgeotilespec_p.h"
+#include "qabstractgeotilecache_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -68,6 +69,8 @@ public:
     QGeoTileSpec spec;
     QByteArray mapImageData;
     QString mapImageFormat;
+    QGeoTileMetadata metadata;
+    bool isNotModified;
 };
 
 QT_END_NAMESPACE
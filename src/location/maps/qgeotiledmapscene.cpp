@@ -39,6 +39,8 @@
 #include "qgeocameradata_p.h"
 #include "qabstractgeotilecache_p.h"
 #include "qgeotilespec_p.h"
+#include "qgeotileresampler_p.h"
+#include "qgeoparsetask_p.h"
 #include <QtPositioning/private/qdoublevector3d_p.h>
 #include <QtPositioning/private/qwebmercator_p.h>
 #include <QtCore/private/qobject_p.h>
@@ -56,6 +58,9 @@ static QVector3D toVector3D(const QDoubleVector3D& in)
 
 QT_BEGIN_NAMESPACE
 
+// Bytes of minified tiles kept for when they are shown again
+static const int maxMinifiedCost = 16 * 1024 * 1024;
+
 QGeoTiledMapScene::QGeoTiledMapScene(QObject *parent)
     : QObject(*new QGeoTiledMapScenePrivate(),parent)
 {
@@ -138,7 +143,11 @@ QSet<QGeoTileSpec> QGeoTiledMapScene::texturedTiles()
 void QGeoTiledMapScene::clearTexturedTiles()
 {
     Q_D(QGeoTiledMapScene);
+    for (const QGeoTileSpec &spec : d->m_resampling.keys())
+        d->cancelResampling(spec);
     d->m_textures.clear();
+    d->m_resampled.clear();
+    d->m_minified.clear();
     d->m_dropTextures = true;
 }
 
@@ -152,6 +161,7 @@ QGeoTiledMapScenePrivate::QGeoTiledMapScenePrivate()
 #endif
       m_intZoomLevel(0),
       m_sideLength(0),
+      m_pixelRatio(1.0),
       m_minTileX(-1),
       m_minTileY(-1),
       m_maxTileX(-1),
@@ -160,6 +170,7 @@ QGeoTiledMapScenePrivate::QGeoTiledMapScenePrivate()
       m_linearScaling(false),
       m_dropTextures(false)
 {
+    m_minified.setMaxCost(maxMinifiedCost);
 }
 
 QGeoTiledMapScenePrivate::~QGeoTiledMapScenePrivate()
@@ -201,7 +212,7 @@ bool QGeoTiledMapScenePrivate::buildGeometry(const QGeoTileSpec &spec, QSGImageN
     // Calculate the texture mapping, in case we are magnifying some lower ZL tile
     const auto it = m_textures.find(spec); // This should be always found, but apparently sometimes it isn't, possibly due to memory shortage
     if (it != m_textures.end()) {
-        if (it.value()->spec.zoom() < spec.zoom()) {
+        if (it.value()->spec.zoom() < spec.zoom() && !m_resampled.contains(spec)) {
             // Currently only using lower ZL tiles for the overzoom.
             const int tilesPerTexture = 1 << (spec.zoom() - it.value()->spec.zoom());
             const int mappedSize = imageNode->texture()->textureSize().width() / tilesPerTexture;
@@ -225,9 +236,109 @@ void QGeoTiledMapScenePrivate::addTile(const QGeoTileSpec &spec, QSharedPointer<
     if (!m_visibleTiles.contains(spec)) // Don't add the geometry if it isn't visible
         return;
 
-    if (m_textures.contains(spec))
-        m_updatedTextures.append(spec);
+    const bool replaced = m_textures.contains(spec);
     m_textures.insert(spec, texture);
+    // A resampled texture replaces the current one once it is ready.
+    if (!resampleTile(spec, texture) && replaced)
+        m_updatedTextures.append(spec);
+}
+
+/*
+    Starts resampling \a texture on the thread pool, if it is not drawn
+    at its size: crops of lower zoom level tiles are magnified, and tiles
+    larger than drawn are minified through a mipmap pyramid. The render
+    thread then uploads an image that needs neither mipmaps nor filtering
+    beyond what fractional zoom levels need. Returns true if \a spec waits
+    for its resampled image.
+*/
+bool QGeoTiledMapScenePrivate::resampleTile(const QGeoTileSpec &spec,
+                                            const QSharedPointer<QGeoTileTexture> &texture)
+{
+    Q_Q(QGeoTiledMapScene);
+
+    const QImage image = texture->image;
+    const int size = qRound(m_tileSize * m_pixelRatio);
+    const bool crop = texture->spec.zoom() < spec.zoom();
+    QRect source = image.rect();
+    if (crop) {
+        const int tilesPerTexture = 1 << (spec.zoom() - texture->spec.zoom());
+        const int mappedSize = image.width() / tilesPerTexture;
+        source = QRect((spec.x() % tilesPerTexture) * mappedSize,
+                       (spec.y() % tilesPerTexture) * mappedSize,
+                       mappedSize, mappedSize);
+    }
+
+    if (image.isNull() || size <= 0 || source.isEmpty() || (!crop && image.width() <= size)) {
+        cancelResampling(spec);
+        if (m_resampled.remove(spec))
+            m_updatedTextures.append(spec);
+        return false;
+    }
+
+    const auto pending = m_resampling.constFind(spec);
+    if (pending != m_resampling.cend() && pending->texture == texture && pending->size == size)
+        return true;
+    cancelResampling(spec);
+
+    if (!crop) {
+        const Minified *minified = m_minified.object(qMakePair(spec, size));
+        if (minified && minified->sourceKey == image.cacheKey()) {
+            m_resampled.insert(spec, minified->image);
+            m_updatedTextures.append(spec);
+            return false;
+        }
+    }
+
+    QSharedPointer<QImage> result(new QImage);
+    const QSize scaledSize(size, size);
+    const QGeoParseTask::Handle task = QGeoParseTask::start(q,
+        [image, source, scaledSize, result]() {
+            *result = QGeoTileResampler::resample(image, source, scaledSize);
+        },
+        [this, spec, texture, crop, result]() {
+            tileResampled(spec, texture, *result, crop);
+        });
+    m_resampling.insert(spec, Resampling{ task, texture, size });
+    return true;
+}
+
+void QGeoTiledMapScenePrivate::tileResampled(const QGeoTileSpec &spec,
+                                             const QSharedPointer<QGeoTileTexture> &texture,
+                                             const QImage &image, bool crop)
+{
+    Q_Q(QGeoTiledMapScene);
+
+    m_resampling.remove(spec);
+    if (!crop && !image.isNull()) {
+        m_minified.insert(qMakePair(spec, image.width()),
+                          new Minified{ texture->image.cacheKey(), image },
+                          int(image.sizeInBytes()));
+    }
+
+    if (image.isNull())
+        m_resampled.remove(spec);
+    else
+        m_resampled.insert(spec, image);
+    m_updatedTextures.append(spec);
+    emit q->tilesResampled();
+}
+
+void QGeoTiledMapScenePrivate::cancelResampling(const QGeoTileSpec &spec)
+{
+    const auto it = m_resampling.find(spec);
+    if (it == m_resampling.end())
+        return;
+    it->task.cancel();
+    m_resampling.erase(it);
+}
+
+/*
+    Resamples the tiles again for the current device pixel ratio.
+*/
+void QGeoTiledMapScenePrivate::resampleTiles()
+{
+    for (auto it = m_textures.cbegin(); it != m_textures.cend(); ++it)
+        resampleTile(it.key(), it.value());
 }
 
 void QGeoTiledMapScenePrivate::setVisibleTiles(const QSet<QGeoTileSpec> &visibleTiles)
@@ -254,6 +365,8 @@ void QGeoTiledMapScenePrivate::removeTiles(const QSet<QGeoTileSpec> &oldTiles)
     for (; i != end; ++i) {
         QGeoTileSpec tile = *i;
         m_textures.remove(tile);
+        m_resampled.remove(tile);
+        cancelResampling(tile);
     }
 }
 
@@ -545,7 +658,7 @@ void QGeoTiledMapRootNode::updateTiles(QGeoTiledMapTileContainerNode *root,
 
     for (const QGeoTileSpec &s : toAdd) {
         QGeoTileTexture *tileTexture = d->m_textures.value(s).data();
-        if (!tileTexture || tileTexture->image.isNull()) {
+        if (!tileTexture || tileTexture->image.isNull() || !textures.contains(s)) {
 #ifdef QT_LOCATION_DEBUG
             droppedTiles.append(s);
 #endif
@@ -591,6 +704,16 @@ QSGNode *QGeoTiledMapScene::updateSceneGraph(QSGNode *oldNode, QQuickWindow *win
     }
 
     bool isOpenGL = (window->rendererInterface()->graphicsApi() == QSGRendererInterface::OpenGL);
+
+    // The GUI thread is blocked here, the tiles are resampled once it runs again.
+    const qreal pixelRatio = window->effectiveDevicePixelRatio();
+    if (pixelRatio != d->m_pixelRatio) {
+        d->m_pixelRatio = pixelRatio;
+        QMetaObject::invokeMethod(this, [this]() {
+            Q_D(QGeoTiledMapScene);
+            d->resampleTiles();
+        }, Qt::QueuedConnection);
+    }
     QGeoTiledMapRootNode *mapRoot = static_cast<QGeoTiledMapRootNode *>(oldNode);
     if (!mapRoot)
         mapRoot = new QGeoTiledMapRootNode();
@@ -648,9 +771,11 @@ QSGNode *QGeoTiledMapScene::updateSceneGraph(QSGNode *oldNode, QQuickWindow *win
         mapRoot->textures.take(spec)->deleteLater();
     for (const QGeoTileSpec &spec : toAdd) {
         QGeoTileTexture *tileTexture = d->m_textures.value(spec).data();
-        if (!tileTexture || tileTexture->image.isNull())
+        if (!tileTexture || tileTexture->image.isNull() || d->m_resampling.contains(spec))
             continue;
-        mapRoot->textures.insert(spec, window->createTextureFromImage(tileTexture->image));
+        const auto resampled = d->m_resampled.constFind(spec);
+        const QImage &image = resampled != d->m_resampled.cend() ? *resampled : tileTexture->image;
+        mapRoot->textures.insert(spec, window->createTextureFromImage(image));
     }
 
     double sideLength = d->m_scaleFactor * d->m_tileSize * d->m_sideLength;
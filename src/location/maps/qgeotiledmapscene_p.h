@@ -87,6 +87,7 @@ public:
 
 Q_SIGNALS:
     void newTilesVisible(const QSet<QGeoTileSpec> &newTiles);
+    void tilesResampled();
 
 private:
     void updateSceneParameters();
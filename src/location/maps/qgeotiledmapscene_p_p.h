@@ -49,11 +49,14 @@
 
 #include "qgeotiledmapscene_p.h"
 #include <QtCore/private/qobject_p.h>
+#include <QtCore/QCache>
+#include <QtCore/QPair>
 #include <QtPositioning/private/qdoublevector3d_p.h>
 #include <QtQuick/QSGImageNode>
 #include <QtQuick/private/qsgdefaultimagenode_p.h>
 #include <QtQuick/QQuickWindow>
 #include "qgeocameradata_p.h"
+#include "qgeoparsetask_p.h"
 #include "qgeotilespec_p.h"
 
 QT_BEGIN_NAMESPACE
@@ -136,6 +139,11 @@ public:
     ~QGeoTiledMapScenePrivate();
 
     void addTile(const QGeoTileSpec &spec, QSharedPointer<QGeoTileTexture> texture);
+    bool resampleTile(const QGeoTileSpec &spec, const QSharedPointer<QGeoTileTexture> &texture);
+    void tileResampled(const QGeoTileSpec &spec, const QSharedPointer<QGeoTileTexture> &texture,
+                       const QImage &image, bool crop);
+    void cancelResampling(const QGeoTileSpec &spec);
+    void resampleTiles();
 
     void setVisibleTiles(const QSet<QGeoTileSpec> &visibleTiles);
     void removeTiles(const QSet<QGeoTileSpec> &oldTiles);
@@ -173,6 +181,26 @@ public:
     QHash<QGeoTileSpec, QSharedPointer<QGeoTileTexture> > m_textures;
     QVector<QGeoTileSpec> m_updatedTextures;
 
+    // Images uploaded in place of the textures, at the size they are drawn at.
+    struct Resampling
+    {
+        QGeoParseTask::Handle task;
+        QSharedPointer<QGeoTileTexture> texture;
+        int size;
+    };
+    qreal m_pixelRatio;
+    QHash<QGeoTileSpec, QImage> m_resampled;
+    QHash<QGeoTileSpec, Resampling> m_resampling;
+
+    // Minified tiles by the size they were drawn at, for the next time they
+    // are shown, along with the cache key of the image they were made from.
+    struct Minified
+    {
+        qint64 sourceKey;
+        QImage image;
+    };
+    QCache<QPair<QGeoTileSpec, int>, Minified> m_minified;
+
     // tilesToGrid transform
     int m_minTileX; // the minimum tile index, i.e. 0 to sideLength which is 1<< zoomLevel
     int m_minTileY;
@@ -43,6 +43,8 @@
 #include "qgeotilespec_p.h"
 #include "qgeotiledmap_p.h"
 
+#include <QtNetwork/QNetworkRequest>
+
 QT_BEGIN_NAMESPACE
 
 QGeoTileFetcher::QGeoTileFetcher(QGeoMappingManagerEngine *parent)
@@ -66,6 +68,44 @@ QGeoTileFetcher::~QGeoTileFetcher()
 {
 }
 
+/*
+    Limits the requests in flight to any one host, as reported by
+    tileHost(), to \a count. Tiles for saturated hosts wait in the queue,
+    where they can still be cancelled, while tiles for other hosts are
+    requested. Zero, the default, leaves the limit to the network access
+    manager, which opens at most six HTTP/1 connections per host.
+*/
+void QGeoTileFetcher::setMaximumRequestsPerHost(int count)
+{
+    Q_D(QGeoTileFetcher);
+    QMutexLocker ml(&d->queueMutex_);
+    d->maxRequestsPerHost_ = qMax(0, count);
+}
+
+int QGeoTileFetcher::maximumRequestsPerHost() const
+{
+    Q_D(const QGeoTileFetcher);
+    return d->maxRequestsPerHost_;
+}
+
+/*
+    Sets whether tile requests may use HTTP/2, which multiplexes all the
+    requests to a host over a single connection. It is negotiated over TLS,
+    so plain HTTP servers keep being spoken to with HTTP/1.1. Disabled by
+    default, plugins enable it through a parameter.
+*/
+void QGeoTileFetcher::setHttp2Enabled(bool enabled)
+{
+    Q_D(QGeoTileFetcher);
+    d->http2Enabled_ = enabled;
+}
+
+bool QGeoTileFetcher::isHttp2Enabled() const
+{
+    Q_D(const QGeoTileFetcher);
+    return d->http2Enabled_;
+}
+
 void QGeoTileFetcher::updateTileRequests(const QSet<QGeoTileSpec> &tilesAdded,
                                                   const QSet<QGeoTileSpec> &tilesRemoved)
 {
@@ -75,12 +115,43 @@ void QGeoTileFetcher::updateTileRequests(const QSet<QGeoTileSpec> &tilesAdded,
 
     cancelTileRequests(tilesRemoved);
 
+    // Tiles a map is waiting for are requested unconditionally.
+    for (const QGeoTileSpec &spec : tilesAdded)
+        d->validators_.remove(spec);
     d->queue_ += tilesAdded.toList();
 
+    // The host of a tile does not change while it waits in the queue.
+    if (d->maxRequestsPerHost_ > 0 && initialized()) {
+        for (const QGeoTileSpec &spec : tilesAdded)
+            d->queuedHosts_.insert(spec, tileHost(spec));
+    }
+
     if (d->enabled_ && initialized() && !d->queue_.isEmpty() && !d->timer_.isActive())
         d->timer_.start(0, this);
 }
 
+/*
+    Requests \a spec again with the validators in \a metadata, so that the
+    server only sends the tile if it has changed since it was cached.
+*/
+void QGeoTileFetcher::revalidateTile(const QGeoTileSpec &spec, const QGeoTileMetadata &metadata)
+{
+    Q_D(QGeoTileFetcher);
+
+    QMutexLocker ml(&d->queueMutex_);
+
+    if (d->queue_.contains(spec) || d->invmap_.contains(spec))
+        return;
+
+    d->validators_.insert(spec, metadata);
+    d->queue_.append(spec);
+    if (d->maxRequestsPerHost_ > 0 && initialized())
+        d->queuedHosts_.insert(spec, tileHost(spec));
+
+    if (d->enabled_ && initialized() && !d->timer_.isActive())
+        d->timer_.start(0, this);
+}
+
 void QGeoTileFetcher::cancelTileRequests(const QSet<QGeoTileSpec> &tiles)
 {
     Q_D(QGeoTileFetcher);
@@ -93,11 +164,14 @@ void QGeoTileFetcher::cancelTileRequests(const QSet<QGeoTileSpec> &tiles)
         QGeoTiledMapReply *reply = d->invmap_.value(*tile, 0);
         if (reply) {
             d->invmap_.remove(*tile);
+            d->releaseHost(*tile);
             reply->abort();
             if (reply->isFinished())
                 reply->deleteLater();
         }
         d->queue_.removeAll(*tile);
+        d->queuedHosts_.remove(*tile);
+        d->validators_.remove(*tile);
     }
 }
 
@@ -113,7 +187,29 @@ void QGeoTileFetcher::requestNextTile()
     if (d->queue_.isEmpty())
         return;
 
-    QGeoTileSpec ts = d->queue_.takeFirst();
+    // Skip the tiles of hosts that have as many requests in flight as allowed.
+    QString host;
+    int next = 0;
+    if (d->maxRequestsPerHost_ > 0) {
+        for (; next < d->queue_.size(); ++next) {
+            const QGeoTileSpec &spec = d->queue_.at(next);
+            QHash<QGeoTileSpec, QString>::const_iterator queuedHost = d->queuedHosts_.constFind(spec);
+            // Queued before the fetcher was initialized, or before the limit was set.
+            if (queuedHost == d->queuedHosts_.constEnd())
+                queuedHost = d->queuedHosts_.insert(spec, tileHost(spec));
+            host = queuedHost.value();
+            if (host.isEmpty() || d->hostLoad_.value(host) < d->maxRequestsPerHost_)
+                break;
+        }
+        if (next == d->queue_.size()) {
+            // Resumed when a request finishes.
+            d->timer_.stop();
+            return;
+        }
+    }
+
+    QGeoTileSpec ts = d->queue_.takeAt(next);
+    d->queuedHosts_.remove(ts);
     if (d->queue_.isEmpty())
         d->timer_.stop();
 
@@ -125,6 +221,7 @@ void QGeoTileFetcher::requestNextTile()
         return;
 
     QGeoTiledMapReply *reply = getTileImage(ts);
+    d->validators_.remove(ts);
     if (!reply)
         return;
 
@@ -138,6 +235,10 @@ void QGeoTileFetcher::requestNextTile()
                 Qt::QueuedConnection);
 
         d->invmap_.insert(ts, reply);
+        if (!host.isEmpty()) {
+            ++d->hostLoad_[host];
+            d->replyHosts_.insert(ts, host);
+        }
     }
 }
 
@@ -159,6 +260,10 @@ void QGeoTileFetcher::finished()
     }
 
     d->invmap_.remove(spec);
+    d->releaseHost(spec);
+
+    if (d->enabled_ && initialized() && !d->queue_.isEmpty() && !d->timer_.isActive())
+        d->timer_.start(0, this);
 
     handleReply(reply, spec);
 }
@@ -191,6 +296,40 @@ bool QGeoTileFetcher::fetchingEnabled() const
     return true;
 }
 
+/*
+    Returns the validators to make the request for \a spec conditional
+    with, if it is being revalidated. Meant to be called from getTileImage(),
+    which already holds the queue lock.
+*/
+QGeoTileMetadata QGeoTileFetcher::tileValidators(const QGeoTileSpec &spec) const
+{
+    Q_D(const QGeoTileFetcher);
+    return d->validators_.value(spec);
+}
+
+/*
+    Sets up \a request for \a spec the same way for all the fetchers: it
+    may use HTTP/2, and is conditional if the tile is being revalidated.
+    Meant to be called from getTileImage().
+*/
+void QGeoTileFetcher::prepareTileRequest(const QGeoTileSpec &spec, QNetworkRequest *request) const
+{
+    Q_D(const QGeoTileFetcher);
+    request->setAttribute(QNetworkRequest::HTTP2AllowedAttribute, d->http2Enabled_);
+    d->validators_.value(spec).addValidators(request);
+}
+
+/*
+    Returns the host \a spec is requested from, which the limit on requests
+    per host applies to. The default implementation returns an empty string,
+    which exempts the tile from the limit.
+*/
+QString QGeoTileFetcher::tileHost(const QGeoTileSpec &spec) const
+{
+    Q_UNUSED(spec);
+    return QString();
+}
+
 void QGeoTileFetcher::handleReply(QGeoTiledMapReply *reply, const QGeoTileSpec &spec)
 {
     Q_D(QGeoTileFetcher);
@@ -201,7 +340,13 @@ void QGeoTileFetcher::handleReply(QGeoTiledMapReply *reply, const QGeoTileSpec &
     }
 
     if (reply->error() == QGeoTiledMapReply::NoError) {
-        emit tileFinished(spec, reply->mapImageData(), reply->mapImageFormat());
+        if (reply->isNotModified()) {
+            emit tileNotModified(spec, reply->metadata());
+        } else {
+            emit tileFinished(spec, reply->mapImageData(), reply->mapImageFormat());
+            // After the tile, whose insertion drops the metadata of the tile it replaces.
+            emit tileMetadataReceived(spec, reply->metadata());
+        }
     } else {
         emit tileError(spec, reply->errorString());
     }
@@ -213,7 +358,7 @@ void QGeoTileFetcher::handleReply(QGeoTiledMapReply *reply, const QGeoTileSpec &
 *******************************************************************************/
 
 QGeoTileFetcherPrivate::QGeoTileFetcherPrivate()
-:   QObjectPrivate(), enabled_(false), engine_(0)
+:   QObjectPrivate(), enabled_(false), maxRequestsPerHost_(0), http2Enabled_(false), engine_(0)
 {
 }
 
@@ -221,4 +366,14 @@ QGeoTileFetcherPrivate::~QGeoTileFetcherPrivate()
 {
 }
 
+void QGeoTileFetcherPrivate::releaseHost(const QGeoTileSpec &spec)
+{
+    const QString host = replyHosts_.take(spec);
+    if (host.isEmpty())
+        return;
+    QHash<QString, int>::iterator load = hostLoad_.find(host);
+    if (load != hostLoad_.end() && --load.value() <= 0)
+        hostLoad_.erase(load);
+}
+
 QT_END_NAMESPACE
@@ -61,6 +61,8 @@ class QGeoTileFetcherPrivate;
 class QGeoTiledMappingManagerEngine;
 class QGeoTiledMapReply;
 class QGeoTileSpec;
+class QGeoTileMetadata;
+class QNetworkRequest;
 
 class Q_LOCATION_PRIVATE_EXPORT QGeoTileFetcher : public QObject
 {
@@ -71,8 +73,14 @@ public:
     QGeoTileFetcher(QGeoMappingManagerEngine *parent);
     virtual ~QGeoTileFetcher();
 
+    void setMaximumRequestsPerHost(int count);
+    int maximumRequestsPerHost() const;
+    void setHttp2Enabled(bool enabled);
+    bool isHttp2Enabled() const;
+
 public Q_SLOTS:
     void updateTileRequests(const QSet<QGeoTileSpec> &tilesAdded, const QSet<QGeoTileSpec> &tilesRemoved);
+    void revalidateTile(const QGeoTileSpec &spec, const QGeoTileMetadata &metadata);
 
 private Q_SLOTS:
     void cancelTileRequests(const QSet<QGeoTileSpec> &tiles);
@@ -82,6 +90,8 @@ private Q_SLOTS:
 Q_SIGNALS:
     void tileFinished(const QGeoTileSpec &spec, const QByteArray &bytes, const QString &format);
     void tileError(const QGeoTileSpec &spec, const QString &errorString);
+    void tileMetadataReceived(const QGeoTileSpec &spec, const QGeoTileMetadata &metadata);
+    void tileNotModified(const QGeoTileSpec &spec, const QGeoTileMetadata &metadata);
 
 protected:
     QGeoTileFetcher(QGeoTileFetcherPrivate &dd, QGeoMappingManagerEngine *parent);
@@ -90,11 +100,14 @@ protected:
     QAbstractGeoTileCache::CacheAreas cacheHint() const;
     virtual bool initialized() const;
     virtual bool fetchingEnabled() const;
+    QGeoTileMetadata tileValidators(const QGeoTileSpec &spec) const;
+    void prepareTileRequest(const QGeoTileSpec &spec, QNetworkRequest *request) const;
+    virtual QString tileHost(const QGeoTileSpec &spec) const;
+    virtual void handleReply(QGeoTiledMapReply *reply, const QGeoTileSpec &spec);
 
 private:
 
     virtual QGeoTiledMapReply *getTileImage(const QGeoTileSpec &spec) = 0;
-    virtual void handleReply(QGeoTiledMapReply *reply, const QGeoTileSpec &spec);
 
     Q_DISABLE_COPY(QGeoTileFetcher)
     friend class QGeoTiledMappingManagerEngine;
@@ -60,6 +60,7 @@
 #include <QMutexLocker>
 #include <QHash>
 #include "qgeomaptype_p.h"
+#include "qabstractgeotilecache_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -74,11 +75,19 @@ public:
     QGeoTileFetcherPrivate();
     virtual ~QGeoTileFetcherPrivate();
 
+    void releaseHost(const QGeoTileSpec &spec);
+
     bool enabled_;
     QBasicTimer timer_;
     QMutex queueMutex_;
     QList<QGeoTileSpec> queue_;
     QHash<QGeoTileSpec, QGeoTiledMapReply *> invmap_;
+    QHash<QGeoTileSpec, QGeoTileMetadata> validators_;
+    QHash<QGeoTileSpec, QString> queuedHosts_;
+    QHash<QGeoTileSpec, QString> replyHosts_;
+    QHash<QString, int> hostLoad_;
+    int maxRequestsPerHost_;
+    bool http2Enabled_;
     QGeoMappingManagerEngine *engine_;
 
 private:
@@ -0,0 +1,560 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeotileregiondownload_p.h"
+#include "qgeotiledmappingmanagerengine_p.h"
+#include "qgeocameracapabilities_p.h"
+
+#include <QtCore/QRectF>
+#include <QtCore/qmath.h>
+#include <QtGui/QPainterPath>
+#include <QtGui/QPainterPathStroker>
+#include <QtPositioning/QGeoPath>
+#include <QtPositioning/QGeoPolygon>
+#include <QtPositioning/QGeoRectangle>
+#include <QtPositioning/private/qwebmercator_p.h>
+#include <QtPositioning/private/qdoublevector2d_p.h>
+
+#include <algorithm>
+#include <cmath>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+// Mean circumference of the earth at the equator, in meters.
+const double earthCircumference = 40075016.686;
+
+/*
+    Converts \a coordinates to tile units at a level \a side tiles wide.
+    Longitudes are unwrapped so that consecutive points are never more than
+    half the world apart, which keeps shapes crossing the date line in one
+    piece; the resulting x values can therefore lie outside [0, side).
+*/
+QPolygonF toTileUnits(const QList<QGeoCoordinate> &coordinates, int side)
+{
+    QPolygonF polygon;
+    polygon.reserve(coordinates.size());
+    double previous = 0.0;
+    for (const QGeoCoordinate &coordinate : coordinates) {
+        const QDoubleVector2D mercator = QWebMercator::coordToMercator(coordinate);
+        double x = mercator.x();
+        if (!polygon.isEmpty()) {
+            while (x - previous > 0.5)
+                x -= 1.0;
+            while (x - previous < -0.5)
+                x += 1.0;
+        }
+        previous = x;
+        polygon.append(QPointF(x * side, mercator.y() * side));
+    }
+    return polygon;
+}
+
+/*
+    Returns the outline of the area covered by \a area in tile units, or an
+    empty path if the tiles are to be selected from the bounding box only.
+*/
+QPainterPath outline(const QGeoShape &area, int side)
+{
+    QPainterPath path;
+    if (area.type() == QGeoShape::PolygonType) {
+        const QGeoPolygon polygon(area);
+        path.addPolygon(toTileUnits(polygon.path(), side));
+        path.closeSubpath();
+    } else if (area.type() == QGeoShape::PathType) {
+        const QGeoPath geoPath(area);
+        const QList<QGeoCoordinate> &coordinates = geoPath.path();
+        if (coordinates.isEmpty())
+            return path;
+
+        // The corridor is widened by the scale factor of the most poleward
+        // point, so that it is never narrower than the route's width.
+        double maxLatitude = 0.0;
+        for (const QGeoCoordinate &coordinate : coordinates)
+            maxLatitude = qMax(maxLatitude, qAbs(coordinate.latitude()));
+        maxLatitude = qMin(maxLatitude, 85.05113);
+        const double scale = earthCircumference * std::cos(qDegreesToRadians(maxLatitude));
+        const double width = qMax(geoPath.width() / scale * side, 0.001);
+
+        QPainterPath line;
+        line.addPolygon(toTileUnits(coordinates, side));
+        QPainterPathStroker stroker;
+        stroker.setWidth(width);
+        stroker.setCapStyle(Qt::RoundCap);
+        stroker.setJoinStyle(Qt::RoundJoin);
+        path = stroker.createStroke(line);
+    }
+    return path;
+}
+
+/*
+    The tiles of a level within the bounds of an area, and the outline they
+    are tested against, if any.
+*/
+struct Coverage
+{
+    QPainterPath path;
+    int zoom = 0;
+    int side = 0;
+    int minX = 0;
+    int maxX = -1;
+    int minY = 0;
+    int maxY = -1;
+
+    bool init(const QGeoShape &area, int level)
+    {
+        if (!area.isValid() || level < 0 || level > 30)
+            return false;
+
+        zoom = level;
+        side = 1 << zoom;
+        path = outline(area, side);
+
+        QRectF bounds;
+        if (!path.isEmpty()) {
+            bounds = path.boundingRect();
+        } else {
+            const QGeoRectangle box = area.boundingGeoRectangle();
+            const QDoubleVector2D topLeft = QWebMercator::coordToMercator(box.topLeft());
+            const QDoubleVector2D bottomRight = QWebMercator::coordToMercator(box.bottomRight());
+            double right = bottomRight.x();
+            if (right < topLeft.x())
+                right += 1.0;
+            bounds = QRectF(QPointF(topLeft.x() * side, topLeft.y() * side),
+                            QPointF(right * side, bottomRight.y() * side));
+        }
+
+        minX = int(std::floor(bounds.left()));
+        maxX = qMin(qMax(minX, int(std::ceil(bounds.right())) - 1), minX + side - 1);
+        minY = qBound(0, int(std::floor(bounds.top())), side - 1);
+        maxY = qBound(minY, int(std::ceil(bounds.bottom())) - 1, side - 1);
+        return true;
+    }
+
+    // Appends the runs of tiles of row \a y to \a spans.
+    void rowSpans(int y, QVector<QGeoTileRegionDownload::Span> *spans) const
+    {
+        QGeoTileRegionDownload::Span span = { zoom, y, 0, 0 };
+        if (path.isEmpty()) {
+            // Wrap around the date line.
+            const int first = ((minX % side) + side) % side;
+            const int count = maxX - minX + 1;
+            span.x = first;
+            span.count = qMin(count, side - first);
+            spans->append(span);
+            if (span.count < count) {
+                span.x = 0;
+                span.count = count - span.count;
+                spans->append(span);
+            }
+            return;
+        }
+
+        if (!path.intersects(QRectF(minX, y, maxX - minX + 1, 1)))
+            return;
+
+        for (int x = minX; x <= maxX; ++x) {
+            if (!path.intersects(QRectF(x, y, 1, 1))) {
+                if (span.count > 0)
+                    spans->append(span);
+                span.count = 0;
+                continue;
+            }
+            // Wrap around the date line.
+            const int wrapped = ((x % side) + side) % side;
+            if (span.count > 0 && wrapped != span.x + span.count) {
+                spans->append(span);
+                span.count = 0;
+            }
+            if (span.count == 0)
+                span.x = wrapped;
+            ++span.count;
+        }
+        if (span.count > 0)
+            spans->append(span);
+    }
+};
+
+} // namespace
+
+/*
+    Downloads every tile covering an area over a range of zoom levels, so
+    that the area can be shown without a network connection later on.
+
+    The tiles are requested through the tile fetcher of the mapping engine,
+    a few at a time and optionally at a limited rate, and stored in the tile
+    cache of the engine unless another target is set. Tiles the visible maps
+    are waiting for are shared with them rather than fetched twice.
+
+    Tiles are downloaded zoom level by zoom level, row by row, always in the
+    same order for a given area. position() is the number of tiles before the
+    first one that has not completed yet, so passing it to setPosition() on a
+    new download of the same area resumes the previous one.
+
+    Downloads are created with QGeoTiledMappingManagerEngine::downloadRegion()
+    and are deleted with the engine.
+*/
+QGeoTileRegionDownload::QGeoTileRegionDownload(QGeoTiledMappingManagerEngine *engine,
+                                               const QGeoShape &area,
+                                               int minimumZoomLevel, int maximumZoomLevel,
+                                               int mapId)
+    : QObject(engine), m_engine(engine), m_area(area), m_minimumZoomLevel(minimumZoomLevel),
+      m_maximumZoomLevel(maximumZoomLevel), m_mapId(mapId),
+      m_pluginString(engine->managerName() + QLatin1Char('_') + QString::number(engine->managerVersion())),
+      m_version(engine->tileVersion()), m_target(engine->tileCache())
+{
+    // The fetcher silently drops requests outside of the levels of the map.
+    const QGeoCameraCapabilities capabilities = engine->cameraCapabilities(mapId);
+    if (capabilities.isValid()) {
+        m_minimumZoomLevel = qMax(m_minimumZoomLevel, int(std::ceil(capabilities.minimumZoomLevel())));
+        m_maximumZoomLevel = qMin(m_maximumZoomLevel, int(std::floor(capabilities.maximumZoomLevel())));
+    }
+
+    for (int zoom = m_minimumZoomLevel; zoom <= m_maximumZoomLevel; ++zoom) {
+        m_levelStarts.append(m_total);
+        m_total += tileCount(area, zoom);
+    }
+
+    m_rateTimer.setSingleShot(true);
+    connect(&m_rateTimer, &QTimer::timeout, this, &QGeoTileRegionDownload::requestTiles);
+}
+
+QGeoTileRegionDownload::~QGeoTileRegionDownload()
+{
+    cancelRequests();
+    m_engine->removeRegionDownload(this);
+}
+
+QGeoShape QGeoTileRegionDownload::area() const
+{
+    return m_area;
+}
+
+int QGeoTileRegionDownload::minimumZoomLevel() const
+{
+    return m_minimumZoomLevel;
+}
+
+int QGeoTileRegionDownload::maximumZoomLevel() const
+{
+    return m_maximumZoomLevel;
+}
+
+int QGeoTileRegionDownload::mapId() const
+{
+    return m_mapId;
+}
+
+/*
+    Sets the cache the tiles are stored in, and the areas of it they are
+    inserted into. Any QAbstractGeoTileCache can be used, for instance one
+    writing to an offline tile store.
+*/
+void QGeoTileRegionDownload::setTarget(QAbstractGeoTileCache *cache,
+                                       QAbstractGeoTileCache::CacheAreas areas)
+{
+    m_target = cache;
+    m_targetAreas = areas;
+}
+
+QAbstractGeoTileCache *QGeoTileRegionDownload::target() const
+{
+    return m_target;
+}
+
+void QGeoTileRegionDownload::setMaximumConcurrentRequests(int requests)
+{
+    m_maximumConcurrentRequests = qMax(1, requests);
+    requestTiles();
+}
+
+int QGeoTileRegionDownload::maximumConcurrentRequests() const
+{
+    return m_maximumConcurrentRequests;
+}
+
+/*
+    Limits the requests sent to the tile server to \a requestsPerSecond,
+    0 meaning no limit. Tile servers usually state such a limit in their
+    usage policy for bulk downloads.
+*/
+void QGeoTileRegionDownload::setMaximumRequestRate(qreal requestsPerSecond)
+{
+    m_maximumRequestRate = qMax(qreal(0.0), requestsPerSecond);
+    requestTiles();
+}
+
+qreal QGeoTileRegionDownload::maximumRequestRate() const
+{
+    return m_maximumRequestRate;
+}
+
+/*
+    Skips the first \a position tiles. Only takes effect before the download
+    has been started.
+*/
+void QGeoTileRegionDownload::setPosition(qint64 position)
+{
+    if (m_state != Idle)
+        return;
+    m_next = qBound<qint64>(0, position, m_total);
+    emit progressChanged();
+}
+
+qint64 QGeoTileRegionDownload::position() const
+{
+    qint64 position = m_next;
+    for (qint64 index : m_requested)
+        position = qMin(position, index);
+    return position;
+}
+
+QGeoTileRegionDownload::State QGeoTileRegionDownload::state() const
+{
+    return m_state;
+}
+
+qint64 QGeoTileRegionDownload::tilesTotal() const
+{
+    return m_total;
+}
+
+qint64 QGeoTileRegionDownload::tilesDownloaded() const
+{
+    return m_downloaded;
+}
+
+qint64 QGeoTileRegionDownload::tilesFailed() const
+{
+    return m_failed;
+}
+
+qint64 QGeoTileRegionDownload::bytesDownloaded() const
+{
+    return m_bytes;
+}
+
+/*
+    Returns the tiles of level \a zoom covering \a area, as runs of
+    consecutive tiles sorted by row then column. Tiles are selected by
+    intersection with the outline of polygons and with the corridor of
+    paths, whose width is in meters; other shapes select every tile of their
+    bounding box.
+*/
+QVector<QGeoTileRegionDownload::Span> QGeoTileRegionDownload::tilesCovering(const QGeoShape &area,
+                                                                            int zoom)
+{
+    QVector<Span> spans;
+    Coverage coverage;
+    if (!coverage.init(area, zoom))
+        return spans;
+
+    for (int y = coverage.minY; y <= coverage.maxY; ++y)
+        coverage.rowSpans(y, &spans);
+    return spans;
+}
+
+/*
+    Returns the number of tiles of level \a zoom covering \a area, without
+    collecting them. Rows outside of the outline of the area are skipped
+    whole, and the tiles of the bounding box of other shapes are only
+    counted.
+*/
+qint64 QGeoTileRegionDownload::tileCount(const QGeoShape &area, int zoom)
+{
+    Coverage coverage;
+    if (!coverage.init(area, zoom))
+        return 0;
+
+    const qint64 rows = coverage.maxY - coverage.minY + 1;
+    if (coverage.path.isEmpty())
+        return rows * (coverage.maxX - coverage.minX + 1);
+
+    qint64 count = 0;
+    QVector<Span> spans;
+    for (int y = coverage.minY; y <= coverage.maxY; ++y) {
+        spans.clear();
+        coverage.rowSpans(y, &spans);
+        for (const Span &span : qAsConst(spans))
+            count += span.count;
+    }
+    return count;
+}
+
+void QGeoTileRegionDownload::start()
+{
+    if (m_state == Downloading || m_state == Finished)
+        return;
+
+    setState(Downloading);
+    requestTiles();
+}
+
+/*
+    Stops sending requests. The tiles already requested are still stored
+    when they arrive.
+*/
+void QGeoTileRegionDownload::pause()
+{
+    if (m_state != Downloading)
+        return;
+
+    m_rateTimer.stop();
+    setState(Paused);
+}
+
+void QGeoTileRegionDownload::cancel()
+{
+    if (m_state == Finished)
+        return;
+
+    m_rateTimer.stop();
+    cancelRequests();
+    setState(Finished);
+}
+
+void QGeoTileRegionDownload::requestTiles()
+{
+    if (m_state != Downloading)
+        return;
+
+    QSet<QGeoTileSpec> tiles;
+    while (m_next < m_total && m_requested.size() + tiles.size() < m_maximumConcurrentRequests) {
+        if (m_maximumRequestRate > 0.0) {
+            const qint64 interval = qint64(1000.0 / m_maximumRequestRate);
+            if (m_lastRequest.isValid() && m_lastRequest.elapsed() < interval) {
+                if (!m_rateTimer.isActive())
+                    m_rateTimer.start(int(interval - m_lastRequest.elapsed()));
+                break;
+            }
+            m_lastRequest.start();
+        }
+
+        const QGeoTileSpec spec = tileAt(m_next);
+        m_requested.insert(spec, m_next);
+        tiles.insert(spec);
+        ++m_next;
+    }
+
+    if (!tiles.isEmpty())
+        m_engine->requestRegionTiles(this, tiles);
+    else if (m_next == m_total && m_requested.isEmpty())
+        setState(Finished);
+}
+
+QGeoTileSpec QGeoTileRegionDownload::tileAt(qint64 index)
+{
+    const int level = int(std::upper_bound(m_levelStarts.cbegin(), m_levelStarts.cend(), index)
+                          - m_levelStarts.cbegin()) - 1;
+    const int zoom = m_minimumZoomLevel + level;
+    if (zoom != m_spansZoom) {
+        m_spansZoom = zoom;
+        m_spans = tilesCovering(m_area, zoom);
+        m_spanStarts.clear();
+        m_spanStarts.reserve(m_spans.size());
+        qint64 start = m_levelStarts.at(level);
+        for (const Span &span : qAsConst(m_spans)) {
+            m_spanStarts.append(start);
+            start += span.count;
+        }
+    }
+
+    const int span = int(std::upper_bound(m_spanStarts.cbegin(), m_spanStarts.cend(), index)
+                         - m_spanStarts.cbegin()) - 1;
+    const Span &s = m_spans.at(span);
+    return QGeoTileSpec(m_pluginString, m_mapId, s.zoom, s.x + int(index - m_spanStarts.at(span)),
+                        s.y, m_version);
+}
+
+void QGeoTileRegionDownload::setState(State state)
+{
+    if (m_state == state)
+        return;
+    m_state = state;
+    emit stateChanged();
+}
+
+void QGeoTileRegionDownload::cancelRequests()
+{
+    if (m_requested.isEmpty())
+        return;
+
+    // Resuming from position() requests these tiles again.
+    const qint64 first = position();
+    const QList<QGeoTileSpec> tiles = m_requested.keys();
+    m_requested.clear();
+    m_next = first;
+    m_engine->cancelRegionTiles(this, QSet<QGeoTileSpec>::fromList(tiles));
+}
+
+/*
+    Called by the engine with the tile's data. \a cached is true if the
+    engine has already stored the tile in its own cache for the maps
+    showing it.
+*/
+void QGeoTileRegionDownload::tileFinished(const QGeoTileSpec &spec, const QByteArray &bytes,
+                                         const QString &format, bool cached)
+{
+    if (!m_requested.contains(spec))
+        return;
+
+    if (m_target && !(cached && m_target == m_engine->tileCache()))
+        m_target->insert(spec, bytes, format, m_targetAreas);
+
+    ++m_downloaded;
+    m_bytes += bytes.size();
+    tileDone(spec);
+}
+
+void QGeoTileRegionDownload::tileFailed(const QGeoTileSpec &spec, const QString &errorString)
+{
+    if (!m_requested.contains(spec))
+        return;
+
+    ++m_failed;
+    emit tileError(spec, errorString);
+    tileDone(spec);
+}
+
+void QGeoTileRegionDownload::tileDone(const QGeoTileSpec &spec)
+{
+    m_requested.remove(spec);
+    emit progressChanged();
+    requestTiles();
+}
+
+QT_END_NAMESPACE
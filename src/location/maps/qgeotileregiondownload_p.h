@@ -0,0 +1,173 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOTILEREGIONDOWNLOAD_P_H
+#define QGEOTILEREGIONDOWNLOAD_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtLocation/private/qlocationglobal_p.h>
+#include <QtLocation/private/qabstractgeotilecache_p.h>
+#include <QtLocation/private/qgeotilespec_p.h>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+#include <QtCore/QTimer>
+#include <QtCore/QVector>
+#include <QtPositioning/QGeoShape>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoTiledMappingManagerEngine;
+
+class Q_LOCATION_PRIVATE_EXPORT QGeoTileRegionDownload : public QObject
+{
+    Q_OBJECT
+public:
+    enum State {
+        Idle,
+        Downloading,
+        Paused,
+        Finished
+    };
+
+    // A run of consecutive tiles in a row of a zoom level.
+    struct Span
+    {
+        int zoom;
+        int y;
+        int x;
+        int count;
+    };
+
+    ~QGeoTileRegionDownload();
+
+    QGeoShape area() const;
+    int minimumZoomLevel() const;
+    int maximumZoomLevel() const;
+    int mapId() const;
+
+    void setTarget(QAbstractGeoTileCache *cache,
+                   QAbstractGeoTileCache::CacheAreas areas = QAbstractGeoTileCache::DiskCache);
+    QAbstractGeoTileCache *target() const;
+
+    void setMaximumConcurrentRequests(int requests);
+    int maximumConcurrentRequests() const;
+    void setMaximumRequestRate(qreal requestsPerSecond);
+    qreal maximumRequestRate() const;
+
+    void setPosition(qint64 position);
+    qint64 position() const;
+
+    State state() const;
+    qint64 tilesTotal() const;
+    qint64 tilesDownloaded() const;
+    qint64 tilesFailed() const;
+    qint64 bytesDownloaded() const;
+
+    static QVector<Span> tilesCovering(const QGeoShape &area, int zoom);
+    static qint64 tileCount(const QGeoShape &area, int zoom);
+
+public Q_SLOTS:
+    void start();
+    void pause();
+    void cancel();
+
+Q_SIGNALS:
+    void progressChanged();
+    void stateChanged();
+    void tileError(const QGeoTileSpec &spec, const QString &errorString);
+
+private Q_SLOTS:
+    void requestTiles();
+
+private:
+    QGeoTileRegionDownload(QGeoTiledMappingManagerEngine *engine, const QGeoShape &area,
+                           int minimumZoomLevel, int maximumZoomLevel, int mapId);
+
+    QGeoTileSpec tileAt(qint64 index);
+    void setState(State state);
+    void cancelRequests();
+    void tileFinished(const QGeoTileSpec &spec, const QByteArray &bytes, const QString &format,
+                      bool cached);
+    void tileFailed(const QGeoTileSpec &spec, const QString &errorString);
+    void tileDone(const QGeoTileSpec &spec);
+
+    QGeoTiledMappingManagerEngine *m_engine;
+    QGeoShape m_area;
+    int m_minimumZoomLevel;
+    int m_maximumZoomLevel;
+    int m_mapId;
+    QString m_pluginString;
+    int m_version;
+
+    QPointer<QAbstractGeoTileCache> m_target;
+    QAbstractGeoTileCache::CacheAreas m_targetAreas = QAbstractGeoTileCache::DiskCache;
+    int m_maximumConcurrentRequests = 4;
+    qreal m_maximumRequestRate = 0.0;
+
+    // The spans of a level are only computed once the download gets there.
+    QVector<qint64> m_levelStarts;
+    int m_spansZoom = -1;
+    QVector<Span> m_spans;
+    QVector<qint64> m_spanStarts;
+    qint64 m_total = 0;
+    qint64 m_next = 0;
+    QHash<QGeoTileSpec, qint64> m_requested;
+    QElapsedTimer m_lastRequest;
+    QTimer m_rateTimer;
+
+    State m_state = Idle;
+    qint64 m_downloaded = 0;
+    qint64 m_failed = 0;
+    qint64 m_bytes = 0;
+
+    friend class QGeoTiledMappingManagerEngine;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOTILEREGIONDOWNLOAD_P_H
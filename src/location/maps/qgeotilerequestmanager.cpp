@@ -42,8 +42,6 @@
 
 QT_BEGIN_NAMESPACE
 
-class RetryFuture;
-
 class QGeoTileRequestManagerPrivate
 {
 public:
@@ -56,8 +54,6 @@ public:
     QMap<QGeoTileSpec, QSharedPointer<QGeoTileTexture> > requestTiles(const QSet<QGeoTileSpec> &tiles);
     void tileError(const QGeoTileSpec &tile, const QString &errorString);
 
-    QHash<QGeoTileSpec, int> m_retries;
-    QHash<QGeoTileSpec, QSharedPointer<RetryFuture> > m_futures;
     QSet<QGeoTileSpec> m_requested;
 
     void tileFetched(const QGeoTileSpec &spec);
@@ -129,8 +125,13 @@ QMap<QGeoTileSpec, QSharedPointer<QGeoTileTexture> > QGeoTileRequestManagerPriva
             if (tex) {
                 if (!tex->image.isNull())
                     cachedTex.insert(tile, tex);
-                cached.insert(tile);
+                // Composed tiles stand in while the proper tile is requested
+                if (!tex->provisional)
+                    cached.insert(tile);
             } else {
+                // Compose the tile from cached higher zoom levels in the background
+                m_engine->composeTile(tile, m_map);
+
                 // Try to use textures from lower zoom levels, but still request the proper tile
                 QGeoTileSpec spec = tile;
                 const int endRange = qMax(0, tile.zoom() - 4); // Using up to 4 zoom levels up. 4 is arbitrary.
@@ -160,15 +161,6 @@ QMap<QGeoTileSpec, QSharedPointer<QGeoTileTexture> > QGeoTileRequestManagerPriva
         if (!m_engine.isNull()) {
 //            qDebug() << "new server requests: " << requestTiles.size() << ", server cancels: " << cancelTiles.size();
             m_engine->updateTileRequests(m_map, requestTiles, cancelTiles);
-
-            // Remove any cancelled tiles from the error retry hash to avoid
-            // re-using the numbers for a totally different request cycle.
-            iter i = cancelTiles.constBegin();
-            iter end = cancelTiles.constEnd();
-            for (; i != end; ++i) {
-                m_retries.remove(*i);
-                m_futures.remove(*i);
-            }
         }
     }
 
@@ -179,67 +171,20 @@ void QGeoTileRequestManagerPrivate::tileFetched(const QGeoTileSpec &spec)
 {
     m_map->updateTile(spec);
     m_requested.remove(spec);
-    m_retries.remove(spec);
-    m_futures.remove(spec);
-}
-
-// Represents a tile that needs to be retried after a certain period of time
-class RetryFuture : public QObject
-{
-    Q_OBJECT
-public:
-    RetryFuture(const QGeoTileSpec &tile, QGeoTiledMap *map, QGeoTiledMappingManagerEngine* engine, QObject *parent = 0);
-
-public Q_SLOTS:
-    void retry();
-
-private:
-    QGeoTileSpec m_tile;
-    QGeoTiledMap *m_map;
-    QPointer<QGeoTiledMappingManagerEngine> m_engine;
-};
-
-RetryFuture::RetryFuture(const QGeoTileSpec &tile, QGeoTiledMap *map, QGeoTiledMappingManagerEngine* engine, QObject *parent)
-    : QObject(parent), m_tile(tile), m_map(map), m_engine(engine)
-{}
-
-void RetryFuture::retry()
-{
-    QSet<QGeoTileSpec> requestTiles;
-    QSet<QGeoTileSpec> cancelTiles;
-    requestTiles.insert(m_tile);
-    if (!m_engine.isNull())
-        m_engine->updateTileRequests(m_map, requestTiles, cancelTiles);
 }
 
+/*
+    Retries are scheduled by the engine, per host. This is only called once
+    the engine has given up on the tile.
+*/
 void QGeoTileRequestManagerPrivate::tileError(const QGeoTileSpec &tile, const QString &errorString)
 {
-    if (m_requested.contains(tile)) {
-        int count = m_retries.value(tile, 0);
-        m_retries.insert(tile, count + 1);
-
-        if (count >= 5) {
-            qWarning("QGeoTileRequestManager: Failed to fetch tile (%d,%d,%d) 5 times, giving up. "
-                     "Last error message was: '%s'",
-                     tile.x(), tile.y(), tile.zoom(), qPrintable(errorString));
-            m_requested.remove(tile);
-            m_retries.remove(tile);
-            m_futures.remove(tile);
-
-        } else {
-            // Exponential time backoff when retrying
-            int delay = (1 << count) * 500;
-
-            QSharedPointer<RetryFuture> future(new RetryFuture(tile,m_map,m_engine));
-            m_futures.insert(tile, future);
-
-            QTimer::singleShot(delay, future.data(), SLOT(retry()));
-            // Passing .data() to singleShot is ok -- Qt will clean up the
-            // connection if the target qobject is deleted
-        }
-    }
-}
+    if (!m_requested.remove(tile))
+        return;
 
-#include "qgeotilerequestmanager.moc"
+    qWarning("QGeoTileRequestManager: Failed to fetch tile (%d,%d,%d), giving up. "
+             "Last error message was: '%s'",
+             tile.x(), tile.y(), tile.zoom(), qPrintable(errorString));
+}
 
 QT_END_NAMESPACE
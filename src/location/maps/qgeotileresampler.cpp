@@ -0,0 +1,153 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeotileresampler_p.h"
+
+#include <QtCore/QVarLengthArray>
+#include <cmath>
+
+QT_BEGIN_NAMESPACE
+
+static inline quint32 average4(quint32 a, quint32 b, quint32 c, quint32 d)
+{
+    // At most 4 * 255 + 2 per channel, so the channels do not overflow into each other.
+    const quint32 rb = ((a & 0x00ff00ff) + (b & 0x00ff00ff) + (c & 0x00ff00ff) + (d & 0x00ff00ff)
+                        + 0x00020002) >> 2;
+    const quint32 ag = (((a >> 8) & 0x00ff00ff) + ((b >> 8) & 0x00ff00ff)
+                        + ((c >> 8) & 0x00ff00ff) + ((d >> 8) & 0x00ff00ff) + 0x00020002) >> 2;
+    return (rb & 0x00ff00ff) | ((ag & 0x00ff00ff) << 8);
+}
+
+// Weights go from 0 to 256, so a weighted channel stays below 1 << 16.
+static inline quint32 interpolate(quint32 a, quint32 b, quint32 t)
+{
+    const quint32 s = 256 - t;
+    const quint32 rb = (((a & 0x00ff00ff) * s + (b & 0x00ff00ff) * t) >> 8) & 0x00ff00ff;
+    const quint32 ag = ((((a >> 8) & 0x00ff00ff) * s + ((b >> 8) & 0x00ff00ff) * t) >> 8) & 0x00ff00ff;
+    return rb | (ag << 8);
+}
+
+static QImage premultiplied(const QImage &image)
+{
+    if (image.format() == QImage::Format_ARGB32_Premultiplied)
+        return image;
+    return image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+}
+
+QImage QGeoTileResampler::halve(const QImage &input)
+{
+    const QImage image = premultiplied(input);
+    if (image.isNull())
+        return QImage();
+
+    const int width = image.width();
+    const int height = image.height();
+    const int halfWidth = qMax(1, width / 2);
+    const int halfHeight = qMax(1, height / 2);
+    QImage result(halfWidth, halfHeight, QImage::Format_ARGB32_Premultiplied);
+
+    // Sizes are rounded down as in mipmaps: an odd last row or column is dropped.
+    const int pairs = width / 2;
+    for (int y = 0; y < halfHeight; ++y) {
+        const quint32 *row0 = reinterpret_cast<const quint32 *>(image.constScanLine(2 * y));
+        const quint32 *row1 = reinterpret_cast<const quint32 *>(image.constScanLine(qMin(2 * y + 1, height - 1)));
+        quint32 *out = reinterpret_cast<quint32 *>(result.scanLine(y));
+        for (int x = 0; x < pairs; ++x)
+            out[x] = average4(row0[2 * x], row0[2 * x + 1], row1[2 * x], row1[2 * x + 1]);
+        if (width == 1)
+            out[0] = average4(row0[0], row0[0], row1[0], row1[0]);
+    }
+    return result;
+}
+
+QImage QGeoTileResampler::scaled(const QImage &input, const QSize &size)
+{
+    const QImage image = premultiplied(input);
+    if (image.isNull() || size.isEmpty())
+        return QImage();
+    if (image.size() == size)
+        return image;
+
+    const int width = image.width();
+    const int height = image.height();
+    QImage result(size, QImage::Format_ARGB32_Premultiplied);
+
+    // Sample positions and weights of the columns, the same for every row.
+    QVarLengthArray<int, 1024> left(size.width());
+    QVarLengthArray<int, 1024> right(size.width());
+    QVarLengthArray<quint32, 1024> weight(size.width());
+    const double xScale = double(width) / size.width();
+    for (int x = 0; x < size.width(); ++x) {
+        const double position = qBound(0.0, (x + 0.5) * xScale - 0.5, double(width - 1));
+        left[x] = int(position);
+        right[x] = qMin(left[x] + 1, width - 1);
+        weight[x] = quint32(std::lround((position - left[x]) * 256));
+    }
+
+    QVarLengthArray<quint32, 1024> blended(width);
+    const double yScale = double(height) / size.height();
+    for (int y = 0; y < size.height(); ++y) {
+        const double position = qBound(0.0, (y + 0.5) * yScale - 0.5, double(height - 1));
+        const int top = int(position);
+        const quint32 t = quint32(std::lround((position - top) * 256));
+        const quint32 *row0 = reinterpret_cast<const quint32 *>(image.constScanLine(top));
+        const quint32 *row1 = reinterpret_cast<const quint32 *>(image.constScanLine(qMin(top + 1, height - 1)));
+
+        // Vertically over whole source rows, then horizontally.
+        quint32 *rows = blended.data();
+        for (int x = 0; x < width; ++x)
+            rows[x] = interpolate(row0[x], row1[x], t);
+
+        quint32 *out = reinterpret_cast<quint32 *>(result.scanLine(y));
+        for (int x = 0; x < size.width(); ++x)
+            out[x] = interpolate(rows[left[x]], rows[right[x]], weight[x]);
+    }
+    return result;
+}
+
+QImage QGeoTileResampler::resample(const QImage &image, const QRect &source, const QSize &size)
+{
+    const QRect rect = source & image.rect();
+    if (rect.isEmpty() || size.isEmpty())
+        return QImage();
+
+    QImage result = premultiplied(rect == image.rect() ? image : image.copy(rect));
+    while (result.width() >= 2 * size.width() && result.height() >= 2 * size.height())
+        result = halve(result);
+    return scaled(result, size);
+}
+
+QT_END_NAMESPACE
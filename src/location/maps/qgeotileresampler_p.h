@@ -0,0 +1,79 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOTILERESAMPLER_P_H
+#define QGEOTILERESAMPLER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtLocation/private/qlocationglobal_p.h>
+#include <QtCore/QRect>
+#include <QtGui/QImage>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Resampling of tile images, to be run off the render thread so that
+    textures are uploaded at the size they are drawn at, without mipmaps.
+
+    Images are processed as ARGB32_Premultiplied. The kernels work on two
+    channels per 32-bit word and the loops are kept branch free so that they
+    can be vectorized by the compiler.
+*/
+class Q_LOCATION_PRIVATE_EXPORT QGeoTileResampler
+{
+public:
+    // 2x2 box filter, the next level of a mipmap pyramid.
+    static QImage halve(const QImage &image);
+    // Bilinear filter, for magnifying or for the last step of minifying.
+    static QImage scaled(const QImage &image, const QSize &size);
+    // The part of image in source, halved while at least twice as large
+    // as size, then scaled to size.
+    static QImage resample(const QImage &image, const QRect &source, const QSize &size);
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOTILERESAMPLER_P_H
@@ -0,0 +1,354 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeotileretryscheduler_p.h"
+#include "qgeotiledmappingmanagerengine_p.h"
+
+#include <QtCore/QRandomGenerator>
+#include <QtCore/QTimerEvent>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+QGeoTileRetryScheduler::QGeoTileRetryScheduler(QGeoTiledMappingManagerEngine *engine)
+    : QObject(engine),
+      m_engine(engine),
+      m_openCircuits(0),
+      m_resending(false),
+      m_initialDelay(500),
+      m_maximumDelay(60000),
+      m_failureThreshold(5),
+      m_maximumRetries(5),
+      m_probeTimeout(30000)
+{
+    m_clock.start();
+}
+
+QGeoTileRetryScheduler::~QGeoTileRetryScheduler()
+{
+}
+
+/*
+    Sets the delay before retrying a host after its first failure to
+    \a initialDelay milliseconds. The delay doubles with every further
+    consecutive failure, up to \a maximumDelay milliseconds.
+*/
+void QGeoTileRetryScheduler::setBackoff(int initialDelay, int maximumDelay)
+{
+    m_initialDelay = qMax(1, initialDelay);
+    m_maximumDelay = qMax(m_initialDelay, maximumDelay);
+}
+
+int QGeoTileRetryScheduler::initialDelay() const
+{
+    return m_initialDelay;
+}
+
+int QGeoTileRetryScheduler::maximumDelay() const
+{
+    return m_maximumDelay;
+}
+
+/*
+    Sets the number of consecutive failures after which a host's circuit
+    opens.
+*/
+void QGeoTileRetryScheduler::setFailureThreshold(int failures)
+{
+    m_failureThreshold = qMax(1, failures);
+}
+
+int QGeoTileRetryScheduler::failureThreshold() const
+{
+    return m_failureThreshold;
+}
+
+/*
+    Sets how many times a tile is retried before giving up on it.
+*/
+void QGeoTileRetryScheduler::setMaximumRetries(int retries)
+{
+    m_maximumRetries = qMax(0, retries);
+}
+
+int QGeoTileRetryScheduler::maximumRetries() const
+{
+    return m_maximumRetries;
+}
+
+/*
+    Sets how long, in milliseconds, a probe may go unanswered before the
+    next tile is sent in its place. Probes can be dropped by the fetcher
+    without ever failing.
+*/
+void QGeoTileRetryScheduler::setProbeTimeout(int timeout)
+{
+    m_probeTimeout = qMax(1, timeout);
+}
+
+int QGeoTileRetryScheduler::probeTimeout() const
+{
+    return m_probeTimeout;
+}
+
+/*
+    Returns whether no host has failed and no tile is waiting for a retry,
+    in which case successes need not be reported.
+*/
+bool QGeoTileRetryScheduler::isIdle() const
+{
+    return m_hosts.isEmpty() && m_retries.isEmpty();
+}
+
+bool QGeoTileRetryScheduler::hasOpenCircuits() const
+{
+    return m_openCircuits > 0;
+}
+
+bool QGeoTileRetryScheduler::isCircuitOpen(const QString &host) const
+{
+    QHash<QString, Host>::const_iterator it = m_hosts.constFind(host);
+    return it != m_hosts.constEnd() && it->open;
+}
+
+/*
+    Returns whether new tiles for \a host must be deferred rather than
+    requested. The tiles the scheduler sends itself are never blocked.
+*/
+bool QGeoTileRetryScheduler::isBlocked(const QString &host) const
+{
+    return !m_resending && isCircuitOpen(host);
+}
+
+int QGeoTileRetryScheduler::deferredCount() const
+{
+    int count = 0;
+    for (const Host &host : m_hosts)
+        count += host.deferred.size();
+    return count;
+}
+
+/*
+    Records a failed request to \a host, pushing back its next retry.
+*/
+void QGeoTileRetryScheduler::hostFailed(const QString &host)
+{
+    Host &h = m_hosts[host];
+    ++h.failures;
+    h.probing = false;
+    h.retryAt = m_clock.elapsed() + backoff(h.failures);
+    if (!h.open && h.failures >= m_failureThreshold) {
+        h.open = true;
+        ++m_openCircuits;
+    }
+    scheduleTimer();
+}
+
+/*
+    Counts a failed attempt at \a spec, and returns whether it should be
+    retried.
+*/
+bool QGeoTileRetryScheduler::retryTile(const QGeoTileSpec &spec)
+{
+    int &retries = m_retries[spec];
+    if (retries >= m_maximumRetries) {
+        m_retries.remove(spec);
+        return false;
+    }
+    ++retries;
+    return true;
+}
+
+/*
+    Records that \a spec was fetched from \a host, which closes the host's
+    circuit and sends the tiles that were held back for it.
+*/
+void QGeoTileRetryScheduler::tileSucceeded(const QGeoTileSpec &spec, const QString &host)
+{
+    m_retries.remove(spec);
+
+    QHash<QString, Host>::iterator it = m_hosts.find(host);
+    if (it == m_hosts.end())
+        return;
+    if (it->open)
+        --m_openCircuits;
+
+    const QVector<Deferred> deferred = it->deferred;
+    m_hosts.erase(it);
+    scheduleTimer();
+    resend(deferred);
+}
+
+void QGeoTileRetryScheduler::defer(QGeoTiledMap *map, const QGeoTileSpec &spec, const QString &host)
+{
+    Host &h = m_hosts[host];
+    for (const Deferred &d : qAsConst(h.deferred)) {
+        if (d.map == map && d.spec == spec)
+            return;
+    }
+    h.deferred.append({ map, spec });
+    scheduleTimer();
+}
+
+void QGeoTileRetryScheduler::cancel(QGeoTiledMap *map, const QSet<QGeoTileSpec> &tiles)
+{
+    if (tiles.isEmpty())
+        return;
+    for (Host &host : m_hosts) {
+        host.deferred.erase(std::remove_if(host.deferred.begin(), host.deferred.end(),
+                                           [map, &tiles](const Deferred &d) {
+                                               return d.map == map && tiles.contains(d.spec);
+                                           }),
+                            host.deferred.end());
+    }
+    for (const QGeoTileSpec &spec : tiles)
+        m_retries.remove(spec);
+    dropProbes(map, &tiles);
+}
+
+void QGeoTileRetryScheduler::releaseMap(QGeoTiledMap *map)
+{
+    for (Host &host : m_hosts) {
+        host.deferred.erase(std::remove_if(host.deferred.begin(), host.deferred.end(),
+                                           [map](const Deferred &d) { return d.map == map; }),
+                            host.deferred.end());
+    }
+    dropProbes(map, nullptr);
+}
+
+/*
+    Ends the probes of \a map for \a tiles, or for all of its tiles if
+    \a tiles is null, which will not be answered anymore. The next tile
+    held back for the host is sent as a probe right away.
+*/
+void QGeoTileRetryScheduler::dropProbes(QGeoTiledMap *map, const QSet<QGeoTileSpec> *tiles)
+{
+    bool dropped = false;
+    for (Host &host : m_hosts) {
+        if (!host.probing || host.probe.map != map)
+            continue;
+        if (tiles && !tiles->contains(host.probe.spec))
+            continue;
+        host.probing = false;
+        host.retryAt = m_clock.elapsed();
+        dropped = true;
+    }
+    if (dropped)
+        scheduleTimer();
+}
+
+void QGeoTileRetryScheduler::timerEvent(QTimerEvent *event)
+{
+    if (event->timerId() != m_timer.timerId()) {
+        QObject::timerEvent(event);
+        return;
+    }
+
+    // Collected first, as resending may change the hosts.
+    const qint64 now = m_clock.elapsed();
+    QVector<Deferred> due;
+    for (Host &host : m_hosts) {
+        if (host.retryAt > now)
+            continue;
+        if (host.probing) {
+            // The probe went unanswered, it goes back in line.
+            host.probing = false;
+            if (!host.deferred.contains(host.probe))
+                host.deferred.append(host.probe);
+        }
+        if (host.deferred.isEmpty())
+            continue;
+        if (host.open) {
+            // Half open: a single tile finds out whether the host is back.
+            host.probe = host.deferred.takeFirst();
+            host.probing = true;
+            host.retryAt = now + m_probeTimeout;
+            due.append(host.probe);
+        } else {
+            due += host.deferred;
+            host.deferred.clear();
+        }
+    }
+
+    scheduleTimer();
+    resend(due);
+}
+
+/*
+    Returns the delay after \a failures consecutive failures, with up to
+    half of it taken off at random so that the tiles of many engines do not
+    all come back at once.
+*/
+int QGeoTileRetryScheduler::backoff(int failures) const
+{
+    const int shift = qMin(failures - 1, 20);
+    const int delay = int(qMin<qint64>(qint64(m_initialDelay) << shift, m_maximumDelay));
+    return delay - QRandomGenerator::global()->bounded(delay / 2 + 1);
+}
+
+void QGeoTileRetryScheduler::scheduleTimer()
+{
+    qint64 next = -1;
+    for (const Host &host : qAsConst(m_hosts)) {
+        if (host.deferred.isEmpty() && !host.probing)
+            continue;
+        if (next < 0 || host.retryAt < next)
+            next = host.retryAt;
+    }
+
+    if (next < 0)
+        m_timer.stop();
+    else
+        m_timer.start(int(qMax<qint64>(0, next - m_clock.elapsed())), this);
+}
+
+void QGeoTileRetryScheduler::resend(const QVector<Deferred> &tiles)
+{
+    if (tiles.isEmpty())
+        return;
+
+    QHash<QGeoTiledMap *, QSet<QGeoTileSpec> > perMap;
+    for (const Deferred &d : tiles)
+        perMap[d.map].insert(d.spec);
+
+    m_resending = true;
+    for (auto it = perMap.cbegin(), end = perMap.cend(); it != end; ++it)
+        m_engine->updateTileRequests(it.key(), it.value(), QSet<QGeoTileSpec>());
+    m_resending = false;
+}
+
+QT_END_NAMESPACE
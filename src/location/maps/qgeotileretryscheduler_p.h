@@ -0,0 +1,156 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOTILERETRYSCHEDULER_P_H
+#define QGEOTILERETRYSCHEDULER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtLocation/private/qlocationglobal_p.h>
+#include <QtLocation/private/qgeotilespec_p.h>
+#include <QtCore/QBasicTimer>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtCore/QVector>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoTiledMap;
+class QGeoTiledMappingManagerEngine;
+
+/*
+    Retries the failed tiles of an engine. Tiles are retried per host rather
+    than one by one: after a failure, all the tiles waiting for a host are
+    requested again together once the host's backoff, which doubles with
+    every consecutive failure, has run out. After too many consecutive
+    failures the host's circuit opens: new tiles for the host are held back
+    too, and a single probe tile is sent when the backoff runs out. The first
+    success closes the circuit and releases everything that was held back.
+    A probe that is cancelled, or that is not answered in time, makes way
+    for the next one.
+*/
+class Q_LOCATION_PRIVATE_EXPORT QGeoTileRetryScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    explicit QGeoTileRetryScheduler(QGeoTiledMappingManagerEngine *engine);
+    ~QGeoTileRetryScheduler();
+
+    void setBackoff(int initialDelay, int maximumDelay);
+    int initialDelay() const;
+    int maximumDelay() const;
+    void setFailureThreshold(int failures);
+    int failureThreshold() const;
+    void setMaximumRetries(int retries);
+    int maximumRetries() const;
+    void setProbeTimeout(int timeout);
+    int probeTimeout() const;
+
+    bool isIdle() const;
+    bool hasOpenCircuits() const;
+    bool isCircuitOpen(const QString &host) const;
+    bool isBlocked(const QString &host) const;
+    int deferredCount() const;
+
+    void hostFailed(const QString &host);
+    bool retryTile(const QGeoTileSpec &spec);
+    void tileSucceeded(const QGeoTileSpec &spec, const QString &host);
+    void defer(QGeoTiledMap *map, const QGeoTileSpec &spec, const QString &host);
+    void cancel(QGeoTiledMap *map, const QSet<QGeoTileSpec> &tiles);
+    void releaseMap(QGeoTiledMap *map);
+
+protected:
+    void timerEvent(QTimerEvent *event) override;
+
+private:
+    struct Deferred
+    {
+        QGeoTiledMap *map;
+        QGeoTileSpec spec;
+
+        bool operator==(const Deferred &other) const
+        {
+            return map == other.map && spec == other.spec;
+        }
+    };
+
+    struct Host
+    {
+        Host() : failures(0), retryAt(0), open(false), probing(false), probe() {}
+
+        int failures;
+        qint64 retryAt;
+        bool open;
+        bool probing;
+        Deferred probe;
+        QVector<Deferred> deferred;
+    };
+
+    int backoff(int failures) const;
+    void scheduleTimer();
+    void resend(const QVector<Deferred> &tiles);
+    void dropProbes(QGeoTiledMap *map, const QSet<QGeoTileSpec> *tiles);
+
+    QGeoTiledMappingManagerEngine *m_engine;
+    QHash<QString, Host> m_hosts;
+    QHash<QGeoTileSpec, int> m_retries;
+    int m_openCircuits;
+    bool m_resending;
+    int m_initialDelay;
+    int m_maximumDelay;
+    int m_failureThreshold;
+    int m_maximumRetries;
+    int m_probeTimeout;
+    QElapsedTimer m_clock;
+    QBasicTimer m_timer;
+
+    Q_DISABLE_COPY(QGeoTileRetryScheduler)
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOTILERETRYSCHEDULER_P_H
@@ -55,7 +55,8 @@ PRIVATE_HEADERS += \
     places/qplacereply_p.h \
     places/qplacemanagerengine_p.h \
     places/qplacecontentrequest_p.h \
-    places/qplaceuser_p.h
+    places/qplaceuser_p.h \
+    places/qplacejsonstreamreader_p.h
 
 SOURCES += \
 #data classes
@@ -88,6 +89,7 @@ SOURCES += \
     places/qplacematchreply.cpp \
     places/qplacesearchreply.cpp \
     places/qplacesearchsuggestionreply.cpp \
+    places/qplacejsonstreamreader.cpp \
 #manager and engine
     places/qplacemanager.cpp \
     places/qplacemanagerengine.cpp
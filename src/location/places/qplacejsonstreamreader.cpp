@@ -0,0 +1,265 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qplacejsonstreamreader_p.h"
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Extracts the objects of a JSON array as the document containing it is
+    being received, so that search replies can report their first results
+    before the whole response has arrived.
+
+    The array is found by the keys leading to it from the root of the
+    document, an empty path meaning the root is the array itself. Several
+    paths can be given when the service nests the array differently depending
+    on the request. Each object is parsed with QJsonDocument once its closing
+    brace has been received. Any other value in the array, or an object that
+    does not parse, is an error, as it would be for the whole document. The rest
+    of the document is kept, with the objects replaced by empty ones, for the
+    values that come with the array such as links to other pages.
+
+    The reader only scans the bytes it has not seen yet, and drops the ones it
+    no longer needs, so that feeding it a response chunk by chunk costs about
+    as much as parsing the whole response once.
+*/
+QPlaceJsonStreamReader::QPlaceJsonStreamReader()
+{
+}
+
+void QPlaceJsonStreamReader::addArrayPath(const QStringList &path)
+{
+    m_paths.append(path);
+}
+
+void QPlaceJsonStreamReader::addData(const QByteArray &data)
+{
+    if (m_error || atEnd())
+        return;
+
+    m_buffer.append(data);
+    const char *buffer = m_buffer.constData();
+    const int size = m_buffer.size();
+
+    // Anything following the root value is ignored.
+    for (; m_pos < size && !m_error && !atEnd(); ++m_pos) {
+        const char c = buffer[m_pos];
+
+        if (m_inString) {
+            if (m_escape) {
+                m_escape = false;
+            } else if (c == '\\') {
+                m_escape = true;
+            } else if (c == '"') {
+                m_inString = false;
+                if (m_stringStart >= 0) {
+                    const QByteArray key(buffer + m_stringStart, m_pos + 1 - m_stringStart);
+                    if (key.contains('\\'))
+                        m_key = QJsonDocument::fromJson('[' + key + ']').array().at(0).toString();
+                    else
+                        m_key = QString::fromUtf8(key.constData() + 1, key.size() - 2);
+                    m_stringStart = -1;
+                }
+            }
+            continue;
+        }
+
+        switch (c) {
+        case '"':
+            if (m_elementStart < 0 && isTargetArray()) {
+                m_error = true;
+                break;
+            }
+            m_inString = true;
+            // Only object keys are kept, and only outside of the elements.
+            if (m_expectKey && m_elementStart < 0)
+                m_stringStart = m_pos;
+            m_expectKey = false;
+            break;
+        case '{':
+        case '[': {
+            if (c == '[' && m_elementStart < 0 && isTargetArray()) {
+                m_error = true;
+                break;
+            }
+            m_started = true;
+            if (c == '{' && m_elementStart < 0 && isTargetArray()) {
+                m_remainder.append(buffer + m_copied, m_pos - m_copied);
+                m_copied = m_pos;
+                m_elementStart = m_pos;
+                m_elementDepth = m_stack.size();
+            }
+            Container container;
+            container.type = c;
+            if (!m_stack.isEmpty() && m_stack.constLast().type == '{')
+                container.key = m_key;
+            m_stack.append(container);
+            m_expectKey = c == '{';
+            if (c == '[' && m_elementStart < 0 && isTargetArray())
+                m_arrayFound = true;
+            break;
+        }
+        case '}':
+        case ']':
+            if (m_stack.isEmpty() || m_stack.constLast().type != (c == '}' ? '{' : '[')) {
+                m_error = true;
+                break;
+            }
+            m_stack.removeLast();
+            m_expectKey = false;
+            if (m_elementStart >= 0 && m_stack.size() == m_elementDepth) {
+                const QJsonDocument document = QJsonDocument::fromJson(
+                            QByteArray::fromRawData(buffer + m_elementStart, m_pos + 1 - m_elementStart));
+                if (!document.isObject()) {
+                    m_error = true;
+                    break;
+                }
+                m_objects.append(document.object());
+                m_remainder.append("{}");
+                m_copied = m_pos + 1;
+                m_elementStart = -1;
+                m_elementDepth = -1;
+            }
+            break;
+        case ',':
+            m_expectKey = !m_stack.isEmpty() && m_stack.constLast().type == '{';
+            break;
+        case ' ':
+        case '\t':
+        case '\n':
+        case '\r':
+            break;
+        default:
+            // Numbers, booleans and null.
+            if (m_elementStart < 0 && isTargetArray())
+                m_error = true;
+            break;
+        }
+    }
+
+    compact();
+}
+
+/*
+    Returns the objects completed since the last call.
+*/
+QList<QJsonObject> QPlaceJsonStreamReader::takeObjects()
+{
+    QList<QJsonObject> objects;
+    objects.swap(m_objects);
+    return objects;
+}
+
+/*
+    Returns the document received so far without the objects of the arrays,
+    each of them being replaced by an empty object.
+*/
+QByteArray QPlaceJsonStreamReader::remainder() const
+{
+    if (m_elementStart >= 0)
+        return m_remainder;
+    return m_remainder + m_buffer.mid(m_copied, m_pos - m_copied);
+}
+
+/*
+    Returns true once the root value of the document has been closed.
+*/
+bool QPlaceJsonStreamReader::atEnd() const
+{
+    return m_started && m_stack.isEmpty() && !m_error;
+}
+
+bool QPlaceJsonStreamReader::hasError() const
+{
+    return m_error;
+}
+
+/*
+    Returns true if one of the arrays has been found in the document.
+*/
+bool QPlaceJsonStreamReader::arrayFound() const
+{
+    return m_arrayFound;
+}
+
+bool QPlaceJsonStreamReader::isTargetArray() const
+{
+    if (m_stack.isEmpty() || m_stack.constLast().type != '[')
+        return false;
+
+    for (const QStringList &path : m_paths) {
+        if (path.size() != m_stack.size() - 1)
+            continue;
+        bool matches = true;
+        for (int i = 0; i < path.size() && matches; ++i)
+            matches = m_stack.at(i + 1).key == path.at(i) && m_stack.at(i).type == '{';
+        if (matches)
+            return true;
+    }
+    return false;
+}
+
+/*
+    Drops the bytes that have been scanned and are not part of an element or
+    key still being received.
+*/
+void QPlaceJsonStreamReader::compact()
+{
+    int keep = m_pos;
+    if (m_elementStart >= 0)
+        keep = m_elementStart;
+    else if (m_stringStart >= 0)
+        keep = m_stringStart;
+    if (keep == 0)
+        return;
+
+    if (m_elementStart < 0) {
+        m_remainder.append(m_buffer.constData() + m_copied, keep - m_copied);
+        m_copied = keep;
+    }
+    m_buffer.remove(0, keep);
+    m_pos -= keep;
+    m_copied -= keep;
+    if (m_elementStart >= 0)
+        m_elementStart -= keep;
+    if (m_stringStart >= 0)
+        m_stringStart -= keep;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,107 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QPLACEJSONSTREAMREADER_P_H
+#define QPLACEJSONSTREAMREADER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtLocation/private/qlocationglobal_p.h>
+#include <QtCore/QByteArray>
+#include <QtCore/QJsonObject>
+#include <QtCore/QList>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+QT_BEGIN_NAMESPACE
+
+class Q_LOCATION_PRIVATE_EXPORT QPlaceJsonStreamReader
+{
+public:
+    QPlaceJsonStreamReader();
+
+    void addArrayPath(const QStringList &path);
+
+    void addData(const QByteArray &data);
+    QList<QJsonObject> takeObjects();
+    QByteArray remainder() const;
+
+    bool atEnd() const;
+    bool hasError() const;
+    bool arrayFound() const;
+
+private:
+    struct Container
+    {
+        char type;
+        QString key;
+    };
+
+    bool isTargetArray() const;
+    void compact();
+
+    QList<QStringList> m_paths;
+    QByteArray m_buffer;
+    QByteArray m_remainder;
+    int m_pos = 0;
+    int m_copied = 0;
+    QVector<Container> m_stack;
+    QList<QJsonObject> m_objects;
+
+    QString m_key;
+    int m_stringStart = -1;
+    int m_elementStart = -1;
+    int m_elementDepth = -1;
+    bool m_inString = false;
+    bool m_escape = false;
+    bool m_expectKey = false;
+    bool m_started = false;
+    bool m_arrayFound = false;
+    bool m_error = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QPLACEJSONSTREAMREADER_P_H
@@ -37,6 +37,7 @@
 #include "qplacemanager.h"
 #include "qplacemanagerengine.h"
 #include "qplacemanagerengine_p.h"
+#include "qgeoservicecache_p.h"
 
 #include <QtCore/QDebug>
 
@@ -143,9 +144,17 @@ QPlaceManager::QPlaceManager(QPlaceManagerEngine *engine, QObject *parent)
 
         qRegisterMetaType<QPlaceCategory>();
 
-        connect(d, SIGNAL(finished(QPlaceReply*)), this, SIGNAL(finished(QPlaceReply*)));
-        connect(d, SIGNAL(error(QPlaceReply*,QPlaceReply::Error)),
-                this, SIGNAL(error(QPlaceReply*,QPlaceReply::Error)));
+        // Replies the response cache requested on behalf of its callers
+        // are reported through the replies it handed out instead.
+        connect(d, &QPlaceManagerEngine::finished, this, [this](QPlaceReply *reply) {
+            if (!d->d_ptr->cache || !d->d_ptr->cache->isUpstream(reply))
+                emit finished(reply);
+        });
+        connect(d, &QPlaceManagerEngine::error,
+                this, [this](QPlaceReply *reply, QPlaceReply::Error error, const QString &errorString) {
+            if (!d->d_ptr->cache || !d->d_ptr->cache->isUpstream(reply))
+                emit this->error(reply, error, errorString);
+        });
 
         connect(d, SIGNAL(placeAdded(QString)),
                 this, SIGNAL(placeAdded(QString)), Qt::QueuedConnection);
@@ -219,6 +228,13 @@ QPlaceContentReply *QPlaceManager::getPlaceContent(const QPlaceContentRequest &r
 */
 QPlaceSearchReply *QPlaceManager::search(const QPlaceSearchRequest &request) const
 {
+    if (QGeoServiceCache *cache = d->d_ptr->cache) {
+        QPlaceManagerEngine *engine = d;
+        return cache->search(QGeoServiceCache::searchKey(request, locales()),
+                             const_cast<QPlaceManager *>(this), [engine, request]() {
+            return engine->search(request);
+        });
+    }
     return d->search(request);
 }
 
@@ -348,7 +348,7 @@ QUrl QPlaceManagerEngine::constructIconUrl(const QPlaceIcon &icon, const QSize &
 }
 
 QPlaceManagerEnginePrivate::QPlaceManagerEnginePrivate()
-    :   managerVersion(-1), manager(0)
+    :   managerVersion(-1), manager(0), cache(0)
 {
 }
 
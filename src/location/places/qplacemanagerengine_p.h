@@ -53,6 +53,8 @@
 
 QT_BEGIN_NAMESPACE
 
+class QGeoServiceCache;
+
 class QPlaceManagerEnginePrivate
 {
 public:
@@ -62,6 +64,7 @@ public:
     QString managerName;
     int managerVersion;
     QPlaceManager *manager;
+    QGeoServiceCache *cache;
 
 private:
     Q_DISABLE_COPY(QPlaceManagerEnginePrivate)
@@ -62,6 +62,12 @@ public:
     instance of QPlaceManager.
 
     See \l {Discovery/Search} for an example on how to use a search reply.
+
+    Plugins that receive the results of a search progressively may set the
+    results received so far and emit contentUpdated() before the reply has
+    finished. Each update only appends results to those of the previous one,
+    so that models can add rows for the new results only.
+
     \sa QPlaceSearchRequest, QPlaceManager
 */
 
@@ -6,6 +6,7 @@ QT_FOR_CONFIG += location-private
 qtConfig(location-labs-plugin): DEFINES += LOCATIONLABS
 
 HEADERS += \
+    geocodebatchreply_esri.h \
     geocodereply_esri.h \
     geocodingmanagerengine_esri.h \
     geomapsource.h \
@@ -22,6 +23,7 @@ HEADERS += \
     placecategoriesreply_esri.h
 
 SOURCES += \
+    geocodebatchreply_esri.cpp \
     geocodereply_esri.cpp  \
     geocodingmanagerengine_esri.cpp \
     geomapsource.cpp \
@@ -0,0 +1,154 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "geocodebatchreply_esri.h"
+#include "geocodereply_esri.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QSharedPointer>
+#include <QGeoLocation>
+#include <QtLocation/private/qgeoparsetask_p.h>
+
+QT_BEGIN_NAMESPACE
+
+// https://developers.arcgis.com/rest/geocode/api-reference/geocoding-geocode-addresses.htm
+
+/*
+    Each of the \a replies answers a geocodeAddresses request for \a chunkSize
+    consecutive items of the batch, whose OBJECTID is their index in the batch.
+    The service only returns the best match of each address, items without a
+    match get no locations.
+*/
+GeoCodeBatchReplyEsri::GeoCodeBatchReplyEsri(const QList<QNetworkReply *> &replies, int count,
+                                             int chunkSize, QObject *parent)
+:   QGeoCodeBatchReply(count, parent), m_chunkSize(chunkSize), m_pendingChunks(replies.size())
+{
+    for (int i = 0; i < replies.size(); ++i) {
+        QNetworkReply *reply = replies.at(i);
+        m_chunks.insert(reply, i);
+        connect(reply, SIGNAL(finished()), this, SLOT(networkReplyFinished()));
+        connect(this, &QGeoCodeReply::aborted, reply, &QNetworkReply::abort);
+        connect(this, &QObject::destroyed, reply, &QObject::deleteLater);
+    }
+
+    setLimit(1);
+    setOffset(0);
+}
+
+GeoCodeBatchReplyEsri::~GeoCodeBatchReplyEsri()
+{
+}
+
+void GeoCodeBatchReplyEsri::networkReplyFinished()
+{
+    QNetworkReply *reply = static_cast<QNetworkReply *>(sender());
+    reply->deleteLater();
+
+    // Aborted.
+    if (isFinished())
+        return;
+
+    const int first = m_chunks.value(reply) * m_chunkSize;
+    const int last = qMin(count(), first + m_chunkSize);
+
+    if (reply->error() != QNetworkReply::NoError) {
+        for (int i = first; i < last; ++i)
+            setItemError(i, CommunicationError, reply->errorString());
+        chunkFinished();
+        return;
+    }
+
+    struct Result
+    {
+        QString errorString;
+        QHash<int, QGeoLocation> locations;
+    };
+    QSharedPointer<Result> result(new Result);
+
+    const QByteArray data = reply->readAll();
+    const QGeoParseTask::Handle task = QGeoParseTask::start(this,
+        [data, result]() {
+            const QJsonDocument document = QJsonDocument::fromJson(data);
+            if (!document.isObject()) {
+                result->errorString = QStringLiteral("Unknown document");
+                return;
+            }
+
+            const QJsonObject object = document.object();
+            if (object.contains(QStringLiteral("error"))) {
+                const QJsonObject error = object.value(QStringLiteral("error")).toObject();
+                result->errorString = error.value(QStringLiteral("message")).toString();
+                return;
+            }
+
+            const QJsonArray locations = object.value(QStringLiteral("locations")).toArray();
+            for (const QJsonValue &value : locations) {
+                const QJsonObject candidate = value.toObject();
+                const QJsonObject attributes = candidate.value(QStringLiteral("attributes")).toObject();
+                // Unmatched addresses are returned with a status of U.
+                if (attributes.value(QStringLiteral("Status")).toString() == QLatin1String("U"))
+                    continue;
+                const int index = attributes.value(QStringLiteral("ResultID")).toInt(-1);
+                if (index >= 0)
+                    result->locations.insert(index, GeoCodeReplyEsri::parseCandidate(candidate));
+            }
+        },
+        [this, result, first, last]() {
+            for (int i = first; i < last; ++i) {
+                if (!result->errorString.isEmpty()) {
+                    setItemError(i, ParseError, result->errorString);
+                } else if (result->locations.contains(i)) {
+                    setItemLocations(i, QList<QGeoLocation>() << result->locations.value(i));
+                } else {
+                    setItemLocations(i, QList<QGeoLocation>());
+                }
+            }
+            chunkFinished();
+        });
+    connect(this, &QGeoCodeReply::aborted, this, [task]() { task.cancel(); });
+}
+
+void GeoCodeBatchReplyEsri::chunkFinished()
+{
+    if (--m_pendingChunks > 0)
+        return;
+
+    finishBatch();
+}
+
+QT_END_NAMESPACE
@@ -46,6 +46,7 @@
 #include <QGeoAddress>
 #include <QGeoLocation>
 #include <QGeoRectangle>
+#include <QtLocation/private/qgeocodereply_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -87,18 +88,23 @@ void GeoCodeReplyEsri::networkReplyFinished()
     if (reply->error() != QNetworkReply::NoError)
         return;
 
-    QJsonDocument document = QJsonDocument::fromJson(reply->readAll());
+    const QByteArray data = reply->readAll();
+    const OperationType type = operationType();
+    QGeoCodeReplyPrivate::parseAsync(this, [data, type](QList<QGeoLocation> &locations, QString &errorString) {
+        QJsonDocument document = QJsonDocument::fromJson(data);
+
+        if (!document.isObject()) {
+            errorString = QStringLiteral("Unknown document");
+            return QGeoCodeReply::CommunicationError;
+        }
 
-    if (document.isObject()) {
         QJsonObject object = document.object();
 
-        switch (operationType()) {
+        switch (type) {
         case Geocode:
         {
             QJsonArray candidates = object.value(QStringLiteral("candidates")).toArray();
 
-            QList<QGeoLocation> locations;
-
             for (int i = 0; i < candidates.count(); i++) {
                 if (!candidates.at(i).isObject())
                     continue;
@@ -108,28 +114,16 @@ void GeoCodeReplyEsri::networkReplyFinished()
                 QGeoLocation location = parseCandidate(candidate);
                 locations.append(location);
             }
-
-            setLocations(locations);
-            setFinished(true);
         }
             break;
 
         case ReverseGeocode:
-        {
-            QGeoLocation location = parseAddress(object);
-
-            QList<QGeoLocation> locations;
-            locations.append(location);
-
-            setLocations(locations);
-            setFinished(true);
-        }
+            locations.append(parseAddress(object));
             break;
         }
 
-    } else {
-        setError(QGeoCodeReply::CommunicationError, QStringLiteral("Unknown document"));
-    }
+        return QGeoCodeReply::NoError;
+    });
 }
 
 QGeoLocation GeoCodeReplyEsri::parseAddress(const QJsonObject& object)
@@ -62,14 +62,15 @@ public:
 
     inline OperationType operationType() const;
 
+    static QGeoLocation parseCandidate(const QJsonObject &candidate);
+
 private Q_SLOTS:
     void networkReplyFinished();
     void networkReplyError(QNetworkReply::NetworkError error);
 
-    QGeoLocation parseAddress(const QJsonObject &object);
-    QGeoLocation parseCandidate(const QJsonObject &candidate);
-
 private:
+    static QGeoLocation parseAddress(const QJsonObject &object);
+
     OperationType m_operationType;
 };
 
@@ -39,6 +39,7 @@
 
 #include "geocodingmanagerengine_esri.h"
 #include "geocodereply_esri.h"
+#include "geocodebatchreply_esri.h"
 
 #include <QVariantMap>
 #include <QUrl>
@@ -46,6 +47,9 @@
 #include <QLocale>
 #include <QNetworkAccessManager>
 #include <QNetworkRequest>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
 #include <QGeoCoordinate>
 #include <QGeoAddress>
 #include <QGeoShape>
@@ -55,12 +59,19 @@ QT_BEGIN_NAMESPACE
 
 // https://developers.arcgis.com/rest/geocode/api-reference/geocoding-find-address-candidates.htm
 // https://developers.arcgis.com/rest/geocode/api-reference/geocoding-reverse-geocode.htm
+// https://developers.arcgis.com/rest/geocode/api-reference/geocoding-geocode-addresses.htm
 
 static const QString kPrefixEsri(QStringLiteral("esri."));
 static const QString kParamUserAgent(kPrefixEsri + QStringLiteral("useragent"));
+static const QString kParamToken(kPrefixEsri + QStringLiteral("token"));
 
 static const QString kUrlGeocode(QStringLiteral("http://geocode.arcgis.com/arcgis/rest/services/World/GeocodeServer/findAddressCandidates"));
 static const QString kUrlReverseGeocode(QStringLiteral("http://geocode.arcgis.com/arcgis/rest/services/World/GeocodeServer/reverseGeocode"));
+static const QString kUrlGeocodeAddresses(QStringLiteral("https://geocode.arcgis.com/arcgis/rest/services/World/GeocodeServer/geocodeAddresses"));
+
+// Number of addresses sent per geocodeAddresses request, as suggested by the
+// World geocoding service.
+static const int kBatchSize = 150;
 
 static QString addressToQuery(const QGeoAddress &address)
 {
@@ -71,6 +82,11 @@ static QString addressToQuery(const QGeoAddress &address)
            + address.country();
 }
 
+static QByteArray formField(const QString &key, const QString &value)
+{
+    return key.toLatin1() + '=' + QUrl::toPercentEncoding(value);
+}
+
 static QString boundingBoxToLtrb(const QGeoRectangle &rect)
 {
     return QString::number(rect.topLeft().longitude()) + QLatin1Char(',')
@@ -89,6 +105,8 @@ GeoCodingManagerEngineEsri::GeoCodingManagerEngineEsri(const QVariantMap &parame
     else
         m_userAgent = QByteArrayLiteral("Qt Location based application");
 
+    m_token = parameters.value(kParamToken).toString();
+
     *error = QGeoServiceProvider::NoError;
     errorString->clear();
 }
@@ -168,6 +186,96 @@ QGeoCodeReply *GeoCodingManagerEngineEsri::reverseGeocode(const QGeoCoordinate &
     return geocodeReply;
 }
 
+/*
+    Batches use the geocodeAddresses operation, which requires a token. Without
+    one the addresses are geocoded one by one.
+*/
+QGeoCodeBatchReply *GeoCodingManagerEngineEsri::geocodeBatch(const QList<QGeoAddress> &addresses,
+                                                             const QGeoShape &bounds)
+{
+    if (m_token.isEmpty())
+        return nullptr;
+
+    QJsonArray records;
+    for (const QGeoAddress &address : addresses) {
+        QJsonObject attributes;
+        attributes.insert(QStringLiteral("Address"), address.street());
+        attributes.insert(QStringLiteral("Neighborhood"), address.district());
+        attributes.insert(QStringLiteral("City"), address.city());
+        attributes.insert(QStringLiteral("Subregion"), address.county());
+        attributes.insert(QStringLiteral("Region"), address.state());
+        attributes.insert(QStringLiteral("Postal"), address.postalCode());
+        attributes.insert(QStringLiteral("CountryCode"), address.countryCode());
+        records.append(attributes);
+    }
+
+    return sendBatch(records, bounds);
+}
+
+QGeoCodeBatchReply *GeoCodingManagerEngineEsri::geocodeBatch(const QStringList &addresses,
+                                                             int limit, const QGeoShape &bounds)
+{
+    Q_UNUSED(limit)
+
+    if (m_token.isEmpty())
+        return nullptr;
+
+    QJsonArray records;
+    for (const QString &address : addresses) {
+        QJsonObject attributes;
+        attributes.insert(QStringLiteral("SingleLine"), address);
+        records.append(attributes);
+    }
+
+    return sendBatch(records, bounds);
+}
+
+QGeoCodeBatchReply *GeoCodingManagerEngineEsri::sendBatch(const QJsonArray &records,
+                                                          const QGeoShape &bounds)
+{
+    if (records.isEmpty())
+        return nullptr;
+
+    QList<QNetworkReply *> replies;
+    for (int first = 0; first < records.size(); first += kBatchSize) {
+        QJsonArray chunk;
+        for (int i = first; i < qMin(records.size(), first + kBatchSize); ++i) {
+            QJsonObject attributes = records.at(i).toObject();
+            attributes.insert(QStringLiteral("OBJECTID"), i);
+            QJsonObject record;
+            record.insert(QStringLiteral("attributes"), attributes);
+            chunk.append(record);
+        }
+        QJsonObject addresses;
+        addresses.insert(QStringLiteral("records"), chunk);
+
+        QByteArray body;
+        body += formField(QStringLiteral("addresses"),
+                          QString::fromUtf8(QJsonDocument(addresses).toJson(QJsonDocument::Compact)));
+        body += '&' + formField(QStringLiteral("f"), QStringLiteral("json"));
+        body += '&' + formField(QStringLiteral("outSR"), QStringLiteral("4326"));
+        body += '&' + formField(QStringLiteral("outFields"), QStringLiteral("*"));
+        body += '&' + formField(QStringLiteral("token"), m_token);
+        if (bounds.type() != QGeoShape::UnknownType)
+            body += '&' + formField(QStringLiteral("searchExtent"), boundingBoxToLtrb(bounds.boundingGeoRectangle()));
+
+        QNetworkRequest request(QUrl(kUrlGeocodeAddresses));
+        request.setHeader(QNetworkRequest::UserAgentHeader, m_userAgent);
+        request.setHeader(QNetworkRequest::ContentTypeHeader,
+                          QByteArrayLiteral("application/x-www-form-urlencoded"));
+        replies.append(m_networkManager->post(request, body));
+    }
+
+    GeoCodeBatchReplyEsri *batchReply = new GeoCodeBatchReplyEsri(replies, records.size(),
+                                                                  kBatchSize, this);
+
+    connect(batchReply, SIGNAL(finished()), this, SLOT(replyFinished()));
+    connect(batchReply, SIGNAL(error(QGeoCodeReply::Error,QString)),
+            this, SLOT(replyError(QGeoCodeReply::Error,QString)));
+
+    return batchReply;
+}
+
 void GeoCodingManagerEngineEsri::replyFinished()
 {
     QGeoCodeReply *reply = qobject_cast<QGeoCodeReply *>(sender());
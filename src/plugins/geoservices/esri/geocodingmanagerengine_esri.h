@@ -43,14 +43,17 @@
 #include <QGeoServiceProvider>
 #include <QGeoCodingManagerEngine>
 #include <QGeoCodeReply>
+#include <QtLocation/private/qgeocodingbatchengine_p.h>
 
 QT_BEGIN_NAMESPACE
 
 class QNetworkAccessManager;
+class QJsonArray;
 
-class GeoCodingManagerEngineEsri : public QGeoCodingManagerEngine
+class GeoCodingManagerEngineEsri : public QGeoCodingManagerEngine, public QGeoCodingBatchEngine
 {
     Q_OBJECT
+    Q_INTERFACES(QGeoCodingBatchEngine)
 
 public:
     GeoCodingManagerEngineEsri(const QVariantMap &parameters, QGeoServiceProvider::Error *error,
@@ -63,13 +66,21 @@ public:
     QGeoCodeReply *reverseGeocode(const QGeoCoordinate &coordinate,
                                   const QGeoShape &bounds) override;
 
+    QGeoCodeBatchReply *geocodeBatch(const QList<QGeoAddress> &addresses,
+                                     const QGeoShape &bounds) override;
+    QGeoCodeBatchReply *geocodeBatch(const QStringList &addresses, int limit,
+                                     const QGeoShape &bounds) override;
+
 private Q_SLOTS:
     void replyFinished();
     void replyError(QGeoCodeReply::Error errorCode, const QString &errorString);
 
 private:
+    QGeoCodeBatchReply *sendBatch(const QJsonArray &records, const QGeoShape &bounds);
+
     QNetworkAccessManager *m_networkManager;
     QByteArray m_userAgent;
+    QString m_token;
 };
 
 QT_END_NAMESPACE
@@ -41,6 +41,7 @@
 #include "georoutejsonparser_esri.h"
 
 #include <QJsonDocument>
+#include <QtLocation/private/qgeoroutereply_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -73,16 +74,16 @@ void GeoRouteReplyEsri::networkReplyFinished()
     if (reply->error() != QNetworkReply::NoError)
         return;
 
-    QJsonDocument document = QJsonDocument::fromJson(reply->readAll());
-    GeoRouteJsonParserEsri parser(document);
-
-    if (parser.isValid())
-    {
-        setRoutes(parser.routes());
-        setFinished(true);
-    } else {
-        setError(QGeoRouteReply::ParseError, parser.errorString());
-    }
+    const QByteArray data = reply->readAll();
+    QGeoRouteReplyPrivate::parseAsync(this, [data](QList<QGeoRoute> &routes, QString &errorString) {
+        GeoRouteJsonParserEsri parser(QJsonDocument::fromJson(data));
+        if (!parser.isValid()) {
+            errorString = parser.errorString();
+            return QGeoRouteReply::ParseError;
+        }
+        routes = parser.routes();
+        return QGeoRouteReply::NoError;
+    });
 }
 
 void GeoRouteReplyEsri::networkReplyError(QNetworkReply::NetworkError error)
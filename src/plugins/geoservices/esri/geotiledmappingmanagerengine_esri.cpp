@@ -61,6 +61,8 @@ static const QString kParamToken(kPrefixEsri + QStringLiteral("token"));
 static const QString kPrefixMapping(kPrefixEsri + QStringLiteral("mapping."));
 static const QString kParamMinimumZoomLevel(kPrefixMapping + QStringLiteral("minimumZoomLevel"));
 static const QString kParamMaximumZoomLevel(kPrefixMapping + QStringLiteral("maximumZoomLevel"));
+static const QString kParamMaxRequestsPerHost(kPrefixMapping + QStringLiteral("maxRequestsPerHost"));
+static const QString kParamHttp2(kPrefixMapping + QStringLiteral("http2"));
 
 static const QString kPropMapSources(QStringLiteral("mapSources"));
 static const QString kPropStyle(QStringLiteral("style"));
@@ -128,6 +130,12 @@ GeoTiledMappingManagerEngineEsri::GeoTiledMappingManagerEngineEsri(const QVarian
     if (parameters.contains(kParamToken))
         tileFetcher->setToken(parameters.value(kParamToken).toString());
 
+    if (parameters.contains(kParamMaxRequestsPerHost))
+        tileFetcher->setMaximumRequestsPerHost(parameters.value(kParamMaxRequestsPerHost).toInt());
+
+    if (parameters.contains(kParamHttp2))
+        tileFetcher->setHttp2Enabled(parameters.value(kParamHttp2).toBool());
+
     setTileFetcher(tileFetcher);
 
     /* TILE CACHE */
@@ -154,7 +162,7 @@ GeoTiledMappingManagerEngineEsri::GeoTiledMappingManagerEngineEsri(const QVarian
     }
     if (parameters.contains(QStringLiteral("esri.mapping.cache.disk.size"))) {
         bool ok = false;
-        int cacheSize = parameters.value(QStringLiteral("esri.mapping.cache.disk.size")).toString().toInt(&ok);
+        qint64 cacheSize = parameters.value(QStringLiteral("esri.mapping.cache.disk.size")).toString().toLongLong(&ok);
         if (ok)
             tileCache->setMaxDiskUsage(cacheSize);
     }
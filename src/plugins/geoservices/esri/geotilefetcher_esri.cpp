@@ -58,6 +58,7 @@ QGeoTiledMapReply *GeoTileFetcherEsri::getTileImage(const QGeoTileSpec &spec)
 {
     QNetworkRequest request;
     request.setHeader(QNetworkRequest::UserAgentHeader, userAgent());
+    prepareTileRequest(spec, &request);
 
     GeoTiledMappingManagerEngineEsri *engine = qobject_cast<GeoTiledMappingManagerEngineEsri *>(
           parent());
@@ -74,4 +75,15 @@ QGeoTiledMapReply *GeoTileFetcherEsri::getTileImage(const QGeoTileSpec &spec)
     return new GeoTiledMapReplyEsri(reply, spec);
 }
 
+QString GeoTileFetcherEsri::tileHost(const QGeoTileSpec &spec) const
+{
+    GeoTiledMappingManagerEngineEsri *engine = qobject_cast<GeoTiledMappingManagerEngineEsri *>(
+          parent());
+
+    GeoMapSource *mapSource = engine->mapSource(spec.mapId());
+    if (!mapSource)
+        return QString();
+    return QUrl(mapSource->url()).host();
+}
+
 QT_END_NAMESPACE
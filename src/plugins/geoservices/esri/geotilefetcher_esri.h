@@ -60,6 +60,9 @@ public:
     inline const QString &token() const;
     inline void setToken(const QString &token);
 
+protected:
+    QString tileHost(const QGeoTileSpec &spec) const override;
+
 private:
     QGeoTiledMapReply *getTileImage(const QGeoTileSpec &spec) override;
 
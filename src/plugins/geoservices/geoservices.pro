@@ -7,6 +7,8 @@ qtConfig(geoservices_mapbox): SUBDIRS += mapbox
 qtConfig(geoservices_esri): SUBDIRS += esri
 qtConfig(geoservices_itemsoverlay): SUBDIRS += itemsoverlay
 qtConfig(geoservices_osm): SUBDIRS += osm
+qtConfig(geoservices_offline): SUBDIRS += offline
+qtConfig(geoservices_mvt): SUBDIRS += mvt
 
 qtConfig(geoservices_mapboxgl) {
     !exists(../../3rdparty/mapbox-gl-native/mapbox-gl-native.pro) {
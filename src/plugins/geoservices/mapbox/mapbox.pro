@@ -19,6 +19,7 @@ HEADERS += \
     qplacesearchreplymapbox.h \
     qgeocodingmanagerenginemapbox.h \
     qgeocodereplymapbox.h \
+    qgeocodebatchreplymapbox.h \
     qmapboxcommon.h
 
 SOURCES += \
@@ -35,6 +36,7 @@ SOURCES += \
     qplacesearchreplymapbox.cpp \
     qgeocodingmanagerenginemapbox.cpp \
     qgeocodereplymapbox.cpp \
+    qgeocodebatchreplymapbox.cpp \
     qmapboxcommon.cpp
 
 RESOURCES += mapbox.qrc
@@ -0,0 +1,143 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeocodebatchreplymapbox.h"
+#include "qmapboxcommon.h"
+
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QJsonArray>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QVector>
+#include <QtPositioning/QGeoLocation>
+#include <QtLocation/private/qgeoparsetask_p.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Each of the \a replies answers a batch geocoding request for \a chunkSize
+    consecutive items of the batch, in the same order. The response holds one
+    FeatureCollection per query, or only the FeatureCollection itself when
+    there was a single query.
+*/
+QGeoCodeBatchReplyMapbox::QGeoCodeBatchReplyMapbox(const QList<QNetworkReply *> &replies, int count,
+                                                   int chunkSize, QObject *parent)
+:   QGeoCodeBatchReply(count, parent), m_chunkSize(chunkSize), m_pendingChunks(replies.size())
+{
+    Q_ASSERT(parent);
+    for (int i = 0; i < replies.size(); ++i) {
+        QNetworkReply *reply = replies.at(i);
+        m_chunks.insert(reply, i);
+        connect(reply, &QNetworkReply::finished, this, &QGeoCodeBatchReplyMapbox::onNetworkReplyFinished);
+        connect(this, &QGeoCodeReply::aborted, reply, &QNetworkReply::abort);
+        connect(this, &QObject::destroyed, reply, &QObject::deleteLater);
+    }
+}
+
+QGeoCodeBatchReplyMapbox::~QGeoCodeBatchReplyMapbox()
+{
+}
+
+void QGeoCodeBatchReplyMapbox::onNetworkReplyFinished()
+{
+    QNetworkReply *reply = static_cast<QNetworkReply *>(sender());
+    reply->deleteLater();
+
+    // Aborted.
+    if (isFinished())
+        return;
+
+    const int first = m_chunks.value(reply) * m_chunkSize;
+    const int last = qMin(count(), first + m_chunkSize);
+
+    if (reply->error() != QNetworkReply::NoError) {
+        for (int i = first; i < last; ++i)
+            setItemError(i, CommunicationError, reply->errorString());
+        chunkFinished();
+        return;
+    }
+
+    struct Result
+    {
+        bool valid = false;
+        QVector<QList<QGeoLocation>> locations;
+    };
+    QSharedPointer<Result> result(new Result);
+
+    const QByteArray data = reply->readAll();
+    const QGeoParseTask::Handle task = QGeoParseTask::start(this,
+        [data, result]() {
+            const QJsonDocument document = QJsonDocument::fromJson(data);
+            QJsonArray collections;
+            if (document.isArray())
+                collections = document.array();
+            else if (document.isObject())
+                collections.append(document.object());
+            else
+                return;
+
+            result->valid = true;
+            for (const QJsonValue &collection : qAsConst(collections)) {
+                QList<QGeoLocation> locations;
+                const QJsonArray features = collection.toObject().value(QStringLiteral("features")).toArray();
+                for (const QJsonValue &value : features)
+                    locations.append(QMapboxCommon::parseGeoLocation(value.toObject()));
+                result->locations.append(locations);
+            }
+        },
+        [this, result, first, last]() {
+            // translate in this thread rather than on the worker
+            const QString parseErrorString = tr("Response parse error");
+            for (int i = first; i < last; ++i) {
+                if (!result->valid || i - first >= result->locations.size())
+                    setItemError(i, ParseError, parseErrorString);
+                else
+                    setItemLocations(i, result->locations.at(i - first));
+            }
+            chunkFinished();
+        });
+    connect(this, &QGeoCodeReply::aborted, this, [task]() { task.cancel(); });
+}
+
+void QGeoCodeBatchReplyMapbox::chunkFinished()
+{
+    if (--m_pendingChunks > 0)
+        return;
+
+    finishBatch();
+}
+
+QT_END_NAMESPACE
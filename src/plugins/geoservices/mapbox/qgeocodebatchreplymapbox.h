@@ -0,0 +1,67 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOCODEBATCHREPLYMAPBOX_H
+#define QGEOCODEBATCHREPLYMAPBOX_H
+
+#include <QtNetwork/QNetworkReply>
+#include <QtLocation/QGeoCodeBatchReply>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoCodeBatchReplyMapbox : public QGeoCodeBatchReply
+{
+    Q_OBJECT
+
+public:
+    QGeoCodeBatchReplyMapbox(const QList<QNetworkReply *> &replies, int count, int chunkSize,
+                             QObject *parent = 0);
+    ~QGeoCodeBatchReplyMapbox();
+
+private Q_SLOTS:
+    void onNetworkReplyFinished();
+
+private:
+    void chunkFinished();
+
+    QHash<QNetworkReply *, int> m_chunks;
+    int m_chunkSize;
+    int m_pendingChunks;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOCODEBATCHREPLYMAPBOX_H
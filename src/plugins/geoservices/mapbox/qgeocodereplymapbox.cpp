@@ -47,6 +47,7 @@
 #include <QtPositioning/QGeoAddress>
 #include <QtPositioning/QGeoLocation>
 #include <QtPositioning/QGeoRectangle>
+#include <QtLocation/private/qgeocodereply_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -79,20 +80,22 @@ void QGeoCodeReplyMapbox::onNetworkReplyFinished()
     if (reply->error() != QNetworkReply::NoError)
         return;
 
-    QList<QGeoLocation> locations;
-    QJsonDocument document = QJsonDocument::fromJson(reply->readAll());
-    if (!document.isObject()) {
-        setError(ParseError, tr("Response parse error"));
-        return;
-    }
-
-    const QJsonArray features = document.object().value(QStringLiteral("features")).toArray();
-    for (const QJsonValue &value : features)
-        locations.append(QMapboxCommon::parseGeoLocation(value.toObject()));
+    const QByteArray data = reply->readAll();
+    // translate in this thread rather than on the worker
+    const QString parseErrorString = tr("Response parse error");
+    QGeoCodeReplyPrivate::parseAsync(this, [data, parseErrorString](QList<QGeoLocation> &locations, QString &errorString) {
+        QJsonDocument document = QJsonDocument::fromJson(data);
+        if (!document.isObject()) {
+            errorString = parseErrorString;
+            return QGeoCodeReply::ParseError;
+        }
 
-    setLocations(locations);
+        const QJsonArray features = document.object().value(QStringLiteral("features")).toArray();
+        for (const QJsonValue &value : features)
+            locations.append(QMapboxCommon::parseGeoLocation(value.toObject()));
 
-    setFinished(true);
+        return QGeoCodeReply::NoError;
+    });
 }
 
 void QGeoCodeReplyMapbox::onNetworkReplyError(QNetworkReply::NetworkError error)
@@ -39,6 +39,7 @@
 
 #include "qgeocodingmanagerenginemapbox.h"
 #include "qgeocodereplymapbox.h"
+#include "qgeocodebatchreplymapbox.h"
 #include "qmapboxcommon.h"
 
 #include <QtCore/QVariantMap>
@@ -59,6 +60,25 @@ QT_BEGIN_NAMESPACE
 
 namespace {
     static const QString allAddressTypes = QStringLiteral("address,district,locality,neighborhood,place,postcode,region,country");
+
+    // Maximum number of queries in a batch geocoding request.
+    static const int maxBatchSize = 50;
+
+    QString addressQuery(const QGeoAddress &address)
+    {
+        if (!address.isTextGenerated())
+            return address.text().simplified();
+
+        QStringList addressString;
+        const QStringList fields = QStringList() << address.street() << address.district()
+                                                 << address.city() << address.postalCode()
+                                                 << address.state() << address.country();
+        for (const QString &field : fields) {
+            if (!field.isEmpty())
+                addressString.append(field);
+        }
+        return addressString.join(QStringLiteral(", "));
+    }
 }
 
 QGeoCodingManagerEngineMapbox::QGeoCodingManagerEngineMapbox(const QVariantMap &parameters,
@@ -156,7 +176,49 @@ QGeoCodeReply *QGeoCodingManagerEngineMapbox::reverseGeocode(const QGeoCoordinat
     return doSearch(coordinateString, queryItems, bounds);
 }
 
-QGeoCodeReply *QGeoCodingManagerEngineMapbox::doSearch(const QString &request, QUrlQuery &queryItems, const QGeoShape &bounds)
+/*
+    Batches are only supported by the permanent geocoding endpoint, that is
+    with the mapbox.enterprise parameter. Otherwise the addresses are
+    geocoded one by one.
+*/
+QGeoCodeBatchReply *QGeoCodingManagerEngineMapbox::geocodeBatch(const QList<QGeoAddress> &addresses, const QGeoShape &bounds)
+{
+    QStringList requests;
+    requests.reserve(addresses.size());
+    for (const QGeoAddress &address : addresses)
+        requests.append(addressQuery(address));
+
+    QUrlQuery queryItems;
+    queryItems.addQueryItem(QStringLiteral("type"), allAddressTypes);
+    queryItems.addQueryItem(QStringLiteral("limit"), QString::number(1));
+
+    return doBatchSearch(requests, queryItems, bounds);
+}
+
+QGeoCodeBatchReply *QGeoCodingManagerEngineMapbox::geocodeBatch(const QStringList &addresses, int limit, const QGeoShape &bounds)
+{
+    QUrlQuery queryItems;
+    queryItems.addQueryItem(QStringLiteral("type"), allAddressTypes);
+    if (limit != -1)
+        queryItems.addQueryItem(QStringLiteral("limit"), QString::number(limit));
+
+    return doBatchSearch(addresses, queryItems, bounds);
+}
+
+QGeoCodeBatchReply *QGeoCodingManagerEngineMapbox::reverseGeocodeBatch(const QList<QGeoCoordinate> &coordinates, const QGeoShape &bounds)
+{
+    QStringList requests;
+    requests.reserve(coordinates.size());
+    for (const QGeoCoordinate &coordinate : coordinates)
+        requests.append(QString::number(coordinate.longitude()) + QLatin1Char(',') + QString::number(coordinate.latitude()));
+
+    QUrlQuery queryItems;
+    queryItems.addQueryItem(QStringLiteral("limit"), QString::number(1));
+
+    return doBatchSearch(requests, queryItems, bounds);
+}
+
+void QGeoCodingManagerEngineMapbox::addCommonQueryItems(QUrlQuery &queryItems, const QGeoShape &bounds) const
 {
     queryItems.addQueryItem(QStringLiteral("access_token"), m_accessToken);
 
@@ -171,6 +233,11 @@ QGeoCodeReply *QGeoCodingManagerEngineMapbox::doSearch(const QString &request, Q
                 QString::number(boundingBox.bottomRight().longitude()) + QLatin1Char(',') +
                 QString::number(boundingBox.topLeft().latitude()));
     }
+}
+
+QGeoCodeReply *QGeoCodingManagerEngineMapbox::doSearch(const QString &request, QUrlQuery &queryItems, const QGeoShape &bounds)
+{
+    addCommonQueryItems(queryItems, bounds);
 
     QUrl requestUrl(m_urlPrefix + request + QStringLiteral(".json"));
     requestUrl.setQuery(queryItems);
@@ -188,6 +255,38 @@ QGeoCodeReply *QGeoCodingManagerEngineMapbox::doSearch(const QString &request, Q
     return reply;
 }
 
+QGeoCodeBatchReply *QGeoCodingManagerEngineMapbox::doBatchSearch(const QStringList &requests, QUrlQuery &queryItems, const QGeoShape &bounds)
+{
+    if (!m_isEnterprise || requests.isEmpty())
+        return nullptr;
+
+    addCommonQueryItems(queryItems, bounds);
+
+    QList<QNetworkReply *> networkReplies;
+    for (int first = 0; first < requests.size(); first += maxBatchSize) {
+        QStringList chunk = requests.mid(first, maxBatchSize);
+        // Semicolons separate the queries of a batch.
+        for (QString &request : chunk)
+            request.replace(QLatin1Char(';'), QLatin1Char(','));
+
+        QUrl requestUrl(m_urlPrefix + chunk.join(QLatin1Char(';')) + QStringLiteral(".json"));
+        requestUrl.setQuery(queryItems);
+
+        QNetworkRequest networkRequest(requestUrl);
+        networkRequest.setHeader(QNetworkRequest::UserAgentHeader, m_userAgent);
+        networkReplies.append(m_networkManager->get(networkRequest));
+    }
+
+    QGeoCodeBatchReplyMapbox *reply = new QGeoCodeBatchReplyMapbox(networkReplies, requests.size(),
+                                                                   maxBatchSize, this);
+
+    connect(reply, &QGeoCodeReply::finished, this, &QGeoCodingManagerEngineMapbox::onReplyFinished);
+    connect(reply, QOverload<QGeoCodeReply::Error, const QString &>::of(&QGeoCodeReply::error),
+            this, &QGeoCodingManagerEngineMapbox::onReplyError);
+
+    return reply;
+}
+
 void QGeoCodingManagerEngineMapbox::onReplyFinished()
 {
     QGeoCodeReply *reply = qobject_cast<QGeoCodeReply *>(sender());
@@ -44,14 +44,16 @@
 #include <QtLocation/QGeoServiceProvider>
 #include <QtLocation/QGeoCodingManagerEngine>
 #include <QtLocation/QGeoCodeReply>
+#include <QtLocation/private/qgeocodingbatchengine_p.h>
 
 QT_BEGIN_NAMESPACE
 
 class QNetworkAccessManager;
 
-class QGeoCodingManagerEngineMapbox : public QGeoCodingManagerEngine
+class QGeoCodingManagerEngineMapbox : public QGeoCodingManagerEngine, public QGeoCodingBatchEngine
 {
     Q_OBJECT
+    Q_INTERFACES(QGeoCodingBatchEngine)
 
 public:
     QGeoCodingManagerEngineMapbox(const QVariantMap &parameters, QGeoServiceProvider::Error *error,
@@ -64,12 +66,21 @@ public:
     QGeoCodeReply *reverseGeocode(const QGeoCoordinate &coordinate,
                                   const QGeoShape &bounds) override;
 
+    QGeoCodeBatchReply *geocodeBatch(const QList<QGeoAddress> &addresses,
+                                     const QGeoShape &bounds) override;
+    QGeoCodeBatchReply *geocodeBatch(const QStringList &addresses, int limit,
+                                     const QGeoShape &bounds) override;
+    QGeoCodeBatchReply *reverseGeocodeBatch(const QList<QGeoCoordinate> &coordinates,
+                                            const QGeoShape &bounds) override;
+
 private slots:
     void onReplyFinished();
     void onReplyError(QGeoCodeReply::Error errorCode, const QString &errorString);
 
 private:
     QGeoCodeReply *doSearch(const QString &, QUrlQuery &, const QGeoShape &bounds);
+    QGeoCodeBatchReply *doBatchSearch(const QStringList &, QUrlQuery &, const QGeoShape &bounds);
+    void addCommonQueryItems(QUrlQuery &queryItems, const QGeoShape &bounds) const;
 
     QNetworkAccessManager *m_networkManager;
     QByteArray m_userAgent;
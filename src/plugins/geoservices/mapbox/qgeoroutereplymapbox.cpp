@@ -122,35 +122,14 @@ void QGeoRouteReplyMapbox::networkReplyFinished()
     QGeoRoutingManagerEngineMapbox *engine = qobject_cast<QGeoRoutingManagerEngineMapbox *>(parent());
     const QGeoRouteParser *parser = engine->routeParser();
 
-    QList<QGeoRoute> routes;
-    QString errorString;
-
-    QByteArray routeReply = reply->readAll();
-    QGeoRouteReply::Error error = parser->parseReply(routes, errorString, routeReply);
-    // Setting the request into the result
-    for (QGeoRoute &route : routes) {
-        route.setRequest(request());
-        for (QGeoRoute &leg: route.routeLegs()) {
-            leg.setRequest(request());
-        }
-    }
-
-    QVariantMap metadata;
-    metadata["osrm.reply-json"] = routeReply;
-
-    QList<QGeoRoute> mapboxRoutes;
-    for (const QGeoRoute &route : routes.mid(0, request().numberAlternativeRoutes() + 1)) {
-        QGeoRouteMapbox mapboxRoute(route, metadata);
-        mapboxRoutes.append(mapboxRoute);
-    }
-
-    if (error == QGeoRouteReply::NoError) {
-        setRoutes(mapboxRoutes);
-        // setError(QGeoRouteReply::NoError, status);  // can't do this, or NoError is emitted and does damages
-        setFinished(true);
-    } else {
-        setError(error, errorString);
-    }
+    const QByteArray routeReply = reply->readAll();
+    parser->parseReplyAsync(this, routeReply, [routeReply](QList<QGeoRoute> &routes) {
+        QVariantMap metadata;
+        metadata["osrm.reply-json"] = routeReply;
+
+        for (QGeoRoute &route : routes)
+            route = QGeoRouteMapbox(route, metadata);
+    });
 }
 
 void QGeoRouteReplyMapbox::networkReplyError(QNetworkReply::NetworkError error)
@@ -150,6 +150,14 @@ QGeoTiledMappingManagerEngineMapbox::QGeoTiledMappingManagerEngineMapbox(const Q
         const QString token = parameters.value(QStringLiteral("mapbox.access_token")).toString();
         tileFetcher->setAccessToken(token);
     }
+    if (parameters.contains(QStringLiteral("mapbox.mapping.max_requests_per_host"))) {
+        bool ok = false;
+        const int count = parameters.value(QStringLiteral("mapbox.mapping.max_requests_per_host")).toString().toInt(&ok);
+        if (ok)
+            tileFetcher->setMaximumRequestsPerHost(count);
+    }
+    if (parameters.contains(QStringLiteral("mapbox.mapping.http2")))
+        tileFetcher->setHttp2Enabled(parameters.value(QStringLiteral("mapbox.mapping.http2")).toBool());
 
     setTileFetcher(tileFetcher);
 
@@ -183,7 +191,7 @@ QGeoTiledMappingManagerEngineMapbox::QGeoTiledMappingManagerEngineMapbox(const Q
     }
     if (parameters.contains(QStringLiteral("mapbox.mapping.cache.disk.size"))) {
         bool ok = false;
-        int cacheSize = parameters.value(QStringLiteral("mapbox.mapping.cache.disk.size")).toString().toInt(&ok);
+        qint64 cacheSize = parameters.value(QStringLiteral("mapbox.mapping.cache.disk.size")).toString().toLongLong(&ok);
         if (ok)
             tileCache->setMaxDiskUsage(cacheSize);
     } else {
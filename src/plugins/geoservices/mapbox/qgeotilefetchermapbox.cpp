@@ -86,6 +86,7 @@ QGeoTiledMapReply *QGeoTileFetcherMapbox::getTileImage(const QGeoTileSpec &spec)
 {
     QNetworkRequest request;
     request.setRawHeader("User-Agent", m_userAgent);
+    prepareTileRequest(spec, &request);
 
     request.setUrl(QUrl(mapboxTilesApiPath +
                         ((spec.mapId() >= m_mapIds.size()) ? QStringLiteral("mapbox.streets") : m_mapIds[spec.mapId() - 1]) + QLatin1Char('/') +
@@ -101,4 +102,11 @@ QGeoTiledMapReply *QGeoTileFetcherMapbox::getTileImage(const QGeoTileSpec &spec)
     return new QGeoMapReplyMapbox(reply, spec, m_replyFormat);
 }
 
+QString QGeoTileFetcherMapbox::tileHost(const QGeoTileSpec &spec) const
+{
+    Q_UNUSED(spec);
+    static const QString host = QUrl(mapboxTilesApiPath).host();
+    return host;
+}
+
 QT_END_NAMESPACE
@@ -57,6 +57,9 @@ public:
     void setFormat(const QString &format);
     void setAccessToken(const QString &accessToken);
 
+protected:
+    QString tileHost(const QGeoTileSpec &spec) const override;
+
 private:
     QGeoTiledMapReply *getTileImage(const QGeoTileSpec &spec);
 
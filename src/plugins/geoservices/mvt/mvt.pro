@@ -0,0 +1,34 @@
+TARGET = qtgeoservices_mvt
+
+QT += location-private positioning-private network
+
+HEADERS += \
+    qgeoserviceproviderpluginmvt.h \
+    qgeotiledmappingmanagerenginemvt.h \
+    qgeotilefetchermvt.h \
+    qgeomapreplymvt.h \
+    qgeofiletilecachemvt.h \
+    qgeomvttile.h \
+    qgeomvtstyle.h \
+    qgeomvtrenderer.h
+
+SOURCES += \
+    qgeoserviceproviderpluginmvt.cpp \
+    qgeotiledmappingmanagerenginemvt.cpp \
+    qgeotilefetchermvt.cpp \
+    qgeomapreplymvt.cpp \
+    qgeofiletilecachemvt.cpp \
+    qgeomvttile.cpp \
+    qgeomvtstyle.cpp \
+    qgeomvtrenderer.cpp
+
+RESOURCES += \
+    mvt.qrc
+
+OTHER_FILES += \
+    mvt_plugin.json \
+    style.json
+
+PLUGIN_TYPE = geoservices
+PLUGIN_CLASS_NAME = QGeoServiceProviderFactoryMvt
+load(qt_plugin)
@@ -0,0 +1,100 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeofiletilecachemvt.h"
+
+QT_BEGIN_NAMESPACE
+
+QGeoFileTileCacheMvt::QGeoFileTileCacheMvt(const QString &directory, QObject *parent)
+    : QGeoFileTileCache(directory, parent)
+{
+}
+
+QGeoFileTileCacheMvt::~QGeoFileTileCacheMvt()
+{
+}
+
+/*
+    Only rendered tiles are returned. Tiles whose payload is cached but not
+    rendered are missing, so that they are requested from the fetcher,
+    which renders them from the cache on a worker thread.
+*/
+QSharedPointer<QGeoTileTexture> QGeoFileTileCacheMvt::get(const QGeoTileSpec &spec)
+{
+    return textureCache_.object(spec);
+}
+
+/*
+    The image rendered for the tile by the fetcher goes into the texture
+    cache with the payload. A payload that was read from the cache to be
+    rendered is not written again.
+*/
+void QGeoFileTileCacheMvt::insert(const QGeoTileSpec &spec,
+                                  const QByteArray &bytes,
+                                  const QString &format,
+                                  QAbstractGeoTileCache::CacheAreas areas)
+{
+    const Rendered rendered = m_rendered.take(spec);
+    if (!rendered.payloadCached)
+        QGeoFileTileCache::insert(spec, bytes, format, areas);
+    else
+        releaseTileFetch(spec);
+    if (!rendered.image.isNull())
+        addToTextureCache(spec, rendered.image);
+}
+
+/*
+    Sets the \a image rendered for tile \a spec, to be added to the texture
+    cache when the tile is inserted. Called by the fetcher, which lives on
+    the thread of the engine, just before the tile is inserted.
+*/
+void QGeoFileTileCacheMvt::setRendered(const QGeoTileSpec &spec, const QImage &image, bool payloadCached)
+{
+    Rendered &rendered = m_rendered[spec];
+    rendered.image = image;
+    rendered.payloadCached = payloadCached;
+}
+
+/*
+    Drops the image rendered for tile \a spec if the tile was not inserted,
+    as happens when it is only fetched for a region download.
+*/
+void QGeoFileTileCacheMvt::dropRendered(const QGeoTileSpec &spec)
+{
+    m_rendered.remove(spec);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,78 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOFILETILECACHEMVT_H
+#define QGEOFILETILECACHEMVT_H
+
+#include <QtLocation/private/qgeofiletilecache_p.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Caches the vector payload of the tiles on disk and in memory, and the
+    images rendered from it as textures. Restyling or rendering at another
+    pixel ratio only needs the payload, so it does not fetch tiles again.
+*/
+class QGeoFileTileCacheMvt : public QGeoFileTileCache
+{
+    Q_OBJECT
+
+public:
+    QGeoFileTileCacheMvt(const QString &directory = QString(), QObject *parent = 0);
+    ~QGeoFileTileCacheMvt();
+
+    QSharedPointer<QGeoTileTexture> get(const QGeoTileSpec &spec) override;
+    void insert(const QGeoTileSpec &spec,
+                const QByteArray &bytes,
+                const QString &format,
+                QAbstractGeoTileCache::CacheAreas areas = QAbstractGeoTileCache::AllCaches) override;
+
+    void setRendered(const QGeoTileSpec &spec, const QImage &image, bool payloadCached);
+    void dropRendered(const QGeoTileSpec &spec);
+
+private:
+    struct Rendered
+    {
+        QImage image;
+        bool payloadCached = false;
+    };
+
+    QHash<QGeoTileSpec, Rendered> m_rendered;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOFILETILECACHEMVT_H
@@ -0,0 +1,157 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeomapreplymvt.h"
+#include "qgeomvtrenderer.h"
+
+#include <QtLocation/private/qgeotilespec_p.h>
+#include <QtLocation/private/qabstractgeotilecache_p.h>
+#include <QtLocation/private/qgeoparsetask_p.h>
+
+QT_BEGIN_NAMESPACE
+
+static const QString payloadFormat = QStringLiteral("pbf");
+
+/*
+    Fetches the payload of a tile with \a reply and renders it.
+*/
+QGeoMapReplyMvt::QGeoMapReplyMvt(QNetworkReply *reply,
+                                 const QGeoTileSpec &spec,
+                                 const QSharedPointer<const QGeoMvtRenderer> &renderer,
+                                 QObject *parent)
+:   QGeoTiledMapReply(spec, parent), m_renderer(renderer)
+{
+    if (!reply) {
+        setError(UnknownError, QStringLiteral("Null reply"));
+        return;
+    }
+    connect(reply, SIGNAL(finished()), this, SLOT(networkReplyFinished()));
+    connect(reply, SIGNAL(error(QNetworkReply::NetworkError)),
+            this, SLOT(networkReplyError(QNetworkReply::NetworkError)));
+    connect(this, &QGeoTiledMapReply::aborted, reply, &QNetworkReply::abort);
+    connect(this, &QObject::destroyed, reply, &QObject::deleteLater);
+    setMapImageFormat(payloadFormat);
+}
+
+/*
+    Renders the cached \a payload of a tile.
+*/
+QGeoMapReplyMvt::QGeoMapReplyMvt(const QByteArray &payload,
+                                 const QGeoTileSpec &spec,
+                                 const QSharedPointer<const QGeoMvtRenderer> &renderer,
+                                 QObject *parent)
+:   QGeoTiledMapReply(spec, parent), m_renderer(renderer)
+{
+    setCached(true);
+    setMapImageFormat(payloadFormat);
+    render(payload);
+}
+
+QGeoMapReplyMvt::~QGeoMapReplyMvt()
+{
+}
+
+/*
+    Returns the image rendered from the payload, once finished.
+*/
+QImage QGeoMapReplyMvt::image() const
+{
+    return m_image;
+}
+
+void QGeoMapReplyMvt::networkReplyFinished()
+{
+    QNetworkReply *reply = static_cast<QNetworkReply *>(sender());
+    reply->deleteLater();
+
+    if (reply->error() != QNetworkReply::NoError) // Already handled in networkReplyError
+        return;
+
+    setMetadata(QGeoTileMetadata::fromNetworkReply(reply));
+
+    // Answer to a revalidation: the cached tile is still current.
+    if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 304) {
+        setNotModified(true);
+        setFinished(true);
+        return;
+    }
+
+    render(reply->readAll());
+}
+
+void QGeoMapReplyMvt::networkReplyError(QNetworkReply::NetworkError error)
+{
+    QNetworkReply *reply = static_cast<QNetworkReply *>(sender());
+    reply->deleteLater();
+    if (error == QNetworkReply::OperationCanceledError)
+        setFinished(true);
+    else
+        setError(QGeoTiledMapReply::CommunicationError, reply->errorString());
+}
+
+/*
+    Decodes and rasterizes \a payload on the thread pool. The reply is
+    finished with the payload as its data, for the cache, and the rendered
+    image.
+*/
+void QGeoMapReplyMvt::render(const QByteArray &payload)
+{
+    struct Result
+    {
+        QImage image;
+        QString errorString;
+    };
+    QSharedPointer<Result> result(new Result);
+
+    const QSharedPointer<const QGeoMvtRenderer> renderer = m_renderer;
+    const int zoom = tileSpec().zoom();
+    const QGeoParseTask::Handle task = QGeoParseTask::start(this,
+        [payload, renderer, zoom, result]() {
+            result->image = renderer->render(payload, zoom, &result->errorString);
+        },
+        [this, payload, result]() {
+            if (result->image.isNull()) {
+                setError(QGeoTiledMapReply::ParseError, result->errorString);
+                return;
+            }
+            m_image = result->image;
+            setMapImageData(payload);
+            setFinished(true);
+        });
+    connect(this, &QGeoTiledMapReply::aborted, this, [task]() { task.cancel(); });
+}
+
+QT_END_NAMESPACE
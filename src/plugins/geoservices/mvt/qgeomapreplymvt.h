@@ -0,0 +1,75 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOMAPREPLYMVT_H
+#define QGEOMAPREPLYMVT_H
+
+#include <QtCore/QSharedPointer>
+#include <QtGui/QImage>
+#include <QtNetwork/QNetworkReply>
+#include <QtLocation/private/qgeotiledmapreply_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoMvtRenderer;
+
+class QGeoMapReplyMvt : public QGeoTiledMapReply
+{
+    Q_OBJECT
+
+public:
+    QGeoMapReplyMvt(QNetworkReply *reply, const QGeoTileSpec &spec,
+                    const QSharedPointer<const QGeoMvtRenderer> &renderer, QObject *parent = 0);
+    QGeoMapReplyMvt(const QByteArray &payload, const QGeoTileSpec &spec,
+                    const QSharedPointer<const QGeoMvtRenderer> &renderer, QObject *parent = 0);
+    ~QGeoMapReplyMvt();
+
+    QImage image() const;
+
+private Q_SLOTS:
+    void networkReplyFinished();
+    void networkReplyError(QNetworkReply::NetworkError error);
+
+private:
+    void render(const QByteArray &payload);
+
+    QSharedPointer<const QGeoMvtRenderer> m_renderer;
+    QImage m_image;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOMAPREPLYMVT_H
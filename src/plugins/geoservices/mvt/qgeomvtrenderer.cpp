@@ -0,0 +1,175 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeomvtrenderer.h"
+#include "qgeomvttile.h"
+
+#include <QtGui/QFontDatabase>
+#include <QtGui/QFontMetricsF>
+#include <QtGui/QPainter>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Tiles are rendered \a tileSize pixels wide, times \a pixelRatio, which
+    also scales the widths and sizes in the style. Labels are only drawn if
+    the platform can render text on worker threads.
+*/
+QGeoMvtRenderer::QGeoMvtRenderer(const QGeoMvtStyle &style, int tileSize, qreal pixelRatio)
+    : m_style(style),
+      m_tileSize(tileSize),
+      m_pixelRatio(pixelRatio),
+      m_labels(QFontDatabase::supportsThreadedFontRendering())
+{
+}
+
+QGeoMvtStyle QGeoMvtRenderer::style() const
+{
+    return m_style;
+}
+
+int QGeoMvtRenderer::tileSize() const
+{
+    return m_tileSize;
+}
+
+qreal QGeoMvtRenderer::pixelRatio() const
+{
+    return m_pixelRatio;
+}
+
+QImage QGeoMvtRenderer::render(const QByteArray &data, int zoom, QString *errorString) const
+{
+    QGeoMvtTile tile;
+    if (!tile.decode(data, errorString))
+        return QImage();
+    return render(tile, zoom);
+}
+
+QImage QGeoMvtRenderer::render(const QGeoMvtTile &tile, int zoom) const
+{
+    const int size = qRound(m_tileSize * m_pixelRatio);
+    QImage image(size, size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(m_style.background.isValid() ? m_style.background : QColor(Qt::transparent));
+
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    for (const QGeoMvtStyle::Layer &style : m_style.layers) {
+        if (!style.isVisible(zoom))
+            continue;
+        const QGeoMvtLayer *layer = tile.layer(style.sourceLayer);
+        if (!layer)
+            continue;
+
+        const qreal scale = qreal(size) / layer->extent;
+        painter.setOpacity(style.opacity);
+
+        switch (style.type) {
+        case QGeoMvtStyle::Layer::Fill:
+            painter.setBrush(style.color);
+            if (style.outlineColor.isValid())
+                painter.setPen(QPen(style.outlineColor, m_pixelRatio));
+            else
+                painter.setPen(Qt::NoPen);
+            for (const QGeoMvtFeature &feature : layer->features) {
+                if (feature.type == QGeoMvtFeature::Polygon && style.matches(*layer, feature))
+                    painter.drawPath(feature.path(scale));
+            }
+            break;
+
+        case QGeoMvtStyle::Layer::Line: {
+            QPen pen(style.color, style.width.at(zoom) * m_pixelRatio, Qt::SolidLine,
+                     Qt::RoundCap, Qt::RoundJoin);
+            if (!style.dashes.isEmpty())
+                pen.setDashPattern(style.dashes);
+            painter.setPen(pen);
+            painter.setBrush(Qt::NoBrush);
+            for (const QGeoMvtFeature &feature : layer->features) {
+                if (feature.type != QGeoMvtFeature::LineString && feature.type != QGeoMvtFeature::Polygon)
+                    continue;
+                if (style.matches(*layer, feature))
+                    painter.drawPath(feature.path(scale));
+            }
+            break;
+        }
+
+        case QGeoMvtStyle::Layer::Circle: {
+            const qreal radius = style.radius.at(zoom) * m_pixelRatio;
+            painter.setPen(Qt::NoPen);
+            painter.setBrush(style.color);
+            for (const QGeoMvtFeature &feature : layer->features) {
+                if (feature.type != QGeoMvtFeature::Point || !style.matches(*layer, feature))
+                    continue;
+                for (const QPointF &point : feature.points(scale))
+                    painter.drawEllipse(point, radius, radius);
+            }
+            break;
+        }
+
+        case QGeoMvtStyle::Layer::Symbol: {
+            if (!m_labels || style.textField.isEmpty())
+                break;
+            QFont font;
+            font.setPixelSize(qMax(1, qRound(style.textSize.at(zoom) * m_pixelRatio)));
+            const QFontMetricsF metrics(font);
+            const QPen halo(style.haloColor, 2 * m_pixelRatio, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin);
+            for (const QGeoMvtFeature &feature : layer->features) {
+                if (feature.type != QGeoMvtFeature::Point || !style.matches(*layer, feature))
+                    continue;
+                const QString text = layer->property(feature, style.textField).toString();
+                if (text.isEmpty())
+                    continue;
+                const qreal width = metrics.horizontalAdvance(text);
+                for (const QPointF &point : feature.points(scale)) {
+                    // Centered on the point. Labels crossing the tile edge are cut off.
+                    QPainterPath path;
+                    path.addText(point.x() - width / 2, point.y() + (metrics.ascent() - metrics.descent()) / 2,
+                                 font, text);
+                    if (style.haloColor.isValid())
+                        painter.strokePath(path, halo);
+                    painter.fillPath(path, style.color);
+                }
+            }
+            break;
+        }
+        }
+    }
+
+    return image;
+}
+
+QT_END_NAMESPACE
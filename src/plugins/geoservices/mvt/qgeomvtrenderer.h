@@ -0,0 +1,74 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOMVTRENDERER_H
+#define QGEOMVTRENDERER_H
+
+#include "qgeomvtstyle.h"
+
+#include <QtGui/QImage>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoMvtTile;
+
+/*
+    Rasterizes vector tiles with QPainter according to a style. Rendering
+    does not touch the renderer, so one renderer can be used from many
+    threads at once.
+*/
+class QGeoMvtRenderer
+{
+public:
+    QGeoMvtRenderer(const QGeoMvtStyle &style, int tileSize, qreal pixelRatio = 1.0);
+
+    QGeoMvtStyle style() const;
+    int tileSize() const;
+    qreal pixelRatio() const;
+
+    QImage render(const QGeoMvtTile &tile, int zoom) const;
+    QImage render(const QByteArray &data, int zoom, QString *errorString = nullptr) const;
+
+private:
+    QGeoMvtStyle m_style;
+    int m_tileSize;
+    qreal m_pixelRatio;
+    bool m_labels;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOMVTRENDERER_H
@@ -0,0 +1,184 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeomvtstyle.h"
+#include "qgeomvttile.h"
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+static QGeoMvtStyle::Function parseFunction(const QJsonValue &value, qreal defaultValue)
+{
+    if (value.isDouble())
+        return QGeoMvtStyle::Function(value.toDouble());
+
+    const QJsonArray stops = value.toObject().value(QStringLiteral("stops")).toArray();
+    if (stops.isEmpty())
+        return QGeoMvtStyle::Function(defaultValue);
+
+    QGeoMvtStyle::Function function;
+    function.stops.clear();
+    for (const QJsonValue &stop : stops) {
+        const QJsonArray pair = stop.toArray();
+        function.stops.append(QPointF(pair.at(0).toDouble(), pair.at(1).toDouble()));
+    }
+    std::sort(function.stops.begin(), function.stops.end(), [](const QPointF &a, const QPointF &b) {
+        return a.x() < b.x();
+    });
+    return function;
+}
+
+static QColor parseColor(const QJsonValue &value)
+{
+    return value.isString() ? QColor(value.toString()) : QColor();
+}
+
+qreal QGeoMvtStyle::Function::at(qreal zoom) const
+{
+    if (zoom <= stops.first().x())
+        return stops.first().y();
+    for (int i = 1; i < stops.size(); ++i) {
+        const QPointF &upper = stops.at(i);
+        if (zoom < upper.x()) {
+            const QPointF &lower = stops.at(i - 1);
+            return lower.y() + (upper.y() - lower.y()) * (zoom - lower.x()) / (upper.x() - lower.x());
+        }
+    }
+    return stops.last().y();
+}
+
+bool QGeoMvtStyle::Layer::isVisible(int zoom) const
+{
+    return zoom >= minZoom && zoom <= maxZoom;
+}
+
+/*
+    Returns whether \a feature of \a layer passes the filter. The geometry
+    type of the feature is matched with the "$type" key.
+*/
+bool QGeoMvtStyle::Layer::matches(const QGeoMvtLayer &layer, const QGeoMvtFeature &feature) const
+{
+    static const QString typeKey = QStringLiteral("$type");
+    static const QVariant typeNames[] = {
+        QVariant(), QStringLiteral("Point"), QStringLiteral("LineString"), QStringLiteral("Polygon")
+    };
+
+    for (auto it = filter.cbegin(), end = filter.cend(); it != end; ++it) {
+        const QVariant value = it.key() == typeKey ? typeNames[feature.type]
+                                                   : layer.property(feature, it.key());
+        if (!value.isValid() || !it.value().contains(value))
+            return false;
+    }
+    return true;
+}
+
+/*
+    Reads a style from \a json, replacing this one. Returns false, setting
+    \a errorString, if it is not a valid style.
+*/
+bool QGeoMvtStyle::load(const QByteArray &json, QString *errorString)
+{
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(json, &parseError);
+    if (!document.isObject()) {
+        if (errorString)
+            *errorString = parseError.errorString();
+        return false;
+    }
+
+    const QJsonObject root = document.object();
+    background = parseColor(root.value(QStringLiteral("background")));
+    layers.clear();
+
+    const QJsonArray layerArray = root.value(QStringLiteral("layers")).toArray();
+    for (const QJsonValue &value : layerArray) {
+        const QJsonObject object = value.toObject();
+        Layer layer;
+        layer.sourceLayer = object.value(QStringLiteral("source-layer")).toString();
+
+        const QString type = object.value(QStringLiteral("type")).toString();
+        if (type == QLatin1String("fill")) {
+            layer.type = Layer::Fill;
+        } else if (type == QLatin1String("line")) {
+            layer.type = Layer::Line;
+        } else if (type == QLatin1String("circle")) {
+            layer.type = Layer::Circle;
+        } else if (type == QLatin1String("symbol")) {
+            layer.type = Layer::Symbol;
+        } else {
+            if (errorString)
+                *errorString = QStringLiteral("Unknown style layer type \"%1\"").arg(type);
+            return false;
+        }
+
+        layer.minZoom = object.value(QStringLiteral("minzoom")).toInt(layer.minZoom);
+        layer.maxZoom = object.value(QStringLiteral("maxzoom")).toInt(layer.maxZoom);
+
+        const QJsonObject filter = object.value(QStringLiteral("filter")).toObject();
+        for (auto it = filter.constBegin(), end = filter.constEnd(); it != end; ++it) {
+            QVariantList values;
+            if (it.value().isArray())
+                values = it.value().toArray().toVariantList();
+            else
+                values.append(it.value().toVariant());
+            layer.filter.insert(it.key(), values);
+        }
+
+        layer.color = parseColor(object.value(QStringLiteral("color")));
+        if (!layer.color.isValid())
+            layer.color = Qt::black;
+        layer.outlineColor = parseColor(object.value(QStringLiteral("outline-color")));
+        layer.haloColor = parseColor(object.value(QStringLiteral("halo-color")));
+        layer.opacity = object.value(QStringLiteral("opacity")).toDouble(layer.opacity);
+        layer.width = parseFunction(object.value(QStringLiteral("width")), 1);
+        layer.radius = parseFunction(object.value(QStringLiteral("radius")), 3);
+        layer.textField = object.value(QStringLiteral("text-field")).toString();
+        layer.textSize = parseFunction(object.value(QStringLiteral("text-size")), 12);
+        const QJsonArray dashes = object.value(QStringLiteral("dash")).toArray();
+        for (const QJsonValue &dash : dashes)
+            layer.dashes.append(dash.toDouble());
+
+        layers.append(layer);
+    }
+    return true;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,108 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOMVTSTYLE_H
+#define QGEOMVTSTYLE_H
+
+#include <QtCore/QHash>
+#include <QtCore/QPointF>
+#include <QtCore/QString>
+#include <QtCore/QVariant>
+#include <QtCore/QVector>
+#include <QtGui/QColor>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoMvtLayer;
+class QGeoMvtFeature;
+
+/*
+    How to draw the layers of vector tiles: a simplified form of the Mapbox
+    GL style specification, with the layers drawn in order, each from one
+    layer of the tiles.
+*/
+class QGeoMvtStyle
+{
+public:
+    // A value that is constant or interpolated linearly between zoom levels.
+    class Function
+    {
+    public:
+        Function(qreal value = 0) { stops.append(QPointF(0, value)); }
+        qreal at(qreal zoom) const;
+
+        QVector<QPointF> stops;    // zoom level, value
+    };
+
+    class Layer
+    {
+    public:
+        enum Type {
+            Fill,
+            Line,
+            Circle,
+            Symbol
+        };
+
+        bool isVisible(int zoom) const;
+        bool matches(const QGeoMvtLayer &layer, const QGeoMvtFeature &feature) const;
+
+        QString sourceLayer;
+        Type type = Fill;
+        int minZoom = 0;
+        int maxZoom = 24;
+        // Properties the features must have, with one of the values listed.
+        QHash<QString, QVariantList> filter;
+        QColor color;
+        QColor outlineColor;
+        QColor haloColor;
+        qreal opacity = 1;
+        Function width = 1;
+        Function radius = 3;
+        QVector<qreal> dashes;
+        QString textField;
+        Function textSize = 12;
+    };
+
+    bool load(const QByteArray &json, QString *errorString = nullptr);
+
+    QColor background;
+    QVector<Layer> layers;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOMVTSTYLE_H
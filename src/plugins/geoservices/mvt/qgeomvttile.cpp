@@ -0,0 +1,430 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeomvttile.h"
+
+#include <cstring>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+enum WireType {
+    Varint = 0,
+    Fixed64 = 1,
+    LengthDelimited = 2,
+    Fixed32 = 5
+};
+
+enum GeometryCommand {
+    MoveTo = 1,
+    LineTo = 2,
+    ClosePath = 7
+};
+
+/*
+    Reads the fields of a protocol buffers message in place, as much of
+    the format as vector tiles use. Any malformed input sets the error
+    flag and ends the message.
+*/
+class ProtobufReader
+{
+public:
+    ProtobufReader(const char *data, int size)
+        : m_data(reinterpret_cast<const uchar *>(data)), m_end(m_data + size) {}
+
+    bool next()
+    {
+        if (m_error || m_data == m_end)
+            return false;
+        const quint64 key = varint();
+        m_field = quint32(key >> 3);
+        m_wireType = int(key & 0x7);
+        return !m_error;
+    }
+
+    quint32 field() const { return m_field; }
+    int wireType() const { return m_wireType; }
+    bool hasError() const { return m_error; }
+
+    quint64 varint()
+    {
+        quint64 value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (m_data == m_end)
+                break;
+            const uchar byte = *m_data++;
+            value |= quint64(byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+                return value;
+        }
+        m_error = true;
+        return 0;
+    }
+
+    ProtobufReader message()
+    {
+        const char *data;
+        const int size = lengthDelimited(&data);
+        return ProtobufReader(data, size);
+    }
+
+    QString string()
+    {
+        const char *data;
+        const int size = lengthDelimited(&data);
+        return QString::fromUtf8(data, size);
+    }
+
+    // Repeated scalar fields may be packed or not, whatever the schema says.
+    void appendUInt32(QVector<quint32> *values)
+    {
+        if (m_wireType == Varint) {
+            values->append(quint32(varint()));
+            return;
+        }
+        ProtobufReader packed = message();
+        while (!packed.atEnd() && !packed.hasError())
+            values->append(quint32(packed.varint()));
+        m_error = m_error || packed.hasError();
+    }
+
+    float fixed32()
+    {
+        quint32 bits = 0;
+        if (!take(4))
+            return 0;
+        for (int i = 3; i >= 0; --i)
+            bits = (bits << 8) | m_data[i - 4];
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    double fixed64()
+    {
+        quint64 bits = 0;
+        if (!take(8))
+            return 0;
+        for (int i = 7; i >= 0; --i)
+            bits = (bits << 8) | m_data[i - 8];
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    void skip()
+    {
+        switch (m_wireType) {
+        case Varint:
+            varint();
+            break;
+        case Fixed64:
+            take(8);
+            break;
+        case LengthDelimited:
+            message();
+            break;
+        case Fixed32:
+            take(4);
+            break;
+        default:
+            m_error = true;
+            break;
+        }
+    }
+
+    bool atEnd() const { return m_data == m_end; }
+
+private:
+    int lengthDelimited(const char **data)
+    {
+        const quint64 size = varint();
+        if (m_error || size > quint64(m_end - m_data)) {
+            m_error = true;
+            *data = nullptr;
+            return 0;
+        }
+        *data = reinterpret_cast<const char *>(m_data);
+        m_data += size;
+        return int(size);
+    }
+
+    bool take(int size)
+    {
+        if (m_end - m_data < size) {
+            m_error = true;
+            return false;
+        }
+        m_data += size;
+        return true;
+    }
+
+    const uchar *m_data;
+    const uchar *m_end;
+    quint32 m_field = 0;
+    int m_wireType = 0;
+    bool m_error = false;
+};
+
+inline qint32 zigzag(quint32 value)
+{
+    return qint32(value >> 1) ^ -qint32(value & 1);
+}
+
+QVariant readValue(ProtobufReader reader)
+{
+    QVariant value;
+    while (reader.next()) {
+        switch (reader.field()) {
+        case 1:
+            value = reader.string();
+            break;
+        case 2:
+            value = reader.fixed32();
+            break;
+        case 3:
+            value = reader.fixed64();
+            break;
+        case 4:
+            value = qint64(reader.varint());
+            break;
+        case 5:
+            value = reader.varint();
+            break;
+        case 6: {
+            const quint64 bits = reader.varint();
+            value = qint64(bits >> 1) ^ -qint64(bits & 1);
+            break;
+        }
+        case 7:
+            value = reader.varint() != 0;
+            break;
+        default:
+            reader.skip();
+            break;
+        }
+    }
+    return value;
+}
+
+bool readFeature(ProtobufReader reader, QGeoMvtFeature *feature)
+{
+    while (reader.next()) {
+        switch (reader.field()) {
+        case 1:
+            feature->id = reader.varint();
+            break;
+        case 2:
+            reader.appendUInt32(&feature->tags);
+            break;
+        case 3: {
+            const quint64 type = reader.varint();
+            feature->type = type <= QGeoMvtFeature::Polygon ? QGeoMvtFeature::GeometryType(type)
+                                                            : QGeoMvtFeature::Unknown;
+            break;
+        }
+        case 4:
+            reader.appendUInt32(&feature->geometry);
+            break;
+        default:
+            reader.skip();
+            break;
+        }
+    }
+    return !reader.hasError();
+}
+
+bool readLayer(ProtobufReader reader, QGeoMvtLayer *layer)
+{
+    while (reader.next()) {
+        switch (reader.field()) {
+        case 1:
+            layer->name = reader.string();
+            break;
+        case 2: {
+            QGeoMvtFeature feature;
+            if (!readFeature(reader.message(), &feature))
+                return false;
+            layer->features.append(feature);
+            break;
+        }
+        case 3:
+            layer->keys.append(reader.string());
+            break;
+        case 4:
+            layer->values.append(readValue(reader.message()));
+            break;
+        case 5:
+            layer->extent = quint32(reader.varint());
+            break;
+        default:
+            reader.skip();
+            break;
+        }
+    }
+    if (layer->extent == 0)
+        return false;
+    return !reader.hasError();
+}
+
+}
+
+/*
+    Decodes \a data, a tile in the Mapbox Vector Tile format, replacing the
+    layers of this tile. Returns false, setting \a errorString, if the data
+    is not a valid vector tile. Compressed tiles have to be inflated first.
+*/
+bool QGeoMvtTile::decode(const QByteArray &data, QString *errorString)
+{
+    layers.clear();
+
+    ProtobufReader reader(data.constData(), data.size());
+    while (reader.next()) {
+        if (reader.field() != 3) {
+            reader.skip();
+            continue;
+        }
+        QGeoMvtLayer layer;
+        if (!readLayer(reader.message(), &layer)) {
+            if (errorString)
+                *errorString = QStringLiteral("Malformed layer in vector tile");
+            layers.clear();
+            return false;
+        }
+        layers.append(layer);
+    }
+
+    if (reader.hasError()) {
+        if (errorString)
+            *errorString = QStringLiteral("Malformed vector tile");
+        layers.clear();
+        return false;
+    }
+    return true;
+}
+
+const QGeoMvtLayer *QGeoMvtTile::layer(const QString &name) const
+{
+    for (const QGeoMvtLayer &layer : layers) {
+        if (layer.name == name)
+            return &layer;
+    }
+    return nullptr;
+}
+
+/*
+    Returns the value of property \a key of \a feature, or an invalid
+    variant if the feature does not have it.
+*/
+QVariant QGeoMvtLayer::property(const QGeoMvtFeature &feature, const QString &key) const
+{
+    for (int i = 0; i + 1 < feature.tags.size(); i += 2) {
+        const quint32 keyIndex = feature.tags.at(i);
+        if (keyIndex < quint32(keys.size()) && keys.at(int(keyIndex)) == key) {
+            const quint32 valueIndex = feature.tags.at(i + 1);
+            return valueIndex < quint32(values.size()) ? values.at(int(valueIndex)) : QVariant();
+        }
+    }
+    return QVariant();
+}
+
+/*
+    Returns the geometry of the feature as a path, with tile coordinates
+    multiplied by \a scale. Rings wind in opposite directions for holes, so
+    the path is filled with the winding rule.
+*/
+QPainterPath QGeoMvtFeature::path(qreal scale) const
+{
+    QPainterPath path;
+    path.setFillRule(Qt::WindingFill);
+
+    qint32 x = 0;
+    qint32 y = 0;
+    int i = 0;
+    while (i < geometry.size()) {
+        const quint32 command = geometry.at(i) & 0x7;
+        const int count = int(geometry.at(i) >> 3);
+        ++i;
+        if (command == ClosePath) {
+            path.closeSubpath();
+            continue;
+        }
+        if ((command != MoveTo && command != LineTo) || count > (geometry.size() - i) / 2)
+            break;
+        for (int n = 0; n < count; ++n) {
+            x += zigzag(geometry.at(i++));
+            y += zigzag(geometry.at(i++));
+            const QPointF point(x * scale, y * scale);
+            if (command == MoveTo)
+                path.moveTo(point);
+            else
+                path.lineTo(point);
+        }
+    }
+    return path;
+}
+
+/*
+    Returns the points of a point feature, with tile coordinates multiplied
+    by \a scale.
+*/
+QVector<QPointF> QGeoMvtFeature::points(qreal scale) const
+{
+    QVector<QPointF> points;
+
+    qint32 x = 0;
+    qint32 y = 0;
+    int i = 0;
+    while (i < geometry.size()) {
+        const quint32 command = geometry.at(i) & 0x7;
+        const int count = int(geometry.at(i) >> 3);
+        ++i;
+        if (command == ClosePath)
+            continue;
+        if ((command != MoveTo && command != LineTo) || count > (geometry.size() - i) / 2)
+            break;
+        for (int n = 0; n < count; ++n) {
+            x += zigzag(geometry.at(i++));
+            y += zigzag(geometry.at(i++));
+            if (command == MoveTo)
+                points.append(QPointF(x * scale, y * scale));
+        }
+    }
+    return points;
+}
+
+QT_END_NAMESPACE
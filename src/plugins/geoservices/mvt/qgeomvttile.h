@@ -0,0 +1,98 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOMVTTILE_H
+#define QGEOMVTTILE_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QPointF>
+#include <QtCore/QString>
+#include <QtCore/QVariant>
+#include <QtCore/QVector>
+#include <QtGui/QPainterPath>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    A feature of a Mapbox Vector Tile layer. Its geometry is kept encoded,
+    as drawing commands in tile coordinates, and only decoded when drawn.
+*/
+class QGeoMvtFeature
+{
+public:
+    enum GeometryType {
+        Unknown = 0,
+        Point = 1,
+        LineString = 2,
+        Polygon = 3
+    };
+
+    QPainterPath path(qreal scale) const;
+    QVector<QPointF> points(qreal scale) const;
+
+    quint64 id = 0;
+    GeometryType type = Unknown;
+    QVector<quint32> tags;      // key and value indexes into the layer, in pairs
+    QVector<quint32> geometry;
+};
+
+class QGeoMvtLayer
+{
+public:
+    QVariant property(const QGeoMvtFeature &feature, const QString &key) const;
+
+    QString name;
+    quint32 extent = 4096;
+    QVector<QString> keys;
+    QVector<QVariant> values;
+    QVector<QGeoMvtFeature> features;
+};
+
+class QGeoMvtTile
+{
+public:
+    bool decode(const QByteArray &data, QString *errorString = nullptr);
+    const QGeoMvtLayer *layer(const QString &name) const;
+
+    QVector<QGeoMvtLayer> layers;
+};
+
+Q_DECLARE_TYPEINFO(QGeoMvtFeature, Q_MOVABLE_TYPE);
+Q_DECLARE_TYPEINFO(QGeoMvtLayer, Q_MOVABLE_TYPE);
+
+QT_END_NAMESPACE
+
+#endif // QGEOMVTTILE_H
@@ -0,0 +1,173 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeotiledmappingmanagerenginemvt.h"
+#include "qgeotilefetchermvt.h"
+#include "qgeofiletilecachemvt.h"
+#include "qgeomvtrenderer.h"
+#include "qgeomvtstyle.h"
+
+#include <QtCore/QFile>
+#include <QtLocation/private/qgeocameracapabilities_p.h>
+#include <QtLocation/private/qgeomaptype_p.h>
+#include <QtLocation/private/qgeotiledmap_p.h>
+
+QT_BEGIN_NAMESPACE
+
+static const char pluginName[] = "mvt";
+
+QGeoTiledMappingManagerEngineMvt::QGeoTiledMappingManagerEngineMvt(const QVariantMap &parameters,
+                                                                   QGeoServiceProvider::Error *error,
+                                                                   QString *errorString)
+:   QGeoTiledMappingManagerEngine(), m_cache(0)
+{
+    const QString urlTemplate = parameters.value(QStringLiteral("mvt.mapping.url")).toString();
+    if (urlTemplate.isEmpty()) {
+        *error = QGeoServiceProvider::MissingRequiredParameterError;
+        *errorString = QStringLiteral("The mvt.mapping.url parameter is required for mapping");
+        return;
+    }
+
+    QString styleFile = QStringLiteral(":/mvt/style.json");
+    if (parameters.contains(QStringLiteral("mvt.mapping.style")))
+        styleFile = parameters.value(QStringLiteral("mvt.mapping.style")).toString();
+
+    QFile file(styleFile);
+    if (!file.open(QIODevice::ReadOnly)) {
+        *error = QGeoServiceProvider::NotSupportedError;
+        *errorString = QStringLiteral("Unable to open style %1: %2").arg(styleFile, file.errorString());
+        return;
+    }
+    QGeoMvtStyle style;
+    QString styleError;
+    if (!style.load(file.readAll(), &styleError)) {
+        *error = QGeoServiceProvider::NotSupportedError;
+        *errorString = QStringLiteral("Unable to load style %1: %2").arg(styleFile, styleError);
+        return;
+    }
+
+    qreal pixelRatio = 1.0;
+    if (parameters.contains(QStringLiteral("mvt.mapping.pixel_ratio"))) {
+        bool ok = false;
+        const qreal ratio = parameters.value(QStringLiteral("mvt.mapping.pixel_ratio")).toString().toDouble(&ok);
+        if (ok && ratio > 0)
+            pixelRatio = ratio;
+    }
+
+    QGeoCameraCapabilities cameraCaps;
+    cameraCaps.setMinimumZoomLevel(0.0);
+    cameraCaps.setMaximumZoomLevel(14.0);
+    cameraCaps.setSupportsBearing(true);
+    cameraCaps.setSupportsTilting(true);
+    cameraCaps.setMinimumTilt(0);
+    cameraCaps.setMaximumTilt(80);
+    cameraCaps.setMinimumFieldOfView(20.0);
+    cameraCaps.setMaximumFieldOfView(120.0);
+    cameraCaps.setOverzoomEnabled(true);
+    setCameraCapabilities(cameraCaps);
+
+    setTileSize(QSize(256, 256));
+
+    QList<QGeoMapType> mapTypes;
+    mapTypes << QGeoMapType(QGeoMapType::StreetMap, tr("Street Map"),
+                            tr("Street map rendered from vector tiles"), false, false, 1,
+                            QByteArray(pluginName), cameraCaps);
+    setSupportedMapTypes(mapTypes);
+
+    /* TILE CACHE */
+    QString cacheDirectory;
+    if (parameters.contains(QStringLiteral("mvt.mapping.cache.directory")))
+        cacheDirectory = parameters.value(QStringLiteral("mvt.mapping.cache.directory")).toString();
+    else
+        cacheDirectory = QAbstractGeoTileCache::baseLocationCacheDirectory() + QLatin1String(pluginName);
+
+    m_cache = new QGeoFileTileCacheMvt(cacheDirectory);
+    if (parameters.contains(QStringLiteral("mvt.mapping.cache.disk.size"))) {
+        bool ok = false;
+        const qint64 cacheSize = parameters.value(QStringLiteral("mvt.mapping.cache.disk.size")).toString().toLongLong(&ok);
+        if (ok)
+            m_cache->setMaxDiskUsage(cacheSize);
+    }
+    if (parameters.contains(QStringLiteral("mvt.mapping.cache.memory.size"))) {
+        bool ok = false;
+        const int cacheSize = parameters.value(QStringLiteral("mvt.mapping.cache.memory.size")).toString().toInt(&ok);
+        if (ok)
+            m_cache->setMaxMemoryUsage(cacheSize);
+    }
+    if (parameters.contains(QStringLiteral("mvt.mapping.cache.texture.size"))) {
+        bool ok = false;
+        const int cacheSize = parameters.value(QStringLiteral("mvt.mapping.cache.texture.size")).toString().toInt(&ok);
+        if (ok)
+            m_cache->setExtraTextureUsage(cacheSize);
+    }
+    setTileCache(m_cache);
+
+    /* TILE FETCHER */
+    QSharedPointer<const QGeoMvtRenderer> renderer(
+                new QGeoMvtRenderer(style, tileSize().width(), pixelRatio));
+    QGeoTileFetcherMvt *tileFetcher = new QGeoTileFetcherMvt(urlTemplate, renderer, m_cache, this);
+    if (parameters.contains(QStringLiteral("mvt.useragent"))) {
+        const QByteArray ua = parameters.value(QStringLiteral("mvt.useragent")).toString().toLatin1();
+        tileFetcher->setUserAgent(ua);
+    }
+    setTileFetcher(tileFetcher);
+
+    *error = QGeoServiceProvider::NoError;
+    errorString->clear();
+}
+
+QGeoTiledMappingManagerEngineMvt::~QGeoTiledMappingManagerEngineMvt()
+{
+}
+
+QGeoMap *QGeoTiledMappingManagerEngineMvt::createMap()
+{
+    return new QGeoTiledMap(this, 0);
+}
+
+/*
+    The rendered image of a tile that was only fetched for a region download
+    is not inserted, so it is dropped here.
+*/
+void QGeoTiledMappingManagerEngineMvt::engineTileFinished(const QGeoTileSpec &spec,
+                                                          const QByteArray &bytes,
+                                                          const QString &format)
+{
+    QGeoTiledMappingManagerEngine::engineTileFinished(spec, bytes, format);
+    m_cache->dropRendered(spec);
+}
+
+QT_END_NAMESPACE
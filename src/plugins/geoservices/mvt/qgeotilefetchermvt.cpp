@@ -0,0 +1,122 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeotilefetchermvt.h"
+#include "qgeomapreplymvt.h"
+#include "qgeofiletilecachemvt.h"
+
+#include <QtNetwork/QNetworkAccessManager>
+#include <QtNetwork/QNetworkRequest>
+#include <QtLocation/private/qgeotilespec_p.h>
+#include <QtLocation/private/qgeotiledmapreply_p.h>
+
+QT_BEGIN_NAMESPACE
+
+QGeoTileFetcherMvt::QGeoTileFetcherMvt(const QString &urlTemplate,
+                                       const QSharedPointer<const QGeoMvtRenderer> &renderer,
+                                       QGeoFileTileCacheMvt *cache,
+                                       QGeoMappingManagerEngine *parent)
+:   QGeoTileFetcher(parent), m_networkManager(new QNetworkAccessManager(this)),
+    m_urlTemplate(urlTemplate), m_userAgent("Qt Location based application"),
+    m_renderer(renderer), m_cache(cache)
+{
+}
+
+void QGeoTileFetcherMvt::setUserAgent(const QByteArray &userAgent)
+{
+    m_userAgent = userAgent;
+}
+
+QUrl QGeoTileFetcherMvt::tileAddress(const QGeoTileSpec &spec) const
+{
+    QString address = m_urlTemplate;
+    address.replace(QLatin1String("{z}"), QString::number(spec.zoom()));
+    address.replace(QLatin1String("{x}"), QString::number(spec.x()));
+    address.replace(QLatin1String("{y}"), QString::number(spec.y()));
+    return QUrl(address);
+}
+
+/*
+    Renders the payload of the tile from the cache when there is one, so
+    that only tiles never fetched, or being revalidated, go to the network.
+*/
+QGeoTiledMapReply *QGeoTileFetcherMvt::getTileImage(const QGeoTileSpec &spec)
+{
+    if (tileValidators(spec).isEmpty()) {
+        const QByteArray payload = m_cache->tileData(spec);
+        if (!payload.isEmpty())
+            return new QGeoMapReplyMvt(payload, spec, m_renderer);
+    }
+
+    QNetworkRequest request;
+    request.setHeader(QNetworkRequest::UserAgentHeader, m_userAgent);
+    request.setUrl(tileAddress(spec));
+    prepareTileRequest(spec, &request);
+    QNetworkReply *reply = m_networkManager->get(request);
+    return new QGeoMapReplyMvt(reply, spec, m_renderer);
+}
+
+QString QGeoTileFetcherMvt::tileHost(const QGeoTileSpec &spec) const
+{
+    return tileAddress(spec).host();
+}
+
+/*
+    Hands the rendered image to the cache before the payload reaches the
+    engine, which inserts the payload and looks the texture up. A payload
+    that came from the cache is not reported as fetched again, as that
+    would reset its metadata.
+*/
+void QGeoTileFetcherMvt::handleReply(QGeoTiledMapReply *reply, const QGeoTileSpec &spec)
+{
+    if (reply->error() != QGeoTiledMapReply::NoError || reply->isNotModified()) {
+        QGeoTileFetcher::handleReply(reply, spec);
+        return;
+    }
+
+    QGeoMapReplyMvt *mvtReply = static_cast<QGeoMapReplyMvt *>(reply);
+    m_cache->setRendered(spec, mvtReply->image(), reply->isCached());
+
+    if (!reply->isCached()) {
+        QGeoTileFetcher::handleReply(reply, spec);
+        return;
+    }
+
+    emit tileFinished(spec, reply->mapImageData(), reply->mapImageFormat());
+    reply->deleteLater();
+}
+
+QT_END_NAMESPACE
@@ -63,7 +63,14 @@ QPlaceSearchReplyHere::QPlaceSearchReplyHere(const QPlaceSearchRequest &request,
     }
     setRequest(request);
 
+    // The items of the first page are nested in a results object, those of
+    // the following pages are not. Either way they are reported as they
+    // arrive.
+    m_reader.addArrayPath(QStringList() << QStringLiteral("results") << QStringLiteral("items"));
+    m_reader.addArrayPath(QStringList() << QStringLiteral("items"));
+
     connect(reply, SIGNAL(finished()), this, SLOT(replyFinished()));
+    connect(reply, SIGNAL(readyRead()), this, SLOT(replyReadyRead()));
     connect(reply, SIGNAL(error(QNetworkReply::NetworkError)),
             this, SLOT(replyError(QNetworkReply::NetworkError)));
     connect(this, &QPlaceReply::aborted, reply, &QNetworkReply::abort);
@@ -90,8 +97,12 @@ void QPlaceSearchReplyHere::replyFinished()
     if (reply->error() != QNetworkReply::NoError)
         return;
 
-    QJsonDocument document = QJsonDocument::fromJson(reply->readAll());
-    if (!document.isObject()) {
+    readResults(reply);
+
+    // The items have been taken out of the document, what is left holds the
+    // links to the other pages.
+    QJsonDocument document = QJsonDocument::fromJson(m_reader.remainder());
+    if (m_reader.hasError() || !document.isObject()) {
         setError(ParseError, QCoreApplication::translate(NOKIA_PLUGIN_CONTEXT_NAME, PARSE_ERROR));
         return;
     }
@@ -101,19 +112,6 @@ void QPlaceSearchReplyHere::replyFinished()
     if (resultsObject.contains(QStringLiteral("results")))
         resultsObject = resultsObject.value(QStringLiteral("results")).toObject();
 
-    QJsonArray items = resultsObject.value(QStringLiteral("items")).toArray();
-
-    QList<QPlaceSearchResult> results;
-    for (int i = 0; i < items.count(); ++i) {
-        QJsonObject item = items.at(i).toObject();
-
-        const QString type = item.value(QStringLiteral("type")).toString();
-        if (type == QStringLiteral("urn:nlp-types:place"))
-            results.append(parsePlaceResult(item));
-        else if (type == QStringLiteral("urn:nlp-types:search"))
-            results.append(parseSearchResult(item));
-    }
-
     QPlaceSearchRequest r_orig = request();
     QPlaceSearchRequestPrivate *rpimpl_orig = QPlaceSearchRequestPrivate::get(r_orig);
 
@@ -135,12 +133,45 @@ void QPlaceSearchReplyHere::replyFinished()
         setPreviousPageRequest(request);
     }
 
-    setResults(results);
+    setResults(m_results);
 
     setFinished(true);
     emit finished();
 }
 
+void QPlaceSearchReplyHere::replyReadyRead()
+{
+    QNetworkReply *reply = static_cast<QNetworkReply *>(sender());
+    if (reply->error() != QNetworkReply::NoError || isFinished())
+        return;
+
+    if (readResults(reply)) {
+        setResults(m_results);
+        emit contentUpdated();
+    }
+}
+
+/*
+    Parses the items of the response received so far, returns true if there
+    were new results.
+*/
+bool QPlaceSearchReplyHere::readResults(QNetworkReply *reply)
+{
+    m_reader.addData(reply->readAll());
+    const QList<QJsonObject> items = m_reader.takeObjects();
+
+    const int count = m_results.size();
+    for (const QJsonObject &item : items) {
+        const QString type = item.value(QStringLiteral("type")).toString();
+        if (type == QStringLiteral("urn:nlp-types:place"))
+            m_results.append(parsePlaceResult(item));
+        else if (type == QStringLiteral("urn:nlp-types:search"))
+            m_results.append(parseSearchResult(item));
+    }
+
+    return m_results.size() > count;
+}
+
 QPlaceResult QPlaceSearchReplyHere::parsePlaceResult(const QJsonObject &item) const
 {
     QPlaceResult result;
@@ -39,6 +39,7 @@
 
 #include <QtNetwork/QNetworkReply>
 #include <QtLocation/QPlaceSearchReply>
+#include <QtLocation/private/qplacejsonstreamreader_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -59,13 +60,17 @@ public:
 private slots:
     void setError(QPlaceReply::Error error_, const QString &errorString);
     void replyFinished();
+    void replyReadyRead();
     void replyError(QNetworkReply::NetworkError error);
 
 private:
     QPlaceResult parsePlaceResult(const QJsonObject &item) const;
     QPlaceProposedSearchResult parseSearchResult(const QJsonObject &item) const;
+    bool readResults(QNetworkReply *reply);
 
     QPlaceManagerEngineNokiaV2 *m_engine;
+    QPlaceJsonStreamReader m_reader;
+    QList<QPlaceSearchResult> m_results;
 };
 
 QT_END_NAMESPACE
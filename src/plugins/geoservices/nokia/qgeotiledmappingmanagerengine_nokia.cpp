@@ -145,7 +145,7 @@ QGeoTiledMappingManagerEngineNokia::QGeoTiledMappingManagerEngineNokia(
     }
     if (parameters.contains(QStringLiteral("here.mapping.cache.disk.size"))) {
       bool ok = false;
-      int cacheSize = parameters.value(QStringLiteral("here.mapping.cache.disk.size")).toString().toInt(&ok);
+      qint64 cacheSize = parameters.value(QStringLiteral("here.mapping.cache.disk.size")).toString().toLongLong(&ok);
       if (ok)
           tileCache->setMaxDiskUsage(cacheSize);
     }
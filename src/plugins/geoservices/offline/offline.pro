@@ -0,0 +1,38 @@
+TARGET = qtgeoservices_offline
+
+QT += location-private positioning-private
+
+HEADERS += \
+    qgeoserviceproviderpluginoffline.h \
+    qgeoroutegraph.h \
+    qgeoofflinerouter.h \
+    qgeoroutingmanagerengineoffline.h \
+    qgeoroutereplyoffline.h \
+    qgeotextindex.h \
+    qgeocodingindex.h \
+    qgeocodingmanagerengineoffline.h \
+    qgeocodereplyoffline.h \
+    qplaceindex.h \
+    qplacemanagerengineoffline.h \
+    qplacereplyoffline.h
+
+SOURCES += \
+    qgeoserviceproviderpluginoffline.cpp \
+    qgeoroutegraph.cpp \
+    qgeoofflinerouter.cpp \
+    qgeoroutingmanagerengineoffline.cpp \
+    qgeoroutereplyoffline.cpp \
+    qgeotextindex.cpp \
+    qgeocodingindex.cpp \
+    qgeocodingmanagerengineoffline.cpp \
+    qgeocodereplyoffline.cpp \
+    qplaceindex.cpp \
+    qplacemanagerengineoffline.cpp \
+    qplacereplyoffline.cpp
+
+OTHER_FILES += \
+    offline_plugin.json
+
+PLUGIN_TYPE = geoservices
+PLUGIN_CLASS_NAME = QGeoServiceProviderFactoryOffline
+load(qt_plugin)
@@ -0,0 +1,650 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeocodingindex.h"
+
+#include <QtCore/QSaveFile>
+#include <QtCore/QtMath>
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+const char Magic[4] = { 'Q', 'G', 'G', 'C' };
+const quint32 ByteOrderMark = 0x01020304;
+const quint32 FormatVersion = 1;
+
+const double EarthMeanRadius = 6371007.2; // same as QtPositioning
+
+// Children per R-tree node.
+const quint32 NodeSize = 16;
+
+enum Section {
+    AddressesSection,
+    AddressTreeSection,
+    AreasSection,
+    AreaTreeSection,
+    RingsSection,
+    VerticesSection,
+    DocumentTrigramsSection,
+    TrigramKeysSection,
+    FirstPostingSection,
+    PostingsSection,
+    StringsSection,
+    SectionCount
+};
+
+struct FileHeader
+{
+    char magic[4];
+    quint32 byteOrder;
+    quint32 version;
+    quint32 addressCount;
+    quint32 areaCount;
+    quint32 ringCount;
+    quint32 vertexCount;
+    quint32 trigramCount;
+    quint32 postingCount;
+    quint32 stringsSize;
+    quint64 sections[SectionCount]; // offsets from the start of the file, 8 byte aligned
+};
+
+Q_STATIC_ASSERT(sizeof(QGeoCodingIndex::Address) == 24);
+Q_STATIC_ASSERT(sizeof(QGeoCodingIndex::Area) == 40);
+Q_STATIC_ASSERT(sizeof(FileHeader) % 8 == 0);
+
+typedef QGeoCodingIndex::Box Box;
+typedef QGeoCodingIndex::Point Point;
+
+/*
+    The R-trees are packed: level 0 are the items themselves, each node of
+    level n + 1 covers NodeSize consecutive entries of level n. Only the
+    boxes of the levels above 0 are stored, one level after the other.
+*/
+QVector<quint32> levelSizes(quint32 count)
+{
+    QVector<quint32> sizes(1, count);
+    while (sizes.last() > 1)
+        sizes.append((sizes.last() + NodeSize - 1) / NodeSize);
+    return sizes;
+}
+
+QVector<quint32> levelOffsets(const QVector<quint32> &sizes)
+{
+    QVector<quint32> offsets(sizes.size(), 0);
+    for (int level = 2; level < sizes.size(); ++level)
+        offsets[level] = offsets.at(level - 1) + sizes.at(level - 1);
+    return offsets;
+}
+
+quint32 treeSize(quint32 count)
+{
+    const QVector<quint32> sizes = levelSizes(count);
+    return std::accumulate(sizes.constBegin() + 1, sizes.constEnd(), 0u);
+}
+
+inline bool boxContains(const Box &box, qint32 latitude, qint32 longitude)
+{
+    return latitude >= box.minLatitude && latitude <= box.maxLatitude
+            && longitude >= box.minLongitude && longitude <= box.maxLongitude;
+}
+
+inline void unite(Box &box, const Box &other)
+{
+    box.minLatitude = qMin(box.minLatitude, other.minLatitude);
+    box.minLongitude = qMin(box.minLongitude, other.minLongitude);
+    box.maxLatitude = qMax(box.maxLatitude, other.maxLatitude);
+    box.maxLongitude = qMax(box.maxLongitude, other.maxLongitude);
+}
+
+// Distance from a coordinate to the closest point of a box.
+double boxDistance(double latitude, double longitude, const Box &box)
+{
+    const double closestLatitude = qBound(box.minLatitude * 1e-6, latitude, box.maxLatitude * 1e-6);
+    const double closestLongitude = qBound(box.minLongitude * 1e-6, longitude, box.maxLongitude * 1e-6);
+    return QGeoCodingIndex::distance(latitude, longitude, closestLatitude, closestLongitude);
+}
+
+// Sort-tile-recursive order: vertical slices by longitude, each sorted by latitude.
+QVector<int> packingOrder(int count, const std::function<Point (int)> &center)
+{
+    QVector<int> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    const int leafCount = (count + int(NodeSize) - 1) / int(NodeSize);
+    const int sliceCount = qMax(1, qCeil(qSqrt(leafCount)));
+    const int sliceSize = qMax(1, (leafCount + sliceCount - 1) / sliceCount) * int(NodeSize);
+
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return center(a).longitude < center(b).longitude;
+    });
+    for (int begin = 0; begin < count; begin += sliceSize) {
+        std::sort(order.begin() + begin, order.begin() + qMin(begin + sliceSize, count),
+                  [&](int a, int b) { return center(a).latitude < center(b).latitude; });
+    }
+    return order;
+}
+
+QVector<Box> packTree(const QVector<Box> &items)
+{
+    QVector<Box> tree;
+    QVector<Box> level = items;
+    while (level.size() > 1) {
+        QVector<Box> parents((level.size() + int(NodeSize) - 1) / int(NodeSize));
+        for (int i = 0; i < level.size(); ++i) {
+            if (i % int(NodeSize) == 0)
+                parents[i / int(NodeSize)] = level.at(i);
+            else
+                unite(parents[i / int(NodeSize)], level.at(i));
+        }
+        tree += parents;
+        level = parents;
+    }
+    return tree;
+}
+
+inline qint32 toMicrodegrees(double degrees)
+{
+    return qint32(qRound64(degrees * 1e6));
+}
+
+} // namespace
+
+QGeoCodingIndex::QGeoCodingIndex()
+{
+}
+
+QGeoCodingIndex::~QGeoCodingIndex()
+{
+    if (m_data)
+        m_file.unmap(const_cast<uchar *>(m_data));
+}
+
+QSharedPointer<const QGeoCodingIndex> QGeoCodingIndex::open(const QString &fileName,
+                                                           QString *errorString)
+{
+    QSharedPointer<QGeoCodingIndex> index(new QGeoCodingIndex);
+    index->m_file.setFileName(fileName);
+    if (!index->m_file.open(QIODevice::ReadOnly)) {
+        *errorString = index->m_file.errorString();
+        return QSharedPointer<const QGeoCodingIndex>();
+    }
+    if (!index->load(errorString))
+        return QSharedPointer<const QGeoCodingIndex>();
+    return index;
+}
+
+bool QGeoCodingIndex::load(QString *errorString)
+{
+    const qint64 size = m_file.size();
+    if (size < qint64(sizeof(FileHeader))) {
+        *errorString = QStringLiteral("File is too small to be a geocoding index");
+        return false;
+    }
+
+    m_data = m_file.map(0, size);
+    if (!m_data) {
+        *errorString = m_file.errorString();
+        return false;
+    }
+
+    const FileHeader *header = reinterpret_cast<const FileHeader *>(m_data);
+    if (memcmp(header->magic, Magic, sizeof(Magic)) != 0) {
+        *errorString = QStringLiteral("Not a geocoding index file");
+        return false;
+    }
+    if (header->byteOrder != ByteOrderMark) {
+        *errorString = QStringLiteral("Geocoding index was built for a different byte order");
+        return false;
+    }
+    if (header->version != FormatVersion) {
+        *errorString = QStringLiteral("Unsupported geocoding index version %1").arg(header->version);
+        return false;
+    }
+
+    m_addressCount = header->addressCount;
+    m_areaCount = header->areaCount;
+    m_ringCount = header->ringCount;
+    m_vertexCount = header->vertexCount;
+    m_stringsSize = header->stringsSize;
+    const quint32 trigramCount = header->trigramCount;
+    const quint32 postingCount = header->postingCount;
+
+    const quint64 documentCount = quint64(m_addressCount) + m_areaCount;
+    const quint64 sizes[SectionCount] = {
+        quint64(m_addressCount) * sizeof(Address),
+        quint64(treeSize(m_addressCount)) * sizeof(Box),
+        quint64(m_areaCount) * sizeof(Area),
+        quint64(treeSize(m_areaCount)) * sizeof(Box),
+        (quint64(m_ringCount) + 1) * sizeof(quint32),
+        quint64(m_vertexCount) * sizeof(Point),
+        documentCount * sizeof(quint16),
+        quint64(trigramCount) * sizeof(quint64),
+        (quint64(trigramCount) + 1) * sizeof(quint32),
+        quint64(postingCount) * sizeof(quint32),
+        quint64(m_stringsSize)
+    };
+    for (int i = 0; i < SectionCount; ++i) {
+        const quint64 offset = header->sections[i];
+        if (offset % 8 != 0 || offset > quint64(size) || sizes[i] > quint64(size) - offset) {
+            *errorString = QStringLiteral("Corrupt geocoding index, section %1 is out of bounds").arg(i);
+            return false;
+        }
+    }
+
+    m_addresses = reinterpret_cast<const Address *>(m_data + header->sections[AddressesSection]);
+    m_addressTree = reinterpret_cast<const Box *>(m_data + header->sections[AddressTreeSection]);
+    m_areas = reinterpret_cast<const Area *>(m_data + header->sections[AreasSection]);
+    m_areaTree = reinterpret_cast<const Box *>(m_data + header->sections[AreaTreeSection]);
+    m_rings = reinterpret_cast<const quint32 *>(m_data + header->sections[RingsSection]);
+    m_vertices = reinterpret_cast<const Point *>(m_data + header->sections[VerticesSection]);
+    m_strings = reinterpret_cast<const char *>(m_data + header->sections[StringsSection]);
+
+    QGeoTextIndex::Tables text;
+    text.documentTrigrams = reinterpret_cast<const quint16 *>(m_data + header->sections[DocumentTrigramsSection]);
+    text.keys = reinterpret_cast<const quint64 *>(m_data + header->sections[TrigramKeysSection]);
+    text.firstPosting = reinterpret_cast<const quint32 *>(m_data + header->sections[FirstPostingSection]);
+    text.postings = reinterpret_cast<const quint32 *>(m_data + header->sections[PostingsSection]);
+    text.keyCount = trigramCount;
+    m_text.setTables(text);
+
+    // The contents are trusted beyond these structural checks.
+    if (m_rings[m_ringCount] != m_vertexCount || text.firstPosting[trigramCount] != postingCount
+            || m_stringsSize == 0 || m_strings[m_stringsSize - 1] != '\0') {
+        *errorString = QStringLiteral("Corrupt geocoding index");
+        return false;
+    }
+
+    return true;
+}
+
+quint32 QGeoCodingIndex::addressCount() const
+{
+    return m_addressCount;
+}
+
+quint32 QGeoCodingIndex::areaCount() const
+{
+    return m_areaCount;
+}
+
+const QGeoCodingIndex::Address &QGeoCodingIndex::address(quint32 index) const
+{
+    return m_addresses[index];
+}
+
+const QGeoCodingIndex::Area &QGeoCodingIndex::area(quint32 index) const
+{
+    return m_areas[index];
+}
+
+QString QGeoCodingIndex::string(quint32 offset) const
+{
+    if (offset == 0 || offset >= m_stringsSize)
+        return QString();
+    return QString::fromUtf8(m_strings + offset);
+}
+
+/*
+    Returns the address closest to the coordinate, or InvalidIndex if there is
+    none within \a maximumDistance metres. The R-tree is searched best first,
+    so only the nodes closer than the answer are visited.
+*/
+quint32 QGeoCodingIndex::nearestAddress(double latitude, double longitude,
+                                        double maximumDistance) const
+{
+    if (m_addressCount == 0)
+        return InvalidIndex;
+
+    struct Entry
+    {
+        double distance;
+        int level;
+        quint32 index;
+        bool operator>(const Entry &other) const { return distance > other.distance; }
+    };
+
+    const QVector<quint32> sizes = levelSizes(m_addressCount);
+    const QVector<quint32> offsets = levelOffsets(sizes);
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    queue.push({ 0.0, sizes.size() - 1, 0 });
+
+    while (!queue.empty()) {
+        const Entry entry = queue.top();
+        queue.pop();
+        if (entry.distance > maximumDistance)
+            break;
+        if (entry.level == 0) {
+            if (sizes.size() > 1)
+                return entry.index;
+            // A single address has no tree above it.
+            const Point &p = m_addresses[0].position;
+            if (distance(latitude, longitude, p.latitude * 1e-6, p.longitude * 1e-6) <= maximumDistance)
+                return 0;
+            break;
+        }
+
+        const int childLevel = entry.level - 1;
+        const quint32 first = entry.index * NodeSize;
+        const quint32 last = qMin(first + NodeSize, sizes.at(childLevel));
+        for (quint32 child = first; child < last; ++child) {
+            double d;
+            if (childLevel == 0) {
+                const Point &p = m_addresses[child].position;
+                d = distance(latitude, longitude, p.latitude * 1e-6, p.longitude * 1e-6);
+            } else {
+                d = boxDistance(latitude, longitude, m_addressTree[offsets.at(childLevel) + child]);
+            }
+            if (d <= maximumDistance)
+                queue.push({ d, childLevel, child });
+        }
+    }
+    return InvalidIndex;
+}
+
+/*
+    Returns the areas whose polygons contain the coordinate.
+*/
+QVector<quint32> QGeoCodingIndex::areasAt(double latitude, double longitude) const
+{
+    QVector<quint32> result;
+    if (m_areaCount == 0)
+        return result;
+
+    const qint32 lat = toMicrodegrees(latitude);
+    const qint32 lng = toMicrodegrees(longitude);
+    const QVector<quint32> sizes = levelSizes(m_areaCount);
+    const QVector<quint32> offsets = levelOffsets(sizes);
+
+    QVector<QPair<int, quint32>> stack;
+    stack.append(qMakePair(sizes.size() - 1, 0u));
+    while (!stack.isEmpty()) {
+        const QPair<int, quint32> node = stack.takeLast();
+        if (node.first == 0) {
+            const Area &area = m_areas[node.second];
+            if (boxContains(area.bounds, lat, lng) && contains(area, lat, lng))
+                result.append(node.second);
+            continue;
+        }
+
+        const int childLevel = node.first - 1;
+        const quint32 first = node.second * NodeSize;
+        const quint32 last = qMin(first + NodeSize, sizes.at(childLevel));
+        for (quint32 child = first; child < last; ++child) {
+            const Box &box = childLevel == 0 ? m_areas[child].bounds
+                                             : m_areaTree[offsets.at(childLevel) + child];
+            if (boxContains(box, lat, lng))
+                stack.append(qMakePair(childLevel, child));
+        }
+    }
+    return result;
+}
+
+// Even-odd rule over all rings, so holes and multipolygons need no roles.
+bool QGeoCodingIndex::contains(const Area &area, qint32 latitude, qint32 longitude) const
+{
+    bool inside = false;
+    for (quint32 ring = area.firstRing; ring < area.firstRing + area.ringCount; ++ring) {
+        const quint32 begin = m_rings[ring];
+        const quint32 end = m_rings[ring + 1];
+        if (end - begin < 3)
+            continue;
+        for (quint32 i = begin, j = end - 1; i < end; j = i++) {
+            const Point &a = m_vertices[i];
+            const Point &b = m_vertices[j];
+            if ((a.latitude > latitude) != (b.latitude > latitude)) {
+                const double crossing = a.longitude + double(latitude - a.latitude)
+                        * (double(b.longitude) - a.longitude) / (double(b.latitude) - a.latitude);
+                if (longitude < crossing)
+                    inside = !inside;
+            }
+        }
+    }
+    return inside;
+}
+
+/*
+    Returns the addresses and areas matching \a text, best matches first.
+
+    \sa QGeoTextIndex::search()
+*/
+QVector<QGeoCodingIndex::Match> QGeoCodingIndex::search(const QString &text) const
+{
+    return m_text.search(text);
+}
+
+/*
+    Haversine distance in metres.
+*/
+double QGeoCodingIndex::distance(double latitude1, double longitude1,
+                                 double latitude2, double longitude2)
+{
+    const double dlat = qDegreesToRadians(latitude2 - latitude1);
+    const double dlon = qDegreesToRadians(longitude2 - longitude1);
+    const double haversineDlat = qSin(dlat / 2.0);
+    const double haversineDlon = qSin(dlon / 2.0);
+    const double y = haversineDlat * haversineDlat
+            + qCos(qDegreesToRadians(latitude1)) * qCos(qDegreesToRadians(latitude2))
+            * haversineDlon * haversineDlon;
+    return 2.0 * EarthMeanRadius * qAsin(qSqrt(qMin(y, 1.0)));
+}
+
+quint32 QGeoCodingIndexWriter::addString(const QString &string)
+{
+    if (string.isEmpty())
+        return 0;
+    auto it = m_stringOffsets.constFind(string);
+    if (it != m_stringOffsets.constEnd())
+        return it.value();
+    const quint32 offset = quint32(m_strings.size());
+    m_strings.append(string.toUtf8());
+    m_strings.append('\0');
+    m_stringOffsets.insert(string, offset);
+    return offset;
+}
+
+void QGeoCodingIndexWriter::addAddress(double latitude, double longitude, const QString &street,
+                                       const QString &houseNumber, const QString &postalCode,
+                                       const QString &city)
+{
+    QGeoCodingIndex::Address address;
+    address.position.latitude = toMicrodegrees(latitude);
+    address.position.longitude = toMicrodegrees(longitude);
+    address.street = addString(street);
+    address.houseNumber = addString(houseNumber);
+    address.postalCode = addString(postalCode);
+    address.city = addString(city);
+    m_addresses.append(address);
+}
+
+void QGeoCodingIndexWriter::addArea(int level, const QString &name, const QString &countryCode,
+                                    const QVector<Ring> &rings)
+{
+    PendingArea pending;
+    memset(&pending.area, 0, sizeof(pending.area));
+    bool empty = true;
+    for (Ring ring : rings) {
+        if (ring.size() > 1 && ring.first().latitude == ring.last().latitude
+                && ring.first().longitude == ring.last().longitude) {
+            ring.removeLast();
+        }
+        if (ring.size() < 3)
+            continue;
+        for (const Point &p : qAsConst(ring)) {
+            const Box box = { p.latitude, p.longitude, p.latitude, p.longitude };
+            if (empty)
+                pending.area.bounds = box;
+            else
+                unite(pending.area.bounds, box);
+            empty = false;
+        }
+        pending.rings.append(ring);
+    }
+    if (pending.rings.isEmpty())
+        return;
+
+    const Box &bounds = pending.area.bounds;
+    pending.area.center.latitude = qint32((qint64(bounds.minLatitude) + bounds.maxLatitude) / 2);
+    pending.area.center.longitude = qint32((qint64(bounds.minLongitude) + bounds.maxLongitude) / 2);
+    pending.area.name = addString(name);
+    pending.area.countryCode = addString(countryCode);
+    pending.area.ringCount = quint16(qMin(pending.rings.size(), 0xffff));
+    pending.area.level = quint8(qBound(0, level, 255));
+    pending.rings.resize(pending.area.ringCount);
+    m_areas.append(pending);
+}
+
+int QGeoCodingIndexWriter::addressCount() const
+{
+    return m_addresses.size();
+}
+
+int QGeoCodingIndexWriter::areaCount() const
+{
+    return m_areas.size();
+}
+
+bool QGeoCodingIndexWriter::write(const QString &fileName, QString *errorString) const
+{
+    // Addresses and areas in R-tree order.
+    const QVector<int> addressOrder = packingOrder(m_addresses.size(), [this](int i) {
+        return m_addresses.at(i).position;
+    });
+    QVector<QGeoCodingIndex::Address> addresses;
+    QVector<Box> addressBoxes;
+    addresses.reserve(m_addresses.size());
+    addressBoxes.reserve(m_addresses.size());
+    for (int i : addressOrder) {
+        const QGeoCodingIndex::Address &address = m_addresses.at(i);
+        addresses.append(address);
+        addressBoxes.append({ address.position.latitude, address.position.longitude,
+                              address.position.latitude, address.position.longitude });
+    }
+    const QVector<Box> addressTree = packTree(addressBoxes);
+
+    const QVector<int> areaOrder = packingOrder(m_areas.size(), [this](int i) {
+        return m_areas.at(i).area.center;
+    });
+    QVector<QGeoCodingIndex::Area> areas;
+    QVector<Box> areaBoxes;
+    QVector<quint32> rings(1, 0);
+    QVector<Point> vertices;
+    for (int i : areaOrder) {
+        const PendingArea &pending = m_areas.at(i);
+        QGeoCodingIndex::Area area = pending.area;
+        area.firstRing = quint32(rings.size() - 1);
+        for (const Ring &ring : pending.rings) {
+            vertices += ring;
+            rings.append(quint32(vertices.size()));
+        }
+        areas.append(area);
+        areaBoxes.append(area.bounds);
+    }
+    const QVector<Box> areaTree = packTree(areaBoxes);
+
+    // Trigram index over the text of the addresses, then of the areas.
+    auto string = [this](quint32 offset) {
+        return offset ? QString::fromUtf8(m_strings.constData() + offset) : QString();
+    };
+    QGeoTextIndexWriter text;
+    for (const QGeoCodingIndex::Address &address : qAsConst(addresses)) {
+        text.addDocument(QStringList({ string(address.houseNumber), string(address.street),
+                                       string(address.postalCode), string(address.city) })
+                         .join(QLatin1Char(' ')));
+    }
+    for (const QGeoCodingIndex::Area &area : qAsConst(areas))
+        text.addDocument(string(area.name));
+    text.finish();
+
+    FileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, Magic, sizeof(Magic));
+    header.byteOrder = ByteOrderMark;
+    header.version = FormatVersion;
+    header.addressCount = quint32(addresses.size());
+    header.areaCount = quint32(areas.size());
+    header.ringCount = quint32(rings.size() - 1);
+    header.vertexCount = quint32(vertices.size());
+    header.trigramCount = quint32(text.keys.size());
+    header.postingCount = quint32(text.postings.size());
+    header.stringsSize = quint32(m_strings.size());
+
+    const QPair<const void *, qint64> sections[SectionCount] = {
+        { addresses.constData(), qint64(addresses.size()) * qint64(sizeof(QGeoCodingIndex::Address)) },
+        { addressTree.constData(), qint64(addressTree.size()) * qint64(sizeof(Box)) },
+        { areas.constData(), qint64(areas.size()) * qint64(sizeof(QGeoCodingIndex::Area)) },
+        { areaTree.constData(), qint64(areaTree.size()) * qint64(sizeof(Box)) },
+        { rings.constData(), qint64(rings.size()) * qint64(sizeof(quint32)) },
+        { vertices.constData(), qint64(vertices.size()) * qint64(sizeof(Point)) },
+        { text.documentTrigrams.constData(), qint64(text.documentTrigrams.size()) * qint64(sizeof(quint16)) },
+        { text.keys.constData(), qint64(text.keys.size()) * qint64(sizeof(quint64)) },
+        { text.firstPosting.constData(), qint64(text.firstPosting.size()) * qint64(sizeof(quint32)) },
+        { text.postings.constData(), qint64(text.postings.size()) * qint64(sizeof(quint32)) },
+        { m_strings.constData(), qint64(m_strings.size()) }
+    };
+    quint64 offset = sizeof(FileHeader);
+    for (int i = 0; i < SectionCount; ++i) {
+        header.sections[i] = offset;
+        offset += (quint64(sections[i].second) + 7) & ~quint64(7);
+    }
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        *errorString = file.errorString();
+        return false;
+    }
+    static const char padding[8] = {};
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    for (int i = 0; i < SectionCount; ++i) {
+        file.write(static_cast<const char *>(sections[i].first), sections[i].second);
+        file.write(padding, ((sections[i].second + 7) & ~qint64(7)) - sections[i].second);
+    }
+    if (!file.commit()) {
+        *errorString = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,188 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOCODINGINDEX_H
+#define QGEOCODINGINDEX_H
+
+#include "qgeotextindex.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Read-only view of a geocoding index file produced by QGeoCodingIndexWriter.
+
+    The file is memory mapped and holds:
+    - address points, ordered along a packed R-tree used for nearest
+      neighbour queries,
+    - administrative areas as polygons, ordered along a second packed R-tree
+      over their bounding boxes, used for point in polygon queries,
+    - a trigram index over the text of both, used for forward geocoding.
+
+    Addresses and areas share one document numbering for the text index:
+    documents below addressCount() are addresses, the others are areas.
+
+    All accessors are const and the object can be used from any thread.
+*/
+class QGeoCodingIndex
+{
+public:
+    struct Point
+    {
+        qint32 latitude;  // microdegrees
+        qint32 longitude; // microdegrees
+    };
+
+    struct Box
+    {
+        qint32 minLatitude;
+        qint32 minLongitude;
+        qint32 maxLatitude;
+        qint32 maxLongitude;
+    };
+
+    struct Address
+    {
+        Point position;
+        quint32 street;   // offsets into the strings blob, 0 for none
+        quint32 houseNumber;
+        quint32 postalCode;
+        quint32 city;
+    };
+
+    struct Area
+    {
+        Box bounds;
+        Point center;
+        quint32 name;
+        quint32 countryCode;
+        quint32 firstRing;
+        quint16 ringCount;
+        quint8 level;     // OSM admin_level
+        quint8 reserved;
+    };
+
+    typedef QGeoTextIndex::Match Match;
+
+    static const quint32 InvalidIndex = 0xffffffff;
+
+    static QSharedPointer<const QGeoCodingIndex> open(const QString &fileName, QString *errorString);
+    ~QGeoCodingIndex();
+
+    quint32 addressCount() const;
+    quint32 areaCount() const;
+
+    const Address &address(quint32 index) const;
+    const Area &area(quint32 index) const;
+    QString string(quint32 offset) const;
+
+    quint32 nearestAddress(double latitude, double longitude, double maximumDistance) const;
+    QVector<quint32> areasAt(double latitude, double longitude) const;
+    QVector<Match> search(const QString &text) const;
+
+    static double distance(double latitude1, double longitude1,
+                           double latitude2, double longitude2);
+
+private:
+    QGeoCodingIndex();
+    bool load(QString *errorString);
+    bool contains(const Area &area, qint32 latitude, qint32 longitude) const;
+
+    QFile m_file;
+    const uchar *m_data = nullptr;
+    quint32 m_addressCount = 0;
+    quint32 m_areaCount = 0;
+    quint32 m_ringCount = 0;
+    quint32 m_vertexCount = 0;
+    quint32 m_stringsSize = 0;
+    const Address *m_addresses = nullptr;
+    const Box *m_addressTree = nullptr;
+    const Area *m_areas = nullptr;
+    const Box *m_areaTree = nullptr;
+    const quint32 *m_rings = nullptr;
+    const Point *m_vertices = nullptr;
+    const char *m_strings = nullptr;
+    QGeoTextIndex m_text;
+
+    Q_DISABLE_COPY(QGeoCodingIndex)
+};
+
+/*
+    Collects addresses and administrative areas in memory and serializes
+    them in the format read by QGeoCodingIndex. Used by the qgeoofflinedata
+    tool and by the tests.
+*/
+class QGeoCodingIndexWriter
+{
+public:
+    typedef QVector<QGeoCodingIndex::Point> Ring;
+
+    void addAddress(double latitude, double longitude, const QString &street,
+                    const QString &houseNumber, const QString &postalCode, const QString &city);
+    void addArea(int level, const QString &name, const QString &countryCode,
+                 const QVector<Ring> &rings);
+
+    int addressCount() const;
+    int areaCount() const;
+
+    bool write(const QString &fileName, QString *errorString) const;
+
+private:
+    quint32 addString(const QString &string);
+
+    struct PendingArea
+    {
+        QGeoCodingIndex::Area area;
+        QVector<Ring> rings;
+    };
+
+    QVector<QGeoCodingIndex::Address> m_addresses;
+    QVector<PendingArea> m_areas;
+    QByteArray m_strings = QByteArray(1, '\0');
+    QHash<QString, quint32> m_stringOffsets;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOCODINGINDEX_H
@@ -0,0 +1,315 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeocodingmanagerengineoffline.h"
+#include "qgeocodereplyoffline.h"
+#include "qgeocodingindex.h"
+
+#include <QtPositioning/QGeoAddress>
+#include <QtPositioning/QGeoLocation>
+#include <QtPositioning/QGeoRectangle>
+#include <QtPositioning/QGeoShape>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+enum AddressField {
+    CountryField,
+    StateField,
+    CountyField,
+    CityField,
+    DistrictField,
+    AddressFieldCount
+};
+
+// OSM admin_level to the QGeoAddress field it fills, -1 for none.
+int addressField(int level)
+{
+    if (level <= 2)
+        return CountryField;
+    if (level <= 4)
+        return StateField;
+    if (level <= 6)
+        return CountyField;
+    if (level <= 8)
+        return CityField;
+    if (level <= 10)
+        return DistrictField;
+    return -1;
+}
+
+void setAddressField(QGeoAddress &address, int field, const QString &value)
+{
+    switch (field) {
+    case CountryField:
+        address.setCountry(value);
+        break;
+    case StateField:
+        address.setState(value);
+        break;
+    case CountyField:
+        address.setCounty(value);
+        break;
+    case CityField:
+        address.setCity(value);
+        break;
+    case DistrictField:
+        address.setDistrict(value);
+        break;
+    }
+}
+
+// Fills the fields the address does not have yet from the most specific
+// administrative areas containing the coordinate.
+void addAdministrativeAreas(const QGeoCodingIndex &index, double latitude, double longitude,
+                            QGeoAddress &address)
+{
+    int levels[AddressFieldCount] = { -1, -1, -1, -1, -1 };
+    quint32 areas[AddressFieldCount] = {};
+    const QVector<quint32> containing = index.areasAt(latitude, longitude);
+    for (quint32 i : containing) {
+        const QGeoCodingIndex::Area &area = index.area(i);
+        const int field = addressField(area.level);
+        if (field >= 0 && area.level > levels[field]) {
+            levels[field] = area.level;
+            areas[field] = i;
+        }
+    }
+
+    for (int field = 0; field < AddressFieldCount; ++field) {
+        if (levels[field] < 0)
+            continue;
+        const QGeoCodingIndex::Area &area = index.area(areas[field]);
+        if (field == CountryField) {
+            if (address.country().isEmpty())
+                address.setCountry(index.string(area.name));
+            if (address.countryCode().isEmpty())
+                address.setCountryCode(index.string(area.countryCode));
+        } else if ((field == StateField && address.state().isEmpty())
+                   || (field == CountyField && address.county().isEmpty())
+                   || (field == CityField && address.city().isEmpty())
+                   || (field == DistrictField && address.district().isEmpty())) {
+            setAddressField(address, field, index.string(area.name));
+        }
+    }
+}
+
+QGeoLocation addressLocation(const QGeoCodingIndex &index, quint32 i)
+{
+    const QGeoCodingIndex::Address &record = index.address(i);
+    const double latitude = record.position.latitude * 1e-6;
+    const double longitude = record.position.longitude * 1e-6;
+
+    const QString street = index.string(record.street);
+    const QString houseNumber = index.string(record.houseNumber);
+    QGeoAddress address;
+    address.setStreet(houseNumber.isEmpty() ? street
+                                            : QStringLiteral("%1 %2").arg(houseNumber, street));
+    address.setPostalCode(index.string(record.postalCode));
+    address.setCity(index.string(record.city));
+    addAdministrativeAreas(index, latitude, longitude, address);
+
+    QGeoLocation location;
+    location.setCoordinate(QGeoCoordinate(latitude, longitude));
+    location.setAddress(address);
+    return location;
+}
+
+QGeoLocation areaLocation(const QGeoCodingIndex &index, quint32 i)
+{
+    const QGeoCodingIndex::Area &area = index.area(i);
+    const double latitude = area.center.latitude * 1e-6;
+    const double longitude = area.center.longitude * 1e-6;
+
+    QGeoAddress address;
+    const int field = addressField(area.level);
+    setAddressField(address, field, index.string(area.name));
+    if (field == CountryField)
+        address.setCountryCode(index.string(area.countryCode));
+    addAdministrativeAreas(index, latitude, longitude, address);
+
+    QGeoLocation location;
+    location.setCoordinate(QGeoCoordinate(latitude, longitude));
+    location.setBoundingBox(QGeoRectangle(QGeoCoordinate(area.bounds.maxLatitude * 1e-6,
+                                                         area.bounds.minLongitude * 1e-6),
+                                          QGeoCoordinate(area.bounds.minLatitude * 1e-6,
+                                                         area.bounds.maxLongitude * 1e-6)));
+    location.setAddress(address);
+    return location;
+}
+
+QGeoCodeReply::Error search(const QGeoCodingIndex &index, const QString &text, int limit,
+                            int offset, const QGeoShape &bounds, QList<QGeoLocation> &locations)
+{
+    const QVector<QGeoCodingIndex::Match> matches = index.search(text);
+    int skipped = 0;
+    for (const QGeoCodingIndex::Match &match : matches) {
+        if (limit >= 0 && locations.size() >= limit)
+            break;
+        const QGeoLocation location = match.document < index.addressCount()
+                ? addressLocation(index, match.document)
+                : areaLocation(index, match.document - index.addressCount());
+        if (bounds.isValid() && !bounds.contains(location.coordinate()))
+            continue;
+        if (skipped < offset) {
+            ++skipped;
+            continue;
+        }
+        locations.append(location);
+    }
+    return QGeoCodeReply::NoError;
+}
+
+} // namespace
+
+QGeoCodingManagerEngineOffline::QGeoCodingManagerEngineOffline(const QVariantMap &parameters,
+                                                               QGeoServiceProvider::Error *error,
+                                                               QString *errorString)
+:   QGeoCodingManagerEngine(parameters), m_maximumDistance(100.0)
+{
+    const QString indexFile = parameters.value(QStringLiteral("offline.geocoding.index")).toString();
+    if (indexFile.isEmpty()) {
+        *error = QGeoServiceProvider::MissingRequiredParameterError;
+        *errorString = QStringLiteral("The offline.geocoding.index parameter is required for geocoding");
+        return;
+    }
+
+    QString indexError;
+    m_index = QGeoCodingIndex::open(indexFile, &indexError);
+    if (!m_index) {
+        *error = QGeoServiceProvider::NotSupportedError;
+        *errorString = QStringLiteral("Unable to load geocoding index %1: %2").arg(indexFile, indexError);
+        return;
+    }
+
+    if (parameters.contains(QStringLiteral("offline.geocoding.max_distance")))
+        m_maximumDistance = parameters.value(QStringLiteral("offline.geocoding.max_distance")).toDouble();
+
+    *error = QGeoServiceProvider::NoError;
+    errorString->clear();
+}
+
+QGeoCodingManagerEngineOffline::~QGeoCodingManagerEngineOffline()
+{
+}
+
+QGeoCodeReply *QGeoCodingManagerEngineOffline::geocode(const QGeoAddress &address,
+                                                       const QGeoShape &bounds)
+{
+    // Addresses are indexed with their street, postal code and city only, so
+    // broader fields would just dilute the match.
+    QString text = QStringList({ address.street(), address.postalCode(), address.city() })
+            .join(QLatin1Char(' ')).trimmed();
+    if (text.isEmpty()) {
+        for (const QString &field : { address.district(), address.county(),
+                                      address.state(), address.country() }) {
+            if (!field.isEmpty()) {
+                text = field;
+                break;
+            }
+        }
+    }
+    return geocode(text, -1, 0, bounds);
+}
+
+QGeoCodeReply *QGeoCodingManagerEngineOffline::geocode(const QString &address, int limit,
+                                                       int offset, const QGeoShape &bounds)
+{
+    QSharedPointer<const QGeoCodingIndex> index = m_index;
+    return startReply(new QGeoCodeReplyOffline(
+        [index, address, limit, offset, bounds](QList<QGeoLocation> &locations, QString &) {
+            return search(*index, address, limit, offset, bounds, locations);
+        }, bounds, limit, offset, this));
+}
+
+/*
+    Returns the closest address within offline.geocoding.max_distance, or the
+    bare coordinate when there is none, completed with the administrative
+    areas containing it. The reply has no locations if neither is known.
+*/
+QGeoCodeReply *QGeoCodingManagerEngineOffline::reverseGeocode(const QGeoCoordinate &coordinate,
+                                                              const QGeoShape &bounds)
+{
+    QSharedPointer<const QGeoCodingIndex> index = m_index;
+    const double maximumDistance = m_maximumDistance;
+    return startReply(new QGeoCodeReplyOffline(
+        [index, coordinate, maximumDistance](QList<QGeoLocation> &locations, QString &) {
+            const quint32 nearest = index->nearestAddress(coordinate.latitude(),
+                                                          coordinate.longitude(), maximumDistance);
+            if (nearest != QGeoCodingIndex::InvalidIndex) {
+                locations.append(addressLocation(*index, nearest));
+            } else {
+                QGeoAddress address;
+                addAdministrativeAreas(*index, coordinate.latitude(), coordinate.longitude(), address);
+                if (!address.isEmpty()) {
+                    QGeoLocation location;
+                    location.setCoordinate(coordinate);
+                    location.setAddress(address);
+                    locations.append(location);
+                }
+            }
+            return QGeoCodeReply::NoError;
+        }, bounds, -1, 0, this));
+}
+
+QGeoCodeReply *QGeoCodingManagerEngineOffline::startReply(QGeoCodeReply *reply)
+{
+    connect(reply, SIGNAL(finished()), this, SLOT(replyFinished()));
+    connect(reply, SIGNAL(error(QGeoCodeReply::Error,QString)),
+            this, SLOT(replyError(QGeoCodeReply::Error,QString)));
+    return reply;
+}
+
+void QGeoCodingManagerEngineOffline::replyFinished()
+{
+    QGeoCodeReply *reply = qobject_cast<QGeoCodeReply *>(sender());
+    if (reply)
+        emit finished(reply);
+}
+
+void QGeoCodingManagerEngineOffline::replyError(QGeoCodeReply::Error errorCode,
+                                                const QString &errorString)
+{
+    QGeoCodeReply *reply = qobject_cast<QGeoCodeReply *>(sender());
+    if (reply)
+        emit error(reply, errorCode, errorString);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,80 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOCODINGMANAGERENGINEOFFLINE_H
+#define QGEOCODINGMANAGERENGINEOFFLINE_H
+
+#include <QtCore/QSharedPointer>
+#include <QtLocation/QGeoServiceProvider>
+#include <QtLocation/QGeoCodingManagerEngine>
+#include <QtLocation/QGeoCodeReply>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoCodingIndex;
+
+class QGeoCodingManagerEngineOffline : public QGeoCodingManagerEngine
+{
+    Q_OBJECT
+
+public:
+    QGeoCodingManagerEngineOffline(const QVariantMap &parameters, QGeoServiceProvider::Error *error,
+                                   QString *errorString);
+    ~QGeoCodingManagerEngineOffline();
+
+    QGeoCodeReply *geocode(const QGeoAddress &address, const QGeoShape &bounds) override;
+    QGeoCodeReply *geocode(const QString &address, int limit, int offset,
+                           const QGeoShape &bounds) override;
+    QGeoCodeReply *reverseGeocode(const QGeoCoordinate &coordinate,
+                                  const QGeoShape &bounds) override;
+
+private Q_SLOTS:
+    void replyFinished();
+    void replyError(QGeoCodeReply::Error errorCode, const QString &errorString);
+
+private:
+    QGeoCodeReply *startReply(QGeoCodeReply *reply);
+
+    QSharedPointer<const QGeoCodingIndex> m_index;
+    double m_maximumDistance;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOCODINGMANAGERENGINEOFFLINE_H
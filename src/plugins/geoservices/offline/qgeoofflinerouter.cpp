@@ -0,0 +1,485 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeoofflinerouter.h"
+
+#include <QtLocation/QGeoRoute>
+#include <QtLocation/QGeoRouteLeg>
+#include <QtLocation/private/qgeoroutesegment_p.h>
+#include <QtPositioning/QGeoPath>
+#include <QtCore/QHash>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+struct SearchLabel
+{
+    double distance;
+    quint32 parent;
+    quint32 edge;
+    bool settled;
+};
+
+typedef std::pair<double, quint32> QueueEntry;
+typedef std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> SearchQueue;
+
+// Edge lengths are stored as floats, keep the heuristic strictly below them.
+const double HeuristicScale = 0.999;
+
+} // namespace
+
+QGeoOfflineRouter::QGeoOfflineRouter(const QSharedPointer<const QGeoRouteGraph> &graph,
+                                     double snapDistance)
+:   m_graph(graph), m_snapDistance(snapDistance)
+{
+}
+
+QGeoOfflineRouter::Profile QGeoOfflineRouter::profile(const QGeoRouteRequest &request)
+{
+    Profile profile;
+    const QGeoRouteRequest::TravelModes modes = request.travelModes();
+    if (modes & (QGeoRouteRequest::CarTravel | QGeoRouteRequest::TruckTravel)) {
+        profile.travelMode = QGeoRouteRequest::CarTravel;
+        profile.access = QGeoRouteGraph::CarAccess;
+    } else if (modes & QGeoRouteRequest::BicycleTravel) {
+        profile.travelMode = QGeoRouteRequest::BicycleTravel;
+        profile.access = QGeoRouteGraph::BicycleAccess;
+        profile.speedLimit = 16.0 / 3.6;
+    } else if (modes & QGeoRouteRequest::PedestrianTravel) {
+        profile.travelMode = QGeoRouteRequest::PedestrianTravel;
+        profile.access = QGeoRouteGraph::PedestrianAccess;
+        profile.speedLimit = 5.0 / 3.6;
+    }
+
+    const QGeoRouteRequest::RouteOptimizations optimization = request.routeOptimization();
+    profile.shortest = (optimization & QGeoRouteRequest::ShortestRoute)
+            && !(optimization & QGeoRouteRequest::FastestRoute);
+    return profile;
+}
+
+double QGeoOfflineRouter::travelTime(const QGeoRouteGraph::Edge &edge, const Profile &profile) const
+{
+    double speed = edge.speed / 3.6;
+    if (profile.speedLimit > 0.0)
+        speed = qMin(speed, profile.speedLimit);
+    return edge.length / speed;
+}
+
+double QGeoOfflineRouter::cost(const QGeoRouteGraph::Edge &edge, const Profile &profile) const
+{
+    return profile.shortest ? double(edge.length) : travelTime(edge, profile);
+}
+
+QGeoCoordinate QGeoOfflineRouter::coordinate(quint32 node) const
+{
+    return QGeoCoordinate(m_graph->latitude(node), m_graph->longitude(node));
+}
+
+/*
+    Finds the cheapest path from \a source to \a target and stores the
+    indices of its edges in \a edges. Returns false if \a target cannot be
+    reached.
+*/
+bool QGeoOfflineRouter::findPath(quint32 source, quint32 target, const Profile &profile,
+                                 QVector<quint32> &edges) const
+{
+    edges.clear();
+    if (source == target)
+        return true;
+
+    const QGeoRouteGraph &graph = *m_graph;
+    double maximumSpeed = graph.maximumSpeed() / 3.6;
+    if (profile.speedLimit > 0.0)
+        maximumSpeed = qMin(maximumSpeed, profile.speedLimit);
+    const double heuristicScale = profile.shortest ? HeuristicScale : HeuristicScale / maximumSpeed;
+
+    const double sourceLatitude = graph.latitude(source);
+    const double sourceLongitude = graph.longitude(source);
+    const double targetLatitude = graph.latitude(target);
+    const double targetLongitude = graph.longitude(target);
+
+    // Forward key is distance + potential, backward key is distance - potential.
+    auto potential = [&](quint32 node) {
+        const double latitude = graph.latitude(node);
+        const double longitude = graph.longitude(node);
+        return heuristicScale * 0.5
+                * (QGeoRouteGraph::distance(latitude, longitude, targetLatitude, targetLongitude)
+                   - QGeoRouteGraph::distance(latitude, longitude, sourceLatitude, sourceLongitude));
+    };
+
+    QHash<quint32, SearchLabel> forward;
+    QHash<quint32, SearchLabel> backward;
+    SearchQueue forwardQueue;
+    SearchQueue backwardQueue;
+
+    forward.insert(source, { 0.0, QGeoRouteGraph::InvalidNode, 0, false });
+    forwardQueue.push(QueueEntry(potential(source), source));
+    backward.insert(target, { 0.0, QGeoRouteGraph::InvalidNode, 0, false });
+    backwardQueue.push(QueueEntry(-potential(target), target));
+
+    double best = std::numeric_limits<double>::infinity();
+    quint32 meeting = QGeoRouteGraph::InvalidNode;
+
+    while (!forwardQueue.empty() && !backwardQueue.empty()) {
+        if (forwardQueue.top().first + backwardQueue.top().first >= best)
+            break;
+
+        if (forwardQueue.top().first <= backwardQueue.top().first) {
+            const quint32 node = forwardQueue.top().second;
+            forwardQueue.pop();
+            SearchLabel &label = forward[node];
+            if (label.settled)
+                continue;
+            label.settled = true;
+            const double distance = label.distance;
+
+            for (const QGeoRouteGraph::Edge *e = graph.edgesBegin(node), *end = graph.edgesEnd(node);
+                 e != end; ++e) {
+                if (!(e->access & profile.access))
+                    continue;
+                const double candidate = distance + cost(*e, profile);
+                auto it = forward.find(e->target);
+                if (it == forward.end()) {
+                    forward.insert(e->target, { candidate, node, graph.edgeIndex(e), false });
+                } else if (!it->settled && candidate < it->distance) {
+                    *it = { candidate, node, graph.edgeIndex(e), false };
+                } else {
+                    continue;
+                }
+                forwardQueue.push(QueueEntry(candidate + potential(e->target), e->target));
+
+                auto other = backward.constFind(e->target);
+                if (other != backward.constEnd() && candidate + other->distance < best) {
+                    best = candidate + other->distance;
+                    meeting = e->target;
+                }
+            }
+        } else {
+            const quint32 node = backwardQueue.top().second;
+            backwardQueue.pop();
+            SearchLabel &label = backward[node];
+            if (label.settled)
+                continue;
+            label.settled = true;
+            const double distance = label.distance;
+
+            for (const QGeoRouteGraph::InEdge *e = graph.inEdgesBegin(node), *end = graph.inEdgesEnd(node);
+                 e != end; ++e) {
+                const QGeoRouteGraph::Edge &edge = graph.edge(e->edge);
+                if (!(edge.access & profile.access))
+                    continue;
+                const double candidate = distance + cost(edge, profile);
+                auto it = backward.find(e->source);
+                if (it == backward.end()) {
+                    backward.insert(e->source, { candidate, node, e->edge, false });
+                } else if (!it->settled && candidate < it->distance) {
+                    *it = { candidate, node, e->edge, false };
+                } else {
+                    continue;
+                }
+                backwardQueue.push(QueueEntry(candidate - potential(e->source), e->source));
+
+                auto other = forward.constFind(e->source);
+                if (other != forward.constEnd() && candidate + other->distance < best) {
+                    best = candidate + other->distance;
+                    meeting = e->source;
+                }
+            }
+        }
+    }
+
+    if (meeting == QGeoRouteGraph::InvalidNode)
+        return false;
+
+    for (quint32 node = meeting; node != source; ) {
+        const SearchLabel &label = forward[node];
+        edges.append(label.edge);
+        node = label.parent;
+    }
+    std::reverse(edges.begin(), edges.end());
+    for (quint32 node = meeting; node != target; ) {
+        const SearchLabel &label = backward[node];
+        edges.append(label.edge);
+        node = label.parent;
+    }
+    return true;
+}
+
+QGeoManeuver::InstructionDirection QGeoOfflineRouter::direction(double bearingBefore,
+                                                                 double bearingAfter)
+{
+    double turn = bearingAfter - bearingBefore;
+    while (turn > 180.0)
+        turn -= 360.0;
+    while (turn <= -180.0)
+        turn += 360.0;
+
+    const double angle = qAbs(turn);
+    const bool right = turn > 0.0;
+    if (angle < 15.0)
+        return QGeoManeuver::DirectionForward;
+    if (angle < 35.0)
+        return right ? QGeoManeuver::DirectionBearRight : QGeoManeuver::DirectionBearLeft;
+    if (angle < 65.0)
+        return right ? QGeoManeuver::DirectionLightRight : QGeoManeuver::DirectionLightLeft;
+    if (angle < 120.0)
+        return right ? QGeoManeuver::DirectionRight : QGeoManeuver::DirectionLeft;
+    if (angle < 165.0)
+        return right ? QGeoManeuver::DirectionHardRight : QGeoManeuver::DirectionHardLeft;
+    return right ? QGeoManeuver::DirectionUTurnRight : QGeoManeuver::DirectionUTurnLeft;
+}
+
+QString QGeoOfflineRouter::instructionText(QGeoManeuver::InstructionDirection direction,
+                                           const QString &name, double bearing)
+{
+    const bool named = !name.isEmpty();
+    switch (direction) {
+    case QGeoManeuver::NoDirection: {
+        static const char *const headings[] = {
+            QT_TR_NOOP("north"), QT_TR_NOOP("northeast"), QT_TR_NOOP("east"),
+            QT_TR_NOOP("southeast"), QT_TR_NOOP("south"), QT_TR_NOOP("southwest"),
+            QT_TR_NOOP("west"), QT_TR_NOOP("northwest")
+        };
+        const QString heading = tr(headings[int(bearing / 45.0 + 0.5) % 8]);
+        return named ? tr("Head %1 on %2").arg(heading, name) : tr("Head %1").arg(heading);
+    }
+    case QGeoManeuver::DirectionForward:
+        return named ? tr("Continue onto %1").arg(name) : tr("Continue straight");
+    case QGeoManeuver::DirectionBearRight:
+        return named ? tr("Bear right onto %1").arg(name) : tr("Bear right");
+    case QGeoManeuver::DirectionLightRight:
+        return named ? tr("Turn slightly right onto %1").arg(name) : tr("Turn slightly right");
+    case QGeoManeuver::DirectionRight:
+        return named ? tr("Turn right onto %1").arg(name) : tr("Turn right");
+    case QGeoManeuver::DirectionHardRight:
+        return named ? tr("Turn sharp right onto %1").arg(name) : tr("Turn sharp right");
+    case QGeoManeuver::DirectionUTurnRight:
+    case QGeoManeuver::DirectionUTurnLeft:
+        return named ? tr("Make a U-turn onto %1").arg(name) : tr("Make a U-turn");
+    case QGeoManeuver::DirectionHardLeft:
+        return named ? tr("Turn sharp left onto %1").arg(name) : tr("Turn sharp left");
+    case QGeoManeuver::DirectionLeft:
+        return named ? tr("Turn left onto %1").arg(name) : tr("Turn left");
+    case QGeoManeuver::DirectionLightLeft:
+        return named ? tr("Turn slightly left onto %1").arg(name) : tr("Turn slightly left");
+    case QGeoManeuver::DirectionBearLeft:
+        return named ? tr("Bear left onto %1").arg(name) : tr("Bear left");
+    }
+    return QString();
+}
+
+/*
+    Turns the edges of one leg into route segments. A new segment, and so a
+    new maneuver, starts wherever the street name changes, or at a sharp turn
+    between two unnamed edges. Every leg ends with a zero length arrival
+    segment, as the OSRM based backends do.
+*/
+void QGeoOfflineRouter::buildLeg(quint32 source, const QVector<quint32> &edges,
+                                 const Profile &profile, const QGeoCoordinate &waypoint,
+                                 bool lastLeg, QList<QGeoRouteSegment> &segments,
+                                 QList<QGeoCoordinate> &path, double &distance,
+                                 double &travelTime) const
+{
+    const QGeoRouteGraph &graph = *m_graph;
+
+    path.reserve(edges.size() + 1);
+    path.append(coordinate(source));
+    for (quint32 e : edges)
+        path.append(coordinate(graph.edge(e).target));
+
+    distance = 0.0;
+    travelTime = 0.0;
+    int begin = 0;
+    while (begin < edges.size()) {
+        const quint32 name = graph.edge(edges.at(begin)).name;
+        double segmentDistance = 0.0;
+        double segmentTime = 0.0;
+        int end = begin;
+        while (end < edges.size()) {
+            const QGeoRouteGraph::Edge &edge = graph.edge(edges.at(end));
+            if (end > begin) {
+                if (edge.name != name)
+                    break;
+                if (name == 0) {
+                    const QGeoManeuver::InstructionDirection turn =
+                            direction(path.at(end - 1).azimuthTo(path.at(end)),
+                                      path.at(end).azimuthTo(path.at(end + 1)));
+                    if (turn != QGeoManeuver::DirectionForward
+                            && turn != QGeoManeuver::DirectionBearLeft
+                            && turn != QGeoManeuver::DirectionBearRight) {
+                        break;
+                    }
+                }
+            }
+            segmentDistance += edge.length;
+            segmentTime += this->travelTime(edge, profile);
+            ++end;
+        }
+
+        const double bearingAfter = path.at(begin).azimuthTo(path.at(begin + 1));
+        const QGeoManeuver::InstructionDirection maneuverDirection = begin == 0
+                ? QGeoManeuver::NoDirection
+                : direction(path.at(begin - 1).azimuthTo(path.at(begin)), bearingAfter);
+
+        QGeoManeuver maneuver;
+        maneuver.setDirection(maneuverDirection);
+        maneuver.setDistanceToNextInstruction(segmentDistance);
+        maneuver.setTimeToNextInstruction(qRound(segmentTime));
+        maneuver.setInstructionText(instructionText(maneuverDirection, graph.name(name), bearingAfter));
+        maneuver.setPosition(path.at(begin));
+
+        QGeoRouteSegment segment;
+        segment.setDistance(segmentDistance);
+        segment.setTravelTime(qRound(segmentTime));
+        segment.setPath(path.mid(begin, end - begin + 1));
+        segment.setManeuver(maneuver);
+        segments.append(segment);
+
+        distance += segmentDistance;
+        travelTime += segmentTime;
+        begin = end;
+    }
+
+    QGeoManeuver arrival;
+    arrival.setDirection(QGeoManeuver::NoDirection);
+    arrival.setInstructionText(lastLeg ? tr("You have arrived at your destination")
+                                       : tr("You have arrived at your waypoint"));
+    arrival.setPosition(path.last());
+    arrival.setWaypoint(waypoint);
+
+    QGeoRouteSegment segment;
+    segment.setPath(QList<QGeoCoordinate>() << path.last());
+    segment.setManeuver(arrival);
+    QGeoRouteSegmentPrivate::get(segment)->setLegLastSegment(true);
+    segments.append(segment);
+}
+
+QGeoRouteReply::Error QGeoOfflineRouter::calculateRoute(const QGeoRouteRequest &request,
+                                                        QList<QGeoRoute> &routes,
+                                                        QString &errorString) const
+{
+    const QList<QGeoCoordinate> waypoints = request.waypoints();
+    if (waypoints.size() < 2) {
+        errorString = tr("At least two waypoints are required");
+        return QGeoRouteReply::UnsupportedOptionError;
+    }
+
+    const Profile profile = QGeoOfflineRouter::profile(request);
+    if (!profile.access) {
+        errorString = tr("Unsupported travel mode");
+        return QGeoRouteReply::UnsupportedOptionError;
+    }
+
+    QVector<quint32> nodes;
+    nodes.reserve(waypoints.size());
+    for (int i = 0; i < waypoints.size(); ++i) {
+        const QGeoCoordinate &waypoint = waypoints.at(i);
+        const quint32 node = m_graph->nearestNode(waypoint.latitude(), waypoint.longitude(),
+                                                  profile.access, m_snapDistance);
+        if (node == QGeoRouteGraph::InvalidNode) {
+            errorString = tr("No road within %1 m of waypoint %2").arg(m_snapDistance).arg(i + 1);
+            return QGeoRouteReply::UnknownError;
+        }
+        nodes.append(node);
+    }
+
+    QGeoRoute route;
+    QList<QGeoRouteLeg> legs;
+    QList<QGeoRouteSegment> segments;
+    QList<QGeoCoordinate> path;
+    double distance = 0.0;
+    double travelTime = 0.0;
+    QVector<quint32> edges;
+    for (int legIndex = 0; legIndex + 1 < nodes.size(); ++legIndex) {
+        if (!findPath(nodes.at(legIndex), nodes.at(legIndex + 1), profile, edges)) {
+            errorString = tr("No route found between waypoints %1 and %2")
+                    .arg(legIndex + 1).arg(legIndex + 2);
+            return QGeoRouteReply::UnknownError;
+        }
+
+        QList<QGeoRouteSegment> legSegments;
+        QList<QGeoCoordinate> legPath;
+        double legDistance = 0.0;
+        double legTravelTime = 0.0;
+        buildLeg(nodes.at(legIndex), edges, profile, waypoints.at(legIndex + 1),
+                 legIndex + 2 == nodes.size(), legSegments, legPath, legDistance, legTravelTime);
+
+        QGeoRouteLeg leg;
+        leg.setLegIndex(legIndex);
+        leg.setOverallRoute(route); // explicitly shared, filled in below
+        leg.setDistance(legDistance);
+        leg.setTravelTime(qRound(legTravelTime));
+        leg.setTravelMode(profile.travelMode);
+        leg.setPath(legPath);
+        leg.setBounds(QGeoPath(legPath).boundingGeoRectangle());
+        leg.setFirstRouteSegment(legSegments.first());
+        legs.append(leg);
+
+        // Consecutive legs share the waypoint node.
+        if (!path.isEmpty())
+            legPath.removeFirst();
+        path.append(legPath);
+        segments.append(legSegments);
+        distance += legDistance;
+        travelTime += legTravelTime;
+    }
+
+    for (int i = segments.size() - 1; i > 0; --i)
+        segments[i - 1].setNextRouteSegment(segments[i]);
+
+    route.setRequest(request);
+    route.setTravelMode(profile.travelMode);
+    route.setDistance(distance);
+    route.setTravelTime(qRound(travelTime));
+    route.setPath(path);
+    route.setBounds(QGeoPath(path).boundingGeoRectangle());
+    route.setFirstRouteSegment(segments.first());
+    route.setRouteLegs(legs);
+    routes.append(route);
+    return QGeoRouteReply::NoError;
+}
+
+QT_END_NAMESPACE
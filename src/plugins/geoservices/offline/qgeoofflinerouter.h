@@ -0,0 +1,103 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOOFFLINEROUTER_H
+#define QGEOOFFLINEROUTER_H
+
+#include "qgeoroutegraph.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtLocation/QGeoManeuver>
+#include <QtLocation/QGeoRouteReply>
+#include <QtLocation/QGeoRouteRequest>
+#include <QtLocation/QGeoRouteSegment>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Point to point queries over a QGeoRouteGraph.
+
+    Each leg is searched with a bidirectional A* using the average of the
+    forward and backward great circle potentials, which keeps both searches
+    consistent so they can stop as soon as their frontiers prove the best
+    meeting point optimal. The router holds no per-query state and can be
+    used from several worker threads at once.
+*/
+class QGeoOfflineRouter
+{
+    Q_DECLARE_TR_FUNCTIONS(QGeoOfflineRouter)
+
+public:
+    struct Profile
+    {
+        QGeoRouteRequest::TravelMode travelMode = QGeoRouteRequest::CarTravel;
+        int access = 0;             // QGeoRouteGraph::AccessFlag
+        bool shortest = false;      // minimize distance instead of travel time
+        double speedLimit = 0.0;    // m/s cap applied to edge speeds, 0 for none
+    };
+
+    QGeoOfflineRouter(const QSharedPointer<const QGeoRouteGraph> &graph, double snapDistance);
+
+    QGeoRouteReply::Error calculateRoute(const QGeoRouteRequest &request,
+                                         QList<QGeoRoute> &routes, QString &errorString) const;
+
+    static Profile profile(const QGeoRouteRequest &request);
+    bool findPath(quint32 source, quint32 target, const Profile &profile,
+                  QVector<quint32> &edges) const;
+
+private:
+    double travelTime(const QGeoRouteGraph::Edge &edge, const Profile &profile) const;
+    double cost(const QGeoRouteGraph::Edge &edge, const Profile &profile) const;
+    QGeoCoordinate coordinate(quint32 node) const;
+    void buildLeg(quint32 source, const QVector<quint32> &edges, const Profile &profile,
+                  const QGeoCoordinate &waypoint, bool lastLeg,
+                  QList<QGeoRouteSegment> &segments, QList<QGeoCoordinate> &path,
+                  double &distance, double &travelTime) const;
+
+    static QGeoManeuver::InstructionDirection direction(double bearingBefore, double bearingAfter);
+    static QString instructionText(QGeoManeuver::InstructionDirection direction,
+                                   const QString &name, double bearing);
+
+    QSharedPointer<const QGeoRouteGraph> m_graph;
+    double m_snapDistance;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOOFFLINEROUTER_H
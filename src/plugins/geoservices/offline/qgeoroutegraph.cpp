@@ -0,0 +1,525 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeoroutegraph.h"
+
+#include <QtCore/QSaveFile>
+#include <QtCore/QtMath>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+const char Magic[4] = { 'Q', 'G', 'R', 'G' };
+const quint32 ByteOrderMark = 0x01020304;
+const quint32 FormatVersion = 1;
+
+const double EarthMeanRadius = 6371007.2; // same as QtPositioning
+const double MetresPerDegree = EarthMeanRadius * M_PI / 180.0;
+
+enum Section {
+    NodesSection,
+    FirstEdgeSection,
+    EdgesSection,
+    FirstInEdgeSection,
+    InEdgesSection,
+    FirstCellNodeSection,
+    CellNodesSection,
+    NamesSection,
+    SectionCount
+};
+
+struct FileHeader
+{
+    char magic[4];
+    quint32 byteOrder;
+    quint32 version;
+    quint32 nodeCount;
+    quint32 edgeCount;
+    quint32 namesSize;
+    quint32 maximumSpeed;
+    qint32 gridLatitude;   // south-west corner of the grid, microdegrees
+    qint32 gridLongitude;
+    qint32 gridCellSize;   // microdegrees
+    qint32 gridColumns;
+    qint32 gridRows;
+    quint64 sections[SectionCount]; // offsets from the start of the file, 8 byte aligned
+};
+
+Q_STATIC_ASSERT(sizeof(QGeoRouteGraph::Node) == 8);
+Q_STATIC_ASSERT(sizeof(QGeoRouteGraph::Edge) == 16);
+Q_STATIC_ASSERT(sizeof(QGeoRouteGraph::InEdge) == 8);
+Q_STATIC_ASSERT(sizeof(FileHeader) % 8 == 0);
+
+inline qint32 toMicrodegrees(double degrees)
+{
+    return qint32(qRound64(degrees * 1e6));
+}
+
+} // namespace
+
+QGeoRouteGraph::QGeoRouteGraph()
+{
+}
+
+QGeoRouteGraph::~QGeoRouteGraph()
+{
+    if (m_data)
+        m_file.unmap(const_cast<uchar *>(m_data));
+}
+
+QSharedPointer<const QGeoRouteGraph> QGeoRouteGraph::open(const QString &fileName,
+                                                         QString *errorString)
+{
+    QSharedPointer<QGeoRouteGraph> graph(new QGeoRouteGraph);
+    graph->m_file.setFileName(fileName);
+    if (!graph->m_file.open(QIODevice::ReadOnly)) {
+        *errorString = graph->m_file.errorString();
+        return QSharedPointer<const QGeoRouteGraph>();
+    }
+    if (!graph->load(errorString))
+        return QSharedPointer<const QGeoRouteGraph>();
+    return graph;
+}
+
+bool QGeoRouteGraph::load(QString *errorString)
+{
+    m_size = m_file.size();
+    if (m_size < qint64(sizeof(FileHeader))) {
+        *errorString = QStringLiteral("File is too small to be a road graph");
+        return false;
+    }
+
+    m_data = m_file.map(0, m_size);
+    if (!m_data) {
+        *errorString = m_file.errorString();
+        return false;
+    }
+
+    const FileHeader *header = reinterpret_cast<const FileHeader *>(m_data);
+    if (memcmp(header->magic, Magic, sizeof(Magic)) != 0) {
+        *errorString = QStringLiteral("Not a road graph file");
+        return false;
+    }
+    if (header->byteOrder != ByteOrderMark) {
+        *errorString = QStringLiteral("Road graph was built for a different byte order");
+        return false;
+    }
+    if (header->version != FormatVersion) {
+        *errorString = QStringLiteral("Unsupported road graph version %1").arg(header->version);
+        return false;
+    }
+    if (header->gridCellSize <= 0 || header->gridColumns < 0 || header->gridRows < 0) {
+        *errorString = QStringLiteral("Corrupt road graph spatial index");
+        return false;
+    }
+
+    m_nodeCount = header->nodeCount;
+    m_edgeCount = header->edgeCount;
+    m_namesSize = header->namesSize;
+    m_maximumSpeed = int(header->maximumSpeed);
+    m_gridLatitude = header->gridLatitude;
+    m_gridLongitude = header->gridLongitude;
+    m_gridCellSize = header->gridCellSize;
+    m_gridColumns = header->gridColumns;
+    m_gridRows = header->gridRows;
+
+    const quint64 cellCount = quint64(m_gridColumns) * quint64(m_gridRows);
+    const quint64 sizes[SectionCount] = {
+        quint64(m_nodeCount) * sizeof(Node),
+        (quint64(m_nodeCount) + 1) * sizeof(quint32),
+        quint64(m_edgeCount) * sizeof(Edge),
+        (quint64(m_nodeCount) + 1) * sizeof(quint32),
+        quint64(m_edgeCount) * sizeof(InEdge),
+        (cellCount + 1) * sizeof(quint32),
+        quint64(m_nodeCount) * sizeof(quint32),
+        quint64(m_namesSize)
+    };
+    for (int i = 0; i < SectionCount; ++i) {
+        const quint64 offset = header->sections[i];
+        if (offset % 8 != 0 || offset > quint64(m_size) || sizes[i] > quint64(m_size) - offset) {
+            *errorString = QStringLiteral("Corrupt road graph, section %1 is out of bounds").arg(i);
+            return false;
+        }
+    }
+
+    m_nodes = reinterpret_cast<const Node *>(m_data + header->sections[NodesSection]);
+    m_firstEdge = reinterpret_cast<const quint32 *>(m_data + header->sections[FirstEdgeSection]);
+    m_edges = reinterpret_cast<const Edge *>(m_data + header->sections[EdgesSection]);
+    m_firstInEdge = reinterpret_cast<const quint32 *>(m_data + header->sections[FirstInEdgeSection]);
+    m_inEdges = reinterpret_cast<const InEdge *>(m_data + header->sections[InEdgesSection]);
+    m_firstCellNode = reinterpret_cast<const quint32 *>(m_data + header->sections[FirstCellNodeSection]);
+    m_cellNodes = reinterpret_cast<const quint32 *>(m_data + header->sections[CellNodesSection]);
+    m_names = reinterpret_cast<const char *>(m_data + header->sections[NamesSection]);
+
+    // The contents are trusted beyond these structural checks; validating
+    // every index would fault in the whole file on load.
+    if (m_firstEdge[m_nodeCount] != m_edgeCount || m_firstInEdge[m_nodeCount] != m_edgeCount
+            || m_firstCellNode[cellCount] != m_nodeCount
+            || m_namesSize == 0 || m_names[m_namesSize - 1] != '\0') {
+        *errorString = QStringLiteral("Corrupt road graph index");
+        return false;
+    }
+
+    return true;
+}
+
+quint32 QGeoRouteGraph::nodeCount() const
+{
+    return m_nodeCount;
+}
+
+quint32 QGeoRouteGraph::edgeCount() const
+{
+    return m_edgeCount;
+}
+
+/*
+    Highest edge speed in km/h, used to keep the A* heuristic admissible.
+*/
+int QGeoRouteGraph::maximumSpeed() const
+{
+    return m_maximumSpeed;
+}
+
+double QGeoRouteGraph::latitude(quint32 node) const
+{
+    return m_nodes[node].latitude * 1e-6;
+}
+
+double QGeoRouteGraph::longitude(quint32 node) const
+{
+    return m_nodes[node].longitude * 1e-6;
+}
+
+const QGeoRouteGraph::Edge &QGeoRouteGraph::edge(quint32 index) const
+{
+    return m_edges[index];
+}
+
+const QGeoRouteGraph::Edge *QGeoRouteGraph::edgesBegin(quint32 node) const
+{
+    return m_edges + m_firstEdge[node];
+}
+
+const QGeoRouteGraph::Edge *QGeoRouteGraph::edgesEnd(quint32 node) const
+{
+    return m_edges + m_firstEdge[node + 1];
+}
+
+quint32 QGeoRouteGraph::edgeIndex(const Edge *edge) const
+{
+    return quint32(edge - m_edges);
+}
+
+const QGeoRouteGraph::InEdge *QGeoRouteGraph::inEdgesBegin(quint32 node) const
+{
+    return m_inEdges + m_firstInEdge[node];
+}
+
+const QGeoRouteGraph::InEdge *QGeoRouteGraph::inEdgesEnd(quint32 node) const
+{
+    return m_inEdges + m_firstInEdge[node + 1];
+}
+
+QString QGeoRouteGraph::name(quint32 offset) const
+{
+    if (offset == 0 || offset >= m_namesSize)
+        return QString();
+    return QString::fromUtf8(m_names + offset);
+}
+
+bool QGeoRouteGraph::reachable(quint32 node, int access) const
+{
+    for (const Edge *e = edgesBegin(node), *end = edgesEnd(node); e != end; ++e) {
+        if (e->access & access)
+            return true;
+    }
+    for (const InEdge *e = inEdgesBegin(node), *end = inEdgesEnd(node); e != end; ++e) {
+        if (m_edges[e->edge].access & access)
+            return true;
+    }
+    return false;
+}
+
+/*
+    Returns the node closest to the given coordinate that has at least one
+    edge usable with \a access, or InvalidNode if there is none within
+    \a maximumDistance metres.
+
+    Grid cells are visited in rings of increasing size around the cell
+    containing the coordinate, stopping as soon as a ring cannot contain
+    anything closer than the best node found so far.
+*/
+quint32 QGeoRouteGraph::nearestNode(double latitude, double longitude, int access,
+                                    double maximumDistance) const
+{
+    if (m_nodeCount == 0 || m_gridColumns == 0 || m_gridRows == 0)
+        return InvalidNode;
+
+    const qint64 cellX = qFloor((longitude * 1e6 - m_gridLongitude) / m_gridCellSize);
+    const qint64 cellY = qFloor((latitude * 1e6 - m_gridLatitude) / m_gridCellSize);
+    const qint64 lastRing = qMax(qMax(cellX, m_gridColumns - 1 - cellX),
+                                 qMax(cellY, m_gridRows - 1 - cellY));
+    const double cellDegrees = m_gridCellSize * 1e-6;
+
+    quint32 best = InvalidNode;
+    double bestDistance = maximumDistance;
+    for (qint64 ring = 0; ring <= lastRing; ++ring) {
+        if (ring > 1) {
+            // Cells are narrowest in the east-west direction on the poleward side of the ring.
+            const double poleward = qMin(qAbs(latitude) + ring * cellDegrees, 89.0);
+            const double reach = (ring - 1) * cellDegrees * MetresPerDegree
+                    * qCos(qDegreesToRadians(poleward));
+            if (reach > bestDistance)
+                break;
+        }
+
+        for (qint64 y = cellY - ring; y <= cellY + ring; ++y) {
+            if (y < 0 || y >= m_gridRows)
+                continue;
+            const bool fullRow = ring == 0 || y == cellY - ring || y == cellY + ring;
+            const qint64 step = fullRow ? 1 : 2 * ring;
+            for (qint64 x = cellX - ring; x <= cellX + ring; x += step) {
+                if (x < 0 || x >= m_gridColumns)
+                    continue;
+                const qint64 cell = y * m_gridColumns + x;
+                for (quint32 i = m_firstCellNode[cell]; i < m_firstCellNode[cell + 1]; ++i) {
+                    const quint32 node = m_cellNodes[i];
+                    const double d = distance(latitude, longitude,
+                                              this->latitude(node), this->longitude(node));
+                    if (d < bestDistance && reachable(node, access)) {
+                        best = node;
+                        bestDistance = d;
+                    }
+                }
+            }
+        }
+    }
+
+    return best;
+}
+
+/*
+    Haversine distance in metres.
+*/
+double QGeoRouteGraph::distance(double latitude1, double longitude1,
+                                double latitude2, double longitude2)
+{
+    const double dlat = qDegreesToRadians(latitude2 - latitude1);
+    const double dlon = qDegreesToRadians(longitude2 - longitude1);
+    const double haversineDlat = qSin(dlat / 2.0);
+    const double haversineDlon = qSin(dlon / 2.0);
+    const double y = haversineDlat * haversineDlat
+            + qCos(qDegreesToRadians(latitude1)) * qCos(qDegreesToRadians(latitude2))
+            * haversineDlon * haversineDlon;
+    return 2.0 * EarthMeanRadius * qAsin(qSqrt(qMin(y, 1.0)));
+}
+
+quint32 QGeoRouteGraphWriter::addNode(double latitude, double longitude)
+{
+    QGeoRouteGraph::Node node;
+    node.latitude = toMicrodegrees(latitude);
+    node.longitude = toMicrodegrees(longitude);
+    m_nodes.append(node);
+    return quint32(m_nodes.size() - 1);
+}
+
+void QGeoRouteGraphWriter::addEdge(quint32 from, quint32 to, int access, int speed,
+                                   const QString &name)
+{
+    Q_ASSERT(from < quint32(m_nodes.size()) && to < quint32(m_nodes.size()));
+
+    quint32 nameOffset = 0;
+    if (!name.isEmpty()) {
+        auto it = m_nameOffsets.constFind(name);
+        if (it == m_nameOffsets.constEnd()) {
+            nameOffset = quint32(m_names.size());
+            m_names.append(name.toUtf8());
+            m_names.append('\0');
+            m_nameOffsets.insert(name, nameOffset);
+        } else {
+            nameOffset = it.value();
+        }
+    }
+
+    const QGeoRouteGraph::Node &a = m_nodes.at(from);
+    const QGeoRouteGraph::Node &b = m_nodes.at(to);
+
+    PendingEdge pending;
+    pending.source = from;
+    pending.edge.target = to;
+    pending.edge.name = nameOffset;
+    pending.edge.length = float(QGeoRouteGraph::distance(a.latitude * 1e-6, a.longitude * 1e-6,
+                                                         b.latitude * 1e-6, b.longitude * 1e-6));
+    pending.edge.speed = quint8(qBound(1, speed, 255));
+    pending.edge.access = quint8(access);
+    pending.edge.reserved = 0;
+    m_edges.append(pending);
+}
+
+quint32 QGeoRouteGraphWriter::nodeCount() const
+{
+    return quint32(m_nodes.size());
+}
+
+quint32 QGeoRouteGraphWriter::edgeCount() const
+{
+    return quint32(m_edges.size());
+}
+
+bool QGeoRouteGraphWriter::write(const QString &fileName, QString *errorString) const
+{
+    const quint32 nodeCount = quint32(m_nodes.size());
+    const quint32 edgeCount = quint32(m_edges.size());
+
+    // Forward and reverse adjacency arrays, both counting sorts that keep
+    // the insertion order of the edges of a node.
+    QVector<quint32> firstEdge(int(nodeCount) + 1, 0);
+    QVector<quint32> firstInEdge(int(nodeCount) + 1, 0);
+    quint32 maximumSpeed = 1;
+    for (const PendingEdge &e : m_edges) {
+        ++firstEdge[int(e.source) + 1];
+        ++firstInEdge[int(e.edge.target) + 1];
+        maximumSpeed = qMax<quint32>(maximumSpeed, e.edge.speed);
+    }
+    for (quint32 i = 0; i < nodeCount; ++i) {
+        firstEdge[int(i) + 1] += firstEdge[int(i)];
+        firstInEdge[int(i) + 1] += firstInEdge[int(i)];
+    }
+
+    QVector<QGeoRouteGraph::Edge> edges(int(edgeCount));
+    QVector<quint32> edgeSlot(firstEdge);
+    for (const PendingEdge &e : m_edges)
+        edges[int(edgeSlot[int(e.source)]++)] = e.edge;
+
+    QVector<QGeoRouteGraph::InEdge> inEdges(int(edgeCount));
+    QVector<quint32> inEdgeSlot(firstInEdge);
+    for (quint32 source = 0; source < nodeCount; ++source) {
+        for (quint32 i = firstEdge.at(int(source)); i < firstEdge.at(int(source) + 1); ++i) {
+            QGeoRouteGraph::InEdge &in = inEdges[int(inEdgeSlot[int(edges.at(int(i)).target)]++)];
+            in.source = source;
+            in.edge = i;
+        }
+    }
+
+    // Uniform grid over the bounding box, sized for a handful of nodes per cell.
+    qint32 minLatitude = 0, minLongitude = 0, maxLatitude = 0, maxLongitude = 0;
+    if (nodeCount) {
+        minLatitude = maxLatitude = m_nodes.first().latitude;
+        minLongitude = maxLongitude = m_nodes.first().longitude;
+        for (const QGeoRouteGraph::Node &n : m_nodes) {
+            minLatitude = qMin(minLatitude, n.latitude);
+            maxLatitude = qMax(maxLatitude, n.latitude);
+            minLongitude = qMin(minLongitude, n.longitude);
+            maxLongitude = qMax(maxLongitude, n.longitude);
+        }
+    }
+    const double area = (double(maxLatitude) - minLatitude + 1) * (double(maxLongitude) - minLongitude + 1);
+    const qint32 cellSize = qMax(500, qCeil(qSqrt(area / qMax(1u, nodeCount / 4))));
+    const qint32 columns = nodeCount ? qint32((qint64(maxLongitude) - minLongitude) / cellSize + 1) : 0;
+    const qint32 rows = nodeCount ? qint32((qint64(maxLatitude) - minLatitude) / cellSize + 1) : 0;
+    const int cellCount = columns * rows;
+
+    QVector<quint32> firstCellNode(cellCount + 1, 0);
+    QVector<quint32> nodeCells(int(nodeCount));
+    for (quint32 i = 0; i < nodeCount; ++i) {
+        const QGeoRouteGraph::Node &n = m_nodes.at(int(i));
+        const int cell = int((qint64(n.latitude) - minLatitude) / cellSize) * columns
+                + int((qint64(n.longitude) - minLongitude) / cellSize);
+        nodeCells[int(i)] = quint32(cell);
+        ++firstCellNode[cell + 1];
+    }
+    for (int i = 0; i < cellCount; ++i)
+        firstCellNode[i + 1] += firstCellNode[i];
+    QVector<quint32> cellNodes(int(nodeCount));
+    QVector<quint32> cellSlot(firstCellNode);
+    for (quint32 i = 0; i < nodeCount; ++i)
+        cellNodes[int(cellSlot[int(nodeCells.at(int(i)))]++)] = i;
+
+    FileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, Magic, sizeof(Magic));
+    header.byteOrder = ByteOrderMark;
+    header.version = FormatVersion;
+    header.nodeCount = nodeCount;
+    header.edgeCount = edgeCount;
+    header.namesSize = quint32(m_names.size());
+    header.maximumSpeed = maximumSpeed;
+    header.gridLatitude = minLatitude;
+    header.gridLongitude = minLongitude;
+    header.gridCellSize = cellSize;
+    header.gridColumns = columns;
+    header.gridRows = rows;
+
+    const QPair<const void *, qint64> sections[SectionCount] = {
+        { m_nodes.constData(), qint64(nodeCount) * qint64(sizeof(QGeoRouteGraph::Node)) },
+        { firstEdge.constData(), qint64(firstEdge.size()) * qint64(sizeof(quint32)) },
+        { edges.constData(), qint64(edgeCount) * qint64(sizeof(QGeoRouteGraph::Edge)) },
+        { firstInEdge.constData(), qint64(firstInEdge.size()) * qint64(sizeof(quint32)) },
+        { inEdges.constData(), qint64(edgeCount) * qint64(sizeof(QGeoRouteGraph::InEdge)) },
+        { firstCellNode.constData(), qint64(firstCellNode.size()) * qint64(sizeof(quint32)) },
+        { cellNodes.constData(), qint64(nodeCount) * qint64(sizeof(quint32)) },
+        { m_names.constData(), qint64(m_names.size()) }
+    };
+    quint64 offset = sizeof(FileHeader);
+    for (int i = 0; i < SectionCount; ++i) {
+        header.sections[i] = offset;
+        offset += (quint64(sections[i].second) + 7) & ~quint64(7);
+    }
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        *errorString = file.errorString();
+        return false;
+    }
+    static const char padding[8] = {};
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    for (int i = 0; i < SectionCount; ++i) {
+        file.write(static_cast<const char *>(sections[i].first), sections[i].second);
+        file.write(padding, ((sections[i].second + 7) & ~qint64(7)) - sections[i].second);
+    }
+    if (!file.commit()) {
+        *errorString = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+QT_END_NAMESPACE
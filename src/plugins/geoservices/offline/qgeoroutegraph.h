@@ -0,0 +1,179 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOROUTEGRAPH_H
+#define QGEOROUTEGRAPH_H
+
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Read-only view of a road graph file produced by QGeoRouteGraphWriter.
+
+    The file is memory mapped and used in place: node coordinates, forward
+    and reverse adjacency arrays (CSR), a uniform grid used to snap
+    coordinates to the network and a blob of UTF-8 street names. Nothing is
+    copied on load, so opening a country sized graph is cheap and the pages
+    are shared between processes using the same file.
+
+    All accessors are const and the object can be used from any thread.
+*/
+class QGeoRouteGraph
+{
+public:
+    enum AccessFlag {
+        CarAccess = 0x1,
+        BicycleAccess = 0x2,
+        PedestrianAccess = 0x4
+    };
+
+    struct Node
+    {
+        qint32 latitude;  // microdegrees
+        qint32 longitude; // microdegrees
+    };
+
+    struct Edge
+    {
+        quint32 target;
+        quint32 name;     // offset into the names blob, 0 for unnamed roads
+        float length;     // metres
+        quint8 speed;     // km/h
+        quint8 access;    // AccessFlag
+        quint16 reserved;
+    };
+
+    struct InEdge
+    {
+        quint32 source;
+        quint32 edge;     // index of the forward edge
+    };
+
+    static const quint32 InvalidNode = 0xffffffff;
+
+    static QSharedPointer<const QGeoRouteGraph> open(const QString &fileName, QString *errorString);
+    ~QGeoRouteGraph();
+
+    quint32 nodeCount() const;
+    quint32 edgeCount() const;
+    int maximumSpeed() const;
+
+    double latitude(quint32 node) const;
+    double longitude(quint32 node) const;
+
+    const Edge &edge(quint32 index) const;
+    const Edge *edgesBegin(quint32 node) const;
+    const Edge *edgesEnd(quint32 node) const;
+    quint32 edgeIndex(const Edge *edge) const;
+    const InEdge *inEdgesBegin(quint32 node) const;
+    const InEdge *inEdgesEnd(quint32 node) const;
+
+    QString name(quint32 offset) const;
+
+    quint32 nearestNode(double latitude, double longitude, int access,
+                        double maximumDistance) const;
+
+    static double distance(double latitude1, double longitude1,
+                           double latitude2, double longitude2);
+
+private:
+    QGeoRouteGraph();
+    bool load(QString *errorString);
+    bool reachable(quint32 node, int access) const;
+
+    QFile m_file;
+    qint64 m_size = 0;
+    const uchar *m_data = nullptr;
+    quint32 m_nodeCount = 0;
+    quint32 m_edgeCount = 0;
+    quint32 m_namesSize = 0;
+    int m_maximumSpeed = 0;
+    qint32 m_gridLatitude = 0;
+    qint32 m_gridLongitude = 0;
+    qint32 m_gridCellSize = 1;
+    qint32 m_gridColumns = 0;
+    qint32 m_gridRows = 0;
+    const Node *m_nodes = nullptr;
+    const quint32 *m_firstEdge = nullptr;
+    const Edge *m_edges = nullptr;
+    const quint32 *m_firstInEdge = nullptr;
+    const InEdge *m_inEdges = nullptr;
+    const quint32 *m_firstCellNode = nullptr;
+    const quint32 *m_cellNodes = nullptr;
+    const char *m_names = nullptr;
+
+    Q_DISABLE_COPY(QGeoRouteGraph)
+};
+
+/*
+    Builds a road graph in memory and serializes it in the format read by
+    QGeoRouteGraph. Used by the qgeoofflinedata tool and by the tests.
+*/
+class QGeoRouteGraphWriter
+{
+public:
+    quint32 addNode(double latitude, double longitude);
+    void addEdge(quint32 from, quint32 to, int access, int speed, const QString &name);
+
+    quint32 nodeCount() const;
+    quint32 edgeCount() const;
+
+    bool write(const QString &fileName, QString *errorString) const;
+
+private:
+    struct PendingEdge
+    {
+        quint32 source;
+        QGeoRouteGraph::Edge edge;
+    };
+
+    QVector<QGeoRouteGraph::Node> m_nodes;
+    QVector<PendingEdge> m_edges;
+    QByteArray m_names = QByteArray(1, '\0');
+    QHash<QString, quint32> m_nameOffsets;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOROUTEGRAPH_H
@@ -0,0 +1,167 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeoroutingmanagerengineoffline.h"
+#include "qgeoroutereplyoffline.h"
+#include "qgeoofflinerouter.h"
+
+#include <QtLocation/QGeoRoute>
+#include <QtLocation/QGeoRouteLeg>
+#include <QtPositioning/private/qgeogreatcircle_p.h>
+
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+QGeoRoutingManagerEngineOffline::QGeoRoutingManagerEngineOffline(const QVariantMap &parameters,
+                                                                 QGeoServiceProvider::Error *error,
+                                                                 QString *errorString)
+:   QGeoRoutingManagerEngine(parameters)
+{
+    const QString graphFile = parameters.value(QStringLiteral("offline.routing.graph")).toString();
+    if (graphFile.isEmpty()) {
+        *error = QGeoServiceProvider::MissingRequiredParameterError;
+        *errorString = QStringLiteral("The offline.routing.graph parameter is required for routing");
+        return;
+    }
+
+    QString graphError;
+    QSharedPointer<const QGeoRouteGraph> graph = QGeoRouteGraph::open(graphFile, &graphError);
+    if (!graph) {
+        *error = QGeoServiceProvider::NotSupportedError;
+        *errorString = QStringLiteral("Unable to load road graph %1: %2").arg(graphFile, graphError);
+        return;
+    }
+
+    double snapDistance = 1000.0;
+    if (parameters.contains(QStringLiteral("offline.routing.snap_distance")))
+        snapDistance = parameters.value(QStringLiteral("offline.routing.snap_distance")).toDouble();
+
+    m_router.reset(new QGeoOfflineRouter(graph, snapDistance));
+
+    setSupportedTravelModes(QGeoRouteRequest::CarTravel
+                            | QGeoRouteRequest::PedestrianTravel
+                            | QGeoRouteRequest::BicycleTravel);
+    setSupportedRouteOptimizations(QGeoRouteRequest::ShortestRoute
+                                   | QGeoRouteRequest::FastestRoute);
+    setSupportedSegmentDetails(QGeoRouteRequest::BasicSegmentData);
+    setSupportedManeuverDetails(QGeoRouteRequest::BasicManeuvers);
+
+    *error = QGeoServiceProvider::NoError;
+    errorString->clear();
+}
+
+QGeoRoutingManagerEngineOffline::~QGeoRoutingManagerEngineOffline()
+{
+}
+
+QGeoRouteReply *QGeoRoutingManagerEngineOffline::calculateRoute(const QGeoRouteRequest &request)
+{
+    QGeoRouteReply *routeReply = new QGeoRouteReplyOffline(m_router, request, this);
+
+    connect(routeReply, SIGNAL(finished()), this, SLOT(replyFinished()));
+    connect(routeReply, SIGNAL(error(QGeoRouteReply::Error,QString)),
+            this, SLOT(replyError(QGeoRouteReply::Error,QString)));
+
+    return routeReply;
+}
+
+/*
+    Reroutes from \a position through the waypoints that have not been
+    reached yet. The leg being travelled is the one whose path passes
+    closest to \a position; ties go to the later leg, so being at a
+    waypoint counts as having reached it.
+*/
+QGeoRouteReply *QGeoRoutingManagerEngineOffline::updateRoute(const QGeoRoute &route,
+                                                             const QGeoCoordinate &position)
+{
+    QGeoRouteRequest request = route.request();
+    const QList<QGeoCoordinate> waypoints = request.waypoints();
+    if (waypoints.size() < 2 || !position.isValid()) {
+        return new QGeoRouteReply(QGeoRouteReply::UnsupportedOptionError,
+                                  QStringLiteral("The route to update has no waypoints."), this);
+    }
+
+    int currentLeg = 0;
+    double closest = std::numeric_limits<double>::infinity();
+    QVector<double> distances;
+    const QList<QGeoRouteLeg> legs = route.routeLegs();
+    for (const QGeoRouteLeg &leg : legs) {
+        const QList<QGeoCoordinate> path = leg.path();
+        const QVector<double> latLng = QGeoGreatCircle::pack(path);
+        distances.resize(path.size());
+        QGeoGreatCircle::distancesFrom(position, latLng.constData(), path.size(),
+                                       distances.data(), QGeoGreatCircle::Approximate);
+        for (double distance : qAsConst(distances)) {
+            if (distance <= closest) {
+                closest = distance;
+                currentLeg = leg.legIndex();
+            }
+        }
+    }
+
+    QList<QGeoCoordinate> remaining;
+    remaining.reserve(waypoints.size() - currentLeg);
+    remaining.append(position);
+    remaining.append(waypoints.mid(currentLeg + 1));
+    request.setWaypoints(remaining);
+
+    const QList<QVariantMap> metadata = request.waypointsMetadata();
+    if (metadata.size() == waypoints.size())
+        request.setWaypointsMetadata(QList<QVariantMap>() << QVariantMap() << metadata.mid(currentLeg + 1));
+
+    return calculateRoute(request);
+}
+
+void QGeoRoutingManagerEngineOffline::replyFinished()
+{
+    QGeoRouteReply *reply = qobject_cast<QGeoRouteReply *>(sender());
+    if (reply)
+        emit finished(reply);
+}
+
+void QGeoRoutingManagerEngineOffline::replyError(QGeoRouteReply::Error errorCode,
+                                                 const QString &errorString)
+{
+    QGeoRouteReply *reply = qobject_cast<QGeoRouteReply *>(sender());
+    if (reply)
+        emit error(reply, errorCode, errorString);
+}
+
+QT_END_NAMESPACE
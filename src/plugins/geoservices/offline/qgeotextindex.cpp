@@ -0,0 +1,199 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeotextindex.h"
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+void QGeoTextIndex::setTables(const Tables &tables)
+{
+    m_tables = tables;
+}
+
+/*
+    Returns the documents sharing at least half of the trigrams of \a text,
+    best matches first. The last word of \a text is matched as a prefix, so
+    partially typed queries find complete names.
+
+    Posting lists are merged from the shortest one; once the remaining lists
+    are too few for a new document to reach the threshold, only documents
+    already seen are counted.
+*/
+QVector<QGeoTextIndex::Match> QGeoTextIndex::search(const QString &text) const
+{
+    QVector<Match> matches;
+    const QVector<quint64> query = trigrams(normalize(text), true);
+    if (query.isEmpty() || !m_tables.keyCount)
+        return matches;
+
+    struct PostingList
+    {
+        const quint32 *begin;
+        const quint32 *end;
+    };
+    QVector<PostingList> lists;
+    lists.reserve(query.size());
+    const quint64 *keysEnd = m_tables.keys + m_tables.keyCount;
+    for (quint64 key : query) {
+        const quint64 *it = std::lower_bound(m_tables.keys, keysEnd, key);
+        if (it != keysEnd && *it == key) {
+            const quint32 i = quint32(it - m_tables.keys);
+            lists.append({ m_tables.postings + m_tables.firstPosting[i],
+                           m_tables.postings + m_tables.firstPosting[i + 1] });
+        }
+    }
+
+    const int minimumHits = qMax(1, (query.size() + 1) / 2);
+    if (lists.size() < minimumHits)
+        return matches;
+    std::sort(lists.begin(), lists.end(), [](const PostingList &a, const PostingList &b) {
+        return a.end - a.begin < b.end - b.begin;
+    });
+
+    QHash<quint32, int> hits;
+    for (int i = 0; i < lists.size(); ++i) {
+        const bool admitNew = i <= lists.size() - minimumHits;
+        for (const quint32 *p = lists.at(i).begin; p != lists.at(i).end; ++p) {
+            if (admitNew) {
+                ++hits[*p];
+            } else {
+                auto it = hits.find(*p);
+                if (it != hits.end())
+                    ++it.value();
+            }
+        }
+    }
+
+    for (auto it = hits.constBegin(); it != hits.constEnd(); ++it) {
+        if (it.value() < minimumHits)
+            continue;
+        const int documentTrigrams = m_tables.documentTrigrams[it.key()];
+        const double score = double(it.value())
+                / qMax(1, query.size() + documentTrigrams - it.value());
+        matches.append({ it.key(), qMin(score, 1.0) });
+    }
+    std::sort(matches.begin(), matches.end(), [](const Match &a, const Match &b) {
+        return a.score > b.score || (a.score == b.score && a.document < b.document);
+    });
+    return matches;
+}
+
+/*
+    Case folds \a text, strips diacritics and replaces everything that is not
+    a letter or a digit with single spaces.
+*/
+QString QGeoTextIndex::normalize(const QString &text)
+{
+    const QString decomposed = text.normalized(QString::NormalizationForm_KD);
+    QString result;
+    result.reserve(decomposed.size());
+    bool space = true;
+    for (const QChar c : decomposed) {
+        if (c.isMark())
+            continue;
+        if (c.isLetterOrNumber()) {
+            result.append(c.toCaseFolded());
+            space = false;
+        } else if (!space) {
+            result.append(QLatin1Char(' '));
+            space = true;
+        }
+    }
+    if (result.endsWith(QLatin1Char(' ')))
+        result.chop(1);
+    return result;
+}
+
+/*
+    Returns the sorted, distinct trigrams of the words of \a normalized. Words
+    are padded with two spaces in front and one behind, so short words and
+    word starts get trigrams of their own. With \a prefix the last word is not
+    padded behind.
+*/
+QVector<quint64> QGeoTextIndex::trigrams(const QString &normalized, bool prefix)
+{
+    QVector<quint64> result;
+    const QVector<QStringRef> words = normalized.splitRef(QLatin1Char(' '), QString::SkipEmptyParts);
+    for (int w = 0; w < words.size(); ++w) {
+        QString padded = QLatin1String("  ") + words.at(w);
+        if (!prefix || w + 1 < words.size())
+            padded += QLatin1Char(' ');
+        for (int i = 0; i + 3 <= padded.size(); ++i) {
+            result.append(quint64(padded.at(i).unicode()) << 32
+                          | quint64(padded.at(i + 1).unicode()) << 16
+                          | quint64(padded.at(i + 2).unicode()));
+        }
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+void QGeoTextIndexWriter::addDocument(const QString &text)
+{
+    const quint32 document = quint32(documentTrigrams.size());
+    const QVector<quint64> documentKeys = QGeoTextIndex::trigrams(QGeoTextIndex::normalize(text), false);
+    documentTrigrams.append(quint16(qMin(documentKeys.size(), 0xffff)));
+    for (quint64 key : documentKeys)
+        m_postingLists[key].append(document);
+}
+
+int QGeoTextIndexWriter::documentCount() const
+{
+    return documentTrigrams.size();
+}
+
+void QGeoTextIndexWriter::finish()
+{
+    keys = m_postingLists.keys().toVector();
+    std::sort(keys.begin(), keys.end());
+    firstPosting.clear();
+    postings.clear();
+    firstPosting.reserve(keys.size() + 1);
+    for (quint64 key : qAsConst(keys)) {
+        firstPosting.append(quint32(postings.size()));
+        postings += m_postingLists.value(key);
+    }
+    firstPosting.append(quint32(postings.size()));
+    m_postingLists.clear();
+}
+
+QT_END_NAMESPACE
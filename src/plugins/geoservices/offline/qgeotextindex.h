@@ -0,0 +1,106 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOTEXTINDEX_H
+#define QGEOTEXTINDEX_H
+
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Trigram index over short texts, such as names and addresses, shared by
+    the geocoding and places indexes. Documents are numbered from 0 in the
+    order they were added to the QGeoTextIndexWriter.
+
+    The index does not own its tables, they point into the memory mapped
+    file of the index using it.
+*/
+class QGeoTextIndex
+{
+public:
+    struct Match
+    {
+        quint32 document;
+        double score;     // 0 to 1, 1 when query and document have the same trigrams
+    };
+
+    struct Tables
+    {
+        const quint16 *documentTrigrams; // trigram count of each document
+        const quint64 *keys;             // sorted trigrams
+        const quint32 *firstPosting;     // keyCount + 1 offsets into postings
+        const quint32 *postings;         // documents of each trigram, ascending
+        quint32 keyCount;
+    };
+
+    void setTables(const Tables &tables);
+
+    QVector<Match> search(const QString &text) const;
+
+    static QString normalize(const QString &text);
+    static QVector<quint64> trigrams(const QString &normalized, bool prefix);
+
+private:
+    Tables m_tables = {};
+};
+
+class QGeoTextIndexWriter
+{
+public:
+    void addDocument(const QString &text);
+    int documentCount() const;
+
+    // Sorts the posting lists, after which the tables below are final.
+    void finish();
+
+    QVector<quint16> documentTrigrams;
+    QVector<quint64> keys;
+    QVector<quint32> firstPosting;
+    QVector<quint32> postings;
+
+private:
+    QHash<quint64, QVector<quint32>> m_postingLists;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOTEXTINDEX_H
@@ -0,0 +1,564 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qplaceindex.h"
+
+#include <QtCore/QSaveFile>
+
+#include <algorithm>
+#include <numeric>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+const char Magic[4] = { 'Q', 'G', 'P', 'L' };
+const quint32 ByteOrderMark = 0x01020304;
+const quint32 FormatVersion = 1;
+
+enum Section {
+    PlacesSection,
+    PlacesByIdSection,
+    PlaceCategoriesSection,
+    CategoriesSection,
+    CellKeysSection,
+    FirstPlaceSection,
+    DocumentTrigramsSection,
+    TrigramKeysSection,
+    FirstPostingSection,
+    PostingsSection,
+    StringsSection,
+    SectionCount
+};
+
+struct FileHeader
+{
+    char magic[4];
+    quint32 byteOrder;
+    quint32 version;
+    quint32 placeCount;
+    quint32 categoryCount;
+    quint32 placeCategoryCount;
+    quint32 cellCount;
+    quint32 cellSize;  // microdegrees
+    quint32 trigramCount;
+    quint32 postingCount;
+    quint32 stringsSize;
+    quint32 reserved;
+    quint64 sections[SectionCount]; // offsets from the start of the file, 8 byte aligned
+};
+
+Q_STATIC_ASSERT(sizeof(QPlaceIndex::Place) == 56);
+Q_STATIC_ASSERT(sizeof(QPlaceIndex::Category) == 16);
+Q_STATIC_ASSERT(sizeof(FileHeader) % 8 == 0);
+
+typedef QPlaceIndex::Point Point;
+
+inline qint32 toMicrodegrees(double degrees)
+{
+    return qint32(qRound64(degrees * 1e6));
+}
+
+// Grid cells are numbered from the south west corner of the world.
+inline quint32 cellRow(qint32 latitude, quint32 cellSize)
+{
+    return quint32((qint64(latitude) + 90000000) / cellSize);
+}
+
+inline quint32 cellColumn(qint32 longitude, quint32 cellSize)
+{
+    return quint32((qint64(longitude) + 180000000) / cellSize);
+}
+
+inline quint64 cellKey(quint32 row, quint32 column)
+{
+    return quint64(row) << 32 | column;
+}
+
+inline quint64 cellKey(const Point &point, quint32 cellSize)
+{
+    return cellKey(cellRow(point.latitude, cellSize), cellColumn(point.longitude, cellSize));
+}
+
+} // namespace
+
+QPlaceIndex::QPlaceIndex()
+{
+}
+
+QPlaceIndex::~QPlaceIndex()
+{
+    if (m_data)
+        m_file.unmap(const_cast<uchar *>(m_data));
+}
+
+QSharedPointer<const QPlaceIndex> QPlaceIndex::open(const QString &fileName, QString *errorString)
+{
+    QSharedPointer<QPlaceIndex> index(new QPlaceIndex);
+    index->m_file.setFileName(fileName);
+    if (!index->m_file.open(QIODevice::ReadOnly)) {
+        *errorString = index->m_file.errorString();
+        return QSharedPointer<const QPlaceIndex>();
+    }
+    if (!index->load(errorString))
+        return QSharedPointer<const QPlaceIndex>();
+    return index;
+}
+
+bool QPlaceIndex::load(QString *errorString)
+{
+    const qint64 size = m_file.size();
+    if (size < qint64(sizeof(FileHeader))) {
+        *errorString = QStringLiteral("File is too small to be a places index");
+        return false;
+    }
+
+    m_data = m_file.map(0, size);
+    if (!m_data) {
+        *errorString = m_file.errorString();
+        return false;
+    }
+
+    const FileHeader *header = reinterpret_cast<const FileHeader *>(m_data);
+    if (memcmp(header->magic, Magic, sizeof(Magic)) != 0) {
+        *errorString = QStringLiteral("Not a places index file");
+        return false;
+    }
+    if (header->byteOrder != ByteOrderMark) {
+        *errorString = QStringLiteral("Places index was built for a different byte order");
+        return false;
+    }
+    if (header->version != FormatVersion) {
+        *errorString = QStringLiteral("Unsupported places index version %1").arg(header->version);
+        return false;
+    }
+
+    m_placeCount = header->placeCount;
+    m_categoryCount = header->categoryCount;
+    m_cellCount = header->cellCount;
+    m_cellSize = header->cellSize;
+    m_stringsSize = header->stringsSize;
+    const quint32 placeCategoryCount = header->placeCategoryCount;
+    const quint32 trigramCount = header->trigramCount;
+    const quint32 postingCount = header->postingCount;
+
+    const quint64 sizes[SectionCount] = {
+        quint64(m_placeCount) * sizeof(Place),
+        quint64(m_placeCount) * sizeof(quint32),
+        quint64(placeCategoryCount) * sizeof(quint32),
+        quint64(m_categoryCount) * sizeof(Category),
+        quint64(m_cellCount) * sizeof(quint64),
+        (quint64(m_cellCount) + 1) * sizeof(quint32),
+        quint64(m_placeCount) * sizeof(quint16),
+        quint64(trigramCount) * sizeof(quint64),
+        (quint64(trigramCount) + 1) * sizeof(quint32),
+        quint64(postingCount) * sizeof(quint32),
+        quint64(m_stringsSize)
+    };
+    for (int i = 0; i < SectionCount; ++i) {
+        const quint64 offset = header->sections[i];
+        if (offset % 8 != 0 || offset > quint64(size) || sizes[i] > quint64(size) - offset) {
+            *errorString = QStringLiteral("Corrupt places index, section %1 is out of bounds").arg(i);
+            return false;
+        }
+    }
+
+    m_places = reinterpret_cast<const Place *>(m_data + header->sections[PlacesSection]);
+    m_placesById = reinterpret_cast<const quint32 *>(m_data + header->sections[PlacesByIdSection]);
+    m_placeCategories = reinterpret_cast<const quint32 *>(m_data + header->sections[PlaceCategoriesSection]);
+    m_categories = reinterpret_cast<const Category *>(m_data + header->sections[CategoriesSection]);
+    m_cellKeys = reinterpret_cast<const quint64 *>(m_data + header->sections[CellKeysSection]);
+    m_firstPlace = reinterpret_cast<const quint32 *>(m_data + header->sections[FirstPlaceSection]);
+    m_strings = reinterpret_cast<const char *>(m_data + header->sections[StringsSection]);
+
+    QGeoTextIndex::Tables text;
+    text.documentTrigrams = reinterpret_cast<const quint16 *>(m_data + header->sections[DocumentTrigramsSection]);
+    text.keys = reinterpret_cast<const quint64 *>(m_data + header->sections[TrigramKeysSection]);
+    text.firstPosting = reinterpret_cast<const quint32 *>(m_data + header->sections[FirstPostingSection]);
+    text.postings = reinterpret_cast<const quint32 *>(m_data + header->sections[PostingsSection]);
+    text.keyCount = trigramCount;
+    m_text.setTables(text);
+
+    // The contents are trusted beyond these structural checks.
+    if (m_cellSize == 0 || m_firstPlace[m_cellCount] != m_placeCount
+            || text.firstPosting[trigramCount] != postingCount
+            || m_stringsSize == 0 || m_strings[m_stringsSize - 1] != '\0') {
+        *errorString = QStringLiteral("Corrupt places index");
+        return false;
+    }
+
+    return true;
+}
+
+quint32 QPlaceIndex::placeCount() const
+{
+    return m_placeCount;
+}
+
+quint32 QPlaceIndex::categoryCount() const
+{
+    return m_categoryCount;
+}
+
+const QPlaceIndex::Place &QPlaceIndex::place(quint32 index) const
+{
+    return m_places[index];
+}
+
+const QPlaceIndex::Category &QPlaceIndex::category(quint32 index) const
+{
+    return m_categories[index];
+}
+
+QVector<quint32> QPlaceIndex::placeCategories(quint32 index) const
+{
+    const Place &p = m_places[index];
+    QVector<quint32> result(int(p.categoryCount));
+    std::copy(m_placeCategories + p.firstCategory,
+              m_placeCategories + p.firstCategory + p.categoryCount, result.begin());
+    return result;
+}
+
+QString QPlaceIndex::string(quint32 offset) const
+{
+    if (offset == 0 || offset >= m_stringsSize)
+        return QString();
+    return QString::fromUtf8(m_strings + offset);
+}
+
+int QPlaceIndex::compareString(quint32 offset, const QByteArray &utf8) const
+{
+    return qstrcmp(m_strings + offset, utf8.constData());
+}
+
+/*
+    Returns the place with the identifier \a id, or InvalidIndex.
+*/
+quint32 QPlaceIndex::findPlace(const QString &id) const
+{
+    const QByteArray utf8 = id.toUtf8();
+    const quint32 *end = m_placesById + m_placeCount;
+    const quint32 *it = std::lower_bound(m_placesById, end, utf8, [this](quint32 place, const QByteArray &key) {
+        return compareString(m_places[place].id, key) < 0;
+    });
+    if (it == end || compareString(m_places[*it].id, utf8) != 0)
+        return InvalidIndex;
+    return *it;
+}
+
+/*
+    Returns the category with the identifier \a id, or InvalidIndex.
+*/
+quint32 QPlaceIndex::findCategory(const QString &id) const
+{
+    const QByteArray utf8 = id.toUtf8();
+    const Category *end = m_categories + m_categoryCount;
+    const Category *it = std::lower_bound(m_categories, end, utf8, [this](const Category &category, const QByteArray &key) {
+        return compareString(category.id, key) < 0;
+    });
+    if (it == end || compareString(it->id, utf8) != 0)
+        return InvalidIndex;
+    return quint32(it - m_categories);
+}
+
+/*
+    Returns the places inside the box, in index order. Only the grid cells
+    overlapping the box are visited; rows without places are skipped with
+    a single binary search each.
+*/
+QVector<quint32> QPlaceIndex::placesIn(double minLatitude, double minLongitude,
+                                       double maxLatitude, double maxLongitude) const
+{
+    QVector<quint32> result;
+    if (m_cellCount == 0)
+        return result;
+
+    const qint32 minLat = toMicrodegrees(qBound(-90.0, minLatitude, 90.0));
+    const qint32 maxLat = toMicrodegrees(qBound(-90.0, maxLatitude, 90.0));
+    const qint32 minLng = toMicrodegrees(qBound(-180.0, minLongitude, 180.0));
+    const qint32 maxLng = toMicrodegrees(qBound(-180.0, maxLongitude, 180.0));
+    if (minLat > maxLat || minLng > maxLng)
+        return result;
+
+    const quint32 firstColumn = cellColumn(minLng, m_cellSize);
+    const quint32 lastColumn = cellColumn(maxLng, m_cellSize);
+    const quint32 lastRow = cellRow(maxLat, m_cellSize);
+    const quint64 *keysEnd = m_cellKeys + m_cellCount;
+    const quint64 *it = m_cellKeys;
+    quint32 row = cellRow(minLat, m_cellSize);
+    while (row <= lastRow) {
+        it = std::lower_bound(it, keysEnd, cellKey(row, firstColumn));
+        if (it == keysEnd)
+            break;
+        const quint32 nextRow = quint32(*it >> 32);
+        if (nextRow != row) {
+            row = nextRow;
+            continue;
+        }
+        for (; it != keysEnd && *it <= cellKey(row, lastColumn); ++it) {
+            const quint32 cell = quint32(it - m_cellKeys);
+            for (quint32 i = m_firstPlace[cell]; i < m_firstPlace[cell + 1]; ++i) {
+                const Point &p = m_places[i].position;
+                if (p.latitude >= minLat && p.latitude <= maxLat
+                        && p.longitude >= minLng && p.longitude <= maxLng) {
+                    result.append(i);
+                }
+            }
+        }
+        ++row;
+    }
+    return result;
+}
+
+/*
+    Returns the places whose name or category names match \a text, best
+    matches first.
+
+    \sa QGeoTextIndex::search()
+*/
+QVector<QPlaceIndex::Match> QPlaceIndex::search(const QString &text) const
+{
+    return m_text.search(text);
+}
+
+quint32 QPlaceIndexWriter::addString(const QString &string)
+{
+    if (string.isEmpty())
+        return 0;
+    auto it = m_stringOffsets.constFind(string);
+    if (it != m_stringOffsets.constEnd())
+        return it.value();
+    const quint32 offset = quint32(m_strings.size());
+    m_strings.append(string.toUtf8());
+    m_strings.append('\0');
+    m_stringOffsets.insert(string, offset);
+    return offset;
+}
+
+/*
+    Adds or replaces the category \a id. Parents may be added later; an
+    unknown parent makes it a top level category.
+*/
+void QPlaceIndexWriter::addCategory(const QString &id, const QString &name, const QString &parentId)
+{
+    if (id.isEmpty())
+        return;
+    PendingCategory category;
+    category.id = addString(id);
+    category.name = addString(name.isEmpty() ? id : name);
+    category.parentId = parentId;
+    m_categories.insert(id, category);
+}
+
+/*
+    Adds a place. Identifiers are expected to be unique; categories that
+    were not added explicitly are created as top level categories named
+    after their identifiers.
+*/
+void QPlaceIndexWriter::addPlace(const PlaceData &data)
+{
+    QPlaceIndex::Place place;
+    memset(&place, 0, sizeof(place));
+    place.position.latitude = toMicrodegrees(qBound(-90.0, data.latitude, 90.0));
+    place.position.longitude = toMicrodegrees(qBound(-180.0, data.longitude, 180.0));
+    place.id = addString(data.id);
+    place.name = addString(data.name);
+    place.street = addString(data.street);
+    place.city = addString(data.city);
+    place.postalCode = addString(data.postalCode);
+    place.country = addString(data.country);
+    place.countryCode = addString(data.countryCode);
+    place.phone = addString(data.phone);
+    place.website = addString(data.website);
+    m_places.append(place);
+
+    QStringList categories;
+    for (const QString &category : data.categories) {
+        if (category.isEmpty() || categories.contains(category))
+            continue;
+        if (!m_categories.contains(category))
+            addCategory(category, category);
+        categories.append(category);
+    }
+    m_placeCategories.append(categories);
+}
+
+void QPlaceIndexWriter::setCellSize(double degrees)
+{
+    m_cellSize = quint32(qBound(1, toMicrodegrees(degrees), 180000000));
+}
+
+int QPlaceIndexWriter::placeCount() const
+{
+    return m_places.size();
+}
+
+int QPlaceIndexWriter::categoryCount() const
+{
+    return m_categories.size();
+}
+
+bool QPlaceIndexWriter::write(const QString &fileName, QString *errorString) const
+{
+    auto utf8 = [this](quint32 offset) {
+        return m_strings.constData() + offset;
+    };
+    auto string = [this](quint32 offset) {
+        return offset ? QString::fromUtf8(m_strings.constData() + offset) : QString();
+    };
+
+    // Categories sorted by identifier.
+    QStringList categoryIds = m_categories.keys();
+    std::sort(categoryIds.begin(), categoryIds.end(), [this, &utf8](const QString &a, const QString &b) {
+        return qstrcmp(utf8(m_categories.value(a).id), utf8(m_categories.value(b).id)) < 0;
+    });
+    QHash<QString, quint32> categoryIndex;
+    for (int i = 0; i < categoryIds.size(); ++i)
+        categoryIndex.insert(categoryIds.at(i), quint32(i));
+    QVector<QPlaceIndex::Category> categories;
+    categories.reserve(categoryIds.size());
+    for (const QString &id : qAsConst(categoryIds)) {
+        const PendingCategory &pending = m_categories.value(id);
+        QPlaceIndex::Category category;
+        category.id = pending.id;
+        category.name = pending.name;
+        category.parent = pending.parentId != id
+                ? categoryIndex.value(pending.parentId, QPlaceIndex::InvalidIndex)
+                : QPlaceIndex::InvalidIndex;
+        category.reserved = 0;
+        categories.append(category);
+    }
+
+    // Places in grid cell order, by identifier within a cell.
+    QVector<int> order(m_places.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this, &utf8](int a, int b) {
+        const quint64 keyA = cellKey(m_places.at(a).position, m_cellSize);
+        const quint64 keyB = cellKey(m_places.at(b).position, m_cellSize);
+        if (keyA != keyB)
+            return keyA < keyB;
+        return qstrcmp(utf8(m_places.at(a).id), utf8(m_places.at(b).id)) < 0;
+    });
+
+    QVector<QPlaceIndex::Place> places;
+    QVector<quint32> placeCategories;
+    QVector<quint64> cellKeys;
+    QVector<quint32> firstPlace;
+    QGeoTextIndexWriter text;
+    places.reserve(order.size());
+    for (int i : qAsConst(order)) {
+        QPlaceIndex::Place place = m_places.at(i);
+        QStringList words(string(place.name));
+        place.firstCategory = quint32(placeCategories.size());
+        for (const QString &id : m_placeCategories.at(i)) {
+            const quint32 category = categoryIndex.value(id);
+            placeCategories.append(category);
+            words.append(string(categories.at(int(category)).name));
+        }
+        place.categoryCount = quint32(placeCategories.size()) - place.firstCategory;
+
+        const quint64 key = cellKey(place.position, m_cellSize);
+        if (cellKeys.isEmpty() || cellKeys.last() != key) {
+            cellKeys.append(key);
+            firstPlace.append(quint32(places.size()));
+        }
+        text.addDocument(words.join(QLatin1Char(' ')));
+        places.append(place);
+    }
+    firstPlace.append(quint32(places.size()));
+    text.finish();
+
+    QVector<quint32> placesById(places.size());
+    std::iota(placesById.begin(), placesById.end(), 0u);
+    std::sort(placesById.begin(), placesById.end(), [&places, &utf8](quint32 a, quint32 b) {
+        return qstrcmp(utf8(places.at(int(a)).id), utf8(places.at(int(b)).id)) < 0;
+    });
+
+    FileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, Magic, sizeof(Magic));
+    header.byteOrder = ByteOrderMark;
+    header.version = FormatVersion;
+    header.placeCount = quint32(places.size());
+    header.categoryCount = quint32(categories.size());
+    header.placeCategoryCount = quint32(placeCategories.size());
+    header.cellCount = quint32(cellKeys.size());
+    header.cellSize = m_cellSize;
+    header.trigramCount = quint32(text.keys.size());
+    header.postingCount = quint32(text.postings.size());
+    header.stringsSize = quint32(m_strings.size());
+
+    const QPair<const void *, qint64> sections[SectionCount] = {
+        { places.constData(), qint64(places.size()) * qint64(sizeof(QPlaceIndex::Place)) },
+        { placesById.constData(), qint64(placesById.size()) * qint64(sizeof(quint32)) },
+        { placeCategories.constData(), qint64(placeCategories.size()) * qint64(sizeof(quint32)) },
+        { categories.constData(), qint64(categories.size()) * qint64(sizeof(QPlaceIndex::Category)) },
+        { cellKeys.constData(), qint64(cellKeys.size()) * qint64(sizeof(quint64)) },
+        { firstPlace.constData(), qint64(firstPlace.size()) * qint64(sizeof(quint32)) },
+        { text.documentTrigrams.constData(), qint64(text.documentTrigrams.size()) * qint64(sizeof(quint16)) },
+        { text.keys.constData(), qint64(text.keys.size()) * qint64(sizeof(quint64)) },
+        { text.firstPosting.constData(), qint64(text.firstPosting.size()) * qint64(sizeof(quint32)) },
+        { text.postings.constData(), qint64(text.postings.size()) * qint64(sizeof(quint32)) },
+        { m_strings.constData(), qint64(m_strings.size()) }
+    };
+    quint64 offset = sizeof(FileHeader);
+    for (int i = 0; i < SectionCount; ++i) {
+        header.sections[i] = offset;
+        offset += (quint64(sections[i].second) + 7) & ~quint64(7);
+    }
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        *errorString = file.errorString();
+        return false;
+    }
+    static const char padding[8] = {};
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    for (int i = 0; i < SectionCount; ++i) {
+        file.write(static_cast<const char *>(sections[i].first), sections[i].second);
+        file.write(padding, ((sections[i].second + 7) & ~qint64(7)) - sections[i].second);
+    }
+    if (!file.commit()) {
+        *errorString = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,203 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QPLACEINDEX_H
+#define QPLACEINDEX_H
+
+#include "qgeotextindex.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Read-only view of a places index file produced by QPlaceIndexWriter.
+
+    The file is memory mapped and holds:
+    - places, ordered by the cell of a uniform latitude/longitude grid they
+      fall into, so the places of a cell are consecutive,
+    - the sorted keys of the non-empty cells and the first place of each,
+      used for area queries,
+    - the place categories, sorted by identifier,
+    - a trigram index over the name and category names of each place; its
+      documents are numbered like the places.
+
+    All accessors are const and the object can be used from any thread.
+*/
+class QPlaceIndex
+{
+public:
+    struct Point
+    {
+        qint32 latitude;  // microdegrees
+        qint32 longitude; // microdegrees
+    };
+
+    struct Place
+    {
+        Point position;
+        quint32 id;       // offsets into the strings blob, 0 for none
+        quint32 name;
+        quint32 street;
+        quint32 city;
+        quint32 postalCode;
+        quint32 country;
+        quint32 countryCode;
+        quint32 phone;
+        quint32 website;
+        quint32 firstCategory; // into the place categories
+        quint32 categoryCount;
+        quint32 reserved;
+    };
+
+    struct Category
+    {
+        quint32 id;
+        quint32 name;
+        quint32 parent;   // category index, InvalidIndex for top level categories
+        quint32 reserved;
+    };
+
+    typedef QGeoTextIndex::Match Match;
+
+    static const quint32 InvalidIndex = 0xffffffff;
+
+    static QSharedPointer<const QPlaceIndex> open(const QString &fileName, QString *errorString);
+    ~QPlaceIndex();
+
+    quint32 placeCount() const;
+    quint32 categoryCount() const;
+
+    const Place &place(quint32 index) const;
+    const Category &category(quint32 index) const;
+    QVector<quint32> placeCategories(quint32 index) const;
+    QString string(quint32 offset) const;
+
+    quint32 findPlace(const QString &id) const;
+    quint32 findCategory(const QString &id) const;
+
+    QVector<quint32> placesIn(double minLatitude, double minLongitude,
+                              double maxLatitude, double maxLongitude) const;
+    QVector<Match> search(const QString &text) const;
+
+private:
+    QPlaceIndex();
+    bool load(QString *errorString);
+    int compareString(quint32 offset, const QByteArray &utf8) const;
+
+    QFile m_file;
+    const uchar *m_data = nullptr;
+    quint32 m_placeCount = 0;
+    quint32 m_categoryCount = 0;
+    quint32 m_cellCount = 0;
+    quint32 m_cellSize = 0;
+    quint32 m_stringsSize = 0;
+    const Place *m_places = nullptr;
+    const quint32 *m_placesById = nullptr;
+    const quint32 *m_placeCategories = nullptr;
+    const Category *m_categories = nullptr;
+    const quint64 *m_cellKeys = nullptr;
+    const quint32 *m_firstPlace = nullptr;
+    const char *m_strings = nullptr;
+    QGeoTextIndex m_text;
+
+    Q_DISABLE_COPY(QPlaceIndex)
+};
+
+/*
+    Collects places and categories in memory and serializes them in the
+    format read by QPlaceIndex. Used by the qgeoofflinedata tool and by the
+    tests.
+*/
+class QPlaceIndexWriter
+{
+public:
+    struct PlaceData
+    {
+        QString id;
+        QString name;
+        double latitude = 0.0;
+        double longitude = 0.0;
+        QStringList categories; // category identifiers
+        QString street;
+        QString city;
+        QString postalCode;
+        QString country;
+        QString countryCode;
+        QString phone;
+        QString website;
+    };
+
+    void addCategory(const QString &id, const QString &name, const QString &parentId = QString());
+    void addPlace(const PlaceData &place);
+
+    // Side of the grid cells, 0.01 degrees by default.
+    void setCellSize(double degrees);
+
+    int placeCount() const;
+    int categoryCount() const;
+
+    bool write(const QString &fileName, QString *errorString) const;
+
+private:
+    quint32 addString(const QString &string);
+
+    struct PendingCategory
+    {
+        quint32 id;
+        quint32 name;
+        QString parentId;
+    };
+
+    QVector<QPlaceIndex::Place> m_places;
+    QVector<QStringList> m_placeCategories;
+    QHash<QString, PendingCategory> m_categories;
+    quint32 m_cellSize = 10000;
+    QByteArray m_strings = QByteArray(1, '\0');
+    QHash<QString, quint32> m_stringOffsets;
+};
+
+QT_END_NAMESPACE
+
+#endif // QPLACEINDEX_H
@@ -0,0 +1,456 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qplacemanagerengineoffline.h"
+#include "qplacereplyoffline.h"
+#include "qplaceindex.h"
+
+#include <QtCore/QSet>
+#include <QtCore/qnumeric.h>
+#include <QtLocation/QPlaceCategory>
+#include <QtLocation/QPlaceContactDetail>
+#include <QtLocation/QPlaceResult>
+#include <QtLocation/QPlaceSearchRequest>
+#include <QtPositioning/QGeoAddress>
+#include <QtPositioning/QGeoCircle>
+#include <QtPositioning/QGeoLocation>
+#include <QtPositioning/QGeoRectangle>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+struct Candidate
+{
+    quint32 place;
+    double score;    // text relevance, 1 when browsing
+    double distance; // to the center of the search area, NaN without one
+    double rank;
+};
+
+inline QGeoCoordinate placeCoordinate(const QPlaceIndex &index, quint32 place)
+{
+    const QPlaceIndex::Point &p = index.place(place).position;
+    return QGeoCoordinate(p.latitude * 1e-6, p.longitude * 1e-6);
+}
+
+// The places inside the bounding box of the area, which may cross the antimeridian.
+QVector<quint32> placesInBox(const QPlaceIndex &index, const QGeoRectangle &box)
+{
+    const double north = box.topLeft().latitude();
+    const double south = box.bottomRight().latitude();
+    const double west = box.topLeft().longitude();
+    const double east = box.bottomRight().longitude();
+    if (west <= east)
+        return index.placesIn(south, west, north, east);
+    return index.placesIn(south, west, north, 180.0) + index.placesIn(south, -180.0, north, east);
+}
+
+class AreaFilter
+{
+public:
+    explicit AreaFilter(const QGeoShape &area)
+    :   m_area(area), m_box(area.isValid() ? area.boundingGeoRectangle() : QGeoRectangle())
+    {
+    }
+
+    bool accepts(const QGeoCoordinate &coordinate) const
+    {
+        return !m_area.isValid() || (m_box.contains(coordinate) && m_area.contains(coordinate));
+    }
+
+private:
+    QGeoShape m_area;
+    QGeoRectangle m_box;
+};
+
+} // namespace
+
+QPlaceManagerEngineOffline::QPlaceManagerEngineOffline(const QVariantMap &parameters,
+                                                       QGeoServiceProvider::Error *error,
+                                                       QString *errorString)
+:   QPlaceManagerEngine(parameters)
+{
+    const QString indexFile = parameters.value(QStringLiteral("offline.places.index")).toString();
+    if (indexFile.isEmpty()) {
+        *error = QGeoServiceProvider::MissingRequiredParameterError;
+        *errorString = QStringLiteral("The offline.places.index parameter is required for places");
+        return;
+    }
+
+    QString indexError;
+    m_index = QPlaceIndex::open(indexFile, &indexError);
+    if (!m_index) {
+        *error = QGeoServiceProvider::NotSupportedError;
+        *errorString = QStringLiteral("Unable to load places index %1: %2").arg(indexFile, indexError);
+        return;
+    }
+
+    if (parameters.contains(QStringLiteral("offline.places.page_size")))
+        m_pageSize = qMax(1, parameters.value(QStringLiteral("offline.places.page_size")).toInt());
+
+    for (quint32 i = 0; i < m_index->categoryCount(); ++i) {
+        const QPlaceIndex::Category &record = m_index->category(i);
+        QPlaceCategory category;
+        category.setCategoryId(m_index->string(record.id));
+        category.setName(m_index->string(record.name));
+        category.setVisibility(QLocation::PublicVisibility);
+        m_categories.insert(category.categoryId(), category);
+
+        const QString parentId = record.parent != QPlaceIndex::InvalidIndex
+                ? m_index->string(m_index->category(record.parent).id) : QString();
+        m_parentCategories.insert(category.categoryId(), parentId);
+        m_subcategories[parentId].append(category.categoryId());
+    }
+
+    *error = QGeoServiceProvider::NoError;
+    errorString->clear();
+}
+
+QPlaceManagerEngineOffline::~QPlaceManagerEngineOffline()
+{
+}
+
+QPlaceDetailsReply *QPlaceManagerEngineOffline::getPlaceDetails(const QString &placeId)
+{
+    QPlaceDetailsReplyOffline *reply = new QPlaceDetailsReplyOffline(this);
+    const quint32 i = m_index->findPlace(placeId);
+    if (placeId.isEmpty() || i == QPlaceIndex::InvalidIndex)
+        reply->setError(QPlaceReply::PlaceDoesNotExistError, QStringLiteral("Place does not exist"));
+    else
+        reply->setPlace(place(i));
+
+    startReply(reply);
+    return reply;
+}
+
+/*
+    Searches by text, by category or both, optionally limited to the search
+    area. Text matches are ranked by their relevance, lowered with their
+    distance from the center of the search area; browsing ranks by distance
+    alone. The searchContext of the page requests holds the offset of the
+    page.
+*/
+QPlaceSearchReply *QPlaceManagerEngineOffline::search(const QPlaceSearchRequest &request)
+{
+    QPlaceSearchReplyOffline *reply = new QPlaceSearchReplyOffline(this);
+    reply->setRequest(request);
+
+    const QString term = request.searchTerm().trimmed();
+    const QGeoShape area = request.searchArea();
+    if (!request.recommendationId().isEmpty()) {
+        reply->setError(QPlaceReply::UnsupportedError,
+                        QStringLiteral("Recommendations are not supported"));
+        startReply(reply);
+        return reply;
+    }
+    if (term.isEmpty() && request.categories().isEmpty() && !area.isValid()) {
+        reply->setError(QPlaceReply::BadArgumentError,
+                        QStringLiteral("A search term, categories or a search area is required"));
+        startReply(reply);
+        return reply;
+    }
+
+    // The requested categories and their descendants.
+    QSet<quint32> categories;
+    QStringList pendingCategories;
+    for (const QPlaceCategory &category : request.categories())
+        pendingCategories.append(category.categoryId());
+    while (!pendingCategories.isEmpty()) {
+        const QString id = pendingCategories.takeLast();
+        const quint32 i = m_index->findCategory(id);
+        if (i == QPlaceIndex::InvalidIndex || categories.contains(i))
+            continue;
+        categories.insert(i);
+        pendingCategories += m_subcategories.value(id);
+    }
+    auto inCategories = [&](quint32 place) {
+        if (request.categories().isEmpty())
+            return true;
+        const QVector<quint32> placeCategories = m_index->placeCategories(place);
+        for (quint32 category : placeCategories) {
+            if (categories.contains(category))
+                return true;
+        }
+        return false;
+    };
+
+    const AreaFilter areaFilter(area);
+    QVector<Candidate> candidates;
+    if (!term.isEmpty()) {
+        const QVector<QPlaceIndex::Match> matches = m_index->search(term);
+        for (const QPlaceIndex::Match &match : matches) {
+            if (areaFilter.accepts(placeCoordinate(*m_index, match.document))
+                    && inCategories(match.document)) {
+                candidates.append({ match.document, match.score, qQNaN(), match.score });
+            }
+        }
+    } else if (area.isValid()) {
+        const QVector<quint32> places = placesInBox(*m_index, area.boundingGeoRectangle());
+        for (quint32 i : places) {
+            if (area.contains(placeCoordinate(*m_index, i)) && inCategories(i))
+                candidates.append({ i, 1.0, qQNaN(), 1.0 });
+        }
+    } else if (!categories.isEmpty()) {
+        for (quint32 i = 0; i < m_index->placeCount(); ++i) {
+            if (inCategories(i))
+                candidates.append({ i, 1.0, qQNaN(), 1.0 });
+        }
+    }
+
+    if (area.isValid()) {
+        // Half the size of the area is where the proximity boost halves.
+        const QGeoCoordinate center = area.center();
+        const double scale = qMax(1.0, center.distanceTo(area.boundingGeoRectangle().topLeft()) / 2.0);
+        for (Candidate &candidate : candidates) {
+            candidate.distance = center.distanceTo(placeCoordinate(*m_index, candidate.place));
+            candidate.rank = term.isEmpty() ? -candidate.distance
+                                            : candidate.score / (1.0 + candidate.distance / scale);
+        }
+    }
+
+    switch (request.relevanceHint()) {
+    case QPlaceSearchRequest::DistanceHint:
+        if (area.isValid()) {
+            std::stable_sort(candidates.begin(), candidates.end(),
+                             [](const Candidate &a, const Candidate &b) {
+                return a.distance < b.distance;
+            });
+            break;
+        }
+        Q_FALLTHROUGH();
+    case QPlaceSearchRequest::UnspecifiedHint:
+        std::stable_sort(candidates.begin(), candidates.end(),
+                         [](const Candidate &a, const Candidate &b) {
+            return a.rank > b.rank;
+        });
+        break;
+    case QPlaceSearchRequest::LexicalPlaceNameHint: {
+        QVector<QPair<QString, Candidate>> named;
+        named.reserve(candidates.size());
+        for (const Candidate &candidate : qAsConst(candidates))
+            named.append(qMakePair(m_index->string(m_index->place(candidate.place).name), candidate));
+        std::stable_sort(named.begin(), named.end(),
+                         [](const QPair<QString, Candidate> &a, const QPair<QString, Candidate> &b) {
+            return QString::localeAwareCompare(a.first, b.first) < 0;
+        });
+        for (int i = 0; i < named.size(); ++i)
+            candidates[i] = named.at(i).second;
+        break;
+    }
+    }
+
+    const int limit = request.limit() >= 0 ? request.limit() : m_pageSize;
+    const int offset = qBound(0, request.searchContext().toMap()
+                              .value(QStringLiteral("offset")).toInt(), candidates.size());
+    const int end = offset + qMin(candidates.size() - offset, limit);
+
+    QList<QPlaceSearchResult> results;
+    results.reserve(end - offset);
+    for (int i = offset; i < end; ++i) {
+        const Candidate &candidate = candidates.at(i);
+        QPlaceResult result;
+        result.setPlace(place(candidate.place));
+        result.setTitle(result.place().name());
+        result.setDistance(candidate.distance);
+        results.append(result);
+    }
+    reply->setResults(results);
+
+    // A limit of 0 asks for no results, which would otherwise page forever.
+    if (limit > 0 && end < candidates.size()) {
+        QPlaceSearchRequest next = request;
+        QVariantMap context;
+        context.insert(QStringLiteral("offset"), end);
+        next.setSearchContext(context);
+        reply->setNextPageRequest(next);
+    }
+    if (limit > 0 && offset > 0) {
+        QPlaceSearchRequest previous = request;
+        QVariantMap context;
+        context.insert(QStringLiteral("offset"), qMax(0, offset - limit));
+        previous.setSearchContext(context);
+        reply->setPreviousPageRequest(previous);
+    }
+
+    startReply(reply);
+    return reply;
+}
+
+/*
+    Suggests the distinct names of the best text matches inside the search
+    area.
+*/
+QPlaceSearchSuggestionReply *QPlaceManagerEngineOffline::searchSuggestions(const QPlaceSearchRequest &request)
+{
+    QPlaceSearchSuggestionReplyOffline *reply = new QPlaceSearchSuggestionReplyOffline(this);
+
+    const QString term = request.searchTerm().trimmed();
+    if (term.isEmpty()) {
+        reply->setError(QPlaceReply::BadArgumentError,
+                        QStringLiteral("A search term is required for suggestions"));
+        startReply(reply);
+        return reply;
+    }
+
+    const int limit = request.limit() >= 0 ? request.limit() : m_pageSize;
+    const AreaFilter areaFilter(request.searchArea());
+    const QVector<QPlaceIndex::Match> matches = m_index->search(term);
+    QStringList suggestions;
+    QSet<QString> seen;
+    for (const QPlaceIndex::Match &match : matches) {
+        if (suggestions.size() >= limit)
+            break;
+        if (!areaFilter.accepts(placeCoordinate(*m_index, match.document)))
+            continue;
+        const QString name = m_index->string(m_index->place(match.document).name);
+        if (name.isEmpty() || seen.contains(name))
+            continue;
+        seen.insert(name);
+        suggestions.append(name);
+    }
+    reply->setSuggestions(suggestions);
+
+    startReply(reply);
+    return reply;
+}
+
+/*
+    The categories are read with the index, so this only reports that they
+    are available.
+*/
+QPlaceReply *QPlaceManagerEngineOffline::initializeCategories()
+{
+    QPlaceCategoriesReplyOffline *reply = new QPlaceCategoriesReplyOffline(this);
+    startReply(reply);
+    return reply;
+}
+
+QString QPlaceManagerEngineOffline::parentCategoryId(const QString &categoryId) const
+{
+    return m_parentCategories.value(categoryId);
+}
+
+QStringList QPlaceManagerEngineOffline::childCategoryIds(const QString &categoryId) const
+{
+    return m_subcategories.value(categoryId);
+}
+
+QPlaceCategory QPlaceManagerEngineOffline::category(const QString &categoryId) const
+{
+    return m_categories.value(categoryId);
+}
+
+QList<QPlaceCategory> QPlaceManagerEngineOffline::childCategories(const QString &parentId) const
+{
+    QList<QPlaceCategory> categories;
+    for (const QString &id : m_subcategories.value(parentId))
+        categories.append(m_categories.value(id));
+    return categories;
+}
+
+void QPlaceManagerEngineOffline::startReply(QPlaceReply *reply)
+{
+    connect(reply, SIGNAL(finished()), this, SLOT(replyFinished()));
+    connect(reply, SIGNAL(error(QPlaceReply::Error,QString)),
+            this, SLOT(replyError(QPlaceReply::Error,QString)));
+    QMetaObject::invokeMethod(reply, "emitFinished", Qt::QueuedConnection);
+}
+
+QPlace QPlaceManagerEngineOffline::place(quint32 index) const
+{
+    const QPlaceIndex::Place &record = m_index->place(index);
+
+    QGeoAddress address;
+    address.setStreet(m_index->string(record.street));
+    address.setCity(m_index->string(record.city));
+    address.setPostalCode(m_index->string(record.postalCode));
+    address.setCountry(m_index->string(record.country));
+    address.setCountryCode(m_index->string(record.countryCode));
+
+    QGeoLocation location;
+    location.setCoordinate(placeCoordinate(*m_index, index));
+    location.setAddress(address);
+
+    QPlace place;
+    place.setPlaceId(m_index->string(record.id));
+    place.setName(m_index->string(record.name));
+    place.setLocation(location);
+    place.setVisibility(QLocation::PublicVisibility);
+
+    QList<QPlaceCategory> categories;
+    const QVector<quint32> placeCategories = m_index->placeCategories(index);
+    for (quint32 category : placeCategories)
+        categories.append(m_categories.value(m_index->string(m_index->category(category).id)));
+    place.setCategories(categories);
+
+    const QString phone = m_index->string(record.phone);
+    if (!phone.isEmpty()) {
+        QPlaceContactDetail detail;
+        detail.setValue(phone);
+        place.appendContactDetail(QPlaceContactDetail::Phone, detail);
+    }
+    const QString website = m_index->string(record.website);
+    if (!website.isEmpty()) {
+        QPlaceContactDetail detail;
+        detail.setValue(website);
+        place.appendContactDetail(QPlaceContactDetail::Website, detail);
+    }
+
+    place.setDetailsFetched(true);
+    return place;
+}
+
+void QPlaceManagerEngineOffline::replyFinished()
+{
+    QPlaceReply *reply = qobject_cast<QPlaceReply *>(sender());
+    if (reply)
+        emit finished(reply);
+}
+
+void QPlaceManagerEngineOffline::replyError(QPlaceReply::Error errorCode, const QString &errorString)
+{
+    QPlaceReply *reply = qobject_cast<QPlaceReply *>(sender());
+    if (reply)
+        emit error(reply, errorCode, errorString);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,91 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QPLACEMANAGERENGINEOFFLINE_H
+#define QPLACEMANAGERENGINEOFFLINE_H
+
+#include <QtCore/QHash>
+#include <QtCore/QSharedPointer>
+#include <QtLocation/QGeoServiceProvider>
+#include <QtLocation/QPlaceManagerEngine>
+
+QT_BEGIN_NAMESPACE
+
+class QPlaceIndex;
+
+class QPlaceManagerEngineOffline : public QPlaceManagerEngine
+{
+    Q_OBJECT
+
+public:
+    QPlaceManagerEngineOffline(const QVariantMap &parameters, QGeoServiceProvider::Error *error,
+                               QString *errorString);
+    ~QPlaceManagerEngineOffline();
+
+    QPlaceDetailsReply *getPlaceDetails(const QString &placeId) override;
+
+    QPlaceSearchReply *search(const QPlaceSearchRequest &request) override;
+    QPlaceSearchSuggestionReply *searchSuggestions(const QPlaceSearchRequest &request) override;
+
+    QPlaceReply *initializeCategories() override;
+    QString parentCategoryId(const QString &categoryId) const override;
+    QStringList childCategoryIds(const QString &categoryId) const override;
+    QPlaceCategory category(const QString &categoryId) const override;
+
+    QList<QPlaceCategory> childCategories(const QString &parentId) const override;
+
+private slots:
+    void replyFinished();
+    void replyError(QPlaceReply::Error errorCode, const QString &errorString);
+
+private:
+    void startReply(QPlaceReply *reply);
+    QPlace place(quint32 index) const;
+
+    QSharedPointer<const QPlaceIndex> m_index;
+    int m_pageSize = 20;
+
+    QHash<QString, QPlaceCategory> m_categories;
+    QHash<QString, QString> m_parentCategories;
+    QHash<QString, QStringList> m_subcategories;
+};
+
+QT_END_NAMESPACE
+
+#endif // QPLACEMANAGERENGINEOFFLINE_H
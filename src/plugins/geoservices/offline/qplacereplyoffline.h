@@ -0,0 +1,108 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtLocation module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QPLACEREPLYOFFLINE_H
+#define QPLACEREPLYOFFLINE_H
+
+#include <QtLocation/QPlaceDetailsReply>
+#include <QtLocation/QPlaceReply>
+#include <QtLocation/QPlaceSearchReply>
+#include <QtLocation/QPlaceSearchSuggestionReply>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Replies of QPlaceManagerEngineOffline. The engine answers from its index
+    right away and fills the replies in directly; emitFinished() is invoked
+    queued, so the reply signals reach connections made after the request
+    returned.
+*/
+class QPlaceSearchReplyOffline : public QPlaceSearchReply
+{
+    Q_OBJECT
+
+    friend class QPlaceManagerEngineOffline;
+
+public:
+    explicit QPlaceSearchReplyOffline(QObject *parent = nullptr);
+    ~QPlaceSearchReplyOffline();
+
+    Q_INVOKABLE void emitFinished();
+};
+
+class QPlaceSearchSuggestionReplyOffline : public QPlaceSearchSuggestionReply
+{
+    Q_OBJECT
+
+    friend class QPlaceManagerEngineOffline;
+
+public:
+    explicit QPlaceSearchSuggestionReplyOffline(QObject *parent = nullptr);
+    ~QPlaceSearchSuggestionReplyOffline();
+
+    Q_INVOKABLE void emitFinished();
+};
+
+class QPlaceDetailsReplyOffline : public QPlaceDetailsReply
+{
+    Q_OBJECT
+
+    friend class QPlaceManagerEngineOffline;
+
+public:
+    explicit QPlaceDetailsReplyOffline(QObject *parent = nullptr);
+    ~QPlaceDetailsReplyOffline();
+
+    Q_INVOKABLE void emitFinished();
+};
+
+class QPlaceCategoriesReplyOffline : public QPlaceReply
+{
+    Q_OBJECT
+
+public:
+    explicit QPlaceCategoriesReplyOffline(QObject *parent = nullptr);
+    ~QPlaceCategoriesReplyOffline();
+
+    Q_INVOKABLE void emitFinished();
+};
+
+QT_END_NAMESPACE
+
+#endif // QPLACEREPLYOFFLINE_H
@@ -46,6 +46,7 @@
 #include <QtPositioning/QGeoAddress>
 #include <QtPositioning/QGeoLocation>
 #include <QtPositioning/QGeoRectangle>
+#include <QtLocation/private/qgeocodereply_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -106,61 +107,59 @@ void QGeoCodeReplyOsm::networkReplyFinished()
     if (reply->error() != QNetworkReply::NoError)
         return;
 
-    QList<QGeoLocation> locations;
-    QJsonDocument document = QJsonDocument::fromJson(reply->readAll());
+    const QByteArray data = reply->readAll();
+    QGeoCodeReplyPrivate::parseAsync(this, [data](QList<QGeoLocation> &locations, QString &) {
+        QJsonDocument document = QJsonDocument::fromJson(data);
 
-    if (document.isObject()) {
-        QJsonObject object = document.object();
+        if (document.isObject()) {
+            QJsonObject object = document.object();
 
-        QGeoCoordinate coordinate;
+            QGeoCoordinate coordinate;
 
-        coordinate.setLatitude(object.value(QStringLiteral("lat")).toString().toDouble());
-        coordinate.setLongitude(object.value(QStringLiteral("lon")).toString().toDouble());
+            coordinate.setLatitude(object.value(QStringLiteral("lat")).toString().toDouble());
+            coordinate.setLongitude(object.value(QStringLiteral("lon")).toString().toDouble());
 
-        QGeoLocation location;
-        location.setCoordinate(coordinate);
-        location.setAddress(parseAddressObject(object));
+            QGeoLocation location;
+            location.setCoordinate(coordinate);
+            location.setAddress(parseAddressObject(object));
 
-        locations.append(location);
+            locations.append(location);
+        } else if (document.isArray()) {
+            QJsonArray results = document.array();
 
-        setLocations(locations);
-    } else if (document.isArray()) {
-        QJsonArray results = document.array();
+            for (int i = 0; i < results.count(); ++i) {
+                if (!results.at(i).isObject())
+                    continue;
 
-        for (int i = 0; i < results.count(); ++i) {
-            if (!results.at(i).isObject())
-                continue;
+                QJsonObject object = results.at(i).toObject();
 
-            QJsonObject object = results.at(i).toObject();
+                QGeoCoordinate coordinate;
 
-            QGeoCoordinate coordinate;
+                coordinate.setLatitude(object.value(QStringLiteral("lat")).toString().toDouble());
+                coordinate.setLongitude(object.value(QStringLiteral("lon")).toString().toDouble());
 
-            coordinate.setLatitude(object.value(QStringLiteral("lat")).toString().toDouble());
-            coordinate.setLongitude(object.value(QStringLiteral("lon")).toString().toDouble());
+                QGeoRectangle rectangle;
 
-            QGeoRectangle rectangle;
-
-            if (object.contains(QStringLiteral("boundingbox"))) {
-                QJsonArray a = object.value(QStringLiteral("boundingbox")).toArray();
-                if (a.count() == 4) {
-                    rectangle.setTopLeft(QGeoCoordinate(a.at(1).toString().toDouble(),
-                                                        a.at(2).toString().toDouble()));
-                    rectangle.setBottomRight(QGeoCoordinate(a.at(0).toString().toDouble(),
-                                                            a.at(3).toString().toDouble()));
+                if (object.contains(QStringLiteral("boundingbox"))) {
+                    QJsonArray a = object.value(QStringLiteral("boundingbox")).toArray();
+                    if (a.count() == 4) {
+                        rectangle.setTopLeft(QGeoCoordinate(a.at(1).toString().toDouble(),
+                                                            a.at(2).toString().toDouble()));
+                        rectangle.setBottomRight(QGeoCoordinate(a.at(0).toString().toDouble(),
+                                                                a.at(3).toString().toDouble()));
+                    }
                 }
-            }
 
-            QGeoLocation location;
-            location.setCoordinate(coordinate);
-            location.setBoundingBox(rectangle);
-            location.setAddress(parseAddressObject(object));
-            locations.append(location);
+                QGeoLocation location;
+                location.setCoordinate(coordinate);
+                location.setBoundingBox(rectangle);
+                location.setAddress(parseAddressObject(object));
+                locations.append(location);
+            }
         }
 
-    }
-
-    setLocations(locations);
-    setFinished(true);
+        return QGeoCodeReply::NoError;
+    });
 }
 
 void QGeoCodeReplyOsm::networkReplyError(QNetworkReply::NetworkError error)
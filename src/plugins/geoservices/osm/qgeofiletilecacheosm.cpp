@@ -36,6 +36,7 @@
 
 #include "qgeofiletilecacheosm.h"
 #include <QtLocation/private/qgeotilespec_p.h>
+#include <QtLocation/private/qgeofiletilecachewriter_p.h>
 #include <QDir>
 #include <QDirIterator>
 #include <QPair>
@@ -195,6 +196,8 @@ void QGeoFileTileCacheOsm::dropTiles(int mapId)
 
 void QGeoFileTileCacheOsm::loadTiles(int mapId)
 {
+    diskWriter_->flush();
+
     QStringList formats;
     formats << QLatin1String("*.*");
 
@@ -301,8 +304,8 @@ void QGeoFileTileCacheOsm::clearObsoleteTiles(const QGeoTileProviderOsm *p)
             if (m_maxMapIdTimestamps[p->mapType().mapId()].isValid() &&  // there are tiles in the cache
                 p->timestamp() > m_maxMapIdTimestamps[p->mapType().mapId()]) { // and they are older than the provider
                 qInfo() << "provider for " << p->mapType().name() << " timestamp: " << p->timestamp()
-                        << " -- data last modified: " << m_maxMapIdTimestamps[p->mapType().mapId()] << ". Clearing.";
-                clearMapId(p->mapType().mapId());
+                        << " -- data last modified: " << m_maxMapIdTimestamps[p->mapType().mapId()] << ". Revalidating.";
+                expireMapId(p->mapType().mapId());
                 m_maxMapIdTimestamps[p->mapType().mapId()] = p->timestamp(); // don't do it again.
             }
         } else {
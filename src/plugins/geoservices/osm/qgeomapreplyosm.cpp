@@ -40,6 +40,7 @@
 #include "qgeomapreplyosm.h"
 
 #include <QtLocation/private/qgeotilespec_p.h>
+#include <QtLocation/private/qabstractgeotilecache_p.h>
 
 QGeoMapReplyOsm::QGeoMapReplyOsm(QNetworkReply *reply,
                                  const QGeoTileSpec &spec,
@@ -71,6 +72,15 @@ void QGeoMapReplyOsm::networkReplyFinished()
     if (reply->error() != QNetworkReply::NoError) // Already handled in networkReplyError
         return;
 
+    setMetadata(QGeoTileMetadata::fromNetworkReply(reply));
+
+    // Answer to a revalidation: the cached tile is still current.
+    if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 304) {
+        setNotModified(true);
+        setFinished(true);
+        return;
+    }
+
     QByteArray a = reply->readAll();
 
     setMapImageData(a);
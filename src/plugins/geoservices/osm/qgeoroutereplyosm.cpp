@@ -71,25 +71,7 @@ void QGeoRouteReplyOsm::networkReplyFinished()
 
     QGeoRoutingManagerEngineOsm *engine = qobject_cast<QGeoRoutingManagerEngineOsm *>(parent());
     const QGeoRouteParser *parser = engine->routeParser();
-
-    QList<QGeoRoute> routes;
-    QString errorString;
-    QGeoRouteReply::Error error = parser->parseReply(routes, errorString, reply->readAll());
-    // Setting the request into the result
-    for (QGeoRoute &route : routes) {
-        route.setRequest(request());
-        for (QGeoRoute &leg: route.routeLegs()) {
-            leg.setRequest(request());
-        }
-    }
-
-    if (error == QGeoRouteReply::NoError) {
-        setRoutes(routes.mid(0, request().numberAlternativeRoutes() + 1));
-        // setError(QGeoRouteReply::NoError, status);  // can't do this, or NoError is emitted and does damages
-        setFinished(true);
-    } else {
-        setError(error, errorString);
-    }
+    parser->parseReplyAsync(this, reply->readAll());
 }
 
 void QGeoRouteReplyOsm::networkReplyError(QNetworkReply::NetworkError error)
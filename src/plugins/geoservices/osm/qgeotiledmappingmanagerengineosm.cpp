@@ -259,7 +259,7 @@ QGeoTiledMappingManagerEngineOsm::QGeoTiledMappingManagerEngineOsm(const QVarian
     }
     if (parameters.contains(QStringLiteral("osm.mapping.cache.disk.size"))) {
         bool ok = false;
-        int cacheSize = parameters.value(QStringLiteral("osm.mapping.cache.disk.size")).toString().toInt(&ok);
+        qint64 cacheSize = parameters.value(QStringLiteral("osm.mapping.cache.disk.size")).toString().toLongLong(&ok);
         if (ok)
             tileCache->setMaxDiskUsage(cacheSize);
     }
@@ -302,6 +302,23 @@ QGeoTiledMappingManagerEngineOsm::QGeoTiledMappingManagerEngineOsm(const QVarian
             tileCache->setExtraTextureUsage(cacheSize);
     }
 
+    if (parameters.contains(QStringLiteral("osm.mapping.cache.max_age"))) {
+        bool ok = false;
+        int maxAge = parameters.value(QStringLiteral("osm.mapping.cache.max_age")).toString().toInt(&ok);
+        if (ok)
+            setTileMaxAge(maxAge);
+    }
+
+    if (parameters.contains(QStringLiteral("osm.mapping.cache.compose_levels"))) {
+        bool ok = false;
+        int levels = parameters.value(QStringLiteral("osm.mapping.cache.compose_levels")).toString().toInt(&ok);
+        if (ok)
+            setTileComposition(levels);
+    }
+
+    if (parameters.contains(QStringLiteral("osm.mapping.cache.shared")))
+        tileCache->setShared(parameters.value(QStringLiteral("osm.mapping.cache.shared")).toBool());
+
 
     setTileCache(tileCache);
 
@@ -312,6 +329,14 @@ QGeoTiledMappingManagerEngineOsm::QGeoTiledMappingManagerEngineOsm(const QVarian
         const QByteArray ua = parameters.value(QStringLiteral("osm.useragent")).toString().toLatin1();
         tileFetcher->setUserAgent(ua);
     }
+    if (parameters.contains(QStringLiteral("osm.mapping.max_requests_per_host"))) {
+        bool ok = false;
+        const int count = parameters.value(QStringLiteral("osm.mapping.max_requests_per_host")).toString().toInt(&ok);
+        if (ok)
+            tileFetcher->setMaximumRequestsPerHost(count);
+    }
+    if (parameters.contains(QStringLiteral("osm.mapping.http2")))
+        tileFetcher->setHttp2Enabled(parameters.value(QStringLiteral("osm.mapping.http2")).toBool());
     setTileFetcher(tileFetcher);
 
     /* PREFETCHING */
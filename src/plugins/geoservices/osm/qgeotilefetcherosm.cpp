@@ -159,10 +159,19 @@ QGeoTiledMapReply *QGeoTileFetcherOsm::getTileImage(const QGeoTileSpec &spec)
     QNetworkRequest request;
     request.setHeader(QNetworkRequest::UserAgentHeader, m_userAgent);
     request.setUrl(url);
+    prepareTileRequest(spec, &request);
     QNetworkReply *reply = m_nm->get(request);
     return new QGeoMapReplyOsm(reply, spec, m_providers[id]->format());
 }
 
+QString QGeoTileFetcherOsm::tileHost(const QGeoTileSpec &spec) const
+{
+    const int id = spec.mapId() - 1;
+    if (id < 0 || id >= m_providers.size())
+        return QString();
+    return m_providers[id]->tileAddress(spec.x(), spec.y(), spec.zoom()).host();
+}
+
 void QGeoTileFetcherOsm::readyUpdated()
 {
     updateTileRequests(QSet<QGeoTileSpec>(), QSet<QGeoTileSpec>());
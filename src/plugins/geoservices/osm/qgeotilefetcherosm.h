@@ -68,6 +68,7 @@ Q_SIGNALS:
 
 protected:
     bool initialized() const override;
+    QString tileHost(const QGeoTileSpec &spec) const override;
 
 protected Q_SLOTS:
     void onProviderResolutionFinished(const QGeoTileProviderOsm *provider);
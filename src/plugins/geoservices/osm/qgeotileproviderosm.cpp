@@ -415,6 +415,10 @@ void TileProvider::onNetworkReplyFinished()
      * placeholders for the actual parameters.
      * Example:
      * http://localhost:8080/maps/%z/%x/%y.png
+     * It may also contain a list of alternatives in braces, usually subdomains, which the
+     * requests are spread over. Each tile is always requested from the same alternative.
+     * Example:
+     * https://{a,b,c}.tile.example.org/%z/%x/%y.png
      *
      * ImageFormat is required, and is the format of the tile.
      * Examples:
@@ -524,6 +528,21 @@ void TileProvider::setupProvider()
     if (m_maximumZoomLevel < 0 || m_maximumZoomLevel > 30 ||  m_maximumZoomLevel < m_minimumZoomLevel)
         return;
 
+    // Optional alternatives, like {a,b,c}
+    m_subdomainGroup.clear();
+    m_subdomains.clear();
+    const int open = m_urlTemplate.indexOf(QLatin1Char('{'));
+    if (open >= 0) {
+        const int close = m_urlTemplate.indexOf(QLatin1Char('}'), open);
+        if (close < 0)
+            return;
+        m_subdomainGroup = m_urlTemplate.mid(open, close - open + 1);
+        m_subdomains = m_urlTemplate.mid(open + 1, close - open - 1).split(QLatin1Char(','),
+                                                                           QString::SkipEmptyParts);
+        if (m_subdomains.isEmpty())
+            return;
+    }
+
     // Currently supporting only %x, %y and &z
     int offset[3];
     offset[0] = m_urlTemplate.indexOf(QLatin1String("%x"));
@@ -649,6 +668,9 @@ QUrl TileProvider::tileAddress(int x, int y, int z) const
     url += paramsSep[1];
     url += QString::number(params[paramsLUT[2]]);
     url += m_urlSuffix;
+    // Neighbouring tiles go to different hosts, and each tile always to the same one.
+    if (!m_subdomains.isEmpty())
+        url.replace(m_subdomainGroup, m_subdomains.at((x + y) % m_subdomains.size()));
     return QUrl(url);
 }
 
@@ -41,6 +41,7 @@
 #include <QtLocation/private/qgeocameracapabilities_p.h>
 #include <QtCore/QUrl>
 #include <QtCore/QVector>
+#include <QtCore/QStringList>
 #include <QtNetwork/QNetworkAccessManager>
 #include <QtNetwork/QNetworkReply>
 #include <QtCore/QPointer>
@@ -110,6 +111,8 @@ public:
     QString m_copyRightStyle;
     QString m_urlPrefix;
     QString m_urlSuffix;
+    QString m_subdomainGroup;
+    QStringList m_subdomains;
     int m_minimumZoomLevel;
     int m_maximumZoomLevel;
     QDateTime m_timestamp;
@@ -40,7 +40,6 @@
 #include "qplacesearchreplyosm.h"
 #include "qplacemanagerengineosm.h"
 
-#include <QtCore/QJsonDocument>
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonObject>
 #include <QtNetwork/QNetworkReply>
@@ -63,7 +62,12 @@ QPlaceSearchReplyOsm::QPlaceSearchReplyOsm(const QPlaceSearchRequest &request,
     }
     setRequest(request);
 
+    // Nominatim answers with an array of places, whose results are reported
+    // as they arrive.
+    m_reader.addArrayPath(QStringList());
+
     connect(reply, SIGNAL(finished()), this, SLOT(replyFinished()));
+    connect(reply, SIGNAL(readyRead()), this, SLOT(replyReadyRead()));
     connect(reply, SIGNAL(error(QNetworkReply::NetworkError)), this, SLOT(networkError(QNetworkReply::NetworkError)));
     connect(this, &QPlaceReply::aborted, reply, &QNetworkReply::abort);
     connect(this, &QObject::destroyed, reply, &QObject::deleteLater);
@@ -102,26 +106,16 @@ void QPlaceSearchReplyOsm::replyFinished()
     if (reply->error() != QNetworkReply::NoError)
         return;
 
-    QJsonDocument document = QJsonDocument::fromJson(reply->readAll());
-    if (!document.isArray()) {
+    readResults(reply);
+    if (m_reader.hasError() || !m_reader.atEnd() || !m_reader.arrayFound()) {
         setError(ParseError, tr("Response parse error"));
         return;
     }
 
-    QJsonArray resultsArray = document.array();
-
-    QGeoCoordinate searchCenter = request().searchArea().center();
-
     QStringList placeIds;
-
-    QList<QPlaceSearchResult> results;
-    for (int i = 0; i < resultsArray.count(); ++i) {
-        QJsonObject item = resultsArray.at(i).toObject();
-        QPlaceResult pr = parsePlaceResult(item);
-        pr.setDistance(searchCenter.distanceTo(pr.place().location().coordinate()));
-        placeIds.append(pr.place().placeId());
-        results.append(pr);
-    }
+    placeIds.reserve(m_results.size());
+    for (const QPlaceSearchResult &result : qAsConst(m_results))
+        placeIds.append(QPlaceResult(result).place().placeId());
 
     QVariantMap searchContext = request().searchContext().toMap();
     QStringList excludePlaceIds =
@@ -157,12 +151,43 @@ void QPlaceSearchReplyOsm::replyFinished()
         setNextPageRequest(r);
     }
 
-    setResults(results);
+    setResults(m_results);
 
     setFinished(true);
     emit finished();
 }
 
+void QPlaceSearchReplyOsm::replyReadyRead()
+{
+    QNetworkReply *reply = static_cast<QNetworkReply *>(sender());
+    if (reply->error() != QNetworkReply::NoError || isFinished())
+        return;
+
+    if (readResults(reply)) {
+        setResults(m_results);
+        emit contentUpdated();
+    }
+}
+
+/*
+    Parses the places of the response received so far, returns true if there
+    were new ones.
+*/
+bool QPlaceSearchReplyOsm::readResults(QNetworkReply *reply)
+{
+    m_reader.addData(reply->readAll());
+    const QList<QJsonObject> items = m_reader.takeObjects();
+
+    const QGeoCoordinate searchCenter = request().searchArea().center();
+    for (const QJsonObject &item : items) {
+        QPlaceResult pr = parsePlaceResult(item);
+        pr.setDistance(searchCenter.distanceTo(pr.place().location().coordinate()));
+        m_results.append(pr);
+    }
+
+    return !items.isEmpty();
+}
+
 void QPlaceSearchReplyOsm::networkError(QNetworkReply::NetworkError error)
 {
     Q_UNUSED(error)
@@ -41,6 +41,7 @@
 #define QPLACESEARCHREPLYOSM_H
 
 #include <QtLocation/QPlaceSearchReply>
+#include <QtLocation/private/qplacejsonstreamreader_p.h>
 #include <QNetworkReply>
 
 QT_BEGIN_NAMESPACE
@@ -63,10 +64,15 @@ public:
 private slots:
     void setError(QPlaceReply::Error errorCode, const QString &errorString);
     void replyFinished();
+    void replyReadyRead();
     void networkError(QNetworkReply::NetworkError error);
 
 private:
     QPlaceResult parsePlaceResult(const QJsonObject &item) const;
+    bool readResults(QNetworkReply *reply);
+
+    QPlaceJsonStreamReader m_reader;
+    QList<QPlaceSearchResult> m_results;
 };
 
 QT_END_NAMESPACE
@@ -39,6 +39,8 @@
 
 #include "qgeopositioninfosourcefactory_serialnmea.h"
 #include <QtPositioning/qnmeapositioninfosource.h>
+#include <QtPositioning/qnmeasatelliteinfosource.h>
+#include <QtPositioning/private/qgeopositioninfosourcehub_p.h>
 #include <QtSerialPort/qserialport.h>
 #include <QtSerialPort/qserialportinfo.h>
 #include <QtCore/qloggingcategory.h>
@@ -46,28 +48,23 @@
 
 Q_LOGGING_CATEGORY(lcSerial, "qt.positioning.serialnmea")
 
-class NmeaSource : public QNmeaPositionInfoSource
+// The serial port can only be opened once, so it is shared by every source
+// this plugin creates for as long as one of them is alive.
+static QSharedPointer<QSerialPort> sharedSerialPort()
 {
-public:
-    NmeaSource(QObject *parent);
-    bool isValid() const { return !m_port.isNull(); }
+    static QWeakPointer<QSerialPort> sharedPort;
+    QSharedPointer<QSerialPort> port = sharedPort.toStrongRef();
+    if (port)
+        return port;
 
-private:
-    QScopedPointer<QSerialPort> m_port;
-};
-
-NmeaSource::NmeaSource(QObject *parent)
-    : QNmeaPositionInfoSource(RealTimeMode, parent),
-      m_port(new QSerialPort)
-{
+    port.reset(new QSerialPort);
     QByteArray requestedPort = qgetenv("QT_NMEA_SERIAL_PORT");
     if (requestedPort.isEmpty()) {
         const QList<QSerialPortInfo> ports = QSerialPortInfo::availablePorts();
         qCDebug(lcSerial) << "Found" << ports.count() << "serial ports";
         if (ports.isEmpty()) {
             qWarning("serialnmea: No serial ports found");
-            m_port.reset();
-            return;
+            return QSharedPointer<QSerialPort>();
         }
 
         // Try to find a well-known device.
@@ -75,49 +72,94 @@ NmeaSource::NmeaSource(QObject *parent)
         supportedDevices << 0x67b; // GlobalSat (BU-353S4 and probably others)
         supportedDevices << 0xe8d; // Qstarz MTK II
         QString portName;
-        foreach (const QSerialPortInfo& port, ports) {
-            if (port.hasVendorIdentifier() && supportedDevices.contains(port.vendorIdentifier())) {
-                portName = port.portName();
+        foreach (const QSerialPortInfo& info, ports) {
+            if (info.hasVendorIdentifier() && supportedDevices.contains(info.vendorIdentifier())) {
+                portName = info.portName();
                 break;
             }
         }
 
         if (portName.isEmpty()) {
             qWarning("serialnmea: No known GPS device found. Specify the COM port via QT_NMEA_SERIAL_PORT.");
-            m_port.reset();
-            return;
+            return QSharedPointer<QSerialPort>();
         }
 
-        m_port->setPortName(portName);
+        port->setPortName(portName);
     } else {
-        m_port->setPortName(QString::fromUtf8(requestedPort));
+        port->setPortName(QString::fromUtf8(requestedPort));
     }
 
-    m_port->setBaudRate(4800);
+    port->setBaudRate(4800);
 
-    qCDebug(lcSerial) << "Opening serial port" << m_port->portName();
+    qCDebug(lcSerial) << "Opening serial port" << port->portName();
 
-    if (!m_port->open(QIODevice::ReadOnly)) {
-        qWarning("serialnmea: Failed to open %s", qPrintable(m_port->portName()));
-        m_port.reset();
-        return;
+    if (!port->open(QIODevice::ReadOnly)) {
+        qWarning("serialnmea: Failed to open %s", qPrintable(port->portName()));
+        return QSharedPointer<QSerialPort>();
     }
 
-    setDevice(m_port.data());
-
     qCDebug(lcSerial) << "Opened successfully";
+
+    sharedPort = port;
+    return port;
 }
 
-QGeoPositionInfoSource *QGeoPositionInfoSourceFactorySerialNmea::positionInfoSource(QObject *parent)
+class NmeaSource : public QNmeaPositionInfoSource
+{
+public:
+    NmeaSource(QObject *parent);
+    bool isValid() const { return !m_port.isNull(); }
+
+private:
+    QSharedPointer<QSerialPort> m_port;
+};
+
+NmeaSource::NmeaSource(QObject *parent)
+    : QNmeaPositionInfoSource(RealTimeMode, parent),
+      m_port(sharedSerialPort())
+{
+    if (m_port)
+        setDevice(m_port.data());
+}
+
+class NmeaSatelliteSource : public QNmeaSatelliteInfoSource
+{
+public:
+    NmeaSatelliteSource(QObject *parent);
+    bool isValid() const { return !m_port.isNull(); }
+
+private:
+    QSharedPointer<QSerialPort> m_port;
+};
+
+NmeaSatelliteSource::NmeaSatelliteSource(QObject *parent)
+    : QNmeaSatelliteInfoSource(RealTimeMode, parent),
+      m_port(sharedSerialPort())
+{
+    // Both sources read the port through the same QNmeaDeviceReader, so
+    // every sentence is read once and handed to both parsers.
+    if (m_port)
+        setDevice(m_port.data());
+}
+
+static QGeoPositionInfoSource *createNmeaSource()
 {
-    QScopedPointer<NmeaSource> src(new NmeaSource(parent));
+    QScopedPointer<NmeaSource> src(new NmeaSource(nullptr));
     return src->isValid() ? src.take() : nullptr;
 }
 
+QGeoPositionInfoSource *QGeoPositionInfoSourceFactorySerialNmea::positionInfoSource(QObject *parent)
+{
+    // All position sources created by this plugin share one NmeaSource, so
+    // the position is parsed once and fanned out.
+    return QGeoPositionInfoSourceHub::createSharedSource(QStringLiteral("serialnmea"),
+                                                        createNmeaSource, parent);
+}
+
 QGeoSatelliteInfoSource *QGeoPositionInfoSourceFactorySerialNmea::satelliteInfoSource(QObject *parent)
 {
-    Q_UNUSED(parent);
-    return nullptr;
+    QScopedPointer<NmeaSatelliteSource> src(new NmeaSatelliteSource(parent));
+    return src->isValid() ? src.take() : nullptr;
 }
 
 QGeoAreaMonitorSource *QGeoPositionInfoSourceFactorySerialNmea::areaMonitor(QObject *parent)
@@ -1,6 +1,6 @@
 TARGET = qtposition_serialnmea
 
-QT = core positioning serialport
+QT = core positioning-private serialport
 
 HEADERS += \
     qgeopositioninfosourcefactory_serialnmea.h
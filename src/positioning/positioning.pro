@@ -34,6 +34,7 @@ PUBLIC_HEADERS += \
                     qgeosatelliteinfo.h \
                     qgeosatelliteinfosource.h \
                     qnmeapositioninfosource.h \
+                    qnmeasatelliteinfosource.h \
                     qgeopositioninfosourcefactory.h \
                     qpositioningglobal.h \
                     qgeopolygon.h \
@@ -47,8 +48,15 @@ PRIVATE_HEADERS += \
                     qgeolocation_p.h \
                     qlocationutils_p.h \
                     qnmeapositioninfosource_p.h \
+                    qnmeasatelliteinfosource_p.h \
+                    qnmeadevicereader_p.h \
+                    qubxdecoder_p.h \
+                    qubxpositioninfosource_p.h \
+                    qubxsatelliteinfosource_p.h \
                     qgeocoordinate_p.h \
+                    qgeogreatcircle_p.h \
                     qgeopositioninfosource_p.h \
+                    qgeopositioninfosourcehub_p.h \
                     qdeclarativegeoaddress_p.h \
                     qdeclarativegeolocation_p.h \
                     qdoublevector2d_p.h \
@@ -70,13 +78,20 @@ SOURCES += \
             qgeorectangle.cpp \
             qgeocircle.cpp \
             qgeocoordinate.cpp \
+            qgeogreatcircle.cpp \
             qgeolocation.cpp \
             qgeopositioninfo.cpp \
             qgeopositioninfosource.cpp \
+            qgeopositioninfosourcehub.cpp \
             qgeosatelliteinfo.cpp \
             qgeosatelliteinfosource.cpp \
             qlocationutils.cpp \
             qnmeapositioninfosource.cpp \
+            qnmeasatelliteinfosource.cpp \
+            qnmeadevicereader.cpp \
+            qubxdecoder.cpp \
+            qubxpositioninfosource.cpp \
+            qubxsatelliteinfosource.cpp \
             qgeopositioninfosourcefactory.cpp \
             qdeclarativegeoaddress.cpp \
             qdeclarativegeolocation.cpp \
@@ -0,0 +1,253 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtPositioning module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeogreatcircle_p.h"
+#include "qlocationutils_p.h"
+
+#include <QtCore/qmath.h>
+#include <algorithm>
+#include <cmath>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+const double kDegToRad = M_PI / 180.0;
+const double kRadToDeg = 180.0 / M_PI;
+
+inline double haversineLength(double latRad1, double lngRad1, double cosLat1,
+                              double latRad2, double lngRad2, double cosLat2)
+{
+    const double sinHalfDLat = std::sin((latRad2 - latRad1) * 0.5);
+    const double sinHalfDLng = std::sin((lngRad2 - lngRad1) * 0.5);
+    const double y = sinHalfDLat * sinHalfDLat + cosLat1 * cosLat2 * sinHalfDLng * sinHalfDLng;
+    // rounding may push y slightly above 1 for antipodal points
+    return 2.0 * QLocationUtils::earthMeanRadius() * std::asin(std::sqrt(std::fmin(y, 1.0)));
+}
+
+inline double equirectangularLength(double latRad1, double lngRad1, double cosLat1,
+                                    double latRad2, double lngRad2, double cosLat2)
+{
+    double dLng = lngRad2 - lngRad1;
+    dLng -= 2.0 * M_PI * std::floor(dLng / (2.0 * M_PI) + 0.5); // shortest way round
+    const double x = dLng * (cosLat1 + cosLat2) * 0.5;
+    const double y = latRad2 - latRad1;
+    return QLocationUtils::earthMeanRadius() * std::sqrt(x * x + y * y);
+}
+
+} // namespace
+
+/*
+    Writes to \a distances the great-circle distance in meters from \a origin to
+    each of the \a count packed coordinates in \a latLng. All distances are 0 if
+    \a origin is invalid.
+*/
+void QGeoGreatCircle::distancesFrom(const QGeoCoordinate &origin, const double *latLng, int count,
+                                    double *distances, Precision precision)
+{
+    if (!origin.isValid()) {
+        std::fill(distances, distances + count, 0.0);
+        return;
+    }
+
+    const double latRad0 = origin.latitude() * kDegToRad;
+    const double lngRad0 = origin.longitude() * kDegToRad;
+    const double cosLat0 = std::cos(latRad0);
+
+    if (precision == Approximate) {
+        for (int i = 0; i < count; ++i) {
+            const double latRad = latLng[2 * i] * kDegToRad;
+            distances[i] = equirectangularLength(latRad0, lngRad0, cosLat0,
+                                                 latRad, latLng[2 * i + 1] * kDegToRad,
+                                                 std::cos(latRad));
+        }
+    } else {
+        for (int i = 0; i < count; ++i) {
+            const double latRad = latLng[2 * i] * kDegToRad;
+            distances[i] = haversineLength(latRad0, lngRad0, cosLat0,
+                                           latRad, latLng[2 * i + 1] * kDegToRad,
+                                           std::cos(latRad));
+        }
+    }
+}
+
+/*
+    Writes to \a azimuths the initial bearing in degrees, in the range [0, 360),
+    from \a origin to each of the \a count packed coordinates in \a latLng, as
+    QGeoCoordinate::azimuthTo() would. All azimuths are 0 if \a origin is invalid.
+*/
+void QGeoGreatCircle::azimuthsFrom(const QGeoCoordinate &origin, const double *latLng, int count,
+                                   double *azimuths)
+{
+    if (!origin.isValid()) {
+        std::fill(azimuths, azimuths + count, 0.0);
+        return;
+    }
+
+    const double latRad0 = origin.latitude() * kDegToRad;
+    const double lngRad0 = origin.longitude() * kDegToRad;
+    const double sinLat0 = std::sin(latRad0);
+    const double cosLat0 = std::cos(latRad0);
+
+    for (int i = 0; i < count; ++i) {
+        const double latRad = latLng[2 * i] * kDegToRad;
+        const double dLng = latLng[2 * i + 1] * kDegToRad - lngRad0;
+        const double cosLat = std::cos(latRad);
+        const double y = std::sin(dLng) * cosLat;
+        const double x = cosLat0 * std::sin(latRad) - sinLat0 * cosLat * std::cos(dLng);
+        azimuths[i] = std::fmod(std::atan2(y, x) * kRadToDeg + 360.0, 360.0);
+    }
+}
+
+/*
+    Writes to \a latLng the \a count coordinates reached by travelling \a distance
+    meters from \a origin along a great circle at each of the given \a azimuths
+    (in degrees). Longitudes are wrapped into [-180, 180].
+*/
+void QGeoGreatCircle::pointsAtDistance(const QGeoCoordinate &origin, double distance,
+                                       const double *azimuths, int count, double *latLng)
+{
+    if (!origin.isValid()) {
+        std::fill(latLng, latLng + 2 * count, qQNaN());
+        return;
+    }
+
+    const double latRad0 = origin.latitude() * kDegToRad;
+    const double lngRad0 = origin.longitude() * kDegToRad;
+    const double ratio = distance / QLocationUtils::earthMeanRadius();
+    const double sinLat0 = std::sin(latRad0);
+    const double sinLat0CosRatio = sinLat0 * std::cos(ratio);
+    const double cosLat0SinRatio = std::cos(latRad0) * std::sin(ratio);
+    const double cosRatio = std::cos(ratio);
+
+    for (int i = 0; i < count; ++i) {
+        const double azimuthRad = azimuths[i] * kDegToRad;
+        const double latRad = std::asin(sinLat0CosRatio + cosLat0SinRatio * std::cos(azimuthRad));
+        const double lngRad = lngRad0 + std::atan2(std::sin(azimuthRad) * cosLat0SinRatio,
+                                                   cosRatio - sinLat0 * std::sin(latRad));
+        latLng[2 * i] = latRad * kRadToDeg;
+        latLng[2 * i + 1] = QLocationUtils::wrapLong(lngRad * kRadToDeg);
+    }
+}
+
+/*
+    Returns the length in meters of the path through the \a count packed
+    coordinates in \a latLng. If \a lengths is not null, the distance along the
+    path from the first coordinate to each coordinate is written to it.
+*/
+double QGeoGreatCircle::cumulativeLengths(const double *latLng, int count, double *lengths,
+                                          Precision precision)
+{
+    if (count <= 0)
+        return 0.0;
+
+    double prevLatRad = latLng[0] * kDegToRad;
+    double prevLngRad = latLng[1] * kDegToRad;
+    double prevCosLat = std::cos(prevLatRad);
+    double total = 0.0;
+    if (lengths)
+        lengths[0] = 0.0;
+
+    for (int i = 1; i < count; ++i) {
+        const double latRad = latLng[2 * i] * kDegToRad;
+        const double lngRad = latLng[2 * i + 1] * kDegToRad;
+        const double cosLat = std::cos(latRad);
+        total += precision == Approximate
+                ? equirectangularLength(prevLatRad, prevLngRad, prevCosLat, latRad, lngRad, cosLat)
+                : haversineLength(prevLatRad, prevLngRad, prevCosLat, latRad, lngRad, cosLat);
+        if (lengths)
+            lengths[i] = total;
+        prevLatRad = latRad;
+        prevLngRad = lngRad;
+        prevCosLat = cosLat;
+    }
+    return total;
+}
+
+/*
+    Returns the length in meters of \a path between \a indexFrom and \a indexTo,
+    which must be valid indices. Each cosine is computed once and shared by the
+    two segments adjacent to a vertex. Like QGeoCoordinate::distanceTo(),
+    segments with an invalid end point have a length of 0.
+*/
+double QGeoGreatCircle::pathLength(const QList<QGeoCoordinate> &path, int indexFrom, int indexTo,
+                                   Precision precision)
+{
+    if (indexFrom >= indexTo)
+        return 0.0;
+
+    const QGeoCoordinate &first = path.at(indexFrom);
+    bool prevValid = first.isValid();
+    double prevLatRad = first.latitude() * kDegToRad;
+    double prevLngRad = first.longitude() * kDegToRad;
+    double prevCosLat = std::cos(prevLatRad);
+    double total = 0.0;
+
+    for (int i = indexFrom + 1; i <= indexTo; ++i) {
+        const QGeoCoordinate &c = path.at(i);
+        const bool valid = c.isValid();
+        const double latRad = c.latitude() * kDegToRad;
+        const double lngRad = c.longitude() * kDegToRad;
+        const double cosLat = std::cos(latRad);
+        if (valid && prevValid) {
+            total += precision == Approximate
+                    ? equirectangularLength(prevLatRad, prevLngRad, prevCosLat, latRad, lngRad, cosLat)
+                    : haversineLength(prevLatRad, prevLngRad, prevCosLat, latRad, lngRad, cosLat);
+        }
+        prevValid = valid;
+        prevLatRad = latRad;
+        prevLngRad = lngRad;
+        prevCosLat = cosLat;
+    }
+    return total;
+}
+
+/*
+    Returns \a coordinates packed as latitude/longitude pairs.
+*/
+QVector<double> QGeoGreatCircle::pack(const QList<QGeoCoordinate> &coordinates)
+{
+    QVector<double> packed;
+    packed.reserve(2 * coordinates.size());
+    for (const QGeoCoordinate &c : coordinates)
+        packed << c.latitude() << c.longitude();
+    return packed;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,98 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtPositioning module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOGREATCIRCLE_P_H
+#define QGEOGREATCIRCLE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/QList>
+#include <QtCore/QVector>
+#include <QtPositioning/QGeoCoordinate>
+#include <QtPositioning/private/qpositioningglobal_p.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Bulk versions of the spherical-earth computations in QGeoCoordinate.
+
+    Coordinates are passed packed as latitude/longitude pairs in decimal degrees
+    (lat0, lng0, lat1, lng1, ...) and must all be valid. The per origin terms are
+    computed once and the loops are kept branch free so that they can be
+    vectorized by the compiler.
+*/
+class Q_POSITIONING_PRIVATE_EXPORT QGeoGreatCircle
+{
+public:
+    enum Precision {
+        // Haversine formula, same results as QGeoCoordinate::distanceTo()
+        Exact,
+        // Equirectangular projection, no trigonometry apart from one cosine per
+        // coordinate. The relative error is below 0.001% for points less than
+        // 10 km apart and below 0.05% for points less than 100 km apart, as long
+        // as they are within 80 degrees of the equator. It grows quickly beyond that.
+        Approximate
+    };
+
+    static void distancesFrom(const QGeoCoordinate &origin, const double *latLng, int count,
+                              double *distances, Precision precision = Exact);
+    static void azimuthsFrom(const QGeoCoordinate &origin, const double *latLng, int count,
+                             double *azimuths);
+    static void pointsAtDistance(const QGeoCoordinate &origin, double distance,
+                                 const double *azimuths, int count, double *latLng);
+    static double cumulativeLengths(const double *latLng, int count, double *lengths = nullptr,
+                                    Precision precision = Exact);
+    static double pathLength(const QList<QGeoCoordinate> &path, int indexFrom, int indexTo,
+                             Precision precision = Exact);
+
+    static QVector<double> pack(const QList<QGeoCoordinate> &coordinates);
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOGREATCIRCLE_P_H
@@ -42,6 +42,7 @@
 #include "qgeopath_p.h"
 
 #include "qgeocoordinate.h"
+#include "qgeogreatcircle_p.h"
 #include "qnumeric.h"
 #include "qlocationutils_p.h"
 #include "qwebmercator_p.h"
@@ -496,8 +497,7 @@ double QGeoPathPrivate::length(int indexFrom, int indexTo) const
     double len = 0.0;
     // TODO: consider calculating the length of the actual rhumb line segments
     // instead of the shortest path from A to B.
-    for (int i = indexFrom; i < indexTo; i++)
-        len += m_path[i].distanceTo(m_path[i+1]);
+    len += QGeoGreatCircle::pathLength(m_path, indexFrom, indexTo);
     if (wrap)
         len += m_path.last().distanceTo(m_path.first());
     return len;
@@ -0,0 +1,479 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtPositioning module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeopositioninfosourcehub_p.h"
+
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QWeakPointer>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    QGeoPositionInfoSourceHub multiplexes a single backend position source
+    across any number of QGeoSharedPositionInfoSource subscribers.
+
+    The backend is parsed/driven once. It runs at the fastest rate requested
+    by any active subscriber and is stopped while no subscriber is active.
+    Each subscriber then thins the shared stream down to its own update
+    interval and decimation before emitting positionUpdated().
+
+    Hubs are reference counted through their subscribers and can be shared
+    process-wide by key, see sharedHub().
+*/
+
+namespace {
+struct HubRegistry
+{
+    QMutex mutex;
+    QHash<QString, QWeakPointer<QGeoPositionInfoSourceHub> > hubs;
+};
+}
+
+Q_GLOBAL_STATIC(HubRegistry, hubRegistry)
+
+QGeoPositionInfoSourceHub::QGeoPositionInfoSourceHub(QGeoPositionInfoSource *backend)
+    : QObject(nullptr), m_backend(backend), m_dispatching(0), m_backendRunning(false),
+      m_backendRequestPending(false)
+{
+    Q_ASSERT(backend);
+    backend->setParent(nullptr);
+
+    connect(backend, SIGNAL(positionUpdated(QGeoPositionInfo)),
+            this, SLOT(backendPositionUpdated(QGeoPositionInfo)));
+    connect(backend, SIGNAL(updateTimeout()),
+            this, SLOT(backendUpdateTimeout()));
+    connect(backend, SIGNAL(error(QGeoPositionInfoSource::Error)),
+            this, SLOT(backendError(QGeoPositionInfoSource::Error)));
+    connect(backend, &QGeoPositionInfoSource::supportedPositioningMethodsChanged, this, [this]() {
+        ++m_dispatching;
+        const QList<QGeoSharedPositionInfoSource *> subscribers = m_subscribers;
+        for (QGeoSharedPositionInfoSource *s : subscribers)
+            emit s->supportedPositioningMethodsChanged();
+        --m_dispatching;
+    });
+}
+
+QGeoPositionInfoSourceHub::~QGeoPositionInfoSourceHub()
+{
+    Q_ASSERT(m_subscribers.isEmpty());
+    releaseBackend();
+}
+
+/*
+    Stops the backend and destroys it, which closes the device it reads
+    from. A backend that is emitting the signal that released the hub is
+    only destroyed once control returns to the event loop.
+*/
+void QGeoPositionInfoSourceHub::releaseBackend()
+{
+    if (!m_backend)
+        return;
+
+    if (m_backendRunning) {
+        m_backend->stopUpdates();
+        m_backendRunning = false;
+    }
+
+    disconnect(m_backend.data(), nullptr, this, nullptr);
+    if (m_dispatching > 0)
+        m_backend.take()->deleteLater();
+    else
+        m_backend.reset();
+}
+
+/*
+    Deleter of shared hubs. The device is released right away, so that it
+    can be opened again at once, but the hub itself may be released from
+    within one of its own slots and is deleted later.
+*/
+void QGeoPositionInfoSourceHub::release(QGeoPositionInfoSourceHub *hub)
+{
+    hub->releaseBackend();
+    hub->deleteLater();
+}
+
+/*
+    Returns the hub registered under \a key, creating it with the backend
+    returned by \a createBackend if no subscriber currently holds a hub for
+    that key. Returns a null pointer if \a createBackend fails.
+
+    The hub stays alive for as long as at least one subscriber refers to it.
+*/
+QSharedPointer<QGeoPositionInfoSourceHub> QGeoPositionInfoSourceHub::sharedHub(const QString &key,
+                                                                               const BackendFactory &createBackend)
+{
+    HubRegistry *registry = hubRegistry();
+    QMutexLocker locker(&registry->mutex);
+
+    QSharedPointer<QGeoPositionInfoSourceHub> hub = registry->hubs.value(key).toStrongRef();
+    if (hub)
+        return hub;
+
+    QGeoPositionInfoSource *backend = createBackend();
+    if (!backend)
+        return QSharedPointer<QGeoPositionInfoSourceHub>();
+
+    // Drop the entries of hubs whose last subscriber went away.
+    for (auto it = registry->hubs.begin(); it != registry->hubs.end(); ) {
+        if (it->isNull())
+            it = registry->hubs.erase(it);
+        else
+            ++it;
+    }
+
+    hub = QSharedPointer<QGeoPositionInfoSourceHub>(new QGeoPositionInfoSourceHub(backend),
+                                                    &QGeoPositionInfoSourceHub::release);
+    registry->hubs.insert(key, hub);
+    return hub;
+}
+
+/*
+    Convenience function returning a new subscriber, parented to \a parent,
+    on the hub shared under \a key.
+*/
+QGeoPositionInfoSource *QGeoPositionInfoSourceHub::createSharedSource(const QString &key,
+                                                                      const BackendFactory &createBackend,
+                                                                      QObject *parent)
+{
+    QSharedPointer<QGeoPositionInfoSourceHub> hub = sharedHub(key, createBackend);
+    if (!hub)
+        return nullptr;
+    return new QGeoSharedPositionInfoSource(hub, parent);
+}
+
+QGeoPositionInfoSource *QGeoPositionInfoSourceHub::backend() const
+{
+    return m_backend.data();
+}
+
+int QGeoPositionInfoSourceHub::subscriberCount() const
+{
+    return m_subscribers.size();
+}
+
+int QGeoPositionInfoSourceHub::activeSubscriberCount() const
+{
+    int count = 0;
+    for (const QGeoSharedPositionInfoSource *s : m_subscribers) {
+        if (s->isActive())
+            ++count;
+    }
+    return count;
+}
+
+void QGeoPositionInfoSourceHub::addSubscriber(QGeoSharedPositionInfoSource *subscriber)
+{
+    if (!m_subscribers.contains(subscriber))
+        m_subscribers.append(subscriber);
+}
+
+void QGeoPositionInfoSourceHub::removeSubscriber(QGeoSharedPositionInfoSource *subscriber)
+{
+    m_subscribers.removeAll(subscriber);
+    reconfigureBackend();
+}
+
+void QGeoPositionInfoSourceHub::requestUpdate(int timeout)
+{
+    // A running backend will deliver the next fix to pending requests anyway.
+    if (m_backendRunning || m_backendRequestPending)
+        return;
+
+    m_backendRequestPending = true;
+    m_backend->requestUpdate(timeout);
+}
+
+/*
+    Runs the backend at the highest rate requested by any active subscriber,
+    where an interval of 0 means "as fast as available", and stops it when
+    no subscriber is active.
+*/
+void QGeoPositionInfoSourceHub::reconfigureBackend()
+{
+    bool anyActive = false;
+    int interval = 0;
+    for (const QGeoSharedPositionInfoSource *s : qAsConst(m_subscribers)) {
+        if (!s->isActive())
+            continue;
+        const int subscriberInterval = s->updateInterval();
+        if (!anyActive)
+            interval = subscriberInterval;
+        else if (subscriberInterval <= 0 || interval <= 0)
+            interval = 0;
+        else
+            interval = qMin(interval, subscriberInterval);
+        anyActive = true;
+    }
+
+    if (!anyActive) {
+        if (m_backendRunning) {
+            m_backend->stopUpdates();
+            m_backendRunning = false;
+        }
+        return;
+    }
+
+    if (m_backend->updateInterval() != interval)
+        m_backend->setUpdateInterval(interval);
+
+    if (!m_backendRunning) {
+        m_backendRunning = true;
+        m_backend->startUpdates();
+    }
+}
+
+void QGeoPositionInfoSourceHub::backendPositionUpdated(const QGeoPositionInfo &update)
+{
+    m_backendRequestPending = false;
+
+    // Subscribers may be destroyed or stopped from a connected slot.
+    ++m_dispatching;
+    const QList<QGeoSharedPositionInfoSource *> subscribers = m_subscribers;
+    for (QGeoSharedPositionInfoSource *s : subscribers) {
+        if (m_subscribers.contains(s))
+            s->deliverUpdate(update);
+    }
+    --m_dispatching;
+}
+
+void QGeoPositionInfoSourceHub::backendUpdateTimeout()
+{
+    m_backendRequestPending = false;
+
+    ++m_dispatching;
+    const QList<QGeoSharedPositionInfoSource *> subscribers = m_subscribers;
+    for (QGeoSharedPositionInfoSource *s : subscribers) {
+        if (m_subscribers.contains(s))
+            s->deliverTimeout();
+    }
+    --m_dispatching;
+}
+
+void QGeoPositionInfoSourceHub::backendError(QGeoPositionInfoSource::Error error)
+{
+    ++m_dispatching;
+    const QList<QGeoSharedPositionInfoSource *> subscribers = m_subscribers;
+    for (QGeoSharedPositionInfoSource *s : subscribers) {
+        if (m_subscribers.contains(s))
+            s->deliverError(error);
+    }
+    --m_dispatching;
+}
+
+//============================================================
+
+QGeoSharedPositionInfoSource::QGeoSharedPositionInfoSource(const QSharedPointer<QGeoPositionInfoSourceHub> &hub,
+                                                           QObject *parent)
+    : QGeoPositionInfoSource(parent), m_hub(hub), m_decimation(1), m_skipped(0),
+      m_active(false), m_requestPending(false)
+{
+    Q_ASSERT(m_hub);
+    m_requestTimer.setSingleShot(true);
+    connect(&m_requestTimer, SIGNAL(timeout()), this, SLOT(requestTimeout()));
+    m_hub->addSubscriber(this);
+}
+
+QGeoSharedPositionInfoSource::~QGeoSharedPositionInfoSource()
+{
+    m_active = false;
+    m_hub->removeSubscriber(this);
+}
+
+void QGeoSharedPositionInfoSource::setUpdateInterval(int msec)
+{
+    int interval = msec;
+    if (interval != 0)
+        interval = qMax(msec, minimumUpdateInterval());
+    QGeoPositionInfoSource::setUpdateInterval(interval);
+    if (m_active)
+        m_hub->reconfigureBackend();
+}
+
+void QGeoSharedPositionInfoSource::setPreferredPositioningMethods(PositioningMethods methods)
+{
+    // The backend is shared, so the preference is only recorded locally.
+    QGeoPositionInfoSource::setPreferredPositioningMethods(methods);
+}
+
+/*
+    Sets the subscriber to emit only every \a decimation-th update it would
+    otherwise emit. Values below 1 are treated as 1, i.e. no decimation.
+*/
+void QGeoSharedPositionInfoSource::setDecimation(int decimation)
+{
+    m_decimation = qMax(1, decimation);
+    m_skipped = 0;
+}
+
+int QGeoSharedPositionInfoSource::decimation() const
+{
+    return m_decimation;
+}
+
+bool QGeoSharedPositionInfoSource::isActive() const
+{
+    return m_active;
+}
+
+QGeoPositionInfo QGeoSharedPositionInfoSource::lastKnownPosition(bool fromSatellitePositioningMethodsOnly) const
+{
+    return m_hub->backend()->lastKnownPosition(fromSatellitePositioningMethodsOnly);
+}
+
+QGeoPositionInfoSource::PositioningMethods QGeoSharedPositionInfoSource::supportedPositioningMethods() const
+{
+    return m_hub->backend()->supportedPositioningMethods();
+}
+
+int QGeoSharedPositionInfoSource::minimumUpdateInterval() const
+{
+    return m_hub->backend()->minimumUpdateInterval();
+}
+
+QGeoPositionInfoSource::Error QGeoSharedPositionInfoSource::error() const
+{
+    return m_hub->backend()->error();
+}
+
+void QGeoSharedPositionInfoSource::startUpdates()
+{
+    if (m_active)
+        return;
+
+    m_active = true;
+    m_skipped = 0;
+    m_lastEmitted.invalidate();
+    m_lastEmittedTimestamp = QDateTime();
+    m_hub->reconfigureBackend();
+}
+
+void QGeoSharedPositionInfoSource::stopUpdates()
+{
+    if (!m_active)
+        return;
+
+    m_active = false;
+    m_hub->reconfigureBackend();
+}
+
+void QGeoSharedPositionInfoSource::requestUpdate(int timeout)
+{
+    if (m_requestPending)
+        return;
+
+    if (timeout < 0 || (timeout > 0 && timeout < minimumUpdateInterval())) {
+        emit updateTimeout();
+        return;
+    }
+
+    m_requestPending = true;
+    if (timeout > 0)
+        m_requestTimer.start(timeout);
+    m_hub->requestUpdate(timeout);
+}
+
+void QGeoSharedPositionInfoSource::requestTimeout()
+{
+    if (!m_requestPending)
+        return;
+
+    m_requestPending = false;
+    emit updateTimeout();
+}
+
+void QGeoSharedPositionInfoSource::deliverUpdate(const QGeoPositionInfo &update)
+{
+    if (m_requestPending) {
+        m_requestPending = false;
+        m_requestTimer.stop();
+        // A pending request answered by this update also counts for the
+        // periodic updates, so they are not emitted twice.
+        m_lastEmitted.start();
+        m_lastEmittedTimestamp = update.timestamp();
+        emit positionUpdated(update);
+        return;
+    }
+
+    if (!m_active)
+        return;
+
+    if (++m_skipped < m_decimation)
+        return;
+    m_skipped = 0;
+
+    const int interval = updateInterval();
+    if (interval > 0 && m_lastEmitted.isValid()) {
+        // Prefer the fix timestamps, so replayed logs are thinned the same
+        // way as live data. Wall clock time needs some tolerance for the
+        // jitter in the backend delivery.
+        qint64 elapsed;
+        qint64 tolerance = 0;
+        if (m_lastEmittedTimestamp.isValid() && update.timestamp().isValid()) {
+            elapsed = m_lastEmittedTimestamp.msecsTo(update.timestamp());
+        } else {
+            elapsed = m_lastEmitted.elapsed();
+            tolerance = interval / 10;
+        }
+        if (elapsed >= 0 && elapsed < interval - tolerance)
+            return;
+    }
+
+    m_lastEmitted.start();
+    m_lastEmittedTimestamp = update.timestamp();
+    emit positionUpdated(update);
+}
+
+void QGeoSharedPositionInfoSource::deliverTimeout()
+{
+    if (m_requestPending && !m_requestTimer.isActive()) {
+        // requestUpdate(0) relies on the backend's default timeout.
+        m_requestPending = false;
+        emit updateTimeout();
+    } else if (m_active) {
+        emit updateTimeout();
+    }
+}
+
+void QGeoSharedPositionInfoSource::deliverError(QGeoPositionInfoSource::Error positionError)
+{
+    emit QGeoPositionInfoSource::error(positionError);
+}
+
+QT_END_NAMESPACE
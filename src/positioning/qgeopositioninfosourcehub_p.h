@@ -0,0 +1,159 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtPositioning module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOPOSITIONINFOSOURCEHUB_P_H
+#define QGEOPOSITIONINFOSOURCEHUB_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtPositioning/private/qpositioningglobal_p.h>
+#include <QtPositioning/qgeopositioninfosource.h>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QList>
+#include <QtCore/QScopedPointer>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QTimer>
+
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoSharedPositionInfoSource;
+
+class Q_POSITIONING_PRIVATE_EXPORT QGeoPositionInfoSourceHub : public QObject
+{
+    Q_OBJECT
+public:
+    typedef std::function<QGeoPositionInfoSource *()> BackendFactory;
+
+    explicit QGeoPositionInfoSourceHub(QGeoPositionInfoSource *backend);
+    ~QGeoPositionInfoSourceHub();
+
+    static QSharedPointer<QGeoPositionInfoSourceHub> sharedHub(const QString &key,
+                                                               const BackendFactory &createBackend);
+    static QGeoPositionInfoSource *createSharedSource(const QString &key,
+                                                     const BackendFactory &createBackend,
+                                                     QObject *parent);
+
+    QGeoPositionInfoSource *backend() const;
+    int subscriberCount() const;
+    int activeSubscriberCount() const;
+
+private Q_SLOTS:
+    void backendPositionUpdated(const QGeoPositionInfo &update);
+    void backendUpdateTimeout();
+    void backendError(QGeoPositionInfoSource::Error error);
+
+private:
+    void addSubscriber(QGeoSharedPositionInfoSource *subscriber);
+    void removeSubscriber(QGeoSharedPositionInfoSource *subscriber);
+    void requestUpdate(int timeout);
+    void reconfigureBackend();
+    void releaseBackend();
+    static void release(QGeoPositionInfoSourceHub *hub);
+
+    QScopedPointer<QGeoPositionInfoSource> m_backend;
+    QList<QGeoSharedPositionInfoSource *> m_subscribers;
+    int m_dispatching;
+    bool m_backendRunning;
+    bool m_backendRequestPending;
+
+    friend class QGeoSharedPositionInfoSource;
+};
+
+class Q_POSITIONING_PRIVATE_EXPORT QGeoSharedPositionInfoSource : public QGeoPositionInfoSource
+{
+    Q_OBJECT
+    Q_PROPERTY(int decimation READ decimation WRITE setDecimation)
+
+public:
+    QGeoSharedPositionInfoSource(const QSharedPointer<QGeoPositionInfoSourceHub> &hub,
+                                 QObject *parent = nullptr);
+    ~QGeoSharedPositionInfoSource();
+
+    void setUpdateInterval(int msec) override;
+    void setPreferredPositioningMethods(PositioningMethods methods) override;
+
+    void setDecimation(int decimation);
+    int decimation() const;
+
+    bool isActive() const;
+
+    QGeoPositionInfo lastKnownPosition(bool fromSatellitePositioningMethodsOnly = false) const override;
+    PositioningMethods supportedPositioningMethods() const override;
+    int minimumUpdateInterval() const override;
+    Error error() const override;
+
+public Q_SLOTS:
+    void startUpdates() override;
+    void stopUpdates() override;
+    void requestUpdate(int timeout = 0) override;
+
+private Q_SLOTS:
+    void requestTimeout();
+
+private:
+    void deliverUpdate(const QGeoPositionInfo &update);
+    void deliverTimeout();
+    void deliverError(QGeoPositionInfoSource::Error positionError);
+
+    QSharedPointer<QGeoPositionInfoSourceHub> m_hub;
+    QTimer m_requestTimer;
+    QElapsedTimer m_lastEmitted;
+    QDateTime m_lastEmittedTimestamp;
+    int m_decimation;
+    int m_skipped;
+    bool m_active;
+    bool m_requestPending;
+
+    friend class QGeoPositionInfoSourceHub;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOPOSITIONINFOSOURCEHUB_P_H
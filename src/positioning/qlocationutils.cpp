@@ -40,6 +40,7 @@
 ****************************************************************************/
 #include "qlocationutils_p.h"
 #include "qgeopositioninfo.h"
+#include "qgeosatelliteinfo.h"
 
 #include <QTime>
 #include <QList>
@@ -281,6 +282,9 @@ QLocationUtils::NmeaSentence QLocationUtils::getNmeaSentenceType(const char *dat
     if (data[3] == 'Z' && data[4] == 'D' && data[5] == 'A')
         return NmeaSentenceZDA;
 
+    if (data[3] == 'G' && data[4] == 'S' && data[5] == 'V')
+        return NmeaSentenceGSV;
+
     return NmeaSentenceInvalid;
 }
 
@@ -329,6 +333,151 @@ bool QLocationUtils::getPosInfoFromNmea(const char *data, int size, QGeoPosition
     }
 }
 
+static QGeoSatelliteInfo::SatelliteSystem qlocationutils_talkerSystem(const char *data, int size)
+{
+    if (size < 3)
+        return QGeoSatelliteInfo::Undefined;
+    if (data[1] == 'G' && data[2] == 'P')
+        return QGeoSatelliteInfo::GPS;
+    if (data[1] == 'G' && data[2] == 'L')
+        return QGeoSatelliteInfo::GLONASS;
+    return QGeoSatelliteInfo::Undefined;
+}
+
+// NMEA 0183 numbers GPS satellites 1-32 and GLONASS satellites 65-96.
+static QGeoSatelliteInfo::SatelliteSystem qlocationutils_prnSystem(int prn)
+{
+    if (prn >= 1 && prn <= 32)
+        return QGeoSatelliteInfo::GPS;
+    if (prn >= 65 && prn <= 96)
+        return QGeoSatelliteInfo::GLONASS;
+    return QGeoSatelliteInfo::Undefined;
+}
+
+QLocationUtils::GSVParseStatus QLocationUtils::getSatInfoFromNmea(const char *data, int size,
+                                                                  QList<QGeoSatelliteInfo> &infos,
+                                                                  QGeoSatelliteInfo::SatelliteSystem &system)
+{
+    if (getNmeaSentenceType(data, size) != NmeaSentenceGSV)
+        return GSVNotParsed;
+
+    // $xxGSV,total,number,inView[,prn,elevation,azimuth,snr]{0,4}*cs
+    const int MaxFields = 4 + 4 * 4;
+    QByteArray fields[MaxFields];
+    const int count = qMin(splitNmeaSentence(data, size, fields, MaxFields), MaxFields);
+    if (count < 4)
+        return GSVNotParsed;
+
+    bool ok = false;
+    const int totalSentences = fields[1].toInt(&ok);
+    if (!ok || totalSentences < 1)
+        return GSVNotParsed;
+    const int sentenceNumber = fields[2].toInt(&ok);
+    if (!ok || sentenceNumber < 1 || sentenceNumber > totalSentences)
+        return GSVNotParsed;
+
+    system = qlocationutils_talkerSystem(data, size);
+
+    for (int i = 4; i < count; i += 4) {
+        const int prn = fields[i].toInt(&ok);
+        if (!ok)
+            continue;
+
+        QGeoSatelliteInfo info;
+        info.setSatelliteIdentifier(prn);
+        info.setSatelliteSystem(system != QGeoSatelliteInfo::Undefined ? system
+                                                                       : qlocationutils_prnSystem(prn));
+        if (i + 1 < count && !fields[i + 1].isEmpty()) {
+            const double elevation = fields[i + 1].toDouble(&ok);
+            if (ok)
+                info.setAttribute(QGeoSatelliteInfo::Elevation, elevation);
+        }
+        if (i + 2 < count && !fields[i + 2].isEmpty()) {
+            const double azimuth = fields[i + 2].toDouble(&ok);
+            if (ok)
+                info.setAttribute(QGeoSatelliteInfo::Azimuth, azimuth);
+        }
+        if (i + 3 < count && !fields[i + 3].isEmpty()) {
+            const int snr = fields[i + 3].toInt(&ok);
+            if (ok)
+                info.setSignalStrength(snr);
+        }
+        infos.append(info);
+    }
+
+    return sentenceNumber == totalSentences ? GSVFullyParsed : GSVPartiallyParsed;
+}
+
+QGeoSatelliteInfo::SatelliteSystem QLocationUtils::getSatInUseFromNmea(const char *data, int size,
+                                                                       QList<int> &pnrsInUse)
+{
+    if (getNmeaSentenceType(data, size) != NmeaSentenceGSA)
+        return QGeoSatelliteInfo::Undefined;
+
+    // $xxGSA,mode,fix,prn{12},pdop,hdop,vdop*cs
+    const int MaxFields = 15;
+    QByteArray fields[MaxFields];
+    const int count = qMin(splitNmeaSentence(data, size, fields, MaxFields), MaxFields);
+
+    QGeoSatelliteInfo::SatelliteSystem system = qlocationutils_talkerSystem(data, size);
+    for (int i = 3; i < count; ++i) {
+        if (fields[i].isEmpty())
+            continue;
+        bool ok = false;
+        const int prn = fields[i].toInt(&ok);
+        if (!ok)
+            continue;
+        // "GN" sentences report one constellation each; tell which from the PRNs.
+        if (system == QGeoSatelliteInfo::Undefined)
+            system = qlocationutils_prnSystem(prn);
+        pnrsInUse.append(prn);
+    }
+
+    return system;
+}
+
+int QLocationUtils::splitNmeaSentence(const char *data, int size, QByteArray *fields, int maxFields)
+{
+    int count = 0;
+    int start = 0;
+    for (int i = 0; i <= size; ++i) {
+        const bool end = (i == size || data[i] == '*' || data[i] == '\r' || data[i] == '\n');
+        if (end || data[i] == ',') {
+            if (count < maxFields)
+                fields[count] = QByteArray::fromRawData(data + start, i - start);
+            ++count;
+            if (end)
+                break;
+            start = i + 1;
+        }
+    }
+    return count;
+}
+
+QTime QLocationUtils::getNmeaSentenceTime(const char *data, int size)
+{
+    int timeField;
+    switch (getNmeaSentenceType(data, size)) {
+    case NmeaSentenceGGA:
+    case NmeaSentenceRMC:
+    case NmeaSentenceZDA:
+        timeField = 1;
+        break;
+    case NmeaSentenceGLL:
+        timeField = 5;
+        break;
+    default:
+        return QTime();
+    }
+
+    QByteArray fields[6];
+    const int count = splitNmeaSentence(data, size, fields, 6);
+    QTime time;
+    if (count > timeField && !fields[timeField].isEmpty())
+        getNmeaTime(fields[timeField], &time);
+    return time;
+}
+
 bool QLocationUtils::hasValidNmeaChecksum(const char *data, int size)
 {
     int asteriskIndex = -1;
@@ -365,7 +514,7 @@ bool QLocationUtils::getNmeaTime(const QByteArray &bytes, QTime *time)
     QTime tempTime;
 
     if (dotIndex < 0) {
-        tempTime = QTime::fromString(QString::fromLatin1(bytes.constData()),
+        tempTime = QTime::fromString(QString::fromLatin1(bytes),
                                      QStringLiteral("hhmmss"));
     } else {
         tempTime = QTime::fromString(QString::fromLatin1(bytes.mid(0, dotIndex)),
@@ -51,9 +51,11 @@
 //
 
 #include <QtCore/QtGlobal>
+#include <QtCore/QList>
 #include <math.h> // needed for non-std:: versions of functions
 #include <qmath.h>
 #include <QtPositioning/QGeoCoordinate>
+#include <QtPositioning/QGeoSatelliteInfo>
 #include <QtPositioning/private/qpositioningglobal_p.h>
 
 static const double offsetEpsilon = 1e-12; // = 0.000000000001
@@ -94,7 +96,14 @@ public:
         NmeaSentenceGLL, // Lat/Lon data
         NmeaSentenceRMC, // Recommended minimum data for gps
         NmeaSentenceVTG, // Vector track an Speed over the Ground
-        NmeaSentenceZDA  // Date and Time
+        NmeaSentenceZDA, // Date and Time
+        NmeaSentenceGSV  // Per-Satellite Info
+    };
+
+    enum GSVParseStatus {
+        GSVNotParsed,
+        GSVPartiallyParsed,
+        GSVFullyParsed
     };
 
     inline static bool isValidLat(double lat) {
@@ -275,6 +284,40 @@ public:
                                    QGeoPositionInfo *info, double uere,
                                    bool *hasFix = nullptr);
 
+    /*
+        Parses one GSV sentence and appends the satellites it reports to \a infos.
+        \a system is set from the talker ID. Returns GSVFullyParsed once the last
+        sentence of a GSV group has been read, GSVPartiallyParsed for the
+        preceding ones.
+    */
+    static GSVParseStatus getSatInfoFromNmea(const char *data,
+                                             int size,
+                                             QList<QGeoSatelliteInfo> &infos,
+                                             QGeoSatelliteInfo::SatelliteSystem &system);
+
+    /*
+        Parses a GSA sentence and appends the PRNs of the satellites used in
+        the fix to \a pnrsInUse. Returns the satellite system the PRNs belong
+        to, or QGeoSatelliteInfo::Undefined if the sentence could not be parsed.
+    */
+    static QGeoSatelliteInfo::SatelliteSystem getSatInUseFromNmea(const char *data,
+                                                                  int size,
+                                                                  QList<int> &pnrsInUse);
+
+    /*
+        Splits the NMEA sentence in \a data at ',' up to the checksum delimiter,
+        without copying. At most \a maxFields fields are stored in \a fields;
+        they refer into \a data and are only valid for as long as it is.
+        Returns the number of fields in the sentence.
+    */
+    static int splitNmeaSentence(const char *data, int size, QByteArray *fields, int maxFields);
+
+    /*
+        Returns the time of day of a GGA, GLL, RMC or ZDA sentence, or an
+        invalid QTime for any other sentence.
+    */
+    static QTime getNmeaSentenceTime(const char *data, int size);
+
     /*
         Returns true if the given NMEA sentence has a valid checksum.
     */
@@ -0,0 +1,161 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtPositioning module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qnmeadevicereader_p.h"
+
+#include <QtCore/QHash>
+#include <QtCore/QIODevice>
+#include <QtCore/QMutex>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    QNmeaDeviceReader reads the NMEA sentences from a QIODevice once and
+    dispatches each of them to every registered QNmeaSentenceSink, so that
+    several NMEA sources (e.g. position and satellite info) can share one
+    device. Lines are read into a fixed buffer and handed out in place.
+*/
+
+namespace {
+struct DeviceReaderRegistry
+{
+    QMutex mutex;
+    QHash<QIODevice *, QWeakPointer<QNmeaDeviceReader> > readers;
+};
+}
+
+Q_GLOBAL_STATIC(DeviceReaderRegistry, deviceReaderRegistry)
+
+QNmeaDeviceReader::QNmeaDeviceReader(QIODevice *device)
+    : QObject(nullptr), m_device(device), m_reading(false)
+{
+}
+
+QNmeaDeviceReader::~QNmeaDeviceReader()
+{
+    DeviceReaderRegistry *registry = deviceReaderRegistry();
+    if (!registry)
+        return;
+
+    QMutexLocker locker(&registry->mutex);
+    for (auto it = registry->readers.begin(); it != registry->readers.end(); ) {
+        if (it.value().isNull())
+            it = registry->readers.erase(it);
+        else
+            ++it;
+    }
+}
+
+/*
+    Returns the reader for \a device, creating it if no NMEA source is
+    currently reading from that device.
+*/
+QSharedPointer<QNmeaDeviceReader> QNmeaDeviceReader::sharedReader(QIODevice *device)
+{
+    DeviceReaderRegistry *registry = deviceReaderRegistry();
+    QMutexLocker locker(&registry->mutex);
+
+    QSharedPointer<QNmeaDeviceReader> reader = registry->readers.value(device).toStrongRef();
+    if (!reader) {
+        reader = QSharedPointer<QNmeaDeviceReader>(new QNmeaDeviceReader(device));
+        registry->readers.insert(device, reader);
+
+        // A device created later at the same address must not get this reader.
+        connect(device, &QObject::destroyed, reader.data(), [registry, device]() {
+            QMutexLocker locker(&registry->mutex);
+            registry->readers.remove(device);
+        });
+    }
+    return reader;
+}
+
+QIODevice *QNmeaDeviceReader::device() const
+{
+    return m_device;
+}
+
+void QNmeaDeviceReader::addSink(QNmeaSentenceSink *sink)
+{
+    if (!m_sinks.contains(sink))
+        m_sinks.append(sink);
+}
+
+void QNmeaDeviceReader::removeSink(QNmeaSentenceSink *sink)
+{
+    const int index = m_sinks.indexOf(sink);
+    if (index >= 0)
+        m_sinks[index] = nullptr; // may be called from within readAvailableData()
+    if (!m_reading)
+        m_sinks.removeAll(nullptr);
+}
+
+void QNmeaDeviceReader::readAvailableData()
+{
+    // Every sink owner calls this upon readyRead(); the first call does the work.
+    if (m_reading || !m_device)
+        return;
+
+    // A sink may release the last reference to us while handling a sentence.
+    const QSharedPointer<QNmeaDeviceReader> guard = sharedFromThis();
+    m_reading = true;
+    bool dispatched = false;
+    while (m_device && m_device->canReadLine()) {
+        char buf[1024];
+        const qint64 size = m_device->readLine(buf, sizeof(buf));
+        if (size <= 0)
+            continue;
+
+        for (int i = 0; i < m_sinks.size(); ++i) {
+            if (m_sinks.at(i))
+                m_sinks.at(i)->processSentence(buf, int(size));
+        }
+        dispatched = true;
+    }
+
+    if (dispatched) {
+        for (int i = 0; i < m_sinks.size(); ++i) {
+            if (m_sinks.at(i))
+                m_sinks.at(i)->sentencesProcessed();
+        }
+    }
+    m_reading = false;
+    m_sinks.removeAll(nullptr);
+}
+
+QT_END_NAMESPACE
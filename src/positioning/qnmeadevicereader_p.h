@@ -0,0 +1,101 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtPositioning module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QNMEADEVICEREADER_P_H
+#define QNMEADEVICEREADER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtPositioning/private/qpositioningglobal_p.h>
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QVector>
+
+QT_BEGIN_NAMESPACE
+
+class QIODevice;
+
+class QNmeaSentenceSink
+{
+public:
+    virtual ~QNmeaSentenceSink() {}
+
+    // data points into the reader's line buffer and is only valid during the call.
+    virtual void processSentence(const char *data, int size) = 0;
+    // Called once all complete lines currently available have been dispatched.
+    virtual void sentencesProcessed() {}
+};
+
+class Q_POSITIONING_PRIVATE_EXPORT QNmeaDeviceReader : public QObject,
+                                                     public QEnableSharedFromThis<QNmeaDeviceReader>
+{
+    Q_OBJECT
+public:
+    ~QNmeaDeviceReader();
+
+    static QSharedPointer<QNmeaDeviceReader> sharedReader(QIODevice *device);
+
+    QIODevice *device() const;
+
+    void addSink(QNmeaSentenceSink *sink);
+    void removeSink(QNmeaSentenceSink *sink);
+
+    void readAvailableData();
+
+private:
+    explicit QNmeaDeviceReader(QIODevice *device);
+
+    QPointer<QIODevice> m_device;
+    QVector<QNmeaSentenceSink *> m_sinks;
+    bool m_reading;
+};
+
+QT_END_NAMESPACE
+
+#endif // QNMEADEVICEREADER_P_H
@@ -183,86 +183,106 @@ QNmeaRealTimeReader::QNmeaRealTimeReader(QNmeaPositionInfoSourcePrivate *sourceP
            this->notifyNewUpdate();
         });
     }
+
+    // The device may be shared with other NMEA sources, e.g. a
+    // QNmeaSatelliteInfoSource, so its lines are read only once.
+    m_deviceReader = QNmeaDeviceReader::sharedReader(m_proxy->m_device);
+    m_deviceReader->addSink(this);
+}
+
+QNmeaRealTimeReader::~QNmeaRealTimeReader()
+{
+    if (m_deviceReader)
+        m_deviceReader->removeSink(this);
 }
 
 void QNmeaRealTimeReader::readAvailableData()
 {
-    while (m_proxy->m_device->canReadLine()) {
-        const QTime infoTime = m_update.timestamp().time(); // if update has been set, time must be valid.
-        const QDate infoDate = m_update.timestamp().date(); // this one might not be valid, as some sentences do not contain it
+    m_deviceReader->readAvailableData();
+}
 
-        QGeoPositionInfoPrivateNmea *pimpl = new QGeoPositionInfoPrivateNmea;
-        QGeoPositionInfo pos(*pimpl);
+void QNmeaRealTimeReader::processSentence(const char *buf, int size)
+{
+    // The device may keep being read for other sources sharing it.
+    if (!m_proxy->acceptsSentences())
+        return;
 
-        char buf[1024];
-        qint64 size = m_proxy->m_device->readLine(buf, sizeof(buf));
-        const bool oldFix = m_hasFix;
-        bool hasFix;
-        const bool parsed = m_proxy->parsePosInfoFromNmeaData(buf, size, &pos, &hasFix);
+    const QTime infoTime = m_update.timestamp().time(); // if update has been set, time must be valid.
+    const QDate infoDate = m_update.timestamp().date(); // this one might not be valid, as some sentences do not contain it
 
-        if (!parsed) {
-            // got garbage, don't stop the timer
-            continue;
-        }
+    QGeoPositionInfoPrivateNmea *pimpl = new QGeoPositionInfoPrivateNmea;
+    QGeoPositionInfo pos(*pimpl);
 
-        m_hasFix |= hasFix;
-        m_updateParsed = true;
-
-        // Date may or may not be valid, as some packets do not have date.
-        // If date isn't valid, match is performed on time only.
-        // Hence, make sure that packet blocks are generated with
-        // the sentences containing the full timestamp (e.g., GPRMC) *first* !
-        if (infoTime.isValid()) {
-            if (pos.timestamp().time().isValid()) {
-                const bool newerTime = infoTime < pos.timestamp().time();
-                const bool newerDate = (infoDate.isValid() // if time is valid but one date or both are not,
-                                        && pos.timestamp().date().isValid()
-                                        && infoDate < pos.timestamp().date());
-                if (newerTime || newerDate) {
-                    // Effectively read data for different update, that is also newer,
-                    // so flush retained update, and copy the new pos into m_update
-                    const QDate updateDate = m_update.timestamp().date();
-                    const QDate lastPushedDate = m_lastPushedTS.date();
-                    const bool newerTimestampSinceLastPushed = m_update.timestamp() > m_lastPushedTS;
-                    const bool invalidDate = !(updateDate.isValid() && lastPushedDate.isValid());
-                    const bool newerTimeSinceLastPushed = m_update.timestamp().time() > m_lastPushedTS.time();
-                    if ( newerTimestampSinceLastPushed || (invalidDate && newerTimeSinceLastPushed)) {
-                        m_proxy->notifyNewUpdate(&m_update, oldFix);
-                        m_lastPushedTS = m_update.timestamp();
-                    }
-                    m_timer.stop();
-                    // next update data
-                    propagateAttributes(pos, m_update, false);
-                    m_update = pos;
-                    m_hasFix = hasFix;
-                } else {
-                    if (infoTime == pos.timestamp().time())
-                        // timestamps match -- merge into m_update
-                        if (mergePositions(m_update, pos, QByteArray(buf, size))) {
-                            // Reset the timer only if new info has been received.
-                            // Else the source might be keep repeating outdated info until
-                            // new info become available.
-                            m_timer.stop();
-                        }
-                    // else discard out of order outdated info.
+    const bool oldFix = m_hasFix;
+    bool hasFix;
+    const bool parsed = m_proxy->parsePosInfoFromNmeaData(buf, size, &pos, &hasFix);
+
+    if (!parsed) {
+        // got garbage, don't stop the timer
+        return;
+    }
+
+    m_hasFix |= hasFix;
+    m_updateParsed = true;
+
+    // Date may or may not be valid, as some packets do not have date.
+    // If date isn't valid, match is performed on time only.
+    // Hence, make sure that packet blocks are generated with
+    // the sentences containing the full timestamp (e.g., GPRMC) *first* !
+    if (infoTime.isValid()) {
+        if (pos.timestamp().time().isValid()) {
+            const bool newerTime = infoTime < pos.timestamp().time();
+            const bool newerDate = (infoDate.isValid() // if time is valid but one date or both are not,
+                                    && pos.timestamp().date().isValid()
+                                    && infoDate < pos.timestamp().date());
+            if (newerTime || newerDate) {
+                // Effectively read data for different update, that is also newer,
+                // so flush retained update, and copy the new pos into m_update
+                const QDate updateDate = m_update.timestamp().date();
+                const QDate lastPushedDate = m_lastPushedTS.date();
+                const bool newerTimestampSinceLastPushed = m_update.timestamp() > m_lastPushedTS;
+                const bool invalidDate = !(updateDate.isValid() && lastPushedDate.isValid());
+                const bool newerTimeSinceLastPushed = m_update.timestamp().time() > m_lastPushedTS.time();
+                if ( newerTimestampSinceLastPushed || (invalidDate && newerTimeSinceLastPushed)) {
+                    m_proxy->notifyNewUpdate(&m_update, oldFix);
+                    m_lastPushedTS = m_update.timestamp();
                 }
+                m_timer.stop();
+                // next update data
+                propagateAttributes(pos, m_update, false);
+                m_update = pos;
+                m_hasFix = hasFix;
             } else {
-                // no timestamp available in parsed update-- merge into m_update
-                if (mergePositions(m_update, pos, QByteArray(buf, size)))
-                    m_timer.stop();
+                if (infoTime == pos.timestamp().time())
+                    // timestamps match -- merge into m_update
+                    if (mergePositions(m_update, pos, QByteArray(buf, size))) {
+                        // Reset the timer only if new info has been received.
+                        // Else the source might be keep repeating outdated info until
+                        // new info become available.
+                        m_timer.stop();
+                    }
+                // else discard out of order outdated info.
             }
         } else {
-            // there was no info with valid TS. Overwrite with whatever is parsed.
+            // no timestamp available in parsed update-- merge into m_update
+            if (mergePositions(m_update, pos, QByteArray(buf, size)))
+                m_timer.stop();
+        }
+    } else {
+        // there was no info with valid TS. Overwrite with whatever is parsed.
 #if USE_NMEA_PIMPL
-            pimpl->nmeaSentences.append(QByteArray(buf, size));
+        pimpl->nmeaSentences.append(QByteArray(buf, size));
 #endif
-            propagateAttributes(pos, m_update);
-            m_update = pos;
-            m_timer.stop();
-        }
+        propagateAttributes(pos, m_update);
+        m_update = pos;
+        m_timer.stop();
     }
+}
 
+void QNmeaRealTimeReader::sentencesProcessed()
+{
     if (m_updateParsed) {
+        m_updateParsed = false;
         if (m_pushDelay < 0)
             notifyNewUpdate();
         else
@@ -270,6 +290,16 @@ void QNmeaRealTimeReader::readAvailableData()
     }
 }
 
+/*
+    Drops the update being collected once the source no longer wants
+    updates, so that it is not pushed later.
+*/
+void QNmeaRealTimeReader::stop()
+{
+    m_timer.stop();
+    m_updateParsed = false;
+}
+
 void QNmeaRealTimeReader::notifyNewUpdate()
 {
     const bool newerTime = m_update.timestamp().time() > m_lastPushedTS.time();
@@ -491,7 +521,8 @@ QNmeaPositionInfoSourcePrivate::QNmeaPositionInfoSourcePrivate(QNmeaPositionInfo
         m_verticalAccuracy(qQNaN()),
         m_noUpdateLastInterval(false),
         m_updateTimeoutSent(false),
-        m_connectedReadyRead(false)
+        m_connectedReadyRead(false),
+        m_updatesStopped(false)
 {
 }
 
@@ -574,6 +605,7 @@ void QNmeaPositionInfoSourcePrivate::startUpdates()
         return;
 
     m_invokedStart = true;
+    m_updatesStopped = false;
     m_pendingUpdate = QGeoPositionInfo();
     m_noUpdateLastInterval = false;
 
@@ -612,6 +644,20 @@ void QNmeaPositionInfoSourcePrivate::stopUpdates()
         m_updateTimer->stop();
     m_pendingUpdate = QGeoPositionInfo();
     m_noUpdateLastInterval = false;
+    m_updatesStopped = true;
+    if (m_nmeaReader && !acceptsSentences())
+        m_nmeaReader->stop();
+}
+
+/*
+    Returns whether the sentences read from the device are parsed. Once
+    updates are stopped they are only parsed while an update is requested,
+    so that a stopped source does no work. Before that, they keep
+    lastKnownPosition() current.
+*/
+bool QNmeaPositionInfoSourcePrivate::acceptsSentences() const
+{
+    return !m_updatesStopped || m_invokedStart || (m_requestTimer && m_requestTimer->isActive());
 }
 
 void QNmeaPositionInfoSourcePrivate::requestUpdate(int msec)
@@ -642,6 +688,8 @@ void QNmeaPositionInfoSourcePrivate::requestUpdate(int msec)
 void QNmeaPositionInfoSourcePrivate::updateRequestTimeout()
 {
     m_requestTimer->stop();
+    if (m_nmeaReader && !acceptsSentences())
+        m_nmeaReader->stop();
     emit m_source->updateTimeout();
 }
 
@@ -861,6 +909,9 @@ QNmeaPositionInfoSource::UpdateMode QNmeaPositionInfoSource::updateMode() const
     source to be notified when data is available for reading.
     QNmeaPositionInfoSource does not assume the ownership of the device,
     and hence does not deallocate it upon destruction.
+
+    In \l {RealTimeMode} the same \a device can also be set on a
+    QNmeaSatelliteInfoSource; the data is then read only once for both.
 */
 void QNmeaPositionInfoSource::setDevice(QIODevice *device)
 {
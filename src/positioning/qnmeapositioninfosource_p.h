@@ -51,6 +51,7 @@
 //
 
 #include "qnmeapositioninfosource.h"
+#include "qnmeadevicereader_p.h"
 #include "qgeopositioninfo.h"
 
 #include <QObject>
@@ -89,6 +90,7 @@ public:
                                   bool *hasFix);
 
     void notifyNewUpdate(QGeoPositionInfo *update, bool fixStatus);
+    bool acceptsSentences() const;
 
     QNmeaPositionInfoSource::UpdateMode m_updateMode;
     QPointer<QIODevice> m_device;
@@ -125,6 +127,7 @@ private:
     bool m_noUpdateLastInterval;
     bool m_updateTimeoutSent;
     bool m_connectedReadyRead;
+    bool m_updatesStopped;
 };
 
 
@@ -136,20 +139,27 @@ public:
     virtual ~QNmeaReader() {}
 
     virtual void readAvailableData() = 0;
+    virtual void stop() {}
 
 protected:
     QNmeaPositionInfoSourcePrivate *m_proxy;
 };
 
 
-class QNmeaRealTimeReader : public QNmeaReader
+class QNmeaRealTimeReader : public QNmeaReader, public QNmeaSentenceSink
 {
 public:
     explicit QNmeaRealTimeReader(QNmeaPositionInfoSourcePrivate *sourcePrivate);
+    ~QNmeaRealTimeReader();
     virtual void readAvailableData();
+    void stop() override;
     void notifyNewUpdate();
 
+    void processSentence(const char *data, int size) override;
+    void sentencesProcessed() override;
+
     // Data members
+    QSharedPointer<QNmeaDeviceReader> m_deviceReader;
     QGeoPositionInfo m_update;
     QDateTime m_lastPushedTS;
     bool m_updateParsed = false;
@@ -0,0 +1,495 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtPositioning module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qnmeasatelliteinfosource_p.h"
+#include "qlocationutils_p.h"
+
+#include <QtCore/QIODevice>
+#include <QtCore/QTimerEvent>
+
+QT_BEGIN_NAMESPACE
+
+QNmeaSatelliteInfoSourcePrivate::QNmeaSatelliteInfoSourcePrivate(QNmeaSatelliteInfoSource *parent,
+                                                                 QNmeaSatelliteInfoSource::UpdateMode updateMode)
+    : QObject(parent),
+      m_updateMode(updateMode),
+      m_satelliteError(QGeoSatelliteInfoSource::NoError),
+      m_source(parent),
+      m_requestTimer(nullptr),
+      m_initialized(false),
+      m_invokedStart(false),
+      m_connectedReadyRead(false),
+      m_updated(false)
+{
+}
+
+QNmeaSatelliteInfoSourcePrivate::~QNmeaSatelliteInfoSourcePrivate()
+{
+    if (m_deviceReader)
+        m_deviceReader->removeSink(this);
+}
+
+bool QNmeaSatelliteInfoSourcePrivate::initialize()
+{
+    if (m_initialized)
+        return true;
+
+    if (!m_device) {
+        qWarning("QNmeaSatelliteInfoSource: no QIODevice data source, call setDevice() first");
+        return false;
+    }
+
+    if (!m_device->isOpen() && !m_device->open(QIODevice::ReadOnly)) {
+        qWarning("QNmeaSatelliteInfoSource: cannot open QIODevice data source");
+        return false;
+    }
+
+    if (m_updateMode == QNmeaSatelliteInfoSource::RealTimeMode) {
+        // Share the lines read from the device with any QNmeaPositionInfoSource
+        // reading the same device.
+        m_deviceReader = QNmeaDeviceReader::sharedReader(m_device);
+        m_deviceReader->addSink(this);
+    }
+
+    m_initialized = true;
+    return true;
+}
+
+void QNmeaSatelliteInfoSourcePrivate::prepareSourceDevice()
+{
+    if (!m_connectedReadyRead) {
+        connect(m_device, SIGNAL(readyRead()), SLOT(readyRead()));
+        m_connectedReadyRead = true;
+    }
+
+    // some data may already be available
+    if (m_device->bytesAvailable())
+        readyRead();
+}
+
+void QNmeaSatelliteInfoSourcePrivate::readyRead()
+{
+    if (m_updateMode == QNmeaSatelliteInfoSource::RealTimeMode) {
+        if (m_deviceReader)
+            m_deviceReader->readAvailableData();
+    } else {
+        readSimulatedData();
+    }
+}
+
+/*
+    Replays the recorded data at its original pace: all sentences up to the
+    next one carrying a newer time of day form an epoch, and the following
+    epoch is only processed once the recorded time difference has elapsed.
+*/
+void QNmeaSatelliteInfoSourcePrivate::readSimulatedData()
+{
+    if (m_simulationTimer.isActive()) // the current epoch is not due yet
+        return;
+
+    while (!m_nextLine.isEmpty() || (m_device && m_device->canReadLine())) {
+        char buf[1024];
+        const char *data = buf;
+        int size = 0;
+        QByteArray line;
+        if (!m_nextLine.isEmpty()) {
+            line.swap(m_nextLine);
+            data = line.constData();
+            size = line.size();
+        } else {
+            size = int(m_device->readLine(buf, sizeof(buf)));
+            if (size <= 0)
+                continue;
+        }
+
+        const QTime time = QLocationUtils::getNmeaSentenceTime(data, size);
+        if (time.isValid() && m_simulationTime.isValid() && time != m_simulationTime) {
+            int delay = m_simulationTime.msecsTo(time);
+            if (delay < 0) // midnight
+                delay += 24 * 60 * 60 * 1000;
+            m_nextLine = QByteArray(data, size);
+            m_simulationTime = time;
+            sentencesProcessed();
+            m_simulationTimer.start(delay, this);
+            return;
+        }
+        if (time.isValid())
+            m_simulationTime = time;
+
+        processSentence(data, size);
+    }
+
+    sentencesProcessed();
+}
+
+void QNmeaSatelliteInfoSourcePrivate::processSentence(const char *data, int size)
+{
+    // Cheap test on the sentence ID; the parsers validate the checksum.
+    if (size < 6 || data[0] != '$' || data[3] != 'G' || data[4] != 'S')
+        return;
+
+    if (data[5] == 'V') {
+        QList<QGeoSatelliteInfo> infos;
+        QGeoSatelliteInfo::SatelliteSystem system = QGeoSatelliteInfo::Undefined;
+        const QNmeaSatelliteInfoSource::SatelliteInfoParseStatus status =
+                m_source->parseSatelliteInfoFromNmea(data, size, infos, system);
+        if (status == QNmeaSatelliteInfoSource::NotParsed)
+            return;
+
+        QNmeaSatelliteSystemState &state = m_systems[system];
+
+        // The first sentence of a GSV group discards any incomplete earlier group.
+        QByteArray fields[3];
+        if (QLocationUtils::splitNmeaSentence(data, size, fields, 3) >= 3 && fields[2] == "1")
+            state.pendingInView.clear();
+        state.pendingInView.append(infos);
+
+        if (status == QNmeaSatelliteInfoSource::FullyParsed) {
+            state.inView.swap(state.pendingInView);
+            state.pendingInView.clear();
+            m_updated = true;
+        }
+    } else if (data[5] == 'A') {
+        QList<int> pnrsInUse;
+        const QGeoSatelliteInfo::SatelliteSystem system =
+                m_source->parseSatellitesInUseFromNmea(data, size, pnrsInUse);
+        if (system == QGeoSatelliteInfo::Undefined && pnrsInUse.isEmpty())
+            return;
+
+        QNmeaSatelliteSystemState &state = m_systems[system];
+        if (state.inUse != pnrsInUse) {
+            state.inUse.swap(pnrsInUse);
+            m_updated = true;
+        }
+    }
+}
+
+void QNmeaSatelliteInfoSourcePrivate::sentencesProcessed()
+{
+    if (!m_updated)
+        return;
+
+    if (m_requestTimer && m_requestTimer->isActive()) { // User called requestUpdate()
+        m_requestTimer->stop();
+        emitUpdated();
+    } else if (m_invokedStart && !m_updateTimer.isActive()) { // update interval <= 0
+        emitUpdated();
+    }
+    // else periodic updates are emitted from timerEvent()
+}
+
+void QNmeaSatelliteInfoSourcePrivate::emitUpdated()
+{
+    QList<QGeoSatelliteInfo> inView;
+    QList<QGeoSatelliteInfo> inUse;
+    for (auto it = m_systems.cbegin(), end = m_systems.cend(); it != end; ++it) {
+        inView.append(it->inView);
+        for (const QGeoSatelliteInfo &info : it->inView) {
+            if (it->inUse.contains(info.satelliteIdentifier()))
+                inUse.append(info);
+        }
+    }
+
+    m_updated = false;
+    emit m_source->satellitesInViewUpdated(inView);
+    emit m_source->satellitesInUseUpdated(inUse);
+}
+
+void QNmeaSatelliteInfoSourcePrivate::startUpdates()
+{
+    if (m_invokedStart)
+        return;
+
+    m_invokedStart = true;
+    if (!initialize())
+        return;
+
+    if (m_source->updateInterval() > 0)
+        m_updateTimer.start(m_source->updateInterval(), this);
+
+    prepareSourceDevice();
+}
+
+void QNmeaSatelliteInfoSourcePrivate::stopUpdates()
+{
+    m_invokedStart = false;
+    m_updateTimer.stop();
+}
+
+void QNmeaSatelliteInfoSourcePrivate::requestUpdate(int msec)
+{
+    if (m_requestTimer && m_requestTimer->isActive())
+        return;
+
+    if (msec <= 0 || msec < m_source->minimumUpdateInterval()) {
+        emit m_source->requestTimeout();
+        return;
+    }
+
+    if (!m_requestTimer) {
+        m_requestTimer = new QTimer(this);
+        m_requestTimer->setSingleShot(true);
+        connect(m_requestTimer, SIGNAL(timeout()), SLOT(updateRequestTimeout()));
+    }
+
+    if (!initialize()) {
+        emit m_source->requestTimeout();
+        return;
+    }
+
+    m_requestTimer->start(msec);
+    prepareSourceDevice();
+}
+
+void QNmeaSatelliteInfoSourcePrivate::updateRequestTimeout()
+{
+    m_requestTimer->stop();
+    emit m_source->requestTimeout();
+}
+
+void QNmeaSatelliteInfoSourcePrivate::timerEvent(QTimerEvent *event)
+{
+    if (event->timerId() == m_simulationTimer.timerId()) {
+        m_simulationTimer.stop();
+        readSimulatedData();
+    } else if (event->timerId() == m_updateTimer.timerId()) {
+        if (m_updated)
+            emitUpdated();
+    } else {
+        QObject::timerEvent(event);
+    }
+}
+
+//=========================================================
+
+/*!
+    \class QNmeaSatelliteInfoSource
+    \inmodule QtPositioning
+    \ingroup QtPositioning-positioning
+    \since 5.12
+
+    \brief The QNmeaSatelliteInfoSource class provides satellite information
+    using an NMEA data source.
+
+    The satellites in view are read from GSV sentences, and the satellites
+    used in the fix from GSA sentences. A GSV group spanning several sentences
+    is reported once it has been read completely.
+
+    A QNmeaSatelliteInfoSource instance operates in either \l {RealTimeMode}
+    or \l {SimulationMode}, in the same way as QNmeaPositionInfoSource.
+
+    In \l {RealTimeMode} the source device can also be set on a
+    QNmeaPositionInfoSource operating in real time mode. The NMEA stream is
+    then read only once and each sentence is handed to both sources.
+
+    The source of NMEA data is set with setDevice().
+*/
+
+/*!
+    \enum QNmeaSatelliteInfoSource::UpdateMode
+    Defines the available update modes.
+
+    \value RealTimeMode Satellite information is read and distributed from the data source as it becomes available. Use this mode if you are using a live source of NMEA data (for example, a GPS hardware device).
+    \value SimulationMode The time information in the NMEA source data is used to provide satellite updates at the rate at which the data was originally recorded. Use this mode if the data source contains previously recorded NMEA data and you want to replay the data for simulation purposes.
+*/
+
+/*!
+    \enum QNmeaSatelliteInfoSource::SatelliteInfoParseStatus
+    Defines the result of parsing one GSV sentence.
+
+    \value NotParsed The sentence could not be parsed.
+    \value PartiallyParsed The sentence was parsed, but more sentences of its GSV group follow.
+    \value FullyParsed The sentence was parsed and was the last sentence of its GSV group.
+*/
+
+/*!
+    Constructs a QNmeaSatelliteInfoSource instance with the given \a parent
+    and \a updateMode.
+*/
+QNmeaSatelliteInfoSource::QNmeaSatelliteInfoSource(UpdateMode updateMode, QObject *parent)
+    : QGeoSatelliteInfoSource(parent),
+      d(new QNmeaSatelliteInfoSourcePrivate(this, updateMode))
+{
+}
+
+/*!
+    Destroys the satellite source.
+*/
+QNmeaSatelliteInfoSource::~QNmeaSatelliteInfoSource()
+{
+    delete d;
+}
+
+/*!
+    Returns the update mode.
+*/
+QNmeaSatelliteInfoSource::UpdateMode QNmeaSatelliteInfoSource::updateMode() const
+{
+    return d->m_updateMode;
+}
+
+/*!
+    Sets the NMEA data source to \a device. If the device is not open, it
+    will be opened in QIODevice::ReadOnly mode.
+
+    The source device can only be set once and must be set before calling
+    startUpdates() or requestUpdate().
+
+    \b {Note:} The \a device must emit QIODevice::readyRead() for the
+    source to be notified when data is available for reading.
+    QNmeaSatelliteInfoSource does not assume the ownership of the device,
+    and hence does not deallocate it upon destruction.
+*/
+void QNmeaSatelliteInfoSource::setDevice(QIODevice *device)
+{
+    if (device != d->m_device) {
+        if (!d->m_device)
+            d->m_device = device;
+        else
+            qWarning("QNmeaSatelliteInfoSource: source device has already been set");
+    }
+}
+
+/*!
+    Returns the NMEA data source.
+*/
+QIODevice *QNmeaSatelliteInfoSource::device() const
+{
+    return d->m_device;
+}
+
+/*!
+    \reimp
+*/
+void QNmeaSatelliteInfoSource::setUpdateInterval(int msec)
+{
+    int interval = msec;
+    if (interval != 0)
+        interval = qMax(msec, minimumUpdateInterval());
+    QGeoSatelliteInfoSource::setUpdateInterval(interval);
+    if (d->m_invokedStart) {
+        d->stopUpdates();
+        d->startUpdates();
+    }
+}
+
+/*!
+    \reimp
+*/
+int QNmeaSatelliteInfoSource::minimumUpdateInterval() const
+{
+    return 2; // Some chips are capable of over 100 updates per seconds.
+}
+
+/*!
+    \reimp
+*/
+QGeoSatelliteInfoSource::Error QNmeaSatelliteInfoSource::error() const
+{
+    return d->m_satelliteError;
+}
+
+/*!
+    \reimp
+*/
+void QNmeaSatelliteInfoSource::startUpdates()
+{
+    d->startUpdates();
+}
+
+/*!
+    \reimp
+*/
+void QNmeaSatelliteInfoSource::stopUpdates()
+{
+    d->stopUpdates();
+}
+
+/*!
+    \reimp
+*/
+void QNmeaSatelliteInfoSource::requestUpdate(int msec)
+{
+    d->requestUpdate(msec == 0 ? 60000 * 5 : msec); // 5min default timeout
+}
+
+/*!
+    Parses an NMEA GSA sentence into a list of the PRNs of the satellites
+    used in the fix.
+
+    The default implementation parses standard NMEA sentences. Reimplement
+    this method in a subclass to deal with non-standard NMEA sentences.
+
+    The parser reads \a size bytes from \a data and appends the PRNs to
+    \a pnrsInUse. Returns the satellite system of the satellites, or
+    QGeoSatelliteInfo::Undefined if it cannot be determined or the
+    sentence could not be parsed.
+*/
+QGeoSatelliteInfo::SatelliteSystem QNmeaSatelliteInfoSource::parseSatellitesInUseFromNmea(const char *data,
+                                                                                        int size,
+                                                                                        QList<int> &pnrsInUse)
+{
+    return QLocationUtils::getSatInUseFromNmea(data, size, pnrsInUse);
+}
+
+/*!
+    Parses an NMEA GSV sentence into a list of satellites in view.
+
+    The default implementation parses standard NMEA sentences. Reimplement
+    this method in a subclass to deal with non-standard NMEA sentences.
+
+    The parser reads \a size bytes from \a data, appends the satellites it
+    finds to \a infos and sets \a system from the talker ID of the sentence.
+*/
+QNmeaSatelliteInfoSource::SatelliteInfoParseStatus
+QNmeaSatelliteInfoSource::parseSatelliteInfoFromNmea(const char *data, int size,
+                                                     QList<QGeoSatelliteInfo> &infos,
+                                                     QGeoSatelliteInfo::SatelliteSystem &system)
+{
+    return static_cast<SatelliteInfoParseStatus>(QLocationUtils::getSatInfoFromNmea(data, size,
+                                                                                   infos, system));
+}
+
+void QNmeaSatelliteInfoSource::setError(QGeoSatelliteInfoSource::Error satelliteError)
+{
+    d->m_satelliteError = satelliteError;
+    emit QGeoSatelliteInfoSource::error(satelliteError);
+}
+
+QT_END_NAMESPACE
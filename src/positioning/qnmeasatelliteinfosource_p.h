@@ -0,0 +1,125 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtPositioning module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QNMEASATELLITEINFOSOURCE_P_H
+#define QNMEASATELLITEINFOSOURCE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qnmeasatelliteinfosource.h"
+#include "qnmeadevicereader_p.h"
+#include <QtPositioning/qgeosatelliteinfo.h>
+
+#include <QtCore/QBasicTimer>
+#include <QtCore/QHash>
+#include <QtCore/QPointer>
+#include <QtCore/QTime>
+#include <QtCore/QTimer>
+
+QT_BEGIN_NAMESPACE
+
+struct QNmeaSatelliteSystemState
+{
+    QList<QGeoSatelliteInfo> pendingInView; // GSV group being assembled
+    QList<QGeoSatelliteInfo> inView;
+    QList<int> inUse;
+};
+
+class QNmeaSatelliteInfoSourcePrivate : public QObject, public QNmeaSentenceSink
+{
+    Q_OBJECT
+public:
+    QNmeaSatelliteInfoSourcePrivate(QNmeaSatelliteInfoSource *parent,
+                                    QNmeaSatelliteInfoSource::UpdateMode updateMode);
+    ~QNmeaSatelliteInfoSourcePrivate();
+
+    void startUpdates();
+    void stopUpdates();
+    void requestUpdate(int msec);
+
+    void processSentence(const char *data, int size) override;
+    void sentencesProcessed() override;
+
+    QNmeaSatelliteInfoSource::UpdateMode m_updateMode;
+    QPointer<QIODevice> m_device;
+    QGeoSatelliteInfoSource::Error m_satelliteError;
+
+public Q_SLOTS:
+    void readyRead();
+
+protected:
+    void timerEvent(QTimerEvent *event) override;
+
+private Q_SLOTS:
+    void updateRequestTimeout();
+
+private:
+    bool initialize();
+    void prepareSourceDevice();
+    void readSimulatedData();
+    void emitUpdated();
+
+    QNmeaSatelliteInfoSource *m_source;
+    QSharedPointer<QNmeaDeviceReader> m_deviceReader; // RealTimeMode only
+    QHash<int, QNmeaSatelliteSystemState> m_systems;
+    QBasicTimer m_updateTimer; // the timer used in startUpdates()
+    QTimer *m_requestTimer; // the timer used in requestUpdate()
+    bool m_initialized;
+    bool m_invokedStart;
+    bool m_connectedReadyRead;
+    bool m_updated; // satellite info changed since it was last emitted
+
+    // SimulationMode
+    QBasicTimer m_simulationTimer;
+    QByteArray m_nextLine;
+    QTime m_simulationTime;
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,468 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtPositioning module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qubxdecoder_p.h"
+
+#include <QtCore/QHash>
+#include <QtCore/QIODevice>
+#include <QtCore/QMutex>
+#include <QtCore/QTimerEvent>
+#include <QtCore/QtEndian>
+
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    QUbxDecoder extracts UBX frames from a byte stream fed in arbitrary
+    chunks:
+
+        0xB5 0x62 | class | id | length (LE16) | payload | CK_A CK_B
+
+    The 8-bit Fletcher checksum over class, id, length and payload is
+    updated while the bytes are consumed. A payload that arrives in one
+    chunk together with its checksum is handed to the sink in place; only
+    frames split across chunks are assembled in an internal buffer.
+*/
+
+static const uchar ubxSync1 = 0xB5;
+static const uchar ubxSync2 = 0x62;
+
+QUbxDecoder::QUbxDecoder(QUbxMessageSink *sink)
+    : m_sink(sink), m_state(Sync1), m_class(0), m_id(0), m_length(0), m_ckA(0), m_ckB(0),
+      m_receivedCkA(0), m_payload(nullptr), m_messageCount(0), m_checksumErrors(0)
+{
+}
+
+void QUbxDecoder::reset()
+{
+    m_state = Sync1;
+    m_buffer.clear();
+    m_payload = nullptr;
+}
+
+void QUbxDecoder::feed(const char *data, int size)
+{
+    const uchar *bytes = reinterpret_cast<const uchar *>(data);
+    int i = 0;
+    while (i < size) {
+        switch (m_state) {
+        case Sync1: {
+            const void *sync = memchr(bytes + i, ubxSync1, size_t(size - i));
+            if (!sync)
+                return;
+            i = int(static_cast<const uchar *>(sync) - bytes) + 1;
+            m_state = Sync2;
+            break;
+        }
+        case Sync2:
+            if (bytes[i] == ubxSync2) {
+                ++i;
+                m_ckA = m_ckB = 0;
+                m_state = Class;
+            } else {
+                m_state = Sync1; // rescan this byte, it may be a sync byte itself
+            }
+            break;
+        case Class:
+            m_class = bytes[i++];
+            addToChecksum(m_class);
+            m_state = Id;
+            break;
+        case Id:
+            m_id = bytes[i++];
+            addToChecksum(m_id);
+            m_state = Length1;
+            break;
+        case Length1:
+            m_length = bytes[i];
+            addToChecksum(bytes[i++]);
+            m_state = Length2;
+            break;
+        case Length2:
+            m_length |= int(bytes[i]) << 8;
+            addToChecksum(bytes[i++]);
+            m_buffer.clear();
+            m_payload = bytes + i;
+            if (m_length > MaxPayloadSize)
+                m_state = Sync1; // corrupt length, resynchronize
+            else
+                m_state = m_length > 0 ? Payload : ChecksumA;
+            break;
+        case Payload: {
+            const int available = size - i;
+            if (m_buffer.isEmpty() && available >= m_length + 2) {
+                // Payload and checksum are in this chunk: decode in place.
+                m_payload = bytes + i;
+                for (int k = 0; k < m_length; ++k)
+                    addToChecksum(bytes[i + k]);
+                i += m_length;
+                m_state = ChecksumA;
+            } else {
+                const int count = qMin(available, m_length - m_buffer.size());
+                for (int k = 0; k < count; ++k)
+                    addToChecksum(bytes[i + k]);
+                m_buffer.append(data + i, count);
+                i += count;
+                if (m_buffer.size() == m_length) {
+                    m_payload = reinterpret_cast<const uchar *>(m_buffer.constData());
+                    m_state = ChecksumA;
+                }
+            }
+            break;
+        }
+        case ChecksumA:
+            m_receivedCkA = bytes[i++];
+            m_state = ChecksumB;
+            break;
+        case ChecksumB: {
+            const quint8 receivedCkB = bytes[i++];
+            m_state = Sync1;
+            if (m_receivedCkA == m_ckA && receivedCkB == m_ckB) {
+                ++m_messageCount;
+                m_sink->processMessage(m_class, m_id, m_length ? m_payload : nullptr, m_length);
+            } else {
+                ++m_checksumErrors;
+            }
+            break;
+        }
+        }
+    }
+}
+
+quint32 QUbxDecoder::timeOfWeek(const uchar *payload, int size)
+{
+    // All NAV messages start with the GPS time of week in milliseconds.
+    return size >= 4 ? qFromLittleEndian<quint32>(payload) : 0;
+}
+
+/*
+    Parses a UBX-NAV-PVT payload. Positions without a valid fix are parsed,
+    but *hasFix is set to false.
+*/
+bool QUbxDecoder::parseNavPvt(const uchar *payload, int size, QGeoPositionInfo *info, bool *hasFix)
+{
+    // 84 bytes up to protocol version 14, 92 bytes since
+    if (!info || size < 84)
+        return false;
+
+    const quint8 valid = payload[11];
+    const bool validDate = valid & 0x01;
+    const bool validTime = valid & 0x02;
+    const bool validMagneticDeclination = valid & 0x08;
+
+    if (validTime) {
+        const QTime time(payload[8], payload[9], payload[10]);
+        QDate date;
+        if (validDate)
+            date = QDate(qFromLittleEndian<quint16>(payload + 4), payload[6], payload[7]);
+        QDateTime timestamp(date, time, Qt::UTC);
+        const qint32 nano = qFromLittleEndian<qint32>(payload + 16);
+        info->setTimestamp(timestamp.addMSecs(nano / 1000000));
+    }
+
+    const quint8 fixType = payload[20];
+    const bool gnssFixOk = payload[21] & 0x01;
+    const bool fix = gnssFixOk && fixType >= 1 && fixType <= 4; // dead reckoning, 2D, 3D, GNSS + DR
+    const bool fix3d = fix && fixType != 2;
+    if (hasFix)
+        *hasFix = fix;
+
+    if (fix) {
+        QGeoCoordinate coordinate(qFromLittleEndian<qint32>(payload + 28) * 1e-7,
+                                  qFromLittleEndian<qint32>(payload + 24) * 1e-7);
+        if (fix3d)
+            coordinate.setAltitude(qFromLittleEndian<qint32>(payload + 36) / 1000.0);
+        info->setCoordinate(coordinate);
+
+        info->setAttribute(QGeoPositionInfo::HorizontalAccuracy,
+                           qFromLittleEndian<quint32>(payload + 40) / 1000.0);
+        if (fix3d) {
+            info->setAttribute(QGeoPositionInfo::VerticalAccuracy,
+                               qFromLittleEndian<quint32>(payload + 44) / 1000.0);
+            // velD points down
+            info->setAttribute(QGeoPositionInfo::VerticalSpeed,
+                               -qFromLittleEndian<qint32>(payload + 56) / 1000.0);
+        }
+        info->setAttribute(QGeoPositionInfo::GroundSpeed,
+                           qFromLittleEndian<qint32>(payload + 60) / 1000.0);
+        info->setAttribute(QGeoPositionInfo::Direction,
+                           qFromLittleEndian<qint32>(payload + 64) * 1e-5);
+    }
+
+    if (validMagneticDeclination && size >= 92) {
+        info->setAttribute(QGeoPositionInfo::MagneticVariation,
+                           qFromLittleEndian<qint16>(payload + 88) * 1e-2);
+    }
+
+    return true;
+}
+
+static QGeoSatelliteInfo::SatelliteSystem qubxdecoder_satelliteSystem(quint8 gnssId)
+{
+    switch (gnssId) {
+    case 0:
+        return QGeoSatelliteInfo::GPS;
+    case 6:
+        return QGeoSatelliteInfo::GLONASS;
+    default:
+        return QGeoSatelliteInfo::Undefined;
+    }
+}
+
+/*
+    Parses a UBX-NAV-SAT payload into the satellites in view and the
+    subset of them used for navigation.
+*/
+bool QUbxDecoder::parseNavSat(const uchar *payload, int size,
+                              QList<QGeoSatelliteInfo> *inView, QList<QGeoSatelliteInfo> *inUse)
+{
+    if (size < 8)
+        return false;
+
+    const int count = payload[5];
+    if (size < 8 + 12 * count)
+        return false;
+
+    for (int i = 0; i < count; ++i) {
+        const uchar *block = payload + 8 + 12 * i;
+
+        QGeoSatelliteInfo info;
+        info.setSatelliteSystem(qubxdecoder_satelliteSystem(block[0]));
+        info.setSatelliteIdentifier(block[1]);
+        info.setSignalStrength(block[2]);
+        const qint8 elevation = qint8(block[3]);
+        if (elevation >= -90 && elevation <= 90)
+            info.setAttribute(QGeoSatelliteInfo::Elevation, elevation);
+        const qint16 azimuth = qFromLittleEndian<qint16>(block + 4);
+        if (azimuth >= 0 && azimuth <= 360)
+            info.setAttribute(QGeoSatelliteInfo::Azimuth, azimuth);
+
+        if (inView)
+            inView->append(info);
+        const quint32 flags = qFromLittleEndian<quint32>(block + 8);
+        if (inUse && (flags & 0x08)) // svUsed
+            inUse->append(info);
+    }
+    return true;
+}
+
+//============================================================
+
+namespace {
+struct UbxReaderRegistry
+{
+    QMutex mutex;
+    QHash<QIODevice *, QWeakPointer<QUbxDeviceReader> > readers;
+};
+}
+
+Q_GLOBAL_STATIC(UbxReaderRegistry, ubxReaderRegistry)
+
+QUbxDeviceReader::QUbxDeviceReader(QIODevice *device)
+    : QObject(nullptr), m_device(device), m_decoder(this), m_reading(false)
+{
+}
+
+QUbxDeviceReader::~QUbxDeviceReader()
+{
+    UbxReaderRegistry *registry = ubxReaderRegistry();
+    if (!registry)
+        return;
+
+    QMutexLocker locker(&registry->mutex);
+    for (auto it = registry->readers.begin(); it != registry->readers.end(); ) {
+        if (it.value().isNull())
+            it = registry->readers.erase(it);
+        else
+            ++it;
+    }
+}
+
+/*
+    Returns the reader decoding \a device, creating it if no UBX source is
+    currently reading from that device. This lets a position and a
+    satellite source share one receiver while decoding the stream once.
+*/
+QSharedPointer<QUbxDeviceReader> QUbxDeviceReader::sharedReader(QIODevice *device)
+{
+    UbxReaderRegistry *registry = ubxReaderRegistry();
+    QMutexLocker locker(&registry->mutex);
+
+    QSharedPointer<QUbxDeviceReader> reader = registry->readers.value(device).toStrongRef();
+    if (!reader) {
+        reader = QSharedPointer<QUbxDeviceReader>(new QUbxDeviceReader(device));
+        registry->readers.insert(device, reader);
+
+        // A device created later at the same address must not get this reader.
+        connect(device, &QObject::destroyed, reader.data(), [registry, device]() {
+            QMutexLocker locker(&registry->mutex);
+            registry->readers.remove(device);
+        });
+    }
+    return reader;
+}
+
+void QUbxDeviceReader::addSink(QUbxMessageSink *sink)
+{
+    if (!m_sinks.contains(sink))
+        m_sinks.append(sink);
+}
+
+void QUbxDeviceReader::removeSink(QUbxMessageSink *sink)
+{
+    const int index = m_sinks.indexOf(sink);
+    if (index >= 0)
+        m_sinks[index] = nullptr; // may be called from within readAvailableData()
+    if (!m_reading)
+        m_sinks.removeAll(nullptr);
+}
+
+void QUbxDeviceReader::readAvailableData()
+{
+    if (m_reading || !m_device)
+        return;
+
+    // A sink may release the last reference to us while handling a message.
+    const QSharedPointer<QUbxDeviceReader> guard = sharedFromThis();
+    m_reading = true;
+    const quint64 messageCount = m_decoder.messageCount();
+    while (m_device && m_device->bytesAvailable() > 0) {
+        char buf[4096];
+        const qint64 size = m_device->read(buf, sizeof(buf));
+        if (size <= 0)
+            break;
+        m_decoder.feed(buf, int(size));
+    }
+
+    if (m_decoder.messageCount() != messageCount) {
+        for (int i = 0; i < m_sinks.size(); ++i) {
+            if (m_sinks.at(i))
+                m_sinks.at(i)->messagesProcessed();
+        }
+    }
+    m_reading = false;
+    m_sinks.removeAll(nullptr);
+}
+
+void QUbxDeviceReader::processMessage(quint8 messageClass, quint8 messageId,
+                                      const uchar *payload, int size)
+{
+    for (int i = 0; i < m_sinks.size(); ++i) {
+        if (m_sinks.at(i))
+            m_sinks.at(i)->processMessage(messageClass, messageId, payload, size);
+    }
+}
+
+//============================================================
+
+/*
+    QUbxSimulatedReader replays recorded UBX data at the rate it was
+    recorded. Messages sharing the same time of week form an epoch; the
+    epochs are dispatched to the sink spaced by their recorded time
+    difference.
+*/
+QUbxSimulatedReader::QUbxSimulatedReader(QIODevice *device, QUbxMessageSink *sink, QObject *parent)
+    : QObject(parent), m_device(device), m_sink(sink), m_decoder(this)
+{
+}
+
+void QUbxSimulatedReader::readAvailableData()
+{
+    while (m_device && m_device->bytesAvailable() > 0) {
+        char buf[4096];
+        const qint64 size = m_device->read(buf, sizeof(buf));
+        if (size <= 0)
+            break;
+        m_decoder.feed(buf, int(size));
+    }
+
+    if (!m_timer.isActive())
+        replayNextEpoch();
+}
+
+void QUbxSimulatedReader::processMessage(quint8 messageClass, quint8 messageId,
+                                         const uchar *payload, int size)
+{
+    // Only NAV messages carry the time of week needed for pacing.
+    if (messageClass != QUbxDecoder::ClassNav)
+        return;
+
+    PendingMessage message;
+    message.timeOfWeek = QUbxDecoder::timeOfWeek(payload, size);
+    message.messageClass = messageClass;
+    message.messageId = messageId;
+    message.payload = QByteArray(reinterpret_cast<const char *>(payload), size);
+    m_pending.enqueue(message);
+}
+
+void QUbxSimulatedReader::replayNextEpoch()
+{
+    if (m_pending.isEmpty())
+        return;
+
+    const quint32 timeOfWeek = m_pending.head().timeOfWeek;
+    while (!m_pending.isEmpty() && m_pending.head().timeOfWeek == timeOfWeek) {
+        const PendingMessage message = m_pending.dequeue();
+        m_sink->processMessage(message.messageClass, message.messageId,
+                               reinterpret_cast<const uchar *>(message.payload.constData()),
+                               message.payload.size());
+    }
+    m_sink->messagesProcessed();
+
+    if (!m_pending.isEmpty()) {
+        qint64 delay = qint64(m_pending.head().timeOfWeek) - timeOfWeek;
+        if (delay < 0) // week rollover
+            delay += 7 * 24 * 60 * 60 * 1000;
+        m_timer.start(int(delay), this);
+    }
+}
+
+void QUbxSimulatedReader::timerEvent(QTimerEvent *event)
+{
+    if (event->timerId() != m_timer.timerId()) {
+        QObject::timerEvent(event);
+        return;
+    }
+
+    m_timer.stop();
+    replayNextEpoch();
+}
+
+QT_END_NAMESPACE
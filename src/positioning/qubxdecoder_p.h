@@ -0,0 +1,202 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtPositioning module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QUBXDECODER_P_H
+#define QUBXDECODER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtPositioning/private/qpositioningglobal_p.h>
+#include <QtPositioning/qgeopositioninfo.h>
+#include <QtPositioning/qgeosatelliteinfo.h>
+#include <QtCore/QBasicTimer>
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+#include <QtCore/QQueue>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QVector>
+
+QT_BEGIN_NAMESPACE
+
+class QIODevice;
+
+class QUbxMessageSink
+{
+public:
+    virtual ~QUbxMessageSink() {}
+
+    // payload is only valid during the call.
+    virtual void processMessage(quint8 messageClass, quint8 messageId,
+                                const uchar *payload, int size) = 0;
+    // Called once all complete messages currently available have been dispatched.
+    virtual void messagesProcessed() {}
+};
+
+class Q_POSITIONING_PRIVATE_EXPORT QUbxDecoder
+{
+public:
+    enum MessageClass {
+        ClassNav = 0x01
+    };
+
+    enum MessageId {
+        NavPvt = 0x07,
+        NavSat = 0x35
+    };
+
+    enum { MaxPayloadSize = 8192 };
+
+    explicit QUbxDecoder(QUbxMessageSink *sink);
+
+    void feed(const char *data, int size);
+    void reset();
+
+    quint64 messageCount() const { return m_messageCount; }
+    quint64 checksumErrorCount() const { return m_checksumErrors; }
+
+    static bool parseNavPvt(const uchar *payload, int size, QGeoPositionInfo *info, bool *hasFix);
+    static bool parseNavSat(const uchar *payload, int size,
+                            QList<QGeoSatelliteInfo> *inView, QList<QGeoSatelliteInfo> *inUse);
+    static quint32 timeOfWeek(const uchar *payload, int size);
+
+private:
+    enum State {
+        Sync1,
+        Sync2,
+        Class,
+        Id,
+        Length1,
+        Length2,
+        Payload,
+        ChecksumA,
+        ChecksumB
+    };
+
+    inline void addToChecksum(uchar byte)
+    {
+        m_ckA += byte;
+        m_ckB += m_ckA;
+    }
+
+    QUbxMessageSink *m_sink;
+    State m_state;
+    quint8 m_class;
+    quint8 m_id;
+    int m_length;
+    quint8 m_ckA;
+    quint8 m_ckB;
+    quint8 m_receivedCkA;
+    const uchar *m_payload; // points into the fed data, or into m_buffer
+    QByteArray m_buffer; // only used for messages split across feed() calls
+    quint64 m_messageCount;
+    quint64 m_checksumErrors;
+};
+
+class Q_POSITIONING_PRIVATE_EXPORT QUbxDeviceReader : public QObject, public QUbxMessageSink,
+                                                     public QEnableSharedFromThis<QUbxDeviceReader>
+{
+    Q_OBJECT
+public:
+    ~QUbxDeviceReader();
+
+    static QSharedPointer<QUbxDeviceReader> sharedReader(QIODevice *device);
+
+    void addSink(QUbxMessageSink *sink);
+    void removeSink(QUbxMessageSink *sink);
+
+    void readAvailableData();
+
+    void processMessage(quint8 messageClass, quint8 messageId,
+                        const uchar *payload, int size) override;
+
+private:
+    explicit QUbxDeviceReader(QIODevice *device);
+
+    QPointer<QIODevice> m_device;
+    QUbxDecoder m_decoder;
+    QVector<QUbxMessageSink *> m_sinks;
+    bool m_reading;
+};
+
+class Q_POSITIONING_PRIVATE_EXPORT QUbxSimulatedReader : public QObject, public QUbxMessageSink
+{
+    Q_OBJECT
+public:
+    QUbxSimulatedReader(QIODevice *device, QUbxMessageSink *sink, QObject *parent = nullptr);
+
+    void readAvailableData();
+
+    void processMessage(quint8 messageClass, quint8 messageId,
+                        const uchar *payload, int size) override;
+
+protected:
+    void timerEvent(QTimerEvent *event) override;
+
+private:
+    struct PendingMessage
+    {
+        quint32 timeOfWeek;
+        quint8 messageClass;
+        quint8 messageId;
+        QByteArray payload;
+    };
+
+    void replayNextEpoch();
+
+    QPointer<QIODevice> m_device;
+    QUbxMessageSink *m_sink;
+    QUbxDecoder m_decoder;
+    QQueue<PendingMessage> m_pending;
+    QBasicTimer m_timer;
+};
+
+QT_END_NAMESPACE
+
+#endif // QUBXDECODER_P_H
@@ -0,0 +1,290 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtPositioning module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qubxpositioninfosource_p.h"
+
+#include <QtCore/QIODevice>
+#include <QtCore/QTimerEvent>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    QUbxPositionInfoSource provides positions from the UBX-NAV-PVT messages
+    of a u-blox receiver, read from any QIODevice.
+
+    In RealTimeMode the device is decoded through a shared QUbxDeviceReader,
+    so a QUbxSatelliteInfoSource can be attached to the same receiver. In
+    SimulationMode recorded .ubx data is replayed at its original pace.
+*/
+
+QUbxPositionInfoSource::QUbxPositionInfoSource(UpdateMode updateMode, QObject *parent)
+    : QGeoPositionInfoSource(parent),
+      m_updateMode(updateMode),
+      m_requestTimer(nullptr),
+      m_positionError(UnknownSourceError),
+      m_invokedStart(false),
+      m_noUpdateLastInterval(false),
+      m_updateTimeoutSent(false),
+      m_connectedReadyRead(false)
+{
+}
+
+QUbxPositionInfoSource::~QUbxPositionInfoSource()
+{
+    if (m_deviceReader)
+        m_deviceReader->removeSink(this);
+}
+
+QUbxPositionInfoSource::UpdateMode QUbxPositionInfoSource::updateMode() const
+{
+    return m_updateMode;
+}
+
+void QUbxPositionInfoSource::setDevice(QIODevice *device)
+{
+    if (device != m_device) {
+        if (!m_device)
+            m_device = device;
+        else
+            qWarning("QUbxPositionInfoSource: source device has already been set");
+    }
+}
+
+QIODevice *QUbxPositionInfoSource::device() const
+{
+    return m_device;
+}
+
+void QUbxPositionInfoSource::setUpdateInterval(int msec)
+{
+    int interval = msec;
+    if (interval != 0)
+        interval = qMax(msec, minimumUpdateInterval());
+    QGeoPositionInfoSource::setUpdateInterval(interval);
+    if (m_invokedStart) {
+        stopUpdates();
+        startUpdates();
+    }
+}
+
+QGeoPositionInfo QUbxPositionInfoSource::lastKnownPosition(bool) const
+{
+    // the bool value does not matter since we only use satellite positioning
+    return m_lastUpdate;
+}
+
+QGeoPositionInfoSource::PositioningMethods QUbxPositionInfoSource::supportedPositioningMethods() const
+{
+    return SatellitePositioningMethods;
+}
+
+int QUbxPositionInfoSource::minimumUpdateInterval() const
+{
+    return 2; // u-blox chips go up to 25 Hz and beyond
+}
+
+QGeoPositionInfoSource::Error QUbxPositionInfoSource::error() const
+{
+    return m_positionError;
+}
+
+bool QUbxPositionInfoSource::initialize()
+{
+    if (m_deviceReader || m_simulatedReader)
+        return true;
+
+    if (!m_device) {
+        qWarning("QUbxPositionInfoSource: no QIODevice data source, call setDevice() first");
+        return false;
+    }
+
+    if (!m_device->isOpen() && !m_device->open(QIODevice::ReadOnly)) {
+        qWarning("QUbxPositionInfoSource: cannot open QIODevice data source");
+        return false;
+    }
+
+    if (m_updateMode == RealTimeMode) {
+        m_deviceReader = QUbxDeviceReader::sharedReader(m_device);
+        m_deviceReader->addSink(this);
+    } else {
+        m_simulatedReader.reset(new QUbxSimulatedReader(m_device, this));
+    }
+    return true;
+}
+
+void QUbxPositionInfoSource::prepareSourceDevice()
+{
+    if (!m_connectedReadyRead) {
+        connect(m_device, SIGNAL(readyRead()), SLOT(readyRead()));
+        m_connectedReadyRead = true;
+    }
+
+    // some data may already be available
+    if (m_device->bytesAvailable())
+        readyRead();
+}
+
+void QUbxPositionInfoSource::readyRead()
+{
+    if (m_deviceReader)
+        m_deviceReader->readAvailableData();
+    else if (m_simulatedReader)
+        m_simulatedReader->readAvailableData();
+}
+
+void QUbxPositionInfoSource::startUpdates()
+{
+    if (m_invokedStart)
+        return;
+
+    m_invokedStart = true;
+    m_pendingUpdate = QGeoPositionInfo();
+    m_noUpdateLastInterval = false;
+
+    if (!initialize())
+        return;
+
+    if (updateInterval() > 0)
+        m_updateTimer.start(updateInterval(), this);
+
+    prepareSourceDevice();
+}
+
+void QUbxPositionInfoSource::stopUpdates()
+{
+    m_invokedStart = false;
+    m_updateTimer.stop();
+    m_pendingUpdate = QGeoPositionInfo();
+    m_noUpdateLastInterval = false;
+}
+
+void QUbxPositionInfoSource::requestUpdate(int msec)
+{
+    if (m_requestTimer && m_requestTimer->isActive())
+        return;
+
+    if (msec == 0)
+        msec = 60000 * 5; // 5min default timeout
+
+    if (msec < 0 || msec < minimumUpdateInterval()) {
+        emit updateTimeout();
+        return;
+    }
+
+    if (!m_requestTimer) {
+        m_requestTimer = new QTimer(this);
+        m_requestTimer->setSingleShot(true);
+        connect(m_requestTimer, SIGNAL(timeout()), SLOT(updateRequestTimeout()));
+    }
+
+    if (!initialize()) {
+        emit updateTimeout();
+        return;
+    }
+
+    m_requestTimer->start(msec);
+    prepareSourceDevice();
+}
+
+void QUbxPositionInfoSource::updateRequestTimeout()
+{
+    m_requestTimer->stop();
+    emit updateTimeout();
+}
+
+void QUbxPositionInfoSource::processMessage(quint8 messageClass, quint8 messageId,
+                                            const uchar *payload, int size)
+{
+    if (messageClass != QUbxDecoder::ClassNav || messageId != QUbxDecoder::NavPvt)
+        return;
+
+    QGeoPositionInfo update;
+    bool hasFix = false;
+    if (!QUbxDecoder::parseNavPvt(payload, size, &update, &hasFix) || !hasFix || !update.isValid())
+        return;
+
+    if (m_requestTimer && m_requestTimer->isActive()) { // User called requestUpdate()
+        m_requestTimer->stop();
+        emitUpdated(update);
+    } else if (m_invokedStart) { // user called startUpdates()
+        if (m_updateTimer.isActive()) { // update interval > 0
+            // for periodic updates, only want the most recent update
+            m_pendingUpdate = update;
+            if (m_noUpdateLastInterval) {
+                emitPendingUpdate();
+                m_noUpdateLastInterval = false;
+            }
+        } else {
+            emitUpdated(update);
+        }
+    }
+    m_lastUpdate = update;
+}
+
+void QUbxPositionInfoSource::timerEvent(QTimerEvent *event)
+{
+    if (event->timerId() == m_updateTimer.timerId())
+        emitPendingUpdate();
+    else
+        QGeoPositionInfoSource::timerEvent(event);
+}
+
+void QUbxPositionInfoSource::emitPendingUpdate()
+{
+    if (m_pendingUpdate.isValid()) {
+        m_updateTimeoutSent = false;
+        m_noUpdateLastInterval = false;
+        emitUpdated(m_pendingUpdate);
+        m_pendingUpdate = QGeoPositionInfo();
+    } else { // invalid update
+        if (m_noUpdateLastInterval && !m_updateTimeoutSent) {
+            m_updateTimeoutSent = true;
+            emit updateTimeout();
+        }
+        m_noUpdateLastInterval = true;
+    }
+}
+
+void QUbxPositionInfoSource::emitUpdated(const QGeoPositionInfo &update)
+{
+    m_lastUpdate = update;
+    emit positionUpdated(update);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,125 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtPositioning module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QUBXPOSITIONINFOSOURCE_P_H
+#define QUBXPOSITIONINFOSOURCE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qubxdecoder_p.h"
+#include <QtPositioning/qgeopositioninfosource.h>
+#include <QtCore/QBasicTimer>
+#include <QtCore/QScopedPointer>
+#include <QtCore/QTimer>
+
+QT_BEGIN_NAMESPACE
+
+class Q_POSITIONING_PRIVATE_EXPORT QUbxPositionInfoSource : public QGeoPositionInfoSource,
+                                                           private QUbxMessageSink
+{
+    Q_OBJECT
+public:
+    enum UpdateMode {
+        RealTimeMode = 1,
+        SimulationMode
+    };
+
+    explicit QUbxPositionInfoSource(UpdateMode updateMode, QObject *parent = nullptr);
+    ~QUbxPositionInfoSource();
+
+    UpdateMode updateMode() const;
+
+    void setDevice(QIODevice *device);
+    QIODevice *device() const;
+
+    void setUpdateInterval(int msec) override;
+
+    QGeoPositionInfo lastKnownPosition(bool fromSatellitePositioningMethodsOnly = false) const override;
+    PositioningMethods supportedPositioningMethods() const override;
+    int minimumUpdateInterval() const override;
+    Error error() const override;
+
+public Q_SLOTS:
+    void startUpdates() override;
+    void stopUpdates() override;
+    void requestUpdate(int timeout = 0) override;
+
+protected:
+    void timerEvent(QTimerEvent *event) override;
+
+private Q_SLOTS:
+    void readyRead();
+    void updateRequestTimeout();
+
+private:
+    void processMessage(quint8 messageClass, quint8 messageId,
+                        const uchar *payload, int size) override;
+
+    bool initialize();
+    void prepareSourceDevice();
+    void emitPendingUpdate();
+    void emitUpdated(const QGeoPositionInfo &update);
+
+    UpdateMode m_updateMode;
+    QPointer<QIODevice> m_device;
+    QSharedPointer<QUbxDeviceReader> m_deviceReader; // RealTimeMode
+    QScopedPointer<QUbxSimulatedReader> m_simulatedReader; // SimulationMode
+    QGeoPositionInfo m_lastUpdate;
+    QGeoPositionInfo m_pendingUpdate;
+    QBasicTimer m_updateTimer; // the timer used in startUpdates()
+    QTimer *m_requestTimer; // the timer used in requestUpdate()
+    Error m_positionError;
+    bool m_invokedStart;
+    bool m_noUpdateLastInterval;
+    bool m_updateTimeoutSent;
+    bool m_connectedReadyRead;
+};
+
+QT_END_NAMESPACE
+
+#endif // QUBXPOSITIONINFOSOURCE_P_H
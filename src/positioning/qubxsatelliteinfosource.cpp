@@ -0,0 +1,253 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtPositioning module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qubxsatelliteinfosource_p.h"
+
+#include <QtCore/QIODevice>
+#include <QtCore/QTimerEvent>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    QUbxSatelliteInfoSource provides satellite information from the
+    UBX-NAV-SAT messages of a u-blox receiver, read from any QIODevice.
+    See QUbxPositionInfoSource for the update modes.
+*/
+
+QUbxSatelliteInfoSource::QUbxSatelliteInfoSource(UpdateMode updateMode, QObject *parent)
+    : QGeoSatelliteInfoSource(parent),
+      m_updateMode(updateMode),
+      m_requestTimer(nullptr),
+      m_satelliteError(NoError),
+      m_invokedStart(false),
+      m_updated(false),
+      m_connectedReadyRead(false)
+{
+}
+
+QUbxSatelliteInfoSource::~QUbxSatelliteInfoSource()
+{
+    if (m_deviceReader)
+        m_deviceReader->removeSink(this);
+}
+
+QUbxSatelliteInfoSource::UpdateMode QUbxSatelliteInfoSource::updateMode() const
+{
+    return m_updateMode;
+}
+
+void QUbxSatelliteInfoSource::setDevice(QIODevice *device)
+{
+    if (device != m_device) {
+        if (!m_device)
+            m_device = device;
+        else
+            qWarning("QUbxSatelliteInfoSource: source device has already been set");
+    }
+}
+
+QIODevice *QUbxSatelliteInfoSource::device() const
+{
+    return m_device;
+}
+
+void QUbxSatelliteInfoSource::setUpdateInterval(int msec)
+{
+    int interval = msec;
+    if (interval != 0)
+        interval = qMax(msec, minimumUpdateInterval());
+    QGeoSatelliteInfoSource::setUpdateInterval(interval);
+    if (m_invokedStart) {
+        stopUpdates();
+        startUpdates();
+    }
+}
+
+int QUbxSatelliteInfoSource::minimumUpdateInterval() const
+{
+    return 2;
+}
+
+QGeoSatelliteInfoSource::Error QUbxSatelliteInfoSource::error() const
+{
+    return m_satelliteError;
+}
+
+bool QUbxSatelliteInfoSource::initialize()
+{
+    if (m_deviceReader || m_simulatedReader)
+        return true;
+
+    if (!m_device) {
+        qWarning("QUbxSatelliteInfoSource: no QIODevice data source, call setDevice() first");
+        return false;
+    }
+
+    if (!m_device->isOpen() && !m_device->open(QIODevice::ReadOnly)) {
+        qWarning("QUbxSatelliteInfoSource: cannot open QIODevice data source");
+        return false;
+    }
+
+    if (m_updateMode == RealTimeMode) {
+        m_deviceReader = QUbxDeviceReader::sharedReader(m_device);
+        m_deviceReader->addSink(this);
+    } else {
+        m_simulatedReader.reset(new QUbxSimulatedReader(m_device, this));
+    }
+    return true;
+}
+
+void QUbxSatelliteInfoSource::prepareSourceDevice()
+{
+    if (!m_connectedReadyRead) {
+        connect(m_device, SIGNAL(readyRead()), SLOT(readyRead()));
+        m_connectedReadyRead = true;
+    }
+
+    // some data may already be available
+    if (m_device->bytesAvailable())
+        readyRead();
+}
+
+void QUbxSatelliteInfoSource::readyRead()
+{
+    if (m_deviceReader)
+        m_deviceReader->readAvailableData();
+    else if (m_simulatedReader)
+        m_simulatedReader->readAvailableData();
+}
+
+void QUbxSatelliteInfoSource::startUpdates()
+{
+    if (m_invokedStart)
+        return;
+
+    m_invokedStart = true;
+    if (!initialize())
+        return;
+
+    if (updateInterval() > 0)
+        m_updateTimer.start(updateInterval(), this);
+
+    prepareSourceDevice();
+}
+
+void QUbxSatelliteInfoSource::stopUpdates()
+{
+    m_invokedStart = false;
+    m_updateTimer.stop();
+}
+
+void QUbxSatelliteInfoSource::requestUpdate(int msec)
+{
+    if (m_requestTimer && m_requestTimer->isActive())
+        return;
+
+    if (msec == 0)
+        msec = 60000 * 5; // 5min default timeout
+
+    if (msec < 0 || msec < minimumUpdateInterval()) {
+        emit requestTimeout();
+        return;
+    }
+
+    if (!m_requestTimer) {
+        m_requestTimer = new QTimer(this);
+        m_requestTimer->setSingleShot(true);
+        connect(m_requestTimer, SIGNAL(timeout()), SLOT(updateRequestTimeout()));
+    }
+
+    if (!initialize()) {
+        emit requestTimeout();
+        return;
+    }
+
+    m_requestTimer->start(msec);
+    prepareSourceDevice();
+}
+
+void QUbxSatelliteInfoSource::updateRequestTimeout()
+{
+    m_requestTimer->stop();
+    emit requestTimeout();
+}
+
+void QUbxSatelliteInfoSource::processMessage(quint8 messageClass, quint8 messageId,
+                                             const uchar *payload, int size)
+{
+    if (messageClass != QUbxDecoder::ClassNav || messageId != QUbxDecoder::NavSat)
+        return;
+
+    QList<QGeoSatelliteInfo> inView;
+    QList<QGeoSatelliteInfo> inUse;
+    if (!QUbxDecoder::parseNavSat(payload, size, &inView, &inUse))
+        return;
+
+    m_inView.swap(inView);
+    m_inUse.swap(inUse);
+    m_updated = true;
+
+    if (m_requestTimer && m_requestTimer->isActive()) { // User called requestUpdate()
+        m_requestTimer->stop();
+        emitUpdated();
+    } else if (m_invokedStart && !m_updateTimer.isActive()) { // update interval <= 0
+        emitUpdated();
+    }
+    // else periodic updates are emitted from timerEvent()
+}
+
+void QUbxSatelliteInfoSource::timerEvent(QTimerEvent *event)
+{
+    if (event->timerId() != m_updateTimer.timerId()) {
+        QGeoSatelliteInfoSource::timerEvent(event);
+        return;
+    }
+
+    if (m_updated)
+        emitUpdated();
+}
+
+void QUbxSatelliteInfoSource::emitUpdated()
+{
+    m_updated = false;
+    emit satellitesInViewUpdated(m_inView);
+    emit satellitesInUseUpdated(m_inUse);
+}
+
+QT_END_NAMESPACE
@@ -108,91 +108,89 @@ QDeclarativePosition::~QDeclarativePosition()
 
 void QDeclarativePosition::setPosition(const QGeoPositionInfo &info)
 {
+    Properties changed;
+
     // timestamp
-    const QDateTime pTimestamp = m_info.timestamp();
-    const QDateTime timestamp = info.timestamp();
-    bool emitTimestampChanged = pTimestamp != timestamp;
+    if (m_info.timestamp() != info.timestamp())
+        changed |= Timestamp;
 
     // coordinate
     const QGeoCoordinate pCoordinate = m_info.coordinate();
     const QGeoCoordinate coordinate = info.coordinate();
-    bool emitCoordinateChanged = pCoordinate != coordinate;
-    bool emitLatitudeValidChanged = exclusiveNaN(pCoordinate.latitude(), coordinate.latitude());
-    bool emitLongitudeValidChanged = exclusiveNaN(pCoordinate.longitude(), coordinate.longitude());
-    bool emitAltitudeValidChanged = exclusiveNaN(pCoordinate.altitude(), coordinate.altitude());
-
-    // direction
-    const qreal pDirection = m_info.attribute(QGeoPositionInfo::Direction);
-    const qreal direction = info.attribute(QGeoPositionInfo::Direction);
-    bool emitDirectionChanged = !equalOrNaN(pDirection, direction);
-    bool emitDirectionValidChanged = exclusiveNaN(pDirection, direction);
-
-    // ground speed
-    const qreal pSpeed = m_info.attribute(QGeoPositionInfo::GroundSpeed);
-    const qreal speed = info.attribute(QGeoPositionInfo::GroundSpeed);
-    bool emitSpeedChanged = !equalOrNaN(pSpeed, speed);
-    bool emitSpeedValidChanged = exclusiveNaN(pSpeed, speed);
-
-    // vertical speed
-    const qreal pVerticalSpeed = m_info.attribute(QGeoPositionInfo::VerticalSpeed);
-    const qreal verticalSpeed = info.attribute(QGeoPositionInfo::VerticalSpeed);
-    bool emitVerticalSpeedChanged = !equalOrNaN(pVerticalSpeed, verticalSpeed);
-    bool emitVerticalSpeedValidChanged = exclusiveNaN(pVerticalSpeed, verticalSpeed);
-
-    // magnetic variation
-    const qreal pMagneticVariation = m_info.attribute(QGeoPositionInfo::MagneticVariation);
-    const qreal magneticVariation = info.attribute(QGeoPositionInfo::MagneticVariation);
-    bool emitMagneticVariationChanged = !equalOrNaN(pMagneticVariation, magneticVariation);
-    bool emitMagneticVariationValidChanged = exclusiveNaN(pMagneticVariation, magneticVariation);
-
-    // horizontal accuracy
-    const qreal pHorizontalAccuracy = m_info.attribute(QGeoPositionInfo::HorizontalAccuracy);
-    const qreal horizontalAccuracy = info.attribute(QGeoPositionInfo::HorizontalAccuracy);
-    bool emitHorizontalAccuracyChanged = !equalOrNaN(pHorizontalAccuracy, horizontalAccuracy);
-    bool emitHorizontalAccuracyValidChanged = exclusiveNaN(pHorizontalAccuracy, horizontalAccuracy);
-
-    // vertical accuracy
-    const qreal pVerticalAccuracy = m_info.attribute(QGeoPositionInfo::VerticalAccuracy);
-    const qreal verticalAccuracy = info.attribute(QGeoPositionInfo::VerticalAccuracy);
-    bool emitVerticalAccuracyChanged = !equalOrNaN(pVerticalAccuracy, verticalAccuracy);
-    bool emitVerticalAccuracyValidChanged = exclusiveNaN(pVerticalAccuracy, verticalAccuracy);
+    if (pCoordinate != coordinate)
+        changed |= Coordinate;
+    if (exclusiveNaN(pCoordinate.latitude(), coordinate.latitude()))
+        changed |= LatitudeValid;
+    if (exclusiveNaN(pCoordinate.longitude(), coordinate.longitude()))
+        changed |= LongitudeValid;
+    if (exclusiveNaN(pCoordinate.altitude(), coordinate.altitude()))
+        changed |= AltitudeValid;
+
+    // attributes
+    static const struct {
+        QGeoPositionInfo::Attribute attribute;
+        Property value;
+        Property valid;
+    } attributes[] = {
+        { QGeoPositionInfo::Direction, Direction, DirectionValid },
+        { QGeoPositionInfo::GroundSpeed, Speed, SpeedValid },
+        { QGeoPositionInfo::VerticalSpeed, VerticalSpeed, VerticalSpeedValid },
+        { QGeoPositionInfo::MagneticVariation, MagneticVariation, MagneticVariationValid },
+        { QGeoPositionInfo::HorizontalAccuracy, HorizontalAccuracy, HorizontalAccuracyValid },
+        { QGeoPositionInfo::VerticalAccuracy, VerticalAccuracy, VerticalAccuracyValid }
+    };
+    for (const auto &attribute : attributes) {
+        const qreal previous = m_info.attribute(attribute.attribute);
+        const qreal current = info.attribute(attribute.attribute);
+        if (!equalOrNaN(previous, current))
+            changed |= attribute.value;
+        if (exclusiveNaN(previous, current))
+            changed |= attribute.valid;
+    }
 
     m_info = info;
+    notify(changed);
+}
+
+/*
+    Emits the change signals of the \a properties that changed, so that
+    only the bindings on those are evaluated, followed by a single
+    propertiesChanged() for handlers interested in the whole update.
+*/
+void QDeclarativePosition::notify(Properties properties)
+{
+    if (!properties)
+        return;
 
-    if (emitTimestampChanged)
-        emit timestampChanged();
-    if (emitCoordinateChanged)
-        emit coordinateChanged();
-    if (emitLatitudeValidChanged)
-        emit latitudeValidChanged();
-    if (emitLongitudeValidChanged)
-        emit longitudeValidChanged();
-    if (emitAltitudeValidChanged)
-        emit altitudeValidChanged();
-    if (emitDirectionChanged)
-        emit directionChanged();
-    if (emitDirectionValidChanged)
-        emit directionValidChanged();
-    if (emitSpeedChanged)
-        emit speedChanged();
-    if (emitSpeedValidChanged)
-        emit speedValidChanged();
-    if (emitVerticalSpeedChanged)
-        emit verticalSpeedChanged();
-    if (emitVerticalSpeedValidChanged)
-        emit verticalSpeedValidChanged();
-    if (emitHorizontalAccuracyChanged)
-        emit horizontalAccuracyChanged();
-    if (emitHorizontalAccuracyValidChanged)
-        emit horizontalAccuracyValidChanged();
-    if (emitVerticalAccuracyChanged)
-        emit verticalAccuracyChanged();
-    if (emitVerticalAccuracyValidChanged)
-        emit verticalAccuracyValidChanged();
-    if (emitMagneticVariationChanged)
-        emit magneticVariationChanged();
-    if (emitMagneticVariationValidChanged)
-        emit magneticVariationValidChanged();
+    typedef void (QDeclarativePosition::*Signal)();
+    static const struct {
+        Property property;
+        Signal signal;
+    } signalList[] = {
+        { Timestamp, &QDeclarativePosition::timestampChanged },
+        { Coordinate, &QDeclarativePosition::coordinateChanged },
+        { LatitudeValid, &QDeclarativePosition::latitudeValidChanged },
+        { LongitudeValid, &QDeclarativePosition::longitudeValidChanged },
+        { AltitudeValid, &QDeclarativePosition::altitudeValidChanged },
+        { Direction, &QDeclarativePosition::directionChanged },
+        { DirectionValid, &QDeclarativePosition::directionValidChanged },
+        { Speed, &QDeclarativePosition::speedChanged },
+        { SpeedValid, &QDeclarativePosition::speedValidChanged },
+        { VerticalSpeed, &QDeclarativePosition::verticalSpeedChanged },
+        { VerticalSpeedValid, &QDeclarativePosition::verticalSpeedValidChanged },
+        { HorizontalAccuracy, &QDeclarativePosition::horizontalAccuracyChanged },
+        { HorizontalAccuracyValid, &QDeclarativePosition::horizontalAccuracyValidChanged },
+        { VerticalAccuracy, &QDeclarativePosition::verticalAccuracyChanged },
+        { VerticalAccuracyValid, &QDeclarativePosition::verticalAccuracyValidChanged },
+        { MagneticVariation, &QDeclarativePosition::magneticVariationChanged },
+        { MagneticVariationValid, &QDeclarativePosition::magneticVariationValidChanged }
+    };
+    for (const auto &entry : signalList) {
+        if (properties & entry.property)
+            emit (this->*entry.signal)();
+    }
+
+    emit propertiesChanged(properties);
 }
 
 const QGeoPositionInfo &QDeclarativePosition::position() const
@@ -303,9 +301,7 @@ void QDeclarativePosition::setHorizontalAccuracy(qreal horizontalAccuracy)
     bool validChanged = exclusiveNaN(pHorizontalAccuracy, horizontalAccuracy);
 
     m_info.setAttribute(QGeoPositionInfo::HorizontalAccuracy, horizontalAccuracy);
-    emit horizontalAccuracyChanged();
-    if (validChanged)
-        emit horizontalAccuracyValidChanged();
+    notify(validChanged ? HorizontalAccuracy | HorizontalAccuracyValid : Properties(HorizontalAccuracy));
 }
 
 qreal QDeclarativePosition::horizontalAccuracy() const
@@ -344,9 +340,7 @@ void QDeclarativePosition::setVerticalAccuracy(qreal verticalAccuracy)
     bool validChanged = exclusiveNaN(pVerticalAccuracy, verticalAccuracy);
 
     m_info.setAttribute(QGeoPositionInfo::VerticalAccuracy, verticalAccuracy);
-    emit verticalAccuracyChanged();
-    if (validChanged)
-        emit verticalAccuracyValidChanged();
+    notify(validChanged ? VerticalAccuracy | VerticalAccuracyValid : Properties(VerticalAccuracy));
 }
 
 qreal QDeclarativePosition::verticalAccuracy() const
@@ -471,4 +465,15 @@ double QDeclarativePosition::magneticVariation() const
     return m_info.attribute(QGeoPositionInfo::MagneticVariation);
 }
 
+/*!
+    \qmlsignal Position::propertiesChanged(int properties)
+    \since Qt Positioning 5.12
+
+    This signal is emitted once for each position update that changes any of
+    the properties, after the change signals of the individual properties.
+    \a properties is a combination of flags telling which ones changed.
+
+    The corresponding handler is \c onPropertiesChanged.
+*/
+
 QT_END_NAMESPACE
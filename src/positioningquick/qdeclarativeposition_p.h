@@ -86,6 +86,29 @@ class Q_POSITIONINGQUICK_PRIVATE_EXPORT QDeclarativePosition : public QObject
     Q_PROPERTY(bool magneticVariationValid READ isMagneticVariationValid NOTIFY magneticVariationChanged REVISION 2)
 
 public:
+    enum Property {
+        NoProperty = 0x0,
+        Timestamp = 0x1,
+        Coordinate = 0x2,
+        LatitudeValid = 0x4,
+        LongitudeValid = 0x8,
+        AltitudeValid = 0x10,
+        Speed = 0x20,
+        SpeedValid = 0x40,
+        HorizontalAccuracy = 0x80,
+        HorizontalAccuracyValid = 0x100,
+        VerticalAccuracy = 0x200,
+        VerticalAccuracyValid = 0x400,
+        Direction = 0x800,
+        DirectionValid = 0x1000,
+        VerticalSpeed = 0x2000,
+        VerticalSpeedValid = 0x4000,
+        MagneticVariation = 0x8000,
+        MagneticVariationValid = 0x10000
+    };
+    Q_DECLARE_FLAGS(Properties, Property)
+    Q_FLAG(Properties)
+
     explicit QDeclarativePosition(QObject *parent = 0);
     ~QDeclarativePosition();
 
@@ -138,10 +161,16 @@ Q_SIGNALS:
     Q_REVISION(2) void magneticVariationChanged();
     Q_REVISION(2) void magneticVariationValidChanged();
 
+    Q_REVISION(3) void propertiesChanged(QDeclarativePosition::Properties properties);
+
 private:
+    void notify(Properties properties);
+
     QGeoPositionInfo m_info;
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(QDeclarativePosition::Properties)
+
 QT_END_NAMESPACE
 
 QML_DECLARE_TYPE(QDeclarativePosition)
@@ -40,6 +40,7 @@
 #include "qdeclarativepositionsource_p.h"
 #include "qdeclarativeposition_p.h"
 
+#include <QtCore/QAbstractAnimation>
 #include <QtCore/QCoreApplication>
 #include <QtQml/qqmlinfo.h>
 #include <QtQml/qqml.h>
@@ -48,8 +49,46 @@
 #include <QtNetwork/QTcpSocket>
 #include <QTimer>
 
+#include <limits>
+
 QT_BEGIN_NAMESPACE
 
+/*
+    Runs for as long as a coalesced position is pending. Being an animation it is
+    advanced by the animation driver, which the Qt Quick render loop keeps in step
+    with the display refresh, so all updates arriving between two frames collapse
+    into a single change set.
+*/
+class QDeclarativePositionFrameTicker : public QAbstractAnimation
+{
+public:
+    explicit QDeclarativePositionFrameTicker(QDeclarativePositionSource *source)
+        : QAbstractAnimation(source), m_source(source)
+    {
+    }
+
+    int duration() const override
+    {
+        return -1;
+    }
+
+protected:
+    void updateCurrentTime(int) override
+    {
+        if (!m_source->m_positionPending) {
+            stop();
+            return;
+        }
+        if (m_source->throttleElapsed()) {
+            stop();
+            m_source->flushPendingPosition();
+        }
+    }
+
+private:
+    QDeclarativePositionSource *m_source;
+};
+
 /*!
     \qmltype PositionSource
     //! \instantiates QDeclarativePositionSource
@@ -131,8 +170,11 @@ QT_BEGIN_NAMESPACE
 QDeclarativePositionSource::QDeclarativePositionSource()
 :   m_positionSource(0), m_preferredPositioningMethods(NoPositioningMethods), m_nmeaFile(0),
     m_nmeaSocket(0), m_active(false), m_singleUpdate(false), m_updateInterval(0),
-    m_sourceError(NoError)
+    m_sourceError(NoError), m_coalesceUpdates(false), m_maximumUpdateRate(0),
+    m_positionPending(false), m_frameTicker(nullptr)
 {
+    m_throttleTimer.setSingleShot(true);
+    connect(&m_throttleTimer, SIGNAL(timeout()), this, SLOT(flushPendingPosition()));
 }
 
 QDeclarativePositionSource::~QDeclarativePositionSource()
@@ -413,10 +455,54 @@ void QDeclarativePositionSource::updateTimeoutReceived()
 
 void QDeclarativePositionSource::setPosition(const QGeoPositionInfo &pi)
 {
+    // anything still waiting for the next frame is older than pi
+    m_positionPending = false;
+    m_pendingPosition = QGeoPositionInfo();
+    m_throttleTimer.stop();
+
     m_position.setPosition(pi);
+    m_lastDelivery.start();
     emit positionChanged();
 }
 
+/*
+    Returns the minimum time, in milliseconds, between two position updates.
+    Computed in floating point, as very small rates do not fit an integer.
+*/
+int QDeclarativePositionSource::throttleInterval() const
+{
+    return int(qMin<qreal>(1000 / m_maximumUpdateRate, std::numeric_limits<int>::max()));
+}
+
+bool QDeclarativePositionSource::throttleElapsed() const
+{
+    if (m_maximumUpdateRate <= 0 || !m_lastDelivery.isValid())
+        return true;
+    return m_lastDelivery.elapsed() >= throttleInterval();
+}
+
+void QDeclarativePositionSource::schedulePendingPosition()
+{
+    if (m_coalesceUpdates) {
+        if (!m_frameTicker)
+            m_frameTicker = new QDeclarativePositionFrameTicker(this);
+        if (m_frameTicker->state() != QAbstractAnimation::Running)
+            m_frameTicker->start();
+    } else if (throttleElapsed()) {
+        flushPendingPosition();
+    } else if (!m_throttleTimer.isActive()) {
+        const qint64 remaining = throttleInterval() - m_lastDelivery.elapsed();
+        m_throttleTimer.start(int(qMax<qint64>(0, remaining)));
+    }
+}
+
+void QDeclarativePositionSource::flushPendingPosition()
+{
+    if (!m_positionPending)
+        return;
+    setPosition(m_pendingPosition);
+}
+
 void QDeclarativePositionSource::setSource(QGeoPositionInfoSource *source)
 {
     if (m_positionSource)
@@ -621,6 +707,8 @@ void QDeclarativePositionSource::update()
 
 void QDeclarativePositionSource::stop()
 {
+    flushPendingPosition();
+
     if (m_positionSource) {
         m_positionSource->stopUpdates();
         if (m_active) {
@@ -679,6 +767,14 @@ QDeclarativePosition *QDeclarativePositionSource::position()
 
 void QDeclarativePositionSource::positionUpdateReceived(const QGeoPositionInfo &update)
 {
+    // A requested single update is delivered right away, it must not wait for a frame.
+    if ((m_coalesceUpdates || m_maximumUpdateRate > 0) && !m_singleUpdate) {
+        m_pendingPosition = update;
+        m_positionPending = true;
+        schedulePendingPosition();
+        return;
+    }
+
     setPosition(update);
 
     if (m_singleUpdate && m_active) {
@@ -689,6 +785,84 @@ void QDeclarativePositionSource::positionUpdateReceived(const QGeoPositionInfo &
 }
 
 
+/*!
+    \qmlproperty bool PositionSource::coalesceUpdates
+
+    This property holds whether position updates are coalesced per frame.
+
+    When enabled, updates received from the positioning backend are not applied
+    to \l position immediately. Instead the most recent one is applied once on
+    the next animation tick, so bindings on \l position and its members are
+    evaluated at most once per frame no matter how fast the backend reports.
+    Updates requested with \l update() are never delayed.
+
+    The default value is \c false.
+
+    \since Qt Positioning 5.12
+    \sa maximumUpdateRate
+*/
+bool QDeclarativePositionSource::coalesceUpdates() const
+{
+    return m_coalesceUpdates;
+}
+
+void QDeclarativePositionSource::setCoalesceUpdates(bool coalesce)
+{
+    if (m_coalesceUpdates == coalesce)
+        return;
+
+    m_coalesceUpdates = coalesce;
+    if (!m_coalesceUpdates && m_frameTicker)
+        m_frameTicker->stop();
+    if (m_positionPending) {
+        m_throttleTimer.stop();
+        if (m_coalesceUpdates || m_maximumUpdateRate > 0)
+            schedulePendingPosition();
+        else
+            flushPendingPosition();
+    }
+    emit coalesceUpdatesChanged();
+}
+
+/*!
+    \qmlproperty real PositionSource::maximumUpdateRate
+
+    This property holds the maximum number of times per second \l position is
+    updated.
+
+    Updates arriving faster than this are folded into the latest one, which is
+    applied as soon as the rate permits. This is independent of \l updateInterval,
+    which is a hint to the positioning backend, and is useful when a backend
+    reports faster than the user interface needs to follow. It can be combined
+    with \l coalesceUpdates.
+
+    The default value is \c 0, meaning the rate is not limited.
+
+    \since Qt Positioning 5.12
+    \sa coalesceUpdates
+*/
+qreal QDeclarativePositionSource::maximumUpdateRate() const
+{
+    return m_maximumUpdateRate;
+}
+
+void QDeclarativePositionSource::setMaximumUpdateRate(qreal rate)
+{
+    rate = qMax<qreal>(0, rate);
+    if (qFuzzyCompare(m_maximumUpdateRate + 1, rate + 1))
+        return;
+
+    m_maximumUpdateRate = rate;
+    if (m_positionPending) {
+        m_throttleTimer.stop();
+        if (m_coalesceUpdates || m_maximumUpdateRate > 0)
+            schedulePendingPosition();
+        else
+            flushPendingPosition();
+    }
+    emit maximumUpdateRateChanged();
+}
+
 /*!
     \qmlproperty enumeration PositionSource::sourceError
 
@@ -54,6 +54,8 @@
 #include "qdeclarativeposition_p.h"
 
 #include <QtCore/QObject>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QTimer>
 #include <QtNetwork/QAbstractSocket>
 #include <QtQml/QQmlParserStatus>
 #include <QtPositioningQuick/private/qpositioningquickglobal_p.h>
@@ -63,6 +65,7 @@ QT_BEGIN_NAMESPACE
 
 class QFile;
 class QTcpSocket;
+class QDeclarativePositionFrameTicker;
 
 class Q_POSITIONINGQUICK_PRIVATE_EXPORT QDeclarativePositionSource : public QObject, public QQmlParserStatus
 {
@@ -77,6 +80,8 @@ class Q_POSITIONINGQUICK_PRIVATE_EXPORT QDeclarativePositionSource : public QObj
     Q_PROPERTY(PositioningMethods preferredPositioningMethods READ preferredPositioningMethods WRITE setPreferredPositioningMethods NOTIFY preferredPositioningMethodsChanged)
     Q_PROPERTY(SourceError sourceError READ sourceError NOTIFY sourceErrorChanged)
     Q_PROPERTY(QString name READ name WRITE setName NOTIFY nameChanged)
+    Q_PROPERTY(bool coalesceUpdates READ coalesceUpdates WRITE setCoalesceUpdates NOTIFY coalesceUpdatesChanged REVISION 12)
+    Q_PROPERTY(qreal maximumUpdateRate READ maximumUpdateRate WRITE setMaximumUpdateRate NOTIFY maximumUpdateRateChanged REVISION 12)
     Q_ENUMS(PositioningMethod)
 
     Q_INTERFACES(QQmlParserStatus)
@@ -123,6 +128,11 @@ public:
     SourceError sourceError() const;
     QGeoPositionInfoSource *positionSource() const;
 
+    bool coalesceUpdates() const;
+    void setCoalesceUpdates(bool coalesce);
+    qreal maximumUpdateRate() const;
+    void setMaximumUpdateRate(qreal rate);
+
     // Virtuals from QQmlParserStatus
     void classBegin() { }
     void componentComplete();
@@ -143,6 +153,8 @@ Q_SIGNALS:
     void nameChanged();
     void validityChanged();
     void updateTimeout();
+    Q_REVISION(12) void coalesceUpdatesChanged();
+    Q_REVISION(12) void maximumUpdateRateChanged();
 
 private Q_SLOTS:
     void positionUpdateReceived(const QGeoPositionInfo &update);
@@ -150,9 +162,14 @@ private Q_SLOTS:
     void socketConnected();
     void socketError(QAbstractSocket::SocketError error);
     void updateTimeoutReceived();
+    void flushPendingPosition();
 
 private:
     void setPosition(const QGeoPositionInfo &pi);
+    void schedulePendingPosition();
+    int throttleInterval() const;
+    bool throttleElapsed() const;
+    friend class QDeclarativePositionFrameTicker;
     void setSource(QGeoPositionInfoSource *source);
 
     QGeoPositionInfoSource *m_positionSource;
@@ -166,6 +183,14 @@ private:
     bool m_singleUpdate;
     int m_updateInterval;
     SourceError m_sourceError;
+
+    bool m_coalesceUpdates;
+    qreal m_maximumUpdateRate;
+    bool m_positionPending;
+    QGeoPositionInfo m_pendingPosition;
+    QDeclarativePositionFrameTicker *m_frameTicker;
+    QTimer m_throttleTimer;
+    QElapsedTimer m_lastDelivery;
 };
 
 QT_END_NAMESPACE
@@ -27,6 +27,8 @@ qtHaveModule(quick) {
 plugins.depends += positioning
 SUBDIRS += plugins
 
+qtConfig(geoservices_offline): SUBDIRS += tools
+
 !android:contains(QT_CONFIG, private_tests) {
     SUBDIRS += positioning_doc_snippets
     positioning_doc_snippets.subdir = positioning/doc/snippets
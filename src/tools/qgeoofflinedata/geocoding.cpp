@@ -0,0 +1,215 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the tools applications of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "commands.h"
+#include "osmreader.h"
+
+#include <qgeocodingindex.h>
+
+#include <QtCore/QSet>
+#include <QtCore/QTextStream>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+struct Boundary
+{
+    int level;
+    QString name;
+    QString countryCode;
+    QVector<qint64> ways;
+};
+
+QGeoCodingIndex::Point toPoint(double latitude, double longitude)
+{
+    QGeoCodingIndex::Point point;
+    point.latitude = qint32(qRound64(latitude * 1e6));
+    point.longitude = qint32(qRound64(longitude * 1e6));
+    return point;
+}
+
+/*
+    Chains the member ways of a boundary into closed rings. Inner and outer
+    rings are not told apart, the index uses the even-odd rule. Rings that
+    cannot be closed, usually because the extract cuts the boundary, are
+    dropped.
+*/
+QVector<QGeoCodingIndexWriter::Ring> assembleRings(const QVector<qint64> &ways,
+                                                   const QHash<qint64, QVector<qint64>> &wayNodes,
+                                                   const QHash<qint64, QGeoCodingIndex::Point> &coordinates)
+{
+    QVector<QVector<qint64>> pieces;
+    for (qint64 id : ways) {
+        const QVector<qint64> nodes = wayNodes.value(id);
+        if (nodes.size() >= 2)
+            pieces.append(nodes);
+    }
+
+    QVector<QGeoCodingIndexWriter::Ring> rings;
+    QVector<bool> used(pieces.size(), false);
+    for (int i = 0; i < pieces.size(); ++i) {
+        if (used.at(i))
+            continue;
+        used[i] = true;
+        QVector<qint64> ring = pieces.at(i);
+        while (ring.first() != ring.last()) {
+            bool extended = false;
+            for (int j = 0; j < pieces.size() && !extended; ++j) {
+                if (used.at(j))
+                    continue;
+                QVector<qint64> piece = pieces.at(j);
+                if (piece.last() == ring.last())
+                    std::reverse(piece.begin(), piece.end());
+                if (piece.first() != ring.last())
+                    continue;
+                ring += piece.mid(1);
+                used[j] = true;
+                extended = true;
+            }
+            if (!extended)
+                break;
+        }
+        if (ring.first() != ring.last())
+            continue;
+
+        QGeoCodingIndexWriter::Ring points;
+        points.reserve(ring.size());
+        for (qint64 node : qAsConst(ring)) {
+            auto it = coordinates.constFind(node);
+            if (it == coordinates.constEnd())
+                break;
+            points.append(it.value());
+        }
+        if (points.size() == ring.size())
+            rings.append(points);
+    }
+    return rings;
+}
+
+} // namespace
+
+/*
+    Indexes the addressed nodes and ways of an OSM extract, the latter at the
+    average of their nodes, and the administrative boundary relations. The
+    file is read twice: boundaries are relations, which come last, and the
+    geometry of their member ways is only kept for the ways they use.
+*/
+bool buildGeocodingIndex(const QString &input, const QString &output, QString *errorString)
+{
+    QVector<Boundary> boundaries;
+    QSet<qint64> boundaryWays;
+
+    OsmReader relationReader;
+    relationReader.relationHandler = [&](const OsmRelation &relation) {
+        const QString type = relation.tags.value(QLatin1String("type"));
+        if ((type != QLatin1String("boundary") && type != QLatin1String("multipolygon"))
+                || relation.tags.value(QLatin1String("boundary")) != QLatin1String("administrative")) {
+            return;
+        }
+        Boundary boundary;
+        bool ok = false;
+        boundary.level = relation.tags.value(QLatin1String("admin_level")).toInt(&ok);
+        boundary.name = relation.tags.value(QLatin1String("name"));
+        if (!ok || boundary.name.isEmpty())
+            return;
+        for (const char *key : { "ISO3166-1:alpha3", "ISO3166-1", "ISO3166-1:alpha2" }) {
+            boundary.countryCode = relation.tags.value(QLatin1String(key));
+            if (!boundary.countryCode.isEmpty())
+                break;
+        }
+        for (const OsmMember &member : relation.members) {
+            if (member.type == QLatin1String("way") && member.role != QLatin1String("subarea")) {
+                boundary.ways.append(member.ref);
+                boundaryWays.insert(member.ref);
+            }
+        }
+        boundaries.append(boundary);
+    };
+    if (!relationReader.read(input, errorString))
+        return false;
+
+    QGeoCodingIndexWriter writer;
+    QHash<qint64, QGeoCodingIndex::Point> coordinates;
+    QHash<qint64, QVector<qint64>> wayNodes;
+
+    auto addAddress = [&](double latitude, double longitude, const QHash<QString, QString> &tags) {
+        QString street = tags.value(QLatin1String("addr:street"));
+        if (street.isEmpty())
+            street = tags.value(QLatin1String("addr:place"));
+        writer.addAddress(latitude, longitude, street,
+                          tags.value(QLatin1String("addr:housenumber")),
+                          tags.value(QLatin1String("addr:postcode")),
+                          tags.value(QLatin1String("addr:city")));
+    };
+
+    OsmReader reader;
+    reader.nodeHandler = [&](const OsmNode &node) {
+        coordinates.insert(node.id, toPoint(node.latitude, node.longitude));
+        if (node.tags.contains(QLatin1String("addr:housenumber")))
+            addAddress(node.latitude, node.longitude, node.tags);
+    };
+    reader.wayHandler = [&](const OsmWay &way) {
+        if (boundaryWays.contains(way.id))
+            wayNodes.insert(way.id, way.nodes);
+        if (!way.tags.contains(QLatin1String("addr:housenumber")))
+            return;
+        double latitude = 0.0;
+        double longitude = 0.0;
+        int count = 0;
+        for (qint64 id : way.nodes) {
+            auto it = coordinates.constFind(id);
+            if (it == coordinates.constEnd())
+                continue;
+            latitude += it->latitude * 1e-6;
+            longitude += it->longitude * 1e-6;
+            ++count;
+        }
+        if (count)
+            addAddress(latitude / count, longitude / count, way.tags);
+    };
+    if (!reader.read(input, errorString))
+        return false;
+
+    for (const Boundary &boundary : qAsConst(boundaries)) {
+        writer.addArea(boundary.level, boundary.name, boundary.countryCode,
+                       assembleRings(boundary.ways, wayNodes, coordinates));
+    }
+
+    if (!writer.write(output, errorString))
+        return false;
+
+    QTextStream(stdout) << "Wrote " << writer.addressCount() << " addresses and "
+                        << writer.areaCount() << " areas to " << output << endl;
+    return true;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,81 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the tools applications of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "commands.h"
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QTextStream>
+
+QT_USE_NAMESPACE
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("qgeoofflinedata"));
+    QCoreApplication::setApplicationVersion(QStringLiteral(QT_VERSION_STR));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral(
+        "Builds the data files used by the Qt Location offline plugin from an "
+        "OpenStreetMap XML extract, or for places from a JSON or CSV dump.\n\n"
+        "Commands:\n"
+        "  routing    road graph for offline.routing.graph\n"
+        "  geocoding  address and boundary index for offline.geocoding.index\n"
+        "  places     places and categories index for offline.places.index"));
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument(QStringLiteral("command"), QStringLiteral("Kind of data to build."));
+    parser.addPositionalArgument(QStringLiteral("input"), QStringLiteral("OpenStreetMap XML file, or JSON or CSV places dump."));
+    parser.addPositionalArgument(QStringLiteral("output"), QStringLiteral("File to write."));
+    parser.process(app);
+
+    const QStringList arguments = parser.positionalArguments();
+    if (arguments.size() != 3)
+        parser.showHelp(1);
+
+    const QString &command = arguments.at(0);
+    QString errorString;
+    bool ok = false;
+    if (command == QLatin1String("routing")) {
+        ok = buildRoutingGraph(arguments.at(1), arguments.at(2), &errorString);
+    } else if (command == QLatin1String("geocoding")) {
+        ok = buildGeocodingIndex(arguments.at(1), arguments.at(2), &errorString);
+    } else if (command == QLatin1String("places")) {
+        ok = buildPlacesIndex(arguments.at(1), arguments.at(2), &errorString);
+    } else {
+        errorString = QStringLiteral("Unknown command %1").arg(command);
+    }
+
+    if (!ok) {
+        QTextStream(stderr) << "qgeoofflinedata: " << errorString << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,107 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the tools applications of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "osmreader.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QXmlStreamReader>
+
+QT_BEGIN_NAMESPACE
+
+static void readChildren(QXmlStreamReader &xml, QHash<QString, QString> &tags,
+                         QVector<qint64> *nodes, QVector<OsmMember> *members)
+{
+    while (xml.readNextStartElement()) {
+        const QXmlStreamAttributes attributes = xml.attributes();
+        if (xml.name() == QLatin1String("tag")) {
+            tags.insert(attributes.value(QLatin1String("k")).toString(),
+                        attributes.value(QLatin1String("v")).toString());
+        } else if (nodes && xml.name() == QLatin1String("nd")) {
+            nodes->append(attributes.value(QLatin1String("ref")).toLongLong());
+        } else if (members && xml.name() == QLatin1String("member")) {
+            OsmMember member;
+            member.type = attributes.value(QLatin1String("type")).toString();
+            member.ref = attributes.value(QLatin1String("ref")).toLongLong();
+            member.role = attributes.value(QLatin1String("role")).toString();
+            members->append(member);
+        }
+        xml.skipCurrentElement();
+    }
+}
+
+bool OsmReader::read(const QString &fileName, QString *errorString)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        *errorString = file.errorString();
+        return false;
+    }
+
+    QXmlStreamReader xml(&file);
+    if (!xml.readNextStartElement() || xml.name() != QLatin1String("osm")) {
+        *errorString = QStringLiteral("%1 is not an OpenStreetMap XML file").arg(fileName);
+        return false;
+    }
+
+    while (xml.readNextStartElement()) {
+        const QXmlStreamAttributes attributes = xml.attributes();
+        if (xml.name() == QLatin1String("node")) {
+            OsmNode node;
+            node.id = attributes.value(QLatin1String("id")).toLongLong();
+            node.latitude = attributes.value(QLatin1String("lat")).toDouble();
+            node.longitude = attributes.value(QLatin1String("lon")).toDouble();
+            readChildren(xml, node.tags, nullptr, nullptr);
+            if (nodeHandler)
+                nodeHandler(node);
+        } else if (xml.name() == QLatin1String("way")) {
+            OsmWay way;
+            way.id = attributes.value(QLatin1String("id")).toLongLong();
+            readChildren(xml, way.tags, &way.nodes, nullptr);
+            if (wayHandler)
+                wayHandler(way);
+        } else if (xml.name() == QLatin1String("relation")) {
+            OsmRelation relation;
+            relation.id = attributes.value(QLatin1String("id")).toLongLong();
+            readChildren(xml, relation.tags, nullptr, &relation.members);
+            if (relationHandler)
+                relationHandler(relation);
+        } else {
+            xml.skipCurrentElement();
+        }
+    }
+
+    if (xml.hasError()) {
+        *errorString = QStringLiteral("%1:%2: %3").arg(fileName).arg(xml.lineNumber())
+                .arg(xml.errorString());
+        return false;
+    }
+    return true;
+}
+
+QT_END_NAMESPACE
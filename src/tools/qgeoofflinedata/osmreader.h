@@ -0,0 +1,85 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the tools applications of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef OSMREADER_H
+#define OSMREADER_H
+
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+struct OsmNode
+{
+    qint64 id = 0;
+    double latitude = 0.0;
+    double longitude = 0.0;
+    QHash<QString, QString> tags;
+};
+
+struct OsmWay
+{
+    qint64 id = 0;
+    QVector<qint64> nodes;
+    QHash<QString, QString> tags;
+};
+
+struct OsmMember
+{
+    QString type;
+    qint64 ref = 0;
+    QString role;
+};
+
+struct OsmRelation
+{
+    qint64 id = 0;
+    QVector<OsmMember> members;
+    QHash<QString, QString> tags;
+};
+
+// Streams the nodes, ways and relations of an OpenStreetMap XML file to the handlers.
+// Files written by the OSM tools list all nodes before the ways, and the ways
+// before the relations.
+class OsmReader
+{
+public:
+    std::function<void(const OsmNode &)> nodeHandler;
+    std::function<void(const OsmWay &)> wayHandler;
+    std::function<void(const OsmRelation &)> relationHandler;
+
+    bool read(const QString &fileName, QString *errorString);
+};
+
+QT_END_NAMESPACE
+
+#endif // OSMREADER_H
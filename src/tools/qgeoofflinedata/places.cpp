@@ -0,0 +1,224 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the tools applications of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "commands.h"
+
+#include <qplaceindex.h>
+
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTextStream>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+/*
+    JSON dumps hold an object with a "categories" and a "places" array, or
+    just the array of places:
+
+    {
+        "categories": [ { "id": "food", "name": "Food & Drink" },
+                        { "id": "pizza", "name": "Pizza", "parent": "food" } ],
+        "places": [ { "id": "p1", "name": "Luigi's", "latitude": 52.5, "longitude": 13.4,
+                      "categories": [ "pizza" ], "street": "Main Street 1", "city": "Berlin",
+                      "postalCode": "10115", "country": "Germany", "countryCode": "DEU",
+                      "phone": "+49 30 1234", "website": "https://luigis.example" } ]
+    }
+*/
+bool readJson(const QByteArray &data, QPlaceIndexWriter &writer, QString *errorString)
+{
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(data, &parseError);
+    if (document.isNull()) {
+        *errorString = parseError.errorString();
+        return false;
+    }
+
+    QJsonArray places = document.array();
+    if (document.isObject()) {
+        const QJsonObject root = document.object();
+        const QJsonArray categories = root.value(QLatin1String("categories")).toArray();
+        for (const QJsonValue &value : categories) {
+            const QJsonObject category = value.toObject();
+            writer.addCategory(category.value(QLatin1String("id")).toString(),
+                               category.value(QLatin1String("name")).toString(),
+                               category.value(QLatin1String("parent")).toString());
+        }
+        places = root.value(QLatin1String("places")).toArray();
+    }
+
+    for (const QJsonValue &value : qAsConst(places)) {
+        const QJsonObject object = value.toObject();
+        QPlaceIndexWriter::PlaceData place;
+        place.id = object.value(QLatin1String("id")).toString();
+        place.name = object.value(QLatin1String("name")).toString();
+        place.latitude = object.value(QLatin1String("latitude")).toDouble();
+        place.longitude = object.value(QLatin1String("longitude")).toDouble();
+        for (const QJsonValue &category : object.value(QLatin1String("categories")).toArray())
+            place.categories.append(category.toString());
+        place.street = object.value(QLatin1String("street")).toString();
+        place.city = object.value(QLatin1String("city")).toString();
+        place.postalCode = object.value(QLatin1String("postalCode")).toString();
+        place.country = object.value(QLatin1String("country")).toString();
+        place.countryCode = object.value(QLatin1String("countryCode")).toString();
+        place.phone = object.value(QLatin1String("phone")).toString();
+        place.website = object.value(QLatin1String("website")).toString();
+        if (place.id.isEmpty() || !object.contains(QLatin1String("latitude"))
+                || !object.contains(QLatin1String("longitude"))) {
+            continue;
+        }
+        writer.addPlace(place);
+    }
+    return true;
+}
+
+// Splits RFC 4180 CSV into records; quoted fields may contain separators and line breaks.
+QVector<QStringList> parseCsv(const QString &text)
+{
+    QVector<QStringList> records;
+    QStringList record;
+    QString field;
+    bool quoted = false;
+    for (int i = 0; i < text.size(); ++i) {
+        const QChar c = text.at(i);
+        if (quoted) {
+            if (c == QLatin1Char('"')) {
+                if (i + 1 < text.size() && text.at(i + 1) == QLatin1Char('"')) {
+                    field.append(c);
+                    ++i;
+                } else {
+                    quoted = false;
+                }
+            } else {
+                field.append(c);
+            }
+        } else if (c == QLatin1Char('"')) {
+            quoted = true;
+        } else if (c == QLatin1Char(',')) {
+            record.append(field);
+            field.clear();
+        } else if (c == QLatin1Char('\n') || c == QLatin1Char('\r')) {
+            if (c == QLatin1Char('\r') && i + 1 < text.size() && text.at(i + 1) == QLatin1Char('\n'))
+                ++i;
+            record.append(field);
+            field.clear();
+            records.append(record);
+            record.clear();
+        } else {
+            field.append(c);
+        }
+    }
+    if (!field.isEmpty() || !record.isEmpty()) {
+        record.append(field);
+        records.append(record);
+    }
+    return records;
+}
+
+/*
+    CSV dumps have a header row naming the columns, with the same names as
+    the keys of the JSON places. Categories are separated by semicolons and
+    are created as top level categories named after their identifiers.
+*/
+bool readCsv(const QByteArray &data, QPlaceIndexWriter &writer, QString *errorString)
+{
+    const QVector<QStringList> records = parseCsv(QString::fromUtf8(data));
+    if (records.isEmpty()) {
+        *errorString = QStringLiteral("The CSV file has no header row");
+        return false;
+    }
+
+    const QStringList header = records.first();
+    const QStringList required = { QStringLiteral("id"), QStringLiteral("latitude"),
+                                   QStringLiteral("longitude") };
+    for (const QString &column : required) {
+        if (!header.contains(column)) {
+            *errorString = QStringLiteral("The CSV file has no %1 column").arg(column);
+            return false;
+        }
+    }
+
+    for (int r = 1; r < records.size(); ++r) {
+        const QStringList &record = records.at(r);
+        auto field = [&](const char *name) {
+            const int column = header.indexOf(QLatin1String(name));
+            return column >= 0 && column < record.size() ? record.at(column).trimmed() : QString();
+        };
+
+        QPlaceIndexWriter::PlaceData place;
+        bool latitudeOk = false;
+        bool longitudeOk = false;
+        place.id = field("id");
+        place.name = field("name");
+        place.latitude = field("latitude").toDouble(&latitudeOk);
+        place.longitude = field("longitude").toDouble(&longitudeOk);
+        place.categories = field("categories").split(QLatin1Char(';'), QString::SkipEmptyParts);
+        place.street = field("street");
+        place.city = field("city");
+        place.postalCode = field("postalCode");
+        place.country = field("country");
+        place.countryCode = field("countryCode");
+        place.phone = field("phone");
+        place.website = field("website");
+        if (place.id.isEmpty() || !latitudeOk || !longitudeOk)
+            continue;
+        writer.addPlace(place);
+    }
+    return true;
+}
+
+} // namespace
+
+bool buildPlacesIndex(const QString &input, const QString &output, QString *errorString)
+{
+    QFile file(input);
+    if (!file.open(QIODevice::ReadOnly)) {
+        *errorString = file.errorString();
+        return false;
+    }
+    const QByteArray data = file.readAll();
+
+    QPlaceIndexWriter writer;
+    const bool csv = QFileInfo(input).suffix().compare(QLatin1String("csv"), Qt::CaseInsensitive) == 0;
+    if (!(csv ? readCsv(data, writer, errorString) : readJson(data, writer, errorString)))
+        return false;
+
+    if (!writer.write(output, errorString))
+        return false;
+
+    QTextStream(stdout) << "Wrote " << writer.placeCount() << " places and "
+                        << writer.categoryCount() << " categories to " << output << endl;
+    return true;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,26 @@
+QT = core
+
+OFFLINE_PLUGIN = $$PWD/../../plugins/geoservices/offline
+INCLUDEPATH += $$OFFLINE_PLUGIN
+
+HEADERS += \
+    commands.h \
+    osmreader.h \
+    $$OFFLINE_PLUGIN/qgeoroutegraph.h \
+    $$OFFLINE_PLUGIN/qgeotextindex.h \
+    $$OFFLINE_PLUGIN/qgeocodingindex.h \
+    $$OFFLINE_PLUGIN/qplaceindex.h
+
+SOURCES += \
+    main.cpp \
+    osmreader.cpp \
+    routing.cpp \
+    geocoding.cpp \
+    places.cpp \
+    $$OFFLINE_PLUGIN/qgeoroutegraph.cpp \
+    $$OFFLINE_PLUGIN/qgeotextindex.cpp \
+    $$OFFLINE_PLUGIN/qgeocodingindex.cpp \
+    $$OFFLINE_PLUGIN/qplaceindex.cpp
+
+QMAKE_TARGET_DESCRIPTION = "Qt Location Offline Data Builder"
+load(qt_tool)
@@ -0,0 +1,219 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the tools applications of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "commands.h"
+#include "osmreader.h"
+
+#include <qgeoroutegraph.h>
+
+#include <QtCore/QTextStream>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+enum {
+    Car = QGeoRouteGraph::CarAccess,
+    Bicycle = QGeoRouteGraph::BicycleAccess,
+    Pedestrian = QGeoRouteGraph::PedestrianAccess,
+    All = Car | Bicycle | Pedestrian
+};
+
+struct HighwayClass
+{
+    const char *highway;
+    int speed;  // km/h
+    int access;
+};
+
+const HighwayClass highwayClasses[] = {
+    { "motorway",       110, Car },
+    { "motorway_link",   60, Car },
+    { "trunk",           90, All },
+    { "trunk_link",      50, All },
+    { "primary",         70, All },
+    { "primary_link",    50, All },
+    { "secondary",       60, All },
+    { "secondary_link",  40, All },
+    { "tertiary",        50, All },
+    { "tertiary_link",   40, All },
+    { "unclassified",    40, All },
+    { "residential",     30, All },
+    { "road",            30, All },
+    { "living_street",   10, All },
+    { "service",         20, All },
+    { "track",           15, Bicycle | Pedestrian },
+    { "cycleway",        18, Bicycle | Pedestrian },
+    { "path",             5, Bicycle | Pedestrian },
+    { "bridleway",        5, Pedestrian },
+    { "footway",          5, Pedestrian },
+    { "pedestrian",       5, Pedestrian },
+    { "steps",            3, Pedestrian }
+};
+
+bool isYes(const QString &value)
+{
+    return value == QLatin1String("yes") || value == QLatin1String("true")
+            || value == QLatin1String("1") || value == QLatin1String("designated")
+            || value == QLatin1String("permissive");
+}
+
+bool isNo(const QString &value)
+{
+    return value == QLatin1String("no") || value == QLatin1String("false")
+            || value == QLatin1String("0") || value == QLatin1String("private");
+}
+
+void applyAccessTag(const OsmWay &way, const char *key, int mode, int &access)
+{
+    const QString value = way.tags.value(QLatin1String(key));
+    if (isNo(value))
+        access &= ~mode;
+    else if (isYes(value))
+        access |= mode;
+}
+
+// Parses "50", "50 km/h" and "30 mph", returns 0 for anything else.
+int maxSpeed(const QString &value)
+{
+    int i = 0;
+    while (i < value.size() && value.at(i).isDigit())
+        ++i;
+    const int speed = value.leftRef(i).toInt();
+    if (value.endsWith(QLatin1String("mph")))
+        return qRound(speed * 1.609344);
+    return speed;
+}
+
+} // namespace
+
+/*
+    Converts the routable ways of an OSM extract into a QGeoRouteGraph. Every
+    way node becomes a graph node and every pair of consecutive nodes becomes
+    up to two directed edges, so the geometry of the roads is preserved.
+*/
+bool buildRoutingGraph(const QString &input, const QString &output, QString *errorString)
+{
+    QHash<qint64, QGeoRouteGraph::Node> coordinates;
+    QHash<qint64, quint32> graphNodes;
+    QGeoRouteGraphWriter writer;
+    int wayCount = 0;
+
+    auto graphNode = [&](qint64 id) {
+        auto it = graphNodes.constFind(id);
+        if (it != graphNodes.constEnd())
+            return it.value();
+        const QGeoRouteGraph::Node &c = coordinates.value(id);
+        const quint32 node = writer.addNode(c.latitude * 1e-6, c.longitude * 1e-6);
+        graphNodes.insert(id, node);
+        return node;
+    };
+
+    OsmReader reader;
+    reader.nodeHandler = [&](const OsmNode &node) {
+        QGeoRouteGraph::Node c;
+        c.latitude = qint32(qRound64(node.latitude * 1e6));
+        c.longitude = qint32(qRound64(node.longitude * 1e6));
+        coordinates.insert(node.id, c);
+    };
+    reader.wayHandler = [&](const OsmWay &way) {
+        const QString highway = way.tags.value(QLatin1String("highway"));
+        if (highway.isEmpty() || way.nodes.size() < 2)
+            return;
+
+        const HighwayClass *highwayClass = nullptr;
+        for (const HighwayClass &c : highwayClasses) {
+            if (highway == QLatin1String(c.highway)) {
+                highwayClass = &c;
+                break;
+            }
+        }
+        if (!highwayClass)
+            return;
+
+        int access = highwayClass->access;
+        const QString generalAccess = way.tags.value(QLatin1String("access"));
+        if (isNo(generalAccess))
+            access = 0;
+        applyAccessTag(way, "motor_vehicle", Car, access);
+        applyAccessTag(way, "motorcar", Car, access);
+        applyAccessTag(way, "bicycle", Bicycle, access);
+        applyAccessTag(way, "foot", Pedestrian, access);
+        if (!access)
+            return;
+
+        int speed = maxSpeed(way.tags.value(QLatin1String("maxspeed")));
+        if (speed <= 0)
+            speed = highwayClass->speed;
+
+        // 1: only along the way, -1: only against it. Pedestrians may always walk both ways.
+        int oneway = 0;
+        const QString onewayTag = way.tags.value(QLatin1String("oneway"));
+        if (isYes(onewayTag))
+            oneway = 1;
+        else if (onewayTag == QLatin1String("-1") || onewayTag == QLatin1String("reverse"))
+            oneway = -1;
+        else if (onewayTag.isEmpty() && (highway == QLatin1String("motorway")
+                                         || way.tags.value(QLatin1String("junction")) == QLatin1String("roundabout")))
+            oneway = 1;
+        int onewayModes = Car | Bicycle;
+        if (isNo(way.tags.value(QLatin1String("oneway:bicycle"))))
+            onewayModes &= ~Bicycle;
+
+        const int forwardAccess = oneway == -1 ? access & ~onewayModes : access;
+        const int backwardAccess = oneway == 1 ? access & ~onewayModes : access;
+        const QString name = way.tags.value(QLatin1String("name"),
+                                            way.tags.value(QLatin1String("ref")));
+
+        for (int i = 1; i < way.nodes.size(); ++i) {
+            const qint64 from = way.nodes.at(i - 1);
+            const qint64 to = way.nodes.at(i);
+            if (from == to || !coordinates.contains(from) || !coordinates.contains(to))
+                continue;
+            const quint32 a = graphNode(from);
+            const quint32 b = graphNode(to);
+            if (forwardAccess)
+                writer.addEdge(a, b, forwardAccess, speed, name);
+            if (backwardAccess)
+                writer.addEdge(b, a, backwardAccess, speed, name);
+        }
+        ++wayCount;
+    };
+
+    if (!reader.read(input, errorString))
+        return false;
+    if (!writer.write(output, errorString))
+        return false;
+
+    QTextStream(stdout) << "Wrote " << writer.nodeCount() << " nodes and " << writer.edgeCount()
+                        << " edges from " << wayCount << " ways to " << output << endl;
+    return true;
+}
+
+QT_END_NAMESPACE
@@ -23,6 +23,7 @@ qtHaveModule(location) {
            qplacesearchresult \
            qplacesearchreply \
            qplacesearchsuggestionreply \
+           qplacejsonstreamreader \
            qplaceuser \
            qplacemanager \
            qplacemanager_nokia \
@@ -40,21 +41,36 @@ qtHaveModule(location) {
            qgeocameracapabilities\
            qgeocameradata \
            qgeocodereply \
+           qgeocodebatchreply \
            qgeocodingmanager \
            qgeomaneuver \
            qgeotiledmapscene \
+           qgeofiletilecachewriter \
+           qgeotileregiondownload \
+           qgeotilemetadata \
+           qgeotileretryscheduler \
+           qgeotilecomposition \
+           qgeotileresampler \
+           qconcurrentcache3q \
+           qgeosharedtileindex \
            qgeoroute \
            qgeoroutereply \
            qgeorouterequest \
            qgeoroutesegment \
+           qgeorouteprogresstracker \
            qgeoroutingmanager \
            qgeoroutingmanagerplugins \
            qgeoserviceprovider \
+           qgeoservicecache \
            qgeotiledmap \
+           qgeotilefetcher \
+           qgeotileproviderosm \
            qgeotilespec \
            qgeoroutexmlparser \
            maptype \
            nokia_services \
+           offline_services \
+           mvt_services \
            qgeocameratiles
 
     qtHaveModule(quick) {
@@ -77,9 +93,13 @@ SUBDIRS += \
            qgeopath \
            qgeopolygon \
            qgeocoordinate \
+           qgeogreatcircle \
            qgeolocation \
            qgeopositioninfo \
            qgeopositioninfosource \
+           qgeopositioninfosourcehub \
            qgeosatelliteinfo \
            qgeosatelliteinfosource \
-           qnmeapositioninfosource
+           qnmeapositioninfosource \
+           qnmeasatelliteinfosource \
+           qubxinfosource
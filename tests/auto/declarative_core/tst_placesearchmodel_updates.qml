@@ -0,0 +1,196 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+import QtQuick 2.0
+import QtTest 1.0
+import QtLocation 5.12
+
+TestCase {
+    id: testCase
+
+    name: "PlaceSearchModelUpdates"
+
+    Plugin {
+        id: streamingPlugin
+        name: "qmlgeo.test.plugin"
+        allowExperimental: true
+        parameters: [
+            PluginParameter { name: "initializePlaceData"; value: true },
+            PluginParameter { name: "streamSearchResults"; value: true }
+        ]
+    }
+
+    Plugin {
+        id: failingPlugin
+        name: "qmlgeo.test.plugin"
+        allowExperimental: true
+        parameters: [
+            PluginParameter { name: "initializePlaceData"; value: true },
+            PluginParameter { name: "streamSearchResults"; value: true },
+            PluginParameter { name: "failSearches"; value: true }
+        ]
+    }
+
+    Plugin {
+        id: favoritesPlugin
+        name: "qmlgeo.test.plugin"
+        allowExperimental: true
+    }
+
+    Place {
+        id: favorite
+        plugin: favoritesPlugin
+        name: "Sea View Hotel"
+    }
+
+    Component {
+        id: modelComponent
+
+        PlaceSearchModel {
+            property var rowCounts: []
+            property var statuses: []
+
+            onRowCountChanged: {
+                rowCounts.push(count);
+                statuses.push(status);
+            }
+        }
+    }
+
+    function test_incrementalRows() {
+        var testModel = modelComponent.createObject(testCase, { plugin: streamingPlugin });
+        var insertedSpy = Qt.createQmlObject('import QtTest 1.0; SignalSpy {}', testCase, "SignalSpy");
+        insertedSpy.target = testModel;
+        insertedSpy.signalName = "rowsInserted";
+
+        // Rows are added for each result as it arrives.
+        testModel.searchTerm = "view";
+        testModel.update();
+        tryCompare(testModel, "status", PlaceSearchModel.Ready);
+        compare(testModel.count, 2);
+        compare(testModel.rowCounts, [1, 2]);
+        compare(testModel.statuses, [PlaceSearchModel.Loading, PlaceSearchModel.Loading]);
+        compare(insertedSpy.count, 2);
+
+        // The rows of a new search replace the current ones once its first
+        // result arrives.
+        testModel.rowCounts = [];
+        testModel.statuses = [];
+        insertedSpy.clear();
+        testModel.update();
+        compare(testModel.count, 2);
+        tryCompare(testModel, "status", PlaceSearchModel.Ready);
+        compare(testModel.count, 2);
+        compare(testModel.rowCounts, [0, 1, 2]);
+        compare(testModel.statuses, [PlaceSearchModel.Loading, PlaceSearchModel.Loading,
+                                     PlaceSearchModel.Loading]);
+        compare(insertedSpy.count, 2);
+
+        insertedSpy.destroy();
+        testModel.destroy();
+    }
+
+    function test_discardOnError_data() {
+        return [
+            { tag: "replace", incremental: false },
+            { tag: "incremental", incremental: true }
+        ];
+    }
+
+    function test_discardOnError(data) {
+        var testModel = modelComponent.createObject(testCase, { plugin: failingPlugin,
+                                                                incremental: data.incremental });
+
+        // The rows of the results received before the error are removed.
+        testModel.searchTerm = "view";
+        testModel.update();
+        tryCompare(testModel, "status", PlaceSearchModel.Error);
+        compare(testModel.errorString(), "Connection closed");
+        compare(testModel.count, 0);
+        compare(testModel.rowCounts, [1, 2, 0]);
+
+        testModel.destroy();
+    }
+
+    function test_favorites() {
+        favorite.save();
+        tryCompare(favorite, "status", Place.Ready);
+        verify(favorite.placeId !== "");
+
+        var testModel = modelComponent.createObject(testCase, { plugin: streamingPlugin,
+                                                                favoritesPlugin: favoritesPlugin });
+
+        // The place of the first row is created while the search is still
+        // running, the one of the second row after the favorites have been
+        // matched.
+        testModel.rowCountChanged.connect(function() {
+            if (testModel.count === 1)
+                verify(testModel.data(0, "place"));
+        });
+
+        testModel.searchTerm = "view";
+        testModel.update();
+        tryCompare(testModel, "status", PlaceSearchModel.Ready);
+        compare(testModel.count, 2);
+
+        for (var i = 0; i < testModel.count; ++i) {
+            var place = testModel.data(i, "place");
+            if (place.name === favorite.name) {
+                verify(place.favorite);
+                compare(place.favorite.placeId, favorite.placeId);
+            } else {
+                compare(place.favorite, null);
+            }
+        }
+
+        testModel.destroy();
+    }
+
+    function test_lazyPlaces() {
+        var testModel = modelComponent.createObject(testCase, { plugin: streamingPlugin });
+
+        testModel.searchTerm = "view";
+        testModel.update();
+        tryCompare(testModel, "status", PlaceSearchModel.Ready);
+        compare(testModel.count, 2);
+
+        // The place of a row is created when it is first asked for, and the
+        // same one is returned after that.
+        for (var i = 0; i < testModel.count; ++i) {
+            var place = testModel.data(i, "place");
+            verify(place);
+            compare(place.name, testModel.data(i, "title"));
+            verify(testModel.data(i, "place") === place);
+            compare(testModel.data(i, "icon"), null);
+        }
+
+        compare(testModel.data(testModel.count, "place"), undefined);
+
+        testModel.destroy();
+    }
+}
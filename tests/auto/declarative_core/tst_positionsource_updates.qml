@@ -0,0 +1,123 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+import QtQuick 2.0
+import QtTest 1.0
+import QtPositioning 5.12
+
+TestCase {
+    id: testCase
+
+    name: "PositionSourceUpdates"
+
+    PositionSource { id: coalescingSource; name: "test.source"; updateInterval: 1000; coalesceUpdates: true }
+    SignalSpy { id: coalescingSpy; target: coalescingSource; signalName: "positionChanged" }
+    SignalSpy { id: coalescingCoordinateSpy; target: coalescingSource.position; signalName: "coordinateChanged" }
+
+    function test_coalescedUpdates() {
+        coalescingSpy.clear();
+        coalescingCoordinateSpy.clear();
+        compare(coalescingSource.coalesceUpdates, true);
+        compare(coalescingSource.maximumUpdateRate, 0);
+
+        coalescingSource.active = true;
+        tryCompare(coalescingSpy, "count", 1, 1500);
+        compare(coalescingCoordinateSpy.count, 1);
+        compare(coalescingSource.position.coordinate.longitude, 0.1);
+        tryCompare(coalescingSpy, "count", 2, 1500);
+        compare(coalescingCoordinateSpy.count, 2);
+        compare(coalescingSource.position.coordinate.longitude, 0.2);
+        coalescingSource.active = false;
+    }
+
+    PositionSource { id: throttledSource; name: "test.source"; updateInterval: 1000 }
+    SignalSpy { id: throttledSpy; target: throttledSource; signalName: "positionChanged" }
+
+    function test_maximumUpdateRate() {
+        throttledSpy.clear();
+        throttledSource.maximumUpdateRate = -1;
+        compare(throttledSource.maximumUpdateRate, 0);
+        throttledSource.maximumUpdateRate = 0.4;
+        compare(throttledSource.maximumUpdateRate, 0.4);
+
+        throttledSource.active = true;
+        tryCompare(throttledSpy, "count", 1, 1500);
+        // the second fix arrives a second later but must wait for the 2.5 s window
+        wait(1500);
+        compare(throttledSpy.count, 1);
+        // by then the third fix replaced it and is delivered once the window closes
+        tryCompare(throttledSpy, "count", 2, 1500);
+        fuzzyCompare(throttledSource.position.coordinate.longitude, 0.3, 0.0001);
+
+        // stopping delivers whatever is still pending
+        throttledSource.active = false;
+        throttledSource.maximumUpdateRate = 0;
+    }
+
+    PositionSource { id: notifyingSource; name: "test.source"; updateInterval: 1000 }
+    SignalSpy { id: notifyingSpy; target: notifyingSource; signalName: "positionChanged" }
+    SignalSpy { id: propertiesSpy; target: notifyingSource.position; signalName: "propertiesChanged" }
+    SignalSpy { id: coordinateSpy; target: notifyingSource.position; signalName: "coordinateChanged" }
+    SignalSpy { id: variationSpy; target: notifyingSource.position; signalName: "magneticVariationChanged" }
+
+    function test_propertiesChanged() {
+        notifyingSpy.clear();
+        propertiesSpy.clear();
+        coordinateSpy.clear();
+        variationSpy.clear();
+
+        // one notification per update, saying what changed
+        notifyingSource.active = true;
+        tryCompare(notifyingSpy, "count", 1, 1500);
+        compare(propertiesSpy.count, 1);
+        var properties = propertiesSpy.signalArguments[0][0];
+        verify(properties & Position.Coordinate);
+        verify(properties & Position.Timestamp);
+        verify(!(properties & Position.MagneticVariation));
+        // only the properties that changed notify their bindings
+        compare(coordinateSpy.count, 1);
+        compare(variationSpy.count, 0);
+        notifyingSource.active = false;
+    }
+
+    PositionSource { id: slowSource; name: "test.source"; updateInterval: 1000 }
+    SignalSpy { id: slowSpy; target: slowSource; signalName: "positionChanged" }
+
+    function test_tinyMaximumUpdateRate() {
+        slowSpy.clear();
+        slowSource.maximumUpdateRate = 1e-9;
+
+        // the first fix goes through, the next ones wait for the (bounded) window
+        slowSource.active = true;
+        tryCompare(slowSpy, "count", 1, 1500);
+        wait(1500);
+        compare(slowSpy.count, 1);
+        slowSource.maximumUpdateRate = 0;
+        slowSource.active = false;
+    }
+}
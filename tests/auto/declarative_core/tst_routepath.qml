@@ -0,0 +1,74 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+import QtQuick 2.0
+import QtTest 1.0
+import QtLocation 5.12
+import QtPositioning 5.12
+
+TestCase {
+    id: testCase
+
+    name: "RoutePath"
+
+    Route { id: emptyRoute }
+    Route { id: pathRoute }
+
+    function test_empty() {
+        compare(emptyRoute.pathModel.length, 0)
+        verify(!emptyRoute.pathModel.at(0).isValid)
+    }
+
+    function test_pathModel() {
+        var pathModel = pathRoute.pathModel
+        compare(pathModel.length, 0)
+        pathRoute.path = [ QtPositioning.coordinate(1, 1), QtPositioning.coordinate(2, 2),
+                           QtPositioning.coordinate(3, 3), QtPositioning.coordinate(4, 4) ]
+        compare(pathRoute.pathModel, pathModel)
+        compare(pathModel.length, 4)
+        compare(pathModel.at(0).latitude, 1)
+        compare(pathModel.at(3).longitude, 4)
+        verify(!pathModel.at(4).isValid)
+        verify(!pathModel.at(-1).isValid)
+
+        var tail = pathModel.slice(1)
+        compare(tail.length, 3)
+        compare(tail.at(0).latitude, 2)
+        var middle = pathModel.slice(1, -1)
+        compare(middle.length, 2)
+        compare(middle.at(1).latitude, 3)
+        compare(middle.slice(1).at(0).latitude, 3)
+        compare(pathModel.slice(3, 1).length, 0)
+
+        // Slices keep the coordinates they were taken from.
+        pathRoute.path = [ QtPositioning.coordinate(5, 5) ]
+        compare(pathModel.length, 1)
+        compare(pathModel.at(0).latitude, 5)
+        compare(tail.length, 3)
+    }
+}
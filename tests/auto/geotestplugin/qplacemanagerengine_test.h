@@ -45,6 +45,8 @@
 #include <QtLocation/QPlaceEditorial>
 #include <QtLocation/QPlaceIdReply>
 #include <QtLocation/QPlaceImage>
+#include <QtLocation/QPlaceMatchReply>
+#include <QtLocation/QPlaceMatchRequest>
 #include <QtLocation/QPlaceSearchSuggestionReply>
 #include <QtLocation/QPlaceSearchReply>
 #include <QtLocation/QPlaceResult>
@@ -190,11 +192,56 @@ public:
         setResults(results);
     }
 
+    // Publishes the results one at a time before the reply finishes, like a
+    // plugin that parses its response while it is being received.
+    void streamResults()
+    {
+        m_pendingResults = results();
+        setResults(QList<QPlaceSearchResult>());
+        for (int i = 0; i < m_pendingResults.count(); ++i)
+            QMetaObject::invokeMethod(this, "emitContentUpdated", Qt::QueuedConnection);
+    }
+
+    Q_INVOKABLE void emitContentUpdated()
+    {
+        QList<QPlaceSearchResult> received = results();
+        received.append(m_pendingResults.takeFirst());
+        setResults(received);
+        emit contentUpdated();
+    }
+
+    Q_INVOKABLE void emitCommunicationError()
+    {
+        setError(QPlaceReply::CommunicationError, QStringLiteral("Connection closed"));
+        emitError();
+    }
+
     Q_INVOKABLE void emitError()
     {
         emit error(error(), errorString());
     }
 
+    Q_INVOKABLE void emitFinished()
+    {
+        emit finished();
+    }
+
+private:
+    QList<QPlaceSearchResult> m_pendingResults;
+};
+
+class MatchReply : public QPlaceMatchReply
+{
+    Q_OBJECT
+
+    friend class QPlaceManagerEngineTest;
+
+public:
+    MatchReply(QObject *parent = 0)
+    :   QPlaceMatchReply(parent)
+    {
+    }
+
     Q_INVOKABLE void emitFinished()
     {
         emit finished();
@@ -230,6 +277,8 @@ public:
     QPlaceManagerEngineTest(const QVariantMap &parameters)
         : QPlaceManagerEngine(parameters)
     {
+        m_streamSearchResults = parameters.value(QStringLiteral("streamSearchResults"), false).toBool();
+        m_failSearches = parameters.value(QStringLiteral("failSearches"), false).toBool();
         m_locales << QLocale();
         if (parameters.value(QStringLiteral("initializePlaceData"), false).toBool()) {
             QFile placeData(QFINDTESTDATA("place_data.json"));
@@ -498,6 +547,35 @@ public:
 
         PlaceSearchReply *reply = new PlaceSearchReply(results, this);
 
+        if (m_streamSearchResults)
+            reply->streamResults();
+        if (m_failSearches)
+            QMetaObject::invokeMethod(reply, "emitCommunicationError", Qt::QueuedConnection);
+        QMetaObject::invokeMethod(reply, "emitFinished", Qt::QueuedConnection);
+
+        return reply;
+    }
+
+    QPlaceMatchReply *matchingPlaces(const QPlaceMatchRequest &request) override
+    {
+        MatchReply *reply = new MatchReply(this);
+        reply->setRequest(request);
+
+        // Places of other managers are matched by name, they do not share
+        // their ids with the places saved here.
+        QList<QPlace> places;
+        foreach (const QPlace &place, request.places()) {
+            QPlace match;
+            foreach (const QPlace &candidate, m_places) {
+                if (candidate.name() == place.name()) {
+                    match = candidate;
+                    break;
+                }
+            }
+            places.append(match);
+        }
+        reply->setPlaces(places);
+
         QMetaObject::invokeMethod(reply, "emitFinished", Qt::QueuedConnection);
 
         return reply;
@@ -719,6 +797,8 @@ public:
     }
 
 private:
+    bool m_streamSearchResults;
+    bool m_failSearches;
     QList<QLocale> m_locales;
     QHash<QString, QPlace> m_places;
     QHash<QString, QPlaceCategory> m_categories;
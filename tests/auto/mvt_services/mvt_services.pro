@@ -0,0 +1,14 @@
+TEMPLATE = app
+CONFIG += testcase
+TARGET = tst_mvt_services
+
+QT += location gui testlib
+INCLUDEPATH += $$PWD/../../../src/plugins/geoservices/mvt
+
+HEADERS += $$PWD/../../../src/plugins/geoservices/mvt/qgeomvttile.h \
+           $$PWD/../../../src/plugins/geoservices/mvt/qgeomvtstyle.h \
+           $$PWD/../../../src/plugins/geoservices/mvt/qgeomvtrenderer.h
+SOURCES += tst_mvt_services.cpp \
+           $$PWD/../../../src/plugins/geoservices/mvt/qgeomvttile.cpp \
+           $$PWD/../../../src/plugins/geoservices/mvt/qgeomvtstyle.cpp \
+           $$PWD/../../../src/plugins/geoservices/mvt/qgeomvtrenderer.cpp
@@ -0,0 +1,388 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtGui/QImage>
+
+#include "qgeomvttile.h"
+#include "qgeomvtstyle.h"
+#include "qgeomvtrenderer.h"
+
+QT_USE_NAMESPACE
+
+// Encodes the parts of the Mapbox Vector Tile format the tests use.
+static void appendVarint(QByteArray *out, quint64 value)
+{
+    while (value >= 0x80) {
+        out->append(char((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out->append(char(value));
+}
+
+static void appendKey(QByteArray *out, int field, int wireType)
+{
+    appendVarint(out, quint64(field) << 3 | quint64(wireType));
+}
+
+static void appendBytes(QByteArray *out, int field, const QByteArray &bytes)
+{
+    appendKey(out, field, 2);
+    appendVarint(out, quint64(bytes.size()));
+    out->append(bytes);
+}
+
+static void appendPacked(QByteArray *out, int field, const QVector<quint32> &values)
+{
+    QByteArray packed;
+    for (quint32 value : values)
+        appendVarint(&packed, value);
+    appendBytes(out, field, packed);
+}
+
+static quint32 zigzag(qint32 value)
+{
+    return quint32((value << 1) ^ (value >> 31));
+}
+
+static quint32 command(int id, int count)
+{
+    return quint32(count << 3 | id);
+}
+
+// A square polygon covering x from x0 to x1 and the whole height of the tile.
+static QVector<quint32> band(qint32 x0, qint32 x1, qint32 extent = 4096)
+{
+    return QVector<quint32>() << command(1, 1) << zigzag(x0) << zigzag(0)
+                              << command(2, 3) << zigzag(x1 - x0) << zigzag(0)
+                              << zigzag(0) << zigzag(extent)
+                              << zigzag(x0 - x1) << zigzag(0)
+                              << command(7, 1);
+}
+
+static QByteArray feature(int type, const QVector<quint32> &tags, const QVector<quint32> &geometry,
+                          quint64 id = 0)
+{
+    QByteArray out;
+    if (id) {
+        appendKey(&out, 1, 0);
+        appendVarint(&out, id);
+    }
+    if (!tags.isEmpty())
+        appendPacked(&out, 2, tags);
+    appendKey(&out, 3, 0);
+    appendVarint(&out, quint64(type));
+    appendPacked(&out, 4, geometry);
+    return out;
+}
+
+static QByteArray stringValue(const QString &value)
+{
+    QByteArray out;
+    appendBytes(&out, 1, value.toUtf8());
+    return out;
+}
+
+static QByteArray layer(const QString &name, const QStringList &keys,
+                        const QList<QByteArray> &values, const QList<QByteArray> &features)
+{
+    QByteArray out;
+    appendKey(&out, 15, 0);
+    appendVarint(&out, 2);
+    appendBytes(&out, 1, name.toUtf8());
+    for (const QByteArray &f : features)
+        appendBytes(&out, 2, f);
+    for (const QString &key : keys)
+        appendBytes(&out, 3, key.toUtf8());
+    for (const QByteArray &value : values)
+        appendBytes(&out, 4, value);
+    appendKey(&out, 5, 0);
+    appendVarint(&out, 4096);
+    return out;
+}
+
+static QByteArray tile(const QList<QByteArray> &layers)
+{
+    QByteArray out;
+    for (const QByteArray &l : layers)
+        appendBytes(&out, 3, l);
+    return out;
+}
+
+// A lake on the left half of the tile and a reservoir on the right half.
+static QByteArray waterTile()
+{
+    return tile(QList<QByteArray>()
+                << layer(QStringLiteral("water"), QStringList() << QStringLiteral("class"),
+                         QList<QByteArray>() << stringValue(QStringLiteral("lake"))
+                                             << stringValue(QStringLiteral("reservoir")),
+                         QList<QByteArray>()
+                         << feature(3, QVector<quint32>() << 0 << 0, band(0, 2048), 7)
+                         << feature(3, QVector<quint32>() << 0 << 1, band(2048, 4096))));
+}
+
+static const char waterStyle[] =
+    "{ \"background\": \"#f2efe9\","
+    "  \"layers\": [ { \"source-layer\": \"water\", \"type\": \"fill\", \"color\": \"#0000ff\","
+    "                  \"minzoom\": 4, \"filter\": { \"class\": [\"lake\"] } } ] }";
+
+class tst_MvtServices : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void decode();
+    void decodeValues();
+    void decodeMalformed_data();
+    void decodeMalformed();
+    void styleFunction();
+    void styleLoad();
+    void styleFilter();
+    void render();
+    void renderPixelRatio();
+};
+
+void tst_MvtServices::decode()
+{
+    QGeoMvtTile tile;
+    QString errorString;
+    QVERIFY2(tile.decode(waterTile(), &errorString), qPrintable(errorString));
+
+    QCOMPARE(tile.layers.size(), 1);
+    const QGeoMvtLayer *water = tile.layer(QStringLiteral("water"));
+    QVERIFY(water);
+    QVERIFY(!tile.layer(QStringLiteral("building")));
+    QCOMPARE(water->extent, quint32(4096));
+    QCOMPARE(water->features.size(), 2);
+
+    const QGeoMvtFeature &lake = water->features.at(0);
+    QCOMPARE(lake.id, quint64(7));
+    QCOMPARE(lake.type, QGeoMvtFeature::Polygon);
+    QCOMPARE(water->property(lake, QStringLiteral("class")).toString(), QStringLiteral("lake"));
+    QCOMPARE(water->property(water->features.at(1), QStringLiteral("class")).toString(),
+             QStringLiteral("reservoir"));
+    QVERIFY(!water->property(lake, QStringLiteral("name")).isValid());
+
+    const QRectF bounds = lake.path(256.0 / 4096).boundingRect();
+    QCOMPARE(bounds, QRectF(0, 0, 128, 256));
+}
+
+void tst_MvtServices::decodeValues()
+{
+    QByteArray intValue;
+    appendKey(&intValue, 4, 0);
+    appendVarint(&intValue, 42);
+    QByteArray sintValue;
+    appendKey(&sintValue, 6, 0);
+    appendVarint(&sintValue, zigzag(-3));
+    QByteArray boolValue;
+    appendKey(&boolValue, 7, 0);
+    appendVarint(&boolValue, 1);
+    QByteArray doubleValue;
+    appendKey(&doubleValue, 3, 1);
+    const double d = 2.5;
+    doubleValue.append(reinterpret_cast<const char *>(&d), sizeof(d));   // little endian hosts only
+
+    const QVector<quint32> tags = QVector<quint32>() << 0 << 0 << 1 << 1 << 2 << 2 << 3 << 3;
+    const QVector<quint32> point = QVector<quint32>() << command(1, 1) << zigzag(100) << zigzag(200);
+    const QByteArray data = tile(QList<QByteArray>()
+        << layer(QStringLiteral("poi"),
+                 QStringList() << QStringLiteral("rank") << QStringLiteral("level")
+                               << QStringLiteral("open") << QStringLiteral("height"),
+                 QList<QByteArray>() << intValue << sintValue << boolValue << doubleValue,
+                 QList<QByteArray>() << feature(1, tags, point)));
+
+    QGeoMvtTile tile;
+    QVERIFY(tile.decode(data));
+    const QGeoMvtLayer *poi = tile.layer(QStringLiteral("poi"));
+    QVERIFY(poi);
+    const QGeoMvtFeature &f = poi->features.at(0);
+    QCOMPARE(poi->property(f, QStringLiteral("rank")).toLongLong(), qint64(42));
+    QCOMPARE(poi->property(f, QStringLiteral("level")).toLongLong(), qint64(-3));
+    QCOMPARE(poi->property(f, QStringLiteral("open")).toBool(), true);
+    if (QSysInfo::ByteOrder == QSysInfo::LittleEndian)
+        QCOMPARE(poi->property(f, QStringLiteral("height")).toDouble(), 2.5);
+
+    const QVector<QPointF> points = f.points(0.5);
+    QCOMPARE(points.size(), 1);
+    QCOMPARE(points.at(0), QPointF(50, 100));
+}
+
+void tst_MvtServices::decodeMalformed_data()
+{
+    QTest::addColumn<QByteArray>("data");
+
+    const QByteArray valid = waterTile();
+    QTest::newRow("truncated") << valid.left(valid.size() - 5);
+
+    QByteArray oversized;
+    appendKey(&oversized, 3, 2);
+    appendVarint(&oversized, 1000);
+    oversized.append("abc");
+    QTest::newRow("length past the end") << oversized;
+
+    QByteArray badWireType;
+    appendKey(&badWireType, 3, 2);
+    appendVarint(&badWireType, 1);
+    appendKey(&badWireType, 9, 3);
+    QTest::newRow("unknown wire type") << badWireType;
+
+    QByteArray zeroExtent;
+    appendKey(&zeroExtent, 5, 0);
+    appendVarint(&zeroExtent, 0);
+    QByteArray layerData;
+    appendBytes(&layerData, 3, zeroExtent);
+    QTest::newRow("zero extent") << layerData;
+
+    QTest::newRow("unterminated varint") << QByteArray("\x1a\xff", 2);
+}
+
+void tst_MvtServices::decodeMalformed()
+{
+    QFETCH(QByteArray, data);
+
+    QGeoMvtTile tile;
+    QString errorString;
+    QVERIFY(!tile.decode(data, &errorString));
+    QVERIFY(!errorString.isEmpty());
+    QVERIFY(tile.layers.isEmpty());
+}
+
+void tst_MvtServices::styleFunction()
+{
+    QGeoMvtStyle::Function constant(3);
+    QCOMPARE(constant.at(0), 3.0);
+    QCOMPARE(constant.at(20), 3.0);
+
+    QGeoMvtStyle::Function stops;
+    stops.stops = QVector<QPointF>() << QPointF(4, 1) << QPointF(14, 6);
+    QCOMPARE(stops.at(2), 1.0);
+    QCOMPARE(stops.at(4), 1.0);
+    QCOMPARE(stops.at(9), 3.5);
+    QCOMPARE(stops.at(14), 6.0);
+    QCOMPARE(stops.at(18), 6.0);
+}
+
+void tst_MvtServices::styleLoad()
+{
+    QGeoMvtStyle style;
+    QString errorString;
+    QVERIFY2(style.load(QByteArray(
+        "{ \"background\": \"#112233\","
+        "  \"layers\": ["
+        "    { \"source-layer\": \"roads\", \"type\": \"line\", \"color\": \"#ff0000\","
+        "      \"minzoom\": 5, \"maxzoom\": 12, \"dash\": [2, 1],"
+        "      \"width\": { \"stops\": [[5, 1], [10, 3]] } },"
+        "    { \"source-layer\": \"place\", \"type\": \"symbol\", \"text-field\": \"name\" }"
+        "  ] }"), &errorString), qPrintable(errorString));
+
+    QCOMPARE(style.background, QColor(QStringLiteral("#112233")));
+    QCOMPARE(style.layers.size(), 2);
+
+    const QGeoMvtStyle::Layer &roads = style.layers.at(0);
+    QCOMPARE(roads.type, QGeoMvtStyle::Layer::Line);
+    QCOMPARE(roads.sourceLayer, QStringLiteral("roads"));
+    QCOMPARE(roads.color, QColor(Qt::red));
+    QCOMPARE(roads.dashes, QVector<qreal>() << 2 << 1);
+    QCOMPARE(roads.width.at(7.5), 2.0);
+    QVERIFY(!roads.isVisible(4));
+    QVERIFY(roads.isVisible(5));
+    QVERIFY(roads.isVisible(12));
+    QVERIFY(!roads.isVisible(13));
+
+    const QGeoMvtStyle::Layer &place = style.layers.at(1);
+    QCOMPARE(place.type, QGeoMvtStyle::Layer::Symbol);
+    QCOMPARE(place.textField, QStringLiteral("name"));
+    QCOMPARE(place.textSize.at(10), 12.0);
+
+    QVERIFY(!style.load(QByteArray("{ \"layers\": [ { \"type\": \"raster\" } ] }"), &errorString));
+    QVERIFY(!errorString.isEmpty());
+    QVERIFY(!style.load(QByteArray("not json"), &errorString));
+}
+
+void tst_MvtServices::styleFilter()
+{
+    QGeoMvtTile tile;
+    QVERIFY(tile.decode(waterTile()));
+    const QGeoMvtLayer *water = tile.layer(QStringLiteral("water"));
+    QVERIFY(water);
+
+    QGeoMvtStyle::Layer layer;
+    QVERIFY(layer.matches(*water, water->features.at(0)));
+
+    layer.filter.insert(QStringLiteral("class"), QVariantList() << QStringLiteral("lake"));
+    QVERIFY(layer.matches(*water, water->features.at(0)));
+    QVERIFY(!layer.matches(*water, water->features.at(1)));
+
+    layer.filter.insert(QStringLiteral("$type"), QVariantList() << QStringLiteral("LineString"));
+    QVERIFY(!layer.matches(*water, water->features.at(0)));
+    layer.filter.insert(QStringLiteral("$type"), QVariantList() << QStringLiteral("Polygon"));
+    QVERIFY(layer.matches(*water, water->features.at(0)));
+
+    layer.filter.insert(QStringLiteral("name"), QVariantList() << QStringLiteral("Lake Tahoe"));
+    QVERIFY(!layer.matches(*water, water->features.at(0)));
+}
+
+void tst_MvtServices::render()
+{
+    QGeoMvtStyle style;
+    QVERIFY(style.load(QByteArray(waterStyle)));
+    const QGeoMvtRenderer renderer(style, 256);
+
+    QString errorString;
+    const QImage image = renderer.render(waterTile(), 10, &errorString);
+    QVERIFY2(!image.isNull(), qPrintable(errorString));
+    QCOMPARE(image.size(), QSize(256, 256));
+
+    // The lake is filled, the reservoir is filtered out.
+    QCOMPARE(QColor(image.pixel(32, 128)), QColor(Qt::blue));
+    QCOMPARE(QColor(image.pixel(224, 128)), QColor(QStringLiteral("#f2efe9")));
+
+    // Below the minimum zoom level of the layer only the background is drawn.
+    const QImage zoomedOut = renderer.render(waterTile(), 3);
+    QCOMPARE(QColor(zoomedOut.pixel(32, 128)), QColor(QStringLiteral("#f2efe9")));
+
+    QVERIFY(renderer.render(QByteArray("\x1a\x7f", 2), 10, &errorString).isNull());
+    QVERIFY(!errorString.isEmpty());
+}
+
+void tst_MvtServices::renderPixelRatio()
+{
+    QGeoMvtStyle style;
+    QVERIFY(style.load(QByteArray(waterStyle)));
+    const QGeoMvtRenderer renderer(style, 256, 2.0);
+
+    const QImage image = renderer.render(waterTile(), 10);
+    QCOMPARE(image.size(), QSize(512, 512));
+    QCOMPARE(QColor(image.pixel(250, 256)), QColor(Qt::blue));
+    QCOMPARE(QColor(image.pixel(262, 256)), QColor(QStringLiteral("#f2efe9")));
+}
+
+QTEST_MAIN(tst_MvtServices)
+
+#include "tst_mvt_services.moc"
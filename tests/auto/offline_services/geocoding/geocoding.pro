@@ -0,0 +1,12 @@
+TEMPLATE = app
+CONFIG += testcase
+TARGET = tst_offline_geocoding
+
+QT += location testlib
+INCLUDEPATH += $$PWD/../../../../src/plugins/geoservices/offline
+
+HEADERS += $$PWD/../../../../src/plugins/geoservices/offline/qgeotextindex.h \
+           $$PWD/../../../../src/plugins/geoservices/offline/qgeocodingindex.h
+SOURCES += tst_geocoding.cpp \
+           $$PWD/../../../../src/plugins/geoservices/offline/qgeotextindex.cpp \
+           $$PWD/../../../../src/plugins/geoservices/offline/qgeocodingindex.cpp
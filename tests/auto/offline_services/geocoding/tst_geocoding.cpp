@@ -0,0 +1,262 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <qgeocodingindex.h>
+
+#include <QtTest/QtTest>
+#include <QtCore/QTemporaryDir>
+#include <QtLocation/QGeoCodeReply>
+#include <QtLocation/QGeoCodingManager>
+#include <QtLocation/QGeoServiceProvider>
+#include <QtPositioning/QGeoAddress>
+#include <QtPositioning/QGeoLocation>
+#include <QtPositioning/QGeoRectangle>
+
+QT_USE_NAMESPACE
+
+/*
+    Test data: a 20 x 20 grid of addresses, 50 m apart, with one street per
+    row. The grid lies in the city of Springfield, which has a hole in the
+    middle, and the city in the country of Testland. The south-west corner
+    of the city is the Old Town district.
+*/
+static const char *const streets[] = {
+    "Alder", "Birch", "Cedar", "Dogwood", "Elm", "Fir", "Ginkgo", "Hazel", "Ironwood", "Juniper",
+    "Kapok", "Larch", "Maple", "Nutmeg", "Oak", "Pine", "Quince", "Rowan", "Spruce", "Teak"
+};
+
+static QGeoCoordinate gridCoordinate(int row, int column)
+{
+    return QGeoCoordinate(0.0003 + row * 0.0005, 0.0003 + column * 0.0005);
+}
+
+static QGeoCodingIndexWriter::Ring square(double south, double west, double north, double east)
+{
+    QGeoCodingIndexWriter::Ring ring;
+    for (const QPointF &p : { QPointF(west, south), QPointF(east, south),
+                              QPointF(east, north), QPointF(west, north) }) {
+        QGeoCodingIndex::Point point;
+        point.latitude = qint32(qRound64(p.y() * 1e6));
+        point.longitude = qint32(qRound64(p.x() * 1e6));
+        ring.append(point);
+    }
+    return ring;
+}
+
+class tst_offline_geocoding : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void missingIndex();
+    void reverseGeocodeAddress();
+    void reverseGeocodeHole();
+    void reverseGeocodeAreaOnly();
+    void reverseGeocodeNothing();
+    void geocodeText();
+    void geocodePrefix();
+    void geocodeDiacritics();
+    void geocodeLimitOffset();
+    void geocodeBounds();
+    void geocodeAddress();
+
+private:
+    QList<QGeoLocation> wait(QGeoCodeReply *reply);
+
+    QTemporaryDir m_dir;
+    QGeoServiceProvider *m_provider = nullptr;
+    QGeoCodingManager *m_geocodingManager = nullptr;
+};
+
+void tst_offline_geocoding::initTestCase()
+{
+    QVERIFY(QGeoServiceProvider::availableServiceProviders().contains(QStringLiteral("offline")));
+    QVERIFY(m_dir.isValid());
+
+    QGeoCodingIndexWriter writer;
+    for (int row = 0; row < 20; ++row) {
+        for (int column = 0; column < 20; ++column) {
+            const QGeoCoordinate c = gridCoordinate(row, column);
+            writer.addAddress(c.latitude(), c.longitude(),
+                              QString::fromLatin1(streets[row]) + QStringLiteral(" Street"),
+                              QString::number(column + 1), QString(), QString());
+        }
+    }
+    writer.addAddress(0.02, 0.02, QString::fromUtf8("K\xc3\xb6nigsallee"), QStringLiteral("1"),
+                      QStringLiteral("40212"), QStringLiteral("D\xc3\xbcsseldorf"));
+
+    writer.addArea(2, QStringLiteral("Testland"), QStringLiteral("TST"),
+                   { square(-1.0, -1.0, 1.0, 1.0) });
+    writer.addArea(8, QStringLiteral("Springfield"), QString(),
+                   { square(0.0, 0.0, 0.01, 0.01), square(0.004, 0.004, 0.006, 0.006) });
+    writer.addArea(10, QStringLiteral("Old Town"), QString(),
+                   { square(0.0, 0.0, 0.002, 0.002) });
+
+    const QString fileName = m_dir.filePath(QStringLiteral("test.index"));
+    QString errorString;
+    QVERIFY2(writer.write(fileName, &errorString), qPrintable(errorString));
+
+    QVariantMap parameters;
+    parameters.insert(QStringLiteral("offline.geocoding.index"), fileName);
+    m_provider = new QGeoServiceProvider(QStringLiteral("offline"), parameters);
+    m_geocodingManager = m_provider->geocodingManager();
+    QVERIFY2(m_geocodingManager, qPrintable(m_provider->errorString()));
+}
+
+void tst_offline_geocoding::cleanupTestCase()
+{
+    delete m_provider;
+}
+
+QList<QGeoLocation> tst_offline_geocoding::wait(QGeoCodeReply *reply)
+{
+    QScopedPointer<QGeoCodeReply> guard(reply);
+    if (!QTest::qWaitFor([reply]() { return reply->isFinished(); }, 5000)) {
+        qWarning("Geocode reply did not finish");
+        return QList<QGeoLocation>();
+    }
+    if (reply->error() != QGeoCodeReply::NoError)
+        qWarning() << reply->errorString();
+    return reply->locations();
+}
+
+void tst_offline_geocoding::missingIndex()
+{
+    QGeoServiceProvider provider(QStringLiteral("offline"));
+    QVERIFY(!provider.geocodingManager());
+    QCOMPARE(provider.error(), QGeoServiceProvider::MissingRequiredParameterError);
+}
+
+void tst_offline_geocoding::reverseGeocodeAddress()
+{
+    const QGeoCoordinate expected = gridCoordinate(2, 2);
+    const QList<QGeoLocation> locations = wait(m_geocodingManager->reverseGeocode(
+            QGeoCoordinate(expected.latitude() + 0.0001, expected.longitude() - 0.00005)));
+    QCOMPARE(locations.size(), 1);
+
+    const QGeoLocation &location = locations.first();
+    QCOMPARE(location.coordinate(), expected);
+    QCOMPARE(location.address().street(), QStringLiteral("3 Cedar Street"));
+    QCOMPARE(location.address().district(), QStringLiteral("Old Town"));
+    QCOMPARE(location.address().city(), QStringLiteral("Springfield"));
+    QCOMPARE(location.address().country(), QStringLiteral("Testland"));
+    QCOMPARE(location.address().countryCode(), QStringLiteral("TST"));
+}
+
+void tst_offline_geocoding::reverseGeocodeHole()
+{
+    const QList<QGeoLocation> locations = wait(m_geocodingManager->reverseGeocode(gridCoordinate(9, 9)));
+    QCOMPARE(locations.size(), 1);
+    QCOMPARE(locations.first().address().street(), QStringLiteral("10 Juniper Street"));
+    QVERIFY(locations.first().address().city().isEmpty());
+    QCOMPARE(locations.first().address().country(), QStringLiteral("Testland"));
+}
+
+void tst_offline_geocoding::reverseGeocodeAreaOnly()
+{
+    const QGeoCoordinate coordinate(0.5, 0.5);
+    const QList<QGeoLocation> locations = wait(m_geocodingManager->reverseGeocode(coordinate));
+    QCOMPARE(locations.size(), 1);
+    QCOMPARE(locations.first().coordinate(), coordinate);
+    QVERIFY(locations.first().address().street().isEmpty());
+    QCOMPARE(locations.first().address().country(), QStringLiteral("Testland"));
+}
+
+void tst_offline_geocoding::reverseGeocodeNothing()
+{
+    QVERIFY(wait(m_geocodingManager->reverseGeocode(QGeoCoordinate(5.0, 5.0))).isEmpty());
+}
+
+void tst_offline_geocoding::geocodeText()
+{
+    const QList<QGeoLocation> locations = wait(m_geocodingManager->geocode(QStringLiteral("Maple Street 12"), 1));
+    QCOMPARE(locations.size(), 1);
+    QCOMPARE(locations.first().address().street(), QStringLiteral("12 Maple Street"));
+    QCOMPARE(locations.first().coordinate(), gridCoordinate(12, 11));
+}
+
+void tst_offline_geocoding::geocodePrefix()
+{
+    const QList<QGeoLocation> locations = wait(m_geocodingManager->geocode(QStringLiteral("springf"), 1));
+    QCOMPARE(locations.size(), 1);
+    QCOMPARE(locations.first().address().city(), QStringLiteral("Springfield"));
+    QCOMPARE(locations.first().address().country(), QStringLiteral("Testland"));
+    QVERIFY(locations.first().boundingBox().isValid());
+}
+
+void tst_offline_geocoding::geocodeDiacritics()
+{
+    const QList<QGeoLocation> locations = wait(m_geocodingManager->geocode(QStringLiteral("KONIGSALLEE 1"), 1));
+    QCOMPARE(locations.size(), 1);
+    QCOMPARE(locations.first().address().street(), QString::fromUtf8("1 K\xc3\xb6nigsallee"));
+    QCOMPARE(locations.first().address().postalCode(), QStringLiteral("40212"));
+}
+
+void tst_offline_geocoding::geocodeLimitOffset()
+{
+    const QList<QGeoLocation> first = wait(m_geocodingManager->geocode(QStringLiteral("Oak Street"), 5, 0));
+    const QList<QGeoLocation> second = wait(m_geocodingManager->geocode(QStringLiteral("Oak Street"), 5, 5));
+    QCOMPARE(first.size(), 5);
+    QCOMPARE(second.size(), 5);
+    for (const QGeoLocation &location : first + second)
+        QVERIFY(location.address().street().endsWith(QStringLiteral(" Oak Street")));
+    for (const QGeoLocation &location : second) {
+        for (const QGeoLocation &other : first)
+            QVERIFY(location.coordinate() != other.coordinate());
+    }
+}
+
+void tst_offline_geocoding::geocodeBounds()
+{
+    // Only the western part of Oak Street, not its neighbours.
+    const QGeoCoordinate west = gridCoordinate(14, 0);
+    const QGeoCoordinate east = gridCoordinate(14, 4);
+    const QGeoRectangle bounds(QGeoCoordinate(west.latitude() + 0.0001, west.longitude() - 0.0001),
+                               QGeoCoordinate(east.latitude() - 0.0001, east.longitude() + 0.0001));
+    const QList<QGeoLocation> locations = wait(m_geocodingManager->geocode(QStringLiteral("Oak Street"), -1, 0, bounds));
+    QCOMPARE(locations.size(), 5);
+    for (const QGeoLocation &location : locations)
+        QVERIFY(bounds.contains(location.coordinate()));
+}
+
+void tst_offline_geocoding::geocodeAddress()
+{
+    QGeoAddress address;
+    address.setStreet(QStringLiteral("Pine Street"));
+    address.setCountry(QStringLiteral("Testland"));
+    const QList<QGeoLocation> locations = wait(m_geocodingManager->geocode(address));
+    QVERIFY(locations.size() >= 20);
+    QVERIFY(locations.first().address().street().endsWith(QStringLiteral(" Pine Street")));
+}
+
+QTEST_GUILESS_MAIN(tst_offline_geocoding)
+
+#include "tst_geocoding.moc"
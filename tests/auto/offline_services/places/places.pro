@@ -0,0 +1,12 @@
+TEMPLATE = app
+CONFIG += testcase
+TARGET = tst_offline_places
+
+QT += location testlib
+INCLUDEPATH += $$PWD/../../../../src/plugins/geoservices/offline
+
+HEADERS += $$PWD/../../../../src/plugins/geoservices/offline/qgeotextindex.h \
+           $$PWD/../../../../src/plugins/geoservices/offline/qplaceindex.h
+SOURCES += tst_places.cpp \
+           $$PWD/../../../../src/plugins/geoservices/offline/qgeotextindex.cpp \
+           $$PWD/../../../../src/plugins/geoservices/offline/qplaceindex.cpp
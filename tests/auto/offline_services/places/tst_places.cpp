@@ -0,0 +1,334 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qplaceindex.h>
+
+#include <QtTest/QtTest>
+#include <QtCore/QTemporaryDir>
+#include <QtLocation/QGeoServiceProvider>
+#include <QtLocation/QPlaceContactDetail>
+#include <QtLocation/QPlaceDetailsReply>
+#include <QtLocation/QPlaceManager>
+#include <QtLocation/QPlaceResult>
+#include <QtLocation/QPlaceSearchReply>
+#include <QtLocation/QPlaceSearchRequest>
+#include <QtLocation/QPlaceSearchSuggestionReply>
+#include <QtPositioning/QGeoCircle>
+#include <QtPositioning/QGeoRectangle>
+
+QT_USE_NAMESPACE
+
+/*
+    Test data: three restaurants and cafes a few hundred metres north east
+    of (0, 0), a second Luigi's Pizzeria 30 km away, a row of 30 kiosks,
+    one place on each side of the antimeridian and a cafe with diacritics.
+*/
+class tst_offline_places : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void missingIndex();
+    void searchText();
+    void searchDiacritics();
+    void searchProximity();
+    void searchCategory();
+    void searchAntimeridian();
+    void searchPaging();
+    void searchZeroLimit();
+    void suggestions();
+    void details();
+    void categories();
+
+private:
+    bool wait(QPlaceReply *reply);
+    QList<QPlaceResult> results(QPlaceSearchReply *reply);
+
+    QTemporaryDir m_dir;
+    QGeoServiceProvider *m_provider = nullptr;
+    QPlaceManager *m_placeManager = nullptr;
+};
+
+static QPlaceIndexWriter::PlaceData placeData(const QString &id, const QString &name,
+                                              double latitude, double longitude,
+                                              const QString &category)
+{
+    QPlaceIndexWriter::PlaceData place;
+    place.id = id;
+    place.name = name;
+    place.latitude = latitude;
+    place.longitude = longitude;
+    place.categories.append(category);
+    return place;
+}
+
+void tst_offline_places::initTestCase()
+{
+    QVERIFY(QGeoServiceProvider::availableServiceProviders().contains(QStringLiteral("offline")));
+    QVERIFY(m_dir.isValid());
+
+    QPlaceIndexWriter writer;
+    writer.addCategory(QStringLiteral("pizza"), QStringLiteral("Pizza"), QStringLiteral("food"));
+    writer.addCategory(QStringLiteral("food"), QStringLiteral("Food & Drink"));
+    writer.addCategory(QStringLiteral("cafe"), QStringLiteral("Cafe"), QStringLiteral("food"));
+    writer.addCategory(QStringLiteral("shop"), QStringLiteral("Shopping"));
+
+    QPlaceIndexWriter::PlaceData luigis = placeData(QStringLiteral("p1"), QStringLiteral("Luigi's Pizzeria"),
+                                                    0.001, 0.001, QStringLiteral("pizza"));
+    luigis.street = QStringLiteral("1 Main Street");
+    luigis.city = QStringLiteral("Springfield");
+    luigis.countryCode = QStringLiteral("TST");
+    luigis.phone = QStringLiteral("+1 555 0100");
+    luigis.website = QStringLiteral("https://luigis.example");
+    writer.addPlace(luigis);
+    writer.addPlace(placeData(QStringLiteral("p2"), QStringLiteral("Pizza Napoli"),
+                              0.003, 0.003, QStringLiteral("pizza")));
+    writer.addPlace(placeData(QStringLiteral("p3"), QStringLiteral("Central Cafe"),
+                              0.002, 0.002, QStringLiteral("cafe")));
+    writer.addPlace(placeData(QStringLiteral("p4"), QStringLiteral("Corner Bakery"),
+                              0.01, 0.01, QStringLiteral("shop")));
+    writer.addPlace(placeData(QStringLiteral("p5"), QString::fromUtf8("Caf\xc3\xa9 M\xc3\xbcller"),
+                              0.5, 0.5, QStringLiteral("cafe")));
+    writer.addPlace(placeData(QStringLiteral("p6"), QStringLiteral("Luigi's Pizzeria"),
+                              0.2, 0.2, QStringLiteral("pizza")));
+    writer.addPlace(placeData(QStringLiteral("east"), QStringLiteral("Dateline Diner"),
+                              0.0, 179.999, QStringLiteral("food")));
+    writer.addPlace(placeData(QStringLiteral("west"), QStringLiteral("Dateline Deli"),
+                              0.0, -179.999, QStringLiteral("food")));
+    for (int i = 1; i <= 30; ++i) {
+        writer.addPlace(placeData(QStringLiteral("kiosk%1").arg(i), QStringLiteral("Kiosk %1").arg(i),
+                                  0.05, 0.001 * i, QStringLiteral("shop")));
+    }
+
+    const QString fileName = m_dir.filePath(QStringLiteral("places.index"));
+    QString errorString;
+    QVERIFY2(writer.write(fileName, &errorString), qPrintable(errorString));
+
+    QVariantMap parameters;
+    parameters.insert(QStringLiteral("offline.places.index"), fileName);
+    m_provider = new QGeoServiceProvider(QStringLiteral("offline"), parameters);
+    m_placeManager = m_provider->placeManager();
+    QVERIFY2(m_placeManager, qPrintable(m_provider->errorString()));
+}
+
+void tst_offline_places::cleanupTestCase()
+{
+    delete m_provider;
+}
+
+bool tst_offline_places::wait(QPlaceReply *reply)
+{
+    if (!QTest::qWaitFor([reply]() { return reply->isFinished(); }, 5000)) {
+        qWarning("Place reply did not finish");
+        return false;
+    }
+    if (reply->error() != QPlaceReply::NoError) {
+        qWarning() << reply->errorString();
+        return false;
+    }
+    return true;
+}
+
+QList<QPlaceResult> tst_offline_places::results(QPlaceSearchReply *reply)
+{
+    QScopedPointer<QPlaceSearchReply> guard(reply);
+    QList<QPlaceResult> places;
+    if (!wait(reply))
+        return places;
+    for (const QPlaceSearchResult &result : reply->results())
+        places.append(QPlaceResult(result));
+    return places;
+}
+
+void tst_offline_places::missingIndex()
+{
+    QGeoServiceProvider provider(QStringLiteral("offline"));
+    QVERIFY(!provider.placeManager());
+    QCOMPARE(provider.error(), QGeoServiceProvider::MissingRequiredParameterError);
+}
+
+void tst_offline_places::searchText()
+{
+    QPlaceSearchRequest request;
+    request.setSearchTerm(QStringLiteral("pizzeria"));
+    const QList<QPlaceResult> places = results(m_placeManager->search(request));
+    QVERIFY(places.size() >= 2);
+    QCOMPARE(places.at(0).title(), QStringLiteral("Luigi's Pizzeria"));
+    QCOMPARE(places.at(1).title(), QStringLiteral("Luigi's Pizzeria"));
+    QVERIFY(places.at(0).place().placeId() != places.at(1).place().placeId());
+    QVERIFY(qIsNaN(places.at(0).distance()));
+}
+
+void tst_offline_places::searchDiacritics()
+{
+    QPlaceSearchRequest request;
+    request.setSearchTerm(QStringLiteral("CAFE MULLER"));
+    const QList<QPlaceResult> places = results(m_placeManager->search(request));
+    QVERIFY(!places.isEmpty());
+    QCOMPARE(places.first().place().placeId(), QStringLiteral("p5"));
+}
+
+void tst_offline_places::searchProximity()
+{
+    QPlaceSearchRequest request;
+    request.setSearchTerm(QStringLiteral("Luigi's Pizzeria"));
+
+    // Both are inside, the closer one comes first.
+    request.setSearchArea(QGeoCircle(QGeoCoordinate(0.18, 0.18), 40000));
+    QList<QPlaceResult> places = results(m_placeManager->search(request));
+    QVERIFY(places.size() >= 2);
+    QCOMPARE(places.at(0).place().placeId(), QStringLiteral("p6"));
+    QCOMPARE(places.at(1).place().placeId(), QStringLiteral("p1"));
+    QVERIFY(places.at(0).distance() < places.at(1).distance());
+
+    // Only the one inside the area.
+    request.setSearchArea(QGeoCircle(QGeoCoordinate(0.2, 0.2), 5000));
+    places = results(m_placeManager->search(request));
+    QCOMPARE(places.size(), 1);
+    QCOMPARE(places.first().place().placeId(), QStringLiteral("p6"));
+}
+
+void tst_offline_places::searchCategory()
+{
+    QPlaceCategory food;
+    food.setCategoryId(QStringLiteral("food"));
+    QPlaceSearchRequest request;
+    request.setCategory(food);
+    request.setSearchArea(QGeoCircle(QGeoCoordinate(0.0, 0.0), 2000));
+    const QList<QPlaceResult> places = results(m_placeManager->search(request));
+
+    // Subcategories are included, the bakery is not; nearest first.
+    QCOMPARE(places.size(), 3);
+    QCOMPARE(places.at(0).place().placeId(), QStringLiteral("p1"));
+    QCOMPARE(places.at(1).place().placeId(), QStringLiteral("p3"));
+    QCOMPARE(places.at(2).place().placeId(), QStringLiteral("p2"));
+}
+
+void tst_offline_places::searchAntimeridian()
+{
+    QPlaceSearchRequest request;
+    request.setSearchArea(QGeoRectangle(QGeoCoordinate(1.0, 179.9), QGeoCoordinate(-1.0, -179.9)));
+    const QList<QPlaceResult> places = results(m_placeManager->search(request));
+    QCOMPARE(places.size(), 2);
+    QStringList ids;
+    for (const QPlaceResult &place : places)
+        ids.append(place.place().placeId());
+    ids.sort();
+    QCOMPARE(ids, QStringList({ QStringLiteral("east"), QStringLiteral("west") }));
+}
+
+void tst_offline_places::searchPaging()
+{
+    QPlaceSearchRequest request;
+    request.setSearchTerm(QStringLiteral("kiosk"));
+    request.setLimit(10);
+
+    QSet<QString> ids;
+    int pages = 0;
+    for (;;) {
+        QScopedPointer<QPlaceSearchReply> reply(m_placeManager->search(request));
+        QVERIFY(wait(reply.data()));
+        QCOMPARE(reply->results().size(), 10);
+        QCOMPARE(reply->previousPageRequest().searchTerm().isEmpty(), pages == 0);
+        for (const QPlaceSearchResult &result : reply->results())
+            ids.insert(QPlaceResult(result).place().placeId());
+        ++pages;
+        if (reply->nextPageRequest().searchTerm().isEmpty())
+            break;
+        request = reply->nextPageRequest();
+    }
+    QCOMPARE(pages, 3);
+    QCOMPARE(ids.size(), 30);
+}
+
+void tst_offline_places::searchZeroLimit()
+{
+    QPlaceSearchRequest request;
+    request.setSearchTerm(QStringLiteral("kiosk"));
+    request.setLimit(0);
+
+    QScopedPointer<QPlaceSearchReply> reply(m_placeManager->search(request));
+    QVERIFY(wait(reply.data()));
+    QVERIFY(reply->results().isEmpty());
+    QVERIFY(reply->nextPageRequest().searchTerm().isEmpty());
+    QVERIFY(reply->previousPageRequest().searchTerm().isEmpty());
+}
+
+void tst_offline_places::suggestions()
+{
+    QPlaceSearchRequest request;
+    request.setSearchTerm(QStringLiteral("luig"));
+    QScopedPointer<QPlaceSearchSuggestionReply> reply(m_placeManager->searchSuggestions(request));
+    QVERIFY(wait(reply.data()));
+    QCOMPARE(reply->suggestions(), QStringList(QStringLiteral("Luigi's Pizzeria")));
+}
+
+void tst_offline_places::details()
+{
+    QScopedPointer<QPlaceDetailsReply> reply(m_placeManager->getPlaceDetails(QStringLiteral("p1")));
+    QVERIFY(wait(reply.data()));
+    const QPlace place = reply->place();
+    QCOMPARE(place.name(), QStringLiteral("Luigi's Pizzeria"));
+    QCOMPARE(place.location().coordinate(), QGeoCoordinate(0.001, 0.001));
+    QCOMPARE(place.location().address().street(), QStringLiteral("1 Main Street"));
+    QCOMPARE(place.location().address().city(), QStringLiteral("Springfield"));
+    QCOMPARE(place.location().address().countryCode(), QStringLiteral("TST"));
+    QCOMPARE(place.primaryPhone(), QStringLiteral("+1 555 0100"));
+    QCOMPARE(place.primaryWebsite(), QUrl(QStringLiteral("https://luigis.example")));
+    QCOMPARE(place.categories().size(), 1);
+    QCOMPARE(place.categories().first().name(), QStringLiteral("Pizza"));
+    QVERIFY(place.detailsFetched());
+
+    QScopedPointer<QPlaceDetailsReply> missing(m_placeManager->getPlaceDetails(QStringLiteral("nowhere")));
+    QTRY_VERIFY(missing->isFinished());
+    QCOMPARE(missing->error(), QPlaceReply::PlaceDoesNotExistError);
+}
+
+void tst_offline_places::categories()
+{
+    QScopedPointer<QPlaceReply> reply(m_placeManager->initializeCategories());
+    QVERIFY(wait(reply.data()));
+
+    QStringList topLevel;
+    for (const QPlaceCategory &category : m_placeManager->childCategories())
+        topLevel.append(category.categoryId());
+    topLevel.sort();
+    QCOMPARE(topLevel, QStringList({ QStringLiteral("food"), QStringLiteral("shop") }));
+
+    QStringList food = m_placeManager->childCategoryIds(QStringLiteral("food"));
+    food.sort();
+    QCOMPARE(food, QStringList({ QStringLiteral("cafe"), QStringLiteral("pizza") }));
+    QCOMPARE(m_placeManager->parentCategoryId(QStringLiteral("pizza")), QStringLiteral("food"));
+    QCOMPARE(m_placeManager->category(QStringLiteral("food")).name(), QStringLiteral("Food & Drink"));
+}
+
+QTEST_GUILESS_MAIN(tst_offline_places)
+
+#include "tst_places.moc"
@@ -0,0 +1,10 @@
+TEMPLATE = app
+CONFIG += testcase
+TARGET = tst_offline_routing
+
+QT += location testlib
+INCLUDEPATH += $$PWD/../../../../src/plugins/geoservices/offline
+
+HEADERS += $$PWD/../../../../src/plugins/geoservices/offline/qgeoroutegraph.h
+SOURCES += tst_routing.cpp \
+           $$PWD/../../../../src/plugins/geoservices/offline/qgeoroutegraph.cpp
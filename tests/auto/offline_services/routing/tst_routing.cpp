@@ -0,0 +1,282 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <qgeoroutegraph.h>
+
+#include <QtTest/QtTest>
+#include <QtCore/QTemporaryDir>
+#include <QtLocation/QGeoManeuver>
+#include <QtLocation/QGeoRoute>
+#include <QtLocation/QGeoRouteLeg>
+#include <QtLocation/QGeoRouteReply>
+#include <QtLocation/QGeoRouteSegment>
+#include <QtLocation/QGeoRoutingManager>
+#include <QtLocation/QGeoServiceProvider>
+
+QT_USE_NAMESPACE
+
+/*
+    Test network, about 222 m between A and B and between B and C:
+
+        E         C
+        |       / |
+        |     D   |
+        |   /     |
+        A ------- B
+
+    Main Street (A-B) and Second Street (B-C) are fast, the Shortcut through D
+    is slow, and cars may only drive north on Oneway Street (A-E).
+*/
+static const QGeoCoordinate A(0.0, 0.0);
+static const QGeoCoordinate B(0.0, 0.002);
+static const QGeoCoordinate C(0.002, 0.002);
+static const QGeoCoordinate D(0.001, 0.001);
+static const QGeoCoordinate E(0.002, 0.0);
+
+class tst_offline_routing : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void missingGraph();
+    void invalidGraph();
+    void fastestRoute();
+    void shortestRoute();
+    void pedestrianRoute();
+    void onewayStreet();
+    void multipleLegs();
+    void waypointTooFar();
+    void updateRoute();
+
+private:
+    QGeoRoute calculate(const QGeoRouteRequest &request);
+    QGeoRouteReply *wait(QGeoRouteReply *reply);
+
+    QTemporaryDir m_dir;
+    QString m_graphFile;
+    QGeoServiceProvider *m_provider = nullptr;
+    QGeoRoutingManager *m_routingManager = nullptr;
+};
+
+void tst_offline_routing::initTestCase()
+{
+    QVERIFY(QGeoServiceProvider::availableServiceProviders().contains(QStringLiteral("offline")));
+    QVERIFY(m_dir.isValid());
+
+    const int all = QGeoRouteGraph::CarAccess | QGeoRouteGraph::BicycleAccess
+            | QGeoRouteGraph::PedestrianAccess;
+
+    QGeoRouteGraphWriter writer;
+    const quint32 a = writer.addNode(A.latitude(), A.longitude());
+    const quint32 b = writer.addNode(B.latitude(), B.longitude());
+    const quint32 c = writer.addNode(C.latitude(), C.longitude());
+    const quint32 d = writer.addNode(D.latitude(), D.longitude());
+    const quint32 e = writer.addNode(E.latitude(), E.longitude());
+    writer.addEdge(a, b, all, 100, QStringLiteral("Main Street"));
+    writer.addEdge(b, a, all, 100, QStringLiteral("Main Street"));
+    writer.addEdge(b, c, all, 100, QStringLiteral("Second Street"));
+    writer.addEdge(c, b, all, 100, QStringLiteral("Second Street"));
+    writer.addEdge(a, d, all, 10, QStringLiteral("Shortcut"));
+    writer.addEdge(d, a, all, 10, QStringLiteral("Shortcut"));
+    writer.addEdge(d, c, all, 10, QStringLiteral("Shortcut"));
+    writer.addEdge(c, d, all, 10, QStringLiteral("Shortcut"));
+    writer.addEdge(a, e, all, 30, QStringLiteral("Oneway Street"));
+    writer.addEdge(e, a, QGeoRouteGraph::PedestrianAccess, 30, QStringLiteral("Oneway Street"));
+
+    m_graphFile = m_dir.filePath(QStringLiteral("test.graph"));
+    QString errorString;
+    QVERIFY2(writer.write(m_graphFile, &errorString), qPrintable(errorString));
+
+    QVariantMap parameters;
+    parameters.insert(QStringLiteral("offline.routing.graph"), m_graphFile);
+    parameters.insert(QStringLiteral("offline.routing.snap_distance"), 100);
+    m_provider = new QGeoServiceProvider(QStringLiteral("offline"), parameters);
+    m_routingManager = m_provider->routingManager();
+    QVERIFY2(m_routingManager, qPrintable(m_provider->errorString()));
+    QVERIFY(m_routingManager->supportedTravelModes() & QGeoRouteRequest::PedestrianTravel);
+}
+
+void tst_offline_routing::cleanupTestCase()
+{
+    delete m_provider;
+}
+
+QGeoRouteReply *tst_offline_routing::wait(QGeoRouteReply *reply)
+{
+    QSignalSpy finishedSpy(reply, SIGNAL(finished()));
+    QSignalSpy errorSpy(reply, SIGNAL(error(QGeoRouteReply::Error,QString)));
+    if (!reply->isFinished() && reply->error() == QGeoRouteReply::NoError)
+        QTRY_VERIFY(finishedSpy.count() + errorSpy.count() > 0);
+    return reply;
+}
+
+QGeoRoute tst_offline_routing::calculate(const QGeoRouteRequest &request)
+{
+    QScopedPointer<QGeoRouteReply> reply(wait(m_routingManager->calculateRoute(request)));
+    if (reply->error() != QGeoRouteReply::NoError)
+        qWarning() << reply->errorString();
+    if (reply->routes().size() != 1)
+        return QGeoRoute();
+    return reply->routes().first();
+}
+
+void tst_offline_routing::missingGraph()
+{
+    QGeoServiceProvider provider(QStringLiteral("offline"));
+    QVERIFY(!provider.routingManager());
+    QCOMPARE(provider.error(), QGeoServiceProvider::MissingRequiredParameterError);
+}
+
+void tst_offline_routing::invalidGraph()
+{
+    const QString fileName = m_dir.filePath(QStringLiteral("invalid.graph"));
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(QByteArray(512, 'x'));
+    file.close();
+
+    QVariantMap parameters;
+    parameters.insert(QStringLiteral("offline.routing.graph"), fileName);
+    QGeoServiceProvider provider(QStringLiteral("offline"), parameters);
+    QVERIFY(!provider.routingManager());
+    QCOMPARE(provider.error(), QGeoServiceProvider::NotSupportedError);
+}
+
+void tst_offline_routing::fastestRoute()
+{
+    const QGeoRoute route = calculate(QGeoRouteRequest(A, C));
+    QCOMPARE(route.path(), QList<QGeoCoordinate>() << A << B << C);
+    QVERIFY(qAbs(route.distance() - 2 * A.distanceTo(B)) < 1.0);
+    QCOMPARE(route.travelTime(), 16);
+    QCOMPARE(route.travelMode(), QGeoRouteRequest::CarTravel);
+    QCOMPARE(route.routeLegs().size(), 1);
+
+    QGeoRouteSegment segment = route.firstRouteSegment();
+    QVERIFY(segment.isValid());
+    QCOMPARE(segment.maneuver().direction(), QGeoManeuver::NoDirection);
+    QCOMPARE(segment.maneuver().instructionText(), QStringLiteral("Head east on Main Street"));
+    QCOMPARE(segment.path(), QList<QGeoCoordinate>() << A << B);
+
+    segment = segment.nextRouteSegment();
+    QCOMPARE(segment.maneuver().direction(), QGeoManeuver::DirectionLeft);
+    QCOMPARE(segment.maneuver().instructionText(), QStringLiteral("Turn left onto Second Street"));
+    QCOMPARE(segment.maneuver().position(), B);
+
+    segment = segment.nextRouteSegment();
+    QVERIFY(segment.isLegLastSegment());
+    QCOMPARE(segment.maneuver().waypoint(), C);
+    QCOMPARE(segment.distance(), 0.0);
+    QVERIFY(!segment.nextRouteSegment().isValid());
+}
+
+void tst_offline_routing::shortestRoute()
+{
+    QGeoRouteRequest request(A, C);
+    request.setRouteOptimization(QGeoRouteRequest::ShortestRoute);
+    const QGeoRoute route = calculate(request);
+    QCOMPARE(route.path(), QList<QGeoCoordinate>() << A << D << C);
+    QVERIFY(route.distance() < 2 * A.distanceTo(B));
+    QCOMPARE(route.firstRouteSegment().maneuver().instructionText(),
+             QStringLiteral("Head northeast on Shortcut"));
+}
+
+void tst_offline_routing::pedestrianRoute()
+{
+    // At walking speed the Shortcut is also the fastest way.
+    QGeoRouteRequest request(A, C);
+    request.setTravelModes(QGeoRouteRequest::PedestrianTravel);
+    const QGeoRoute route = calculate(request);
+    QCOMPARE(route.path(), QList<QGeoCoordinate>() << A << D << C);
+    QCOMPARE(route.travelMode(), QGeoRouteRequest::PedestrianTravel);
+    QVERIFY(route.travelTime() > 200);
+}
+
+void tst_offline_routing::onewayStreet()
+{
+    QCOMPARE(calculate(QGeoRouteRequest(A, E)).path(), QList<QGeoCoordinate>() << A << E);
+
+    QScopedPointer<QGeoRouteReply> reply(wait(m_routingManager->calculateRoute(QGeoRouteRequest(E, A))));
+    QCOMPARE(reply->error(), QGeoRouteReply::UnknownError);
+    QVERIFY(reply->routes().isEmpty());
+
+    QGeoRouteRequest request(E, A);
+    request.setTravelModes(QGeoRouteRequest::PedestrianTravel);
+    QCOMPARE(calculate(request).path(), QList<QGeoCoordinate>() << E << A);
+}
+
+void tst_offline_routing::multipleLegs()
+{
+    QGeoRouteRequest request(QList<QGeoCoordinate>() << A << B << C);
+    const QGeoRoute route = calculate(request);
+    QCOMPARE(route.path(), QList<QGeoCoordinate>() << A << B << C);
+
+    const QList<QGeoRouteLeg> legs = route.routeLegs();
+    QCOMPARE(legs.size(), 2);
+    QCOMPARE(legs.at(0).legIndex(), 0);
+    QCOMPARE(legs.at(0).path(), QList<QGeoCoordinate>() << A << B);
+    QCOMPARE(legs.at(1).path(), QList<QGeoCoordinate>() << B << C);
+    QVERIFY(qAbs(legs.at(0).distance() + legs.at(1).distance() - route.distance()) < 1e-6);
+
+    int legEnds = 0;
+    for (QGeoRouteSegment s = route.firstRouteSegment(); s.isValid(); s = s.nextRouteSegment())
+        legEnds += s.isLegLastSegment();
+    QCOMPARE(legEnds, 2);
+}
+
+void tst_offline_routing::waypointTooFar()
+{
+    QScopedPointer<QGeoRouteReply> reply(wait(m_routingManager->calculateRoute(
+                                                  QGeoRouteRequest(A, QGeoCoordinate(1.0, 1.0)))));
+    QCOMPARE(reply->error(), QGeoRouteReply::UnknownError);
+    QVERIFY(!reply->errorString().isEmpty());
+}
+
+void tst_offline_routing::updateRoute()
+{
+    QGeoRouteRequest request(QList<QGeoCoordinate>() << A << B << C);
+    const QGeoRoute route = calculate(request);
+    QCOMPARE(route.routeLegs().size(), 2);
+
+    // Past the first waypoint, on Second Street close to B.
+    const QGeoCoordinate position(0.0006, 0.002);
+    QScopedPointer<QGeoRouteReply> reply(wait(m_routingManager->updateRoute(route, position)));
+    QCOMPARE(reply->error(), QGeoRouteReply::NoError);
+    QCOMPARE(reply->routes().size(), 1);
+
+    const QGeoRoute updated = reply->routes().first();
+    QCOMPARE(updated.request().waypoints(), QList<QGeoCoordinate>() << position << C);
+    QCOMPARE(updated.routeLegs().size(), 1);
+    QCOMPARE(updated.path(), QList<QGeoCoordinate>() << B << C);
+}
+
+QTEST_GUILESS_MAIN(tst_offline_routing)
+
+#include "tst_routing.moc"
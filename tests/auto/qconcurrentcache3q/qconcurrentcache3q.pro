@@ -0,0 +1,7 @@
+TEMPLATE = app
+CONFIG += testcase
+TARGET = tst_qconcurrentcache3q
+
+SOURCES += tst_qconcurrentcache3q.cpp
+
+QT += location-private testlib
@@ -0,0 +1,245 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/QAtomicInt>
+#include <QtCore/QRunnable>
+#include <QtCore/QThreadPool>
+#include <QtTest/QtTest>
+#include <QtLocation/private/qconcurrentcache3q_p.h>
+
+#include <limits>
+
+QT_USE_NAMESPACE
+
+static QAtomicInt evictions;
+static QAtomicInt removals;
+
+class CountingPolicy : public QCache3QDefaultEvictionPolicy<int, QString>
+{
+protected:
+    void aboutToBeEvicted(const int &, QSharedPointer<QString>) { evictions.ref(); }
+    void aboutToBeRemoved(const int &, QSharedPointer<QString>) { removals.ref(); }
+};
+
+typedef QConcurrentCache3Q<int, QString, CountingPolicy> Cache;
+
+static QSharedPointer<QString> value(int key)
+{
+    return QSharedPointer<QString>(new QString(QString::number(key)));
+}
+
+class Worker : public QRunnable
+{
+public:
+    Worker(Cache *cache, int first, int count) : m_cache(cache), m_first(first), m_count(count) {}
+
+    void run() override
+    {
+        for (int key = m_first; key < m_first + m_count; ++key) {
+            m_cache->insert(key, value(key), 1 + key % 3);
+            // Lookups of other threads' keys, which may or may not be cached.
+            QSharedPointer<QString> mine = m_cache->object(key);
+            if (mine && *mine != QString::number(key))
+                mismatches.ref();
+            QSharedPointer<QString> other = m_cache->object(key ^ 0x4000);
+            if (other && *other != QString::number(key ^ 0x4000))
+                mismatches.ref();
+            m_cache->contains(key - 1);
+        }
+    }
+
+    static QAtomicInt mismatches;
+
+private:
+    Cache *m_cache;
+    int m_first;
+    int m_count;
+};
+
+QAtomicInt Worker::mismatches;
+
+class tst_QConcurrentCache3Q : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void init();
+    void insertAndLookup();
+    void shardedMaxCost();
+    void largeCosts();
+    void eviction();
+    void removeAndClear();
+    void serializeQueue();
+    void concurrentAccess();
+};
+
+void tst_QConcurrentCache3Q::init()
+{
+    evictions.store(0);
+    removals.store(0);
+}
+
+void tst_QConcurrentCache3Q::insertAndLookup()
+{
+    Cache cache(1000);
+    for (int key = 0; key < 100; ++key)
+        QVERIFY(cache.insert(key, value(key)));
+
+    QCOMPARE(cache.totalCost(), qint64(100));
+    QCOMPARE(cache.keys().size(), 100);
+    for (int key = 0; key < 100; ++key) {
+        QVERIFY(cache.contains(key));
+        QCOMPARE(*cache.object(key), QString::number(key));
+    }
+    QVERIFY(!cache.contains(100));
+    QVERIFY(!cache.object(100));
+}
+
+void tst_QConcurrentCache3Q::shardedMaxCost()
+{
+    Cache cache(10, 4);
+    QCOMPARE(cache.shardCount(), 4);
+    QCOMPARE(cache.maxCost(), qint64(10));
+
+    // Objects larger than the share of their shard are admitted up to the
+    // maximum cost of the whole cache, which is never exceeded.
+    for (int key = 0; key < 8; ++key)
+        QVERIFY(cache.insert(key, value(key), 1));
+    QVERIFY(cache.insert(100, value(100), 9));
+    QVERIFY(cache.contains(100));
+    QVERIFY(cache.totalCost() <= 10);
+    QVERIFY(!cache.insert(101, value(101), 11));
+    QVERIFY(!cache.contains(101));
+
+    // The other shards borrow back what they need.
+    QVERIFY(cache.insert(102, value(102), 8));
+    QVERIFY(cache.contains(102));
+    QVERIFY(cache.totalCost() <= 10);
+
+    cache.setMaxCost(40);
+    QCOMPARE(cache.maxCost(), qint64(40));
+    QVERIFY(cache.insert(2, value(2), 40));
+    QCOMPARE(cache.totalCost(), qint64(40));
+}
+
+void tst_QConcurrentCache3Q::largeCosts()
+{
+    const qint64 gigabyte = Q_INT64_C(1) << 30;
+    Cache cache(8 * gigabyte, 1);
+
+    for (int key = 0; key < 6; ++key)
+        QVERIFY(cache.insert(key, value(key), gigabyte));
+    QCOMPARE(cache.totalCost(), 6 * gigabyte);
+    QCOMPARE(evictions.load(), 0);
+
+    for (int key = 6; key < 12; ++key)
+        QVERIFY(cache.insert(key, value(key), gigabyte));
+    QVERIFY(cache.totalCost() <= 8 * gigabyte);
+    QVERIFY(cache.totalCost() > std::numeric_limits<int>::max());
+    QCOMPARE(evictions.load(), 4);
+}
+
+void tst_QConcurrentCache3Q::eviction()
+{
+    Cache cache(40, 4);
+    for (int key = 0; key < 200; ++key)
+        cache.insert(key, value(key));
+
+    QVERIFY(cache.totalCost() <= 40);
+    QCOMPARE(evictions.load(), 200 - int(cache.totalCost()));
+
+    // Popular entries survive a stream of new ones.
+    cache.setPromoteAt(1);
+    const int popular = 1000;
+    cache.insert(popular, value(popular));
+    for (int i = 0; i < 4; ++i)
+        cache.object(popular);
+    for (int key = 2000; key < 2200; ++key)
+        cache.insert(key, value(key));
+    QVERIFY(cache.contains(popular));
+}
+
+void tst_QConcurrentCache3Q::removeAndClear()
+{
+    Cache cache(100);
+    for (int key = 0; key < 10; ++key)
+        cache.insert(key, value(key));
+
+    cache.remove(3);
+    QVERIFY(!cache.contains(3));
+    QCOMPARE(removals.load(), 1);
+    cache.remove(4, true);
+    QCOMPARE(removals.load(), 1);
+
+    cache.clear();
+    QCOMPARE(removals.load(), 9);
+    QCOMPARE(cache.totalCost(), qint64(0));
+    QVERIFY(cache.keys().isEmpty());
+}
+
+void tst_QConcurrentCache3Q::serializeQueue()
+{
+    QList<int> keys;
+    QList<QSharedPointer<QString> > values;
+    QList<qint64> costs;
+    for (int key = 0; key < 20; ++key) {
+        keys.append(key);
+        values.append(value(key));
+        costs.append(2);
+    }
+
+    Cache cache(1000);
+    cache.deserializeQueue(1, keys, values, costs);
+    QCOMPARE(cache.totalCost(), qint64(40));
+    for (int key = 0; key < 20; ++key)
+        QVERIFY(cache.contains(key));
+
+    QList<QSharedPointer<QString> > buffer;
+    cache.serializeQueue(1, buffer);
+    QCOMPARE(buffer.size(), 20);
+}
+
+void tst_QConcurrentCache3Q::concurrentAccess()
+{
+    Worker::mismatches.store(0);
+    Cache cache(5000);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(8);
+    for (int i = 0; i < 8; ++i)
+        pool.start(new Worker(&cache, i * 0x1000, 0x1000));
+    QVERIFY(pool.waitForDone(60000));
+
+    QCOMPARE(Worker::mismatches.load(), 0);
+    QVERIFY(cache.totalCost() <= 5000);
+    QVERIFY(cache.totalCost() > 0);
+}
+
+QTEST_GUILESS_MAIN(tst_QConcurrentCache3Q)
+
+#include "tst_qconcurrentcache3q.moc"
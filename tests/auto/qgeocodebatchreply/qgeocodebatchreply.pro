@@ -0,0 +1,9 @@
+TEMPLATE = app
+CONFIG+=testcase
+TARGET=tst_qgeocodebatchreply
+
+SOURCES += tst_qgeocodebatchreply.cpp
+
+CONFIG -= app_bundle
+
+QT += testlib location-private positioning
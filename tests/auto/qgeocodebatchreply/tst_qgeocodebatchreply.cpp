@@ -0,0 +1,241 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtLocation/QGeoCodeBatchReply>
+#include <QtLocation/private/qgeocodebatchreply_p.h>
+#include <QtPositioning/QGeoCoordinate>
+#include <QtPositioning/QGeoLocation>
+
+QT_USE_NAMESPACE
+
+class ItemReply : public QGeoCodeReply
+{
+    Q_OBJECT
+public:
+    explicit ItemReply(int index) : index(index) {}
+
+    void succeed()
+    {
+        QGeoLocation location;
+        location.setCoordinate(QGeoCoordinate(index, index));
+        setLocations(QList<QGeoLocation>() << location);
+        setFinished(true);
+    }
+    void fail() { setError(CommunicationError, QString::number(index)); }
+
+    int index;
+};
+
+class tst_QGeoCodeBatchReply : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void errorConstructor();
+    void concurrency();
+    void itemOrder();
+    void itemErrors();
+    void allItemsFailed();
+    void finishedAndNullReplies();
+    void abort();
+    void emptyBatch();
+
+private:
+    QGeoCodePipelinedBatchReply *createBatch(int count, int concurrency);
+
+    QList<QPointer<ItemReply>> m_sent;
+};
+
+QGeoCodePipelinedBatchReply *tst_QGeoCodeBatchReply::createBatch(int count, int concurrency)
+{
+    m_sent.clear();
+    return new QGeoCodePipelinedBatchReply(count, concurrency, [this](int index) {
+        ItemReply *reply = new ItemReply(index);
+        m_sent.append(reply);
+        return reply;
+    }, this);
+}
+
+static int inFlight(const QList<QPointer<ItemReply>> &sent)
+{
+    int count = 0;
+    for (const QPointer<ItemReply> &reply : sent) {
+        if (reply && !reply->isFinished())
+            ++count;
+    }
+    return count;
+}
+
+void tst_QGeoCodeBatchReply::errorConstructor()
+{
+    QGeoCodeBatchReply reply(QGeoCodeReply::CommunicationError, QStringLiteral("down"));
+    QVERIFY(reply.isFinished());
+    QCOMPARE(reply.error(), QGeoCodeReply::CommunicationError);
+    QCOMPARE(reply.errorString(), QStringLiteral("down"));
+    QCOMPARE(reply.count(), 0);
+    QVERIFY(!reply.isItemFinished(0));
+}
+
+void tst_QGeoCodeBatchReply::concurrency()
+{
+    QScopedPointer<QGeoCodePipelinedBatchReply> batch(createBatch(10, 3));
+    QSignalSpy finished(batch.data(), SIGNAL(finished()));
+    batch->start();
+
+    QCOMPARE(m_sent.size(), 3);
+    int maximum = 0;
+    while (inFlight(m_sent) > 0) {
+        maximum = qMax(maximum, inFlight(m_sent));
+        // Finishing a reply sends the next one, which appends to m_sent.
+        for (int i = 0; i < m_sent.size(); ++i) {
+            if (m_sent.at(i) && !m_sent.at(i)->isFinished()) {
+                m_sent.at(i)->succeed();
+                break;
+            }
+        }
+    }
+
+    QCOMPARE(maximum, 3);
+    QCOMPARE(m_sent.size(), 10);
+    QCOMPARE(finished.count(), 0);
+    QTRY_COMPARE(finished.count(), 1);
+    QCOMPARE(batch->error(), QGeoCodeReply::NoError);
+}
+
+void tst_QGeoCodeBatchReply::itemOrder()
+{
+    QScopedPointer<QGeoCodePipelinedBatchReply> batch(createBatch(4, 4));
+    QSignalSpy itemFinished(batch.data(), SIGNAL(itemFinished(int)));
+    batch->start();
+    QCOMPARE(m_sent.size(), 4);
+
+    for (int i = m_sent.size() - 1; i >= 0; --i)
+        m_sent.at(i)->succeed();
+
+    QCOMPARE(itemFinished.count(), 4);
+    QCOMPARE(itemFinished.first().first().toInt(), 3);
+    for (int i = 0; i < batch->count(); ++i) {
+        QVERIFY(batch->isItemFinished(i));
+        QCOMPARE(batch->itemLocations(i).size(), 1);
+        QCOMPARE(batch->itemLocations(i).first().coordinate(), QGeoCoordinate(i, i));
+    }
+    QTRY_VERIFY(batch->isFinished());
+    QVERIFY(batch->locations().isEmpty());
+}
+
+void tst_QGeoCodeBatchReply::itemErrors()
+{
+    QScopedPointer<QGeoCodePipelinedBatchReply> batch(createBatch(3, 3));
+    batch->start();
+
+    m_sent.at(0)->fail();
+    m_sent.at(1)->succeed();
+    m_sent.at(2)->fail();
+
+    QTRY_VERIFY(batch->isFinished());
+    QCOMPARE(batch->error(), QGeoCodeReply::NoError);
+    QCOMPARE(batch->itemError(0), QGeoCodeReply::CommunicationError);
+    QCOMPARE(batch->itemErrorString(0), QStringLiteral("0"));
+    QCOMPARE(batch->itemError(1), QGeoCodeReply::NoError);
+    QCOMPARE(batch->itemError(2), QGeoCodeReply::CommunicationError);
+    QVERIFY(batch->itemLocations(0).isEmpty());
+}
+
+void tst_QGeoCodeBatchReply::allItemsFailed()
+{
+    QScopedPointer<QGeoCodePipelinedBatchReply> batch(createBatch(2, 1));
+    QSignalSpy error(batch.data(), SIGNAL(error(QGeoCodeReply::Error,QString)));
+    batch->start();
+
+    m_sent.at(0)->fail();
+    QCOMPARE(m_sent.size(), 2);
+    m_sent.at(1)->fail();
+
+    QTRY_VERIFY(batch->isFinished());
+    QCOMPARE(error.count(), 1);
+    QCOMPARE(batch->error(), QGeoCodeReply::CommunicationError);
+    QCOMPARE(batch->errorString(), QStringLiteral("0"));
+}
+
+void tst_QGeoCodeBatchReply::finishedAndNullReplies()
+{
+    QScopedPointer<QGeoCodePipelinedBatchReply> batch(
+        new QGeoCodePipelinedBatchReply(3, 1, [](int index) -> QGeoCodeReply * {
+            if (index == 1)
+                return nullptr;
+            ItemReply *reply = new ItemReply(index);
+            reply->succeed();
+            return reply;
+        }));
+    QSignalSpy finished(batch.data(), SIGNAL(finished()));
+    batch->start();
+
+    // Every item finished while starting, the batch still finishes later.
+    QCOMPARE(finished.count(), 0);
+    QVERIFY(batch->isItemFinished(2));
+    QTRY_COMPARE(finished.count(), 1);
+    QCOMPARE(batch->itemLocations(0).size(), 1);
+    QCOMPARE(batch->itemError(1), QGeoCodeReply::UnknownError);
+    QCOMPARE(batch->itemLocations(2).size(), 1);
+}
+
+void tst_QGeoCodeBatchReply::abort()
+{
+    QScopedPointer<QGeoCodePipelinedBatchReply> batch(createBatch(5, 2));
+    QSignalSpy finished(batch.data(), SIGNAL(finished()));
+    batch->start();
+    QCOMPARE(m_sent.size(), 2);
+
+    QSignalSpy aborted(m_sent.at(0).data(), SIGNAL(aborted()));
+    batch->abort();
+
+    QCOMPARE(aborted.count(), 1);
+    QCOMPARE(finished.count(), 1);
+    QCOMPARE(m_sent.size(), 2);
+    QTRY_VERIFY(!m_sent.at(0));
+    QTRY_VERIFY(!m_sent.at(1));
+    QVERIFY(!batch->isItemFinished(0));
+    QCOMPARE(finished.count(), 1);
+}
+
+void tst_QGeoCodeBatchReply::emptyBatch()
+{
+    QScopedPointer<QGeoCodePipelinedBatchReply> batch(createBatch(0, 4));
+    QSignalSpy finished(batch.data(), SIGNAL(finished()));
+    batch->start();
+
+    QCOMPARE(m_sent.size(), 0);
+    QTRY_COMPARE(finished.count(), 1);
+    QCOMPARE(batch->error(), QGeoCodeReply::NoError);
+    QCOMPARE(batch->count(), 0);
+}
+
+QTEST_GUILESS_MAIN(tst_QGeoCodeBatchReply)
+
+#include "tst_qgeocodebatchreply.moc"
@@ -178,6 +178,68 @@ void tst_QGeoCodingManager::reverseGeocode()
 
 }
 
+void tst_QGeoCodingManager::batchSearch()
+{
+    QStringList searches;
+    searches << "Berlin" << "Brisbane" << "Oslo";
+
+    QGeoCodeBatchReply *reply = qgeocodingmanager->geocode(searches, 1);
+
+    // The replies of the items are not reported, the batch finishes later.
+    QCOMPARE(reply->count(), searches.size());
+    QVERIFY(reply->isItemFinished(0));
+    QVERIFY(reply->isItemFinished(2));
+    QCOMPARE(signalfinished->count(), 0);
+    QTRY_COMPARE(signalfinished->count(), 1);
+    QCOMPARE(signalfinished->first().first().value<QGeoCodeReply *>(), static_cast<QGeoCodeReply *>(reply));
+    QCOMPARE(signalerror->count(), 0);
+    QVERIFY(reply->isFinished());
+    QCOMPARE(reply->error(), QGeoCodeReply::NoError);
+
+    delete reply;
+}
+
+void tst_QGeoCodingManager::batchGeocode()
+{
+    QList<QGeoAddress> addresses;
+    for (const QString &city : {QStringLiteral("Berlin"), QStringLiteral("Oslo")}) {
+        QGeoAddress address;
+        address.setCity(city);
+        addresses.append(address);
+    }
+
+    QGeoCodeBatchReply *reply = qgeocodingmanager->geocode(addresses);
+
+    QCOMPARE(reply->count(), addresses.size());
+    QCOMPARE(signalfinished->count(), 0);
+    QTRY_COMPARE(signalfinished->count(), 1);
+    QCOMPARE(signalerror->count(), 0);
+    QVERIFY(reply->isItemFinished(1));
+
+    delete reply;
+}
+
+void tst_QGeoCodingManager::batchReverseGeocode()
+{
+    QList<QGeoCoordinate> coordinates;
+    coordinates << QGeoCoordinate(34.34, 56.65) << QGeoCoordinate(-27.5, 153.0);
+
+    QGeoCodeBatchReply *reply = qgeocodingmanager->reverseGeocode(coordinates);
+
+    QCOMPARE(reply->count(), coordinates.size());
+    QCOMPARE(signalfinished->count(), 0);
+    QTRY_COMPARE(signalfinished->count(), 1);
+    QCOMPARE(signalerror->count(), 0);
+
+    // A single item is still reported once, as a batch.
+    QGeoCodeBatchReply *single = qgeocodingmanager->reverseGeocode(coordinates.mid(0, 1));
+    QTRY_COMPARE(signalfinished->count(), 2);
+    QCOMPARE(signalfinished->last().first().value<QGeoCodeReply *>(), static_cast<QGeoCodeReply *>(single));
+
+    delete reply;
+    delete single;
+}
+
 
 QTEST_GUILESS_MAIN(tst_QGeoCodingManager)
 
@@ -0,0 +1,7 @@
+TEMPLATE = app
+CONFIG += testcase
+TARGET = tst_qgeofiletilecachewriter
+
+SOURCES += tst_qgeofiletilecachewriter.cpp
+
+QT += location-private testlib
@@ -0,0 +1,151 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QtTest>
+#include <QtLocation/private/qgeofiletilecachewriter_p.h>
+
+QT_USE_NAMESPACE
+
+class tst_QGeoFileTileCacheWriter : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void write();
+    void remove();
+    void coalesce();
+    void flushOnDestruction();
+
+private:
+    static QByteArray readFile(const QString &filename);
+};
+
+QByteArray tst_QGeoFileTileCacheWriter::readFile(const QString &filename)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+    return file.readAll();
+}
+
+void tst_QGeoFileTileCacheWriter::write()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString filename = dir.filePath(QStringLiteral("osm-1-2-3-4.png"));
+
+    QGeoFileTileCacheWriter writer;
+    writer.write(filename, QByteArrayLiteral("tile"));
+
+    // The bytes are available until the file has been written.
+    QByteArray bytes;
+    if (writer.pending(filename, &bytes))
+        QCOMPARE(bytes, QByteArrayLiteral("tile"));
+
+    writer.flush();
+    QVERIFY(!writer.pending(filename, &bytes));
+    QCOMPARE(readFile(filename), QByteArrayLiteral("tile"));
+}
+
+void tst_QGeoFileTileCacheWriter::remove()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString filename = dir.filePath(QStringLiteral("osm-1-2-3-4.png"));
+
+    QGeoFileTileCacheWriter writer;
+    writer.write(filename, QByteArrayLiteral("tile"));
+    writer.flush();
+    QVERIFY(QFile::exists(filename));
+
+    writer.remove(filename);
+    QByteArray bytes = QByteArrayLiteral("unchanged");
+    if (writer.pending(filename, &bytes))
+        QVERIFY(bytes.isEmpty());
+
+    writer.flush();
+    QVERIFY(!QFile::exists(filename));
+
+    // Removing a file that does not exist is harmless.
+    writer.remove(filename);
+    writer.flush();
+    QVERIFY(!QFile::exists(filename));
+}
+
+void tst_QGeoFileTileCacheWriter::coalesce()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    QGeoFileTileCacheWriter writer;
+    QStringList filenames;
+    for (int i = 0; i < 100; ++i) {
+        const QString filename = dir.filePath(QStringLiteral("osm-1-10-%1-0.png").arg(i));
+        filenames.append(filename);
+        writer.write(filename, QByteArray::number(i));
+        writer.remove(filename);
+        writer.write(filename, QByteArray::number(i * 2));
+    }
+    writer.flush();
+
+    for (int i = 0; i < filenames.size(); ++i)
+        QCOMPARE(readFile(filenames.at(i)), QByteArray::number(i * 2));
+
+    for (const QString &filename : qAsConst(filenames)) {
+        writer.write(filename, QByteArrayLiteral("replaced"));
+        writer.remove(filename);
+    }
+    writer.flush();
+
+    QCOMPARE(QDir(dir.path()).entryList(QDir::Files).count(), 0);
+}
+
+void tst_QGeoFileTileCacheWriter::flushOnDestruction()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    QStringList filenames;
+    {
+        QGeoFileTileCacheWriter writer;
+        for (int i = 0; i < 50; ++i) {
+            filenames.append(dir.filePath(QStringLiteral("osm-1-10-%1-0.png").arg(i)));
+            writer.write(filenames.last(), QByteArray(256, char(i)));
+        }
+    }
+
+    for (int i = 0; i < filenames.size(); ++i)
+        QCOMPARE(readFile(filenames.at(i)), QByteArray(256, char(i)));
+}
+
+QTEST_APPLESS_MAIN(tst_QGeoFileTileCacheWriter)
+
+#include "tst_qgeofiletilecachewriter.moc"
@@ -0,0 +1,7 @@
+TEMPLATE = app
+CONFIG+=testcase
+TARGET=tst_qgeogreatcircle
+
+SOURCES += tst_qgeogreatcircle.cpp
+
+QT += positioning-private testlib
@@ -0,0 +1,178 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <QtPositioning/QGeoCoordinate>
+#include <QtPositioning/QGeoPath>
+#include <QtPositioning/private/qgeogreatcircle_p.h>
+
+QT_USE_NAMESPACE
+
+class tst_QGeoGreatCircle : public QObject
+{
+    Q_OBJECT
+
+private:
+    QList<QGeoCoordinate> samplePoints() const
+    {
+        return QList<QGeoCoordinate>()
+                << QGeoCoordinate(-27.46758, 153.027892)
+                << QGeoCoordinate(-27.4676, 153.0279)
+                << QGeoCoordinate(-33.8688, 151.2093)
+                << QGeoCoordinate(51.5074, -0.1278)
+                << QGeoCoordinate(40.7128, -74.0060)
+                << QGeoCoordinate(64.1466, -21.9426)
+                << QGeoCoordinate(-77.8463, 166.6682)
+                << QGeoCoordinate(27.4, -26.9) // close to the antipode of the origin
+                << QGeoCoordinate(0.0, 179.9)
+                << QGeoCoordinate(0.0, -179.9);
+    }
+
+private slots:
+    void distancesFrom()
+    {
+        const QGeoCoordinate origin(-27.46758, 153.027892);
+        const QList<QGeoCoordinate> points = samplePoints();
+        const QVector<double> packed = QGeoGreatCircle::pack(points);
+        QVector<double> distances(points.size());
+
+        QGeoGreatCircle::distancesFrom(origin, packed.constData(), points.size(), distances.data());
+        for (int i = 0; i < points.size(); ++i)
+            QVERIFY(qAbs(distances.at(i) - origin.distanceTo(points.at(i))) < 1e-6);
+
+        QGeoGreatCircle::distancesFrom(QGeoCoordinate(), packed.constData(), points.size(),
+                                       distances.data());
+        for (double d : qAsConst(distances))
+            QCOMPARE(d, 0.0);
+    }
+
+    void approximateDistances_data()
+    {
+        QTest::addColumn<QGeoCoordinate>("origin");
+        QTest::addColumn<double>("distance");
+        QTest::addColumn<double>("tolerance");
+
+        QTest::newRow("brisbane 1km") << QGeoCoordinate(-27.46758, 153.027892) << 1000.0 << 1e-5;
+        QTest::newRow("oslo 10km") << QGeoCoordinate(59.9139, 10.7522) << 10000.0 << 1e-5;
+        QTest::newRow("dateline 50km") << QGeoCoordinate(-17.7134, 179.99) << 50000.0 << 5e-4;
+        QTest::newRow("north 100km") << QGeoCoordinate(78.0, 15.0) << 100000.0 << 5e-4;
+    }
+
+    void approximateDistances()
+    {
+        QFETCH(QGeoCoordinate, origin);
+        QFETCH(double, distance);
+        QFETCH(double, tolerance);
+
+        QVector<double> azimuths;
+        for (int a = 0; a < 360; a += 15)
+            azimuths << a;
+        QVector<double> packed(2 * azimuths.size());
+        QGeoGreatCircle::pointsAtDistance(origin, distance, azimuths.constData(), azimuths.size(),
+                                          packed.data());
+
+        QVector<double> distances(azimuths.size());
+        QGeoGreatCircle::distancesFrom(origin, packed.constData(), azimuths.size(),
+                                       distances.data(), QGeoGreatCircle::Approximate);
+        for (double d : qAsConst(distances))
+            QVERIFY2(qAbs(d - distance) / distance < tolerance, qPrintable(QString::number(d)));
+    }
+
+    void azimuthsFrom()
+    {
+        const QGeoCoordinate origin(-27.46758, 153.027892);
+        const QList<QGeoCoordinate> points = samplePoints().mid(2);
+        const QVector<double> packed = QGeoGreatCircle::pack(points);
+        QVector<double> azimuths(points.size());
+
+        QGeoGreatCircle::azimuthsFrom(origin, packed.constData(), points.size(), azimuths.data());
+        for (int i = 0; i < points.size(); ++i) {
+            QVERIFY(azimuths.at(i) >= 0.0 && azimuths.at(i) < 360.0);
+            QVERIFY(qAbs(azimuths.at(i) - origin.azimuthTo(points.at(i))) < 1e-9);
+        }
+    }
+
+    void pointsAtDistance()
+    {
+        const QGeoCoordinate origin(51.5074, -0.1278);
+        const QVector<double> azimuths = QVector<double>() << 0 << 45 << 90 << 180 << 270 << 359.5;
+        QVector<double> packed(2 * azimuths.size());
+
+        QGeoGreatCircle::pointsAtDistance(origin, 1500000, azimuths.constData(), azimuths.size(),
+                                          packed.data());
+        for (int i = 0; i < azimuths.size(); ++i) {
+            const QGeoCoordinate expected = origin.atDistanceAndAzimuth(1500000, azimuths.at(i));
+            QVERIFY(qAbs(packed.at(2 * i) - expected.latitude()) < 1e-9);
+            QVERIFY(qAbs(packed.at(2 * i + 1) - expected.longitude()) < 1e-9);
+        }
+    }
+
+    void cumulativeLengths()
+    {
+        const QList<QGeoCoordinate> points = samplePoints();
+        const QVector<double> packed = QGeoGreatCircle::pack(points);
+        QVector<double> lengths(points.size());
+
+        const double total = QGeoGreatCircle::cumulativeLengths(packed.constData(), points.size(),
+                                                                lengths.data());
+        double expected = 0.0;
+        QCOMPARE(lengths.first(), 0.0);
+        for (int i = 1; i < points.size(); ++i) {
+            expected += points.at(i - 1).distanceTo(points.at(i));
+            QVERIFY(qAbs(lengths.at(i) - expected) < 1e-3);
+        }
+        QCOMPARE(total, lengths.last());
+        QCOMPARE(QGeoGreatCircle::cumulativeLengths(packed.constData(), 0), 0.0);
+        QCOMPARE(QGeoGreatCircle::cumulativeLengths(packed.constData(), 1), 0.0);
+    }
+
+    void pathLength()
+    {
+        QList<QGeoCoordinate> points = samplePoints();
+        double expected = 0.0;
+        for (int i = 2; i < 6; ++i)
+            expected += points.at(i).distanceTo(points.at(i + 1));
+        QVERIFY(qAbs(QGeoGreatCircle::pathLength(points, 2, 6) - expected) < 1e-3);
+
+        // invalid vertices contribute nothing, as with QGeoCoordinate::distanceTo()
+        points.insert(3, QGeoCoordinate());
+        expected = points.at(4).distanceTo(points.at(5));
+        QVERIFY(qAbs(QGeoGreatCircle::pathLength(points, 2, 5) - expected) < 1e-3);
+
+        const QGeoPath path(samplePoints());
+        double pathExpected = 0.0;
+        for (int i = 0; i < path.size() - 1; ++i)
+            pathExpected += path.coordinateAt(i).distanceTo(path.coordinateAt(i + 1));
+        QVERIFY(qAbs(path.length(0, path.size() - 1) - pathExpected) < 1e-3);
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_QGeoGreatCircle)
+
+#include "tst_qgeogreatcircle.moc"
@@ -0,0 +1,7 @@
+TEMPLATE = app
+CONFIG+=testcase
+TARGET=tst_qgeopositioninfosourcehub
+
+SOURCES += tst_qgeopositioninfosourcehub.cpp
+
+QT += positioning-private testlib
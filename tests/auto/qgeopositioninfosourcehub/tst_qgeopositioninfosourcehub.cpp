@@ -0,0 +1,279 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <QtTest/QSignalSpy>
+#include <QtPositioning/QGeoPositionInfoSource>
+#include <QtPositioning/private/qgeopositioninfosourcehub_p.h>
+
+QT_USE_NAMESPACE
+
+class DummyBackend : public QGeoPositionInfoSource
+{
+    Q_OBJECT
+public:
+    DummyBackend() : QGeoPositionInfoSource(nullptr), running(false), starts(0), requests(0) {}
+
+    QGeoPositionInfo lastKnownPosition(bool = false) const override { return last; }
+    PositioningMethods supportedPositioningMethods() const override { return SatellitePositioningMethods; }
+    int minimumUpdateInterval() const override { return 10; }
+    Error error() const override { return NoError; }
+
+    void startUpdates() override { running = true; ++starts; }
+    void stopUpdates() override { running = false; }
+    void requestUpdate(int) override { ++requests; }
+
+    void feed(const QDateTime &ts)
+    {
+        last = QGeoPositionInfo(QGeoCoordinate(60.0, 25.0), ts);
+        emit positionUpdated(last);
+    }
+
+    QGeoPositionInfo last;
+    bool running;
+    int starts;
+    int requests;
+};
+
+static QPointer<DummyBackend> lastBackend;
+
+static QGeoPositionInfoSource *createBackend()
+{
+    DummyBackend *backend = new DummyBackend;
+    lastBackend = backend;
+    return backend;
+}
+
+class tst_QGeoPositionInfoSourceHub : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void sharing();
+    void backendRate();
+    void fanOut();
+    void updateInterval();
+    void decimation();
+    void requestUpdate();
+    void release();
+    void releaseWhileDispatching();
+    void releaseFromRequest();
+};
+
+void tst_QGeoPositionInfoSourceHub::sharing()
+{
+    QScopedPointer<QGeoPositionInfoSource> a(
+                QGeoPositionInfoSourceHub::createSharedSource(QStringLiteral("sharing"), createBackend, nullptr));
+    QPointer<DummyBackend> backend = lastBackend;
+    QScopedPointer<QGeoPositionInfoSource> b(
+                QGeoPositionInfoSourceHub::createSharedSource(QStringLiteral("sharing"), createBackend, nullptr));
+    QVERIFY(a && b);
+    QCOMPARE(lastBackend.data(), backend.data()); // no second backend created
+
+    a.reset();
+    b.reset();
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    QVERIFY(backend.isNull());
+}
+
+void tst_QGeoPositionInfoSourceHub::backendRate()
+{
+    QSharedPointer<QGeoPositionInfoSourceHub> hub =
+            QGeoPositionInfoSourceHub::sharedHub(QStringLiteral("rate"), createBackend);
+    DummyBackend *backend = static_cast<DummyBackend *>(hub->backend());
+
+    QGeoSharedPositionInfoSource a(hub);
+    QGeoSharedPositionInfoSource b(hub);
+    a.setUpdateInterval(1000);
+    b.setUpdateInterval(200);
+    QVERIFY(!backend->running);
+
+    a.startUpdates();
+    QVERIFY(backend->running);
+    QCOMPARE(backend->updateInterval(), 1000);
+
+    b.startUpdates();
+    QCOMPARE(backend->updateInterval(), 200);
+    QCOMPARE(backend->starts, 1);
+
+    b.stopUpdates();
+    QCOMPARE(backend->updateInterval(), 1000);
+
+    b.setUpdateInterval(0);
+    b.startUpdates();
+    QCOMPARE(backend->updateInterval(), 0);
+
+    a.stopUpdates();
+    b.stopUpdates();
+    QVERIFY(!backend->running);
+    QCOMPARE(hub->activeSubscriberCount(), 0);
+}
+
+void tst_QGeoPositionInfoSourceHub::fanOut()
+{
+    QSharedPointer<QGeoPositionInfoSourceHub> hub =
+            QGeoPositionInfoSourceHub::sharedHub(QStringLiteral("fanout"), createBackend);
+    DummyBackend *backend = static_cast<DummyBackend *>(hub->backend());
+
+    QGeoSharedPositionInfoSource a(hub);
+    QGeoSharedPositionInfoSource b(hub);
+    QGeoSharedPositionInfoSource idle(hub);
+    QSignalSpy spyA(&a, SIGNAL(positionUpdated(QGeoPositionInfo)));
+    QSignalSpy spyB(&b, SIGNAL(positionUpdated(QGeoPositionInfo)));
+    QSignalSpy spyIdle(&idle, SIGNAL(positionUpdated(QGeoPositionInfo)));
+    a.startUpdates();
+    b.startUpdates();
+
+    const QDateTime start = QDateTime::currentDateTimeUtc();
+    for (int i = 0; i < 5; ++i)
+        backend->feed(start.addMSecs(i * 100));
+
+    QCOMPARE(spyA.count(), 5);
+    QCOMPARE(spyB.count(), 5);
+    QCOMPARE(spyIdle.count(), 0);
+    QCOMPARE(a.lastKnownPosition(), backend->last);
+}
+
+void tst_QGeoPositionInfoSourceHub::updateInterval()
+{
+    QSharedPointer<QGeoPositionInfoSourceHub> hub =
+            QGeoPositionInfoSourceHub::sharedHub(QStringLiteral("interval"), createBackend);
+    DummyBackend *backend = static_cast<DummyBackend *>(hub->backend());
+
+    QGeoSharedPositionInfoSource fast(hub);
+    QGeoSharedPositionInfoSource slow(hub);
+    slow.setUpdateInterval(1000);
+    QSignalSpy spyFast(&fast, SIGNAL(positionUpdated(QGeoPositionInfo)));
+    QSignalSpy spySlow(&slow, SIGNAL(positionUpdated(QGeoPositionInfo)));
+    fast.startUpdates();
+    slow.startUpdates();
+
+    const QDateTime start = QDateTime::currentDateTimeUtc();
+    for (int i = 0; i < 30; ++i)
+        backend->feed(start.addMSecs(i * 100));
+
+    QCOMPARE(spyFast.count(), 30);
+    QCOMPARE(spySlow.count(), 3);
+}
+
+void tst_QGeoPositionInfoSourceHub::decimation()
+{
+    QSharedPointer<QGeoPositionInfoSourceHub> hub =
+            QGeoPositionInfoSourceHub::sharedHub(QStringLiteral("decimation"), createBackend);
+    DummyBackend *backend = static_cast<DummyBackend *>(hub->backend());
+
+    QGeoSharedPositionInfoSource source(hub);
+    QVERIFY(source.setProperty("decimation", 4));
+    QCOMPARE(source.decimation(), 4);
+    QSignalSpy spy(&source, SIGNAL(positionUpdated(QGeoPositionInfo)));
+    source.startUpdates();
+
+    const QDateTime start = QDateTime::currentDateTimeUtc();
+    for (int i = 0; i < 12; ++i)
+        backend->feed(start.addMSecs(i * 100));
+
+    QCOMPARE(spy.count(), 3);
+}
+
+void tst_QGeoPositionInfoSourceHub::requestUpdate()
+{
+    QSharedPointer<QGeoPositionInfoSourceHub> hub =
+            QGeoPositionInfoSourceHub::sharedHub(QStringLiteral("request"), createBackend);
+    DummyBackend *backend = static_cast<DummyBackend *>(hub->backend());
+
+    QGeoSharedPositionInfoSource a(hub);
+    QGeoSharedPositionInfoSource b(hub);
+    QSignalSpy spyA(&a, SIGNAL(positionUpdated(QGeoPositionInfo)));
+    QSignalSpy spyB(&b, SIGNAL(positionUpdated(QGeoPositionInfo)));
+    QSignalSpy timeoutB(&b, SIGNAL(updateTimeout()));
+
+    a.requestUpdate(5000);
+    b.requestUpdate(50);
+    QCOMPARE(backend->requests, 1);
+    QVERIFY(!backend->running);
+
+    QTRY_COMPARE(timeoutB.count(), 1);
+    backend->feed(QDateTime::currentDateTimeUtc());
+    QCOMPARE(spyA.count(), 1);
+    QCOMPARE(spyB.count(), 0);
+}
+
+void tst_QGeoPositionInfoSourceHub::release()
+{
+    QScopedPointer<QGeoPositionInfoSource> a(
+                QGeoPositionInfoSourceHub::createSharedSource(QStringLiteral("release"), createBackend, nullptr));
+    QPointer<DummyBackend> backend = lastBackend;
+    a->startUpdates();
+    QVERIFY(backend->running);
+
+    // The backend, and with it the device, goes away with the last subscriber.
+    a.reset();
+    QVERIFY(backend.isNull());
+
+    a.reset(QGeoPositionInfoSourceHub::createSharedSource(QStringLiteral("release"), createBackend, nullptr));
+    QVERIFY(a);
+    QVERIFY(!lastBackend.isNull());
+}
+
+void tst_QGeoPositionInfoSourceHub::releaseWhileDispatching()
+{
+    QGeoPositionInfoSource *a =
+            QGeoPositionInfoSourceHub::createSharedSource(QStringLiteral("dispatch"), createBackend, nullptr);
+    QPointer<DummyBackend> backend = lastBackend;
+    connect(a, &QGeoPositionInfoSource::positionUpdated, a, [a]() { delete a; });
+    a->startUpdates();
+
+    // The backend is stopped at once, but is still emitting the update.
+    backend->feed(QDateTime::currentDateTimeUtc());
+    QVERIFY(!backend.isNull());
+    QVERIFY(!backend->running);
+
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    QVERIFY(backend.isNull());
+}
+
+void tst_QGeoPositionInfoSourceHub::releaseFromRequest()
+{
+    QGeoPositionInfoSource *a =
+            QGeoPositionInfoSourceHub::createSharedSource(QStringLiteral("releaseRequest"), createBackend, nullptr);
+    QPointer<DummyBackend> backend = lastBackend;
+    QPointer<QGeoPositionInfoSource> guard(a);
+    connect(a, &QGeoPositionInfoSource::positionUpdated, a, [a]() { delete a; });
+
+    // The subscriber is gone once the update answering its request is emitted.
+    a->requestUpdate(5000);
+    backend->feed(QDateTime::currentDateTimeUtc());
+    QVERIFY(guard.isNull());
+
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    QVERIFY(backend.isNull());
+}
+
+QTEST_GUILESS_MAIN(tst_QGeoPositionInfoSourceHub)
+#include "tst_qgeopositioninfosourcehub.moc"
@@ -0,0 +1,9 @@
+TEMPLATE = app
+CONFIG+=testcase
+TARGET=tst_qgeorouteprogresstracker
+
+SOURCES += tst_qgeorouteprogresstracker.cpp
+
+CONFIG -= app_bundle
+
+QT += testlib location-private positioning
@@ -0,0 +1,260 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtLocation/QGeoRoute>
+#include <QtLocation/QGeoRouteSegment>
+#include <QtLocation/private/qgeorouteprogresstracker_p.h>
+
+QT_USE_NAMESPACE
+
+class tst_QGeoRouteProgressTracker : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void emptyRoute();
+    void progress();
+    void segments();
+    void routePathFallback();
+    void offRoute();
+    void reacquire();
+    void overlappingPath();
+    void antimeridian();
+
+private:
+    static QList<QGeoCoordinate> line(const QGeoCoordinate &start, double azimuth,
+                                      double spacing, int count);
+    static QGeoRoute routeFromSegments(const QList<QList<QGeoCoordinate>> &paths);
+};
+
+QList<QGeoCoordinate> tst_QGeoRouteProgressTracker::line(const QGeoCoordinate &start,
+                                                        double azimuth, double spacing, int count)
+{
+    QList<QGeoCoordinate> path;
+    QGeoCoordinate position = start;
+    for (int i = 0; i < count; ++i) {
+        path.append(position);
+        position = position.atDistanceAndAzimuth(spacing, azimuth);
+    }
+    return path;
+}
+
+QGeoRoute tst_QGeoRouteProgressTracker::routeFromSegments(const QList<QList<QGeoCoordinate>> &paths)
+{
+    QList<QGeoRouteSegment> segments;
+    QList<QGeoCoordinate> routePath;
+    for (const QList<QGeoCoordinate> &path : paths) {
+        QGeoRouteSegment segment;
+        segment.setPath(path);
+        if (!segments.isEmpty())
+            segments.last().setNextRouteSegment(segment);
+        segments.append(segment);
+        routePath.append(path);
+    }
+
+    QGeoRoute route;
+    if (!segments.isEmpty())
+        route.setFirstRouteSegment(segments.first());
+    route.setPath(routePath);
+    return route;
+}
+
+void tst_QGeoRouteProgressTracker::emptyRoute()
+{
+    QGeoRouteProgressTracker tracker;
+    QVERIFY(tracker.isEmpty());
+    QVERIFY(!tracker.update(QGeoCoordinate(10.0, 10.0)));
+    QVERIFY(!tracker.isMatched());
+    QVERIFY(!tracker.isOffRoute());
+
+    tracker.setRoute(routeFromSegments({ { QGeoCoordinate(10.0, 10.0) } }));
+    QVERIFY(tracker.isEmpty());
+    QCOMPARE(tracker.totalDistance(), 0.0);
+    QCOMPARE(tracker.currentEdge(), -1);
+}
+
+void tst_QGeoRouteProgressTracker::progress()
+{
+    const QList<QGeoCoordinate> path = line(QGeoCoordinate(52.5, 13.4), 90.0, 100.0, 101);
+    QGeoRouteProgressTracker tracker;
+    tracker.setRoute(routeFromSegments({ path }));
+    QVERIFY(!tracker.isEmpty());
+
+    const double total = tracker.totalDistance();
+    QVERIFY(qAbs(total - 10000.0) < 1.0);
+
+    // drive along the route, 10 m to the side of it
+    for (int i = 0; i < 100; ++i) {
+        const QGeoCoordinate onRoute = path.at(i).atDistanceAndAzimuth(50.0, 90.0);
+        QVERIFY(tracker.update(onRoute.atDistanceAndAzimuth(10.0, 0.0)));
+        QVERIFY(tracker.isMatched());
+        QVERIFY(!tracker.isOffRoute());
+        QCOMPARE(tracker.currentEdge(), i);
+        QVERIFY(qAbs(tracker.traveledDistance() - (i * 100.0 + 50.0)) < 0.5);
+        QVERIFY(qAbs(tracker.remainingDistance() - (total - tracker.traveledDistance())) < 1e-6);
+        QVERIFY(qAbs(tracker.deviation() - 10.0) < 0.1);
+        QVERIFY(tracker.matchedCoordinate().distanceTo(onRoute) < 0.5);
+    }
+
+    tracker.reset();
+    QVERIFY(!tracker.isMatched());
+    QCOMPARE(tracker.traveledDistance(), 0.0);
+    QCOMPARE(tracker.remainingDistance(), total);
+}
+
+void tst_QGeoRouteProgressTracker::segments()
+{
+    const QList<QGeoCoordinate> path = line(QGeoCoordinate(-33.9, 18.4), 45.0, 50.0, 31);
+    QGeoRouteProgressTracker tracker;
+    // consecutive segments share their end points
+    tracker.setRoute(routeFromSegments({ path.mid(0, 11), path.mid(10, 11), path.mid(20, 11) }));
+    QVERIFY(qAbs(tracker.totalDistance() - 1500.0) < 0.5);
+
+    QVERIFY(tracker.update(path.at(3).atDistanceAndAzimuth(25.0, 45.0)));
+    QCOMPARE(tracker.currentSegment(), 0);
+    QCOMPARE(tracker.currentEdge(), 3);
+    QVERIFY(tracker.update(path.at(12).atDistanceAndAzimuth(25.0, 45.0)));
+    QCOMPARE(tracker.currentSegment(), 1);
+    QCOMPARE(tracker.currentEdge(), 12);
+    QVERIFY(tracker.update(path.at(29).atDistanceAndAzimuth(25.0, 45.0)));
+    QCOMPARE(tracker.currentSegment(), 2);
+    QCOMPARE(tracker.currentEdge(), 29);
+}
+
+void tst_QGeoRouteProgressTracker::routePathFallback()
+{
+    QGeoRoute route;
+    route.setPath(line(QGeoCoordinate(0.0, 0.0), 0.0, 100.0, 11));
+
+    QGeoRouteProgressTracker tracker;
+    tracker.setRoute(route);
+    QVERIFY(!tracker.isEmpty());
+    QVERIFY(tracker.update(QGeoCoordinate(0.0049, 0.0)));
+    QCOMPARE(tracker.currentSegment(), 0);
+    QCOMPARE(tracker.currentEdge(), 5);
+}
+
+void tst_QGeoRouteProgressTracker::offRoute()
+{
+    const QList<QGeoCoordinate> path = line(QGeoCoordinate(45.0, 7.0), 0.0, 100.0, 51);
+    QGeoRouteProgressTracker tracker;
+    tracker.setOffRouteDistance(30.0);
+    tracker.setOffRouteCount(3);
+    tracker.setRoute(routeFromSegments({ path }));
+
+    QVERIFY(tracker.update(path.at(10)));
+    const double traveled = tracker.traveledDistance();
+
+    // a single bad position does not count as leaving the route
+    const QGeoCoordinate away = path.at(11).atDistanceAndAzimuth(200.0, 90.0);
+    QVERIFY(!tracker.update(away));
+    QVERIFY(!tracker.isOffRoute());
+    QCOMPARE(tracker.traveledDistance(), traveled);
+    QVERIFY(qAbs(tracker.deviation() - 200.0) < 1.0);
+    QVERIFY(tracker.update(path.at(11)));
+    QVERIFY(!tracker.isOffRoute());
+
+    QVERIFY(!tracker.update(away));
+    QVERIFY(!tracker.update(away));
+    QVERIFY(!tracker.isOffRoute());
+    QVERIFY(!tracker.update(away));
+    QVERIFY(tracker.isOffRoute());
+    QVERIFY(qIsInf(tracker.deviation()) || tracker.deviation() > 30.0);
+
+    // back on the route
+    QVERIFY(tracker.update(path.at(12).atDistanceAndAzimuth(50.0, 0.0).atDistanceAndAzimuth(20.0, 270.0)));
+    QVERIFY(!tracker.isOffRoute());
+    QCOMPARE(tracker.currentEdge(), 12);
+}
+
+void tst_QGeoRouteProgressTracker::reacquire()
+{
+    const QList<QGeoCoordinate> path = line(QGeoCoordinate(60.0, 25.0), 90.0, 20.0, 5001);
+    QGeoRouteProgressTracker tracker;
+    tracker.setLookAheadDistance(200.0);
+    tracker.setRoute(routeFromSegments({ path }));
+
+    // the first match and a jump beyond the look ahead distance use the grid
+    QVERIFY(tracker.update(path.at(4000).atDistanceAndAzimuth(10.0, 90.0)));
+    QCOMPARE(tracker.currentEdge(), 4000);
+    QVERIFY(tracker.update(path.at(100).atDistanceAndAzimuth(10.0, 90.0)));
+    QCOMPARE(tracker.currentEdge(), 100);
+    QVERIFY(tracker.update(path.at(3000).atDistanceAndAzimuth(10.0, 90.0)));
+    QCOMPARE(tracker.currentEdge(), 3000);
+}
+
+void tst_QGeoRouteProgressTracker::overlappingPath()
+{
+    // there and back along the same road
+    QList<QGeoCoordinate> path = line(QGeoCoordinate(48.0, 2.0), 90.0, 100.0, 21);
+    for (int i = 19; i >= 0; --i)
+        path.append(path.at(i));
+
+    QGeoRouteProgressTracker tracker;
+    tracker.setLookAheadDistance(300.0);
+    tracker.setRoute(routeFromSegments({ path }));
+
+    for (int i = 0; i < 20; ++i) {
+        QVERIFY(tracker.update(path.at(i).atDistanceAndAzimuth(50.0, 90.0)));
+        QCOMPARE(tracker.currentEdge(), i);
+    }
+    // the first edge back is as close as the last edge there, skip it
+    for (int i = 21; i < 40; ++i) {
+        QVERIFY(tracker.update(path.at(i).atDistanceAndAzimuth(50.0, 270.0)));
+        QCOMPARE(tracker.currentEdge(), i);
+    }
+    QVERIFY(tracker.remainingDistance() < 51.0);
+}
+
+void tst_QGeoRouteProgressTracker::antimeridian()
+{
+    const QList<QGeoCoordinate> path = line(QGeoCoordinate(-17.0, 179.99), 90.0, 100.0, 41);
+    QVERIFY(path.last().longitude() < 0.0);
+
+    QGeoRouteProgressTracker tracker;
+    tracker.setRoute(routeFromSegments({ path }));
+    QVERIFY(qAbs(tracker.totalDistance() - 4000.0) < 1.0);
+
+    for (int i = 0; i < 40; ++i) {
+        QVERIFY(tracker.update(path.at(i).atDistanceAndAzimuth(50.0, 90.0)));
+        QCOMPARE(tracker.currentEdge(), i);
+    }
+
+    // the grid wraps around too
+    tracker.reset();
+    const int crossing = 11;
+    QVERIFY(path.at(crossing - 1).longitude() > 0.0);
+    QVERIFY(path.at(crossing).longitude() < 0.0);
+    QVERIFY(tracker.update(path.at(crossing - 1).atDistanceAndAzimuth(60.0, 90.0)));
+    QCOMPARE(tracker.currentEdge(), crossing - 1);
+}
+
+QTEST_GUILESS_MAIN(tst_QGeoRouteProgressTracker)
+
+#include "tst_qgeorouteprogresstracker.moc"
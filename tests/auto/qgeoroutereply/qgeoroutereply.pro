@@ -6,4 +6,4 @@ TARGET=tst_qgeoroutereply
 HEADERS += tst_qgeoroutereply.h
 SOURCES += tst_qgeoroutereply.cpp
 
-QT += location testlib
+QT += location-private testlib
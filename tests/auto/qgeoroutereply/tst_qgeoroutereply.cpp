@@ -239,4 +239,82 @@ void tst_QGeoRouteReply::request()
     delete rr;
 }
 
-QTEST_APPLESS_MAIN(tst_QGeoRouteReply);
+void tst_QGeoRouteReply::parseAsync()
+{
+    SubRouteReply *rr = new SubRouteReply(*qgeorouterequest);
+    QSignalSpy finishedSpy(rr, SIGNAL(finished()));
+    QSignalSpy errorSpy(rr, SIGNAL(error(QGeoRouteReply::Error,QString)));
+    const QThread *mainThread = QThread::currentThread();
+    const QList<QGeoCoordinate> path = waypoints;
+
+    QGeoRouteReplyPrivate::parseAsync(rr, [mainThread, path](QList<QGeoRoute> &routes, QString &) {
+        // parsing happens away from the thread of the reply
+        if (QThread::currentThread() == mainThread)
+            return QGeoRouteReply::UnknownError;
+        QGeoRoute route;
+        route.setPath(path);
+        routes.append(route);
+        return QGeoRouteReply::NoError;
+    });
+
+    QVERIFY(!rr->isFinished());
+    QTRY_COMPARE(finishedSpy.count(), 1);
+    QCOMPARE(errorSpy.count(), 0);
+    QCOMPARE(rr->error(), QGeoRouteReply::NoError);
+    QCOMPARE(rr->routes().size(), 1);
+    QCOMPARE(rr->routes().first().path(), waypoints);
+
+    delete rr;
+}
+
+void tst_QGeoRouteReply::parseAsyncError()
+{
+    SubRouteReply *rr = new SubRouteReply(*qgeorouterequest);
+    QSignalSpy finishedSpy(rr, SIGNAL(finished()));
+    QSignalSpy errorSpy(rr, SIGNAL(error(QGeoRouteReply::Error,QString)));
+
+    QGeoRouteReplyPrivate::parseAsync(rr, [](QList<QGeoRoute> &, QString &errorString) {
+        errorString = QStringLiteral("Bad reply");
+        return QGeoRouteReply::ParseError;
+    });
+
+    QTRY_COMPARE(errorSpy.count(), 1);
+    QCOMPARE(finishedSpy.count(), 1);
+    QCOMPARE(rr->error(), QGeoRouteReply::ParseError);
+    QCOMPARE(rr->errorString(), QStringLiteral("Bad reply"));
+    QVERIFY(rr->routes().isEmpty());
+
+    delete rr;
+}
+
+void tst_QGeoRouteReply::parseAsyncAbort()
+{
+    QSemaphore parsed;
+
+    // aborted replies get nothing delivered
+    SubRouteReply *aborted = new SubRouteReply(*qgeorouterequest);
+    QSignalSpy finishedSpy(aborted, SIGNAL(finished()));
+    QGeoRouteReplyPrivate::parseAsync(aborted, [&parsed](QList<QGeoRoute> &routes, QString &) {
+        routes.append(QGeoRoute());
+        parsed.release();
+        return QGeoRouteReply::NoError;
+    });
+    aborted->abort();
+    QVERIFY(parsed.tryAcquire(1, 5000));
+    QTest::qWait(100);
+    QCOMPARE(finishedSpy.count(), 0);
+    QVERIFY(aborted->routes().isEmpty());
+    delete aborted;
+
+    // nor do destroyed ones, the parse still runs to completion
+    SubRouteReply *destroyed = new SubRouteReply(*qgeorouterequest);
+    QGeoRouteReplyPrivate::parseAsync(destroyed, [&parsed](QList<QGeoRoute> &, QString &) {
+        parsed.release();
+        return QGeoRouteReply::NoError;
+    });
+    delete destroyed;
+    QVERIFY(parsed.tryAcquire(1, 5000));
+    QTest::qWait(100);
+}
+
+QTEST_GUILESS_MAIN(tst_QGeoRouteReply);
@@ -38,6 +38,7 @@
 #include <qgeorouterequest.h>
 #include <qgeoroutereply.h>
 #include <qgeoroute.h>
+#include <QtLocation/private/qgeoroutereply_p.h>
 
 QT_USE_NAMESPACE
 class SubRouteReply :public QGeoRouteReply
@@ -73,6 +74,9 @@ private slots:
     void error();
     void error_data();
     void request();
+    void parseAsync();
+    void parseAsyncError();
+    void parseAsyncAbort();
     //End Unit Test for QGeoRouteReply
 
 
@@ -0,0 +1,9 @@
+TEMPLATE = app
+CONFIG+=testcase
+TARGET=tst_qgeoservicecache
+
+SOURCES += tst_qgeoservicecache.cpp
+
+CONFIG -= app_bundle
+
+QT += testlib location-private positioning
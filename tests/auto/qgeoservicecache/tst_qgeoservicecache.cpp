@@ -0,0 +1,268 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <QtCore/QTemporaryDir>
+#include <QtLocation/QGeoCodeReply>
+#include <QtLocation/QGeoCodingManager>
+#include <QtLocation/QGeoRoute>
+#include <QtLocation/QGeoRouteSegment>
+#include <QtLocation/QGeoServiceProvider>
+#include <QtLocation/private/qgeoroute_p.h>
+#include <QtLocation/private/qgeoservicecache_p.h>
+#include <QtPositioning/QGeoAddress>
+#include <QtPositioning/QGeoLocation>
+
+QT_USE_NAMESPACE
+
+class tst_QGeoServiceCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void disabled();
+    void coalesce();
+    void memoryHit();
+    void errorsNotCached();
+    void abort();
+    void diskHit();
+    void routeDeepCopy();
+
+private:
+    QGeoServiceProvider *createProvider(const QVariantMap &extraParameters);
+    bool waitForFinished(QGeoCodeReply *reply);
+
+    QScopedPointer<QGeoServiceProvider> m_provider;
+    QGeoCodingManager *m_manager = nullptr;
+    QGeoServiceCache *m_cache = nullptr;
+};
+
+void tst_QGeoServiceCache::initTestCase()
+{
+#if QT_CONFIG(library)
+    /*
+     * Set custom path since CI doesn't install test plugins
+     */
+#ifdef Q_OS_WIN
+    QCoreApplication::addLibraryPath(QCoreApplication::applicationDirPath() +
+                                     QStringLiteral("/../../../../plugins"));
+#else
+    QCoreApplication::addLibraryPath(QCoreApplication::applicationDirPath()
+                                     + QStringLiteral("/../../../plugins"));
+#endif
+#endif
+
+    // The test engine answers one request at a time, after 200 ms, and
+    // asserts that it is not asked for another one meanwhile.
+    QVariantMap parameters;
+    parameters.insert(QStringLiteral("finishRequestImmediately"), false);
+    parameters.insert(QStringLiteral("cache.services.disk.size"), 0);
+    m_provider.reset(createProvider(parameters));
+    m_manager = m_provider->geocodingManager();
+    QVERIFY(m_manager);
+    m_cache = m_manager->findChild<QGeoServiceCache *>();
+    QVERIFY(m_cache);
+    QCOMPARE(m_cache->service(), QGeoServiceCache::Geocoding);
+}
+
+QGeoServiceProvider *tst_QGeoServiceCache::createProvider(const QVariantMap &extraParameters)
+{
+    QVariantMap parameters = extraParameters;
+    parameters.insert(QStringLiteral("cache.services.ttl"), 60);
+    return new QGeoServiceProvider(QStringLiteral("qmlgeo.test.plugin"), parameters, true);
+}
+
+bool tst_QGeoServiceCache::waitForFinished(QGeoCodeReply *reply)
+{
+    return QTest::qWaitFor([reply]() { return reply->isFinished(); }, 5000);
+}
+
+void tst_QGeoServiceCache::disabled()
+{
+    QGeoServiceProvider provider(QStringLiteral("qmlgeo.test.plugin"), QVariantMap(), true);
+    QVERIFY(provider.geocodingManager());
+    QVERIFY(!provider.geocodingManager()->findChild<QGeoServiceCache *>());
+}
+
+void tst_QGeoServiceCache::coalesce()
+{
+    QSignalSpy finishedSpy(m_manager, SIGNAL(finished(QGeoCodeReply*)));
+    const quint64 misses = m_cache->misses();
+    const quint64 coalesced = m_cache->coalesced();
+
+    QScopedPointer<QGeoCodeReply> first(m_manager->geocode(QStringLiteral("Berlin"), 3, 0));
+    QScopedPointer<QGeoCodeReply> second(m_manager->geocode(QStringLiteral("berlin "), 3, 0));
+    QVERIFY(first.data() != second.data());
+    QVERIFY(!first->isFinished());
+    QVERIFY(!second->isFinished());
+
+    QVERIFY(waitForFinished(first.data()));
+    QVERIFY(waitForFinished(second.data()));
+    QCOMPARE(first->error(), QGeoCodeReply::NoError);
+    QCOMPARE(first->locations().size(), 3);
+    QCOMPARE(second->locations().size(), 3);
+    QCOMPARE(second->locations().first().address().street(), QStringLiteral("Berlin"));
+    QCOMPARE(m_cache->misses(), misses + 1);
+    QCOMPARE(m_cache->coalesced(), coalesced + 1);
+
+    // Only the replies handed out are reported, not the one shared upstream.
+    QTRY_COMPARE(finishedSpy.count(), 2);
+    QList<QGeoCodeReply *> reported;
+    for (const QList<QVariant> &arguments : qAsConst(finishedSpy))
+        reported.append(arguments.first().value<QGeoCodeReply *>());
+    QVERIFY(reported.contains(first.data()));
+    QVERIFY(reported.contains(second.data()));
+}
+
+void tst_QGeoServiceCache::memoryHit()
+{
+    QScopedPointer<QGeoCodeReply> miss(m_manager->geocode(QStringLiteral("Munich"), 2, 0));
+    QVERIFY(waitForFinished(miss.data()));
+    const quint64 hits = m_cache->memoryHits();
+    const quint64 misses = m_cache->misses();
+
+    QScopedPointer<QGeoCodeReply> hit(m_manager->geocode(QStringLiteral("  MUNICH"), 2, 0));
+    QSignalSpy finishedSpy(hit.data(), SIGNAL(finished()));
+    QVERIFY(!hit->isFinished());
+    QTRY_COMPARE(finishedSpy.count(), 1);
+    QCOMPARE(hit->locations().size(), 2);
+    QCOMPARE(m_cache->memoryHits(), hits + 1);
+    QCOMPARE(m_cache->misses(), misses);
+    QVERIFY(m_cache->hitRate() > 0.0);
+
+    // A different page is a different request.
+    QScopedPointer<QGeoCodeReply> page(m_manager->geocode(QStringLiteral("Munich"), 2, 2));
+    QVERIFY(waitForFinished(page.data()));
+    QCOMPARE(m_cache->misses(), misses + 1);
+}
+
+void tst_QGeoServiceCache::errorsNotCached()
+{
+    const quint64 misses = m_cache->misses();
+    for (int i = 0; i < 2; ++i) {
+        // The test engine fails single digit requests with that error code.
+        QScopedPointer<QGeoCodeReply> reply(m_manager->geocode(QStringLiteral("2"), 1, 0));
+        QSignalSpy errorSpy(reply.data(), SIGNAL(error(QGeoCodeReply::Error,QString)));
+        QVERIFY(waitForFinished(reply.data()));
+        QCOMPARE(errorSpy.count(), 1);
+        QCOMPARE(reply->error(), QGeoCodeReply::Error(2));
+    }
+    QCOMPARE(m_cache->misses(), misses + 2);
+}
+
+void tst_QGeoServiceCache::abort()
+{
+    // Aborting one of two coalesced requests leaves the other one running.
+    QScopedPointer<QGeoCodeReply> first(m_manager->geocode(QStringLiteral("Paris"), 1, 0));
+    QScopedPointer<QGeoCodeReply> second(m_manager->geocode(QStringLiteral("Paris"), 1, 0));
+    first->abort();
+    QVERIFY(waitForFinished(second.data()));
+    QCOMPARE(second->error(), QGeoCodeReply::NoError);
+    QCOMPARE(second->locations().size(), 1);
+
+    // Aborting the last one aborts the engine request, so the engine is free
+    // to take the next one.
+    QScopedPointer<QGeoCodeReply> aborted(m_manager->geocode(QStringLiteral("Rome"), 1, 0));
+    aborted->abort();
+    QScopedPointer<QGeoCodeReply> next(m_manager->geocode(QStringLiteral("Oslo"), 1, 0));
+    QVERIFY(waitForFinished(next.data()));
+    QCOMPARE(next->locations().size(), 1);
+    QCOMPARE(next->locations().first().address().street(), QStringLiteral("Oslo"));
+}
+
+void tst_QGeoServiceCache::diskHit()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    QVariantMap parameters;
+    parameters.insert(QStringLiteral("cache.services.directory"), directory.path());
+
+    {
+        QScopedPointer<QGeoServiceProvider> provider(createProvider(parameters));
+        QVERIFY(provider->geocodingManager());
+        // The test engine returns as many locations as the longitude.
+        QScopedPointer<QGeoCodeReply> reply(
+                provider->geocodingManager()->reverseGeocode(QGeoCoordinate(10.0, 3.0)));
+        QVERIFY(waitForFinished(reply.data()));
+        QCOMPARE(reply->locations().size(), 3);
+    }
+
+    QScopedPointer<QGeoServiceProvider> provider(createProvider(parameters));
+    QGeoCodingManager *manager = provider->geocodingManager();
+    QVERIFY(manager);
+    QGeoServiceCache *cache = manager->findChild<QGeoServiceCache *>();
+    QVERIFY(cache);
+
+    QScopedPointer<QGeoCodeReply> reply(manager->reverseGeocode(QGeoCoordinate(10.00000001, 3.0)));
+    QVERIFY(waitForFinished(reply.data()));
+    QCOMPARE(cache->diskHits(), quint64(1));
+    QCOMPARE(cache->misses(), quint64(0));
+    QCOMPARE(reply->locations().size(), 3);
+    QCOMPARE(reply->locations().first().coordinate(), QGeoCoordinate(10.0, 3.0));
+}
+
+void tst_QGeoServiceCache::routeDeepCopy()
+{
+    // Cached routes are handed out as deep copies, as QGeoRoute and
+    // QGeoRouteSegment are explicitly shared.
+    QGeoRouteSegment first;
+    first.setPath({ QGeoCoordinate(1.0, 1.0), QGeoCoordinate(2.0, 2.0) });
+    QGeoRouteSegment second;
+    second.setPath({ QGeoCoordinate(2.0, 2.0), QGeoCoordinate(3.0, 3.0) });
+    first.setNextRouteSegment(second);
+
+    QGeoRoute route;
+    route.setPath({ QGeoCoordinate(1.0, 1.0), QGeoCoordinate(3.0, 3.0) });
+    route.setFirstRouteSegment(first);
+    QGeoRouteLeg leg;
+    leg.setLegIndex(0);
+    leg.setFirstRouteSegment(second);
+    leg.setOverallRoute(route);
+    route.setRouteLegs({ leg });
+
+    QGeoRoute copy = QGeoRoutePrivate::deepCopy(route);
+    QCOMPARE(copy, route);
+
+    copy.setPath({ QGeoCoordinate(5.0, 5.0) });
+    QGeoRouteSegment copySecond = copy.firstRouteSegment().nextRouteSegment();
+    copySecond.setPath({ QGeoCoordinate(6.0, 6.0) });
+    QCOMPARE(route.path().size(), 2);
+    QCOMPARE(route.firstRouteSegment().nextRouteSegment().path().size(), 2);
+    QCOMPARE(route.routeLegs().first().firstRouteSegment().path().size(), 2);
+
+    // The legs of the copy point into the copied segment chain.
+    QCOMPARE(copy.routeLegs().size(), 1);
+    QCOMPARE(copy.routeLegs().first().firstRouteSegment().path().size(), 1);
+    QCOMPARE(copy.routeLegs().first().legIndex(), 0);
+}
+
+QTEST_GUILESS_MAIN(tst_QGeoServiceCache)
+
+#include "tst_qgeoservicecache.moc"
@@ -0,0 +1,7 @@
+TEMPLATE = app
+CONFIG += testcase
+TARGET = tst_qgeosharedtileindex
+
+SOURCES += tst_qgeosharedtileindex.cpp
+
+QT += location-private testlib
@@ -0,0 +1,227 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/QScopedPointer>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QtTest>
+#include <QtLocation/private/qgeosharedtileindex_p.h>
+#include <QtLocation/private/qgeotilespec_p.h>
+
+QT_USE_NAMESPACE
+
+class tst_QGeoSharedTileIndex : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void initializer();
+    void insertAndLookup();
+    void remove();
+    void claimFetch();
+    void claimExpiry();
+    void evictLeastRecentlyUsed();
+    void clear();
+    void capacityFor();
+
+private:
+    static QGeoTileSpec tile(int x) { return QGeoTileSpec(QStringLiteral("test"), 1, 10, x, 0); }
+
+    QScopedPointer<QTemporaryDir> m_dir;
+    // Two instances on the same directory stand for two processes.
+    QScopedPointer<QGeoSharedTileIndex> m_first;
+    QScopedPointer<QGeoSharedTileIndex> m_second;
+};
+
+void tst_QGeoSharedTileIndex::init()
+{
+    m_dir.reset(new QTemporaryDir);
+    QVERIFY(m_dir->isValid());
+    m_first.reset(new QGeoSharedTileIndex(m_dir->path(), 256));
+    if (!m_first->isValid())
+        QSKIP(qPrintable(QStringLiteral("Shared memory is not available: ") + m_first->errorString()));
+    m_second.reset(new QGeoSharedTileIndex(m_dir->path(), 256));
+    QVERIFY2(m_second->isValid(), qPrintable(m_second->errorString()));
+}
+
+void tst_QGeoSharedTileIndex::cleanup()
+{
+    m_second.reset();
+    m_first.reset();
+    m_dir.reset();
+}
+
+void tst_QGeoSharedTileIndex::initializer()
+{
+    QVERIFY(m_first->isInitializer());
+    QVERIFY(!m_second->isInitializer());
+    QVERIFY(m_second->capacity() >= 256);
+    QCOMPARE(m_second->capacity(), m_first->capacity());
+
+    QTemporaryDir other;
+    QGeoSharedTileIndex unrelated(other.path(), 256);
+    QVERIFY(unrelated.isInitializer());
+}
+
+void tst_QGeoSharedTileIndex::insertAndLookup()
+{
+    QVERIFY(m_first->insert(tile(1), QStringLiteral("test-1-10-1-0.png"), 100).isEmpty());
+    QCOMPARE(m_second->lookup(tile(1)), QStringLiteral("test-1-10-1-0.png"));
+    QCOMPARE(m_second->state(tile(1)), QGeoSharedTileIndex::Present);
+    QVERIFY(m_second->lookup(tile(2)).isEmpty());
+    QCOMPARE(m_second->state(tile(2)), QGeoSharedTileIndex::Missing);
+    QCOMPARE(m_second->count(), 1);
+    QCOMPARE(m_second->totalCost(), qint64(100));
+
+    // Inserting again replaces the tile rather than adding it twice.
+    m_second->insert(tile(1), QStringLiteral("test-1-10-1-0.jpg"), 50);
+    QCOMPARE(m_first->lookup(tile(1)), QStringLiteral("test-1-10-1-0.jpg"));
+    QCOMPARE(m_first->count(), 1);
+    QCOMPARE(m_first->totalCost(), qint64(50));
+}
+
+void tst_QGeoSharedTileIndex::remove()
+{
+    m_first->insert(tile(1), QStringLiteral("a.png"), 10);
+    m_first->insert(tile(2), QStringLiteral("b.png"), 20);
+    m_second->remove(tile(1));
+    QVERIFY(m_first->lookup(tile(1)).isEmpty());
+    QCOMPARE(m_first->lookup(tile(2)), QStringLiteral("b.png"));
+    QCOMPARE(m_first->count(), 1);
+    QCOMPARE(m_first->totalCost(), qint64(20));
+}
+
+void tst_QGeoSharedTileIndex::claimFetch()
+{
+    QVERIFY(m_first->claimFetch(tile(1)));
+    QVERIFY(m_first->claimFetch(tile(1)));
+    QVERIFY(!m_second->claimFetch(tile(1)));
+    QCOMPARE(m_second->state(tile(1)), QGeoSharedTileIndex::Fetching);
+
+    // Only the claimant can release the claim.
+    m_second->releaseFetch(tile(1));
+    QCOMPARE(m_second->state(tile(1)), QGeoSharedTileIndex::Fetching);
+    m_first->releaseFetch(tile(1));
+    QCOMPARE(m_second->state(tile(1)), QGeoSharedTileIndex::Missing);
+    QVERIFY(m_second->claimFetch(tile(1)));
+
+    // Inserting the tile ends the claim, and there is nothing left to fetch.
+    m_second->insert(tile(1), QStringLiteral("a.png"), 10);
+    QCOMPARE(m_first->state(tile(1)), QGeoSharedTileIndex::Present);
+    QVERIFY(!m_first->claimFetch(tile(1)));
+    QVERIFY(!m_second->claimFetch(tile(1)));
+    QCOMPARE(m_first->count(), 1);
+
+    // A tile that cannot be recorded ends the claim too.
+    QVERIFY(m_first->claimFetch(tile(2)));
+    QVERIFY(m_first->insert(tile(2), QString(100, QLatin1Char('a')), 10).isEmpty());
+    QCOMPARE(m_second->state(tile(2)), QGeoSharedTileIndex::Missing);
+    QVERIFY(m_second->claimFetch(tile(2)));
+    QCOMPARE(m_first->count(), 1);
+}
+
+void tst_QGeoSharedTileIndex::claimExpiry()
+{
+    m_first->setClaimTimeout(20);
+    m_second->setClaimTimeout(20);
+    QVERIFY(m_first->claimFetch(tile(1)));
+    QVERIFY(!m_second->claimFetch(tile(1)));
+    QTRY_COMPARE(m_second->state(tile(1)), QGeoSharedTileIndex::Missing);
+    QVERIFY(m_second->claimFetch(tile(1)));
+    QVERIFY(!m_first->claimFetch(tile(1)));
+}
+
+void tst_QGeoSharedTileIndex::evictLeastRecentlyUsed()
+{
+    m_first->setMaxCost(300);
+    QCOMPARE(m_second->maxCost(), qint64(300));
+
+    QVERIFY(m_first->insert(tile(1), QStringLiteral("1.png"), 100).isEmpty());
+    QVERIFY(m_second->insert(tile(2), QStringLiteral("2.png"), 100).isEmpty());
+    QVERIFY(m_first->insert(tile(3), QStringLiteral("3.png"), 100).isEmpty());
+
+    // A use by either process keeps the tile.
+    QVERIFY(!m_second->lookup(tile(1)).isEmpty());
+
+    QCOMPARE(m_second->insert(tile(4), QStringLiteral("4.png"), 100),
+             QStringList() << QStringLiteral("2.png"));
+    QCOMPARE(m_first->state(tile(2)), QGeoSharedTileIndex::Missing);
+    QCOMPARE(m_first->count(), 3);
+    QCOMPARE(m_first->totalCost(), qint64(300));
+
+    QCOMPARE(m_first->insert(tile(5), QStringLiteral("5.png"), 200),
+             QStringList() << QStringLiteral("3.png") << QStringLiteral("1.png"));
+    QCOMPARE(m_second->totalCost(), qint64(300));
+}
+
+void tst_QGeoSharedTileIndex::clear()
+{
+    for (int x = 0; x < 100; ++x)
+        m_first->insert(tile(x), QStringLiteral("%1.png").arg(x), 1);
+    QVERIFY(m_second->claimFetch(tile(100)));
+    QCOMPARE(m_second->count(), 100);
+
+    m_second->clear();
+    QCOMPARE(m_first->count(), 0);
+    QCOMPARE(m_first->totalCost(), qint64(0));
+    QCOMPARE(m_first->state(tile(5)), QGeoSharedTileIndex::Missing);
+    QCOMPARE(m_first->state(tile(100)), QGeoSharedTileIndex::Missing);
+
+    // Removed and cleared slots are reused.
+    for (int round = 0; round < 10; ++round) {
+        for (int x = 0; x < 200; ++x)
+            m_first->insert(tile(x), QStringLiteral("%1.png").arg(x), 1);
+        for (int x = 0; x < 200; ++x)
+            m_second->remove(tile(x));
+    }
+    QCOMPARE(m_first->count(), 0);
+    m_first->insert(tile(7), QStringLiteral("7.png"), 1);
+    QCOMPARE(m_second->lookup(tile(7)), QStringLiteral("7.png"));
+}
+
+void tst_QGeoSharedTileIndex::capacityFor()
+{
+    // An index sized for a number of tiles holds them all without evicting.
+    QTemporaryDir other;
+    QGeoSharedTileIndex index(other.path(), QGeoSharedTileIndex::capacityFor(1000));
+    QVERIFY2(index.isValid(), qPrintable(index.errorString()));
+    index.setMaxCost(1000);
+    for (int x = 0; x < 1000; ++x)
+        QVERIFY(index.insert(tile(x), QStringLiteral("%1.png").arg(x), 1).isEmpty());
+    QCOMPARE(index.count(), 1000);
+
+    QCOMPARE(index.insert(tile(1000), QStringLiteral("1000.png"), 1),
+             QStringList() << QStringLiteral("0.png"));
+    QCOMPARE(index.count(), 1000);
+}
+
+QTEST_GUILESS_MAIN(tst_QGeoSharedTileIndex)
+
+#include "tst_qgeosharedtileindex.moc"
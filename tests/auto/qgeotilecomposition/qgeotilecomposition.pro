@@ -0,0 +1,7 @@
+TEMPLATE = app
+CONFIG += testcase
+TARGET = tst_qgeotilecomposition
+
+SOURCES += tst_qgeotilecomposition.cpp
+
+QT += location-private testlib
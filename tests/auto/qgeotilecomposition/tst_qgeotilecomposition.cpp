@@ -0,0 +1,224 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/QBuffer>
+#include <QtCore/QTemporaryDir>
+#include <QtGui/QImage>
+#include <QtTest/QtTest>
+#include <QtLocation/private/qgeofiletilecache_p.h>
+#include <QtLocation/private/qgeotiledmappingmanagerengine_p.h>
+
+QT_USE_NAMESPACE
+
+class ComposingEngine : public QGeoTiledMappingManagerEngine
+{
+public:
+    ComposingEngine(const QString &directory, int levels, bool permanent = false)
+    {
+        setTileSize(QSize(256, 256));
+        setTileCache(new QGeoFileTileCache(directory));
+        setTileComposition(levels, permanent);
+    }
+
+    using QGeoTiledMappingManagerEngine::engineTileFinished;
+};
+
+static QByteArray solidTile(const QColor &color)
+{
+    QImage image(256, 256, QImage::Format_RGB32);
+    image.fill(color);
+    QByteArray bytes;
+    QBuffer buffer(&bytes);
+    buffer.open(QIODevice::WriteOnly);
+    image.save(&buffer, "PNG");
+    return bytes;
+}
+
+// Caches the children of the tile at (x, y, zoom) found `levels` zoom
+// levels further in, each quarter of the tile in its own colour.
+static void cacheChildren(QAbstractGeoTileCache *cache, int zoom, int x, int y, int levels,
+                          int skip = -1)
+{
+    static const QColor colors[] = { Qt::red, Qt::green, Qt::blue, Qt::yellow };
+    const int n = 1 << levels;
+    for (int row = 0; row < n; ++row) {
+        for (int col = 0; col < n; ++col) {
+            if (row * n + col == skip)
+                continue;
+            const int quarter = (row * 2 / n) * 2 + col * 2 / n;
+            cache->insert(QGeoTileSpec(QStringLiteral("test"), 1, zoom + levels,
+                                       x * n + col, y * n + row),
+                          solidTile(colors[quarter]), QStringLiteral("png"));
+        }
+    }
+}
+
+class tst_QGeoTileComposition : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void compose_data();
+    void compose();
+    void incompleteChildren();
+    void missingChildArrives();
+    void disabled();
+    void replacedByRealTile();
+    void permanent();
+};
+
+void tst_QGeoTileComposition::compose_data()
+{
+    QTest::addColumn<int>("levels");
+    QTest::addColumn<int>("cachedLevel");
+
+    QTest::newRow("children") << 1 << 1;
+    QTest::newRow("grandchildren") << 2 << 2;
+    QTest::newRow("closest level") << 2 << 1;
+}
+
+void tst_QGeoTileComposition::compose()
+{
+    QFETCH(int, levels);
+    QFETCH(int, cachedLevel);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    ComposingEngine engine(dir.path(), levels);
+    QAbstractGeoTileCache *cache = engine.tileCache();
+
+    const QGeoTileSpec spec(QStringLiteral("test"), 1, 3, 5, 2);
+    cacheChildren(cache, 3, 5, 2, cachedLevel);
+    QVERIFY(!cache->get(spec));
+
+    engine.composeTile(spec);
+    QTRY_VERIFY(cache->get(spec));
+
+    const QSharedPointer<QGeoTileTexture> texture = cache->get(spec);
+    QVERIFY(texture->provisional);
+    QCOMPARE(texture->image.size(), QSize(256, 256));
+    QCOMPARE(QColor(texture->image.pixel(64, 64)), QColor(Qt::red));
+    QCOMPARE(QColor(texture->image.pixel(192, 64)), QColor(Qt::green));
+    QCOMPARE(QColor(texture->image.pixel(64, 192)), QColor(Qt::blue));
+    QCOMPARE(QColor(texture->image.pixel(192, 192)), QColor(Qt::yellow));
+
+    // Composed textures have no data behind them to compose from.
+    QVERIFY(!cache->contains(spec));
+}
+
+void tst_QGeoTileComposition::incompleteChildren()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    ComposingEngine engine(dir.path(), 1);
+    QAbstractGeoTileCache *cache = engine.tileCache();
+
+    const QGeoTileSpec spec(QStringLiteral("test"), 1, 3, 5, 2);
+    cacheChildren(cache, 3, 5, 2, 1, 3);
+
+    engine.composeTile(spec);
+    QTest::qWait(100);
+    QVERIFY(!cache->get(spec));
+}
+
+void tst_QGeoTileComposition::missingChildArrives()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    ComposingEngine engine(dir.path(), 1);
+    QAbstractGeoTileCache *cache = engine.tileCache();
+
+    const QGeoTileSpec spec(QStringLiteral("test"), 1, 3, 5, 2);
+    const QGeoTileSpec missing(QStringLiteral("test"), 1, 4, 11, 5);
+    cacheChildren(cache, 3, 5, 2, 1, 3);
+    engine.composeTile(spec);
+
+    // A tile that cannot be composed is not looked at again...
+    cache->insert(missing, solidTile(Qt::yellow), QStringLiteral("png"));
+    engine.composeTile(spec);
+    QTest::qWait(100);
+    QVERIFY(!cache->get(spec));
+
+    // ...until one of its children is fetched.
+    engine.engineTileFinished(missing, solidTile(Qt::yellow), QStringLiteral("png"));
+    engine.composeTile(spec);
+    QTRY_VERIFY(cache->get(spec));
+    QCOMPARE(QColor(cache->get(spec)->image.pixel(192, 192)), QColor(Qt::yellow));
+}
+
+void tst_QGeoTileComposition::disabled()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    ComposingEngine engine(dir.path(), 0);
+    QAbstractGeoTileCache *cache = engine.tileCache();
+
+    const QGeoTileSpec spec(QStringLiteral("test"), 1, 3, 5, 2);
+    cacheChildren(cache, 3, 5, 2, 1);
+
+    engine.composeTile(spec);
+    QTest::qWait(100);
+    QVERIFY(!cache->get(spec));
+}
+
+void tst_QGeoTileComposition::replacedByRealTile()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    ComposingEngine engine(dir.path(), 1);
+    QAbstractGeoTileCache *cache = engine.tileCache();
+
+    const QGeoTileSpec spec(QStringLiteral("test"), 1, 3, 5, 2);
+    cacheChildren(cache, 3, 5, 2, 1);
+    engine.composeTile(spec);
+    QTRY_VERIFY(cache->get(spec));
+
+    cache->insert(spec, solidTile(Qt::black), QStringLiteral("png"));
+    const QSharedPointer<QGeoTileTexture> texture = cache->get(spec);
+    QVERIFY(texture);
+    QVERIFY(!texture->provisional);
+    QCOMPARE(QColor(texture->image.pixel(64, 64)), QColor(Qt::black));
+}
+
+void tst_QGeoTileComposition::permanent()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    ComposingEngine engine(dir.path(), 1, true);
+    QAbstractGeoTileCache *cache = engine.tileCache();
+
+    const QGeoTileSpec spec(QStringLiteral("test"), 1, 3, 5, 2);
+    cacheChildren(cache, 3, 5, 2, 1);
+    engine.composeTile(spec);
+    QTRY_VERIFY(cache->get(spec));
+    QVERIFY(!cache->get(spec)->provisional);
+}
+
+QTEST_MAIN(tst_QGeoTileComposition)
+
+#include "tst_qgeotilecomposition.moc"
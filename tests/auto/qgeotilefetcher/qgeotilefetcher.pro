@@ -0,0 +1,7 @@
+TEMPLATE = app
+CONFIG += testcase
+TARGET = tst_qgeotilefetcher
+
+SOURCES += tst_qgeotilefetcher.cpp
+
+QT += location-private testlib
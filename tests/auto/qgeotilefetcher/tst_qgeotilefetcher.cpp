@@ -0,0 +1,234 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtLocation/private/qgeocameracapabilities_p.h>
+#include <QtLocation/private/qgeotiledmappingmanagerengine_p.h>
+#include <QtLocation/private/qgeotiledmapreply_p.h>
+#include <QtLocation/private/qgeotilefetcher_p.h>
+#include <QtLocation/private/qgeotilespec_p.h>
+
+QT_USE_NAMESPACE
+
+class TestTileReply : public QGeoTiledMapReply
+{
+public:
+    TestTileReply(const QGeoTileSpec &spec, QObject *parent)
+        : QGeoTiledMapReply(spec, parent)
+    {
+    }
+
+    void finish()
+    {
+        setMapImageData(QByteArrayLiteral("tile"));
+        setFinished(true);
+    }
+};
+
+// Tiles with an even x come from host0, the others from host1.
+static QString hostOf(const QGeoTileSpec &spec)
+{
+    return QStringLiteral("host%1").arg(spec.x() % 2);
+}
+
+/*
+    Replies stay in flight until the test finishes them.
+*/
+class TestTileFetcher : public QGeoTileFetcher
+{
+public:
+    TestTileFetcher(QGeoMappingManagerEngine *parent) : QGeoTileFetcher(parent) {}
+
+    void fetch(const QSet<QGeoTileSpec> &tiles)
+    {
+        updateTileRequests(tiles, QSet<QGeoTileSpec>());
+    }
+
+    void cancel(const QSet<QGeoTileSpec> &tiles)
+    {
+        updateTileRequests(QSet<QGeoTileSpec>(), tiles);
+    }
+
+    int inFlight(const QString &host) const
+    {
+        int count = 0;
+        for (TestTileReply *reply : m_replies) {
+            if (hostOf(reply->tileSpec()) == host)
+                ++count;
+        }
+        return count;
+    }
+
+    void finishAll(const QString &host)
+    {
+        const QList<TestTileReply *> replies = m_replies;
+        for (TestTileReply *reply : replies) {
+            if (hostOf(reply->tileSpec()) == host) {
+                m_replies.removeOne(reply);
+                reply->finish();
+            }
+        }
+    }
+
+    QList<TestTileReply *> m_replies;
+    QList<QGeoTileSpec> m_requested;
+    QList<QGeoTileSpec> m_handled;
+    mutable int m_hostLookups = 0;
+
+protected:
+    QString tileHost(const QGeoTileSpec &spec) const override
+    {
+        ++m_hostLookups;
+        return hostOf(spec);
+    }
+
+private:
+    QGeoTiledMapReply *getTileImage(const QGeoTileSpec &spec) override
+    {
+        TestTileReply *reply = new TestTileReply(spec, this);
+        m_replies.append(reply);
+        m_requested.append(spec);
+        return reply;
+    }
+
+    void handleReply(QGeoTiledMapReply *reply, const QGeoTileSpec &spec) override
+    {
+        reply->deleteLater();
+        m_handled.append(spec);
+    }
+};
+
+class TestMappingEngine : public QGeoTiledMappingManagerEngine
+{
+public:
+    TestMappingEngine()
+    {
+        QGeoCameraCapabilities capabilities;
+        capabilities.setMinimumZoomLevel(0);
+        capabilities.setMaximumZoomLevel(20);
+        setCameraCapabilities(capabilities);
+        setTileSize(QSize(256, 256));
+        fetcher = new TestTileFetcher(this);
+        setTileFetcher(fetcher);
+    }
+
+    TestTileFetcher *fetcher;
+};
+
+class tst_QGeoTileFetcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void unlimited();
+    void maximumRequestsPerHost();
+    void cancelQueued();
+};
+
+static QSet<QGeoTileSpec> tiles(int count)
+{
+    QSet<QGeoTileSpec> result;
+    for (int x = 0; x < count; ++x)
+        result.insert(QGeoTileSpec(QStringLiteral("test"), 1, 10, x, 0));
+    return result;
+}
+
+void tst_QGeoTileFetcher::unlimited()
+{
+    TestMappingEngine engine;
+    TestTileFetcher *fetcher = engine.fetcher;
+    QCOMPARE(fetcher->maximumRequestsPerHost(), 0);
+    QVERIFY(!fetcher->isHttp2Enabled());
+
+    fetcher->fetch(tiles(6));
+    QTRY_COMPARE(fetcher->m_requested.size(), 6);
+
+    // Hosts are not looked up when there is no limit.
+    QCOMPARE(fetcher->m_hostLookups, 0);
+}
+
+void tst_QGeoTileFetcher::maximumRequestsPerHost()
+{
+    TestMappingEngine engine;
+    TestTileFetcher *fetcher = engine.fetcher;
+    fetcher->setMaximumRequestsPerHost(2);
+
+    fetcher->fetch(tiles(10));
+    QTRY_COMPARE(fetcher->m_requested.size(), 4);
+    QTest::qWait(50);
+    QCOMPARE(fetcher->m_requested.size(), 4);
+    QCOMPARE(fetcher->inFlight(QStringLiteral("host0")), 2);
+    QCOMPARE(fetcher->inFlight(QStringLiteral("host1")), 2);
+
+    // Finished requests make room for more tiles of the same host only.
+    fetcher->finishAll(QStringLiteral("host0"));
+    QTRY_COMPARE(fetcher->m_requested.size(), 6);
+    QCOMPARE(fetcher->m_handled.size(), 2);
+    QCOMPARE(fetcher->inFlight(QStringLiteral("host0")), 2);
+    QCOMPARE(fetcher->inFlight(QStringLiteral("host1")), 2);
+
+    fetcher->finishAll(QStringLiteral("host0"));
+    fetcher->finishAll(QStringLiteral("host1"));
+    QTRY_COMPARE(fetcher->m_requested.size(), 9);
+    QCOMPARE(fetcher->inFlight(QStringLiteral("host0")), 1);
+    QCOMPARE(fetcher->inFlight(QStringLiteral("host1")), 2);
+
+    fetcher->finishAll(QStringLiteral("host0"));
+    fetcher->finishAll(QStringLiteral("host1"));
+    QTRY_COMPARE(fetcher->m_requested.size(), 10);
+    fetcher->finishAll(QStringLiteral("host1"));
+    QTRY_COMPARE(fetcher->m_handled.size(), 10);
+
+    // The host of each tile was looked up once, when it was queued, however
+    // often the tile was passed over.
+    QCOMPARE(fetcher->m_hostLookups, 10);
+}
+
+void tst_QGeoTileFetcher::cancelQueued()
+{
+    TestMappingEngine engine;
+    TestTileFetcher *fetcher = engine.fetcher;
+    fetcher->setMaximumRequestsPerHost(1);
+
+    const QGeoTileSpec first(QStringLiteral("test"), 1, 10, 0, 0);
+    const QGeoTileSpec second(QStringLiteral("test"), 1, 10, 2, 0);
+    fetcher->fetch(QSet<QGeoTileSpec>() << first << second);
+    QTRY_COMPARE(fetcher->m_requested.size(), 1);
+
+    // A tile waiting for its host is not requested once cancelled.
+    const QGeoTileSpec waiting = fetcher->m_requested.first() == first ? second : first;
+    fetcher->cancel(QSet<QGeoTileSpec>() << waiting);
+    fetcher->finishAll(QStringLiteral("host0"));
+    QTRY_COMPARE(fetcher->m_handled.size(), 1);
+    QTest::qWait(50);
+    QCOMPARE(fetcher->m_requested.size(), 1);
+}
+
+QTEST_GUILESS_MAIN(tst_QGeoTileFetcher)
+
+#include "tst_qgeotilefetcher.moc"
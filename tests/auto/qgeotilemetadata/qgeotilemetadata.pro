@@ -0,0 +1,7 @@
+TEMPLATE = app
+CONFIG += testcase
+TARGET = tst_qgeotilemetadata
+
+SOURCES += tst_qgeotilemetadata.cpp
+
+QT += location-private network testlib
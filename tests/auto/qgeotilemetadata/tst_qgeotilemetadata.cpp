@@ -0,0 +1,237 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QStandardPaths>
+#include <QtNetwork/QNetworkReply>
+#include <QtNetwork/QNetworkRequest>
+#include <QtTest/QtTest>
+#include <QtLocation/private/qabstractgeotilecache_p.h>
+#include <QtLocation/private/qgeofiletilecache_p.h>
+
+QT_USE_NAMESPACE
+
+typedef QList<QPair<QByteArray, QByteArray> > RawHeaders;
+Q_DECLARE_METATYPE(RawHeaders)
+
+class HeaderReply : public QNetworkReply
+{
+public:
+    explicit HeaderReply(const RawHeaders &headers)
+    {
+        for (const auto &header : headers)
+            setRawHeader(header.first, header.second);
+        open(QIODevice::ReadOnly);
+    }
+
+    void abort() override {}
+
+protected:
+    qint64 readData(char *, qint64) override { return -1; }
+};
+
+class tst_QGeoTileMetadata : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void fromNetworkReply_data();
+    void fromNetworkReply();
+    void isStale();
+    void addValidators();
+    void cacheMetadata();
+    void persistence();
+};
+
+void tst_QGeoTileMetadata::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+}
+
+void tst_QGeoTileMetadata::fromNetworkReply_data()
+{
+    QTest::addColumn<RawHeaders>("headers");
+    QTest::addColumn<QByteArray>("etag");
+    QTest::addColumn<QDateTime>("lastModified");
+    QTest::addColumn<int>("expiresIn");
+    QTest::addColumn<QDateTime>("expires");
+
+    const QDateTime date(QDate(2019, 1, 15), QTime(12, 0), Qt::UTC);
+
+    QTest::newRow("none") << RawHeaders() << QByteArray() << QDateTime() << -1 << QDateTime();
+    QTest::newRow("validators")
+            << (RawHeaders() << qMakePair(QByteArray("ETag"), QByteArray("\"abc\""))
+                             << qMakePair(QByteArray("Last-Modified"),
+                                          QByteArray("Tue, 15 Jan 2019 12:00:00 GMT")))
+            << QByteArray("\"abc\"") << date << -1 << QDateTime();
+    QTest::newRow("max-age")
+            << (RawHeaders() << qMakePair(QByteArray("Cache-Control"), QByteArray("public, max-age=3600")))
+            << QByteArray() << QDateTime() << 3600 << QDateTime();
+    QTest::newRow("max-age over expires")
+            << (RawHeaders() << qMakePair(QByteArray("Cache-Control"), QByteArray("max-age=60"))
+                             << qMakePair(QByteArray("Expires"),
+                                          QByteArray("Tue, 15 Jan 2019 12:00:00 GMT")))
+            << QByteArray() << QDateTime() << 60 << QDateTime();
+    QTest::newRow("no-cache")
+            << (RawHeaders() << qMakePair(QByteArray("Cache-Control"), QByteArray("No-Cache")))
+            << QByteArray() << QDateTime() << 0 << QDateTime();
+    QTest::newRow("expires")
+            << (RawHeaders() << qMakePair(QByteArray("Expires"),
+                                          QByteArray("Tue, 15 Jan 2019 12:00:00 GMT")))
+            << QByteArray() << QDateTime() << -1 << date;
+    QTest::newRow("invalid expires")
+            << (RawHeaders() << qMakePair(QByteArray("Expires"), QByteArray("0")))
+            << QByteArray() << QDateTime() << 0 << QDateTime();
+}
+
+void tst_QGeoTileMetadata::fromNetworkReply()
+{
+    QFETCH(RawHeaders, headers);
+    QFETCH(QByteArray, etag);
+    QFETCH(QDateTime, lastModified);
+    QFETCH(int, expiresIn);
+    QFETCH(QDateTime, expires);
+
+    HeaderReply reply(headers);
+    const QDateTime before = QDateTime::currentDateTimeUtc();
+    const QGeoTileMetadata metadata = QGeoTileMetadata::fromNetworkReply(&reply);
+    const QDateTime after = QDateTime::currentDateTimeUtc();
+
+    QCOMPARE(metadata.etag, etag);
+    QCOMPARE(metadata.lastModified, lastModified);
+    if (expiresIn >= 0) {
+        QVERIFY(metadata.expires >= before.addSecs(expiresIn));
+        QVERIFY(metadata.expires <= after.addSecs(expiresIn));
+    } else {
+        QCOMPARE(metadata.expires, expires);
+    }
+}
+
+void tst_QGeoTileMetadata::isStale()
+{
+    const QDateTime now(QDate(2019, 1, 15), QTime(12, 0), Qt::UTC);
+
+    QGeoTileMetadata metadata;
+    QVERIFY(metadata.isEmpty());
+    QVERIFY(!metadata.isStale(now));
+    QVERIFY(!metadata.canRevalidate());
+
+    metadata.expires = now.addSecs(1);
+    QVERIFY(!metadata.isEmpty());
+    QVERIFY(!metadata.isStale(now));
+    QVERIFY(metadata.isStale(now.addSecs(1)));
+
+    metadata.etag = "\"abc\"";
+    QVERIFY(metadata.canRevalidate());
+}
+
+void tst_QGeoTileMetadata::addValidators()
+{
+    QGeoTileMetadata metadata;
+    QNetworkRequest request;
+    metadata.addValidators(&request);
+    QVERIFY(!request.hasRawHeader("If-None-Match"));
+    QVERIFY(!request.hasRawHeader("If-Modified-Since"));
+
+    metadata.etag = "\"abc\"";
+    metadata.lastModified = QDateTime(QDate(2019, 1, 15), QTime(12, 0), Qt::UTC);
+    metadata.addValidators(&request);
+    QCOMPARE(request.rawHeader("If-None-Match"), QByteArray("\"abc\""));
+    QCOMPARE(request.header(QNetworkRequest::IfModifiedSinceHeader).toDateTime(),
+             metadata.lastModified);
+}
+
+void tst_QGeoTileMetadata::cacheMetadata()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    QGeoFileTileCache cache(dir.path());
+    cache.init();
+
+    const QGeoTileSpec spec(QStringLiteral("test"), 1, 2, 3, 4);
+    QGeoTileMetadata metadata;
+    metadata.etag = "\"abc\"";
+
+    // Only tiles on disk keep their metadata.
+    cache.setMetadata(spec, metadata);
+    QVERIFY(cache.metadata(spec).isEmpty());
+
+    cache.insert(spec, QByteArrayLiteral("tile"), QStringLiteral("png"),
+                 QAbstractGeoTileCache::DiskCache);
+    cache.setMetadata(spec, metadata);
+    QCOMPARE(cache.metadata(spec).etag, metadata.etag);
+
+    cache.setMetadata(spec, QGeoTileMetadata());
+    QVERIFY(cache.metadata(spec).isEmpty());
+
+    cache.setMetadata(spec, metadata);
+    cache.clearMapId(1);
+    QVERIFY(cache.metadata(spec).isEmpty());
+}
+
+void tst_QGeoTileMetadata::persistence()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QGeoTileSpec spec(QStringLiteral("test"), 1, 2, 3, 4);
+    const QGeoTileSpec other(QStringLiteral("test"), 1, 2, 3, 5);
+    QGeoTileMetadata metadata;
+    metadata.etag = "\"abc\"";
+    metadata.lastModified = QDateTime(QDate(2019, 1, 15), QTime(12, 0), Qt::UTC);
+    metadata.expires = metadata.lastModified.addDays(1);
+
+    {
+        QGeoFileTileCache cache(dir.path());
+        cache.init();
+        cache.insert(spec, QByteArrayLiteral("tile"), QStringLiteral("png"),
+                     QAbstractGeoTileCache::DiskCache);
+        cache.insert(other, QByteArrayLiteral("tile"), QStringLiteral("png"),
+                     QAbstractGeoTileCache::DiskCache);
+        cache.setMetadata(spec, metadata);
+        cache.setMetadata(other, metadata);
+    }
+
+    // A tile deleted behind the cache's back loses its metadata.
+    QVERIFY(QFile::remove(QGeoFileTileCache::tileSpecToFilenameDefault(other, QStringLiteral("png"),
+                                                                       dir.path())));
+
+    QGeoFileTileCache cache(dir.path());
+    cache.init();
+    const QGeoTileMetadata loaded = cache.metadata(spec);
+    QCOMPARE(loaded.etag, metadata.etag);
+    QCOMPARE(loaded.lastModified, metadata.lastModified);
+    QCOMPARE(loaded.expires, metadata.expires);
+    QVERIFY(cache.metadata(other).isEmpty());
+}
+
+QTEST_GUILESS_MAIN(tst_QGeoTileMetadata)
+
+#include "tst_qgeotilemetadata.moc"
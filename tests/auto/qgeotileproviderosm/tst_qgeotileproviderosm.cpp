@@ -0,0 +1,101 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeotileproviderosm.h"
+
+#include <QtTest/QtTest>
+
+QT_USE_NAMESPACE
+
+class tst_QGeoTileProviderOsm : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void tileAddress_data();
+    void tileAddress();
+    void invalidSubdomains_data();
+    void invalidSubdomains();
+};
+
+void tst_QGeoTileProviderOsm::tileAddress_data()
+{
+    QTest::addColumn<QString>("urlTemplate");
+    QTest::addColumn<int>("x");
+    QTest::addColumn<int>("y");
+    QTest::addColumn<QString>("address");
+
+    const QString rotating = QStringLiteral("https://{a,b,c}.tile.example.org/%z/%x/%y.png");
+    QTest::newRow("0/0") << rotating << 0 << 0 << "https://a.tile.example.org/10/0/0.png";
+    QTest::newRow("1/0") << rotating << 1 << 0 << "https://b.tile.example.org/10/1/0.png";
+    QTest::newRow("1/1") << rotating << 1 << 1 << "https://c.tile.example.org/10/1/1.png";
+    QTest::newRow("2/1") << rotating << 2 << 1 << "https://a.tile.example.org/10/2/1.png";
+    QTest::newRow("0/2") << rotating << 0 << 2 << "https://c.tile.example.org/10/0/2.png";
+
+    const QString single = QStringLiteral("http://localhost:8080/maps/%z/%x/%y.png");
+    QTest::newRow("no alternatives") << single << 1 << 2 << "http://localhost:8080/maps/10/1/2.png";
+
+    const QString path = QStringLiteral("http://tiles.example.org/{one,two}/%z/%y/%x");
+    QTest::newRow("path") << path << 3 << 4 << "http://tiles.example.org/two/10/4/3";
+}
+
+void tst_QGeoTileProviderOsm::tileAddress()
+{
+    QFETCH(QString, urlTemplate);
+    QFETCH(int, x);
+    QFETCH(int, y);
+    QFETCH(QString, address);
+
+    TileProvider provider(urlTemplate, QStringLiteral("png"), QString(), QString());
+    QVERIFY(provider.isValid());
+    QCOMPARE(provider.tileAddress(x, y, 10), QUrl(address));
+
+    // A tile always goes to the same host.
+    QCOMPARE(provider.tileAddress(x, y, 10), provider.tileAddress(x, y, 10));
+}
+
+void tst_QGeoTileProviderOsm::invalidSubdomains_data()
+{
+    QTest::addColumn<QString>("urlTemplate");
+
+    QTest::newRow("unterminated") << QStringLiteral("https://{a,b.tile.example.org/%z/%x/%y.png");
+    QTest::newRow("empty") << QStringLiteral("https://{}.tile.example.org/%z/%x/%y.png");
+    QTest::newRow("separators only") << QStringLiteral("https://{,}.tile.example.org/%z/%x/%y.png");
+}
+
+void tst_QGeoTileProviderOsm::invalidSubdomains()
+{
+    QFETCH(QString, urlTemplate);
+
+    TileProvider provider(urlTemplate, QStringLiteral("png"), QString(), QString());
+    QVERIFY(provider.isInvalid());
+}
+
+QTEST_GUILESS_MAIN(tst_QGeoTileProviderOsm)
+
+#include "tst_qgeotileproviderosm.moc"
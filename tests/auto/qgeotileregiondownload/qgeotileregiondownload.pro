@@ -0,0 +1,8 @@
+TEMPLATE = app
+CONFIG += testcase
+TARGET = tst_qgeotileregiondownload
+INCLUDEPATH += ../geotestplugin
+
+SOURCES += tst_qgeotileregiondownload.cpp
+
+QT += location-private positioning-private testlib
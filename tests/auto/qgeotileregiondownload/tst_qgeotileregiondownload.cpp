@@ -0,0 +1,292 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeotiledmap_test.h"
+#include <QtCore/QString>
+#include <QtTest/QtTest>
+#include <QtTest/QSignalSpy>
+#include <QtPositioning/QGeoPath>
+#include <QtPositioning/QGeoPolygon>
+#include <QtPositioning/QGeoRectangle>
+#include <QtLocation/QGeoServiceProvider>
+#include <QtLocation/private/qgeomappingmanager_p.h>
+#include <QtLocation/private/qgeofiletilecache_p.h>
+#include <QtLocation/private/qgeotileregiondownload_p.h>
+
+#include <limits>
+
+QT_USE_NAMESPACE
+
+typedef QPair<int, int> Tile;
+
+class RecordingTileCache : public QGeoFileTileCache
+{
+public:
+    void insert(const QGeoTileSpec &spec, const QByteArray &bytes, const QString &format,
+                QAbstractGeoTileCache::CacheAreas areas) override
+    {
+        Q_UNUSED(bytes);
+        Q_UNUSED(format);
+        Q_UNUSED(areas);
+        inserted.append(spec);
+    }
+
+    QList<QGeoTileSpec> inserted;
+};
+
+class tst_QGeoTileRegionDownload : public QObject
+{
+    Q_OBJECT
+
+private:
+    static QSet<Tile> tiles(const QVector<QGeoTileRegionDownload::Span> &spans);
+
+private Q_SLOTS:
+    void initTestCase();
+    void coveringRectangle();
+    void coveringDateLine();
+    void coveringPolygon();
+    void coveringPath();
+    void download();
+    void pauseAndResume();
+    void requestRate();
+    void largeRegion();
+
+private:
+    QScopedPointer<QGeoServiceProvider> m_provider;
+    QScopedPointer<QGeoTiledMapTest> m_map;
+    const QGeoRectangle m_area = QGeoRectangle(QGeoCoordinate(10, -10), QGeoCoordinate(-10, 10));
+};
+
+QSet<Tile> tst_QGeoTileRegionDownload::tiles(const QVector<QGeoTileRegionDownload::Span> &spans)
+{
+    QSet<Tile> result;
+    for (const QGeoTileRegionDownload::Span &span : spans) {
+        for (int i = 0; i < span.count; ++i)
+            result.insert(Tile(span.x + i, span.y));
+    }
+    return result;
+}
+
+void tst_QGeoTileRegionDownload::initTestCase()
+{
+#if QT_CONFIG(library)
+    // Set custom path since CI doesn't install test plugins
+#ifdef Q_OS_WIN
+    QCoreApplication::addLibraryPath(QCoreApplication::applicationDirPath() +
+                                     QStringLiteral("/../../../../plugins"));
+#else
+    QCoreApplication::addLibraryPath(QCoreApplication::applicationDirPath() +
+                                     QStringLiteral("/../../../plugins"));
+#endif
+#endif
+    QVariantMap parameters;
+    parameters["finishRequestImmediately"] = true;
+    m_provider.reset(new QGeoServiceProvider("qmlgeo.test.plugin", parameters));
+    m_provider->setAllowExperimental(true);
+    QGeoMappingManager *mappingManager = m_provider->mappingManager();
+    QVERIFY2(m_provider->error() == QGeoServiceProvider::NoError,
+             "Could not load plugin: " + m_provider->errorString().toLatin1());
+    m_map.reset(static_cast<QGeoTiledMapTest *>(mappingManager->createMap(this)));
+    QVERIFY(m_map);
+}
+
+void tst_QGeoTileRegionDownload::coveringRectangle()
+{
+    QCOMPARE(tiles(QGeoTileRegionDownload::tilesCovering(m_area, 0)), QSet<Tile>() << Tile(0, 0));
+
+    const QVector<QGeoTileRegionDownload::Span> spans = QGeoTileRegionDownload::tilesCovering(m_area, 2);
+    QCOMPARE(spans.count(), 2);
+    for (const QGeoTileRegionDownload::Span &span : spans) {
+        QCOMPARE(span.zoom, 2);
+        QCOMPARE(span.x, 1);
+        QCOMPARE(span.count, 2);
+    }
+    QCOMPARE(spans.at(0).y, 1);
+    QCOMPARE(spans.at(1).y, 2);
+
+    const QGeoRectangle world(QGeoCoordinate(85, -180), QGeoCoordinate(-85, 180));
+    QCOMPARE(tiles(QGeoTileRegionDownload::tilesCovering(world, 3)).count(), 64);
+
+    QVERIFY(QGeoTileRegionDownload::tilesCovering(QGeoRectangle(), 3).isEmpty());
+}
+
+void tst_QGeoTileRegionDownload::coveringDateLine()
+{
+    const QGeoRectangle area(QGeoCoordinate(10, 170), QGeoCoordinate(-10, -170));
+    const QVector<QGeoTileRegionDownload::Span> spans = QGeoTileRegionDownload::tilesCovering(area, 2);
+
+    // The tiles on either side of the date line are separate runs.
+    QCOMPARE(spans.count(), 4);
+    QCOMPARE(tiles(spans), QSet<Tile>() << Tile(3, 1) << Tile(0, 1)
+                                        << Tile(3, 2) << Tile(0, 2));
+
+    const QGeoPolygon polygon(QList<QGeoCoordinate>() << QGeoCoordinate(10, 170)
+                                                      << QGeoCoordinate(10, -170)
+                                                      << QGeoCoordinate(-10, -170)
+                                                      << QGeoCoordinate(-10, 170));
+    QCOMPARE(tiles(QGeoTileRegionDownload::tilesCovering(polygon, 2)), tiles(spans));
+}
+
+void tst_QGeoTileRegionDownload::coveringPolygon()
+{
+    const QGeoPolygon triangle(QList<QGeoCoordinate>() << QGeoCoordinate(60, -90)
+                                                       << QGeoCoordinate(-60, -90)
+                                                       << QGeoCoordinate(-60, 90));
+    const QSet<Tile> covered = tiles(QGeoTileRegionDownload::tilesCovering(triangle, 3));
+    const QSet<Tile> box = tiles(QGeoTileRegionDownload::tilesCovering(
+                                       triangle.boundingGeoRectangle(), 3));
+
+    QVERIFY(covered.count() < box.count());
+    QVERIFY(box.contains(covered));
+    QVERIFY(covered.contains(Tile(2, 5)));
+    QVERIFY(!covered.contains(Tile(5, 2)));
+}
+
+void tst_QGeoTileRegionDownload::coveringPath()
+{
+    const QList<QGeoCoordinate> line = QList<QGeoCoordinate>() << QGeoCoordinate(1, -10)
+                                                               << QGeoCoordinate(1, 10);
+
+    QCOMPARE(tiles(QGeoTileRegionDownload::tilesCovering(QGeoPath(line, 1), 5)),
+             QSet<Tile>() << Tile(15, 15) << Tile(16, 15));
+
+    // A 500 km wide corridor reaches the row south of the equator.
+    const QSet<Tile> corridor = tiles(QGeoTileRegionDownload::tilesCovering(QGeoPath(line, 500000), 5));
+    QVERIFY(corridor.contains(Tile(15, 16)));
+    QVERIFY(corridor.contains(Tile(16, 16)));
+    QVERIFY(!corridor.contains(Tile(15, 17)));
+}
+
+void tst_QGeoTileRegionDownload::download()
+{
+    RecordingTileCache cache;
+    QGeoTileRegionDownload *download = m_map->m_engine->downloadRegion(m_area, 0, 2);
+    QCOMPARE(download->tilesTotal(), qint64(9));
+    download->setTarget(&cache);
+    download->setMaximumConcurrentRequests(2);
+
+    QSignalSpy stateSpy(download, SIGNAL(stateChanged()));
+    download->start();
+    QCOMPARE(download->state(), QGeoTileRegionDownload::Downloading);
+    QTRY_COMPARE(download->state(), QGeoTileRegionDownload::Finished);
+    QCOMPARE(stateSpy.count(), 2);
+
+    QCOMPARE(download->tilesDownloaded(), qint64(9));
+    QCOMPARE(download->tilesFailed(), qint64(0));
+    QVERIFY(download->bytesDownloaded() > 0);
+    QCOMPARE(download->position(), qint64(9));
+    QCOMPARE(cache.inserted.toSet().count(), 9);
+    for (const QGeoTileSpec &spec : qAsConst(cache.inserted)) {
+        QCOMPARE(spec.mapId(), 1);
+        QVERIFY(spec.zoom() >= 0 && spec.zoom() <= 2);
+    }
+
+    delete download;
+}
+
+void tst_QGeoTileRegionDownload::pauseAndResume()
+{
+    RecordingTileCache cache;
+    QGeoTileRegionDownload *download = m_map->m_engine->downloadRegion(m_area, 0, 2);
+    download->setTarget(&cache);
+    download->setMaximumConcurrentRequests(1);
+    connect(download, &QGeoTileRegionDownload::progressChanged, download, [download]() {
+        if (download->tilesDownloaded() == 3)
+            download->pause();
+    });
+
+    download->start();
+    QTRY_COMPARE(download->state(), QGeoTileRegionDownload::Paused);
+    QTest::qWait(50);
+    QCOMPARE(download->tilesDownloaded(), qint64(3));
+    const qint64 position = download->position();
+    QCOMPARE(position, qint64(3));
+    delete download;
+
+    // A new download of the same area carries on where the previous one stopped.
+    download = m_map->m_engine->downloadRegion(m_area, 0, 2);
+    download->setTarget(&cache);
+    download->setPosition(position);
+    download->start();
+    QTRY_COMPARE(download->state(), QGeoTileRegionDownload::Finished);
+    QCOMPARE(download->tilesDownloaded(), qint64(6));
+    QCOMPARE(cache.inserted.toSet().count(), 9);
+    delete download;
+}
+
+void tst_QGeoTileRegionDownload::requestRate()
+{
+    RecordingTileCache cache;
+    QGeoTileRegionDownload *download = m_map->m_engine->downloadRegion(m_area, 0, 2);
+    download->setTarget(&cache);
+    download->setMaximumRequestRate(50);
+
+    QElapsedTimer timer;
+    timer.start();
+    download->start();
+    QTRY_COMPARE(download->state(), QGeoTileRegionDownload::Finished);
+
+    // Nine requests, 20 ms apart.
+    QVERIFY(timer.elapsed() >= 150);
+    QCOMPARE(download->tilesDownloaded(), qint64(9));
+    delete download;
+}
+
+void tst_QGeoTileRegionDownload::largeRegion()
+{
+    const QGeoRectangle world(QGeoCoordinate(85, -180), QGeoCoordinate(-85, 180));
+    for (int zoom = 0; zoom <= 4; ++zoom) {
+        QCOMPARE(QGeoTileRegionDownload::tileCount(world, zoom),
+                 qint64(tiles(QGeoTileRegionDownload::tilesCovering(world, zoom)).count()));
+    }
+    const QGeoPolygon triangle(QList<QGeoCoordinate>() << QGeoCoordinate(60, -120)
+                               << QGeoCoordinate(60, 120) << QGeoCoordinate(-60, 0));
+    QCOMPARE(QGeoTileRegionDownload::tileCount(triangle, 4),
+             qint64(tiles(QGeoTileRegionDownload::tilesCovering(triangle, 4)).count()));
+
+    // The whole world down to level 16 has more tiles than fit an int.
+    RecordingTileCache cache;
+    QGeoTileRegionDownload *download = m_map->m_engine->downloadRegion(world, 0, 16);
+    QVERIFY(download->tilesTotal() > std::numeric_limits<int>::max());
+    download->setTarget(&cache);
+    download->setPosition(download->tilesTotal() - 2);
+    QCOMPARE(download->position(), download->tilesTotal() - 2);
+
+    download->start();
+    QTRY_COMPARE(download->state(), QGeoTileRegionDownload::Finished);
+    QCOMPARE(download->tilesDownloaded(), qint64(2));
+    QCOMPARE(cache.inserted.count(), 2);
+    for (const QGeoTileSpec &spec : qAsConst(cache.inserted))
+        QCOMPARE(spec.zoom(), 16);
+    delete download;
+}
+
+QTEST_MAIN(tst_QGeoTileRegionDownload)
+
+#include "tst_qgeotileregiondownload.moc"
@@ -0,0 +1,7 @@
+TEMPLATE = app
+CONFIG += testcase
+TARGET = tst_qgeotileresampler
+
+SOURCES += tst_qgeotileresampler.cpp
+
+QT += location-private testlib
@@ -0,0 +1,202 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtGui/QImage>
+#include <QtGui/QPainter>
+#include <QtLocation/private/qgeotileresampler_p.h>
+
+QT_USE_NAMESPACE
+
+// Four quadrants of different colors.
+static QImage quadrants(int size)
+{
+    QImage image(size, size, QImage::Format_ARGB32_Premultiplied);
+    QPainter painter(&image);
+    const int half = size / 2;
+    painter.fillRect(0, 0, half, half, Qt::red);
+    painter.fillRect(half, 0, size - half, half, Qt::green);
+    painter.fillRect(0, half, half, size - half, Qt::blue);
+    painter.fillRect(half, half, size - half, size - half, Qt::yellow);
+    return image;
+}
+
+static int maxDifference(QRgb a, QRgb b)
+{
+    return qMax(qMax(qAbs(qRed(a) - qRed(b)), qAbs(qGreen(a) - qGreen(b))),
+                qMax(qAbs(qBlue(a) - qBlue(b)), qAbs(qAlpha(a) - qAlpha(b))));
+}
+
+class tst_QGeoTileResampler : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void halve();
+    void halveOddSizes();
+    void scaledMagnify();
+    void scaledMatchesSmoothScaling();
+    void resampleCrop();
+    void resampleMinify();
+    void convertsFormat();
+    void invalidInput();
+};
+
+void tst_QGeoTileResampler::halve()
+{
+    QImage image(2, 2, QImage::Format_ARGB32_Premultiplied);
+    image.setPixel(0, 0, qRgba(0, 0, 0, 255));
+    image.setPixel(1, 0, qRgba(255, 0, 0, 255));
+    image.setPixel(0, 1, qRgba(0, 255, 0, 255));
+    image.setPixel(1, 1, qRgba(1, 0, 255, 255));
+
+    const QImage half = QGeoTileResampler::halve(image);
+    QCOMPARE(half.size(), QSize(1, 1));
+    QCOMPARE(half.format(), QImage::Format_ARGB32_Premultiplied);
+    // Averages are rounded to the nearest.
+    QCOMPARE(half.pixel(0, 0), qRgba(64, 64, 64, 255));
+
+    const QImage tile = quadrants(256);
+    const QImage level = QGeoTileResampler::halve(tile);
+    QCOMPARE(level.size(), QSize(128, 128));
+    QCOMPARE(QColor(level.pixel(10, 10)), QColor(Qt::red));
+    QCOMPARE(QColor(level.pixel(117, 10)), QColor(Qt::green));
+    QCOMPARE(QColor(level.pixel(10, 117)), QColor(Qt::blue));
+    QCOMPARE(QColor(level.pixel(117, 117)), QColor(Qt::yellow));
+}
+
+void tst_QGeoTileResampler::halveOddSizes()
+{
+    QImage image(5, 1, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::red);
+    QImage half = QGeoTileResampler::halve(image);
+    QCOMPARE(half.size(), QSize(2, 1));
+    QCOMPARE(QColor(half.pixel(1, 0)), QColor(Qt::red));
+
+    image = QImage(1, 3, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::blue);
+    half = QGeoTileResampler::halve(image);
+    QCOMPARE(half.size(), QSize(1, 1));
+    QCOMPARE(QColor(half.pixel(0, 0)), QColor(Qt::blue));
+}
+
+void tst_QGeoTileResampler::scaledMagnify()
+{
+    QImage image(2, 1, QImage::Format_ARGB32_Premultiplied);
+    image.setPixel(0, 0, qRgba(0, 0, 0, 255));
+    image.setPixel(1, 0, qRgba(255, 255, 255, 255));
+
+    const QImage scaled = QGeoTileResampler::scaled(image, QSize(8, 2));
+    QCOMPARE(scaled.size(), QSize(8, 2));
+    // Edge pixels are clamped, the ones in between form a ramp.
+    QCOMPARE(scaled.pixel(0, 0), qRgba(0, 0, 0, 255));
+    QCOMPARE(scaled.pixel(7, 1), qRgba(255, 255, 255, 255));
+    for (int x = 1; x < 8; ++x)
+        QVERIFY(qRed(scaled.pixel(x, 0)) >= qRed(scaled.pixel(x - 1, 0)));
+    QVERIFY(qAbs(qRed(scaled.pixel(3, 0)) + qRed(scaled.pixel(4, 0)) - 255) <= 2);
+    QCOMPARE(scaled.pixel(3, 0), scaled.pixel(3, 1));
+}
+
+void tst_QGeoTileResampler::scaledMatchesSmoothScaling()
+{
+    QImage image(64, 64, QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < image.height(); ++y) {
+        for (int x = 0; x < image.width(); ++x)
+            image.setPixel(x, y, qRgba(x * 4, y * 4, (x + y) * 2, 255));
+    }
+
+    const QImage ours = QGeoTileResampler::scaled(image, QSize(100, 100));
+    const QImage reference = image.scaled(100, 100, Qt::IgnoreAspectRatio, Qt::SmoothTransformation)
+                                  .convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    for (int y = 2; y < 98; ++y) {
+        for (int x = 2; x < 98; ++x)
+            QVERIFY2(maxDifference(ours.pixel(x, y), reference.pixel(x, y)) <= 4,
+                     qPrintable(QStringLiteral("at %1,%2").arg(x).arg(y)));
+    }
+}
+
+void tst_QGeoTileResampler::resampleCrop()
+{
+    const QImage tile = quadrants(256);
+
+    // The bottom right quarter, magnified to the size of a tile.
+    const QImage crop = QGeoTileResampler::resample(tile, QRect(128, 128, 128, 128), QSize(256, 256));
+    QCOMPARE(crop.size(), QSize(256, 256));
+    QCOMPARE(QColor(crop.pixel(0, 0)), QColor(Qt::yellow));
+    QCOMPARE(QColor(crop.pixel(255, 255)), QColor(Qt::yellow));
+
+    // A crop at the drawn size is copied as is.
+    const QImage copy = QGeoTileResampler::resample(tile, QRect(0, 0, 128, 128), QSize(128, 128));
+    QCOMPARE(copy, tile.copy(0, 0, 128, 128));
+
+    // Out of the image.
+    QVERIFY(QGeoTileResampler::resample(tile, QRect(300, 0, 10, 10), QSize(10, 10)).isNull());
+}
+
+void tst_QGeoTileResampler::resampleMinify()
+{
+    const QImage tile = quadrants(512);
+
+    const QImage half = QGeoTileResampler::resample(tile, tile.rect(), QSize(256, 256));
+    QCOMPARE(half, QGeoTileResampler::halve(tile));
+
+    const QImage small = QGeoTileResampler::resample(tile, tile.rect(), QSize(100, 100));
+    QCOMPARE(small.size(), QSize(100, 100));
+    QCOMPARE(QColor(small.pixel(20, 20)), QColor(Qt::red));
+    QCOMPARE(QColor(small.pixel(80, 20)), QColor(Qt::green));
+    QCOMPARE(QColor(small.pixel(20, 80)), QColor(Qt::blue));
+    QCOMPARE(QColor(small.pixel(80, 80)), QColor(Qt::yellow));
+}
+
+void tst_QGeoTileResampler::convertsFormat()
+{
+    QImage image(4, 4, QImage::Format_ARGB32);
+    image.fill(qRgba(255, 0, 0, 128));
+
+    const QImage half = QGeoTileResampler::halve(image);
+    QCOMPARE(half.format(), QImage::Format_ARGB32_Premultiplied);
+    QVERIFY(maxDifference(half.pixel(0, 0), qRgba(255, 0, 0, 128)) <= 1);
+
+    QImage rgb(4, 4, QImage::Format_RGB32);
+    rgb.fill(Qt::green);
+    const QImage scaled = QGeoTileResampler::scaled(rgb, QSize(6, 6));
+    QCOMPARE(scaled.format(), QImage::Format_ARGB32_Premultiplied);
+    QCOMPARE(QColor(scaled.pixel(3, 3)), QColor(Qt::green));
+}
+
+void tst_QGeoTileResampler::invalidInput()
+{
+    QVERIFY(QGeoTileResampler::halve(QImage()).isNull());
+    QVERIFY(QGeoTileResampler::scaled(QImage(), QSize(4, 4)).isNull());
+    QVERIFY(QGeoTileResampler::scaled(quadrants(4), QSize()).isNull());
+    QVERIFY(QGeoTileResampler::resample(quadrants(4), QRect(0, 0, 4, 4), QSize(0, 4)).isNull());
+}
+
+QTEST_MAIN(tst_QGeoTileResampler)
+
+#include "tst_qgeotileresampler.moc"
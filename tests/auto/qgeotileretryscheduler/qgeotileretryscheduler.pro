@@ -0,0 +1,7 @@
+TEMPLATE = app
+CONFIG += testcase
+TARGET = tst_qgeotileretryscheduler
+
+SOURCES += tst_qgeotileretryscheduler.cpp
+
+QT += location-private testlib
@@ -0,0 +1,318 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtLocation/private/qgeotiledmappingmanagerengine_p.h>
+#include <QtLocation/private/qgeotileretryscheduler_p.h>
+#include <QtLocation/private/qgeotilespec_p.h>
+
+QT_USE_NAMESPACE
+
+class RecordingEngine : public QGeoTiledMappingManagerEngine
+{
+public:
+    struct Request
+    {
+        QGeoTiledMap *map;
+        QSet<QGeoTileSpec> tiles;
+    };
+
+    void updateTileRequests(QGeoTiledMap *map,
+                            const QSet<QGeoTileSpec> &tilesAdded,
+                            const QSet<QGeoTileSpec> &tilesRemoved) override
+    {
+        Q_UNUSED(tilesRemoved)
+        requests.append({ map, tilesAdded });
+    }
+
+    int requestedTiles() const
+    {
+        int count = 0;
+        for (const Request &request : requests)
+            count += request.tiles.size();
+        return count;
+    }
+
+    QList<Request> requests;
+};
+
+// The scheduler never dereferences maps, it only hands them back.
+static QGeoTiledMap *const mapA = reinterpret_cast<QGeoTiledMap *>(quintptr(0x10));
+static QGeoTiledMap *const mapB = reinterpret_cast<QGeoTiledMap *>(quintptr(0x20));
+
+static QGeoTileSpec tile(int x)
+{
+    return QGeoTileSpec(QStringLiteral("test"), 1, 10, x, 0);
+}
+
+class tst_QGeoTileRetryScheduler : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void retryAfterBackoff();
+    void giveUp();
+    void batchesPerMap();
+    void circuitBreaker();
+    void probeFailure();
+    void probeCancelled();
+    void probeTimeout();
+    void independentHosts();
+    void cancel();
+    void releaseMap();
+};
+
+void tst_QGeoTileRetryScheduler::retryAfterBackoff()
+{
+    RecordingEngine engine;
+    QGeoTileRetryScheduler scheduler(&engine);
+    scheduler.setBackoff(20, 1000);
+
+    QVERIFY(scheduler.isIdle());
+    scheduler.hostFailed(QStringLiteral("a"));
+    QVERIFY(scheduler.retryTile(tile(1)));
+    scheduler.defer(mapA, tile(1), QStringLiteral("a"));
+    scheduler.defer(mapA, tile(1), QStringLiteral("a"));
+    QVERIFY(!scheduler.isIdle());
+    QVERIFY(!scheduler.isCircuitOpen(QStringLiteral("a")));
+    QCOMPARE(scheduler.deferredCount(), 1);
+    QCOMPARE(engine.requests.size(), 0);
+
+    QTRY_COMPARE(engine.requests.size(), 1);
+    QCOMPARE(engine.requests.first().map, mapA);
+    QCOMPARE(engine.requests.first().tiles, QSet<QGeoTileSpec>() << tile(1));
+    QCOMPARE(scheduler.deferredCount(), 0);
+
+    scheduler.tileSucceeded(tile(1), QStringLiteral("a"));
+    QVERIFY(scheduler.isIdle());
+}
+
+void tst_QGeoTileRetryScheduler::giveUp()
+{
+    RecordingEngine engine;
+    QGeoTileRetryScheduler scheduler(&engine);
+    scheduler.setMaximumRetries(2);
+
+    QVERIFY(scheduler.retryTile(tile(1)));
+    QVERIFY(scheduler.retryTile(tile(1)));
+    QVERIFY(!scheduler.retryTile(tile(1)));
+
+    // Giving up starts the count over.
+    QVERIFY(scheduler.retryTile(tile(1)));
+    QVERIFY(scheduler.retryTile(tile(2)));
+}
+
+void tst_QGeoTileRetryScheduler::batchesPerMap()
+{
+    RecordingEngine engine;
+    QGeoTileRetryScheduler scheduler(&engine);
+    scheduler.setBackoff(20, 1000);
+
+    scheduler.hostFailed(QStringLiteral("a"));
+    scheduler.defer(mapA, tile(1), QStringLiteral("a"));
+    scheduler.defer(mapA, tile(2), QStringLiteral("a"));
+    scheduler.defer(mapB, tile(2), QStringLiteral("a"));
+
+    QTRY_COMPARE(engine.requests.size(), 2);
+    QCOMPARE(engine.requestedTiles(), 3);
+    for (const RecordingEngine::Request &request : qAsConst(engine.requests)) {
+        if (request.map == mapA)
+            QCOMPARE(request.tiles, QSet<QGeoTileSpec>() << tile(1) << tile(2));
+        else
+            QCOMPARE(request.tiles, QSet<QGeoTileSpec>() << tile(2));
+    }
+}
+
+void tst_QGeoTileRetryScheduler::circuitBreaker()
+{
+    RecordingEngine engine;
+    QGeoTileRetryScheduler scheduler(&engine);
+    scheduler.setBackoff(20, 20);
+    scheduler.setFailureThreshold(3);
+
+    const QString host = QStringLiteral("a");
+    scheduler.hostFailed(host);
+    scheduler.hostFailed(host);
+    QVERIFY(!scheduler.hasOpenCircuits());
+    scheduler.hostFailed(host);
+    QVERIFY(scheduler.hasOpenCircuits());
+    QVERIFY(scheduler.isCircuitOpen(host));
+    QVERIFY(scheduler.isBlocked(host));
+
+    for (int x = 0; x < 4; ++x)
+        scheduler.defer(mapA, tile(x), host);
+
+    // Only a single probe goes out while the circuit is open.
+    QTRY_COMPARE(engine.requests.size(), 1);
+    QCOMPARE(engine.requests.first().tiles.size(), 1);
+    QTest::qWait(100);
+    QCOMPARE(engine.requests.size(), 1);
+    QCOMPARE(scheduler.deferredCount(), 3);
+
+    // The probe's success closes the circuit and sends everything else.
+    const QGeoTileSpec probe = *engine.requests.first().tiles.cbegin();
+    scheduler.tileSucceeded(probe, host);
+    QVERIFY(!scheduler.hasOpenCircuits());
+    QVERIFY(!scheduler.isBlocked(host));
+    QCOMPARE(engine.requests.size(), 2);
+    QCOMPARE(engine.requestedTiles(), 4);
+    QCOMPARE(scheduler.deferredCount(), 0);
+}
+
+void tst_QGeoTileRetryScheduler::probeFailure()
+{
+    RecordingEngine engine;
+    QGeoTileRetryScheduler scheduler(&engine);
+    scheduler.setBackoff(20, 20);
+    scheduler.setFailureThreshold(1);
+
+    const QString host = QStringLiteral("a");
+    scheduler.hostFailed(host);
+    scheduler.defer(mapA, tile(1), host);
+    scheduler.defer(mapA, tile(2), host);
+
+    QTRY_COMPARE(engine.requests.size(), 1);
+
+    // A failed probe goes back in line and the circuit stays open.
+    const QGeoTileSpec probe = *engine.requests.first().tiles.cbegin();
+    scheduler.hostFailed(host);
+    scheduler.defer(mapA, probe, host);
+    QVERIFY(scheduler.isCircuitOpen(host));
+
+    QTRY_COMPARE(engine.requests.size(), 2);
+    QCOMPARE(engine.requests.last().tiles.size(), 1);
+    QCOMPARE(scheduler.deferredCount(), 1);
+}
+
+void tst_QGeoTileRetryScheduler::probeCancelled()
+{
+    RecordingEngine engine;
+    QGeoTileRetryScheduler scheduler(&engine);
+    scheduler.setBackoff(20, 20);
+    scheduler.setFailureThreshold(1);
+
+    const QString host = QStringLiteral("a");
+    scheduler.hostFailed(host);
+    scheduler.defer(mapA, tile(1), host);
+    scheduler.defer(mapA, tile(2), host);
+
+    QTRY_COMPARE(engine.requests.size(), 1);
+
+    // A cancelled probe is never answered, the next tile is sent instead.
+    const QGeoTileSpec probe = *engine.requests.first().tiles.cbegin();
+    scheduler.cancel(mapA, QSet<QGeoTileSpec>() << probe);
+    QVERIFY(scheduler.isCircuitOpen(host));
+
+    QTRY_COMPARE(engine.requests.size(), 2);
+    QCOMPARE(engine.requests.last().tiles.size(), 1);
+    QVERIFY(!engine.requests.last().tiles.contains(probe));
+    QCOMPARE(scheduler.deferredCount(), 0);
+
+    // So does releasing the map of the probe.
+    scheduler.defer(mapA, probe, host);
+    scheduler.releaseMap(mapA);
+    scheduler.defer(mapB, tile(3), host);
+    QTRY_COMPARE(engine.requests.size(), 3);
+    QCOMPARE(engine.requests.last().map, mapB);
+}
+
+void tst_QGeoTileRetryScheduler::probeTimeout()
+{
+    RecordingEngine engine;
+    QGeoTileRetryScheduler scheduler(&engine);
+    scheduler.setBackoff(20, 20);
+    scheduler.setFailureThreshold(1);
+    scheduler.setProbeTimeout(50);
+
+    const QString host = QStringLiteral("a");
+    scheduler.hostFailed(host);
+    scheduler.defer(mapA, tile(1), host);
+
+    // A probe dropped without an answer is sent again.
+    QTRY_COMPARE(engine.requests.size(), 1);
+    QTRY_COMPARE(engine.requests.size(), 2);
+    QCOMPARE(engine.requests.last().tiles, QSet<QGeoTileSpec>() << tile(1));
+    QVERIFY(scheduler.isCircuitOpen(host));
+}
+
+void tst_QGeoTileRetryScheduler::independentHosts()
+{
+    RecordingEngine engine;
+    QGeoTileRetryScheduler scheduler(&engine);
+    scheduler.setFailureThreshold(1);
+
+    scheduler.hostFailed(QStringLiteral("a"));
+    QVERIFY(scheduler.isBlocked(QStringLiteral("a")));
+    QVERIFY(!scheduler.isBlocked(QStringLiteral("b")));
+
+    scheduler.tileSucceeded(tile(1), QStringLiteral("b"));
+    QVERIFY(scheduler.isBlocked(QStringLiteral("a")));
+}
+
+void tst_QGeoTileRetryScheduler::cancel()
+{
+    RecordingEngine engine;
+    QGeoTileRetryScheduler scheduler(&engine);
+    scheduler.setBackoff(20, 1000);
+
+    scheduler.hostFailed(QStringLiteral("a"));
+    scheduler.defer(mapA, tile(1), QStringLiteral("a"));
+    scheduler.defer(mapA, tile(2), QStringLiteral("a"));
+    scheduler.defer(mapB, tile(1), QStringLiteral("a"));
+    scheduler.cancel(mapA, QSet<QGeoTileSpec>() << tile(1));
+    QCOMPARE(scheduler.deferredCount(), 2);
+
+    QTRY_COMPARE(engine.requests.size(), 2);
+    QCOMPARE(engine.requestedTiles(), 2);
+    for (const RecordingEngine::Request &request : qAsConst(engine.requests)) {
+        if (request.map == mapA)
+            QCOMPARE(request.tiles, QSet<QGeoTileSpec>() << tile(2));
+        else
+            QCOMPARE(request.tiles, QSet<QGeoTileSpec>() << tile(1));
+    }
+}
+
+void tst_QGeoTileRetryScheduler::releaseMap()
+{
+    RecordingEngine engine;
+    QGeoTileRetryScheduler scheduler(&engine);
+    scheduler.setBackoff(20, 1000);
+
+    scheduler.hostFailed(QStringLiteral("a"));
+    scheduler.defer(mapA, tile(1), QStringLiteral("a"));
+    scheduler.defer(mapA, tile(2), QStringLiteral("a"));
+    scheduler.releaseMap(mapA);
+    QCOMPARE(scheduler.deferredCount(), 0);
+
+    QTest::qWait(100);
+    QCOMPARE(engine.requests.size(), 0);
+}
+
+QTEST_GUILESS_MAIN(tst_QGeoTileRetryScheduler)
+
+#include "tst_qgeotileretryscheduler.moc"
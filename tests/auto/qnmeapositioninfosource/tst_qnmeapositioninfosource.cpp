@@ -338,6 +338,30 @@ void tst_QNmeaPositionInfoSource::startUpdates_expectLatestUpdateOnly()
     QCOMPARE(spyUpdate[0][0].value<QGeoPositionInfo>().timestamp(), dateTimes.last());
 }
 
+void tst_QNmeaPositionInfoSource::stopUpdates()
+{
+    if (m_mode == QNmeaPositionInfoSource::SimulationMode)
+        QSKIP("Simulation mode reads the whole device on its own schedule");
+
+    QNmeaPositionInfoSource source(m_mode);
+    QNmeaPositionInfoSourceProxyFactory factory;
+    QNmeaPositionInfoSourceProxy *proxy = static_cast<QNmeaPositionInfoSourceProxy*>(factory.createProxy(&source));
+
+    QSignalSpy spyUpdate(proxy->source(), SIGNAL(positionUpdated(QGeoPositionInfo)));
+    proxy->source()->startUpdates();
+
+    QDateTime dt = QDateTime::currentDateTime().toUTC();
+    proxy->feedUpdate(dt);
+    QTRY_COMPARE(spyUpdate.count(), 1);
+
+    // A stopped source must neither emit nor parse what is still read.
+    proxy->source()->stopUpdates();
+    proxy->feedUpdate(dt.addSecs(1));
+    QTest::qWait(300);
+    QCOMPARE(spyUpdate.count(), 1);
+    QCOMPARE(proxy->source()->lastKnownPosition().timestamp(), dt);
+}
+
 void tst_QNmeaPositionInfoSource::startUpdates_waitForValidDateTime()
 {
     // Tests that the class does not emit an update until it receives a
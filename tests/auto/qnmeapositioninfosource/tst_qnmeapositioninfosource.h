@@ -102,6 +102,8 @@ private slots:
 
     void startUpdates_expectLatestUpdateOnly();
 
+    void stopUpdates();
+
     void startUpdates_waitForValidDateTime();
     void startUpdates_waitForValidDateTime_data();
 
@@ -0,0 +1,9 @@
+TEMPLATE = app
+CONFIG+=testcase
+QT += network positioning testlib
+TARGET = tst_qnmeasatelliteinfosource
+
+HEADERS += ../utils/qlocationtestutils_p.h
+
+SOURCES += ../utils/qlocationtestutils.cpp \
+           tst_qnmeasatelliteinfosource.cpp
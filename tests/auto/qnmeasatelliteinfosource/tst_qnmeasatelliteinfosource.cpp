@@ -0,0 +1,193 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "../utils/qlocationtestutils_p.h"
+
+#include <QtPositioning/qnmeapositioninfosource.h>
+#include <QtPositioning/qnmeasatelliteinfosource.h>
+
+#include <QTest>
+#include <QBuffer>
+#include <QSignalSpy>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+QT_USE_NAMESPACE
+Q_DECLARE_METATYPE(QList<QGeoSatelliteInfo>)
+
+// Two GSV sentences with 6 GPS satellites, and a GSA using 3 of them.
+static QByteArray createEpoch(const QDateTime &dt)
+{
+    QByteArray epoch;
+    epoch += QLocationTestUtils::createRmcSentence(dt).toLatin1();
+    epoch += QLocationTestUtils::addNmeaChecksumAndBreaks(
+                QStringLiteral("$GPGSV,2,1,06,02,45,120,38,05,12,300,21,12,70,045,44,15,05,210,*")).toLatin1();
+    epoch += QLocationTestUtils::addNmeaChecksumAndBreaks(
+                QStringLiteral("$GPGSV,2,2,06,24,33,080,40,29,,,*")).toLatin1();
+    epoch += QLocationTestUtils::addNmeaChecksumAndBreaks(
+                QStringLiteral("$GPGSA,A,3,02,12,24,,,,,,,,,,2.1,1.2,1.7*")).toLatin1();
+    return epoch;
+}
+
+class tst_QNmeaSatelliteInfoSource : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void constructor();
+    void minimumUpdateInterval();
+    void simulation();
+    void simulation_incompleteGroup();
+    void requestUpdate_timeout();
+    void realTime_sharedDevice();
+};
+
+void tst_QNmeaSatelliteInfoSource::initTestCase()
+{
+    qRegisterMetaType<QList<QGeoSatelliteInfo> >();
+}
+
+void tst_QNmeaSatelliteInfoSource::constructor()
+{
+    QObject o;
+    QNmeaSatelliteInfoSource source(QNmeaSatelliteInfoSource::SimulationMode, &o);
+    QCOMPARE(source.parent(), &o);
+    QCOMPARE(source.updateMode(), QNmeaSatelliteInfoSource::SimulationMode);
+    QVERIFY(!source.device());
+    QCOMPARE(source.error(), QGeoSatelliteInfoSource::NoError);
+}
+
+void tst_QNmeaSatelliteInfoSource::minimumUpdateInterval()
+{
+    QNmeaSatelliteInfoSource source(QNmeaSatelliteInfoSource::RealTimeMode);
+    QCOMPARE(source.minimumUpdateInterval(), 2);
+}
+
+void tst_QNmeaSatelliteInfoSource::simulation()
+{
+    const QDateTime dt = QDateTime::currentDateTimeUtc();
+    QBuffer buffer;
+    buffer.setData(createEpoch(dt) + createEpoch(dt.addMSecs(200)) + createEpoch(dt.addMSecs(400)));
+
+    QNmeaSatelliteInfoSource source(QNmeaSatelliteInfoSource::SimulationMode);
+    source.setDevice(&buffer);
+    QSignalSpy inViewSpy(&source, SIGNAL(satellitesInViewUpdated(QList<QGeoSatelliteInfo>)));
+    QSignalSpy inUseSpy(&source, SIGNAL(satellitesInUseUpdated(QList<QGeoSatelliteInfo>)));
+    source.startUpdates();
+
+    // The first epoch is emitted once the second one starts; the rest are paced.
+    QCOMPARE(inViewSpy.count(), 1);
+    QTRY_COMPARE(inViewSpy.count(), 3);
+    QCOMPARE(inUseSpy.count(), 3);
+
+    const QList<QGeoSatelliteInfo> inView = inViewSpy.last().at(0).value<QList<QGeoSatelliteInfo> >();
+    QCOMPARE(inView.count(), 6);
+    QCOMPARE(inView.at(0).satelliteIdentifier(), 2);
+    QCOMPARE(inView.at(0).satelliteSystem(), QGeoSatelliteInfo::GPS);
+    QCOMPARE(inView.at(0).signalStrength(), 38);
+    QCOMPARE(inView.at(0).attribute(QGeoSatelliteInfo::Elevation), qreal(45));
+    QCOMPARE(inView.at(0).attribute(QGeoSatelliteInfo::Azimuth), qreal(120));
+    QVERIFY(!inView.at(5).hasAttribute(QGeoSatelliteInfo::Elevation));
+
+    const QList<QGeoSatelliteInfo> inUse = inUseSpy.last().at(0).value<QList<QGeoSatelliteInfo> >();
+    QCOMPARE(inUse.count(), 3);
+    QCOMPARE(inUse.at(0).satelliteIdentifier(), 2);
+    QCOMPARE(inUse.at(1).satelliteIdentifier(), 12);
+    QCOMPARE(inUse.at(2).satelliteIdentifier(), 24);
+}
+
+void tst_QNmeaSatelliteInfoSource::simulation_incompleteGroup()
+{
+    const QDateTime dt = QDateTime::currentDateTimeUtc();
+    QByteArray data = QLocationTestUtils::createRmcSentence(dt).toLatin1();
+    // Only the first sentence of the group: nothing must be reported.
+    data += QLocationTestUtils::addNmeaChecksumAndBreaks(
+                QStringLiteral("$GPGSV,2,1,06,02,45,120,38,05,12,300,21,12,70,045,44,15,05,210,*")).toLatin1();
+    data += createEpoch(dt.addMSecs(100));
+
+    QBuffer buffer;
+    buffer.setData(data);
+    QNmeaSatelliteInfoSource source(QNmeaSatelliteInfoSource::SimulationMode);
+    source.setDevice(&buffer);
+    QSignalSpy inViewSpy(&source, SIGNAL(satellitesInViewUpdated(QList<QGeoSatelliteInfo>)));
+    source.startUpdates();
+
+    QTRY_COMPARE(inViewSpy.count(), 1);
+    const QList<QGeoSatelliteInfo> inView = inViewSpy.last().at(0).value<QList<QGeoSatelliteInfo> >();
+    QCOMPARE(inView.count(), 6);
+}
+
+void tst_QNmeaSatelliteInfoSource::requestUpdate_timeout()
+{
+    QBuffer buffer;
+    buffer.setData(QLocationTestUtils::createRmcSentence(QDateTime::currentDateTimeUtc()).toLatin1());
+
+    QNmeaSatelliteInfoSource source(QNmeaSatelliteInfoSource::SimulationMode);
+    source.setDevice(&buffer);
+    QSignalSpy timeoutSpy(&source, SIGNAL(requestTimeout()));
+    source.requestUpdate(-1);
+    QCOMPARE(timeoutSpy.count(), 1);
+    source.requestUpdate(100);
+    QTRY_COMPARE(timeoutSpy.count(), 2);
+}
+
+void tst_QNmeaSatelliteInfoSource::realTime_sharedDevice()
+{
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+    QTcpSocket client;
+    client.connectToHost(server.serverAddress(), server.serverPort());
+    QVERIFY(server.waitForNewConnection(15000));
+    QVERIFY(client.waitForConnected());
+    QIODevice *device = server.nextPendingConnection();
+    QVERIFY(device);
+
+    QNmeaPositionInfoSource positionSource(QNmeaPositionInfoSource::RealTimeMode);
+    QNmeaSatelliteInfoSource satelliteSource(QNmeaSatelliteInfoSource::RealTimeMode);
+    positionSource.setDevice(device);
+    satelliteSource.setDevice(device);
+
+    QSignalSpy positionSpy(&positionSource, SIGNAL(positionUpdated(QGeoPositionInfo)));
+    QSignalSpy inViewSpy(&satelliteSource, SIGNAL(satellitesInViewUpdated(QList<QGeoSatelliteInfo>)));
+    positionSource.startUpdates();
+    satelliteSource.startUpdates();
+
+    const QDateTime dt = QDateTime::currentDateTimeUtc();
+    for (int i = 0; i < 3; ++i)
+        client.write(createEpoch(dt.addMSecs(i * 100)));
+    client.flush();
+
+    QTRY_VERIFY(positionSpy.count() >= 2);
+    QTRY_COMPARE(inViewSpy.count(), 3);
+    QCOMPARE(inViewSpy.last().at(0).value<QList<QGeoSatelliteInfo> >().count(), 6);
+}
+
+QTEST_GUILESS_MAIN(tst_QNmeaSatelliteInfoSource)
+#include "tst_qnmeasatelliteinfosource.moc"
@@ -0,0 +1,7 @@
+TEMPLATE = app
+CONFIG += testcase
+TARGET = tst_qplacejsonstreamreader
+
+SOURCES += tst_qplacejsonstreamreader.cpp
+
+QT += location-private testlib
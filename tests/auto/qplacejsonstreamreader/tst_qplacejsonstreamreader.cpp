@@ -0,0 +1,236 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QString>
+#include <QtTest/QtTest>
+#include <QtLocation/private/qplacejsonstreamreader_p.h>
+
+QT_USE_NAMESPACE
+
+class tst_QPlaceJsonStreamReader : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void rootArray();
+    void nestedArray();
+    void multiplePaths();
+    void strings();
+    void chunked_data();
+    void chunked();
+    void notFound();
+    void error();
+};
+
+void tst_QPlaceJsonStreamReader::rootArray()
+{
+    QPlaceJsonStreamReader reader;
+    reader.addArrayPath(QStringList());
+
+    reader.addData("[{\"id\": 1}, {\"id\": 3, \"list\": [{\"id\": 4}, 5]}]");
+
+    QVERIFY(reader.atEnd());
+    QVERIFY(!reader.hasError());
+    QVERIFY(reader.arrayFound());
+
+    const QList<QJsonObject> objects = reader.takeObjects();
+    QCOMPARE(objects.count(), 2);
+    QCOMPARE(objects.at(0).value(QStringLiteral("id")).toInt(), 1);
+    QCOMPARE(objects.at(1).value(QStringLiteral("id")).toInt(), 3);
+    QCOMPARE(objects.at(1).value(QStringLiteral("list")).toArray().count(), 1);
+
+    QVERIFY(reader.takeObjects().isEmpty());
+    QCOMPARE(reader.remainder(), QByteArray("[{}, {}]"));
+}
+
+void tst_QPlaceJsonStreamReader::nestedArray()
+{
+    QPlaceJsonStreamReader reader;
+    reader.addArrayPath(QStringList() << QStringLiteral("results") << QStringLiteral("items"));
+
+    reader.addData("{\"items\": [{\"id\": 0}], \"results\": {\"next\": \"page2\", "
+                   "\"items\": [{\"id\": 1}, {\"id\": 2}]}, \"other\": [{\"id\": 5}]}");
+
+    QVERIFY(reader.atEnd());
+    const QList<QJsonObject> objects = reader.takeObjects();
+    QCOMPARE(objects.count(), 2);
+    QCOMPARE(objects.at(0).value(QStringLiteral("id")).toInt(), 1);
+    QCOMPARE(objects.at(1).value(QStringLiteral("id")).toInt(), 2);
+
+    const QJsonDocument remainder = QJsonDocument::fromJson(reader.remainder());
+    QVERIFY(remainder.isObject());
+    const QJsonObject results = remainder.object().value(QStringLiteral("results")).toObject();
+    QCOMPARE(results.value(QStringLiteral("next")).toString(), QStringLiteral("page2"));
+    QCOMPARE(results.value(QStringLiteral("items")).toArray().count(), 2);
+    QCOMPARE(remainder.object().value(QStringLiteral("items")).toArray().at(0).toObject()
+             .value(QStringLiteral("id")).toInt(), 0);
+}
+
+void tst_QPlaceJsonStreamReader::multiplePaths()
+{
+    QPlaceJsonStreamReader reader;
+    reader.addArrayPath(QStringList() << QStringLiteral("results") << QStringLiteral("items"));
+    reader.addArrayPath(QStringList() << QStringLiteral("items"));
+
+    reader.addData("{\"next\": \"page2\", \"items\": [{\"id\": 1}]}");
+
+    QVERIFY(reader.atEnd());
+    QVERIFY(reader.arrayFound());
+    QCOMPARE(reader.takeObjects().count(), 1);
+}
+
+void tst_QPlaceJsonStreamReader::strings()
+{
+    QPlaceJsonStreamReader reader;
+    reader.addArrayPath(QStringList() << QStringLiteral("it\"ems"));
+
+    reader.addData("{\"text\": \"[{\\\"items\\\": ]\", \"it\\\"ems\": "
+                   "[{\"name\": \"a } b ] \\\\\"}, {\"name\": \"\\\"{\"}]}");
+
+    QVERIFY(!reader.hasError());
+    QVERIFY(reader.atEnd());
+    const QList<QJsonObject> objects = reader.takeObjects();
+    QCOMPARE(objects.count(), 2);
+    QCOMPARE(objects.at(0).value(QStringLiteral("name")).toString(), QStringLiteral("a } b ] \\"));
+    QCOMPARE(objects.at(1).value(QStringLiteral("name")).toString(), QStringLiteral("\"{"));
+}
+
+void tst_QPlaceJsonStreamReader::chunked_data()
+{
+    QTest::addColumn<int>("chunkSize");
+
+    QTest::newRow("1") << 1;
+    QTest::newRow("3") << 3;
+    QTest::newRow("7") << 7;
+    QTest::newRow("64") << 64;
+}
+
+void tst_QPlaceJsonStreamReader::chunked()
+{
+    QFETCH(int, chunkSize);
+
+    QByteArray document("{\"results\": {\"next\": \"http://example.com/?q=\\\"}\", \"items\": [");
+    for (int i = 0; i < 20; ++i) {
+        if (i > 0)
+            document.append(", ");
+        document.append(QStringLiteral("{\"id\": %1, \"title\": \"Place {%1}\"}").arg(i).toUtf8());
+    }
+    document.append("]}, \"previous\": null}");
+
+    QPlaceJsonStreamReader reader;
+    reader.addArrayPath(QStringList() << QStringLiteral("results") << QStringLiteral("items"));
+
+    QList<QJsonObject> objects;
+    for (int i = 0; i < document.size(); i += chunkSize) {
+        reader.addData(document.mid(i, chunkSize));
+        QVERIFY(!reader.hasError());
+
+        // Objects are reported as soon as their closing brace is received.
+        objects.append(reader.takeObjects());
+        const int closed = document.left(i + chunkSize).count("}\"}");
+        QCOMPARE(objects.count(), closed);
+    }
+
+    QVERIFY(reader.atEnd());
+    QCOMPARE(objects.count(), 20);
+    for (int i = 0; i < objects.count(); ++i) {
+        QCOMPARE(objects.at(i).value(QStringLiteral("id")).toInt(), i);
+        QCOMPARE(objects.at(i).value(QStringLiteral("title")).toString(),
+                 QStringLiteral("Place {%1}").arg(i));
+    }
+
+    const QJsonObject remainder = QJsonDocument::fromJson(reader.remainder()).object();
+    QCOMPARE(remainder.value(QStringLiteral("results")).toObject().value(QStringLiteral("next")).toString(),
+             QStringLiteral("http://example.com/?q=\"}"));
+    QVERIFY(remainder.contains(QStringLiteral("previous")));
+}
+
+void tst_QPlaceJsonStreamReader::notFound()
+{
+    QPlaceJsonStreamReader reader;
+    reader.addArrayPath(QStringList() << QStringLiteral("items"));
+
+    reader.addData("{\"error\": \"Invalid request\"}");
+
+    QVERIFY(reader.atEnd());
+    QVERIFY(!reader.hasError());
+    QVERIFY(!reader.arrayFound());
+    QVERIFY(reader.takeObjects().isEmpty());
+    QCOMPARE(reader.remainder(), QByteArray("{\"error\": \"Invalid request\"}"));
+}
+
+void tst_QPlaceJsonStreamReader::error()
+{
+    QPlaceJsonStreamReader mismatched;
+    mismatched.addArrayPath(QStringList());
+    mismatched.addData("[{\"id\": 1]");
+    QVERIFY(mismatched.hasError());
+    QVERIFY(!mismatched.atEnd());
+
+    QPlaceJsonStreamReader trailing;
+    trailing.addArrayPath(QStringList());
+    trailing.addData("[{\"id\": 1}] [{\"id\": 2}]");
+    QVERIFY(!trailing.hasError());
+    QVERIFY(trailing.atEnd());
+    QCOMPARE(trailing.takeObjects().count(), 1);
+
+    QPlaceJsonStreamReader truncated;
+    truncated.addArrayPath(QStringList());
+    truncated.addData("[{\"id\": 1}, {\"id\"");
+    QVERIFY(!truncated.hasError());
+    QVERIFY(!truncated.atEnd());
+    QCOMPARE(truncated.takeObjects().count(), 1);
+
+    // The arrays hold objects only.
+    const QByteArray nonObjects[] = { "[{\"id\": 1}, 2]", "[\"x\"]", "[[]]", "[null]", "[ true ]" };
+    for (const QByteArray &data : nonObjects) {
+        QPlaceJsonStreamReader reader;
+        reader.addArrayPath(QStringList());
+        reader.addData(data);
+        QVERIFY2(reader.hasError(), data.constData());
+    }
+
+    QPlaceJsonStreamReader invalidObject;
+    invalidObject.addArrayPath(QStringList());
+    invalidObject.addData("[{\"id\": 1}, {\"id\": }]");
+    QVERIFY(invalidObject.hasError());
+    QCOMPARE(invalidObject.takeObjects().count(), 1);
+
+    QPlaceJsonStreamReader outside;
+    outside.addArrayPath(QStringList() << QStringLiteral("items"));
+    outside.addData("{\"count\": 2, \"other\": [1, \"x\"], \"items\": [{\"id\": 1}]}");
+    QVERIFY(!outside.hasError());
+    QVERIFY(outside.atEnd());
+    QCOMPARE(outside.takeObjects().count(), 1);
+}
+
+QTEST_APPLESS_MAIN(tst_QPlaceJsonStreamReader)
+
+#include "tst_qplacejsonstreamreader.moc"
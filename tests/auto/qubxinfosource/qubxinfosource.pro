@@ -0,0 +1,6 @@
+TEMPLATE = app
+CONFIG+=testcase
+QT += network positioning-private testlib
+TARGET = tst_qubxinfosource
+
+SOURCES += tst_qubxinfosource.cpp
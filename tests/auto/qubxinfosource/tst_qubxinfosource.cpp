@@ -0,0 +1,321 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtPositioning/private/qubxdecoder_p.h>
+#include <QtPositioning/private/qubxpositioninfosource_p.h>
+#include <QtPositioning/private/qubxsatelliteinfosource_p.h>
+
+#include <QTest>
+#include <QBuffer>
+#include <QElapsedTimer>
+#include <QSignalSpy>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QtCore/QtEndian>
+
+QT_USE_NAMESPACE
+Q_DECLARE_METATYPE(QList<QGeoSatelliteInfo>)
+
+static QByteArray ubxFrame(quint8 messageClass, quint8 messageId, const QByteArray &payload)
+{
+    QByteArray frame;
+    frame.append(char(0xB5));
+    frame.append(char(0x62));
+    frame.append(char(messageClass));
+    frame.append(char(messageId));
+    frame.append(char(payload.size() & 0xff));
+    frame.append(char(payload.size() >> 8));
+    frame.append(payload);
+
+    quint8 ckA = 0;
+    quint8 ckB = 0;
+    for (int i = 2; i < frame.size(); ++i) {
+        ckA += quint8(frame.at(i));
+        ckB += ckA;
+    }
+    frame.append(char(ckA));
+    frame.append(char(ckB));
+    return frame;
+}
+
+static QByteArray navPvt(quint32 timeOfWeek, const QDateTime &dt, double lat, double lon)
+{
+    QByteArray payload(92, 0);
+    uchar *p = reinterpret_cast<uchar *>(payload.data());
+    qToLittleEndian<quint32>(timeOfWeek, p);
+    qToLittleEndian<quint16>(quint16(dt.date().year()), p + 4);
+    p[6] = uchar(dt.date().month());
+    p[7] = uchar(dt.date().day());
+    p[8] = uchar(dt.time().hour());
+    p[9] = uchar(dt.time().minute());
+    p[10] = uchar(dt.time().second());
+    p[11] = 0x07; // validDate | validTime | fullyResolved
+    qToLittleEndian<qint32>(dt.time().msec() * 1000000, p + 16);
+    p[20] = 3; // 3D fix
+    p[21] = 0x01; // gnssFixOK
+    p[23] = 9;
+    qToLittleEndian<qint32>(qint32(qRound(lon * 1e7)), p + 24);
+    qToLittleEndian<qint32>(qint32(qRound(lat * 1e7)), p + 28);
+    qToLittleEndian<qint32>(45200, p + 36); // hMSL 45.2 m
+    qToLittleEndian<quint32>(2500, p + 40); // hAcc 2.5 m
+    qToLittleEndian<quint32>(4000, p + 44); // vAcc 4 m
+    qToLittleEndian<qint32>(-500, p + 56); // velD, 0.5 m/s up
+    qToLittleEndian<qint32>(12000, p + 60); // gSpeed 12 m/s
+    qToLittleEndian<qint32>(9000000, p + 64); // headMot 90 deg
+    return ubxFrame(QUbxDecoder::ClassNav, QUbxDecoder::NavPvt, payload);
+}
+
+static QByteArray navSat(quint32 timeOfWeek)
+{
+    // gnssId, svId, cno, elevation, azimuth, used
+    static const int sats[][6] = {
+        { 0, 2, 38, 45, 120, 1 },
+        { 0, 12, 44, 70, 45, 1 },
+        { 6, 5, 21, 12, 300, 0 }
+    };
+    const int count = 3;
+    QByteArray payload(8 + 12 * count, 0);
+    uchar *p = reinterpret_cast<uchar *>(payload.data());
+    qToLittleEndian<quint32>(timeOfWeek, p);
+    p[4] = 1;
+    p[5] = count;
+    for (int i = 0; i < count; ++i) {
+        uchar *block = p + 8 + 12 * i;
+        block[0] = uchar(sats[i][0]);
+        block[1] = uchar(sats[i][1]);
+        block[2] = uchar(sats[i][2]);
+        block[3] = uchar(qint8(sats[i][3]));
+        qToLittleEndian<qint16>(qint16(sats[i][4]), block + 4);
+        qToLittleEndian<quint32>(sats[i][5] ? 0x0f : 0x04, block + 8);
+    }
+    return ubxFrame(QUbxDecoder::ClassNav, QUbxDecoder::NavSat, payload);
+}
+
+static QByteArray epoch(int index)
+{
+    const quint32 timeOfWeek = 100000 + index * 200;
+    const QDateTime dt = QDateTime(QDate(2019, 4, 1), QTime(12, 0), Qt::UTC).addMSecs(index * 200);
+    return navPvt(timeOfWeek, dt, 60.17 + index * 0.001, 24.94) + navSat(timeOfWeek);
+}
+
+class MessageCollector : public QUbxMessageSink
+{
+public:
+    void processMessage(quint8 messageClass, quint8 messageId, const uchar *payload, int size) override
+    {
+        ids.append(qMakePair(messageClass, messageId));
+        sizes.append(size);
+        Q_UNUSED(payload);
+    }
+
+    QList<QPair<quint8, quint8> > ids;
+    QList<int> sizes;
+};
+
+class tst_QUbxInfoSource : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void decoder_wholeFrames();
+    void decoder_splitFrames();
+    void decoder_garbageAndChecksum();
+    void parseNavPvt();
+    void parseNavSat();
+    void simulation();
+    void realTime_sharedDevice();
+};
+
+void tst_QUbxInfoSource::initTestCase()
+{
+    qRegisterMetaType<QList<QGeoSatelliteInfo> >();
+}
+
+void tst_QUbxInfoSource::decoder_wholeFrames()
+{
+    MessageCollector collector;
+    QUbxDecoder decoder(&collector);
+    const QByteArray data = epoch(0) + epoch(1);
+    decoder.feed(data.constData(), data.size());
+
+    QCOMPARE(decoder.messageCount(), quint64(4));
+    QCOMPARE(decoder.checksumErrorCount(), quint64(0));
+    QCOMPARE(collector.ids.at(0), qMakePair(quint8(QUbxDecoder::ClassNav), quint8(QUbxDecoder::NavPvt)));
+    QCOMPARE(collector.ids.at(1), qMakePair(quint8(QUbxDecoder::ClassNav), quint8(QUbxDecoder::NavSat)));
+    QCOMPARE(collector.sizes.at(0), 92);
+    QCOMPARE(collector.sizes.at(1), 8 + 3 * 12);
+}
+
+void tst_QUbxInfoSource::decoder_splitFrames()
+{
+    MessageCollector collector;
+    QUbxDecoder decoder(&collector);
+    const QByteArray data = epoch(0) + epoch(1);
+    for (int i = 0; i < data.size(); ++i)
+        decoder.feed(data.constData() + i, 1);
+
+    QCOMPARE(decoder.messageCount(), quint64(4));
+    QCOMPARE(decoder.checksumErrorCount(), quint64(0));
+    QCOMPARE(collector.sizes.at(0), 92);
+}
+
+void tst_QUbxInfoSource::decoder_garbageAndChecksum()
+{
+    MessageCollector collector;
+    QUbxDecoder decoder(&collector);
+
+    QByteArray corrupt = navSat(1000);
+    corrupt[10] = corrupt.at(10) ^ 0x01;
+
+    QByteArray data;
+    data += "$GPGGA,garbage*00\r\n";
+    data += char(0xB5); // stray sync byte
+    data += navPvt(1000, QDateTime::currentDateTimeUtc(), 1.0, 2.0);
+    data += corrupt;
+    data += navSat(1000);
+    decoder.feed(data.constData(), data.size());
+
+    QCOMPARE(decoder.messageCount(), quint64(2));
+    QCOMPARE(decoder.checksumErrorCount(), quint64(1));
+}
+
+void tst_QUbxInfoSource::parseNavPvt()
+{
+    const QDateTime dt(QDate(2019, 4, 1), QTime(12, 30, 15, 250), Qt::UTC);
+    const QByteArray frame = navPvt(5000, dt, 60.17, 24.94);
+    const uchar *payload = reinterpret_cast<const uchar *>(frame.constData()) + 6;
+
+    QGeoPositionInfo info;
+    bool hasFix = false;
+    QVERIFY(QUbxDecoder::parseNavPvt(payload, frame.size() - 8, &info, &hasFix));
+    QVERIFY(hasFix);
+    QCOMPARE(info.timestamp(), dt);
+    QVERIFY(qAbs(info.coordinate().latitude() - 60.17) < 1e-6);
+    QVERIFY(qAbs(info.coordinate().longitude() - 24.94) < 1e-6);
+    QCOMPARE(info.coordinate().altitude(), 45.2);
+    QCOMPARE(info.attribute(QGeoPositionInfo::HorizontalAccuracy), qreal(2.5));
+    QCOMPARE(info.attribute(QGeoPositionInfo::VerticalAccuracy), qreal(4.0));
+    QCOMPARE(info.attribute(QGeoPositionInfo::GroundSpeed), qreal(12.0));
+    QCOMPARE(info.attribute(QGeoPositionInfo::Direction), qreal(90.0));
+    QCOMPARE(info.attribute(QGeoPositionInfo::VerticalSpeed), qreal(0.5));
+    QVERIFY(!info.hasAttribute(QGeoPositionInfo::MagneticVariation));
+
+    QVERIFY(!QUbxDecoder::parseNavPvt(payload, 40, &info, &hasFix));
+}
+
+void tst_QUbxInfoSource::parseNavSat()
+{
+    const QByteArray frame = navSat(5000);
+    const uchar *payload = reinterpret_cast<const uchar *>(frame.constData()) + 6;
+
+    QList<QGeoSatelliteInfo> inView;
+    QList<QGeoSatelliteInfo> inUse;
+    QVERIFY(QUbxDecoder::parseNavSat(payload, frame.size() - 8, &inView, &inUse));
+    QCOMPARE(inView.size(), 3);
+    QCOMPARE(inUse.size(), 2);
+    QCOMPARE(inView.at(2).satelliteSystem(), QGeoSatelliteInfo::GLONASS);
+    QCOMPARE(inView.at(2).satelliteIdentifier(), 5);
+    QCOMPARE(inView.at(2).signalStrength(), 21);
+    QCOMPARE(inView.at(2).attribute(QGeoSatelliteInfo::Azimuth), qreal(300));
+    QCOMPARE(inUse.at(1).satelliteIdentifier(), 12);
+
+    // truncated payload
+    QVERIFY(!QUbxDecoder::parseNavSat(payload, frame.size() - 20, &inView, &inUse));
+}
+
+void tst_QUbxInfoSource::simulation()
+{
+    QByteArray data;
+    for (int i = 0; i < 4; ++i)
+        data += epoch(i);
+    QBuffer positionBuffer;
+    positionBuffer.setData(data);
+    QBuffer satelliteBuffer;
+    satelliteBuffer.setData(data);
+
+    QUbxPositionInfoSource positionSource(QUbxPositionInfoSource::SimulationMode);
+    positionSource.setDevice(&positionBuffer);
+    QUbxSatelliteInfoSource satelliteSource(QUbxSatelliteInfoSource::SimulationMode);
+    satelliteSource.setDevice(&satelliteBuffer);
+
+    QSignalSpy positionSpy(&positionSource, SIGNAL(positionUpdated(QGeoPositionInfo)));
+    QSignalSpy inViewSpy(&satelliteSource, SIGNAL(satellitesInViewUpdated(QList<QGeoSatelliteInfo>)));
+    QSignalSpy inUseSpy(&satelliteSource, SIGNAL(satellitesInUseUpdated(QList<QGeoSatelliteInfo>)));
+
+    QElapsedTimer timer;
+    timer.start();
+    positionSource.startUpdates();
+    satelliteSource.startUpdates();
+
+    // The first epoch is delivered at once, the others 200 ms apart.
+    QCOMPARE(positionSpy.count(), 1);
+    QCOMPARE(inViewSpy.count(), 1);
+    QTRY_COMPARE(positionSpy.count(), 4);
+    QTRY_COMPARE(inViewSpy.count(), 4);
+    QVERIFY(timer.elapsed() >= 550);
+    QCOMPARE(inUseSpy.count(), 4);
+
+    const QGeoPositionInfo last = positionSpy.last().at(0).value<QGeoPositionInfo>();
+    QVERIFY(qAbs(last.coordinate().latitude() - 60.173) < 1e-6);
+    QCOMPARE(positionSource.lastKnownPosition(), last);
+}
+
+void tst_QUbxInfoSource::realTime_sharedDevice()
+{
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+    QTcpSocket client;
+    client.connectToHost(server.serverAddress(), server.serverPort());
+    QVERIFY(server.waitForNewConnection(15000));
+    QVERIFY(client.waitForConnected());
+    QIODevice *device = server.nextPendingConnection();
+    QVERIFY(device);
+
+    QUbxPositionInfoSource positionSource(QUbxPositionInfoSource::RealTimeMode);
+    QUbxSatelliteInfoSource satelliteSource(QUbxSatelliteInfoSource::RealTimeMode);
+    positionSource.setDevice(device);
+    satelliteSource.setDevice(device);
+
+    QSignalSpy positionSpy(&positionSource, SIGNAL(positionUpdated(QGeoPositionInfo)));
+    QSignalSpy inViewSpy(&satelliteSource, SIGNAL(satellitesInViewUpdated(QList<QGeoSatelliteInfo>)));
+    positionSource.startUpdates();
+    satelliteSource.startUpdates();
+
+    for (int i = 0; i < 3; ++i)
+        client.write(epoch(i));
+    client.flush();
+
+    QTRY_COMPARE(positionSpy.count(), 3);
+    QTRY_COMPARE(inViewSpy.count(), 3);
+    QCOMPARE(inViewSpy.last().at(0).value<QList<QGeoSatelliteInfo> >().count(), 3);
+}
+
+QTEST_GUILESS_MAIN(tst_QUbxInfoSource)
+#include "tst_qubxinfosource.moc"
@@ -0,0 +1,5 @@
+TEMPLATE = subdirs
+
+qtHaveModule(location): SUBDIRS += qgeorouteparserosrmv5 \
+                                    qgeorouteprogresstracker \
+                                    qgeotilefetcher
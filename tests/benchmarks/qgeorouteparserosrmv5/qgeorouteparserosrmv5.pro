@@ -0,0 +1,6 @@
+TEMPLATE = app
+TARGET = tst_bench_qgeorouteparserosrmv5
+
+SOURCES += tst_bench_qgeorouteparserosrmv5.cpp
+
+QT = core location-private positioning testlib
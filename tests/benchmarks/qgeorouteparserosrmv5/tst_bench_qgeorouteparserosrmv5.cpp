@@ -0,0 +1,158 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <QtCore/qmath.h>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtPositioning/QGeoCoordinate>
+#include <QtLocation/QGeoRoute>
+#include <QtLocation/private/qgeorouteparserosrmv5_p.h>
+
+QT_USE_NAMESPACE
+
+static void encodeValue(int value, QByteArray &out)
+{
+    uint v = value < 0 ? ~(uint(value) << 1) : (uint(value) << 1);
+    while (v >= 0x20) {
+        out.append(char((0x20 | (v & 0x1f)) + 63));
+        v >>= 5;
+    }
+    out.append(char(v + 63));
+}
+
+class tst_bench_QGeoRouteParserOsrmV5 : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void parseReply();
+
+private:
+    QByteArray m_reply;
+    int m_vertices = 0;
+};
+
+/*
+    Builds an OSRM v5 reply for a route of about 5,000 km, going east from Lisbon
+    along a slowly meandering line with a vertex every 20 m, split into 5 legs of
+    250 steps each, like a cross-continent route requested with full step geometry.
+*/
+void tst_bench_QGeoRouteParserOsrmV5::initTestCase()
+{
+    const int legCount = 5;
+    const int stepsPerLeg = 250;
+    const int verticesPerStep = 200;
+    const double stepLength = 20.0;
+
+    QGeoCoordinate position(38.7223, -9.1393);
+    int lat = qRound(position.latitude() * 1e6);
+    int lng = qRound(position.longitude() * 1e6);
+    int n = 0;
+
+    QJsonArray legs;
+    for (int l = 0; l < legCount; ++l) {
+        QJsonArray steps;
+        for (int s = 0; s < stepsPerLeg; ++s) {
+            QByteArray geometry;
+            int prevLat = 0;
+            int prevLng = 0;
+            QJsonArray location;
+            location << position.longitude() << position.latitude();
+            for (int v = 0; v < verticesPerStep; ++v, ++n) {
+                if (v > 0) {
+                    position = position.atDistanceAndAzimuth(stepLength, 80.0 + 20.0 * qSin(n * 1e-3));
+                    lat = qRound(position.latitude() * 1e6);
+                    lng = qRound(position.longitude() * 1e6);
+                }
+                encodeValue(lat - prevLat, geometry);
+                encodeValue(lng - prevLng, geometry);
+                prevLat = lat;
+                prevLng = lng;
+            }
+
+            QJsonObject maneuver;
+            maneuver.insert(QStringLiteral("location"), location);
+            maneuver.insert(QStringLiteral("type"), s == 0 ? QStringLiteral("depart") : QStringLiteral("continue"));
+            maneuver.insert(QStringLiteral("modifier"), QStringLiteral("straight"));
+            maneuver.insert(QStringLiteral("bearing_after"), 90);
+
+            QJsonObject step;
+            step.insert(QStringLiteral("maneuver"), maneuver);
+            step.insert(QStringLiteral("geometry"), QString::fromLatin1(geometry));
+            step.insert(QStringLiteral("name"), QStringLiteral("E80"));
+            step.insert(QStringLiteral("duration"), verticesPerStep * stepLength / 30.0);
+            step.insert(QStringLiteral("distance"), verticesPerStep * stepLength);
+            step.insert(QStringLiteral("intersections"), QJsonArray());
+            steps << step;
+        }
+        QJsonObject leg;
+        leg.insert(QStringLiteral("steps"), steps);
+        leg.insert(QStringLiteral("distance"), stepsPerLeg * verticesPerStep * stepLength);
+        leg.insert(QStringLiteral("duration"), stepsPerLeg * verticesPerStep * stepLength / 30.0);
+        legs << leg;
+    }
+    m_vertices = n;
+
+    QJsonObject route;
+    route.insert(QStringLiteral("legs"), legs);
+    route.insert(QStringLiteral("distance"), n * stepLength);
+    route.insert(QStringLiteral("duration"), n * stepLength / 30.0);
+
+    QJsonObject reply;
+    reply.insert(QStringLiteral("code"), QStringLiteral("Ok"));
+    reply.insert(QStringLiteral("routes"), QJsonArray() << route);
+    m_reply = QJsonDocument(reply).toJson(QJsonDocument::Compact);
+
+    // sanity check the generated reply before measuring anything
+    QGeoRouteParserOsrmV5 parser;
+    QList<QGeoRoute> routes;
+    QString errorString;
+    QCOMPARE(parser.parseReply(routes, errorString, m_reply), QGeoRouteReply::NoError);
+    QCOMPARE(routes.size(), 1);
+    QCOMPARE(routes.first().path().size(), m_vertices);
+    QVERIFY(routes.first().path().first().distanceTo(QGeoCoordinate(38.7223, -9.1393)) < 1.0);
+    QVERIFY(routes.first().path().last().distanceTo(QGeoCoordinate(38.7223, -9.1393)) > 4.0e6);
+}
+
+void tst_bench_QGeoRouteParserOsrmV5::parseReply()
+{
+    QGeoRouteParserOsrmV5 parser;
+    QBENCHMARK {
+        QList<QGeoRoute> routes;
+        QString errorString;
+        parser.parseReply(routes, errorString, m_reply);
+    }
+}
+
+QTEST_GUILESS_MAIN(tst_bench_QGeoRouteParserOsrmV5)
+
+#include "tst_bench_qgeorouteparserosrmv5.moc"
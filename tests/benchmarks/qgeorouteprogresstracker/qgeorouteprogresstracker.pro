@@ -0,0 +1,6 @@
+TEMPLATE = app
+TARGET = tst_bench_qgeorouteprogresstracker
+
+SOURCES += tst_bench_qgeorouteprogresstracker.cpp
+
+QT = core location-private positioning-private testlib
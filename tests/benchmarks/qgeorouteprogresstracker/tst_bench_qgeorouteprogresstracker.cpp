@@ -0,0 +1,210 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCore/qmath.h>
+#include <QtPositioning/QGeoCoordinate>
+#include <QtPositioning/QGeoPositionInfo>
+#include <QtPositioning/private/qlocationutils_p.h>
+#include <QtLocation/QGeoRoute>
+#include <QtLocation/QGeoRouteSegment>
+#include <QtLocation/private/qgeorouteprogresstracker_p.h>
+
+QT_USE_NAMESPACE
+
+static QByteArray nmeaCoordinate(double value, int degreeDigits, char positive, char negative)
+{
+    const double absolute = qAbs(value);
+    const int degrees = int(absolute);
+    const double minutes = (absolute - degrees) * 60.0;
+    return QString::asprintf("%0*d%07.4f,%c", degreeDigits, degrees, minutes,
+                             value < 0 ? negative : positive).toLatin1();
+}
+
+static QByteArray rmcSentence(int second, const QGeoCoordinate &position, double speed, double course)
+{
+    QByteArray sentence = "GPRMC,";
+    sentence += QString::asprintf("%02d%02d%02d.00,A,", (second / 3600) % 24, (second / 60) % 60,
+                                  second % 60).toLatin1();
+    sentence += nmeaCoordinate(position.latitude(), 2, 'N', 'S') + ',';
+    sentence += nmeaCoordinate(position.longitude(), 3, 'E', 'W') + ',';
+    sentence += QString::asprintf("%.1f,%.1f,190519,,", speed / 0.514444, course).toLatin1();
+
+    char checksum = 0;
+    for (char c : qAsConst(sentence))
+        checksum ^= c;
+    return '$' + sentence + QString::asprintf("*%02X\r\n", uchar(checksum)).toLatin1();
+}
+
+class tst_bench_QGeoRouteProgressTracker : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void setRoute();
+    void replayNmea();
+    void track();
+
+private:
+    int replay(QGeoRouteProgressTracker &tracker) const;
+
+    QGeoRoute m_route;
+    QList<QByteArray> m_nmea;
+    QVector<QGeoCoordinate> m_positions;
+};
+
+/*
+    Builds a 1,000 km route with a vertex every 10 m, split into 1,000 segments,
+    and the NMEA log of a drive along it at 20 m/s with one fix per second. The
+    fixes wander up to 8 m from the road, and the drive leaves the route for a
+    minute halfway through, like a missed exit followed by a return to the road.
+*/
+void tst_bench_QGeoRouteProgressTracker::initTestCase()
+{
+    const int segmentCount = 1000;
+    const int verticesPerSegment = 100;
+    const double spacing = 10.0;
+    const double speed = 20.0;
+
+    QGeoCoordinate position(48.1351, 11.5820);
+    QList<QGeoCoordinate> routePath;
+    QList<QGeoRouteSegment> segments;
+    for (int s = 0; s < segmentCount; ++s) {
+        QList<QGeoCoordinate> path;
+        if (!routePath.isEmpty())
+            path.append(routePath.last());
+        for (int v = 0; v < verticesPerSegment; ++v) {
+            const int n = s * verticesPerSegment + v;
+            if (n > 0)
+                position = position.atDistanceAndAzimuth(spacing, 60.0 + 40.0 * qSin(n * 2e-3));
+            path.append(position);
+            routePath.append(position);
+        }
+        QGeoRouteSegment segment;
+        segment.setPath(path);
+        if (!segments.isEmpty())
+            segments.last().setNextRouteSegment(segment);
+        segments.append(segment);
+    }
+    m_route.setFirstRouteSegment(segments.first());
+    m_route.setPath(routePath);
+
+    const int step = int(speed / spacing);
+    const int detourStart = routePath.size() / 2;
+    const int detourEnd = detourStart + 60 * step;
+    for (int i = 0, second = 0; i < routePath.size() - 1; i += step, ++second) {
+        const QGeoCoordinate &from = routePath.at(i);
+        const double course = from.azimuthTo(routePath.at(i + 1));
+        double offset = 8.0 * qSin(second * 0.7);
+        if (i >= detourStart && i < detourEnd)
+            offset += 300.0 * qSin(M_PI * (i - detourStart) / (detourEnd - detourStart));
+        const QGeoCoordinate fix = from.atDistanceAndAzimuth(offset, course + 90.0);
+        m_nmea.append(rmcSentence(second, fix, speed, course));
+    }
+
+    m_positions.reserve(m_nmea.size());
+    for (const QByteArray &sentence : qAsConst(m_nmea)) {
+        QGeoPositionInfo info;
+        QVERIFY(QLocationUtils::getPosInfoFromNmea(sentence.constData(), sentence.size(), &info, 0.0));
+        m_positions.append(info.coordinate());
+    }
+
+    // sanity check the log before measuring anything
+    QGeoRouteProgressTracker tracker;
+    tracker.setRoute(m_route);
+    QVERIFY(qAbs(tracker.totalDistance() - (routePath.size() - 1) * spacing) < 1.0);
+    int offRouteCount = 0;
+    int segment = 0;
+    for (const QGeoCoordinate &coordinate : qAsConst(m_positions)) {
+        const bool wasOffRoute = tracker.isOffRoute();
+        tracker.update(coordinate);
+        if (!wasOffRoute && tracker.isOffRoute())
+            ++offRouteCount;
+        QVERIFY(tracker.currentSegment() >= segment);
+        segment = tracker.currentSegment();
+    }
+    QCOMPARE(offRouteCount, 1);
+    QCOMPARE(segment, segmentCount - 1);
+    QVERIFY(tracker.remainingDistance() < 2.0 * speed);
+}
+
+void tst_bench_QGeoRouteProgressTracker::setRoute()
+{
+    QGeoRouteProgressTracker tracker;
+    QBENCHMARK {
+        tracker.setRoute(m_route);
+    }
+}
+
+int tst_bench_QGeoRouteProgressTracker::replay(QGeoRouteProgressTracker &tracker) const
+{
+    int matched = 0;
+    for (const QByteArray &sentence : m_nmea) {
+        QGeoPositionInfo info;
+        if (QLocationUtils::getPosInfoFromNmea(sentence.constData(), sentence.size(), &info, 0.0)
+                && tracker.update(info.coordinate())) {
+            ++matched;
+        }
+    }
+    return matched;
+}
+
+/*
+    Parses the NMEA log and tracks every fix, as a Navigator fed by an NMEA
+    PositionSource does.
+*/
+void tst_bench_QGeoRouteProgressTracker::replayNmea()
+{
+    QGeoRouteProgressTracker tracker;
+    tracker.setRoute(m_route);
+    int matched = 0;
+    QBENCHMARK {
+        tracker.reset();
+        matched = replay(tracker);
+    }
+    QVERIFY(matched > m_nmea.size() * 9 / 10);
+}
+
+/*
+    Same as replayNmea(), without the NMEA parsing.
+*/
+void tst_bench_QGeoRouteProgressTracker::track()
+{
+    QGeoRouteProgressTracker tracker;
+    tracker.setRoute(m_route);
+    QBENCHMARK {
+        tracker.reset();
+        for (const QGeoCoordinate &coordinate : qAsConst(m_positions))
+            tracker.update(coordinate);
+    }
+}
+
+QTEST_GUILESS_MAIN(tst_bench_QGeoRouteProgressTracker)
+
+#include "tst_bench_qgeorouteprogresstracker.moc"
@@ -0,0 +1,6 @@
+TEMPLATE = app
+TARGET = tst_bench_qgeotilefetcher
+
+SOURCES += tst_bench_qgeotilefetcher.cpp
+
+QT = core network location-private testlib
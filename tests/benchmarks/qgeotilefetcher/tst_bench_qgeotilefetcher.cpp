@@ -0,0 +1,247 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCore/QEventLoop>
+#include <QtCore/QTimer>
+#include <QtNetwork/QNetworkAccessManager>
+#include <QtNetwork/QNetworkReply>
+#include <QtNetwork/QNetworkRequest>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
+#include <QtLocation/private/qgeocameracapabilities_p.h>
+#include <QtLocation/private/qgeotiledmappingmanagerengine_p.h>
+#include <QtLocation/private/qgeotiledmapreply_p.h>
+#include <QtLocation/private/qgeotilefetcher_p.h>
+#include <QtLocation/private/qgeotilespec_p.h>
+
+QT_USE_NAMESPACE
+
+/*
+    Stands in for a tile server on the other side of a network: every
+    request is answered with a 4 KiB tile after a fixed delay, in order, on
+    persistent HTTP/1.1 connections.
+*/
+class TileConnection : public QObject
+{
+public:
+    TileConnection(qintptr socketDescriptor, int latency, QObject *parent)
+        : QObject(parent), m_latency(latency)
+    {
+        m_socket.setSocketDescriptor(socketDescriptor);
+        connect(&m_socket, &QTcpSocket::readyRead, this, &TileConnection::readRequests);
+        connect(&m_socket, &QTcpSocket::disconnected, this, &QObject::deleteLater);
+    }
+
+private:
+    void readRequests()
+    {
+        static const QByteArray tile(4096, 't');
+        static const QByteArray response = "HTTP/1.1 200 OK\r\n"
+                                           "Content-Type: image/png\r\n"
+                                           "Content-Length: " + QByteArray::number(tile.size()) + "\r\n"
+                                           "\r\n" + tile;
+        m_buffer += m_socket.readAll();
+        int end;
+        while ((end = m_buffer.indexOf("\r\n\r\n")) >= 0) {
+            m_buffer.remove(0, end + 4);
+            QTimer::singleShot(m_latency, this, [this]() { m_socket.write(response); });
+        }
+    }
+
+    QTcpSocket m_socket;
+    QByteArray m_buffer;
+    int m_latency;
+};
+
+class TileServer : public QTcpServer
+{
+public:
+    explicit TileServer(int latency) : m_latency(latency) {}
+
+protected:
+    void incomingConnection(qintptr socketDescriptor) override
+    {
+        new TileConnection(socketDescriptor, m_latency, this);
+    }
+
+private:
+    int m_latency;
+};
+
+class BenchTileReply : public QGeoTiledMapReply
+{
+public:
+    BenchTileReply(QNetworkReply *reply, const QGeoTileSpec &spec, QObject *parent)
+        : QGeoTiledMapReply(spec, parent)
+    {
+        connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+            reply->deleteLater();
+            if (reply->error() != QNetworkReply::NoError) {
+                setError(QGeoTiledMapReply::CommunicationError, reply->errorString());
+                return;
+            }
+            setMapImageData(reply->readAll());
+            setFinished(true);
+        });
+        connect(this, &QGeoTiledMapReply::aborted, reply, &QNetworkReply::abort);
+    }
+};
+
+/*
+    Fetches tiles from the stand-in servers, spreading them over the servers
+    the way subdomain templates do.
+*/
+class BenchTileFetcher : public QGeoTileFetcher
+{
+public:
+    BenchTileFetcher(QGeoMappingManagerEngine *parent) : QGeoTileFetcher(parent) {}
+
+    void fetch(const QSet<QGeoTileSpec> &tiles)
+    {
+        m_remaining = tiles.size();
+        updateTileRequests(tiles, QSet<QGeoTileSpec>());
+        m_loop.exec();
+    }
+
+    QStringList m_hosts;
+
+protected:
+    QString tileHost(const QGeoTileSpec &spec) const override
+    {
+        return tileUrl(spec).authority();
+    }
+
+private:
+    QUrl tileUrl(const QGeoTileSpec &spec) const
+    {
+        return QUrl(QStringLiteral("http://%1/%2/%3/%4.png")
+                    .arg(m_hosts.at((spec.x() + spec.y()) % m_hosts.size()))
+                    .arg(spec.zoom()).arg(spec.x()).arg(spec.y()));
+    }
+
+    QGeoTiledMapReply *getTileImage(const QGeoTileSpec &spec) override
+    {
+        QNetworkRequest request(tileUrl(spec));
+        prepareTileRequest(spec, &request);
+        return new BenchTileReply(m_nm.get(request), spec, this);
+    }
+
+    void handleReply(QGeoTiledMapReply *reply, const QGeoTileSpec &) override
+    {
+        reply->deleteLater();
+        if (--m_remaining == 0)
+            m_loop.quit();
+    }
+
+    QNetworkAccessManager m_nm;
+    QEventLoop m_loop;
+    int m_remaining = 0;
+};
+
+class BenchMappingEngine : public QGeoTiledMappingManagerEngine
+{
+public:
+    BenchMappingEngine()
+    {
+        QGeoCameraCapabilities capabilities;
+        capabilities.setMinimumZoomLevel(0);
+        capabilities.setMaximumZoomLevel(20);
+        setCameraCapabilities(capabilities);
+        setTileSize(QSize(256, 256));
+        fetcher = new BenchTileFetcher(this);
+        setTileFetcher(fetcher);
+    }
+
+    BenchTileFetcher *fetcher;
+};
+
+class tst_bench_QGeoTileFetcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void fetch_data();
+    void fetch();
+
+private:
+    QVector<QSharedPointer<TileServer> > m_servers;
+    QSet<QGeoTileSpec> m_tiles;
+};
+
+/*
+    Three servers on separate ports play the part of the a, b and c
+    subdomains of a tile provider, each 20 ms away. HTTP/2 needs a TLS
+    server and is not covered.
+*/
+void tst_bench_QGeoTileFetcher::initTestCase()
+{
+    for (int i = 0; i < 3; ++i) {
+        QSharedPointer<TileServer> server(new TileServer(20));
+        QVERIFY(server->listen(QHostAddress::LocalHost));
+        m_servers.append(server);
+    }
+
+    // A screenful of tiles and its prefetched surroundings.
+    for (int x = 0; x < 16; ++x) {
+        for (int y = 0; y < 12; ++y)
+            m_tiles.insert(QGeoTileSpec(QStringLiteral("bench"), 1, 10, 500 + x, 300 + y));
+    }
+}
+
+void tst_bench_QGeoTileFetcher::fetch_data()
+{
+    QTest::addColumn<int>("hosts");
+    QTest::addColumn<int>("maxRequestsPerHost");
+
+    QTest::newRow("1 host, no limit") << 1 << 0;
+    QTest::newRow("1 host, 4 per host") << 1 << 4;
+    QTest::newRow("3 hosts, no limit") << 3 << 0;
+    QTest::newRow("3 hosts, 4 per host") << 3 << 4;
+    QTest::newRow("3 hosts, 6 per host") << 3 << 6;
+}
+
+void tst_bench_QGeoTileFetcher::fetch()
+{
+    QFETCH(int, hosts);
+    QFETCH(int, maxRequestsPerHost);
+
+    BenchMappingEngine engine;
+    for (int i = 0; i < hosts; ++i)
+        engine.fetcher->m_hosts.append(QStringLiteral("127.0.0.1:%1").arg(m_servers.at(i)->serverPort()));
+    engine.fetcher->setMaximumRequestsPerHost(maxRequestsPerHost);
+
+    QBENCHMARK {
+        engine.fetcher->fetch(m_tiles);
+    }
+}
+
+QTEST_MAIN(tst_bench_QGeoTileFetcher)
+
+#include "tst_bench_qgeotilefetcher.moc"